@@ -140,3 +140,12 @@ if (HDF5_ENABLE_SZIP_SUPPORT)
     set (EXTERNAL_FILTERS "${EXTERNAL_FILTERS} ENCODE")
   endif ()
 endif ()
+
+#-----------------------------------------------------------------------------
+# Option for the built-in LZ4 filter (needs no external library)
+#-----------------------------------------------------------------------------
+option (HDF5_ENABLE_LZ4_SUPPORT "Enable the built-in LZ4 Filter" ON)
+if (HDF5_ENABLE_LZ4_SUPPORT)
+  set (H5_HAVE_FILTER_LZ4 1)
+  message (STATUS "Filter LZ4 is ON")
+endif ()
@@ -417,6 +417,11 @@ H5_term_library(void)
         (void)H5MM_free(tmp_open_stream);
     } /* end while */
 
+#ifdef H5_HAVE_THREADSAFE
+    /* Stop the helper threads used to filter chunks */
+    H5TS_pool_term();
+#endif /* H5_HAVE_THREADSAFE */
+
 #if defined H5_MEMORY_ALLOC_SANITY_CHECK
     /* Sanity check memory allocations */
     H5MM_final_sanity_check();
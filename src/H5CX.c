@@ -253,6 +253,10 @@ typedef struct H5CX_t {
     hbool_t vl_alloc_info_valid; /* Whether VL datatype alloc info is valid */
     H5T_conv_cb_t dt_conv_cb;   /* Datatype conversion struct (H5D_XFER_CONV_CB_NAME) */
     hbool_t dt_conv_cb_valid;   /* Whether datatype conversion struct is valid */
+    unsigned chunk_decode_nthreads; /* Threads for decoding filtered chunks (H5D_XFER_CHUNK_DECODE_NTHREADS_NAME) */
+    hbool_t chunk_decode_nthreads_valid; /* Whether chunk decode threads value is valid */
+    unsigned deflate_nthreads;  /* Threads for compressing a chunk with deflate (H5D_XFER_DEFLATE_NTHREADS_NAME) */
+    hbool_t deflate_nthreads_valid; /* Whether deflate threads value is valid */
 
     /* Return-only DXPL properties to return to application */
 #ifdef H5_HAVE_PARALLEL
@@ -358,6 +362,8 @@ typedef struct H5CX_dxpl_cache_t {
     H5Z_data_xform_t *data_transform; /* Data transform info (H5D_XFER_XFORM_NAME) */
     H5T_vlen_alloc_info_t vl_alloc_info; /* VL datatype alloc info (H5D_XFER_VLEN_*_NAME) */
     H5T_conv_cb_t dt_conv_cb;       /* Datatype conversion struct (H5D_XFER_CONV_CB_NAME) */
+    unsigned chunk_decode_nthreads; /* Threads for decoding filtered chunks (H5D_XFER_CHUNK_DECODE_NTHREADS_NAME) */
+    unsigned deflate_nthreads;      /* Threads for compressing a chunk with deflate (H5D_XFER_DEFLATE_NTHREADS_NAME) */
 } H5CX_dxpl_cache_t;
 
 /* Typedef for cached default link creation property list information */
@@ -551,6 +557,14 @@ H5CX__init_package(void)
     if(H5P_get(dx_plist, H5D_XFER_CONV_CB_NAME, &H5CX_def_dxpl_cache.dt_conv_cb) < 0)
         HGOTO_ERROR(H5E_CONTEXT, H5E_CANTGET, FAIL, "Can't retrieve datatype conversion exception callback")
 
+    /* Get number of threads for decoding filtered chunks */
+    if(H5P_get(dx_plist, H5D_XFER_CHUNK_DECODE_NTHREADS_NAME, &H5CX_def_dxpl_cache.chunk_decode_nthreads) < 0)
+        HGOTO_ERROR(H5E_CONTEXT, H5E_CANTGET, FAIL, "Can't retrieve number of chunk decode threads")
+
+    /* Get number of threads for compressing a chunk with deflate */
+    if(H5P_get(dx_plist, H5D_XFER_DEFLATE_NTHREADS_NAME, &H5CX_def_dxpl_cache.deflate_nthreads) < 0)
+        HGOTO_ERROR(H5E_CONTEXT, H5E_CANTGET, FAIL, "Can't retrieve number of deflate threads")
+
     /* Reset the "default LCPL cache" information */
     HDmemset(&H5CX_def_lcpl_cache, 0, sizeof(H5CX_lcpl_cache_t));
 
@@ -2488,6 +2502,72 @@ done:
     FUNC_LEAVE_NOAPI(ret_value)
 } /* end H5CX_get_dt_conv_cb() */
 
+
+/*-------------------------------------------------------------------------
+ * Function:    H5CX_get_chunk_decode_nthreads
+ *
+ * Purpose:     Retrieves the number of threads for decoding filtered chunks
+ *              for the current API call context.
+ *
+ * Return:      Non-negative on success / Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5CX_get_chunk_decode_nthreads(unsigned *chunk_decode_nthreads)
+{
+    H5CX_node_t **head = H5CX_get_my_context();  /* Get the pointer to the head of the API context, for this thread */
+    herr_t ret_value = SUCCEED;         /* Return value */
+
+    FUNC_ENTER_NOAPI(FAIL)
+
+    /* Sanity check */
+    HDassert(chunk_decode_nthreads);
+    HDassert(head && *head);
+    HDassert(H5P_DEFAULT != (*head)->ctx.dxpl_id);
+
+    H5CX_RETRIEVE_PROP_VALID(dxpl, H5P_DATASET_XFER_DEFAULT, H5D_XFER_CHUNK_DECODE_NTHREADS_NAME, chunk_decode_nthreads)
+
+    /* Get the value */
+    *chunk_decode_nthreads = (*head)->ctx.chunk_decode_nthreads;
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5CX_get_chunk_decode_nthreads() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:    H5CX_get_deflate_nthreads
+ *
+ * Purpose:     Retrieves the number of threads for compressing a chunk
+ *              with deflate for the current API call context.
+ *
+ * Return:      Non-negative on success / Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5CX_get_deflate_nthreads(unsigned *deflate_nthreads)
+{
+    H5CX_node_t **head = H5CX_get_my_context();  /* Get the pointer to the head of the API context, for this thread */
+    herr_t ret_value = SUCCEED;         /* Return value */
+
+    FUNC_ENTER_NOAPI(FAIL)
+
+    /* Sanity check */
+    HDassert(deflate_nthreads);
+    HDassert(head && *head);
+    HDassert(H5P_DEFAULT != (*head)->ctx.dxpl_id);
+
+    H5CX_RETRIEVE_PROP_VALID(dxpl, H5P_DATASET_XFER_DEFAULT, H5D_XFER_DEFLATE_NTHREADS_NAME, deflate_nthreads)
+
+    /* Get the value */
+    *deflate_nthreads = (*head)->ctx.deflate_nthreads;
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5CX_get_deflate_nthreads() */
+
 
 /*-------------------------------------------------------------------------
  * Function:    H5CX_get_encoding
@@ -605,6 +605,77 @@ done:
     FUNC_LEAVE_API(ret_value)
 } /* end H5Dget_offset() */
 
+
+/*-------------------------------------------------------------------------
+ * Function:    H5Dget_chunk_cache_stats
+ *
+ * Purpose:     Retrieves the statistics of the raw data chunk cache of a
+ *              chunked dataset, accumulated since the dataset was opened
+ *              or since the last call to H5Dreset_chunk_cache_stats().
+ *
+ * Parameters:
+ *              hid_t dset_id;                      IN: Chunked dataset ID
+ *              H5D_chunk_cache_stats_t *stats;     OUT: Cache statistics
+ *
+ * Return:      Non-negative on success, negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5Dget_chunk_cache_stats(hid_t dset_id, H5D_chunk_cache_stats_t *stats)
+{
+    H5VL_object_t  *vol_obj;                /* Dataset for this operation   */
+    herr_t          ret_value = SUCCEED;    /* Return value                 */
+
+    FUNC_ENTER_API(FAIL)
+    H5TRACE2("e", "i*x", dset_id, stats);
+
+    /* Check args */
+    if(NULL == (vol_obj = (H5VL_object_t *)H5I_object_verify(dset_id, H5I_DATASET)))
+        HGOTO_ERROR(H5E_ARGS, H5E_BADTYPE, FAIL, "invalid dataset identifier")
+    if(NULL == stats)
+        HGOTO_ERROR(H5E_ARGS, H5E_BADVALUE, FAIL, "stats parameter cannot be NULL")
+
+    /* Get the statistics */
+    if(H5VL_dataset_optional(vol_obj, H5VL_NATIVE_DATASET_GET_CHUNK_CACHE_STATS, H5P_DATASET_XFER_DEFAULT, H5_REQUEST_NULL, stats) < 0)
+        HGOTO_ERROR(H5E_DATASET, H5E_CANTGET, FAIL, "unable to get chunk cache statistics")
+
+done:
+    FUNC_LEAVE_API(ret_value)
+} /* end H5Dget_chunk_cache_stats() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:    H5Dreset_chunk_cache_stats
+ *
+ * Purpose:     Resets the statistics of the raw data chunk cache of a
+ *              chunked dataset to zero.
+ *
+ * Return:      Non-negative on success, negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5Dreset_chunk_cache_stats(hid_t dset_id)
+{
+    H5VL_object_t  *vol_obj;                /* Dataset for this operation   */
+    herr_t          ret_value = SUCCEED;    /* Return value                 */
+
+    FUNC_ENTER_API(FAIL)
+    H5TRACE1("e", "i", dset_id);
+
+    /* Check args */
+    if(NULL == (vol_obj = (H5VL_object_t *)H5I_object_verify(dset_id, H5I_DATASET)))
+        HGOTO_ERROR(H5E_ARGS, H5E_BADTYPE, FAIL, "invalid dataset identifier")
+
+    /* Reset the statistics */
+    if(H5VL_dataset_optional(vol_obj, H5VL_NATIVE_DATASET_RESET_CHUNK_CACHE_STATS, H5P_DATASET_XFER_DEFAULT, H5_REQUEST_NULL) < 0)
+        HGOTO_ERROR(H5E_DATASET, H5E_CANTSET, FAIL, "unable to reset chunk cache statistics")
+
+done:
+    FUNC_LEAVE_API(ret_value)
+} /* end H5Dreset_chunk_cache_stats() */
+
 
 /*-------------------------------------------------------------------------
  * Function:    H5Diterate
@@ -68,9 +68,18 @@
 /****************/
 
 /* Macros for iterating over chunks to operate on */
-#define H5D_CHUNK_GET_FIRST_NODE(map) (map->use_single ? (H5SL_node_t *)(1) : H5SL_first(map->sel_chunks))
-#define H5D_CHUNK_GET_NODE_INFO(map, node)  (map->use_single ? map->single_chunk_info : (H5D_chunk_info_t *)H5SL_item(node))
-#define H5D_CHUNK_GET_NEXT_NODE(map, node)  (map->use_single ? (H5SL_node_t *)NULL : H5SL_next(node))
+#define H5D_CHUNK_GET_FIRST_NODE(map) (map->use_single ? &map->single_chunk_info : \
+        (map->sel_chunks->nchunks > 0 ? map->sel_chunks->chunk : NULL))
+#define H5D_CHUNK_GET_NODE_INFO(map, node)  (*(node))
+#define H5D_CHUNK_GET_NEXT_NODE(map, node)  (map->use_single ? NULL : \
+        ((node) + 1 < map->sel_chunks->chunk + map->sel_chunks->nchunks ? (node) + 1 : NULL))
+
+/* Hash a chunk index into the table of selected chunks (Fibonacci hashing) */
+#define H5D_CHUNK_SEL_HASH(index, bits) \
+        ((size_t)(((hsize_t)(index) * (hsize_t)0x9E3779B97F4A7C15) >> (64 - (bits))))
+
+/* Smallest hash table for the selected chunks */
+#define H5D_CHUNK_SEL_HASH_MIN_BITS     6
 
 /* Sanity check on chunk index types: commonly used by a lot of routines in this file */
 #define H5D_CHUNK_STORAGE_INDEX_CHK(storage)                                                    \
@@ -122,6 +131,7 @@ typedef struct H5D_rdcc_ent_t {
     hbool_t    locked;        /*entry is locked in cache        */
     hbool_t    dirty;        /*needs to be written to disk?        */
     hbool_t     deleted;        /*chunk about to be deleted        */
+    hbool_t     hot;            /*entry is in the 2Q hot queue      */
     unsigned    edge_chunk_state; /*states related to edge chunks (see above) */
     hsize_t     scaled[H5O_LAYOUT_NDIMS]; /*scaled chunk 'name' (coordinates) */
     uint32_t    rd_count;    /*bytes remaining to be read        */
@@ -129,11 +139,18 @@ typedef struct H5D_rdcc_ent_t {
     H5F_block_t chunk_block;    /*offset/length of chunk in file        */
     hsize_t     chunk_idx;      /*index of chunk in dataset             */
     uint8_t    *chunk;        /*the unfiltered chunk data        */
+    uint8_t    *filt_buf;       /*chunk data already run through the filter pipeline for flushing, or NULL */
+    size_t      filt_nbytes;    /*size of the data in filt_buf      */
+    size_t      filt_alloc;     /*size of filt_buf                  */
+    unsigned    filt_mask;      /*filter mask for the data in filt_buf */
     unsigned    idx;        /*index in hash table            */
     struct H5D_rdcc_ent_t *next;/*next item in doubly-linked list    */
     struct H5D_rdcc_ent_t *prev;/*previous item in doubly-linked list    */
     struct H5D_rdcc_ent_t *tmp_next;/*next item in temporary doubly-linked list */
     struct H5D_rdcc_ent_t *tmp_prev;/*previous item in temporary doubly-linked list */
+    struct H5D_shared_t *owner; /*dataset that owns the entry, with a file-wide budget */
+    struct H5D_rdcc_ent_t *budget_next;/*next item in the file-wide LRU list */
+    struct H5D_rdcc_ent_t *budget_prev;/*previous item in the file-wide LRU list */
 } H5D_rdcc_ent_t;
 typedef H5D_rdcc_ent_t *H5D_rdcc_ent_ptr_t; /* For free lists */
 
@@ -236,6 +253,38 @@ typedef struct H5D_chunk_file_iter_ud_t {
 #endif /* H5_HAVE_PARALLEL */
 } H5D_chunk_file_iter_ud_t;
 
+/* Information about a chunk loaded ahead of the read loop */
+typedef struct H5D_chunk_decode_t {
+    H5D_chunk_ud_t      udata;                  /* Chunk index info for the chunk */
+    hsize_t             scaled[H5O_LAYOUT_NDIMS]; /* Scaled coordinates of the chunk */
+    unsigned            idx;                    /* Slot for the chunk in the cache */
+    hbool_t             filtered;               /* Whether the chunk's filters are enabled */
+    size_t              nbytes;                 /* Size of the data in the buffer */
+    size_t              buf_alloc;              /* Size of the buffer */
+    void                *buf;                   /* Chunk buffer, filtered then unfiltered */
+    hbool_t             decoded;                /* Whether the filter pipeline succeeded */
+} H5D_chunk_decode_t;
+
+/* Callback info for decoding chunks with H5TS_parallel_for() */
+typedef struct H5D_chunk_decode_ud_t {
+    const H5O_pline_t   *pline;                 /* Filter pipeline */
+    H5Z_EDC_t           err_detect;             /* Error detection info */
+    H5Z_cb_t            filter_cb;              /* I/O filter callback function */
+    size_t              chunk_size;             /* Size of a decoded chunk */
+    H5D_chunk_decode_t  *chunks;                /* Chunks to decode */
+} H5D_chunk_decode_ud_t;
+
+/* Callback info for filtering cache entries with H5TS_parallel_for() */
+typedef struct H5D_chunk_encode_ud_t {
+    const H5O_pline_t   *pline;                 /* Filter pipeline */
+    unsigned            filter_mode;            /* Chunk filter mode flags */
+    double              min_gain;               /* Min. gain from filtering a chunk */
+    H5Z_EDC_t           err_detect;             /* Error detection info */
+    H5Z_cb_t            filter_cb;              /* I/O filter callback function */
+    size_t              chunk_size;             /* Size of a chunk */
+    H5D_rdcc_ent_t      **ents;                 /* Cache entries to filter */
+} H5D_chunk_encode_ud_t;
+
 #ifdef H5_HAVE_PARALLEL
 /* information to construct a collective I/O operation for filling chunks */
 typedef struct H5D_chunk_coll_info_t {
@@ -285,6 +334,12 @@ static herr_t H5D__chunk_set_info_real(H5O_layout_chunk_t *layout, unsigned ndim
     const hsize_t *curr_dims, const hsize_t *max_dims);
 static void *H5D__chunk_mem_alloc(size_t size, const H5O_pline_t *pline);
 static void *H5D__chunk_mem_xfree(void *chk, const void *pline);
+static void *H5D__chunk_pool_alloc(H5D_shared_t *shared, size_t size,
+    const H5O_pline_t *pline, size_t *alloc);
+static void *H5D__chunk_pool_free(H5D_shared_t *shared, void *chk, size_t alloc,
+    const H5O_pline_t *pline);
+static void *H5D__chunk_pool_mem_alloc(size_t size, size_t *alloc, void *info);
+static void H5D__chunk_pool_mem_free(void *buf, size_t alloc, void *info);
 static void *H5D__chunk_mem_realloc(void *chk, size_t size,
     const H5O_pline_t *pline);
 static herr_t H5D__chunk_cinfo_cache_reset(H5D_chunk_cached_t *last);
@@ -292,13 +347,24 @@ static herr_t H5D__chunk_cinfo_cache_update(H5D_chunk_cached_t *last,
     const H5D_chunk_ud_t *udata);
 static hbool_t H5D__chunk_cinfo_cache_found(const H5D_chunk_cached_t *last,
     H5D_chunk_ud_t *udata);
-static herr_t H5D__free_chunk_info(void *item, void *key, void *opdata);
+static herr_t H5D__free_chunk_info(H5D_chunk_info_t *chunk_info);
+static herr_t H5D__chunk_sel_reserve(H5D_chunk_sel_t *sel, size_t nchunks);
+static herr_t H5D__chunk_sel_trim(H5D_chunk_sel_t *sel);
+static herr_t H5D__chunk_sel_hash_build(H5D_chunk_sel_t *sel, unsigned bits);
+static herr_t H5D__chunk_sel_append(H5D_chunk_sel_t *sel, H5D_chunk_info_t *chunk_info);
+static int H5D__chunk_cmp_sel_index(const void *_info1, const void *_info2);
 static herr_t H5D__create_chunk_map_single(H5D_chunk_map_t *fm,
     const H5D_io_info_t *io_info);
 static herr_t H5D__create_chunk_file_map_all(H5D_chunk_map_t *fm,
     const H5D_io_info_t *io_info);
 static herr_t H5D__create_chunk_file_map_hyper(H5D_chunk_map_t *fm,
     const H5D_io_info_t *io_info);
+static herr_t H5D__create_chunk_file_map_regular(H5D_chunk_map_t *fm,
+    const H5D_io_info_t *io_info, const hsize_t *start, const hsize_t *stride,
+    const hsize_t *count, const hsize_t *block);
+static herr_t H5D__chunk_file_map_add(H5D_chunk_map_t *fm,
+    const H5D_io_info_t *io_info, hsize_t chunk_index, const hsize_t *coords,
+    const hsize_t *scaled, hsize_t *chunk_points);
 
 static herr_t H5D__create_chunk_mem_map_1d(const H5D_chunk_map_t *fm);
 
@@ -308,10 +374,20 @@ static herr_t H5D__chunk_file_cb(void *elem, const H5T_t *type, unsigned ndims,
 static herr_t H5D__chunk_mem_cb(void *elem, const H5T_t *type, unsigned ndims,
     const hsize_t *coords, void *fm);
 static unsigned H5D__chunk_hash_val(const H5D_shared_t *shared, const hsize_t *scaled);
+static hsize_t H5D__chunk_ghost_key(const H5D_shared_t *shared, const hsize_t *scaled);
+static hbool_t H5D__chunk_ghost_find(const H5D_t *dset, unsigned idx,
+    const hsize_t *scaled);
+static hbool_t H5D__chunk_cache_admit(const H5D_t *dset, unsigned idx,
+    const hsize_t *scaled);
+static herr_t H5D__chunk_filter_adapt(const H5O_pline_t *pline, double min_gain,
+    const void *chunk, size_t chunk_size, H5Z_EDC_t err_detect, H5Z_cb_t filter_cb,
+    unsigned *filter_mask, size_t *nbytes, size_t *alloc, void **buf);
+static htri_t H5D__chunk_is_fill(const H5D_t *dset, const void *chunk);
 static herr_t H5D__chunk_flush_entry(const H5D_t *dset, H5D_rdcc_ent_t *ent,
     hbool_t reset);
 static herr_t H5D__chunk_cache_evict(const H5D_t *dset, H5D_rdcc_ent_t *ent,
     hbool_t flush);
+static void H5D__chunk_cache_remove(H5D_shared_t *shared, H5D_rdcc_ent_t *ent);
 static hbool_t H5D__chunk_is_partial_edge_chunk(unsigned dset_ndims,
     const uint32_t *chunk_dims, const hsize_t *chunk_scaled, const hsize_t *dset_dims);
 static void *H5D__chunk_lock(const H5D_io_info_t *io_info,
@@ -319,6 +395,27 @@ static void *H5D__chunk_lock(const H5D_io_info_t *io_info,
 static herr_t H5D__chunk_unlock(const H5D_io_info_t *io_info,
     const H5D_chunk_ud_t *udata, hbool_t dirty, void *chunk, uint32_t naccessed);
 static herr_t H5D__chunk_cache_prune(const H5D_t *dset, size_t size);
+static herr_t H5D__chunk_cache_prune_2q(const H5D_t *dset, size_t size);
+static herr_t H5D__chunk_cache_prune_budget(const H5D_t *dset, size_t size);
+static int H5D__chunk_addr_table_cb(const H5D_chunk_rec_t *chunk_rec, void *_udata);
+static herr_t H5D__chunk_addr_table_load(const H5D_t *dset);
+static H5D_rdcc_ent_t *H5D__chunk_cache_insert(const H5D_t *dset,
+    const H5D_chunk_ud_t *udata, unsigned idx, unsigned edge_chunk_state,
+    void *chunk);
+static herr_t H5D__chunk_decode_cb(size_t idx, void *_udata);
+static int H5D__chunk_cmp_decode_addr(const void *_chk1, const void *_chk2);
+static htri_t H5D__chunk_pline_thread_safe(const H5O_pline_t *pline);
+static herr_t H5D__chunk_encode_cb(size_t idx, void *_udata);
+static int H5D__chunk_cmp_ent_addr(const void *_ent1, const void *_ent2);
+static herr_t H5D__chunk_flush_entries(const H5D_t *dset, H5D_rdcc_ent_t **ents,
+    size_t nents, hbool_t evict);
+static herr_t H5D__chunk_flush_lru(const H5D_t *dset, H5D_rdcc_ent_t *victim);
+static herr_t H5D__chunk_load_batch(const H5D_t *dset, H5D_chunk_decode_t *chunks,
+    size_t nchunks, unsigned nthreads);
+static herr_t H5D__chunk_decode_window(const H5D_io_info_t *io_info,
+    const H5D_chunk_map_t *fm, H5D_chunk_info_t * const **chunk_node, unsigned nthreads,
+    H5D_chunk_decode_t *chunks, size_t max_chunks);
+static herr_t H5D__chunk_readahead(const H5D_t *dset, const hsize_t *scaled);
 static herr_t H5D__chunk_prune_fill(H5D_chunk_it_ud1_t *udata, hbool_t new_unfilt_chunk);
 #ifdef H5_HAVE_PARALLEL
 static herr_t H5D__chunk_collective_fill(const H5D_t *dset,
@@ -462,8 +559,11 @@ H5D__chunk_direct_write(const H5D_t *dset, uint32_t filters, hsize_t *offset,
     idx_info.layout = &(dset->shared->layout.u.chunk);
     idx_info.storage = &(dset->shared->layout.storage.u.chunk);
 
-    /* Set up the size of chunk for user data */
+    /* Set up the size and filter mask of the chunk for user data */
+    /* (The filter mask has to be set before the chunk information is
+     *  cached, or reads of the chunk would use the old chunk's mask) */
     udata.chunk_block.length = data_size;
+    udata.filter_mask = filters;
 
     if(0 == idx_info.pline->nused && H5F_addr_defined(old_chunk.offset))
         /* If there are no filters and we are overwriting the chunk we can just set values */
@@ -498,9 +598,6 @@ H5D__chunk_direct_write(const H5D_t *dset, uint32_t filters, hsize_t *offset,
 
     /* Insert the chunk record into the index */
     if(need_insert && layout->storage.u.chunk.ops->insert) {
-        /* Set the chunk's filter mask to the new settings */
-        udata.filter_mask = filters;
-
         if((layout->storage.u.chunk.ops->insert)(&idx_info, &udata, dset) < 0)
             HGOTO_ERROR(H5E_DATASET, H5E_CANTINSERT, FAIL, "unable to insert chunk addr into index")
     } /* end if */
@@ -971,6 +1068,26 @@ H5D__chunk_init(H5F_t *f, const H5D_t * const dset, hid_t dapl_id)
     if(rdcc->w0 < 0)
         rdcc->w0 = H5F_RDCC_W0(f);
 
+    if(H5P_get(dapl, H5D_ACS_CHUNK_ENCODE_NTHREADS_NAME, &rdcc->encode_nthreads) < 0)
+        HGOTO_ERROR(H5E_PLIST, H5E_CANTGET,FAIL, "can't get number of chunk encode threads")
+    if(H5P_get(dapl, H5D_ACS_CHUNK_READAHEAD_NAME, &rdcc->readahead) < 0)
+        HGOTO_ERROR(H5E_PLIST, H5E_CANTGET,FAIL, "can't get number of chunks to read ahead")
+    if(H5P_get(dapl, H5D_ACS_CHUNK_CACHE_POLICY_NAME, &rdcc->policy) < 0)
+        HGOTO_ERROR(H5E_PLIST, H5E_CANTGET,FAIL, "can't get chunk cache policy")
+
+    /* Share the file's chunk cache budget, if it has one */
+    if(H5F_RDCC_BUDGET(f)->nbytes_max > 0)
+        rdcc->budget = H5F_RDCC_BUDGET(f);
+
+    /* Use a chunk address table, if asked to and the index can't change */
+    if(H5P_get(dapl, H5D_ACS_CHUNK_ADDR_TABLE_NAME, &rdcc->use_addr_table) < 0)
+        HGOTO_ERROR(H5E_PLIST, H5E_CANTGET, FAIL, "can't get chunk address table setting")
+    if(H5F_INTENT(f) & (H5F_ACC_RDWR | H5F_ACC_SWMR_READ))
+        rdcc->use_addr_table = FALSE;
+
+    if(H5P_get(dapl, H5D_ACS_CHUNK_READ_COALESCE_NAME, &rdcc->coalesce_max) < 0)
+        HGOTO_ERROR(H5E_PLIST, H5E_CANTGET, FAIL, "can't get max. size of coalesced chunk reads")
+
     /* If nbytes_max or nslots is 0, set them both to 0 and avoid allocating space */
     if(!rdcc->nbytes_max || !rdcc->nslots)
         rdcc->nbytes_max = rdcc->nslots = 0;
@@ -979,6 +1096,11 @@ H5D__chunk_init(H5F_t *f, const H5D_t * const dset, hid_t dapl_id)
         if(NULL == rdcc->slot)
             HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "memory allocation failed")
 
+        /* Allocate the keys of the chunks preempted from the 2Q probationary queue */
+        if(H5D_CHUNK_CACHE_POLICY_2Q == rdcc->policy)
+            if(NULL == (rdcc->ghost = (H5D_rdcc_ghost_t *)H5MM_calloc(rdcc->nslots * sizeof(H5D_rdcc_ghost_t))))
+                HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "memory allocation failed for chunk cache ghost keys")
+
         /* Reset any cached chunk info for this dataset */
         H5D__chunk_cinfo_cache_reset(&(rdcc->last));
     } /* end else */
@@ -1205,7 +1327,7 @@ H5D__chunk_io_init_selections(const H5D_io_info_t *io_info, const H5D_type_info_
             && !(io_info->using_mpi_vfd)
 #endif /* H5_HAVE_PARALLEL */
             && H5S_SEL_ALL != H5S_GET_SELECT_TYPE(fm->file_space)) {
-        /* Initialize skip list for chunk selections */
+        /* Initialize array of chunk selections */
         fm->sel_chunks = NULL;
         fm->use_single = TRUE;
 
@@ -1243,12 +1365,12 @@ H5D__chunk_io_init_selections(const H5D_io_info_t *io_info, const H5D_type_info_
     else {
         hbool_t sel_hyper_flag;         /* Whether file selection is a hyperslab */
 
-        /* Initialize skip list for chunk selections */
-        if(NULL == dataset->shared->cache.chunk.sel_chunks)
-            if(NULL == (dataset->shared->cache.chunk.sel_chunks = H5SL_create(H5SL_TYPE_HSIZE, NULL)))
-                HGOTO_ERROR(H5E_DATASET, H5E_CANTCREATE, FAIL, "can't create skip list for chunk selections")
-        fm->sel_chunks = dataset->shared->cache.chunk.sel_chunks;
-        HDassert(fm->sel_chunks);
+        /* Initialize array of chunk selections (the array is kept with the
+         * dataset, to save allocating it for each I/O operation) */
+        fm->sel_chunks = &(dataset->shared->cache.chunk.sel_chunks);
+        HDassert(fm->sel_chunks->nchunks == 0);
+        fm->sel_chunks->sorted = TRUE;
+        fm->sel_chunks->use_hash = FALSE;
 
         /* We are not using single element mode */
         fm->use_single = FALSE;
@@ -1284,6 +1406,11 @@ H5D__chunk_io_init_selections(const H5D_io_info_t *io_info, const H5D_type_info_
             H5S_sel_iter_op_t iter_op;  /* Operator for iteration */
             H5D_chunk_file_iter_ud_t udata;     /* User data for iteration */
 
+            /* Points may be selected in any order, so look the chunks up
+             * through a hash table while building their selections */
+            if(H5D__chunk_sel_hash_build(fm->sel_chunks, H5D_CHUNK_SEL_HASH_MIN_BITS) < 0)
+                HGOTO_ERROR(H5E_DATASET, H5E_CANTINIT, FAIL, "can't initialize hash table of selected chunks")
+
             /* Create temporary datatypes for selection iteration */
             if(NULL == (file_type = H5T_copy(dataset->shared->type, H5T_COPY_ALL)))
                 HGOTO_ERROR(H5E_DATATYPE, H5E_CANTCOPY, FAIL, "unable to copy file datatype")
@@ -1304,6 +1431,13 @@ H5D__chunk_io_init_selections(const H5D_io_info_t *io_info, const H5D_type_info_
             /* Reset "last chunk" info */
             fm->last_index = (hsize_t)-1;
             fm->last_chunk_info = NULL;
+
+            /* Put the chunks in order, for I/O and binary searches */
+            if(!fm->sel_chunks->sorted) {
+                HDqsort(fm->sel_chunks->chunk, fm->sel_chunks->nchunks, sizeof(H5D_chunk_info_t *), H5D__chunk_cmp_sel_index);
+                fm->sel_chunks->sorted = TRUE;
+            } /* end if */
+            fm->sel_chunks->use_hash = FALSE;
         } /* end else */
 
         /* Build the memory selection for each chunk */
@@ -1474,6 +1608,193 @@ H5D__chunk_mem_realloc(void *chk, size_t size, const H5O_pline_t *pline)
 } /* H5D__chunk_mem_realloc() */
 
 
+/*-------------------------------------------------------------------------
+ * Function:    H5D__chunk_pool_alloc
+ *
+ * Purpose:     Allocate space for a chunk of the dataset in memory, like
+ *              H5D__chunk_mem_alloc().  Buffers for filtered chunk data
+ *              come from the dataset's pool of free buffers, which is
+ *              searched for the smallest buffer of at least SIZE bytes
+ *              (but no more than twice that, so small requests don't
+ *              take the buffers for whole chunks).  When none fits, a
+ *              new buffer aligned on H5D_CHUNK_POOL_ALIGN bytes is
+ *              allocated.  The size of the buffer is returned in *ALLOC,
+ *              if ALLOC isn't NULL.
+ *
+ *              The buffers may be handed to the filter pipeline like any
+ *              other filtered chunk buffer, so they must be compatible
+ *              with H5MM_realloc() and H5MM_xfree().
+ *
+ * Return:      Pointer to memory for chunk on success/NULL on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+static void *
+H5D__chunk_pool_alloc(H5D_shared_t *shared, size_t size, const H5O_pline_t *pline,
+    size_t *alloc)
+{
+    H5D_rdcc_t  *rdcc = &(shared->cache.chunk);  /* Raw data chunk cache */
+    void        *ret_value = NULL;      /* Return value */
+
+    FUNC_ENTER_STATIC_NOERR
+
+    HDassert(size);
+
+    if(pline && pline->nused) {
+        size_t  best = rdcc->pool.nbufs;    /* Index of the best-fitting buffer */
+        size_t  u;                      /* Local index variable */
+
+        /* Look for the smallest free buffer that fits */
+        for(u = 0; u < rdcc->pool.nbufs; u++)
+            if(rdcc->pool.buf[u].alloc >= size && rdcc->pool.buf[u].alloc / 2 <= size
+                    && (best == rdcc->pool.nbufs || rdcc->pool.buf[u].alloc < rdcc->pool.buf[best].alloc))
+                best = u;
+
+        if(best < rdcc->pool.nbufs) {
+            /* Take the buffer out of the pool */
+            ret_value = rdcc->pool.buf[best].buf;
+            size = rdcc->pool.buf[best].alloc;
+            rdcc->pool.nbytes -= size;
+            rdcc->pool.buf[best] = rdcc->pool.buf[--rdcc->pool.nbufs];
+        } /* end if */
+        else {
+#if defined(H5_HAVE_POSIX_MEMALIGN) && !defined(H5_MEMORY_ALLOC_SANITY_CHECK)
+            if(HDposix_memalign(&ret_value, (size_t)H5D_CHUNK_POOL_ALIGN, size) != 0)
+                ret_value = NULL;
+#else /* defined(H5_HAVE_POSIX_MEMALIGN) && !defined(H5_MEMORY_ALLOC_SANITY_CHECK) */
+            ret_value = H5MM_malloc(size);
+#endif /* defined(H5_HAVE_POSIX_MEMALIGN) && !defined(H5_MEMORY_ALLOC_SANITY_CHECK) */
+        } /* end else */
+    } /* end if */
+    else
+        ret_value = H5D__chunk_mem_alloc(size, pline);
+
+    if(ret_value && alloc)
+        *alloc = size;
+
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* H5D__chunk_pool_alloc() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:    H5D__chunk_pool_free
+ *
+ * Purpose:     Free space for a chunk of the dataset in memory, like
+ *              H5D__chunk_mem_xfree().  ALLOC is the size of the buffer,
+ *              or 0 if it isn't known.  Buffers of known size for
+ *              filtered chunk data are kept in the dataset's pool of free
+ *              buffers for reuse, as long as the pool has room.  The
+ *              pool keeps up to H5D_CHUNK_POOL_NBUFS buffers, holding no
+ *              more than H5D_CHUNK_POOL_NCHUNKS chunks or the size of the
+ *              chunk cache, whichever is less (but always room for one
+ *              chunk, for datasets whose chunks are too large to cache).
+ *              When a buffer doesn't fit, it replaces the smallest
+ *              buffer in the pool if it is larger.
+ *
+ *              Buffers allocated by filters other than deflate end up
+ *              here too, so not all the pooled buffers are aligned.
+ *
+ * Return:      NULL (never fails)
+ *
+ *-------------------------------------------------------------------------
+ */
+static void *
+H5D__chunk_pool_free(H5D_shared_t *shared, void *chk, size_t alloc,
+    const H5O_pline_t *pline)
+{
+    H5D_rdcc_t  *rdcc = &(shared->cache.chunk);  /* Raw data chunk cache */
+
+    FUNC_ENTER_STATIC_NOERR
+
+    if(chk) {
+        if(pline && pline->nused && alloc > 0) {
+            size_t  chunk_size;             /* Size of a chunk */
+            size_t  max_nbytes;             /* Max. # of bytes in the pool */
+
+            H5_CHECKED_ASSIGN(chunk_size, size_t, shared->layout.u.chunk.size, uint32_t);
+            max_nbytes = MIN(H5D_CHUNK_POOL_NCHUNKS * chunk_size, rdcc->nbytes_max);
+            max_nbytes = MAX(max_nbytes, chunk_size);
+
+            /* Make room for the buffer by dropping smaller ones */
+            while(rdcc->pool.nbufs > 0 && (rdcc->pool.nbufs == H5D_CHUNK_POOL_NBUFS
+                    || rdcc->pool.nbytes + alloc > max_nbytes)) {
+                size_t  smallest = 0;       /* Index of the smallest buffer */
+                size_t  u;                  /* Local index variable */
+
+                for(u = 1; u < rdcc->pool.nbufs; u++)
+                    if(rdcc->pool.buf[u].alloc < rdcc->pool.buf[smallest].alloc)
+                        smallest = u;
+                if(rdcc->pool.buf[smallest].alloc >= alloc)
+                    break;
+                H5MM_xfree(rdcc->pool.buf[smallest].buf);
+                rdcc->pool.nbytes -= rdcc->pool.buf[smallest].alloc;
+                rdcc->pool.buf[smallest] = rdcc->pool.buf[--rdcc->pool.nbufs];
+            } /* end while */
+
+            if(rdcc->pool.nbufs < H5D_CHUNK_POOL_NBUFS && rdcc->pool.nbytes + alloc <= max_nbytes) {
+                rdcc->pool.buf[rdcc->pool.nbufs].buf = chk;
+                rdcc->pool.buf[rdcc->pool.nbufs].alloc = alloc;
+                rdcc->pool.nbufs++;
+                rdcc->pool.nbytes += alloc;
+                chk = NULL;
+            } /* end if */
+        } /* end if */
+
+        if(chk)
+            (void)H5D__chunk_mem_xfree(chk, pline);
+    } /* end if */
+
+    FUNC_LEAVE_NOAPI(NULL)
+} /* H5D__chunk_pool_free() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:    H5D__chunk_pool_mem_alloc
+ *
+ * Purpose:     Allocate a buffer for the filter pipeline from the pool of
+ *              free buffers of the dataset in INFO (see H5Z_mem_t).
+ *
+ * Return:      Pointer to the buffer on success/NULL on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+static void *
+H5D__chunk_pool_mem_alloc(size_t size, size_t *alloc, void *info)
+{
+    H5D_shared_t *shared = (H5D_shared_t *)info;    /* Dataset's shared info */
+    void        *ret_value = NULL;      /* Return value */
+
+    FUNC_ENTER_STATIC_NOERR
+
+    ret_value = H5D__chunk_pool_alloc(shared, size, &(shared->dcpl_cache.pline), alloc);
+
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* H5D__chunk_pool_mem_alloc() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:    H5D__chunk_pool_mem_free
+ *
+ * Purpose:     Give a buffer from the filter pipeline back to the pool of
+ *              free buffers of the dataset in INFO (see H5Z_mem_t).
+ *
+ * Return:      void
+ *
+ *-------------------------------------------------------------------------
+ */
+static void
+H5D__chunk_pool_mem_free(void *buf, size_t alloc, void *info)
+{
+    H5D_shared_t *shared = (H5D_shared_t *)info;    /* Dataset's shared info */
+
+    FUNC_ENTER_STATIC_NOERR
+
+    (void)H5D__chunk_pool_free(shared, buf, alloc, &(shared->dcpl_cache.pline));
+
+    FUNC_LEAVE_NOAPI_VOID
+} /* H5D__chunk_pool_mem_free() */
+
+
 /*--------------------------------------------------------------------------
  NAME
     H5D__free_chunk_info
@@ -1481,21 +1802,19 @@ H5D__chunk_mem_realloc(void *chk, size_t size, const H5O_pline_t *pline)
     Internal routine to destroy a chunk info node
  USAGE
     void H5D__free_chunk_info(chunk_info)
-        void *chunk_info;    IN: Pointer to chunk info to destroy
+        H5D_chunk_info_t *chunk_info;    IN: Pointer to chunk info to destroy
  RETURNS
     No return value
  DESCRIPTION
-    Releases all the memory for a chunk info node.  Called by H5SL_free
+    Releases all the memory for a chunk info node.
  GLOBAL VARIABLES
  COMMENTS, BUGS, ASSUMPTIONS
  EXAMPLES
  REVISION LOG
 --------------------------------------------------------------------------*/
 static herr_t
-H5D__free_chunk_info(void *item, void H5_ATTR_UNUSED *key, void H5_ATTR_UNUSED *opdata)
+H5D__free_chunk_info(H5D_chunk_info_t *chunk_info)
 {
-    H5D_chunk_info_t *chunk_info = (H5D_chunk_info_t *)item;
-
     FUNC_ENTER_STATIC_NOERR
 
     HDassert(chunk_info);
@@ -1517,6 +1836,255 @@ H5D__free_chunk_info(void *item, void H5_ATTR_UNUSED *key, void H5_ATTR_UNUSED *
 }   /* H5D__free_chunk_info() */
 
 
+/*-------------------------------------------------------------------------
+ * Function:    H5D__chunk_sel_reserve
+ *
+ * Purpose:     Make room for at least NCHUNKS chunks in the array of
+ *              selected chunks.
+ *
+ * Return:      Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5D__chunk_sel_reserve(H5D_chunk_sel_t *sel, size_t nchunks)
+{
+    herr_t ret_value = SUCCEED;         /* Return value */
+
+    FUNC_ENTER_STATIC
+
+    HDassert(sel);
+
+    if(nchunks > sel->nalloc) {
+        H5D_chunk_info_t **chunk;       /* Reallocated array */
+
+        if(NULL == (chunk = (H5D_chunk_info_t **)H5MM_realloc(sel->chunk, nchunks * sizeof(H5D_chunk_info_t *))))
+            HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "memory allocation failed for selected chunks")
+        sel->chunk = chunk;
+        sel->nalloc = nchunks;
+    } /* end if */
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5D__chunk_sel_reserve() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:    H5D__chunk_sel_trim
+ *
+ * Purpose:     Shrink the array of selected chunks to the number of chunks
+ *              in it, after it was grown past that while they were added.
+ *
+ * Return:      Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5D__chunk_sel_trim(H5D_chunk_sel_t *sel)
+{
+    herr_t ret_value = SUCCEED;         /* Return value */
+
+    FUNC_ENTER_STATIC
+
+    HDassert(sel);
+
+    if(sel->nchunks > 0 && sel->nchunks < sel->nalloc) {
+        H5D_chunk_info_t **chunk;       /* Reallocated array */
+
+        if(NULL == (chunk = (H5D_chunk_info_t **)H5MM_realloc(sel->chunk, sel->nchunks * sizeof(H5D_chunk_info_t *))))
+            HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "memory allocation failed for selected chunks")
+        sel->chunk = chunk;
+        sel->nalloc = sel->nchunks;
+    } /* end if */
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5D__chunk_sel_trim() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:    H5D__chunk_sel_hash_build
+ *
+ * Purpose:     Start using a hash table of 2^BITS slots (at least) to
+ *              look up the selected chunks by chunk index, and add the
+ *              chunks already selected to it.  The table is reused from
+ *              earlier I/O operations when it's big enough.
+ *
+ * Return:      Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5D__chunk_sel_hash_build(H5D_chunk_sel_t *sel, unsigned bits)
+{
+    size_t      nslots;                 /* Number of slots in the table */
+    size_t      n;                      /* Local index variable */
+    herr_t      ret_value = SUCCEED;    /* Return value */
+
+    FUNC_ENTER_STATIC
+
+    HDassert(sel);
+    HDassert(bits > 0 && bits < 8 * sizeof(size_t));
+
+    /* Allocate the table, if the current one is too small */
+    if(bits > sel->hash_bits) {
+        sel->hash = (size_t *)H5MM_xfree(sel->hash);
+        sel->hash_bits = 0;
+        if(NULL == (sel->hash = (size_t *)H5MM_malloc(((size_t)1 << bits) * sizeof(size_t))))
+            HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "memory allocation failed for selected chunk hash table")
+        sel->hash_bits = bits;
+    } /* end if */
+    nslots = (size_t)1 << sel->hash_bits;
+    HDmemset(sel->hash, 0, nslots * sizeof(size_t));
+
+    /* Add the chunks, with linear probing */
+    for(n = 0; n < sel->nchunks; n++) {
+        size_t slot = H5D_CHUNK_SEL_HASH(sel->chunk[n]->index, sel->hash_bits);
+
+        while(sel->hash[slot])
+            slot = (slot + 1) & (nslots - 1);
+        sel->hash[slot] = n + 1;
+    } /* end for */
+    sel->use_hash = TRUE;
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5D__chunk_sel_hash_build() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:    H5D__chunk_sel_append
+ *
+ * Purpose:     Append a chunk to the array of selected chunks, growing
+ *              the array as needed.  Chunks selected by hyperslab and
+ *              "all" selections are appended in order of chunk index, so
+ *              the array is built sorted without any searching; when the
+ *              hash table is in use, the chunk is added to it as well.
+ *
+ * Return:      Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5D__chunk_sel_append(H5D_chunk_sel_t *sel, H5D_chunk_info_t *chunk_info)
+{
+    herr_t      ret_value = SUCCEED;    /* Return value */
+
+    FUNC_ENTER_STATIC
+
+    HDassert(sel);
+    HDassert(chunk_info);
+
+    /* Grow the array, doubling its size */
+    if(sel->nchunks == sel->nalloc)
+        if(H5D__chunk_sel_reserve(sel, MAX(2 * sel->nalloc, 16)) < 0)
+            HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "can't grow array of selected chunks")
+
+    if(sel->nchunks > 0 && chunk_info->index < sel->chunk[sel->nchunks - 1]->index)
+        sel->sorted = FALSE;
+    sel->chunk[sel->nchunks++] = chunk_info;
+
+    if(sel->use_hash) {
+        /* Keep the table at most half full */
+        if(2 * sel->nchunks > ((size_t)1 << sel->hash_bits)) {
+            if(H5D__chunk_sel_hash_build(sel, sel->hash_bits + 1) < 0)
+                HGOTO_ERROR(H5E_DATASET, H5E_CANTINIT, FAIL, "can't grow hash table of selected chunks")
+        } /* end if */
+        else {
+            size_t nslots = (size_t)1 << sel->hash_bits;
+            size_t slot = H5D_CHUNK_SEL_HASH(chunk_info->index, sel->hash_bits);
+
+            while(sel->hash[slot])
+                slot = (slot + 1) & (nslots - 1);
+            sel->hash[slot] = sel->nchunks;
+        } /* end else */
+    } /* end if */
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5D__chunk_sel_append() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:    H5D__chunk_cmp_sel_index
+ *
+ * Purpose:     Compare two selected chunks by chunk index, for HDqsort().
+ *
+ * Return:      -1, 0 or 1
+ *
+ *-------------------------------------------------------------------------
+ */
+static int
+H5D__chunk_cmp_sel_index(const void *_info1, const void *_info2)
+{
+    const H5D_chunk_info_t *info1 = *(const H5D_chunk_info_t * const *)_info1;
+    const H5D_chunk_info_t *info2 = *(const H5D_chunk_info_t * const *)_info2;
+    int ret_value = 0;                  /* Return value */
+
+    FUNC_ENTER_STATIC_NOERR
+
+    ret_value = (info1->index > info2->index) - (info1->index < info2->index);
+
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5D__chunk_cmp_sel_index() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:    H5D__chunk_sel_find
+ *
+ * Purpose:     Look a chunk up by chunk index in the selected chunks, in
+ *              the hash table while the selection is being built for a
+ *              point selection, or with a binary search in the sorted
+ *              array otherwise.
+ *
+ * Return:      Pointer to the chunk's information, or NULL if the chunk
+ *              isn't selected
+ *
+ *-------------------------------------------------------------------------
+ */
+H5D_chunk_info_t *
+H5D__chunk_sel_find(const H5D_chunk_sel_t *sel, hsize_t index)
+{
+    H5D_chunk_info_t *ret_value = NULL;     /* Return value */
+
+    FUNC_ENTER_PACKAGE_NOERR
+
+    HDassert(sel);
+
+    if(sel->use_hash) {
+        size_t nslots = (size_t)1 << sel->hash_bits;
+        size_t slot = H5D_CHUNK_SEL_HASH(index, sel->hash_bits);
+
+        while(sel->hash[slot]) {
+            if(sel->chunk[sel->hash[slot] - 1]->index == index) {
+                ret_value = sel->chunk[sel->hash[slot] - 1];
+                break;
+            } /* end if */
+            slot = (slot + 1) & (nslots - 1);
+        } /* end while */
+    } /* end if */
+    else {
+        size_t lo = 0, hi = sel->nchunks;   /* Bounds of the search */
+
+        HDassert(sel->sorted);
+        while(lo < hi) {
+            size_t mid = lo + (hi - lo) / 2;
+
+            if(sel->chunk[mid]->index < index)
+                lo = mid + 1;
+            else if(sel->chunk[mid]->index > index)
+                hi = mid;
+            else {
+                ret_value = sel->chunk[mid];
+                break;
+            } /* end else */
+        } /* end while */
+    } /* end else */
+
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5D__chunk_sel_find() */
+
+
 /*-------------------------------------------------------------------------
  * Function:    H5D__create_chunk_map_single
  *
@@ -1536,7 +2104,7 @@ H5D__create_chunk_map_single(H5D_chunk_map_t *fm, const H5D_io_info_t
 #endif /* H5_HAVE_PARALLEL */
     *io_info)
 {
-    H5D_chunk_info_t *chunk_info;           /* Chunk information to insert into skip list */
+    H5D_chunk_info_t *chunk_info;           /* Chunk information to insert into list */
     hsize_t     coords[H5O_LAYOUT_NDIMS];   /* Coordinates of chunk */
     hsize_t     sel_start[H5O_LAYOUT_NDIMS]; /* Offset of low bound of file selection */
     hsize_t     sel_end[H5O_LAYOUT_NDIMS];  /* Offset of high bound of file selection */
@@ -1677,13 +2245,17 @@ H5D__create_chunk_file_map_all(H5D_chunk_map_t *fm, const H5D_io_info_t
     /* Set the index of this chunk */
     chunk_index = 0;
 
+    /* Every chunk is selected, so make room for all of them up front */
+    if(H5D__chunk_sel_reserve(fm->sel_chunks, (size_t)fm->layout->u.chunk.nchunks) < 0)
+        HGOTO_ERROR(H5E_DATASET, H5E_CANTALLOC, FAIL, "can't allocate array of selected chunks")
+
     /* Create "temporary" chunk for selection operations (copy file space) */
     if(NULL == (tmp_fchunk = H5S_create_simple(fm->f_ndims, fm->chunk_dim, NULL)))
         HGOTO_ERROR(H5E_DATASET, H5E_CANTCREATE, FAIL, "unable to create dataspace for chunk")
 
     /* Iterate through each chunk in the dataset */
     while(sel_points) {
-        H5D_chunk_info_t *new_chunk_info;   /* chunk information to insert into skip list */
+        H5D_chunk_info_t *new_chunk_info;   /* chunk information to insert into list */
         hsize_t    chunk_points;            /* Number of elements in chunk selection */
 
         /* Add temporary chunk to the list of chunks */
@@ -1721,10 +2293,10 @@ H5D__create_chunk_file_map_all(H5D_chunk_map_t *fm, const H5D_io_info_t
         H5MM_memcpy(new_chunk_info->scaled, scaled, sizeof(hsize_t) * fm->f_ndims);
         new_chunk_info->scaled[fm->f_ndims] = 0;
 
-        /* Insert the new chunk into the skip list */
-        if(H5SL_insert(fm->sel_chunks, new_chunk_info, &new_chunk_info->index) < 0) {
-            H5D__free_chunk_info(new_chunk_info, NULL, NULL);
-            HGOTO_ERROR(H5E_DATASPACE, H5E_CANTINSERT, FAIL, "can't insert chunk into skip list")
+        /* Append the new chunk to the list of selected chunks */
+        if(H5D__chunk_sel_append(fm->sel_chunks, new_chunk_info) < 0) {
+            H5D__free_chunk_info(new_chunk_info);
+            HGOTO_ERROR(H5E_DATASPACE, H5E_CANTINSERT, FAIL, "can't insert chunk into list of selected chunks")
         } /* end if */
 
         /* Get number of elements selected in chunk */
@@ -1807,131 +2379,328 @@ done:
 
 
 /*-------------------------------------------------------------------------
- * Function:    H5D__create_chunk_file_map_hyper
- *
- * Purpose:    Create all chunk selections in file, for a hyperslab selection.
+ * Function:    H5D__chunk_file_map_add
  *
- * Return:    Non-negative on success/Negative on failure
+ * Purpose:     Add the chunk at COORDS (with scaled coordinates SCALED and
+ *              index CHUNK_INDEX) to the chunks selected in the file,
+ *              with the part of the file selection that falls in it.  The
+ *              number of elements selected in the chunk is returned in
+ *              *CHUNK_POINTS.
  *
- * Programmer:    Quincey Koziol
- *        Thursday, May 29, 2003
+ * Return:      Non-negative on success/Negative on failure
  *
  *-------------------------------------------------------------------------
  */
 static herr_t
-H5D__create_chunk_file_map_hyper(H5D_chunk_map_t *fm, const H5D_io_info_t
+H5D__chunk_file_map_add(H5D_chunk_map_t *fm, const H5D_io_info_t
 #ifndef H5_HAVE_PARALLEL
     H5_ATTR_UNUSED
 #endif /* H5_HAVE_PARALLEL */
-    *io_info)
+    *io_info, hsize_t chunk_index, const hsize_t *coords, const hsize_t *scaled,
+    hsize_t *chunk_points)
 {
     H5S_t       *tmp_fchunk = NULL;         /* Temporary file dataspace */
-    hsize_t     sel_start[H5O_LAYOUT_NDIMS]; /* Offset of low bound of file selection */
-    hsize_t     sel_end[H5O_LAYOUT_NDIMS];  /* Offset of high bound of file selection */
-    hsize_t     sel_points;                 /* Number of elements in file selection */
-    hsize_t     start_coords[H5O_LAYOUT_NDIMS];   /* Starting coordinates of selection */
-    hsize_t     coords[H5O_LAYOUT_NDIMS];   /* Current coordinates of chunk */
-    hsize_t     end[H5O_LAYOUT_NDIMS];      /* Final coordinates of chunk */
-    hsize_t     chunk_index;                /* Index of chunk */
-    hsize_t     start_scaled[H5S_MAX_RANK]; /* Starting scaled coordinates of selection */
-    hsize_t     scaled[H5S_MAX_RANK];       /* Scaled coordinates for this chunk */
-    int         curr_dim;                   /* Current dimension to increment */
-    unsigned    u;                          /* Local index variable */
-    herr_t    ret_value = SUCCEED;        /* Return value */
+    H5D_chunk_info_t *new_chunk_info;       /* chunk information to insert into list */
+    herr_t      ret_value = SUCCEED;        /* Return value */
 
     FUNC_ENTER_STATIC
 
-    /* Sanity check */
-    HDassert(fm->f_ndims > 0);
+    /* Create dataspace for chunk, 'AND'ing the overall selection with
+     *  the current chunk.
+     */
+    if(H5S_combine_hyperslab(fm->file_space, H5S_SELECT_AND, coords, NULL, fm->chunk_dim, NULL, &tmp_fchunk) < 0)
+        HGOTO_ERROR(H5E_DATASPACE, H5E_CANTCOPY, FAIL, "unable to combine file space selection with chunk block")
 
-    /* Get number of elements selected in file */
-    sel_points = fm->nelmts;
+    /* Resize chunk's dataspace dimensions to size of chunk */
+    if(H5S_set_extent_real(tmp_fchunk, fm->chunk_dim) < 0)
+        HGOTO_ERROR(H5E_DATASET, H5E_CANTSELECT, FAIL, "can't adjust chunk dimensions")
 
-    /* Get bounding box for selection (to reduce the number of chunks to iterate over) */
-    if(H5S_SELECT_BOUNDS(fm->file_space, sel_start, sel_end) < 0)
-        HGOTO_ERROR(H5E_DATASPACE, H5E_CANTGET, FAIL, "can't get file selection bound info")
+    /* Move selection back to have correct offset in chunk */
+    if(H5S_SELECT_ADJUST_U(tmp_fchunk, coords) < 0)
+        HGOTO_ERROR(H5E_DATASET, H5E_CANTSELECT, FAIL, "can't adjust chunk selection")
 
-    /* Set initial chunk location & hyperslab size */
+    /* Add temporary chunk to the list of chunks */
+
+    /* Allocate the file & memory chunk information */
+    if(NULL == (new_chunk_info = H5FL_MALLOC(H5D_chunk_info_t)))
+        HGOTO_ERROR(H5E_DATASET, H5E_CANTALLOC, FAIL, "can't allocate chunk info")
+
+    /* Initialize the chunk information */
+
+    /* Set the chunk index */
+    new_chunk_info->index = chunk_index;
+
+#ifdef H5_HAVE_PARALLEL
+    /* Store chunk selection information, for multi-chunk I/O */
+    if(io_info->using_mpi_vfd)
+        fm->select_chunk[chunk_index] = new_chunk_info;
+#endif /* H5_HAVE_PARALLEL */
+
+    /* Set the file chunk dataspace */
+    new_chunk_info->fspace = tmp_fchunk;
+    new_chunk_info->fspace_shared = FALSE;
+    tmp_fchunk = NULL;
+
+    /* Set the memory chunk dataspace */
+    new_chunk_info->mspace = NULL;
+    new_chunk_info->mspace_shared = FALSE;
+
+    /* Copy the chunk's scaled coordinates */
+    H5MM_memcpy(new_chunk_info->scaled, scaled, sizeof(hsize_t) * fm->f_ndims);
+    new_chunk_info->scaled[fm->f_ndims] = 0;
+
+    /* Append the new chunk to the list of selected chunks */
+    if(H5D__chunk_sel_append(fm->sel_chunks, new_chunk_info) < 0) {
+        H5D__free_chunk_info(new_chunk_info);
+        HGOTO_ERROR(H5E_DATASPACE, H5E_CANTINSERT, FAIL, "can't insert chunk into list of selected chunks")
+    } /* end if */
+
+    /* Get number of elements selected in chunk */
+    *chunk_points = H5S_GET_SELECT_NPOINTS(new_chunk_info->fspace);
+    H5_CHECKED_ASSIGN(new_chunk_info->chunk_points, uint32_t, *chunk_points, hsize_t);
+
+done:
+    /* Clean up on failure */
+    if(ret_value < 0)
+        if(tmp_fchunk && H5S_close(tmp_fchunk) < 0)
+            HDONE_ERROR(H5E_DATASET, H5E_CANTRELEASE, FAIL, "can't release temporary dataspace")
+
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5D__chunk_file_map_add() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:    H5D__create_chunk_file_map_regular
+ *
+ * Purpose:     Create all chunk selections in file, for a regular
+ *              hyperslab selection (START, STRIDE, COUNT and BLOCK, with
+ *              blocks that don't overlap).
+ *
+ *              A chunk holds part of a regular hyperslab if, and only if,
+ *              its range in every dimension holds part of the selection
+ *              in that dimension.  The ranges of chunks that do are
+ *              worked out separately for each dimension, which takes
+ *              time in proportion to the chunks along the dimensions
+ *              instead of the chunks in the selection's bounding box.
+ *              The selected chunks are then the combinations of those
+ *              ranges, visited in order of chunk index, and their number
+ *              is known before any of them is added.
+ *
+ * Return:      Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5D__create_chunk_file_map_regular(H5D_chunk_map_t *fm, const H5D_io_info_t *io_info,
+    const hsize_t *start, const hsize_t *stride, const hsize_t *count,
+    const hsize_t *block)
+{
+    hsize_t     *dim_scaled = NULL;         /* Scaled coordinates of the chunks selected along each dimension */
+    hsize_t     *dim_chunks[H5O_LAYOUT_NDIMS]; /* Start of each dimension's part of 'dim_scaled' */
+    size_t      dim_nchunks[H5O_LAYOUT_NDIMS]; /* # of chunks selected along each dimension */
+    size_t      dim_idx[H5O_LAYOUT_NDIMS];  /* Current position in each dimension's chunks */
+    hsize_t     coords[H5O_LAYOUT_NDIMS];   /* Current coordinates of chunk */
+    hsize_t     scaled[H5S_MAX_RANK];       /* Scaled coordinates for this chunk */
+    hsize_t     first[H5O_LAYOUT_NDIMS];    /* First chunk along each dimension holding part of the selection's bounds */
+    hsize_t     sel_points;                 /* Number of elements in file selection */
+    size_t      nscaled = 0;                /* Total # of chunks along all dimensions */
+    size_t      nchunks = 1;                /* # of chunks selected */
+    int         curr_dim;                   /* Current dimension to increment */
+    unsigned    u;                          /* Local index variable */
+    herr_t      ret_value = SUCCEED;        /* Return value */
+
+    FUNC_ENTER_STATIC
+
+    /* Sanity check */
+    HDassert(fm->f_ndims > 0);
+
+    /* Get number of elements selected in file */
+    sel_points = fm->nelmts;
+
+    /* Find the range of chunks in each dimension covering the selection */
     for(u = 0; u < fm->f_ndims; u++) {
+        hsize_t last;               /* Last element selected in this dimension */
+
         /* Validate this chunk dimension */
         if(fm->layout->u.chunk.dim[u] == 0)
             HGOTO_ERROR(H5E_DATASET, H5E_BADVALUE, FAIL, "chunk size must be > 0, dim = %u ", u)
-        scaled[u] = start_scaled[u] = sel_start[u] / fm->layout->u.chunk.dim[u];
-        coords[u] = start_coords[u] = scaled[u] * fm->layout->u.chunk.dim[u];
-        end[u] = (coords[u] + fm->chunk_dim[u]) - 1;
+        HDassert(count[u] > 0 && block[u] > 0 && stride[u] >= block[u]);
+        last = start[u] + (count[u] - 1) * stride[u] + block[u] - 1;
+        first[u] = start[u] / fm->layout->u.chunk.dim[u];
+        dim_nchunks[u] = (size_t)((last / fm->layout->u.chunk.dim[u]) - first[u] + 1);
+        nscaled += dim_nchunks[u];
     } /* end for */
+    if(NULL == (dim_scaled = (hsize_t *)H5MM_malloc(nscaled * sizeof(hsize_t))))
+        HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "memory allocation failed for chunk coordinates")
 
-    /* Calculate the index of this chunk */
-    chunk_index = H5VM_array_offset_pre(fm->f_ndims, fm->layout->u.chunk.down_chunks, scaled);
+    /* Keep the chunks in each dimension's range that hold part of the
+     * selection, i.e. that don't fall in a gap between two blocks */
+    nscaled = 0;
+    for(u = 0; u < fm->f_ndims; u++) {
+        hsize_t chunk_dim = fm->layout->u.chunk.dim[u];   /* Chunk size in this dimension */
+        hsize_t n;                  /* Local index variable */
+        size_t  range = dim_nchunks[u];     /* # of chunks in the dimension's range */
+
+        dim_chunks[u] = dim_scaled + nscaled;
+        dim_nchunks[u] = 0;
+        for(n = first[u]; n < first[u] + range; n++) {
+            hsize_t lo = MAX(n * chunk_dim, start[u]);    /* First element of the chunk that could be selected */
+            hsize_t hi = (n + 1) * chunk_dim - 1;         /* Last element of the chunk */
+            hsize_t blk;                /* Block holding or preceding 'lo' */
+
+            /* The chunk holds part of the selection if the block at or
+             * before its first element reaches into it, or the next
+             * block starts in it */
+            blk = MIN((lo - start[u]) / stride[u], count[u] - 1);
+            if(start[u] + blk * stride[u] + block[u] - 1 >= lo
+                    || (blk + 1 < count[u] && start[u] + (blk + 1) * stride[u] <= hi))
+                dim_chunks[u][dim_nchunks[u]++] = n;
+        } /* end for */
+        nscaled += dim_nchunks[u];
+        nchunks *= dim_nchunks[u];
+        HDassert(dim_nchunks[u] > 0);
+    } /* end for */
 
-    /* Iterate through each chunk in the dataset */
+    /* Make room for exactly the chunks selected */
+    if(H5D__chunk_sel_reserve(fm->sel_chunks, nchunks) < 0)
+        HGOTO_ERROR(H5E_DATASET, H5E_CANTALLOC, FAIL, "can't allocate array of selected chunks")
+
+    /* Start with the first selected chunk */
+    for(u = 0; u < fm->f_ndims; u++) {
+        dim_idx[u] = 0;
+        scaled[u] = dim_chunks[u][0];
+        coords[u] = scaled[u] * fm->layout->u.chunk.dim[u];
+    } /* end for */
+
+    /* Iterate through the selected chunks, in order of chunk index */
     while(sel_points) {
-        /* Check for intersection of current chunk and file selection */
-        /* (Casting away const OK - QAK) */
-        if(TRUE == H5S_SELECT_INTERSECT_BLOCK(fm->file_space, coords, end)) {
-            H5D_chunk_info_t *new_chunk_info;   /* chunk information to insert into skip list */
-            hsize_t    chunk_points;            /* Number of elements in chunk selection */
+        hsize_t chunk_index;        /* Index of chunk */
+        hsize_t chunk_points;       /* Number of elements in chunk selection */
 
-            /* Create dataspace for chunk, 'AND'ing the overall selection with
-             *  the current chunk.
-             */
-            if(H5S_combine_hyperslab(fm->file_space, H5S_SELECT_AND, coords, NULL, fm->chunk_dim, NULL, &tmp_fchunk) < 0)
-                HGOTO_ERROR(H5E_DATASPACE, H5E_CANTCOPY, FAIL, "unable to combine file space selection with chunk block")
+        /* Add the chunk */
+        chunk_index = H5VM_array_offset_pre(fm->f_ndims, fm->layout->u.chunk.down_chunks, scaled);
+        if(H5D__chunk_file_map_add(fm, io_info, chunk_index, coords, scaled, &chunk_points) < 0)
+            HGOTO_ERROR(H5E_DATASET, H5E_CANTINSERT, FAIL, "can't add chunk to selected chunks")
+        HDassert(chunk_points > 0 && chunk_points <= sel_points);
 
-            /* Resize chunk's dataspace dimensions to size of chunk */
-            if(H5S_set_extent_real(tmp_fchunk, fm->chunk_dim) < 0)
-                HGOTO_ERROR(H5E_DATASET, H5E_CANTSELECT, FAIL, "can't adjust chunk dimensions")
+        /* Decrement # of points left in file selection */
+        sel_points -= chunk_points;
 
-            /* Move selection back to have correct offset in chunk */
-            if(H5S_SELECT_ADJUST_U(tmp_fchunk, coords) < 0)
-                HGOTO_ERROR(H5E_DATASET, H5E_CANTSELECT, FAIL, "can't adjust chunk selection")
+        /* Move to the next chunk, in the fastest changing dimension first */
+        curr_dim = (int)fm->f_ndims - 1;
+        while(curr_dim >= 0 && ++dim_idx[curr_dim] == dim_nchunks[curr_dim]) {
+            dim_idx[curr_dim] = 0;
+            scaled[curr_dim] = dim_chunks[curr_dim][0];
+            coords[curr_dim] = scaled[curr_dim] * fm->layout->u.chunk.dim[curr_dim];
+            curr_dim--;
+        } /* end while */
+        if(curr_dim < 0)
+            break;
+        scaled[curr_dim] = dim_chunks[curr_dim][dim_idx[curr_dim]];
+        coords[curr_dim] = scaled[curr_dim] * fm->layout->u.chunk.dim[curr_dim];
+    } /* end while */
+    HDassert(sel_points == 0);
+    HDassert(fm->sel_chunks->nchunks == nchunks);
 
-            /* Add temporary chunk to the list of chunks */
+done:
+    dim_scaled = (hsize_t *)H5MM_xfree(dim_scaled);
 
-            /* Allocate the file & memory chunk information */
-            if(NULL == (new_chunk_info = H5FL_MALLOC(H5D_chunk_info_t)))
-                HGOTO_ERROR(H5E_DATASET, H5E_CANTALLOC, FAIL, "can't allocate chunk info")
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5D__create_chunk_file_map_regular() */
 
-            /* Initialize the chunk information */
 
-            /* Set the chunk index */
-            new_chunk_info->index = chunk_index;
+/*-------------------------------------------------------------------------
+ * Function:    H5D__create_chunk_file_map_hyper
+ *
+ * Purpose:    Create all chunk selections in file, for a hyperslab selection.
+ *
+ *              Regular hyperslabs are mapped with
+ *              H5D__create_chunk_file_map_regular().  For others, each
+ *              chunk in the selection's bounding box is checked for
+ *              holding part of the selection.
+ *
+ * Return:    Non-negative on success/Negative on failure
+ *
+ * Programmer:    Quincey Koziol
+ *        Thursday, May 29, 2003
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5D__create_chunk_file_map_hyper(H5D_chunk_map_t *fm, const H5D_io_info_t *io_info)
+{
+    hsize_t     sel_start[H5O_LAYOUT_NDIMS]; /* Offset of low bound of file selection */
+    hsize_t     sel_end[H5O_LAYOUT_NDIMS];  /* Offset of high bound of file selection */
+    hsize_t     sel_stride[H5O_LAYOUT_NDIMS]; /* Stride of regular file selection */
+    hsize_t     sel_count[H5O_LAYOUT_NDIMS]; /* Count of regular file selection */
+    hsize_t     sel_block[H5O_LAYOUT_NDIMS]; /* Block of regular file selection */
+    hsize_t     sel_points;                 /* Number of elements in file selection */
+    hsize_t     start_coords[H5O_LAYOUT_NDIMS];   /* Starting coordinates of selection */
+    hsize_t     coords[H5O_LAYOUT_NDIMS];   /* Current coordinates of chunk */
+    hsize_t     end[H5O_LAYOUT_NDIMS];      /* Final coordinates of chunk */
+    hsize_t     chunk_index;                /* Index of chunk */
+    hsize_t     start_scaled[H5S_MAX_RANK]; /* Starting scaled coordinates of selection */
+    hsize_t     scaled[H5S_MAX_RANK];       /* Scaled coordinates for this chunk */
+    size_t      nalloc;                     /* Size of the array of selected chunks before adding them */
+    int         curr_dim;                   /* Current dimension to increment */
+    unsigned    u;                          /* Local index variable */
+    herr_t    ret_value = SUCCEED;        /* Return value */
 
-#ifdef H5_HAVE_PARALLEL
-            /* Store chunk selection information, for multi-chunk I/O */
-            if(io_info->using_mpi_vfd)
-                fm->select_chunk[chunk_index] = new_chunk_info;
-#endif /* H5_HAVE_PARALLEL */
+    FUNC_ENTER_STATIC
 
-            /* Set the file chunk dataspace */
-            new_chunk_info->fspace = tmp_fchunk;
-            new_chunk_info->fspace_shared = FALSE;
-            tmp_fchunk = NULL;
+    /* Sanity check */
+    HDassert(fm->f_ndims > 0);
 
-            /* Set the memory chunk dataspace */
-            new_chunk_info->mspace = NULL;
-            new_chunk_info->mspace_shared = FALSE;
+    /* Map regular hyperslabs without checking every chunk */
+    if(TRUE == H5S_hyper_get_regular(fm->file_space, sel_start, sel_stride, sel_count, sel_block)) {
+        if(H5D__create_chunk_file_map_regular(fm, io_info, sel_start, sel_stride, sel_count, sel_block) < 0)
+            HGOTO_ERROR(H5E_DATASET, H5E_CANTSELECT, FAIL, "can't map regular hyperslab selection to chunks")
+        HGOTO_DONE(SUCCEED)
+    } /* end if */
 
-            /* Copy the chunk's scaled coordinates */
-        H5MM_memcpy(new_chunk_info->scaled, scaled, sizeof(hsize_t) * fm->f_ndims);
-            new_chunk_info->scaled[fm->f_ndims] = 0;
+    /* Get number of elements selected in file */
+    sel_points = fm->nelmts;
 
-            /* Insert the new chunk into the skip list */
-            if(H5SL_insert(fm->sel_chunks, new_chunk_info, &new_chunk_info->index) < 0) {
-                H5D__free_chunk_info(new_chunk_info, NULL, NULL);
-                HGOTO_ERROR(H5E_DATASPACE, H5E_CANTINSERT, FAIL, "can't insert chunk into skip list")
-            } /* end if */
+    /* Get bounding box for selection (to reduce the number of chunks to iterate over) */
+    if(H5S_SELECT_BOUNDS(fm->file_space, sel_start, sel_end) < 0)
+        HGOTO_ERROR(H5E_DATASPACE, H5E_CANTGET, FAIL, "can't get file selection bound info")
+
+    /* Set initial chunk location & hyperslab size */
+    for(u = 0; u < fm->f_ndims; u++) {
+        /* Validate this chunk dimension */
+        if(fm->layout->u.chunk.dim[u] == 0)
+            HGOTO_ERROR(H5E_DATASET, H5E_BADVALUE, FAIL, "chunk size must be > 0, dim = %u ", u)
+        scaled[u] = start_scaled[u] = sel_start[u] / fm->layout->u.chunk.dim[u];
+        coords[u] = start_coords[u] = scaled[u] * fm->layout->u.chunk.dim[u];
+        end[u] = (coords[u] + fm->chunk_dim[u]) - 1;
+    } /* end for */
+
+    /* The number of chunks selected isn't known, as the bounding box may
+     * hold many chunks that aren't, so the array grows as chunks are
+     * added and is trimmed afterwards.  The chunks are visited in order
+     * of chunk index, so the array is built without searching. */
+    nalloc = fm->sel_chunks->nalloc;
+
+    /* Calculate the index of this chunk */
+    chunk_index = H5VM_array_offset_pre(fm->f_ndims, fm->layout->u.chunk.down_chunks, scaled);
+
+    /* Iterate through each chunk in the dataset */
+    while(sel_points) {
+        /* Check for intersection of current chunk and file selection */
+        /* (Casting away const OK - QAK) */
+        if(TRUE == H5S_SELECT_INTERSECT_BLOCK(fm->file_space, coords, end)) {
+            hsize_t    chunk_points;            /* Number of elements in chunk selection */
 
-            /* Get number of elements selected in chunk */
-            chunk_points = H5S_GET_SELECT_NPOINTS(new_chunk_info->fspace);
-            H5_CHECKED_ASSIGN(new_chunk_info->chunk_points, uint32_t, chunk_points, hsize_t);
+            /* Add the chunk */
+            if(H5D__chunk_file_map_add(fm, io_info, chunk_index, coords, scaled, &chunk_points) < 0)
+                HGOTO_ERROR(H5E_DATASET, H5E_CANTINSERT, FAIL, "can't add chunk to selected chunks")
 
             /* Decrement # of points left in file selection */
             sel_points -= chunk_points;
 
             /* Leave if we are done */
             if(sel_points == 0)
-                HGOTO_DONE(SUCCEED)
+                break;
         } /* end if */
 
         /* Increment chunk index */
@@ -1970,12 +2739,12 @@ H5D__create_chunk_file_map_hyper(H5D_chunk_map_t *fm, const H5D_io_info_t
         } /* end if */
     } /* end while */
 
-done:
-    /* Clean up on failure */
-    if(ret_value < 0)
-        if(tmp_fchunk && H5S_close(tmp_fchunk) < 0)
-            HDONE_ERROR(H5E_DATASET, H5E_CANTRELEASE, FAIL, "can't release temporary dataspace")
+    /* Release the room left over, if the array was grown for these chunks */
+    if(fm->sel_chunks->nalloc > nalloc)
+        if(H5D__chunk_sel_trim(fm->sel_chunks) < 0)
+            HGOTO_ERROR(H5E_DATASET, H5E_CANTALLOC, FAIL, "can't trim array of selected chunks")
 
+done:
     FUNC_LEAVE_NOAPI(ret_value)
 } /* end H5D__create_chunk_file_map_hyper() */
 
@@ -2000,7 +2769,7 @@ static herr_t
 H5D__create_chunk_mem_map_hyper(const H5D_chunk_map_t *fm)
 {
     H5D_chunk_info_t *chunk_info;           /* Pointer to chunk information */
-    H5SL_node_t *curr_node;                 /* Current node in skip list */
+    size_t      n;                          /* Local index variable */
     hsize_t     file_sel_start[H5S_MAX_RANK];    /* Offset of low bound of file selection */
     hsize_t     file_sel_end[H5S_MAX_RANK]; /* Offset of high bound of file selection */
     hsize_t     mem_sel_start[H5S_MAX_RANK]; /* Offset of low bound of file selection */
@@ -2015,12 +2784,9 @@ H5D__create_chunk_mem_map_hyper(const H5D_chunk_map_t *fm)
     HDassert(fm->f_ndims>0);
 
     /* Check for all I/O going to a single chunk */
-    if(H5SL_count(fm->sel_chunks)==1) {
-        /* Get the node */
-        curr_node = H5SL_first(fm->sel_chunks);
-
+    if(fm->sel_chunks->nchunks == 1) {
         /* Get pointer to chunk's information */
-        chunk_info = (H5D_chunk_info_t *)H5SL_item(curr_node);
+        chunk_info = fm->sel_chunks->chunk[0];
         HDassert(chunk_info);
 
         /* Just point at the memory dataspace & selection */
@@ -2048,14 +2814,13 @@ H5D__create_chunk_mem_map_hyper(const H5D_chunk_map_t *fm)
         } /* end for */
 
         /* Iterate over each chunk in the chunk list */
-        curr_node = H5SL_first(fm->sel_chunks);
-        while(curr_node) {
+        for(n = 0; n < fm->sel_chunks->nchunks; n++) {
             hsize_t coords[H5S_MAX_RANK];   /* Current coordinates of chunk */
             hssize_t chunk_adjust[H5S_MAX_RANK]; /* Adjustment to make to a particular chunk */
             H5S_sel_type chunk_sel_type;    /* Chunk's selection type */
 
             /* Get pointer to chunk's information */
-            chunk_info = (H5D_chunk_info_t *)H5SL_item(curr_node);
+            chunk_info = fm->sel_chunks->chunk[n];
             HDassert(chunk_info);
 
             /* Compute the chunk coordinates from the scaled coordinates */
@@ -2101,10 +2866,7 @@ H5D__create_chunk_mem_map_hyper(const H5D_chunk_map_t *fm)
                 if(H5S_SELECT_ADJUST_S(chunk_info->mspace, chunk_adjust) < 0)
                     HGOTO_ERROR(H5E_DATASET, H5E_CANTSET, FAIL, "unable to adjust selection")
             } /* end else */
-
-            /* Get the next chunk node in the skip list */
-            curr_node = H5SL_next(curr_node);
-        } /* end while */
+        } /* end for */
     } /* end else */
 
 done:
@@ -2129,7 +2891,7 @@ static herr_t
 H5D__create_chunk_mem_map_1d(const H5D_chunk_map_t *fm)
 {
     H5D_chunk_info_t *chunk_info;           /* Pointer to chunk information */
-    H5SL_node_t *curr_node;                 /* Current node in skip list */
+    size_t      n;                          /* Local index variable */
     herr_t	ret_value = SUCCEED;            /* Return value */
 
     FUNC_ENTER_STATIC
@@ -2138,12 +2900,9 @@ H5D__create_chunk_mem_map_1d(const H5D_chunk_map_t *fm)
     HDassert(fm->f_ndims>0);
 
     /* Check for all I/O going to a single chunk */
-    if(H5SL_count(fm->sel_chunks)==1) {
-        /* Get the node */
-        curr_node = H5SL_first(fm->sel_chunks);
-
+    if(fm->sel_chunks->nchunks == 1) {
         /* Get pointer to chunk's information */
-        chunk_info = (H5D_chunk_info_t *)H5SL_item(curr_node);
+        chunk_info = fm->sel_chunks->chunk[0];
         HDassert(chunk_info);
 
         /* Just point at the memory dataspace & selection */
@@ -2163,13 +2922,12 @@ H5D__create_chunk_mem_map_1d(const H5D_chunk_map_t *fm)
             HGOTO_ERROR(H5E_DATASPACE, H5E_CANTGET, FAIL, "can't get file selection bound info")
 
         /* Iterate over each chunk in the chunk list */
-        curr_node = H5SL_first(fm->sel_chunks);
-        while(curr_node) {
+        for(n = 0; n < fm->sel_chunks->nchunks; n++) {
             hsize_t     chunk_points;          /* Number of elements in chunk selection */
             hsize_t     tmp_count = 1;
 
             /* Get pointer to chunk's information */
-            chunk_info = (H5D_chunk_info_t *)H5SL_item(curr_node);
+            chunk_info = fm->sel_chunks->chunk[n];
             HDassert(chunk_info);
 
             /* Copy the memory dataspace */
@@ -2182,10 +2940,7 @@ H5D__create_chunk_mem_map_1d(const H5D_chunk_map_t *fm)
                 HGOTO_ERROR(H5E_DATASET, H5E_CANTSELECT, FAIL, "can't create chunk memory selection")
 
             mem_sel_start[0] += chunk_points;
-
-            /* Get the next chunk node in the skip list */
-            curr_node = H5SL_next(curr_node);
-        } /* end while */
+        } /* end for */
     } /* end else */
 
 done:
@@ -2223,7 +2978,7 @@ H5D__chunk_file_cb(void H5_ATTR_UNUSED *elem, const H5T_t H5_ATTR_UNUSED *type,
     /* Calculate the index of this chunk */
     chunk_index = H5VM_chunk_index_scaled(ndims, coords, fm->layout->u.chunk.dim, fm->layout->u.chunk.down_chunks, scaled);
 
-    /* Find correct chunk in file & memory skip list */
+    /* Find correct chunk in list of selected chunks */
     if(chunk_index==fm->last_index) {
         /* If the chunk index is the same as the last chunk index we used,
          * get the cached info to operate on.
@@ -2232,10 +2987,10 @@ H5D__chunk_file_cb(void H5_ATTR_UNUSED *elem, const H5T_t H5_ATTR_UNUSED *type,
     } /* end if */
     else {
         /* If the chunk index is not the same as the last chunk index we used,
-         * find the chunk in the skip list.
+         * find the chunk in the list of selected chunks.
          */
-        /* Get the chunk node from the skip list */
-        if(NULL == (chunk_info = (H5D_chunk_info_t *)H5SL_search(fm->sel_chunks, &chunk_index))) {
+        /* Look the chunk up in the hash table of selected chunks */
+        if(NULL == (chunk_info = H5D__chunk_sel_find(fm->sel_chunks, chunk_index))) {
             H5S_t *fspace;                      /* Memory chunk's dataspace */
 
             /* Allocate the file & memory chunk information */
@@ -2276,10 +3031,10 @@ H5D__chunk_file_cb(void H5_ATTR_UNUSED *elem, const H5T_t H5_ATTR_UNUSED *type,
             chunk_info->scaled[fm->f_ndims] = 0;
             H5MM_memcpy(chunk_info->scaled, scaled, sizeof(hsize_t) * fm->f_ndims);
 
-            /* Insert the new chunk into the skip list */
-            if(H5SL_insert(fm->sel_chunks,chunk_info,&chunk_info->index) < 0) {
-                    H5D__free_chunk_info(chunk_info,NULL,NULL);
-                HGOTO_ERROR(H5E_DATASPACE,H5E_CANTINSERT,FAIL,"can't insert chunk into skip list")
+            /* Insert the new chunk into the list of selected chunks */
+            if(H5D__chunk_sel_append(fm->sel_chunks, chunk_info) < 0) {
+                H5D__free_chunk_info(chunk_info);
+                HGOTO_ERROR(H5E_DATASPACE, H5E_CANTINSERT, FAIL, "can't insert chunk into list of selected chunks")
             } /* end if */
         } /* end if */
 
@@ -2337,7 +3092,7 @@ H5D__chunk_mem_cb(void H5_ATTR_UNUSED *elem, const H5T_t H5_ATTR_UNUSED *type, u
     /* Calculate the index of this chunk */
     chunk_index = H5VM_chunk_index(ndims, coords, fm->layout->u.chunk.dim, fm->layout->u.chunk.down_chunks);
 
-    /* Find correct chunk in file & memory skip list */
+    /* Find correct chunk in list of selected chunks */
     if(chunk_index == fm->last_index) {
         /* If the chunk index is the same as the last chunk index we used,
          * get the cached spaces to operate on.
@@ -2346,11 +3101,11 @@ H5D__chunk_mem_cb(void H5_ATTR_UNUSED *elem, const H5T_t H5_ATTR_UNUSED *type, u
     } /* end if */
     else {
         /* If the chunk index is not the same as the last chunk index we used,
-         * find the chunk in the skip list.
+         * find the chunk in the list of selected chunks.
          */
-        /* Get the chunk node from the skip list */
-        if(NULL == (chunk_info = (H5D_chunk_info_t *)H5SL_search(fm->sel_chunks, &chunk_index)))
-            HGOTO_ERROR(H5E_DATASPACE, H5E_NOTFOUND, H5_ITER_ERROR, "can't locate chunk in skip list")
+        /* Look the chunk up in the list of selected chunks */
+        if(NULL == (chunk_info = H5D__chunk_sel_find(fm->sel_chunks, chunk_index)))
+            HGOTO_ERROR(H5E_DATASPACE, H5E_NOTFOUND, H5_ITER_ERROR, "can't locate chunk in list of selected chunks")
 
         /* Check if the chunk already has a memory space */
         if(NULL == chunk_info->mspace)
@@ -2495,7 +3250,7 @@ H5D__chunk_read(H5D_io_info_t *io_info, const H5D_type_info_t *type_info,
     hsize_t H5_ATTR_UNUSED nelmts, const H5S_t H5_ATTR_UNUSED *file_space, const H5S_t H5_ATTR_UNUSED *mem_space,
     H5D_chunk_map_t *fm)
 {
-    H5SL_node_t *chunk_node;            /* Current node in chunk skip list */
+    H5D_chunk_info_t * const *chunk_node; /* Current node in the list of selected chunks */
     H5D_io_info_t nonexistent_io_info;  /* "nonexistent" I/O info object */
     H5D_io_info_t ctg_io_info;          /* Contiguous I/O info object */
     H5D_storage_t ctg_store;            /* Chunk storage information as contiguous dataset */
@@ -2504,6 +3259,12 @@ H5D__chunk_read(H5D_io_info_t *io_info, const H5D_type_info_t *type_info,
     hbool_t     cpt_dirty;              /* Temporary placeholder for compact storage "dirty" flag */
     uint32_t    src_accessed_bytes = 0; /* Total accessed size in a chunk */
     hbool_t     skip_missing_chunks = FALSE;    /* Whether to skip missing chunks */
+    unsigned    decode_nthreads = 1;    /* Number of threads for decoding filtered chunks */
+    H5D_chunk_decode_t *decode_chunks = NULL;   /* Chunks being decoded ahead of the read loop */
+    size_t      decode_max = 0;         /* Max. # of chunks to decode at once */
+    H5D_chunk_info_t * const *decode_node = NULL; /* Next chunk to consider for decoding ahead */
+    hbool_t     ra_enabled;             /* Whether to read ahead of cache misses */
+    hbool_t     ra_missed = FALSE;      /* Whether the current chunk missed the cache */
     herr_t    ret_value = SUCCEED;    /*return value        */
 
     FUNC_ENTER_STATIC
@@ -2552,13 +3313,77 @@ H5D__chunk_read(H5D_io_info_t *io_info, const H5D_type_info_t *type_info,
             skip_missing_chunks = TRUE;
     }
 
-    /* Iterate through nodes in chunk skip list */
+    /* Check if chunks should be read ahead of sequential cache misses */
+    ra_enabled = (io_info->dset->shared->cache.chunk.readahead > 0
+            && io_info->dset->shared->cache.chunk.nslots > 0
+#ifdef H5_HAVE_PARALLEL
+            && !io_info->using_mpi_vfd
+#endif /* H5_HAVE_PARALLEL */
+            );
+
+    /* Check if chunks should be loaded ahead of the read loop, to decode
+     * filtered chunks with multiple threads or to coalesce the reads of
+     * chunks stored next to each other */
+    if(!fm->use_single && fm->sel_chunks->nchunks > 1
+#ifdef H5_HAVE_PARALLEL
+            && !io_info->using_mpi_vfd
+#endif /* H5_HAVE_PARALLEL */
+            ) {
+        const H5D_rdcc_t *rdcc = &(io_info->dset->shared->cache.chunk);
+        const H5O_pline_t *pline = &(io_info->dset->shared->dcpl_cache.pline);
+
+        if(pline->nused > 0)
+            if(H5CX_get_chunk_decode_nthreads(&decode_nthreads) < 0)
+                HGOTO_ERROR(H5E_DATASET, H5E_CANTGET, FAIL, "can't get number of chunk decode threads")
+
+        if(decode_nthreads > 1 || rdcc->coalesce_max > 0) {
+            size_t chunk_size;
+
+            /* Decode a couple of chunks per thread at a time, or load as
+             * many chunks as one coalesced read may cover, as long as they
+             * all fit in the chunk cache together */
+            H5_CHECKED_ASSIGN(chunk_size, size_t, io_info->dset->shared->layout.u.chunk.size, uint32_t);
+            if(decode_nthreads > 1)
+                decode_max = 2 * (size_t)decode_nthreads;
+            if(rdcc->coalesce_max > 0)
+                decode_max = MAX3(decode_max, rdcc->coalesce_max / chunk_size, (size_t)2);
+            decode_max = MIN(decode_max, rdcc->nbytes_max / chunk_size);
+            decode_max = MIN(decode_max, rdcc->nslots);
+
+            if(decode_max > 1 && decode_nthreads > 1) {
+                htri_t avail;
+
+                /* Only decode with helper threads when the pipeline can run
+                 * on them */
+                if((avail = H5D__chunk_pline_thread_safe(pline)) < 0)
+                    HGOTO_ERROR(H5E_DATASET, H5E_CANTGET, FAIL, "can't check filter pipeline")
+                if(!avail) {
+                    decode_nthreads = 1;
+                    if(0 == rdcc->coalesce_max)
+                        decode_max = 0;
+                } /* end if */
+            } /* end if */
+
+            if(decode_max > 1) {
+                if(NULL == (decode_chunks = (H5D_chunk_decode_t *)H5MM_malloc(decode_max * sizeof(H5D_chunk_decode_t))))
+                    HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "memory allocation failed for chunk decode info")
+                decode_node = H5D_CHUNK_GET_FIRST_NODE(fm);
+            } /* end if */
+        } /* end if */
+    } /* end if */
+
+    /* Iterate through the selected chunks */
     chunk_node = H5D_CHUNK_GET_FIRST_NODE(fm);
     while(chunk_node) {
         H5D_chunk_info_t *chunk_info;   /* Chunk information */
         H5D_chunk_ud_t udata;        /* Chunk index pass-through    */
 
-        /* Get the actual chunk information from the skip list node */
+        /* Decode the next group of chunks, once the read loop gets to them */
+        if(decode_chunks && chunk_node == decode_node)
+            if(H5D__chunk_decode_window(io_info, fm, &decode_node, decode_nthreads, decode_chunks, decode_max) < 0)
+                HGOTO_ERROR(H5E_DATASET, H5E_READERROR, FAIL, "unable to decode raw data chunks")
+
+        /* Get the actual chunk information from the list node */
         chunk_info = H5D_CHUNK_GET_NODE_INFO(fm, chunk_node);
 
         /* Get the info for the chunk in the file */
@@ -2589,6 +3414,10 @@ H5D__chunk_read(H5D_io_info_t *io_info, const H5D_type_info_t *type_info,
                 H5_CHECK_OVERFLOW(type_info->src_type_size, /*From:*/ size_t, /*To:*/ uint32_t);
                 src_accessed_bytes = chunk_info->chunk_points * (uint32_t)type_info->src_type_size;
 
+                /* Check if the chunk missed the cache, for reading ahead */
+                if(ra_enabled)
+                    ra_missed = (UINT_MAX == udata.idx_hint && H5F_addr_defined(udata.chunk_block.offset));
+
                 /* Lock the chunk into the cache */
                 if(NULL == (chunk = H5D__chunk_lock(io_info, &udata, FALSE, FALSE)))
                     HGOTO_ERROR(H5E_IO, H5E_READERROR, FAIL, "unable to read raw data chunk")
@@ -2619,6 +3448,13 @@ H5D__chunk_read(H5D_io_info_t *io_info, const H5D_type_info_t *type_info,
             /* Release the cache lock on the chunk. */
             if(chunk && H5D__chunk_unlock(io_info, &udata, FALSE, chunk, src_accessed_bytes) < 0)
                 HGOTO_ERROR(H5E_IO, H5E_READERROR, FAIL, "unable to unlock raw data chunk")
+
+            /* Read ahead of chunk cache misses */
+            if(ra_missed) {
+                ra_missed = FALSE;
+                if(H5D__chunk_readahead(io_info->dset, chunk_info->scaled) < 0)
+                    HGOTO_ERROR(H5E_IO, H5E_READERROR, FAIL, "unable to read ahead raw data chunks")
+            } /* end if */
         } /* end if */
 
         /* Advance to next chunk in list */
@@ -2626,6 +3462,9 @@ H5D__chunk_read(H5D_io_info_t *io_info, const H5D_type_info_t *type_info,
     } /* end while */
 
 done:
+    if(decode_chunks)
+        decode_chunks = (H5D_chunk_decode_t *)H5MM_xfree(decode_chunks);
+
     FUNC_LEAVE_NOAPI(ret_value)
 } /* H5D__chunk_read() */
 
@@ -2647,7 +3486,7 @@ H5D__chunk_write(H5D_io_info_t *io_info, const H5D_type_info_t *type_info,
     hsize_t H5_ATTR_UNUSED nelmts, const H5S_t H5_ATTR_UNUSED *file_space, const H5S_t H5_ATTR_UNUSED *mem_space,
     H5D_chunk_map_t *fm)
 {
-    H5SL_node_t *chunk_node;            /* Current node in chunk skip list */
+    H5D_chunk_info_t * const *chunk_node; /* Current node in the list of selected chunks */
     H5D_io_info_t ctg_io_info;          /* Contiguous I/O info object */
     H5D_storage_t ctg_store;            /* Chunk storage information as contiguous dataset */
     H5D_io_info_t cpt_io_info;          /* Compact I/O info object */
@@ -2680,7 +3519,7 @@ H5D__chunk_write(H5D_io_info_t *io_info, const H5D_type_info_t *type_info,
     /* Initialize temporary compact storage info */
     cpt_store.compact.dirty = &cpt_dirty;
 
-    /* Iterate through nodes in chunk skip list */
+    /* Iterate through the selected chunks */
     chunk_node = H5D_CHUNK_GET_FIRST_NODE(fm);
     while(chunk_node) {
         H5D_chunk_info_t *chunk_info;   /* Chunk information */
@@ -2691,7 +3530,7 @@ H5D__chunk_write(H5D_io_info_t *io_info, const H5D_type_info_t *type_info,
         htri_t cacheable;               /* Whether the chunk is cacheable */
         hbool_t need_insert = FALSE;    /* Whether the chunk needs to be inserted into the index */
 
-        /* Get the actual chunk information from the skip list node */
+        /* Get the actual chunk information from the list node */
         chunk_info = H5D_CHUNK_GET_NODE_INFO(fm, chunk_node);
 
         /* Look up the chunk */
@@ -2818,6 +3657,21 @@ H5D__chunk_flush(H5D_t *dset)
     /* Sanity check */
     HDassert(dset);
 
+    /* Filter and write the dirty chunks together, if using multiple threads */
+    if(rdcc->encode_nthreads > 1 && rdcc->nused > 1) {
+        H5D_rdcc_ent_t **ents;          /* Dirty cache entries */
+        size_t nents = 0;               /* Number of dirty cache entries */
+
+        if(NULL == (ents = (H5D_rdcc_ent_t **)H5MM_malloc((size_t)rdcc->nused * sizeof(H5D_rdcc_ent_t *))))
+            HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "memory allocation failed for cache entry list")
+        for(ent = rdcc->head; ent; ent = ent->next)
+            if(ent->dirty)
+                ents[nents++] = ent;
+        if(nents > 0 && H5D__chunk_flush_entries(dset, ents, nents, FALSE) < 0)
+            nerrors++;
+        H5MM_xfree(ents);
+    } /* end if */
+
     /* Loop over all entries in the chunk cache */
     for(ent = rdcc->head; ent; ent = next) {
     next = ent->next;
@@ -2864,9 +3718,14 @@ H5D__chunk_io_term(const H5D_chunk_map_t *fm)
     } /* end if */
     else {
         /* Release the nodes on the list of selected chunks */
-        if(fm->sel_chunks)
-            if(H5SL_free(fm->sel_chunks, H5D__free_chunk_info, NULL) < 0)
-                HGOTO_ERROR(H5E_PLIST, H5E_CANTNEXT, FAIL, "can't iterate over chunks")
+        if(fm->sel_chunks) {
+            size_t n;           /* Local index variable */
+
+            for(n = 0; n < fm->sel_chunks->nchunks; n++)
+                H5D__free_chunk_info(fm->sel_chunks->chunk[n]);
+            fm->sel_chunks->nchunks = 0;
+            fm->sel_chunks->use_hash = FALSE;
+        } /* end if */
     } /* end else */
 
     /* Free the memory chunk dataspace template */
@@ -2912,6 +3771,21 @@ H5D__chunk_dest(H5D_t *dset)
     HDassert(dset);
     H5D_CHUNK_STORAGE_INDEX_CHK(sc);
 
+    /* Filter and write the cached chunks together, if using multiple threads */
+    if(rdcc->encode_nthreads > 1 && rdcc->nused > 1) {
+        H5D_rdcc_ent_t **ents;          /* Cache entries */
+        size_t nents = 0;               /* Number of cache entries */
+
+        /* (Just flush the chunks one at a time below if this fails) */
+        if(NULL != (ents = (H5D_rdcc_ent_t **)H5MM_malloc((size_t)rdcc->nused * sizeof(H5D_rdcc_ent_t *)))) {
+            for(ent = rdcc->head; ent; ent = ent->next)
+                ents[nents++] = ent;
+            if(H5D__chunk_flush_entries(dset, ents, nents, TRUE) < 0)
+                nerrors++;
+            H5MM_xfree(ents);
+        } /* end if */
+    } /* end if */
+
     /* Flush all the cached chunks */
     for(ent = rdcc->head; ent; ent = next) {
         next = ent->next;
@@ -2926,6 +3800,12 @@ H5D__chunk_dest(H5D_t *dset)
     /* Release cache structures */
     if(rdcc->slot)
         rdcc->slot = H5FL_SEQ_FREE(H5D_rdcc_ent_ptr_t, rdcc->slot);
+    if(rdcc->ghost)
+        rdcc->ghost = (H5D_rdcc_ghost_t *)H5MM_xfree(rdcc->ghost);
+    if(rdcc->addr_table)
+        rdcc->addr_table = (H5D_chunk_addr_t *)H5MM_xfree(rdcc->addr_table);
+    while(rdcc->pool.nbufs > 0)
+        H5MM_xfree(rdcc->pool.buf[--rdcc->pool.nbufs].buf);
     HDmemset(rdcc, 0, sizeof(H5D_rdcc_t));
 
     /* Compose chunked index info struct */
@@ -3186,84 +4066,310 @@ H5D__chunk_hash_val(const H5D_shared_t *shared, const hsize_t *scaled)
 
 
 /*-------------------------------------------------------------------------
- * Function:    H5D__chunk_lookup
- *
- * Purpose:    Loops up a chunk in cache and on disk, and retrieves
- *              information about that chunk.
+ * Function:    H5D__chunk_ghost_key
  *
- * Return:    Non-negative on success/Negative on failure
+ * Purpose:     Compute the key that the 2Q chunk cache policy remembers
+ *              a preempted chunk by.  Different chunks may share a key,
+ *              which only costs an extra promotion to the hot queue.
  *
- * Programmer:    Albert Cheng
- *              June 27, 1998
+ * Return:      Key for the chunk (never 0)
  *
  *-------------------------------------------------------------------------
  */
-herr_t
-H5D__chunk_lookup(const H5D_t *dset, const hsize_t *scaled,
-    H5D_chunk_ud_t *udata)
+static hsize_t
+H5D__chunk_ghost_key(const H5D_shared_t *shared, const hsize_t *scaled)
 {
-    H5D_rdcc_ent_t  *ent = NULL;        /* Cache entry */
-    H5O_storage_chunk_t *sc = &(dset->shared->layout.storage.u.chunk);
-    unsigned idx;                       /* Index of chunk in cache, if present */
-    hbool_t found = FALSE;              /* In cache? */
-    herr_t ret_value = SUCCEED;            /* Return value */
+    hsize_t key = 0;    /* Value to return */
+    unsigned u;         /* Local index variable */
 
-    FUNC_ENTER_PACKAGE
+    FUNC_ENTER_STATIC_NOERR
 
-    /* Sanity checks */
-    HDassert(dset);
-    HDassert(dset->shared->layout.u.chunk.ndims > 0);
-    H5D_CHUNK_STORAGE_INDEX_CHK(sc);
+    /* Sanity check */
+    HDassert(shared);
     HDassert(scaled);
-    HDassert(udata);
 
-    /* Initialize the query information about the chunk we are looking for */
-    udata->common.layout = &(dset->shared->layout.u.chunk);
-    udata->common.storage = sc;
-    udata->common.scaled = scaled;
+    for(u = 0; u < shared->ndims; u++)
+        key = (key * 1000003) ^ scaled[u];
 
-    /* Reset information about the chunk we are looking for */
-    udata->chunk_block.offset = HADDR_UNDEF;
-    udata->chunk_block.length = 0;
-    udata->filter_mask = 0;
-    udata->new_unfilt_chunk = FALSE;
+    /* (0 marks an empty ghost slot) */
+    FUNC_LEAVE_NOAPI((key << 1) | 1)
+} /* H5D__chunk_ghost_key() */
 
-    /* Check for chunk in cache */
-    if(dset->shared->cache.chunk.nslots > 0) {
-        /* Determine the chunk's location in the hash table */
-        idx = H5D__chunk_hash_val(dset->shared, scaled);
 
-        /* Get the chunk cache entry for that location */
-        ent = dset->shared->cache.chunk.slot[idx];
-        if(ent) {
-            unsigned u;                  /* Counter */
+/*-------------------------------------------------------------------------
+ * Function:    H5D__chunk_ghost_find
+ *
+ * Purpose:     Check whether the chunk at SCALED, which hashes to slot
+ *              IDX, was preempted from the 2Q probationary queue recently.
+ *              As in 2Q, only the chunks preempted during the time it
+ *              takes to preempt half as many chunks as the cache can hold
+ *              are remembered.
+ *
+ * Return:      TRUE if the chunk was preempted recently, FALSE otherwise
+ *
+ *-------------------------------------------------------------------------
+ */
+static hbool_t
+H5D__chunk_ghost_find(const H5D_t *dset, unsigned idx, const hsize_t *scaled)
+{
+    const H5D_rdcc_t    *rdcc = &(dset->shared->cache.chunk); /* Raw data chunk cache */
+    const H5D_rdcc_ghost_t *ghost;              /* Ghost entry for the slot */
+    hsize_t             max_age;                /* # of preemptions a chunk is remembered for */
+    hbool_t             ret_value = FALSE;      /* Return value */
 
-            /* Speculatively set the 'found' flag */
-            found = TRUE;
+    FUNC_ENTER_STATIC_NOERR
 
-            /* Verify that the cache entry is the correct chunk */
-            for(u = 0; u < dset->shared->ndims; u++)
-                if(scaled[u] != ent->scaled[u]) {
-                    found = FALSE;
-                    break;
-                } /* end if */
-        } /* end if */
+    /* Sanity checks */
+    HDassert(rdcc->ghost);
+    HDassert(idx < rdcc->nslots);
+
+    ghost = &rdcc->ghost[idx];
+    if(ghost->key && ghost->key == H5D__chunk_ghost_key(dset->shared, scaled)) {
+        max_age = (rdcc->nbytes_max / dset->shared->layout.u.chunk.size) / 2;
+        if(rdcc->ghost_seq - ghost->seq <= MAX(max_age, 1))
+            ret_value = TRUE;
     } /* end if */
 
-    /* Retrieve chunk addr */
-    if(found) {
-        udata->idx_hint = idx;
-        udata->chunk_block.offset = ent->chunk_block.offset;
-        udata->chunk_block.length = ent->chunk_block.length;;
-        udata->chunk_idx = ent->chunk_idx;
-    } /* end if */
-    else {
-        /* Invalidate idx_hint, to signal that the chunk is not in cache */
-        udata->idx_hint = UINT_MAX;
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* H5D__chunk_ghost_find() */
 
-        /* Check for cached information */
-        if(!H5D__chunk_cinfo_cache_found(&dset->shared->cache.chunk.last, udata)) {
-            H5D_chk_idx_info_t idx_info;        /* Chunked index info */
+
+/*-------------------------------------------------------------------------
+ * Function:    H5D__chunk_cache_admit
+ *
+ * Purpose:     Check whether a chunk that isn't cached may be added to
+ *              the chunk cache in slot IDX.  It may not if the entry in
+ *              that slot is locked.  With the 2Q policy it also may not
+ *              displace an entry in the hot queue, unless the chunk was
+ *              recently preempted from the probationary queue itself.
+ *
+ * Return:      TRUE if the chunk may be added, FALSE otherwise
+ *
+ *-------------------------------------------------------------------------
+ */
+static hbool_t
+H5D__chunk_cache_admit(const H5D_t *dset, unsigned idx, const hsize_t *scaled)
+{
+    const H5D_rdcc_t    *rdcc = &(dset->shared->cache.chunk); /* Raw data chunk cache */
+    const H5D_rdcc_ent_t *ent;                  /* Entry in the chunk's slot */
+    hbool_t             ret_value = TRUE;       /* Return value */
+
+    FUNC_ENTER_STATIC_NOERR
+
+    /* Sanity checks */
+    HDassert(idx < rdcc->nslots);
+    HDassert(scaled);
+
+    if(NULL != (ent = rdcc->slot[idx])) {
+        if(ent->locked)
+            ret_value = FALSE;
+        else if(ent->hot && !H5D__chunk_ghost_find(dset, idx, scaled))
+            ret_value = FALSE;
+    } /* end if */
+
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* H5D__chunk_cache_admit() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:    H5D__chunk_addr_table_cb
+ *
+ * Purpose:     Record the location of a chunk in the chunk address table,
+ *              while iterating over the chunk index.
+ *
+ * Return:      H5_ITER_CONT
+ *
+ *-------------------------------------------------------------------------
+ */
+static int
+H5D__chunk_addr_table_cb(const H5D_chunk_rec_t *chunk_rec, void *_udata)
+{
+    H5D_shared_t *shared = (H5D_shared_t *)_udata;  /* Dataset whose index is iterated over */
+    unsigned u;                         /* Local index variable */
+
+    FUNC_ENTER_STATIC_NOERR
+
+    /* (Skip chunks outside the dataset's current extent) */
+    for(u = 0; u < shared->ndims; u++)
+        if(chunk_rec->scaled[u] >= shared->layout.u.chunk.chunks[u])
+            break;
+    if(u == shared->ndims) {
+        hsize_t chunk_index;            /* Index of the chunk in the table */
+        H5D_chunk_addr_t *addr;         /* Chunk's entry in the table */
+
+        chunk_index = H5VM_array_offset_pre(shared->ndims, shared->layout.u.chunk.down_chunks, chunk_rec->scaled);
+        addr = &shared->cache.chunk.addr_table[chunk_index];
+
+        addr->addr = chunk_rec->chunk_addr;
+        addr->nbytes = chunk_rec->nbytes;
+        addr->filter_mask = chunk_rec->filter_mask;
+    } /* end if */
+
+    FUNC_LEAVE_NOAPI(H5_ITER_CONT)
+} /* H5D__chunk_addr_table_cb() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:    H5D__chunk_addr_table_load
+ *
+ * Purpose:     Read the whole chunk index of a dataset into its chunk
+ *              address table.
+ *
+ * Return:      Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5D__chunk_addr_table_load(const H5D_t *dset)
+{
+    H5D_rdcc_t *rdcc = &(dset->shared->cache.chunk);   /* Raw data chunk cache */
+    const H5O_layout_chunk_t *layout = &(dset->shared->layout.u.chunk);  /* Chunk layout */
+    H5O_storage_chunk_t *sc = &(dset->shared->layout.storage.u.chunk);    /* Chunk storage */
+    H5D_chunk_addr_t *table = NULL;     /* Chunk address table */
+    hsize_t u;                          /* Local index variable */
+    herr_t ret_value = SUCCEED;         /* Return value */
+
+    FUNC_ENTER_STATIC
+
+    HDassert(NULL == rdcc->addr_table);
+
+    /* Allocate the table, with all chunks unallocated */
+    if(layout->nchunks != (hsize_t)((size_t)layout->nchunks) || (size_t)layout->nchunks > ((size_t)-1) / sizeof(H5D_chunk_addr_t))
+        HGOTO_ERROR(H5E_DATASET, H5E_OVERFLOW, FAIL, "too many chunks for chunk address table")
+    if(NULL == (table = (H5D_chunk_addr_t *)H5MM_malloc(MAX(1, (size_t)layout->nchunks) * sizeof(H5D_chunk_addr_t))))
+        HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "memory allocation failed for chunk address table")
+    for(u = 0; u < layout->nchunks; u++) {
+        table[u].addr = HADDR_UNDEF;
+        table[u].nbytes = 0;
+        table[u].filter_mask = 0;
+    } /* end for */
+    rdcc->addr_table = table;
+
+    /* Fill in the chunks in the index */
+    if((*sc->ops->is_space_alloc)(sc)) {
+        H5D_chk_idx_info_t idx_info;    /* Chunked index info */
+
+        /* Compose chunked index info struct */
+        idx_info.f = dset->oloc.file;
+        idx_info.pline = &dset->shared->dcpl_cache.pline;
+        idx_info.layout = &dset->shared->layout.u.chunk;
+        idx_info.storage = sc;
+
+        if((sc->ops->iterate)(&idx_info, H5D__chunk_addr_table_cb, dset->shared) < 0) {
+            rdcc->addr_table = (H5D_chunk_addr_t *)H5MM_xfree(rdcc->addr_table);
+            HGOTO_ERROR(H5E_DATASET, H5E_BADITER, FAIL, "unable to iterate over chunk index")
+        } /* end if */
+    } /* end if */
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* H5D__chunk_addr_table_load() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:    H5D__chunk_lookup
+ *
+ * Purpose:    Loops up a chunk in cache and on disk, and retrieves
+ *              information about that chunk.
+ *
+ * Return:    Non-negative on success/Negative on failure
+ *
+ * Programmer:    Albert Cheng
+ *              June 27, 1998
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5D__chunk_lookup(const H5D_t *dset, const hsize_t *scaled,
+    H5D_chunk_ud_t *udata)
+{
+    H5D_rdcc_ent_t  *ent = NULL;        /* Cache entry */
+    H5O_storage_chunk_t *sc = &(dset->shared->layout.storage.u.chunk);
+    unsigned idx;                       /* Index of chunk in cache, if present */
+    hbool_t found = FALSE;              /* In cache? */
+    herr_t ret_value = SUCCEED;            /* Return value */
+
+    FUNC_ENTER_PACKAGE
+
+    /* Sanity checks */
+    HDassert(dset);
+    HDassert(dset->shared->layout.u.chunk.ndims > 0);
+    H5D_CHUNK_STORAGE_INDEX_CHK(sc);
+    HDassert(scaled);
+    HDassert(udata);
+
+    /* Initialize the query information about the chunk we are looking for */
+    udata->common.layout = &(dset->shared->layout.u.chunk);
+    udata->common.storage = sc;
+    udata->common.scaled = scaled;
+
+    /* Reset information about the chunk we are looking for */
+    udata->chunk_block.offset = HADDR_UNDEF;
+    udata->chunk_block.length = 0;
+    udata->filter_mask = 0;
+    udata->new_unfilt_chunk = FALSE;
+
+    /* Check for chunk in cache */
+    if(dset->shared->cache.chunk.nslots > 0) {
+        /* Determine the chunk's location in the hash table */
+        idx = H5D__chunk_hash_val(dset->shared, scaled);
+
+        /* Get the chunk cache entry for that location */
+        ent = dset->shared->cache.chunk.slot[idx];
+        if(ent) {
+            unsigned u;                  /* Counter */
+
+            /* Speculatively set the 'found' flag */
+            found = TRUE;
+
+            /* Verify that the cache entry is the correct chunk */
+            for(u = 0; u < dset->shared->ndims; u++)
+                if(scaled[u] != ent->scaled[u]) {
+                    found = FALSE;
+                    break;
+                } /* end if */
+        } /* end if */
+    } /* end if */
+
+    /* Retrieve chunk addr */
+    if(found) {
+        udata->idx_hint = idx;
+        udata->chunk_block.offset = ent->chunk_block.offset;
+        udata->chunk_block.length = ent->chunk_block.length;;
+        udata->chunk_idx = ent->chunk_idx;
+    } /* end if */
+    else {
+        H5D_rdcc_t *rdcc = &(dset->shared->cache.chunk);
+
+        /* Invalidate idx_hint, to signal that the chunk is not in cache */
+        udata->idx_hint = UINT_MAX;
+
+        /* Look the chunk up in the chunk address table, if it's used */
+        if(rdcc->use_addr_table) {
+            hsize_t chunk_index;        /* Index of the chunk in the table */
+
+            if(NULL == rdcc->addr_table)
+                if(H5D__chunk_addr_table_load(dset) < 0)
+                    HGOTO_ERROR(H5E_DATASET, H5E_CANTLOAD, FAIL, "can't load chunk address table")
+
+            chunk_index = H5VM_array_offset_pre(dset->shared->ndims, dset->shared->layout.u.chunk.down_chunks, scaled);
+            if(chunk_index < dset->shared->layout.u.chunk.nchunks) {
+                const H5D_chunk_addr_t *addr = &rdcc->addr_table[chunk_index];
+
+                udata->chunk_block.offset = addr->addr;
+                udata->chunk_block.length = addr->nbytes;
+                udata->filter_mask = addr->filter_mask;
+
+                /* (The chunk's index in the chunk index is only needed to
+                 *  insert chunks, which isn't done in read-only files) */
+                udata->chunk_idx = HSIZE_UNDEF;
+                HGOTO_DONE(SUCCEED)
+            } /* end if */
+        } /* end if */
+
+        /* Check for cached information */
+        if(!H5D__chunk_cinfo_cache_found(&dset->shared->cache.chunk.last, udata)) {
+            H5D_chk_idx_info_t idx_info;        /* Chunked index info */
 
             /* Compose chunked index info struct */
             idx_info.f = dset->oloc.file;
@@ -3327,6 +4433,138 @@ done:
 } /* H5D__chunk_lookup() */
 
 
+/*-------------------------------------------------------------------------
+ * Function:    H5D__chunk_filter_adapt
+ *
+ * Purpose:     Second-guess the output pipeline for a dataset using the
+ *              H5D_CHUNK_FILTER_ADAPTIVE chunk filter mode.  *BUF holds
+ *              the result of running the unfiltered chunk CHUNK (of
+ *              CHUNK_SIZE bytes) through PLINE.  If optional filters were
+ *              applied but saved less than the fraction MIN_GAIN of the
+ *              chunk, the chunk is filtered again with all the optional
+ *              filters skipped, so that only mandatory filters (like
+ *              Fletcher32) are applied to it.  *FILTER_MASK, *NBYTES,
+ *              *ALLOC and *BUF are updated to match.
+ *
+ *              This may be called from a helper thread, so errors aren't
+ *              pushed on the error stack.
+ *
+ * Return:      Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5D__chunk_filter_adapt(const H5O_pline_t *pline, double min_gain,
+    const void *chunk, size_t chunk_size, H5Z_EDC_t err_detect, H5Z_cb_t filter_cb,
+    unsigned *filter_mask, size_t *nbytes, size_t *alloc, void **buf)
+{
+    unsigned optional_mask = 0;         /* Mask of the optional filters */
+    size_t u;                           /* Local index variable */
+    herr_t ret_value = SUCCEED;         /* Return value */
+
+    FUNC_ENTER_STATIC_NOERR
+
+    HDassert(pline);
+    HDassert(chunk);
+    HDassert(filter_mask);
+    HDassert(nbytes);
+    HDassert(alloc);
+    HDassert(buf && *buf);
+
+    for(u = 0; u < pline->nused; u++)
+        if(pline->filter[u].flags & H5Z_FLAG_OPTIONAL)
+            optional_mask |= (unsigned)1 << u;
+
+    /* Leave the chunk alone if no optional filters were applied or if they
+     * saved enough space */
+    if((optional_mask & ~*filter_mask)
+            && (double)*nbytes > (1.0 - min_gain) * (double)chunk_size) {
+        if(*alloc < chunk_size) {
+            void *new_buf;              /* Enlarged buffer */
+
+            if(NULL == (new_buf = H5MM_realloc(*buf, chunk_size)))
+                HGOTO_DONE(FAIL)
+            *buf = new_buf;
+            *alloc = chunk_size;
+        } /* end if */
+        H5MM_memcpy(*buf, chunk, chunk_size);
+        *nbytes = chunk_size;
+
+        /* Run the mandatory filters only */
+        *filter_mask = optional_mask;
+        if(H5Z_pipeline(pline, 0, filter_mask, err_detect, filter_cb, (size_t)0,
+                nbytes, alloc, buf) < 0)
+            HGOTO_DONE(FAIL)
+    } /* end if */
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5D__chunk_filter_adapt() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:    H5D__chunk_is_fill
+ *
+ * Purpose:     Check whether a chunk of a dataset in memory holds nothing
+ *              but the fill value, in a way that reading the chunk back
+ *              without it being written to the file would reproduce.
+ *              That requires the fill value to be written to chunks when
+ *              they are created, and rules out variable-length types.
+ *
+ * Return:      TRUE/FALSE on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+static htri_t
+H5D__chunk_is_fill(const H5D_t *dset, const void *chunk)
+{
+    const H5O_fill_t *fill = &dset->shared->dcpl_cache.fill; /* Fill value info */
+    const uint8_t *bytes = (const uint8_t *)chunk; /* Chunk's bytes */
+    H5D_fill_value_t fill_status;       /* Fill value status */
+    size_t chunk_size;                  /* Size of a chunk */
+    htri_t ret_value = FALSE;           /* Return value */
+
+    FUNC_ENTER_STATIC
+
+    HDassert(chunk);
+
+    /* Check that unwritten chunks read back as the fill value */
+    if(H5P_is_fill_value_defined(fill, &fill_status) < 0)
+        HGOTO_ERROR(H5E_PLIST, H5E_CANTGET, FAIL, "can't tell if fill value defined")
+    if(!(fill->fill_time == H5D_FILL_TIME_ALLOC ||
+            (fill->fill_time == H5D_FILL_TIME_IFSET &&
+             (fill_status == H5D_FILL_VALUE_USER_DEFINED ||
+              fill_status == H5D_FILL_VALUE_DEFAULT))))
+        HGOTO_DONE(FALSE)
+    if(H5T_detect_class(dset->shared->type, H5T_VLEN, FALSE) > 0)
+        HGOTO_DONE(FALSE)
+
+    H5_CHECKED_ASSIGN(chunk_size, size_t, dset->shared->layout.u.chunk.size, uint32_t);
+    if(NULL == fill->buf) {
+        /* The fill value is all zeros */
+        if(bytes[0] != 0)
+            HGOTO_DONE(FALSE)
+        ret_value = (chunk_size == 1 || !HDmemcmp(bytes, bytes + 1, chunk_size - 1));
+    } /* end if */
+    else {
+        size_t fill_size;               /* Size of the fill value */
+
+        if(fill->size <= 0)
+            HGOTO_DONE(FALSE)
+        fill_size = (size_t)fill->size;
+        if(chunk_size % fill_size || HDmemcmp(bytes, fill->buf, fill_size))
+            HGOTO_DONE(FALSE)
+
+        /* Each element matches the first one */
+        ret_value = (chunk_size == fill_size
+                || !HDmemcmp(bytes, bytes + fill_size, chunk_size - fill_size));
+    } /* end else */
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5D__chunk_is_fill() */
+
+
 /*-------------------------------------------------------------------------
  * Function:    H5D__chunk_flush_entry
  *
@@ -3346,6 +4584,7 @@ static herr_t
 H5D__chunk_flush_entry(const H5D_t *dset, H5D_rdcc_ent_t *ent, hbool_t reset)
 {
     void    *buf = NULL;            /* Temporary buffer        */
+    size_t    buf_alloc = 0;          /* Size of the temporary buffer */
     hbool_t    point_of_no_return = FALSE;
     H5O_storage_chunk_t *sc = &(dset->shared->layout.storage.u.chunk);
     herr_t    ret_value = SUCCEED;    /* Return value            */
@@ -3359,6 +4598,24 @@ H5D__chunk_flush_entry(const H5D_t *dset, H5D_rdcc_ent_t *ent, hbool_t reset)
     HDassert(!ent->locked);
 
     buf = ent->chunk;
+
+    /* Skip writing new chunks that hold only the fill value */
+    if(ent->dirty && (dset->shared->dcpl_cache.chunk_filter_mode & H5D_CHUNK_SKIP_FILL_CHUNKS)
+            && !H5F_addr_defined(ent->chunk_block.offset)) {
+        htri_t is_fill;                 /* Whether the chunk holds only the fill value */
+
+        if((is_fill = H5D__chunk_is_fill(dset, ent->chunk)) < 0)
+            HGOTO_ERROR(H5E_DATASET, H5E_CANTGET, FAIL, "can't check for fill value chunk")
+        if(is_fill)
+            ent->dirty = FALSE;
+    } /* end if */
+
+    /* Discard filtered data for a chunk that isn't dirty (no longer
+     * needs writing) */
+    if(ent->filt_buf && !ent->dirty)
+        ent->filt_buf = (uint8_t *)H5D__chunk_pool_free(dset->shared, ent->filt_buf, ent->filt_alloc,
+                &(dset->shared->dcpl_cache.pline));
+
     if(ent->dirty) {
         H5D_chk_idx_info_t idx_info;    /* Chunked index info */
         H5D_chunk_ud_t     udata;        /* pass through B-tree        */
@@ -3374,13 +4631,37 @@ H5D__chunk_flush_entry(const H5D_t *dset, H5D_rdcc_ent_t *ent, hbool_t reset)
         udata.filter_mask = 0;
         udata.chunk_idx = ent->chunk_idx;
 
+        /* Has the chunk already been filtered? */
+        if(ent->filt_buf) {
+            HDassert(dset->shared->dcpl_cache.pline.nused
+                    && !(ent->edge_chunk_state & H5D_RDCC_DISABLE_FILTERS));
+
+            /* Write out the filtered data instead of the chunk */
+            buf = ent->filt_buf;
+            buf_alloc = ent->filt_alloc;
+            ent->filt_buf = NULL;
+            udata.filter_mask = ent->filt_mask;
+            dset->shared->cache.chunk.stats.nbytes_encoded += dset->shared->layout.u.chunk.size;
+#if H5_SIZEOF_SIZE_T > 4
+            /* Check for the chunk expanding too much to encode in a 32-bit value */
+            if(ent->filt_nbytes > ((size_t)0xffffffff))
+                HGOTO_ERROR(H5E_DATASET, H5E_BADRANGE, FAIL, "chunk too large for 32-bit length")
+#endif /* H5_SIZEOF_SIZE_T > 4 */
+            H5_CHECKED_ASSIGN(udata.chunk_block.length, hsize_t, ent->filt_nbytes, size_t);
+
+            /* Indicate that the chunk must be allocated */
+            must_alloc = TRUE;
+        } /* end if */
         /* Should the chunk be filtered before writing it to disk? */
-        if(dset->shared->dcpl_cache.pline.nused
+        else if(dset->shared->dcpl_cache.pline.nused
                 && !(ent->edge_chunk_state & H5D_RDCC_DISABLE_FILTERS)) {
             H5Z_EDC_t err_detect;       /* Error detection info */
             H5Z_cb_t filter_cb;         /* I/O filter callback function */
+            H5Z_mem_t mem;              /* Allocator for the filters' buffers */
             size_t alloc = udata.chunk_block.length;        /* Bytes allocated for BUF    */
             size_t nbytes;              /* Chunk size (in bytes) */
+            hbool_t adaptive = (dset->shared->dcpl_cache.chunk_filter_mode & H5D_CHUNK_FILTER_ADAPTIVE) != 0; /* Whether to filter chunks adaptively */
+            double start;               /* Time the filters were started */
 
             /* Retrieve filter settings from API context */
             if(H5CX_get_err_detect(&err_detect) < 0)
@@ -3388,15 +4669,16 @@ H5D__chunk_flush_entry(const H5D_t *dset, H5D_rdcc_ent_t *ent, hbool_t reset)
             if(H5CX_get_filter_cb(&filter_cb) < 0)
                 HGOTO_ERROR(H5E_DATASET, H5E_CANTGET, FAIL, "can't get I/O filter callback function")
 
-            if(!reset) {
+            if(!reset || adaptive) {
                 /*
                  * Copy the chunk to a new buffer before running it through
                  * the pipeline because we'll want to save the original buffer
-                 * for later.
+                 * for later (or need it if the chunk doesn't filter well).
                  */
-                if(NULL == (buf = H5MM_malloc(alloc)))
+                if(NULL == (buf = H5D__chunk_pool_alloc(dset->shared, alloc, &(dset->shared->dcpl_cache.pline), &alloc)))
                     HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "memory allocation failed for pipeline")
-                H5MM_memcpy(buf, ent->chunk, alloc);
+                buf_alloc = alloc;
+                H5MM_memcpy(buf, ent->chunk, (size_t)udata.chunk_block.length);
             } /* end if */
             else {
                 /*
@@ -3408,11 +4690,27 @@ H5D__chunk_flush_entry(const H5D_t *dset, H5D_rdcc_ent_t *ent, hbool_t reset)
                  */
                 point_of_no_return = TRUE;
                 ent->chunk = NULL;
+                buf_alloc = alloc;
             } /* end else */
             H5_CHECKED_ASSIGN(nbytes, size_t, udata.chunk_block.length, hsize_t);
-            if(H5Z_pipeline(&(dset->shared->dcpl_cache.pline), 0, &(udata.filter_mask),
-                    err_detect, filter_cb, &nbytes, &alloc, &buf) < 0)
+            mem.alloc_func = H5D__chunk_pool_mem_alloc;
+            mem.free_func = H5D__chunk_pool_mem_free;
+            mem.info = dset->shared;
+            start = H5_get_time();
+            if(H5Z_pipeline_mem(&(dset->shared->dcpl_cache.pline), 0, &(udata.filter_mask),
+                    err_detect, filter_cb, (size_t)0, &mem, &nbytes, &alloc, &buf) < 0)
                 HGOTO_ERROR(H5E_DATASET, H5E_CANTFILTER, FAIL, "output pipeline failed")
+            buf_alloc = alloc;
+            if(adaptive) {
+                if(H5D__chunk_filter_adapt(&(dset->shared->dcpl_cache.pline),
+                        dset->shared->dcpl_cache.chunk_filter_min_gain, ent->chunk,
+                        (size_t)dset->shared->layout.u.chunk.size, err_detect, filter_cb,
+                        &(udata.filter_mask), &nbytes, &alloc, &buf) < 0)
+                    HGOTO_ERROR(H5E_DATASET, H5E_CANTFILTER, FAIL, "output pipeline failed")
+                buf_alloc = alloc;
+            } /* end if */
+            dset->shared->cache.chunk.stats.filter_time += H5_get_time() - start;
+            dset->shared->cache.chunk.stats.nbytes_encoded += dset->shared->layout.u.chunk.size;
 #if H5_SIZEOF_SIZE_T > 4
             /* Check for the chunk expanding too much to encode in a 32-bit value */
             if(nbytes > ((size_t)0xffffffff))
@@ -3465,243 +4763,1296 @@ H5D__chunk_flush_entry(const H5D_t *dset, H5D_rdcc_ent_t *ent, hbool_t reset)
             ent->chunk_block.length = udata.chunk_block.length;
         } /* end if */
 
-        /* Write the data to the file */
-        HDassert(H5F_addr_defined(udata.chunk_block.offset));
-        H5_CHECK_OVERFLOW(udata.chunk_block.length, hsize_t, size_t);
-        if(H5F_shared_block_write(H5F_SHARED(dset->oloc.file), H5FD_MEM_DRAW, udata.chunk_block.offset, (size_t)udata.chunk_block.length, buf) < 0)
-            HGOTO_ERROR(H5E_DATASET, H5E_WRITEERROR, FAIL, "unable to write raw data to file")
+        /* Write the data to the file */
+        HDassert(H5F_addr_defined(udata.chunk_block.offset));
+        H5_CHECK_OVERFLOW(udata.chunk_block.length, hsize_t, size_t);
+        if(H5F_shared_block_write(H5F_SHARED(dset->oloc.file), H5FD_MEM_DRAW, udata.chunk_block.offset, (size_t)udata.chunk_block.length, buf) < 0)
+            HGOTO_ERROR(H5E_DATASET, H5E_WRITEERROR, FAIL, "unable to write raw data to file")
+
+        /* Insert the chunk record into the index */
+        if(need_insert && sc->ops->insert)
+            if((sc->ops->insert)(&idx_info, &udata, dset) < 0)
+                HGOTO_ERROR(H5E_DATASET, H5E_CANTINSERT, FAIL, "unable to insert chunk addr into index")
+
+        /* Cache the chunk's info, in case it's accessed again shortly */
+        H5D__chunk_cinfo_cache_update(&dset->shared->cache.chunk.last, &udata);
+
+        /* Mark cache entry as clean */
+        ent->dirty = FALSE;
+
+        /* Increment # of flushed entries */
+        dset->shared->cache.chunk.stats.nflushes++;
+    } /* end if */
+
+    /* Reset, but do not free or removed from list */
+    if(reset) {
+        point_of_no_return = FALSE;
+        if(buf == ent->chunk)
+            buf = NULL;
+        if(ent->chunk != NULL)
+            ent->chunk = (uint8_t *)H5D__chunk_pool_free(dset->shared, ent->chunk,
+                    (size_t)dset->shared->layout.u.chunk.size,
+                    ((ent->edge_chunk_state & H5D_RDCC_DISABLE_FILTERS) ? NULL
+                    : &(dset->shared->dcpl_cache.pline)));
+    } /* end if */
+
+done:
+    /* Free the temp buffer only if it's different than the entry chunk */
+    if(buf != ent->chunk)
+        (void)H5D__chunk_pool_free(dset->shared, buf, buf_alloc, &(dset->shared->dcpl_cache.pline));
+
+    /*
+     * If we reached the point of no return then we have no choice but to
+     * reset the entry.  This can only happen if RESET is true but the
+     * output pipeline failed.  Do not free the entry or remove it from the
+     * list.
+     */
+    if(ret_value < 0 && point_of_no_return)
+        if(ent->chunk)
+            ent->chunk = (uint8_t *)H5D__chunk_pool_free(dset->shared, ent->chunk,
+                    (size_t)dset->shared->layout.u.chunk.size,
+                    ((ent->edge_chunk_state & H5D_RDCC_DISABLE_FILTERS) ? NULL
+                    : &(dset->shared->dcpl_cache.pline)));
+
+    FUNC_LEAVE_NOAPI_TAG(ret_value)
+} /* end H5D__chunk_flush_entry() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:    H5D__chunk_cache_evict
+ *
+ * Purpose:     Preempts the specified entry from the cache, flushing it to
+ *              disk if necessary.
+ *
+ * Return:      Non-negative on success/Negative on failure
+ *
+ * Programmer:  Robb Matzke
+ *              Thursday, May 21, 1998
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5D__chunk_cache_evict(const H5D_t *dset, H5D_rdcc_ent_t *ent, hbool_t flush)
+{
+    herr_t      ret_value = SUCCEED;       /* Return value */
+
+    FUNC_ENTER_STATIC
+
+    /* Sanity checks */
+    HDassert(dset);
+    HDassert(ent);
+    HDassert(!ent->locked);
+    HDassert(ent->idx < dset->shared->cache.chunk.nslots);
+
+    /* Flush */
+    if(flush && H5D__chunk_flush_entry(dset, ent, TRUE) < 0)
+        HDONE_ERROR(H5E_IO, H5E_WRITEERROR, FAIL, "cannot flush indexed storage buffer")
+
+    /* Don't flush (any more), just free chunk and remove it from the cache */
+    H5D__chunk_cache_remove(dset->shared, ent);
+
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5D__chunk_cache_evict() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:    H5D__chunk_cache_remove
+ *
+ * Purpose:     Remove the specified entry from the chunk cache of the
+ *              dataset with shared info SHARED, freeing its chunk without
+ *              flushing it.  The entry must have been flushed already
+ *              if it's dirty, or be discarded.
+ *
+ *              Only the dataset's shared info is needed, so entries of
+ *              other datasets in the file may be removed, as long as
+ *              they're clean.
+ *
+ * Return:      void
+ *
+ *-------------------------------------------------------------------------
+ */
+static void
+H5D__chunk_cache_remove(H5D_shared_t *shared, H5D_rdcc_ent_t *ent)
+{
+    H5D_rdcc_t *rdcc = &(shared->cache.chunk);
+
+    FUNC_ENTER_STATIC_NOERR
+
+    /* Sanity checks */
+    HDassert(ent);
+    HDassert(!ent->locked);
+    HDassert(ent->idx < rdcc->nslots);
+
+    /* Free chunk */
+    if(ent->chunk != NULL)
+        ent->chunk = (uint8_t *)H5D__chunk_pool_free(shared, ent->chunk,
+                (size_t)shared->layout.u.chunk.size,
+                ((ent->edge_chunk_state & H5D_RDCC_DISABLE_FILTERS) ? NULL
+                : &(shared->dcpl_cache.pline)));
+
+    /* Unlink from list */
+    if(ent->prev)
+        ent->prev->next = ent->next;
+    else
+        rdcc->head = ent->next;
+    if(ent->next)
+        ent->next->prev = ent->prev;
+    else
+        rdcc->tail = ent->prev;
+    ent->prev = ent->next = NULL;
+
+    /* Unlink from temporary list */
+    if(ent->tmp_prev) {
+        HDassert(rdcc->tmp_head->tmp_next);
+        ent->tmp_prev->tmp_next = ent->tmp_next;
+        if(ent->tmp_next) {
+            ent->tmp_next->tmp_prev = ent->tmp_prev;
+            ent->tmp_next = NULL;
+        } /* end if */
+        ent->tmp_prev = NULL;
+    } /* end if */
+    else
+        /* Only clear hash table slot if the chunk was not on the temporary list
+         */
+        rdcc->slot[ent->idx] = NULL;
+
+    /* Unlink from the file-wide list */
+    if(rdcc->budget) {
+        if(ent->budget_prev)
+            ent->budget_prev->budget_next = ent->budget_next;
+        else
+            rdcc->budget->head = ent->budget_next;
+        if(ent->budget_next)
+            ent->budget_next->budget_prev = ent->budget_prev;
+        else
+            rdcc->budget->tail = ent->budget_prev;
+        ent->budget_prev = ent->budget_next = NULL;
+        rdcc->budget->nbytes_used -= shared->layout.u.chunk.size;
+    } /* end if */
+
+    /* Remember chunks preempted from the 2Q probationary queue */
+    if(ent->hot)
+        rdcc->nhot--;
+    else if(rdcc->ghost && !ent->deleted && NULL == rdcc->slot[ent->idx]) {
+        rdcc->ghost[ent->idx].key = H5D__chunk_ghost_key(shared, ent->scaled);
+        rdcc->ghost[ent->idx].seq = ++rdcc->ghost_seq;
+    } /* end if */
+
+    /* Remove from cache */
+    HDassert(rdcc->slot[ent->idx] != ent);
+    ent->idx = UINT_MAX;
+    rdcc->nbytes_used -= shared->layout.u.chunk.size;
+    rdcc->stats.nevictions++;
+    --rdcc->nused;
+
+    /* Free */
+    ent = H5FL_FREE(H5D_rdcc_ent_t, ent);
+
+    FUNC_LEAVE_NOAPI_VOID
+} /* end H5D__chunk_cache_remove() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:    H5D__chunk_cache_prune
+ *
+ * Purpose:    Prune the cache by preempting some things until the cache has
+ *        room for something which is SIZE bytes.  Only unlocked
+ *        entries are considered for preemption.
+ *
+ * Return:    Non-negative on success/Negative on failure
+ *
+ * Programmer:    Robb Matzke
+ *              Thursday, May 21, 1998
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5D__chunk_cache_prune(const H5D_t *dset, size_t size)
+{
+    const H5D_rdcc_t    *rdcc = &(dset->shared->cache.chunk);
+    size_t        total = rdcc->nbytes_max;
+    const int        nmeth = 2;    /*number of methods        */
+    int                w[1];        /*weighting as an interval    */
+    H5D_rdcc_ent_t    *p[2], *cur;    /*list pointers            */
+    H5D_rdcc_ent_t    *n[2];        /*list next pointers        */
+    int        nerrors = 0;            /* Accumulated error count during preemptions */
+    herr_t      ret_value = SUCCEED;       /* Return value */
+
+    FUNC_ENTER_STATIC
+
+    /* The 2Q policy has its own preemption order */
+    if(H5D_CHUNK_CACHE_POLICY_2Q == rdcc->policy) {
+        if(H5D__chunk_cache_prune_2q(dset, size) < 0)
+            HGOTO_ERROR(H5E_IO, H5E_CANTFLUSH, FAIL, "unable to preempt one or more raw data cache entry")
+        HGOTO_DONE(SUCCEED)
+    } /* end if */
+
+    /*
+     * Preemption is accomplished by having multiple pointers (currently two)
+     * slide down the list beginning at the head. Pointer p(N+1) will start
+     * traversing the list when pointer pN reaches wN percent of the original
+     * list.  In other words, preemption method N gets to consider entries in
+     * approximate least recently used order w0 percent before method N+1
+     * where 100% means tha method N will run to completion before method N+1
+     * begins.  The pointers participating in the list traversal are each
+     * given a chance at preemption before any of the pointers are advanced.
+     */
+    w[0] = (int)(rdcc->nused * rdcc->w0);
+    p[0] = rdcc->head;
+    p[1] = NULL;
+
+    while((p[0] || p[1]) && (rdcc->nbytes_used + size) > total) {
+        int i;          /* Local index variable */
+
+    /* Introduce new pointers */
+    for(i = 0; i < nmeth - 1; i++)
+            if(0 == w[i])
+                p[i + 1] = rdcc->head;
+
+    /* Compute next value for each pointer */
+    for(i = 0; i < nmeth; i++)
+            n[i] = p[i] ? p[i]->next : NULL;
+
+    /* Give each method a chance */
+    for(i = 0; i < nmeth && (rdcc->nbytes_used + size) > total; i++) {
+        if(0 == i && p[0] && !p[0]->locked &&
+                    ((0 == p[0]->rd_count && 0 == p[0]->wr_count) ||
+                     (0 == p[0]->rd_count && dset->shared->layout.u.chunk.size == p[0]->wr_count) ||
+                     (dset->shared->layout.u.chunk.size == p[0]->rd_count && 0 == p[0]->wr_count))) {
+        /*
+        * Method 0: Preempt entries that have been completely written
+        * and/or completely read but not entries that are partially
+        * written or partially read.
+        */
+        cur = p[0];
+        } else if(1 == i && p[1] && !p[1]->locked) {
+        /*
+        * Method 1: Preempt the entry without regard to
+        * considerations other than being locked.  This is the last
+        * resort preemption.
+        */
+        cur = p[1];
+        } else {
+        /* Nothing to preempt at this point */
+        cur = NULL;
+        }
+
+        if(cur) {
+                int j;          /* Local index variable */
+
+        for(j = 0; j < nmeth; j++) {
+            if(p[j] == cur)
+                        p[j] = NULL;
+            if(n[j] == cur)
+                        n[j] = cur->next;
+        } /* end for */
+
+                /* Write the dirty chunks nearest preemption along with this
+                 * one, if using multiple threads to filter them */
+                if(cur->dirty && rdcc->encode_nthreads > 1
+                        && dset->shared->dcpl_cache.pline.nused
+                        && !(cur->edge_chunk_state & H5D_RDCC_DISABLE_FILTERS))
+                    if(H5D__chunk_flush_lru(dset, cur) < 0)
+                        nerrors++;
+
+                dset->shared->cache.chunk.stats.npreemptions++;
+        if(H5D__chunk_cache_evict(dset, cur, TRUE) < 0)
+                    nerrors++;
+        } /* end if */
+    } /* end for */
+
+    /* Advance pointers */
+    for(i = 0; i < nmeth; i++)
+            p[i] = n[i];
+    for(i = 0; i < nmeth - 1; i++)
+            w[i] -= 1;
+    } /* end while */
+
+    if(nerrors)
+    HGOTO_ERROR(H5E_IO, H5E_CANTFLUSH, FAIL, "unable to preempt one or more raw data cache entry")
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5D__chunk_cache_prune() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:    H5D__chunk_cache_prune_2q
+ *
+ * Purpose:     Prune the cache with the 2Q policy until it has room for
+ *              something which is SIZE bytes.  Entries in the
+ *              probationary queue are preempted oldest first while they
+ *              take up more than a quarter of the cache, and entries in
+ *              the hot queue are preempted least recently used first
+ *              otherwise.  Only unlocked entries are considered.
+ *
+ *              Both queues share the cache's linked list: new entries
+ *              are added at the tail and hot entries move to the tail
+ *              when used, so walking from the head finds the entries in
+ *              preemption order.
+ *
+ * Return:      Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5D__chunk_cache_prune_2q(const H5D_t *dset, size_t size)
+{
+    const H5D_rdcc_t    *rdcc = &(dset->shared->cache.chunk);
+    size_t              total = rdcc->nbytes_max;
+    size_t              chunk_size = dset->shared->layout.u.chunk.size;
+    int                 nerrors = 0;            /* Accumulated error count during preemptions */
+    herr_t              ret_value = SUCCEED;    /* Return value */
+
+    FUNC_ENTER_STATIC
+
+    while((rdcc->nbytes_used + size) > total) {
+        H5D_rdcc_ent_t  *cur, *fallback = NULL;    /* Entries to preempt */
+        hbool_t         want_hot;               /* Whether to preempt from the hot queue */
+
+        /* Pick the queue to preempt from */
+        want_hot = (size_t)(rdcc->nused - rdcc->nhot) * chunk_size <= total / 4;
+
+        /* Find the first unlocked entry in that queue, or else in the other one */
+        for(cur = rdcc->head; cur; cur = cur->next)
+            if(!cur->locked) {
+                if(cur->hot == want_hot)
+                    break;
+                if(!fallback)
+                    fallback = cur;
+            } /* end if */
+        if(!cur && NULL == (cur = fallback))
+            break;
+
+        /* Write the dirty chunks nearest preemption along with this one, if
+         * using multiple threads to filter them */
+        if(cur->dirty && rdcc->encode_nthreads > 1
+                && dset->shared->dcpl_cache.pline.nused
+                && !(cur->edge_chunk_state & H5D_RDCC_DISABLE_FILTERS))
+            if(H5D__chunk_flush_lru(dset, cur) < 0)
+                nerrors++;
+
+        dset->shared->cache.chunk.stats.npreemptions++;
+        if(H5D__chunk_cache_evict(dset, cur, TRUE) < 0)
+            nerrors++;
+    } /* end while */
+
+    if(nerrors)
+        HGOTO_ERROR(H5E_IO, H5E_CANTFLUSH, FAIL, "unable to preempt one or more raw data cache entry")
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5D__chunk_cache_prune_2q() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:    H5D__chunk_cache_prune_budget
+ *
+ * Purpose:     Prune the chunk caches of all the datasets open in the
+ *              file until the file's chunk cache budget has room for
+ *              something which is SIZE bytes.  Entries are preempted in
+ *              least recently used order across the datasets.  Only
+ *              unlocked entries are considered.
+ *
+ *              Dirty entries of other datasets are skipped: they can
+ *              only be flushed under their own dataset, and are left
+ *              for it to flush (or preempt) the next time it's accessed
+ *              or closed.  Clean entries of other datasets are simply
+ *              removed from their caches.
+ *
+ * Return:      Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5D__chunk_cache_prune_budget(const H5D_t *dset, size_t size)
+{
+    H5F_rdcc_budget_t   *budget = dset->shared->cache.chunk.budget; /* File-wide chunk cache budget */
+    int                 nerrors = 0;            /* Accumulated error count during preemptions */
+    herr_t              ret_value = SUCCEED;    /* Return value */
+
+    FUNC_ENTER_STATIC
+
+    /* Sanity check */
+    HDassert(budget);
+
+    while((budget->nbytes_used + size) > budget->nbytes_max) {
+        H5D_rdcc_ent_t  *ent;                   /* Entry to preempt */
+
+        /* Find the least recently used entry that isn't locked, and
+         * belongs to this dataset or is clean */
+        for(ent = budget->head; ent; ent = ent->budget_next)
+            if(!ent->locked && (ent->owner == dset->shared || !ent->dirty))
+                break;
+        if(!ent)
+            break;
+
+        ent->owner->cache.chunk.stats.npreemptions++;
+        if(ent->owner == dset->shared) {
+            if(H5D__chunk_cache_evict(dset, ent, TRUE) < 0)
+                nerrors++;
+        } /* end if */
+        else
+            H5D__chunk_cache_remove(ent->owner, ent);
+    } /* end while */
+
+    if(nerrors)
+        HGOTO_ERROR(H5E_IO, H5E_CANTFLUSH, FAIL, "unable to preempt one or more raw data cache entry")
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5D__chunk_cache_prune_budget() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:    H5D__chunk_cache_insert
+ *
+ * Purpose:     Add an unlocked, clean entry for a chunk to the raw data
+ *              chunk cache, in slot IDX.  Any entry already in that slot
+ *              (which must not be locked) is preempted, and the cache is
+ *              pruned to make room for the new chunk.  On success the
+ *              cache takes ownership of the CHUNK buffer.
+ *
+ * Return:      Success:    Pointer to the new cache entry
+ *
+ *              Failure:    NULL
+ *
+ *-------------------------------------------------------------------------
+ */
+static H5D_rdcc_ent_t *
+H5D__chunk_cache_insert(const H5D_t *dset, const H5D_chunk_ud_t *udata,
+    unsigned idx, unsigned edge_chunk_state, void *chunk)
+{
+    H5D_rdcc_t          *rdcc = &(dset->shared->cache.chunk); /* Raw data chunk cache */
+    H5D_rdcc_ent_t      *ent;                   /* Cache entry */
+    size_t              chunk_size;             /* Size of a chunk */
+    hbool_t             hot = FALSE;            /* Whether the entry goes in the 2Q hot queue */
+    H5D_rdcc_ent_t      *ret_value = NULL;      /* Return value */
+
+    FUNC_ENTER_STATIC
+
+    /* Sanity checks */
+    HDassert(udata);
+    HDassert(idx < rdcc->nslots);
+    HDassert(chunk);
+
+    /* Get the chunk's size */
+    H5_CHECKED_ASSIGN(chunk_size, size_t, dset->shared->layout.u.chunk.size, uint32_t);
+
+    /* With the 2Q policy, chunks used again soon after being preempted from
+     * the probationary queue go straight into the hot queue */
+    if(rdcc->ghost && H5D__chunk_ghost_find(dset, idx, udata->common.scaled)) {
+        hot = TRUE;
+        rdcc->ghost[idx].key = 0;
+    } /* end if */
+
+    /* Preempt enough things from the cache to make room */
+    if((ent = rdcc->slot[idx])) {
+        HDassert(!ent->locked);
+        rdcc->stats.npreemptions++;
+        if(H5D__chunk_cache_evict(dset, ent, TRUE) < 0)
+            HGOTO_ERROR(H5E_IO, H5E_CANTINIT, NULL, "unable to preempt chunk from cache")
+    } /* end if */
+    if(H5D__chunk_cache_prune(dset, chunk_size) < 0)
+        HGOTO_ERROR(H5E_IO, H5E_CANTINIT, NULL, "unable to preempt chunk(s) from cache")
+    if(rdcc->budget && H5D__chunk_cache_prune_budget(dset, chunk_size) < 0)
+        HGOTO_ERROR(H5E_IO, H5E_CANTINIT, NULL, "unable to preempt chunk(s) from file's caches")
+
+    /* Create a new entry */
+    if(NULL == (ent = H5FL_CALLOC(H5D_rdcc_ent_t)))
+        HGOTO_ERROR(H5E_DATASET, H5E_CANTALLOC, NULL, "can't allocate raw data chunk entry")
+
+    /* Initialize the new entry */
+    ent->edge_chunk_state = edge_chunk_state;
+    ent->hot = hot;
+    ent->chunk_block.offset = udata->chunk_block.offset;
+    ent->chunk_block.length = udata->chunk_block.length;
+    ent->chunk_idx = udata->chunk_idx;
+    H5MM_memcpy(ent->scaled, udata->common.scaled, sizeof(hsize_t) * dset->shared->layout.u.chunk.ndims);
+    H5_CHECKED_ASSIGN(ent->rd_count, uint32_t, chunk_size, size_t);
+    H5_CHECKED_ASSIGN(ent->wr_count, uint32_t, chunk_size, size_t);
+    ent->chunk = (uint8_t *)chunk;
+
+    /* Add it to the cache */
+    HDassert(NULL == rdcc->slot[idx]);
+    rdcc->slot[idx] = ent;
+    ent->idx = idx;
+    rdcc->nbytes_used += chunk_size;
+    rdcc->nused++;
+    if(hot)
+        rdcc->nhot++;
+
+    /* Add it to the linked list */
+    if(rdcc->tail) {
+        rdcc->tail->next = ent;
+        ent->prev = rdcc->tail;
+        rdcc->tail = ent;
+    } /* end if */
+    else
+        rdcc->head = rdcc->tail = ent;
+    ent->tmp_next = NULL;
+    ent->tmp_prev = NULL;
+
+    /* Add it to the file-wide list */
+    if(rdcc->budget) {
+        ent->owner = dset->shared;
+        if(rdcc->budget->tail) {
+            rdcc->budget->tail->budget_next = ent;
+            ent->budget_prev = rdcc->budget->tail;
+            rdcc->budget->tail = ent;
+        } /* end if */
+        else
+            rdcc->budget->head = rdcc->budget->tail = ent;
+        rdcc->budget->nbytes_used += chunk_size;
+    } /* end if */
+
+    /* Set return value */
+    ret_value = ent;
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5D__chunk_cache_insert() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:    H5D__chunk_pline_thread_safe
+ *
+ * Purpose:     Check whether the filter pipeline can be run on the helper
+ *              threads of H5TS_parallel_for() for the current operation:
+ *              its filters must all be ones the library provides itself
+ *              (see H5Z_pipeline_thread_safe()), and there must be no
+ *              application filter callback, which may call the API.
+ *
+ * Return:      TRUE/FALSE on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+static htri_t
+H5D__chunk_pline_thread_safe(const H5O_pline_t *pline)
+{
+    H5Z_cb_t filter_cb;                 /* I/O filter callback function */
+    htri_t ret_value = TRUE;            /* Return value */
+
+    FUNC_ENTER_STATIC
+
+    if(H5CX_get_filter_cb(&filter_cb) < 0)
+        HGOTO_ERROR(H5E_DATASET, H5E_CANTGET, FAIL, "can't get I/O filter callback function")
+    if(filter_cb.func)
+        HGOTO_DONE(FALSE)
+
+    if((ret_value = H5Z_pipeline_thread_safe(pline)) < 0)
+        HGOTO_ERROR(H5E_PLINE, H5E_CANTGET, FAIL, "can't check filter pipeline")
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5D__chunk_pline_thread_safe() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:    H5D__chunk_encode_cb
+ *
+ * Purpose:     Run the filter pipeline on a copy of one of the entries
+ *              being flushed by H5D__chunk_flush_entries(), leaving the
+ *              result in the entry for H5D__chunk_flush_entry() to write.
+ *              This may be called from a helper thread (see
+ *              H5TS_parallel_for() for what the filter pipeline may do
+ *              there, and for how its errors reach the calling thread).
+ *              Entries that aren't dirty or don't need filtering are
+ *              skipped.
+ *
+ * Return:      Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5D__chunk_encode_cb(size_t idx, void *_udata)
+{
+    H5D_chunk_encode_ud_t *udata = (H5D_chunk_encode_ud_t *)_udata;
+    H5D_rdcc_ent_t *ent = udata->ents[idx];     /* Entry to filter */
+    void *buf;                          /* Buffer for filtering */
+    size_t alloc = udata->chunk_size;   /* Bytes allocated for BUF */
+    size_t nbytes = udata->chunk_size;  /* Size of the data in BUF */
+    unsigned filter_mask = 0;           /* Filter mask */
+    herr_t ret_value = SUCCEED;         /* Return value */
+
+    FUNC_ENTER_STATIC
+
+    HDassert(!ent->filt_buf);
+
+    if(ent->dirty && !ent->locked && !(ent->edge_chunk_state & H5D_RDCC_DISABLE_FILTERS)) {
+        if(NULL == (buf = H5MM_malloc(alloc)))
+            HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "memory allocation failed for pipeline")
+        H5MM_memcpy(buf, ent->chunk, alloc);
+
+        if(H5Z_pipeline(udata->pline, 0, &filter_mask, udata->err_detect,
+                udata->filter_cb, (size_t)0, &nbytes, &alloc, &buf) < 0) {
+            H5MM_xfree(buf);
+            HGOTO_ERROR(H5E_PLINE, H5E_CANTFILTER, FAIL, "output pipeline failed")
+        } /* end if */
+        if((udata->filter_mode & H5D_CHUNK_FILTER_ADAPTIVE)
+                && H5D__chunk_filter_adapt(udata->pline, udata->min_gain, ent->chunk,
+                        udata->chunk_size, udata->err_detect, udata->filter_cb,
+                        &filter_mask, &nbytes, &alloc, &buf) < 0) {
+            H5MM_xfree(buf);
+            HGOTO_ERROR(H5E_PLINE, H5E_CANTFILTER, FAIL, "unable to pick chunk filters")
+        } /* end if */
+
+        ent->filt_buf = (uint8_t *)buf;
+        ent->filt_alloc = alloc;
+        ent->filt_nbytes = nbytes;
+        ent->filt_mask = filter_mask;
+    } /* end if */
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5D__chunk_encode_cb() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:    H5D__chunk_cmp_ent_addr
+ *
+ * Purpose:     Compare the file addresses of two cache entries, for
+ *              sorting them with HDqsort().  Entries without an address
+ *              sort last, and ties are broken by the entries' hash slots.
+ *
+ * Return:      -1, 0 or 1, like strcmp()
+ *
+ *-------------------------------------------------------------------------
+ */
+static int
+H5D__chunk_cmp_ent_addr(const void *_ent1, const void *_ent2)
+{
+    const H5D_rdcc_ent_t *ent1 = *(const H5D_rdcc_ent_t * const *)_ent1;
+    const H5D_rdcc_ent_t *ent2 = *(const H5D_rdcc_ent_t * const *)_ent2;
+    int ret_value = 0;                  /* Return value */
+
+    FUNC_ENTER_STATIC_NOERR
+
+    /* (HADDR_UNDEF is larger than any defined address) */
+    if(ent1->chunk_block.offset != ent2->chunk_block.offset)
+        ret_value = (ent1->chunk_block.offset < ent2->chunk_block.offset) ? -1 : 1;
+    else
+        ret_value = (ent1->idx > ent2->idx) - (ent1->idx < ent2->idx);
+
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5D__chunk_cmp_ent_addr() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:    H5D__chunk_flush_entries
+ *
+ * Purpose:     Flush the NENTS unlocked cache entries in ENTS, preempting
+ *              them from the cache as well if EVICT is set.  The filter
+ *              pipeline is run on the dirty entries first, using up to the
+ *              dataset's number of chunk encode threads, and then the
+ *              entries are written in order of their current addresses in
+ *              the file.  ENTS is sorted in place.
+ *
+ * Return:      Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5D__chunk_flush_entries(const H5D_t *dset, H5D_rdcc_ent_t **ents, size_t nents,
+    hbool_t evict)
+{
+    const H5D_rdcc_t    *rdcc = &(dset->shared->cache.chunk); /* Raw data chunk cache */
+    const H5O_pline_t   *pline = &(dset->shared->dcpl_cache.pline); /* I/O pipeline info */
+    unsigned            nerrors = 0;            /* Count of errors flushing entries */
+    size_t              u;                      /* Local index variable */
+    herr_t              ret_value = SUCCEED;    /* Return value */
+
+    FUNC_ENTER_STATIC
+
+    /* Sanity checks */
+    HDassert(ents);
+    HDassert(nents > 0);
+
+    /* Filter the dirty entries, when the pipeline can run on helper
+     * threads */
+    if(pline->nused > 0 && rdcc->encode_nthreads > 1 && nents > 1) {
+        htri_t thread_safe;             /* Whether the pipeline can run on helper threads */
+
+        if((thread_safe = H5D__chunk_pline_thread_safe(pline)) < 0)
+            HGOTO_ERROR(H5E_DATASET, H5E_CANTGET, FAIL, "can't check filter pipeline")
+        if(thread_safe) {
+            H5D_chunk_encode_ud_t encode_udata;     /* User data for filtering entries */
+            double start;                           /* Time the filters were started */
+            herr_t status;                          /* Status of filtering the entries */
+
+            /* Retrieve filter settings from API context */
+            if(H5CX_get_err_detect(&encode_udata.err_detect) < 0)
+                HGOTO_ERROR(H5E_DATASET, H5E_CANTGET, FAIL, "can't get error detection info")
+            if(H5CX_get_filter_cb(&encode_udata.filter_cb) < 0)
+                HGOTO_ERROR(H5E_DATASET, H5E_CANTGET, FAIL, "can't get I/O filter callback function")
+
+            /* (There's no application filter callback to call from helper
+             *  threads, see H5D__chunk_pline_thread_safe()) */
+            HDassert(NULL == encode_udata.filter_cb.func);
+            encode_udata.pline = pline;
+            encode_udata.filter_mode = dset->shared->dcpl_cache.chunk_filter_mode;
+            encode_udata.min_gain = dset->shared->dcpl_cache.chunk_filter_min_gain;
+            H5_CHECKED_ASSIGN(encode_udata.chunk_size, size_t, dset->shared->layout.u.chunk.size, uint32_t);
+            encode_udata.ents = ents;
+
+            start = H5_get_time();
+            status = H5TS_parallel_for(rdcc->encode_nthreads, nents, H5D__chunk_encode_cb, &encode_udata);
+            dset->shared->cache.chunk.stats.filter_time += H5_get_time() - start;
+
+            /* If any entry failed, leave them all dirty and unfiltered */
+            if(status < 0) {
+                for(u = 0; u < nents; u++)
+                    if(ents[u]->filt_buf)
+                        ents[u]->filt_buf = (uint8_t *)H5MM_xfree(ents[u]->filt_buf);
+                HGOTO_ERROR(H5E_DATASET, H5E_CANTFILTER, FAIL, "unable to filter raw data chunks")
+            } /* end if */
+        } /* end if */
+    } /* end if */
+
+    /* Write the entries in address order */
+    HDqsort(ents, nents, sizeof(H5D_rdcc_ent_t *), H5D__chunk_cmp_ent_addr);
+    for(u = 0; u < nents; u++) {
+        if(evict) {
+            if(H5D__chunk_cache_evict(dset, ents[u], TRUE) < 0)
+                nerrors++;
+        } /* end if */
+        else if(H5D__chunk_flush_entry(dset, ents[u], FALSE) < 0)
+            nerrors++;
+    } /* end for */
+    if(nerrors)
+        HGOTO_ERROR(H5E_DATASET, H5E_CANTFLUSH, FAIL, "unable to flush one or more raw data chunks")
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5D__chunk_flush_entries() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:    H5D__chunk_flush_lru
+ *
+ * Purpose:     Flush VICTIM, an entry that is about to be preempted, along
+ *              with the next few dirty entries in least recently used
+ *              order, so that their filters can run concurrently.  The
+ *              entries stay in the cache, but clean, making preempting
+ *              them later cheap.
+ *
+ * Return:      Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5D__chunk_flush_lru(const H5D_t *dset, H5D_rdcc_ent_t *victim)
+{
+    const H5D_rdcc_t    *rdcc = &(dset->shared->cache.chunk); /* Raw data chunk cache */
+    H5D_rdcc_ent_t      **ents = NULL;          /* Entries to flush */
+    H5D_rdcc_ent_t      *ent;                   /* Current entry */
+    size_t              max_ents;               /* Max. # of entries to flush */
+    size_t              nents = 0;              /* # of entries to flush */
+    herr_t              ret_value = SUCCEED;    /* Return value */
+
+    FUNC_ENTER_STATIC
+
+    /* Sanity checks */
+    HDassert(victim);
+    HDassert(victim->dirty);
+    HDassert(!victim->locked);
+
+    /* Flush a couple of entries per thread */
+    max_ents = 2 * (size_t)rdcc->encode_nthreads;
+    if(NULL == (ents = (H5D_rdcc_ent_t **)H5MM_malloc(max_ents * sizeof(H5D_rdcc_ent_t *))))
+        HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "memory allocation failed for cache entry list")
+
+    ents[nents++] = victim;
+    for(ent = rdcc->head; ent && nents < max_ents; ent = ent->next)
+        if(ent != victim && ent->dirty && !ent->locked
+                && !(ent->edge_chunk_state & H5D_RDCC_DISABLE_FILTERS))
+            ents[nents++] = ent;
+
+    if(H5D__chunk_flush_entries(dset, ents, nents, FALSE) < 0)
+        HGOTO_ERROR(H5E_DATASET, H5E_CANTFLUSH, FAIL, "unable to flush raw data chunks")
+
+done:
+    if(ents)
+        ents = (H5D_rdcc_ent_t **)H5MM_xfree(ents);
+
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5D__chunk_flush_lru() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:    H5D__chunk_decode_cb
+ *
+ * Purpose:     Run the filter pipeline in reverse on one of the chunks
+ *              read by H5D__chunk_load_batch().  This may be called
+ *              from a helper thread, so it only touches the chunk's own
+ *              buffer (see H5TS_parallel_for() for what the filter
+ *              pipeline may do there, and for how its errors reach the
+ *              calling thread).
+ *
+ * Return:      Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5D__chunk_decode_cb(size_t idx, void *_udata)
+{
+    H5D_chunk_decode_ud_t *udata = (H5D_chunk_decode_ud_t *)_udata;
+    H5D_chunk_decode_t *chk = &udata->chunks[idx];  /* Chunk to decode */
+    herr_t ret_value = SUCCEED;         /* Return value */
+
+    FUNC_ENTER_STATIC
+
+    /* (Unfiltered chunks are used as read) */
+    if(chk->filtered) {
+        if(H5Z_pipeline(udata->pline, H5Z_FLAG_REVERSE, &(chk->udata.filter_mask),
+                udata->err_detect, udata->filter_cb, udata->chunk_size, &chk->nbytes, &chk->buf_alloc, &chk->buf) < 0)
+            HGOTO_ERROR(H5E_PLINE, H5E_CANTFILTER, FAIL, "data pipeline read failed")
+        chk->decoded = TRUE;
+    } /* end if */
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5D__chunk_decode_cb() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:    H5D__chunk_cmp_decode_addr
+ *
+ * Purpose:     Compare the file addresses of two chunks to load, for
+ *              sorting them with HDqsort().
+ *
+ * Return:      -1, 0 or 1, like strcmp()
+ *
+ *-------------------------------------------------------------------------
+ */
+static int
+H5D__chunk_cmp_decode_addr(const void *_chk1, const void *_chk2)
+{
+    const H5D_chunk_decode_t *chk1 = *(const H5D_chunk_decode_t * const *)_chk1;
+    const H5D_chunk_decode_t *chk2 = *(const H5D_chunk_decode_t * const *)_chk2;
+    int ret_value = 0;                  /* Return value */
+
+    FUNC_ENTER_STATIC_NOERR
+
+    ret_value = (chk1->udata.chunk_block.offset > chk2->udata.chunk_block.offset)
+            - (chk1->udata.chunk_block.offset < chk2->udata.chunk_block.offset);
+
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5D__chunk_cmp_decode_addr() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:    H5D__chunk_load_batch
+ *
+ * Purpose:     Load a batch of chunks that aren't cached yet into the
+ *              chunk cache.  The raw chunks are read from the file first
+ *              and the filtered ones are then decoded with up to NTHREADS
+ *              threads.
+ *
+ *              The caller fills in the index info, cache slot and scaled
+ *              coordinates of each chunk and makes sure that no two
+ *              chunks in the batch map to the same cache slot.  Chunks
+ *              that decode to less than a full chunk are dropped and
+ *              left for the regular read path.
+ *
+ *              If the dataset's chunk cache coalesces reads, the chunks
+ *              are read in the order of their addresses, and chunks
+ *              stored back to back in the file are read together, up
+ *              to the size set with H5Pset_chunk_read_coalesce.
+ *
+ * Return:      Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5D__chunk_load_batch(const H5D_t *dset, H5D_chunk_decode_t *chunks,
+    size_t nchunks, unsigned nthreads)
+{
+    const H5O_pline_t   *pline = &(dset->shared->dcpl_cache.pline); /* I/O pipeline info */
+    H5D_rdcc_t          *rdcc = &(dset->shared->cache.chunk); /* Raw data chunk cache */
+    H5D_chunk_decode_ud_t decode_udata;         /* User data for decoding chunks */
+    H5D_chunk_decode_t  **order = NULL;         /* Chunks sorted by address, when coalescing reads */
+    void                *run_buf = NULL;        /* Buffer for reading several chunks at once */
+    size_t              run_buf_size = 0;       /* Size of the run buffer */
+    size_t              nread = 0;              /* Number of chunks with buffers */
+    size_t              chunk_size;             /* Size of a chunk */
+    hbool_t             any_filtered = FALSE;   /* Whether any chunk must be decoded */
+    double              start;                  /* Time the filters were started */
+    herr_t              status;                 /* Status of decoding the chunks */
+    size_t              u, v, w;                /* Local index variables */
+    herr_t              ret_value = SUCCEED;    /* Return value */
+
+    FUNC_ENTER_STATIC
+
+    /* Sanity checks */
+    HDassert(chunks);
+    HDassert(nchunks > 0);
+
+    /* Get the chunk's size */
+    H5_CHECKED_ASSIGN(chunk_size, size_t, dset->shared->layout.u.chunk.size, uint32_t);
+
+    /* Allocate the buffers for the raw chunks */
+    for(u = 0; u < nchunks; u++) {
+        H5D_chunk_decode_t *chk = &chunks[u];
+
+        H5_CHECKED_ASSIGN(chk->nbytes, size_t, chk->udata.chunk_block.length, hsize_t);
+        chk->decoded = !chk->filtered;
+        if(NULL == (chk->buf = H5D__chunk_pool_alloc(dset->shared, chk->nbytes, chk->filtered ? pline : NULL, &chk->buf_alloc)))
+            HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "memory allocation failed for raw data chunk")
+        nread++;
+
+        if(chk->filtered)
+            any_filtered = TRUE;
+    } /* end for */
+
+    /* Sort the chunks by address, to find the ones next to each other */
+    if(rdcc->coalesce_max > 0 && nchunks > 1) {
+        if(NULL == (order = (H5D_chunk_decode_t **)H5MM_malloc(nchunks * sizeof(H5D_chunk_decode_t *))))
+            HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "memory allocation failed for chunk read order")
+        for(u = 0; u < nchunks; u++)
+            order[u] = &chunks[u];
+        HDqsort(order, nchunks, sizeof(H5D_chunk_decode_t *), H5D__chunk_cmp_decode_addr);
+    } /* end if */
+
+    /* Read the raw chunks from the file */
+    for(u = 0; u < nchunks; u = v) {
+        H5D_chunk_decode_t *chk = order ? order[u] : &chunks[u];
+        size_t run_nbytes = chk->nbytes;    /* Size of the chunks read together */
+
+        /* Extend the read over the following chunks stored right after
+         * this one */
+        v = u + 1;
+        if(order)
+            while(v < nchunks && H5F_addr_eq(order[v]->udata.chunk_block.offset,
+                        order[v - 1]->udata.chunk_block.offset + order[v - 1]->nbytes)
+                    && run_nbytes + order[v]->nbytes <= rdcc->coalesce_max) {
+                run_nbytes += order[v]->nbytes;
+                v++;
+            } /* end while */
+
+        if(v - u > 1) {
+            uint8_t *p;                     /* Pointer into the run buffer */
+
+            if(run_nbytes > run_buf_size) {
+                run_buf = H5MM_xfree(run_buf);
+                if(NULL == (run_buf = H5MM_malloc(run_nbytes)))
+                    HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "memory allocation failed for coalesced chunk read")
+                run_buf_size = run_nbytes;
+            } /* end if */
+
+            if(H5F_shared_block_read(H5F_SHARED(dset->oloc.file), H5FD_MEM_DRAW, chk->udata.chunk_block.offset, run_nbytes, run_buf) < 0)
+                HGOTO_ERROR(H5E_IO, H5E_READERROR, FAIL, "unable to read raw data chunks")
+
+            /* Hand out the chunks' data */
+            p = (uint8_t *)run_buf;
+            for(w = u; w < v; w++) {
+                H5MM_memcpy(order[w]->buf, p, order[w]->nbytes);
+                p += order[w]->nbytes;
+            } /* end for */
+        } /* end if */
+        else
+            if(H5F_shared_block_read(H5F_SHARED(dset->oloc.file), H5FD_MEM_DRAW, chk->udata.chunk_block.offset, chk->nbytes, chk->buf) < 0)
+                HGOTO_ERROR(H5E_IO, H5E_READERROR, FAIL, "unable to read raw data chunk")
+
+        rdcc->stats.nreads++;
+    } /* end for */
 
-        /* Insert the chunk record into the index */
-        if(need_insert && sc->ops->insert)
-            if((sc->ops->insert)(&idx_info, &udata, dset) < 0)
-                HGOTO_ERROR(H5E_DATASET, H5E_CANTINSERT, FAIL, "unable to insert chunk addr into index")
+    if(any_filtered) {
+        /* Retrieve filter settings from API context */
+        decode_udata.pline = pline;
+        decode_udata.chunks = chunks;
+        H5_CHECKED_ASSIGN(decode_udata.chunk_size, size_t, dset->shared->layout.u.chunk.size, uint32_t);
+        if(H5CX_get_err_detect(&decode_udata.err_detect) < 0)
+            HGOTO_ERROR(H5E_DATASET, H5E_CANTGET, FAIL, "can't get error detection info")
+        if(H5CX_get_filter_cb(&decode_udata.filter_cb) < 0)
+            HGOTO_ERROR(H5E_DATASET, H5E_CANTGET, FAIL, "can't get I/O filter callback function")
+
+        /* (There's no application filter callback to call from helper
+         *  threads, see H5D__chunk_pline_thread_safe()) */
+        HDassert(nthreads <= 1 || NULL == decode_udata.filter_cb.func);
+
+        /* Decode the chunks */
+        start = H5_get_time();
+        status = H5TS_parallel_for(nthreads, nchunks, H5D__chunk_decode_cb, &decode_udata);
+        rdcc->stats.filter_time += H5_get_time() - start;
+        if(status < 0)
+            HGOTO_ERROR(H5E_DATASET, H5E_CANTFILTER, FAIL, "unable to decode raw data chunks")
+        for(u = 0; u < nchunks; u++)
+            if(chunks[u].filtered && chunks[u].decoded)
+                rdcc->stats.nbytes_decoded += chunks[u].nbytes;
+    } /* end if */
 
-        /* Cache the chunk's info, in case it's accessed again shortly */
-        H5D__chunk_cinfo_cache_update(&dset->shared->cache.chunk.last, &udata);
+    /* Add the decoded chunks to the cache */
+    for(u = 0; u < nchunks; u++) {
+        H5D_chunk_decode_t *chk = &chunks[u];
 
-        /* Mark cache entry as clean */
-        ent->dirty = FALSE;
+        /* (Chunks that decoded to less than a full chunk are left for the
+         *  read loop to deal with) */
+        if(chk->decoded && chk->buf_alloc >= chunk_size) {
+            unsigned edge_chunk_state = 0;  /* Edge chunk state for the new entry */
 
-        /* Increment # of flushed entries */
-        dset->shared->cache.chunk.stats.nflushes++;
-    } /* end if */
+            if(pline->nused && !chk->filtered)
+                edge_chunk_state = H5D_RDCC_DISABLE_FILTERS;
+            if(NULL == H5D__chunk_cache_insert(dset, &chk->udata, chk->idx, edge_chunk_state, chk->buf))
+                HGOTO_ERROR(H5E_DATASET, H5E_CANTINSERT, FAIL, "unable to add chunk to cache")
+            chk->buf = NULL;
 
-    /* Reset, but do not free or removed from list */
-    if(reset) {
-        point_of_no_return = FALSE;
-        if(buf == ent->chunk)
-            buf = NULL;
-        if(ent->chunk != NULL)
-            ent->chunk = (uint8_t *)H5D__chunk_mem_xfree(ent->chunk,
-                    ((ent->edge_chunk_state & H5D_RDCC_DISABLE_FILTERS) ? NULL
-                    : &(dset->shared->dcpl_cache.pline)));
-    } /* end if */
+            /* Increment # of cache misses */
+            rdcc->stats.nmisses++;
+        } /* end if */
+    } /* end for */
 
 done:
-    /* Free the temp buffer only if it's different than the entry chunk */
-    if(buf != ent->chunk)
-        H5MM_xfree(buf);
-
-    /*
-     * If we reached the point of no return then we have no choice but to
-     * reset the entry.  This can only happen if RESET is true but the
-     * output pipeline failed.  Do not free the entry or remove it from the
-     * list.
-     */
-    if(ret_value < 0 && point_of_no_return)
-        if(ent->chunk)
-            ent->chunk = (uint8_t *)H5D__chunk_mem_xfree(ent->chunk,
-                    ((ent->edge_chunk_state & H5D_RDCC_DISABLE_FILTERS) ? NULL
-                    : &(dset->shared->dcpl_cache.pline)));
+    /* Release any chunks that weren't added to the cache */
+    for(u = 0; u < nread; u++)
+        if(chunks[u].buf)
+            chunks[u].buf = H5D__chunk_pool_free(dset->shared, chunks[u].buf, chunks[u].buf_alloc, chunks[u].filtered ? pline : NULL);
+    order = (H5D_chunk_decode_t **)H5MM_xfree(order);
+    run_buf = H5MM_xfree(run_buf);
 
-    FUNC_LEAVE_NOAPI_TAG(ret_value)
-} /* end H5D__chunk_flush_entry() */
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5D__chunk_load_batch() */
 
 
 /*-------------------------------------------------------------------------
- * Function:    H5D__chunk_cache_evict
+ * Function:    H5D__chunk_decode_window
  *
- * Purpose:     Preempts the specified entry from the cache, flushing it to
- *              disk if necessary.
+ * Purpose:     Look ahead from *CHUNK_NODE through the chunks selected
+ *              for a read, and load up to MAX_CHUNKS of the filtered
+ *              chunks that aren't cached yet into the chunk cache with
+ *              H5D__chunk_load_batch(), so that the read loop finds them
+ *              already decoded in the cache.  When the dataset's chunk
+ *              cache coalesces reads, unfiltered chunks are loaded too.
  *
- * Return:      Non-negative on success/Negative on failure
+ *              *CHUNK_NODE is advanced past the chunks examined.  Chunks
+ *              that can't be handled here (not allocated, already cached,
+ *              unfiltered chunks when not coalescing reads, or chunks
+ *              that map to the same cache slot as an earlier chunk) are
+ *              left for the read loop.
  *
- * Programmer:  Robb Matzke
- *              Thursday, May 21, 1998
+ * Return:      Non-negative on success/Negative on failure
  *
  *-------------------------------------------------------------------------
  */
 static herr_t
-H5D__chunk_cache_evict(const H5D_t *dset, H5D_rdcc_ent_t *ent, hbool_t flush)
+H5D__chunk_decode_window(const H5D_io_info_t *io_info, const H5D_chunk_map_t *fm,
+    H5D_chunk_info_t * const **chunk_node, unsigned nthreads, H5D_chunk_decode_t *chunks,
+    size_t max_chunks)
 {
-    H5D_rdcc_t *rdcc = &(dset->shared->cache.chunk);
-    herr_t      ret_value = SUCCEED;       /* Return value */
+    const H5D_t         *dset = io_info->dset;  /* Local pointer to the dataset info */
+    const H5O_layout_t  *layout = &(dset->shared->layout); /* Dataset layout */
+    hbool_t             coalesce = (dset->shared->cache.chunk.coalesce_max > 0); /* Whether reads are coalesced */
+    H5D_chunk_info_t * const *node = *chunk_node; /* Current node in the list of selected chunks */
+    size_t              nchunks = 0;            /* Number of chunks to decode */
+    size_t              nscanned = 0;           /* Number of chunks examined */
+    size_t              u;                      /* Local index variable */
+    herr_t              ret_value = SUCCEED;    /* Return value */
 
     FUNC_ENTER_STATIC
 
     /* Sanity checks */
-    HDassert(dset);
-    HDassert(ent);
-    HDassert(!ent->locked);
-    HDassert(ent->idx < rdcc->nslots);
-
-    if(flush) {
-        /* Flush */
-        if(H5D__chunk_flush_entry(dset, ent, TRUE) < 0)
-            HDONE_ERROR(H5E_IO, H5E_WRITEERROR, FAIL, "cannot flush indexed storage buffer")
-    } /* end if */
-    else {
-        /* Don't flush, just free chunk */
-        if(ent->chunk != NULL)
-            ent->chunk = (uint8_t *)H5D__chunk_mem_xfree(ent->chunk,
-                    ((ent->edge_chunk_state & H5D_RDCC_DISABLE_FILTERS) ? NULL
-                    : &(dset->shared->dcpl_cache.pline)));
-    } /* end else */
-
-    /* Unlink from list */
-    if(ent->prev)
-        ent->prev->next = ent->next;
-    else
-        rdcc->head = ent->next;
-    if(ent->next)
-        ent->next->prev = ent->prev;
-    else
-        rdcc->tail = ent->prev;
-    ent->prev = ent->next = NULL;
+    HDassert(dset->shared->dcpl_cache.pline.nused > 0 || coalesce);
+    HDassert(dset->shared->cache.chunk.nslots > 0);
+    HDassert(chunks);
+    HDassert(max_chunks > 0);
+
+    /* Gather the chunks to decode */
+    while(node && nscanned < max_chunks) {
+        H5D_chunk_info_t *chunk_info = H5D_CHUNK_GET_NODE_INFO(fm, node);
+        H5D_chunk_decode_t *chk = &chunks[nchunks];
+
+        /* Get the info for the chunk in the file.  (The scaled coordinates
+         * include the datatype's dimension, which version 1 B-tree keys
+         * compare too.) */
+        H5MM_memcpy(chk->scaled, chunk_info->scaled, sizeof(hsize_t) * (dset->shared->ndims + 1));
+        if(H5D__chunk_lookup(dset, chk->scaled, &chk->udata) < 0)
+            HGOTO_ERROR(H5E_DATASET, H5E_CANTGET, FAIL, "error looking up chunk address")
+        nscanned++;
+
+        /* Check whether the chunk's filters are enabled */
+        chk->filtered = dset->shared->dcpl_cache.pline.nused > 0
+                && !((layout->u.chunk.flags & H5O_LAYOUT_CHUNK_DONT_FILTER_PARTIAL_BOUND_CHUNKS)
+                    && H5D__chunk_is_partial_edge_chunk(dset->shared->ndims, layout->u.chunk.dim,
+                        chk->scaled, dset->shared->curr_dims));
+
+        /* Only consider allocated chunks that aren't in the cache and that
+         * have their filters enabled, unless reads are coalesced */
+        if(UINT_MAX == chk->udata.idx_hint && H5F_addr_defined(chk->udata.chunk_block.offset)
+                && (chk->filtered || coalesce)) {
+            hbool_t collide = FALSE;    /* Whether the chunk collides with an earlier one */
+
+            /* Skip chunks that may not take their slot, or that would
+             * evict another chunk in this window */
+            chk->idx = H5D__chunk_hash_val(dset->shared, chk->scaled);
+            if(!H5D__chunk_cache_admit(dset, chk->idx, chk->scaled))
+                collide = TRUE;
+            for(u = 0; u < nchunks && !collide; u++)
+                if(chunks[u].idx == chk->idx) {
+                    collide = TRUE;
+                    break;
+                } /* end if */
 
-    /* Unlink from temporary list */
-    if(ent->tmp_prev) {
-        HDassert(rdcc->tmp_head->tmp_next);
-        ent->tmp_prev->tmp_next = ent->tmp_next;
-        if(ent->tmp_next) {
-            ent->tmp_next->tmp_prev = ent->tmp_prev;
-            ent->tmp_next = NULL;
+            if(!collide)
+                nchunks++;
         } /* end if */
-        ent->tmp_prev = NULL;
-    } /* end if */
-    else
-        /* Only clear hash table slot if the chunk was not on the temporary list
-         */
-        rdcc->slot[ent->idx] = NULL;
 
-    /* Remove from cache */
-    HDassert(rdcc->slot[ent->idx] != ent);
-    ent->idx = UINT_MAX;
-    rdcc->nbytes_used -= dset->shared->layout.u.chunk.size;
-    --rdcc->nused;
+        node = H5D_CHUNK_GET_NEXT_NODE(fm, node);
+    } /* end while */
+    *chunk_node = node;
 
-    /* Free */
-    ent = H5FL_FREE(H5D_rdcc_ent_t, ent);
+    /* Nothing to gain from decoding a single chunk here */
+    if(nchunks > 1)
+        if(H5D__chunk_load_batch(dset, chunks, nchunks, nthreads) < 0)
+            HGOTO_ERROR(H5E_DATASET, H5E_READERROR, FAIL, "unable to load raw data chunks")
 
+done:
     FUNC_LEAVE_NOAPI(ret_value)
-} /* end H5D__chunk_cache_evict() */
+} /* end H5D__chunk_decode_window() */
 
 
 /*-------------------------------------------------------------------------
- * Function:    H5D__chunk_cache_prune
+ * Function:    H5D__chunk_readahead
  *
- * Purpose:    Prune the cache by preempting some things until the cache has
- *        room for something which is SIZE bytes.  Only unlocked
- *        entries are considered for preemption.
+ * Purpose:     Track the cache misses of a dataset, and when the last few
+ *              misses walk through the chunks along the slowest or the
+ *              fastest changing dimension with a constant stride, load
+ *              the next chunks along that path into the chunk cache
+ *              ahead of time.  SCALED is the chunk that just missed.
  *
- * Return:    Non-negative on success/Negative on failure
+ *              Up to the number of chunks set with H5Pset_chunk_readahead
+ *              are loaded, limited by the size of the chunk cache.  The
+ *              filtered chunks among them are decoded with the number of
+ *              threads set with H5Pset_chunk_decode_nthreads.
  *
- * Programmer:    Robb Matzke
- *              Thursday, May 21, 1998
+ * Return:      Non-negative on success/Negative on failure
  *
  *-------------------------------------------------------------------------
  */
 static herr_t
-H5D__chunk_cache_prune(const H5D_t *dset, size_t size)
+H5D__chunk_readahead(const H5D_t *dset, const hsize_t *scaled)
 {
-    const H5D_rdcc_t    *rdcc = &(dset->shared->cache.chunk);
-    size_t        total = rdcc->nbytes_max;
-    const int        nmeth = 2;    /*number of methods        */
-    int                w[1];        /*weighting as an interval    */
-    H5D_rdcc_ent_t    *p[2], *cur;    /*list pointers            */
-    H5D_rdcc_ent_t    *n[2];        /*list next pointers        */
-    int        nerrors = 0;            /* Accumulated error count during preemptions */
-    herr_t      ret_value = SUCCEED;       /* Return value */
+    const H5O_pline_t   *pline = &(dset->shared->dcpl_cache.pline); /* I/O pipeline info */
+    const H5O_layout_t  *layout = &(dset->shared->layout); /* Dataset layout */
+    H5D_rdcc_t          *rdcc = &(dset->shared->cache.chunk); /* Raw data chunk cache */
+    H5D_chunk_decode_t  *chunks = NULL;         /* Chunks to load */
+    unsigned            ndims = dset->shared->ndims; /* Rank of the dataset */
+    unsigned            ndiff = 0;              /* # of dimensions that changed */
+    unsigned            dim = 0;                /* Dimension that changed */
+    hssize_t            stride = 0;             /* Distance from the last miss, in chunks */
+    hbool_t             streaming = FALSE;      /* Whether the access pattern is regular */
+    size_t              chunk_size;             /* Size of a chunk */
+    size_t              max_chunks;             /* Max. # of chunks to load */
+    size_t              nchunks = 0;            /* # of chunks to load */
+    unsigned            nthreads;               /* # of threads to decode with */
+    size_t              u, v;                   /* Local index variables */
+    herr_t              ret_value = SUCCEED;    /* Return value */
 
     FUNC_ENTER_STATIC
 
-    /*
-     * Preemption is accomplished by having multiple pointers (currently two)
-     * slide down the list beginning at the head. Pointer p(N+1) will start
-     * traversing the list when pointer pN reaches wN percent of the original
-     * list.  In other words, preemption method N gets to consider entries in
-     * approximate least recently used order w0 percent before method N+1
-     * where 100% means tha method N will run to completion before method N+1
-     * begins.  The pointers participating in the list traversal are each
-     * given a chance at preemption before any of the pointers are advanced.
-     */
-    w[0] = (int)(rdcc->nused * rdcc->w0);
-    p[0] = rdcc->head;
-    p[1] = NULL;
+    /* Sanity checks */
+    HDassert(scaled);
+    HDassert(rdcc->readahead > 0);
+    HDassert(rdcc->nslots > 0);
+
+    /* Compare the chunk with the last one missed */
+    if(rdcc->ra.valid) {
+        for(u = 0; u < ndims; u++)
+            if(scaled[u] != rdcc->ra.last[u]) {
+                ndiff++;
+                dim = (unsigned)u;
+            } /* end if */
 
-    while((p[0] || p[1]) && (rdcc->nbytes_used + size) > total) {
-        int i;          /* Local index variable */
+        /* Only follow paths along the slowest or fastest changing dimension */
+        if(1 == ndiff && (0 == dim || (ndims - 1) == dim)) {
+            stride = (hssize_t)scaled[dim] - (hssize_t)rdcc->ra.last[dim];
+            streaming = (dim == rdcc->ra.dim && stride == rdcc->ra.stride);
+        } /* end if */
+    } /* end if */
+    H5MM_memcpy(rdcc->ra.last, scaled, sizeof(hsize_t) * ndims);
+    rdcc->ra.dim = dim;
+    rdcc->ra.stride = stride;
+    rdcc->ra.valid = TRUE;
 
-    /* Introduce new pointers */
-    for(i = 0; i < nmeth - 1; i++)
-            if(0 == w[i])
-                p[i + 1] = rdcc->head;
+    /* Wait for the same stride to show up twice in a row */
+    if(!streaming)
+        HGOTO_DONE(SUCCEED)
 
-    /* Compute next value for each pointer */
-    for(i = 0; i < nmeth; i++)
-            n[i] = p[i] ? p[i]->next : NULL;
+    /* Don't read ahead more chunks than the cache can hold along with the
+     * chunk that was just missed */
+    H5_CHECKED_ASSIGN(chunk_size, size_t, layout->u.chunk.size, uint32_t);
+    max_chunks = rdcc->readahead;
+    max_chunks = MIN(max_chunks, (rdcc->nbytes_max / chunk_size) - 1);
+    max_chunks = MIN(max_chunks, rdcc->nslots - 1);
+    if(0 == max_chunks)
+        HGOTO_DONE(SUCCEED)
 
-    /* Give each method a chance */
-    for(i = 0; i < nmeth && (rdcc->nbytes_used + size) > total; i++) {
-        if(0 == i && p[0] && !p[0]->locked &&
-                    ((0 == p[0]->rd_count && 0 == p[0]->wr_count) ||
-                     (0 == p[0]->rd_count && dset->shared->layout.u.chunk.size == p[0]->wr_count) ||
-                     (dset->shared->layout.u.chunk.size == p[0]->rd_count && 0 == p[0]->wr_count))) {
-        /*
-        * Method 0: Preempt entries that have been completely written
-        * and/or completely read but not entries that are partially
-        * written or partially read.
-        */
-        cur = p[0];
-        } else if(1 == i && p[1] && !p[1]->locked) {
-        /*
-        * Method 1: Preempt the entry without regard to
-        * considerations other than being locked.  This is the last
-        * resort preemption.
-        */
-        cur = p[1];
-        } else {
-        /* Nothing to preempt at this point */
-        cur = NULL;
-        }
+    /* Check whether the filter pipeline can run on helper threads */
+    if(H5CX_get_chunk_decode_nthreads(&nthreads) < 0)
+        HGOTO_ERROR(H5E_DATASET, H5E_CANTGET, FAIL, "can't get number of chunk decode threads")
+    if(nthreads > 1 && pline->nused > 0) {
+        htri_t thread_safe;
 
-        if(cur) {
-                int j;          /* Local index variable */
+        if((thread_safe = H5D__chunk_pline_thread_safe(pline)) < 0)
+            HGOTO_ERROR(H5E_DATASET, H5E_CANTGET, FAIL, "can't check filter pipeline")
+        if(!thread_safe)
+            nthreads = 1;
+    } /* end if */
 
-        for(j = 0; j < nmeth; j++) {
-            if(p[j] == cur)
-                        p[j] = NULL;
-            if(n[j] == cur)
-                        n[j] = cur->next;
-        } /* end for */
-        if(H5D__chunk_cache_evict(dset, cur, TRUE) < 0)
-                    nerrors++;
-        } /* end if */
-    } /* end for */
+    if(NULL == (chunks = (H5D_chunk_decode_t *)H5MM_malloc(max_chunks * sizeof(H5D_chunk_decode_t))))
+        HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "memory allocation failed for chunk readahead info")
 
-    /* Advance pointers */
-    for(i = 0; i < nmeth; i++)
-            p[i] = n[i];
-    for(i = 0; i < nmeth - 1; i++)
-            w[i] -= 1;
-    } /* end while */
+    /* Gather the next chunks along the path */
+    for(u = 1; u <= max_chunks; u++) {
+        H5D_chunk_decode_t *chk = &chunks[nchunks];
+        hssize_t pos = (hssize_t)scaled[dim] + (hssize_t)u * stride;
+        hbool_t collide = FALSE;
 
-    if(nerrors)
-    HGOTO_ERROR(H5E_IO, H5E_CANTFLUSH, FAIL, "unable to preempt one or more raw data cache entry")
+        /* Stop at the edge of the dataset */
+        if(pos < 0 || (hsize_t)pos >= rdcc->scaled_dims[dim])
+            break;
+
+        /* Continue the path from the last chunk examined on the next miss */
+        rdcc->ra.last[dim] = (hsize_t)pos;
+
+        H5MM_memcpy(chk->scaled, scaled, sizeof(hsize_t) * (ndims + 1));
+        chk->scaled[dim] = (hsize_t)pos;
+        if(H5D__chunk_lookup(dset, chk->scaled, &chk->udata) < 0)
+            HGOTO_ERROR(H5E_DATASET, H5E_CANTGET, FAIL, "error looking up chunk address")
+
+        /* Skip chunks that are already cached or not allocated */
+        if(UINT_MAX != chk->udata.idx_hint || !H5F_addr_defined(chk->udata.chunk_block.offset))
+            continue;
+
+        /* Skip chunks that may not take their slot, or that would evict
+         * another chunk read ahead here */
+        chk->idx = H5D__chunk_hash_val(dset->shared, chk->scaled);
+        if(!H5D__chunk_cache_admit(dset, chk->idx, chk->scaled))
+            continue;
+        for(v = 0; v < nchunks; v++)
+            if(chunks[v].idx == chk->idx) {
+                collide = TRUE;
+                break;
+            } /* end if */
+        if(collide)
+            continue;
+
+        chk->filtered = pline->nused > 0
+                && !((layout->u.chunk.flags & H5O_LAYOUT_CHUNK_DONT_FILTER_PARTIAL_BOUND_CHUNKS)
+                    && H5D__chunk_is_partial_edge_chunk(ndims, layout->u.chunk.dim,
+                        chk->scaled, dset->shared->curr_dims));
+        nchunks++;
+    } /* end for */
+
+    if(nchunks > 0)
+        if(H5D__chunk_load_batch(dset, chunks, nchunks, nthreads) < 0)
+            HGOTO_ERROR(H5E_DATASET, H5E_READERROR, FAIL, "unable to read ahead raw data chunks")
 
 done:
+    if(chunks)
+        chunks = (H5D_chunk_decode_t *)H5MM_xfree(chunks);
+
     FUNC_LEAVE_NOAPI(ret_value)
-} /* end H5D__chunk_cache_prune() */
+} /* end H5D__chunk_readahead() */
 
 
 /*-------------------------------------------------------------------------
@@ -3807,10 +6158,10 @@ H5D__chunk_lock(const H5D_io_info_t *io_info, H5D_chunk_ud_t *udata,
 
                 /* Reallocate the chunk so H5D__chunk_mem_xfree doesn't get confused
                  */
-                if(NULL == (chunk = H5D__chunk_mem_alloc(chunk_size, pline)))
+                if(NULL == (chunk = H5D__chunk_pool_alloc(dset->shared, chunk_size, pline, NULL)))
                     HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, NULL, "memory allocation failed for raw data chunk")
                 H5MM_memcpy(chunk, ent->chunk, chunk_size);
-                ent->chunk = (uint8_t *)H5D__chunk_mem_xfree(ent->chunk, old_pline);
+                ent->chunk = (uint8_t *)H5D__chunk_pool_free(dset->shared, ent->chunk, chunk_size, old_pline);
                 ent->chunk = (uint8_t *)chunk;
                 chunk = NULL;
 
@@ -3833,11 +6184,11 @@ H5D__chunk_lock(const H5D_io_info_t *io_info, H5D_chunk_ud_t *udata,
 
                 /* Reallocate the chunk so H5D__chunk_mem_xfree doesn't get confused
                  */
-                if(NULL == (chunk = H5D__chunk_mem_alloc(chunk_size, pline)))
+                if(NULL == (chunk = H5D__chunk_pool_alloc(dset->shared, chunk_size, pline, NULL)))
                     HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, NULL, "memory allocation failed for raw data chunk")
                 H5MM_memcpy(chunk, ent->chunk, chunk_size);
 
-                ent->chunk = (uint8_t *)H5D__chunk_mem_xfree(ent->chunk, old_pline);
+                ent->chunk = (uint8_t *)H5D__chunk_pool_free(dset->shared, ent->chunk, chunk_size, old_pline);
                 ent->chunk = (uint8_t *)chunk;
                 chunk = NULL;
 
@@ -3847,12 +6198,42 @@ H5D__chunk_lock(const H5D_io_info_t *io_info, H5D_chunk_ud_t *udata,
             } /* end else */
         } /* end if */
 
+        /* Move the entry to the end of the file-wide LRU list */
+        if(rdcc->budget && ent->budget_next) {
+            ent->budget_next->budget_prev = ent->budget_prev;
+            if(ent->budget_prev)
+                ent->budget_prev->budget_next = ent->budget_next;
+            else
+                rdcc->budget->head = ent->budget_next;
+            ent->budget_prev = rdcc->budget->tail;
+            ent->budget_next = NULL;
+            rdcc->budget->tail->budget_next = ent;
+            rdcc->budget->tail = ent;
+        } /* end if */
+
+        /*
+         * With the 2Q policy, move hot entries to the end of the list and
+         * leave probationary entries in the order they were added.
+         */
+        if(H5D_CHUNK_CACHE_POLICY_2Q == rdcc->policy) {
+            if(ent->hot && ent->next) {
+                ent->next->prev = ent->prev;
+                if(ent->prev)
+                    ent->prev->next = ent->next;
+                else
+                    rdcc->head = ent->next;
+                ent->prev = rdcc->tail;
+                ent->next = NULL;
+                rdcc->tail->next = ent;
+                rdcc->tail = ent;
+            } /* end if */
+        } /* end if */
         /*
          * If the chunk is not at the beginning of the cache; move it backward
          * by one slot.  This is how we implement the LRU preemption
          * algorithm.
          */
-        if(ent->next) {
+        else if(ent->next) {
             if(ent->next->next)
                 ent->next->next->prev = ent;
             else
@@ -3917,7 +6298,7 @@ H5D__chunk_lock(const H5D_io_info_t *io_info, H5D_chunk_ud_t *udata,
              */
             rdcc->stats.nhits++;
 
-            if(NULL == (chunk = H5D__chunk_mem_alloc(chunk_size, pline)))
+            if(NULL == (chunk = H5D__chunk_pool_alloc(dset->shared, chunk_size, pline, NULL)))
                 HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, NULL, "memory allocation failed for raw data chunk")
 
             /* In the case that some dataset functions look through this data,
@@ -3937,14 +6318,17 @@ H5D__chunk_lock(const H5D_io_info_t *io_info, H5D_chunk_ud_t *udata,
 
                 /* Chunk size on disk isn't [likely] the same size as the final chunk
                  * size in memory, so allocate memory big enough. */
-                if(NULL == (chunk = H5D__chunk_mem_alloc(my_chunk_alloc, (udata->new_unfilt_chunk ? old_pline : pline))))
+                if(NULL == (chunk = H5D__chunk_pool_alloc(dset->shared, my_chunk_alloc, (udata->new_unfilt_chunk ? old_pline : pline), &buf_alloc)))
                     HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, NULL, "memory allocation failed for raw data chunk")
                 if(H5F_shared_block_read(H5F_SHARED(dset->oloc.file), H5FD_MEM_DRAW, chunk_addr, my_chunk_alloc, chunk) < 0)
                     HGOTO_ERROR(H5E_IO, H5E_READERROR, NULL, "unable to read raw data chunk")
+                rdcc->stats.nreads++;
 
                 if(old_pline && old_pline->nused) {
                     H5Z_EDC_t err_detect;       /* Error detection info */
                     H5Z_cb_t filter_cb;         /* I/O filter callback function */
+                    H5Z_mem_t mem;              /* Allocator for the filters' buffers */
+                    double start;               /* Time the filters were started */
 
                     /* Retrieve filter settings from API context */
                     if(H5CX_get_err_detect(&err_detect) < 0)
@@ -3952,20 +6336,28 @@ H5D__chunk_lock(const H5D_io_info_t *io_info, H5D_chunk_ud_t *udata,
                     if(H5CX_get_filter_cb(&filter_cb) < 0)
                         HGOTO_ERROR(H5E_DATASET, H5E_CANTGET, NULL, "can't get I/O filter callback function")
 
-                    if(H5Z_pipeline(old_pline, H5Z_FLAG_REVERSE, &(udata->filter_mask),
-                            err_detect, filter_cb, &my_chunk_alloc, &buf_alloc, &chunk) < 0)
+                    /* Recycle the filters' buffers through the dataset's pool */
+                    mem.alloc_func = H5D__chunk_pool_mem_alloc;
+                    mem.free_func = H5D__chunk_pool_mem_free;
+                    mem.info = dset->shared;
+
+                    start = H5_get_time();
+                    if(H5Z_pipeline_mem(old_pline, H5Z_FLAG_REVERSE, &(udata->filter_mask),
+                            err_detect, filter_cb, chunk_size, &mem, &my_chunk_alloc, &buf_alloc, &chunk) < 0)
                         HGOTO_ERROR(H5E_DATASET, H5E_CANTFILTER, NULL, "data pipeline read failed")
+                    rdcc->stats.filter_time += H5_get_time() - start;
+                    rdcc->stats.nbytes_decoded += my_chunk_alloc;
 
                     /* Reallocate chunk if necessary */
                     if(udata->new_unfilt_chunk) {
                         void *tmp_chunk = chunk;
 
                         if(NULL == (chunk = H5D__chunk_mem_alloc(my_chunk_alloc, pline))) {
-                            (void)H5D__chunk_mem_xfree(tmp_chunk, old_pline);
+                            (void)H5D__chunk_pool_free(dset->shared, tmp_chunk, buf_alloc, old_pline);
                             HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, NULL, "memory allocation failed for raw data chunk")
                         } /* end if */
                         H5MM_memcpy(chunk, tmp_chunk, chunk_size);
-                        (void)H5D__chunk_mem_xfree(tmp_chunk, old_pline);
+                        (void)H5D__chunk_pool_free(dset->shared, tmp_chunk, buf_alloc, old_pline);
                     } /* end if */
                 } /* end if */
 
@@ -3980,7 +6372,7 @@ H5D__chunk_lock(const H5D_io_info_t *io_info, H5D_chunk_ud_t *udata,
 
                 /* Chunk size on disk isn't [likely] the same size as the final chunk
                  * size in memory, so allocate memory big enough. */
-                if(NULL == (chunk = H5D__chunk_mem_alloc(chunk_size, pline)))
+                if(NULL == (chunk = H5D__chunk_pool_alloc(dset->shared, chunk_size, pline, NULL)))
                     HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, NULL, "memory allocation failed for raw data chunk")
 
                 if(H5P_is_fill_value_defined(fill, &fill_status) < 0)
@@ -4013,7 +6405,7 @@ H5D__chunk_lock(const H5D_io_info_t *io_info, H5D_chunk_ud_t *udata,
                     HDmemset(chunk, 0, chunk_size);
 
                 /* Increment # of creations */
-                rdcc->stats.ninits++;
+                rdcc->ninits++;
             } /* end else */
         } /* end else */
 
@@ -4022,52 +6414,18 @@ H5D__chunk_lock(const H5D_io_info_t *io_info, H5D_chunk_ud_t *udata,
             /* Calculate the index */
             udata->idx_hint = H5D__chunk_hash_val(io_info->dset->shared, udata->common.scaled);
 
-            /* Add the chunk to the cache only if the slot is not already locked */
-            ent = rdcc->slot[udata->idx_hint];
-            if(!ent || !ent->locked) {
-                /* Preempt enough things from the cache to make room */
-                if(ent) {
-                    if(H5D__chunk_cache_evict(io_info->dset, ent, TRUE) < 0)
-                        HGOTO_ERROR(H5E_IO, H5E_CANTINIT, NULL, "unable to preempt chunk from cache")
-                } /* end if */
-                if(H5D__chunk_cache_prune(io_info->dset, chunk_size) < 0)
-                    HGOTO_ERROR(H5E_IO, H5E_CANTINIT, NULL, "unable to preempt chunk(s) from cache")
-
-                /* Create a new entry */
-                if(NULL == (ent = H5FL_CALLOC(H5D_rdcc_ent_t)))
-                    HGOTO_ERROR(H5E_DATASET, H5E_CANTALLOC, NULL, "can't allocate raw data chunk entry")
+            /* Add the chunk to the cache only if the slot is not already
+             * locked (or, with the 2Q policy, held by a hot entry) */
+            if(H5D__chunk_cache_admit(io_info->dset, udata->idx_hint, udata->common.scaled)) {
+                unsigned edge_chunk_state;  /* Edge chunk state for the new entry */
 
-                ent->edge_chunk_state = disable_filters ? H5D_RDCC_DISABLE_FILTERS : 0;
+                edge_chunk_state = disable_filters ? H5D_RDCC_DISABLE_FILTERS : 0;
                 if(udata->new_unfilt_chunk)
-                    ent->edge_chunk_state |= H5D_RDCC_NEWLY_DISABLED_FILTERS;
-
-                /* Initialize the new entry */
-                ent->chunk_block.offset = chunk_addr;
-                ent->chunk_block.length = chunk_alloc;
-                ent->chunk_idx = udata->chunk_idx;
-                H5MM_memcpy(ent->scaled, udata->common.scaled, sizeof(hsize_t) * layout->u.chunk.ndims);
-                H5_CHECKED_ASSIGN(ent->rd_count, uint32_t, chunk_size, size_t);
-                H5_CHECKED_ASSIGN(ent->wr_count, uint32_t, chunk_size, size_t);
-                ent->chunk = (uint8_t *)chunk;
-
-                /* Add it to the cache */
-                HDassert(NULL == rdcc->slot[udata->idx_hint]);
-                rdcc->slot[udata->idx_hint] = ent;
-                ent->idx = udata->idx_hint;
-                rdcc->nbytes_used += chunk_size;
-                rdcc->nused++;
-
-                /* Add it to the linked list */
-                if(rdcc->tail) {
-                    rdcc->tail->next = ent;
-                    ent->prev = rdcc->tail;
-                    rdcc->tail = ent;
-                } /* end if */
-                else
-                    rdcc->head = rdcc->tail = ent;
-                ent->tmp_next = NULL;
-                ent->tmp_prev = NULL;
+                    edge_chunk_state |= H5D_RDCC_NEWLY_DISABLED_FILTERS;
 
+                /* Create a new entry for the chunk */
+                if(NULL == (ent = H5D__chunk_cache_insert(io_info->dset, udata, udata->idx_hint, edge_chunk_state, chunk)))
+                    HGOTO_ERROR(H5E_DATASET, H5E_CANTINSERT, NULL, "unable to add chunk to cache")
             } /* end if */
             else
                 /* We did not add the chunk to cache */
@@ -4185,7 +6543,9 @@ H5D__chunk_unlock(const H5D_io_info_t *io_info, const H5D_chunk_ud_t *udata,
         } /* end if */
         else {
             if(chunk)
-                chunk = H5D__chunk_mem_xfree(chunk, (is_unfiltered_edge_chunk ? NULL
+                chunk = H5D__chunk_pool_free(io_info->dset->shared, chunk,
+                        (size_t)io_info->dset->shared->layout.u.chunk.size,
+                        (is_unfiltered_edge_chunk ? NULL
             : &(io_info->dset->shared->dcpl_cache.pline)));
         } /* end else */
     } /* end if */
@@ -4470,7 +6830,7 @@ H5D__chunk_allocate(const H5D_io_info_t *io_info, hbool_t full_overwrite, hsize_
                 HGOTO_ERROR(H5E_DATASET, H5E_CANTGET, FAIL, "can't get I/O filter callback function")
 
             /* Push the chunk through the filters */
-            if(H5Z_pipeline(pline, 0, &filter_mask, err_detect, filter_cb, &orig_chunk_size, &buf_size, &fb_info.fill_buf) < 0)
+            if(H5Z_pipeline(pline, 0, &filter_mask, err_detect, filter_cb, (size_t)0, &orig_chunk_size, &buf_size, &fb_info.fill_buf) < 0)
                 HGOTO_ERROR(H5E_PLINE, H5E_WRITEERROR, FAIL, "output pipeline failed")
 #if H5_SIZEOF_SIZE_T > 4
             /* Check for the chunk expanding too much to encode in a 32-bit value */
@@ -4610,7 +6970,7 @@ H5D__chunk_allocate(const H5D_io_info_t *io_info, hbool_t full_overwrite, hsize_
                         HGOTO_ERROR(H5E_DATASET, H5E_CANTGET, FAIL, "can't get I/O filter callback function")
 
                     /* Push the chunk through the filters */
-                    if(H5Z_pipeline(pline, 0, &filter_mask, err_detect, filter_cb, &nbytes, &fb_info.fill_buf_size, &fb_info.fill_buf) < 0)
+                    if(H5Z_pipeline(pline, 0, &filter_mask, err_detect, filter_cb, (size_t)0, &nbytes, &fb_info.fill_buf_size, &fb_info.fill_buf) < 0)
                         HGOTO_ERROR(H5E_PLINE, H5E_WRITEERROR, FAIL, "output pipeline failed")
 
 #if H5_SIZEOF_SIZE_T > 4
@@ -5859,6 +8219,11 @@ H5D__chunk_update_cache(H5D_t *dset)
     /* Check the rank */
     HDassert((dset->shared->layout.u.chunk.ndims - 1) > 1);
 
+    /* Forget the chunks preempted from the 2Q probationary queue, their
+     * slots are changing */
+    if(rdcc->ghost)
+        HDmemset(rdcc->ghost, 0, rdcc->nslots * sizeof(H5D_rdcc_ghost_t));
+
     /* Add temporary entry list to rdcc */
     (void)HDmemset(&tmp_head, 0, sizeof(tmp_head));
     rdcc->tmp_head = &tmp_head;
@@ -5940,6 +8305,43 @@ done:
 } /* end H5D__chunk_update_cache() */
 
 
+/*-------------------------------------------------------------------------
+ * Function:    H5D__chunk_copy_resize
+ *
+ * Purpose:     Record that the filter pipeline has given back a chunk
+ *              buffer of BUF_SIZE bytes for H5D__chunk_copy_cb(), growing
+ *              the background buffer to match, since the datatype
+ *              conversions use as much of both.
+ *
+ * Return:      Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5D__chunk_copy_resize(H5D_chunk_it_ud3_t *udata, void *buf, size_t buf_size)
+{
+    herr_t ret_value = SUCCEED;         /* Return value */
+
+    FUNC_ENTER_STATIC
+
+    if(buf_size > udata->buf_size && udata->bkg) {
+        void *new_buf;                  /* New buffer for data */
+
+        if(NULL == (new_buf = H5MM_realloc(udata->bkg, buf_size)))
+            HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "memory allocation failed for raw data chunk")
+        udata->bkg = new_buf;
+        if(!udata->cpy_info->expand_ref)
+            HDmemset((uint8_t *)udata->bkg + udata->buf_size, 0, (size_t)(buf_size - udata->buf_size));
+    } /* end if */
+
+    udata->buf = buf;
+    udata->buf_size = buf_size;
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5D__chunk_copy_resize() */
+
+
 /*-------------------------------------------------------------------------
  * Function:    H5D__chunk_copy_cb
  *
@@ -6073,8 +8475,13 @@ H5D__chunk_copy_cb(const H5D_chunk_rec_t *chunk_rec, void *_udata)
     if(must_filter && (is_vlen || fix_ref) && !udata->chunk_in_cache) {
         unsigned filter_mask = chunk_rec->filter_mask;
 
-        if(H5Z_pipeline(pline, H5Z_FLAG_REVERSE, &filter_mask, H5Z_NO_EDC, filter_cb, &nbytes, &buf_size, &buf) < 0)
+        /* (The buffer must keep its room for converting the elements, which
+         *  can be more than the size of the decoded chunk) */
+        if(H5Z_pipeline(pline, H5Z_FLAG_REVERSE, &filter_mask, H5Z_NO_EDC, filter_cb, MAX(buf_size, (size_t)udata->common.layout->size), &nbytes, &buf_size, &buf) < 0)
             HGOTO_ERROR(H5E_PLINE, H5E_CANTFILTER, H5_ITER_ERROR, "data pipeline read failed")
+        if(H5D__chunk_copy_resize(udata, buf, buf_size) < 0)
+            HGOTO_ERROR(H5E_DATASET, H5E_CANTALLOC, H5_ITER_ERROR, "unable to resize chunk copy buffers")
+        bkg = udata->bkg;
     } /* end if */
 
     /* Perform datatype conversion, if necessary */
@@ -6130,7 +8537,7 @@ H5D__chunk_copy_cb(const H5D_chunk_rec_t *chunk_rec, void *_udata)
 
     /* Need to compress variable-length or reference data elements or a chunk found in cache before writing to file */
     if(must_filter && (is_vlen || fix_ref || udata->chunk_in_cache) ) {
-        if(H5Z_pipeline(pline, 0, &(udata_dst.filter_mask), H5Z_NO_EDC, filter_cb, &nbytes, &buf_size, &buf) < 0)
+        if(H5Z_pipeline(pline, 0, &(udata_dst.filter_mask), H5Z_NO_EDC, filter_cb, (size_t)0, &nbytes, &buf_size, &buf) < 0)
             HGOTO_ERROR(H5E_PLINE, H5E_CANTFILTER, H5_ITER_ERROR, "output pipeline failed")
 #if H5_SIZEOF_SIZE_T > 4
         /* Check for the chunk expanding too much to encode in a 32-bit value */
@@ -6138,8 +8545,8 @@ H5D__chunk_copy_cb(const H5D_chunk_rec_t *chunk_rec, void *_udata)
             HGOTO_ERROR(H5E_DATASET, H5E_BADRANGE, H5_ITER_ERROR, "chunk too large for 32-bit length")
 #endif /* H5_SIZEOF_SIZE_T > 4 */
         H5_CHECKED_ASSIGN(udata_dst.chunk_block.length, uint32_t, nbytes, size_t);
-        udata->buf = buf;
-        udata->buf_size = buf_size;
+        if(H5D__chunk_copy_resize(udata, buf, buf_size) < 0)
+            HGOTO_ERROR(H5E_DATASET, H5E_CANTALLOC, H5_ITER_ERROR, "unable to resize chunk copy buffers")
     } /* end if */
 
     udata->chunk_in_cache = FALSE;
@@ -6680,8 +9087,8 @@ H5D__chunk_stats(const H5D_t *dset, hbool_t headers)
 
     if (headers) {
         if (rdcc->stats.nhits>0 || rdcc->stats.nmisses>0) {
-            miss_rate = 100.0 * rdcc->stats.nmisses /
-                    (rdcc->stats.nhits + rdcc->stats.nmisses);
+            miss_rate = 100.0 * (double)rdcc->stats.nmisses /
+                    (double)(rdcc->stats.nhits + rdcc->stats.nmisses);
         } else {
             miss_rate = 0.0;
         }
@@ -6691,9 +9098,9 @@ H5D__chunk_stats(const H5D_t *dset, hbool_t headers)
             HDsprintf(ascii, "%7.2f%%", miss_rate);
         }
 
-        HDfprintf(H5DEBUG(AC), "   %-18s %8u %8u %7s %8d+%-9ld\n",
+        HDfprintf(H5DEBUG(AC), "   %-18s %8Hu %8Hu %7s %8u+%-9ld\n",
             "raw data chunks", rdcc->stats.nhits, rdcc->stats.nmisses, ascii,
-            rdcc->stats.ninits, (long)(rdcc->stats.nflushes)-(long)(rdcc->stats.ninits));
+            rdcc->ninits, (long)(rdcc->stats.nflushes)-(long)(rdcc->ninits));
     }
 
 done:
@@ -7036,7 +9443,7 @@ H5D__chunk_format_convert_cb(const H5D_chunk_rec_t *chunk_rec, void *_udata)
             HGOTO_ERROR(H5E_IO, H5E_READERROR, H5_ITER_ERROR, "unable to read raw data chunk")
 
         /* Pass the chunk through the pipeline */
-        if (H5Z_pipeline(new_idx_info->pline, 0, &filter_mask, H5Z_NO_EDC, filter_cb, &nbytes, &read_size, &buf) < 0)
+        if (H5Z_pipeline(new_idx_info->pline, 0, &filter_mask, H5Z_NO_EDC, filter_cb, (size_t)0, &nbytes, &read_size, &buf) < 0)
             HGOTO_ERROR(H5E_PLINE, H5E_CANTFILTER, H5_ITER_ERROR, "output pipeline failed")
 
 #if H5_SIZEOF_SIZE_T > 4
@@ -1239,7 +1239,8 @@ H5D__earray_idx_iterate_cb(hsize_t H5_ATTR_UNUSED idx, const void *_elmt, void *
 {
     H5D_earray_it_ud_t   *udata = (H5D_earray_it_ud_t *)_udata; /* User data */
     unsigned ndims;                 /* Rank of chunk */
-    int curr_dim;                   /* Current dimension */
+    unsigned unlim_dim;             /* Unlimited dimension */
+    int curr_dim;                   /* Current dimension, in swizzled order */
     int ret_value = H5_ITER_CONT;   /* Return value */
 
     FUNC_ENTER_STATIC_NOERR
@@ -1260,18 +1261,30 @@ H5D__earray_idx_iterate_cb(hsize_t H5_ATTR_UNUSED idx, const void *_elmt, void *
 	if((ret_value = (udata->cb)(&udata->chunk_rec, udata->udata)) < 0)
 	    HERROR(H5E_DATASET, H5E_CALLBACK, "failure in generic chunk iterator callback");
 
-    /* Update coordinates of chunk in dataset */
+    /* Update coordinates of chunk in dataset.  The array is indexed with
+     * the unlimited dimension swizzled to the slowest changing position. */
     ndims = udata->common.layout->ndims - 1;
     HDassert(ndims > 0);
+    unlim_dim = udata->common.layout->u.earray.unlim_dim;
     curr_dim = (int)(ndims - 1);
     while(curr_dim >= 0) {
+        unsigned dim;               /* Dimension for the swizzled position */
+
+        /* Map the swizzled position to the dataset's dimension */
+        if(curr_dim == 0)
+            dim = unlim_dim;
+        else if((unsigned)curr_dim <= unlim_dim)
+            dim = (unsigned)curr_dim - 1;
+        else
+            dim = (unsigned)curr_dim;
+
         /* Increment coordinate in current dimension */
-        udata->chunk_rec.scaled[curr_dim]++;
+        udata->chunk_rec.scaled[dim]++;
 
         /* Check if we went off the end of the current dimension */
-        if(udata->chunk_rec.scaled[curr_dim] >= udata->common.layout->max_chunks[curr_dim]) {
+        if(udata->chunk_rec.scaled[dim] >= udata->common.layout->max_chunks[dim]) {
             /* Reset coordinate & move to next faster dimension */
-            udata->chunk_rec.scaled[curr_dim] = 0;
+            udata->chunk_rec.scaled[dim] = 0;
             curr_dim--;
         } /* end if */
         else
@@ -225,6 +225,10 @@ H5D__init_package(void)
         HGOTO_ERROR(H5E_PLIST, H5E_CANTGET, FAIL, "can't retrieve fill value")
     if(H5P_get(def_dcpl, H5O_CRT_PIPELINE_NAME, &H5D_def_dset.dcpl_cache.pline) < 0)
         HGOTO_ERROR(H5E_PLIST, H5E_CANTGET, FAIL, "can't retrieve pipeline filter")
+    if(H5P_get(def_dcpl, H5D_CRT_CHUNK_FILTER_MODE_NAME, &H5D_def_dset.dcpl_cache.chunk_filter_mode) < 0)
+        HGOTO_ERROR(H5E_PLIST, H5E_CANTGET, FAIL, "can't retrieve chunk filter mode")
+    if(H5P_get(def_dcpl, H5D_CRT_CHUNK_FILTER_MIN_GAIN_NAME, &H5D_def_dset.dcpl_cache.chunk_filter_min_gain) < 0)
+        HGOTO_ERROR(H5E_PLIST, H5E_CANTGET, FAIL, "can't retrieve minimum chunk filter gain")
 
     /* Mark "top" of interface as initialized, too */
     H5D_top_package_initialize_s = TRUE;
@@ -1325,11 +1329,19 @@ H5D__create(H5F_t *file, hid_t type_id, const H5S_t *space, hid_t dcpl_id,
         if(H5P_get(dc_plist, H5D_CRT_EXT_FILE_LIST_NAME, efl) < 0)
             HGOTO_ERROR(H5E_DATASET, H5E_CANTGET, NULL, "can't retrieve external file list")
         efl_copied = TRUE;
+        if(H5P_get(dc_plist, H5D_CRT_CHUNK_FILTER_MODE_NAME, &new_dset->shared->dcpl_cache.chunk_filter_mode) < 0)
+            HGOTO_ERROR(H5E_DATASET, H5E_CANTGET, NULL, "can't retrieve chunk filter mode")
+        if(H5P_get(dc_plist, H5D_CRT_CHUNK_FILTER_MIN_GAIN_NAME, &new_dset->shared->dcpl_cache.chunk_filter_min_gain) < 0)
+            HGOTO_ERROR(H5E_DATASET, H5E_CANTGET, NULL, "can't retrieve minimum chunk filter gain")
 
         /* Check that chunked layout is used if filters are enabled */
         if(pline->nused > 0 && H5D_CHUNKED != layout->type)
             HGOTO_ERROR(H5E_DATASET, H5E_BADVALUE, NULL, "filters can only be used with chunked layout")
 
+        /* Check that chunked layout is used if a chunk filter mode is set */
+        if(new_dset->shared->dcpl_cache.chunk_filter_mode && H5D_CHUNKED != layout->type)
+            HGOTO_ERROR(H5E_DATASET, H5E_BADVALUE, NULL, "chunk filter mode can only be used with chunked layout")
+
         /* Check if the alloc_time is the default and error out */
         if(fill->alloc_time == H5D_ALLOC_TIME_DEFAULT)
             HGOTO_ERROR(H5E_DATASET, H5E_BADVALUE, NULL, "invalid space allocation state")
@@ -1935,12 +1947,11 @@ H5D_close(H5D_t *dataset)
                 break;
 
             case H5D_CHUNKED:
-                /* Check for skip list for iterating over chunks during I/O to close */
-                if(dataset->shared->cache.chunk.sel_chunks) {
-                    HDassert(H5SL_count(dataset->shared->cache.chunk.sel_chunks) == 0);
-                    H5SL_close(dataset->shared->cache.chunk.sel_chunks);
-                    dataset->shared->cache.chunk.sel_chunks = NULL;
-                } /* end if */
+                /* Free the array for iterating over chunks during I/O */
+                HDassert(dataset->shared->cache.chunk.sel_chunks.nchunks == 0);
+                dataset->shared->cache.chunk.sel_chunks.chunk = (H5D_chunk_info_t **)H5MM_xfree(dataset->shared->cache.chunk.sel_chunks.chunk);
+                dataset->shared->cache.chunk.sel_chunks.hash = (size_t *)H5MM_xfree(dataset->shared->cache.chunk.sel_chunks.hash);
+                HDmemset(&dataset->shared->cache.chunk.sel_chunks, 0, sizeof(H5D_chunk_sel_t));
 
                 /* Check for cached single chunk dataspace */
                 if(dataset->shared->cache.chunk.single_space) {
@@ -2125,12 +2136,11 @@ H5D_mult_refresh_close(hid_t dset_id)
                 break;
 
             case H5D_CHUNKED:
-                /* Check for skip list for iterating over chunks during I/O to close */
-                if(dataset->shared->cache.chunk.sel_chunks) {
-                    HDassert(H5SL_count(dataset->shared->cache.chunk.sel_chunks) == 0);
-                    H5SL_close(dataset->shared->cache.chunk.sel_chunks);
-                    dataset->shared->cache.chunk.sel_chunks = NULL;
-                } /* end if */
+                /* Free the array for iterating over chunks during I/O */
+                HDassert(dataset->shared->cache.chunk.sel_chunks.nchunks == 0);
+                dataset->shared->cache.chunk.sel_chunks.chunk = (H5D_chunk_info_t **)H5MM_xfree(dataset->shared->cache.chunk.sel_chunks.chunk);
+                dataset->shared->cache.chunk.sel_chunks.hash = (size_t *)H5MM_xfree(dataset->shared->cache.chunk.sel_chunks.hash);
+                HDmemset(&dataset->shared->cache.chunk.sel_chunks, 0, sizeof(H5D_chunk_sel_t));
 
                 /* Check for cached single chunk dataspace */
                 if(dataset->shared->cache.chunk.single_space) {
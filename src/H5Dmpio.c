@@ -652,7 +652,7 @@ H5D__mpio_get_sum_chunk(const H5D_io_info_t *io_info, const H5D_chunk_map_t *fm,
 
     /* Get the number of chunks to perform I/O on */
     num_chunkf = 0;
-    ori_num_chunkf = H5SL_count(fm->sel_chunks);
+    ori_num_chunkf = fm->sel_chunks->nchunks;
     H5_CHECKED_ASSIGN(num_chunkf, int, ori_num_chunkf, size_t);
 
     /* Determine the summation of number of chunks for all processes */
@@ -1027,14 +1027,11 @@ H5D__link_chunk_collective_io(H5D_io_info_t *io_info, const H5D_type_info_t *typ
      *  equivalent of compressed contiguous datasets - QAK]
      */
     if(total_chunks == 1) {
-        H5SL_node_t *chunk_node;        /* Pointer to chunk node for selection */
         H5S_t *fspace;                  /* Dataspace describing chunk & selection in it */
         H5S_t *mspace;                  /* Dataspace describing selection in memory corresponding to this chunk */
 
         /* Check for this process having selection in this chunk */
-        chunk_node = H5SL_first(fm->sel_chunks);
-
-        if(chunk_node == NULL) {
+        if(fm->sel_chunks->nchunks == 0) {
             /* Set the dataspace info for I/O to NULL, this process doesn't have any I/O to perform */
             fspace = mspace = NULL;
 
@@ -1043,11 +1040,11 @@ H5D__link_chunk_collective_io(H5D_io_info_t *io_info, const H5D_type_info_t *typ
         } /* end if */
         else {
             H5D_chunk_ud_t udata;           /* User data for querying chunk info */
-            H5D_chunk_info_t *chunk_info;   /* Info for chunk in skiplist */
+            H5D_chunk_info_t *chunk_info;   /* Info for selected chunk */
 
             /* Get the chunk info, for the selection in the chunk */
-            if(NULL == (chunk_info = (H5D_chunk_info_t *)H5SL_item(chunk_node)))
-                HGOTO_ERROR(H5E_STORAGE, H5E_CANTGET, FAIL, "couldn't get chunk info from skip list")
+            if(NULL == (chunk_info = fm->sel_chunks->chunk[0]))
+                HGOTO_ERROR(H5E_STORAGE, H5E_CANTGET, FAIL, "couldn't get chunk info from list of selected chunks")
 
             /* Set the dataspace info for I/O */
             fspace = chunk_info->fspace;
@@ -1077,7 +1074,7 @@ if(H5DEBUG(D))
         size_t u;               /* Local index variable */
 
         /* Get the number of chunks with a selection */
-        num_chunk = H5SL_count(fm->sel_chunks);
+        num_chunk = fm->sel_chunks->nchunks;
         H5_CHECK_OVERFLOW(num_chunk, size_t, int);
 
 #ifdef H5D_DEBUG
@@ -2258,7 +2255,6 @@ static herr_t
 H5D__sort_chunk(H5D_io_info_t *io_info, const H5D_chunk_map_t *fm,
     H5D_chunk_addr_info_t chunk_addr_info_array[], int sum_chunk)
 {
-    H5SL_node_t    *chunk_node;         /* Current node in chunk skip list */
     H5D_chunk_info_t *chunk_info;         /* Current chunking info. of this node. */
     haddr_t         chunk_addr;         /* Current chunking address of this node */
     haddr_t        *total_chunk_addr_array = NULL; /* The array of chunk address for the total number of chunk */
@@ -2320,15 +2316,14 @@ if(H5DEBUG(D))
             HMPI_GOTO_ERROR(FAIL, "MPI_BCast failed", mpi_code)
     } /* end if */
 
-    /* Start at first node in chunk skip list */
-    i = 0;
-    if(NULL == (chunk_node = H5SL_first(fm->sel_chunks)))
-        HGOTO_ERROR(H5E_STORAGE, H5E_CANTGET, FAIL,"couldn't get chunk node from skipped list")
+    /* Start at first selected chunk */
+    if(fm->sel_chunks->nchunks == 0)
+        HGOTO_ERROR(H5E_STORAGE, H5E_CANTGET, FAIL,"couldn't get chunk node from list of selected chunks")
 
     /* Iterate over all chunks for this process */
-    while(chunk_node) {
-        if(NULL == (chunk_info = (H5D_chunk_info_t *)H5SL_item(chunk_node)))
-            HGOTO_ERROR(H5E_STORAGE, H5E_CANTGET, FAIL,"couldn't get chunk info from skipped list")
+    for(i = 0; i < (int)fm->sel_chunks->nchunks; i++) {
+        if(NULL == (chunk_info = fm->sel_chunks->chunk[i]))
+            HGOTO_ERROR(H5E_STORAGE, H5E_CANTGET, FAIL,"couldn't get chunk info from list of selected chunks")
 
         if(many_chunk_opt == H5D_OBTAIN_ONE_CHUNK_ADDR_IND) {
             H5D_chunk_ud_t udata;   /* User data for querying chunk info */
@@ -2348,18 +2343,14 @@ if(H5DEBUG(D))
         /* Set the address & info for this chunk */
         chunk_addr_info_array[i].chunk_addr = chunk_addr;
         chunk_addr_info_array[i].chunk_info = *chunk_info;
-
-        /* Advance to next chunk in list */
-        i++;
-        chunk_node = H5SL_next(chunk_node);
-    } /* end while */
+    } /* end for */
 
 #ifdef H5D_DEBUG
 if(H5DEBUG(D))
     HDfprintf(H5DEBUG(D), "before Qsort\n");
 #endif
     if(do_sort) {
-        size_t num_chunks = H5SL_count(fm->sel_chunks);
+        size_t num_chunks = fm->sel_chunks->nchunks;
 
         HDqsort(chunk_addr_info_array, num_chunks, sizeof(chunk_addr_info_array[0]), H5D__cmp_chunk_addr);
     } /* end if */
@@ -2418,7 +2409,7 @@ H5D__obtain_mpio_mode(H5D_io_info_t* io_info, H5D_chunk_map_t *fm,
     uint8_t*          recv_io_mode_info = NULL;
     uint8_t*          mergebuf = NULL;
     uint8_t*          tempbuf;
-    H5SL_node_t*      chunk_node;
+    size_t            n;
     H5D_chunk_info_t* chunk_info;
     int               mpi_size, mpi_rank;
     MPI_Comm          comm;
@@ -2466,13 +2457,11 @@ H5D__obtain_mpio_mode(H5D_io_info_t* io_info, H5D_chunk_map_t *fm,
             HGOTO_ERROR(H5E_DATASET, H5E_CANTALLOC, FAIL, "couldn't allocate recv I/O mode info buffer")
 
     /* Obtain the regularity and selection information for all chunks in this process. */
-    chunk_node        = H5SL_first(fm->sel_chunks);
-    while(chunk_node) {
-        chunk_info    = (H5D_chunk_info_t *)H5SL_item(chunk_node);
+    for(n = 0; n < fm->sel_chunks->nchunks; n++) {
+        chunk_info    = fm->sel_chunks->chunk[n];
 
         io_mode_info[chunk_info->index] = H5D_CHUNK_SELECT_REG; /* this chunk is selected and is "regular" */
-        chunk_node = H5SL_next(chunk_node);
-    } /* end while */
+    } /* end for */
 
     /* Gather all the information */
     H5_CHECK_OVERFLOW(total_chunks, size_t, int)
@@ -2604,19 +2593,17 @@ H5D__construct_filtered_io_info_list(const H5D_io_info_t *io_info, const H5D_typ
         HGOTO_ERROR(H5E_IO, H5E_MPI, FAIL, "unable to obtain mpi rank")
 
     /* Each process builds a local list of the chunks they have selected */
-    if ((num_chunks_selected = H5SL_count(fm->sel_chunks))) {
+    if ((num_chunks_selected = fm->sel_chunks->nchunks)) {
         H5D_chunk_info_t *chunk_info;
         H5D_chunk_ud_t    udata;
-        H5SL_node_t      *chunk_node;
         hsize_t           select_npoints;
         hssize_t          chunk_npoints;
 
         if(NULL == (local_info_array = (H5D_filtered_collective_io_info_t *) H5MM_malloc(num_chunks_selected * sizeof(H5D_filtered_collective_io_info_t))))
             HGOTO_ERROR(H5E_DATASET, H5E_CANTALLOC, FAIL, "couldn't allocate local io info array buffer")
 
-        chunk_node = H5SL_first(fm->sel_chunks);
-        for(i = 0; chunk_node; i++) {
-            chunk_info = (H5D_chunk_info_t *) H5SL_item(chunk_node);
+        for(i = 0; i < num_chunks_selected; i++) {
+            chunk_info = fm->sel_chunks->chunk[i];
 
             /* Obtain this chunk's address */
             if(H5D__chunk_lookup(io_info->dset, chunk_info->scaled, &udata) < 0)
@@ -2649,8 +2636,6 @@ H5D__construct_filtered_io_info_list(const H5D_io_info_t *io_info, const H5D_typ
                 HGOTO_ERROR(H5E_DATASET, H5E_CANTCOUNT, FAIL, "dataspace is invalid")
             local_info_array[i].full_overwrite =
                     (local_info_array[i].io_size >= (hsize_t) chunk_npoints * type_info->dst_type_size) ? TRUE : FALSE;
-
-            chunk_node = H5SL_next(chunk_node);
         } /* end for */
     } /* end if */
 
@@ -2846,8 +2831,8 @@ H5D__chunk_redistribute_shared_chunks(const H5D_io_info_t *io_info, const H5D_ty
             size_t            mod_data_size;
 
             /* Look up the chunk and get its file and memory dataspaces */
-            if(NULL == (chunk_info = (H5D_chunk_info_t *) H5SL_search(fm->sel_chunks, &chunk_entry->index)))
-                HGOTO_ERROR(H5E_DATASPACE, H5E_NOTFOUND, FAIL, "can't locate chunk in skip list")
+            if(NULL == (chunk_info = H5D__chunk_sel_find(fm->sel_chunks, chunk_entry->index)))
+                HGOTO_ERROR(H5E_DATASPACE, H5E_NOTFOUND, FAIL, "can't locate chunk in list of selected chunks")
 
             /* Determine size of serialized chunk file dataspace, plus the size of
              * the data being written
@@ -3117,8 +3102,8 @@ H5D__filtered_collective_chunk_entry_io(H5D_filtered_collective_io_info_t *chunk
         HGOTO_ERROR(H5E_DATASET, H5E_CANTGET, FAIL, "can't get I/O filter callback function")
 
     /* Look up the chunk and get its file and memory dataspaces */
-    if (NULL == (chunk_info = (H5D_chunk_info_t *) H5SL_search(fm->sel_chunks, &chunk_entry->index)))
-        HGOTO_ERROR(H5E_DATASPACE, H5E_NOTFOUND, FAIL, "can't locate chunk in skip list")
+    if (NULL == (chunk_info = H5D__chunk_sel_find(fm->sel_chunks, chunk_entry->index)))
+        HGOTO_ERROR(H5E_DATASPACE, H5E_NOTFOUND, FAIL, "can't locate chunk in list of selected chunks")
 
     if ((extent_npoints = H5S_GET_EXTENT_NPOINTS(chunk_info->fspace)) < 0)
         HGOTO_ERROR(H5E_DATASET, H5E_CANTCOUNT, FAIL, "dataspace is invalid")
@@ -3163,7 +3148,7 @@ H5D__filtered_collective_chunk_entry_io(H5D_filtered_collective_io_info_t *chunk
             HGOTO_ERROR(H5E_DATASET, H5E_CANTSET, FAIL, "can't set MPI-I/O transfer mode")
 
         if(H5Z_pipeline(&io_info->dset->shared->dcpl_cache.pline, H5Z_FLAG_REVERSE,
-                &filter_mask, err_detect, filter_cb, (size_t *)&chunk_entry->chunk_states.new_chunk.length,
+                &filter_mask, err_detect, filter_cb, (size_t)true_chunk_size, (size_t *)&chunk_entry->chunk_states.new_chunk.length,
                 &buf_size, &chunk_entry->buf) < 0)
             HGOTO_ERROR(H5E_DATASET, H5E_CANTFILTER, FAIL, "couldn't unfilter chunk for modifying")
     } /* end if */
@@ -3278,7 +3263,7 @@ H5D__filtered_collective_chunk_entry_io(H5D_filtered_collective_io_info_t *chunk
 
             /* Filter the chunk */
             if(H5Z_pipeline(&io_info->dset->shared->dcpl_cache.pline, 0, &filter_mask,
-                    err_detect, filter_cb, (size_t *)&chunk_entry->chunk_states.new_chunk.length,
+                    err_detect, filter_cb, (size_t)0, (size_t *)&chunk_entry->chunk_states.new_chunk.length,
                     &buf_size, &chunk_entry->buf) < 0)
                 HGOTO_ERROR(H5E_PLINE, H5E_CANTFILTER, FAIL, "output pipeline failed")
 
@@ -62,6 +62,15 @@
 #define H5D_MARK_SPACE  0x01
 #define H5D_MARK_LAYOUT  0x02
 
+/* Max. # of free buffers kept for reuse by a dataset's chunk cache */
+#define H5D_CHUNK_POOL_NBUFS    16
+
+/* Max. # of bytes in those free buffers, in chunks */
+#define H5D_CHUNK_POOL_NCHUNKS  4
+
+/* Alignment of the buffers allocated for them */
+#define H5D_CHUNK_POOL_ALIGN    64
+
 /* Default creation parameters for chunk index data structures */
 /* See H5O_layout_chunk_t */
 
@@ -341,6 +350,17 @@ typedef struct H5D_chunk_info_t {
     hbool_t mspace_shared;      /* Indicate that the memory space for a chunk is shared and shouldn't be freed */
 } H5D_chunk_info_t;
 
+/* The chunks selected for an I/O operation */
+typedef struct H5D_chunk_sel_t {
+    size_t nchunks;             /* Number of chunks selected */
+    size_t nalloc;              /* Number of entries allocated in 'chunk' */
+    H5D_chunk_info_t **chunk;   /* Information for each chunk selected, in order of chunk index once the selection is built */
+    hbool_t sorted;             /* Whether 'chunk' is in order of chunk index */
+    hbool_t use_hash;           /* Whether 'hash' indexes the chunks in 'chunk' */
+    unsigned hash_bits;         /* Log2 of the number of slots in 'hash' (0 if not allocated) */
+    size_t *hash;               /* Open-addressed hash table from chunk index to position in 'chunk' (plus one, 0 for an empty slot) */
+} H5D_chunk_sel_t;
+
 /* Main structure holding the mapping between file chunks and memory */
 typedef struct H5D_chunk_map_t {
     H5O_layout_t *layout;       /* Dataset layout information*/
@@ -356,7 +376,7 @@ typedef struct H5D_chunk_map_t {
     H5S_sel_type msel_type;     /* Selection type in memory */
     H5S_sel_type fsel_type;     /* Selection type in file */
 
-    H5SL_t *sel_chunks;         /* Skip list containing information for each chunk selected */
+    H5D_chunk_sel_t *sel_chunks; /* Information for each chunk selected */
 
     H5S_t  *single_space;       /* Dataspace for single chunk */
     H5D_chunk_info_t *single_chunk_info;  /* Pointer to single chunk's info */
@@ -392,18 +412,52 @@ typedef struct H5D_virtual_held_file_t {
     struct H5D_virtual_held_file_t *next;       /* Pointer to next node in list */
 } H5D_virtual_held_file_t;
 
+/* A chunk recently preempted from the probationary queue of the 2Q chunk
+ * cache policy */
+typedef struct H5D_rdcc_ghost_t {
+    hsize_t     key;           /* Key of the chunk (0 if none)     */
+    hsize_t     seq;           /* Preemption # of the chunk        */
+} H5D_rdcc_ghost_t;
+
+/* Location of a chunk in the file, in the chunk address table */
+typedef struct H5D_chunk_addr_t {
+    haddr_t     addr;          /* Address of the chunk (HADDR_UNDEF if not allocated) */
+    uint32_t    nbytes;        /* Size of the chunk in the file    */
+    uint32_t    filter_mask;   /* Excluded filters                 */
+} H5D_chunk_addr_t;
+
 /* The raw data chunk cache */
 struct H5D_rdcc_ent_t;  /* Forward declaration of struct used below */
 typedef struct H5D_rdcc_t {
-    struct {
-        unsigned    ninits;    /* Number of chunk creations        */
-        unsigned    nhits;     /* Number of cache hits            */
-        unsigned    nmisses;   /* Number of cache misses        */
-        unsigned    nflushes;  /* Number of cache flushes        */
-    } stats;
+    H5D_chunk_cache_stats_t stats; /* Cache statistics          */
+    unsigned      ninits;      /* Number of chunk creations        */
     size_t        nbytes_max;  /* Maximum cached raw data in bytes    */
     size_t        nslots;      /* Number of chunk slots allocated    */
     double        w0;          /* Chunk preemption policy          */
+    unsigned      encode_nthreads; /* Threads for filtering chunks when flushing them */
+    H5D_chunk_cache_policy_t policy; /* Chunk replacement policy      */
+    int           nhot;        /* # of entries in the 2Q hot queue  */
+    struct H5D_rdcc_ghost_t *ghost; /* 2Q: last chunk preempted from the probationary queue, per slot */
+    hsize_t       ghost_seq;   /* 2Q: # of chunks preempted from the probationary queue */
+    unsigned      readahead;   /* # of chunks to read ahead of sequential access */
+    H5F_rdcc_budget_t *budget; /* Chunk cache memory shared across the file's datasets, or NULL */
+    hbool_t       use_addr_table; /* Whether to look up chunks in 'addr_table' */
+    H5D_chunk_addr_t *addr_table; /* Locations of all the chunks in the dataset, or NULL until first used */
+    size_t        coalesce_max; /* Max. bytes to read at once for chunks next to each other in the file */
+    struct {
+        size_t      nbufs;     /* # of free buffers in the pool        */
+        size_t      nbytes;    /* Total size of the free buffers       */
+        struct {
+            void    *buf;      /* Free buffer for filtered chunk data  */
+            size_t  alloc;     /* Size of the buffer                   */
+        } buf[H5D_CHUNK_POOL_NBUFS];
+    } pool;
+    struct {
+        hbool_t     valid;     /* Whether 'last' is set                */
+        unsigned    dim;       /* Dimension of the last step           */
+        hssize_t    stride;    /* Length of the last step, in chunks   */
+        hsize_t     last[H5O_LAYOUT_NDIMS]; /* Last chunk missed or read ahead */
+    } ra;
     struct H5D_rdcc_ent_t *head; /* Head of doubly linked list        */
     struct H5D_rdcc_ent_t *tail; /* Tail of doubly linked list        */
     struct H5D_rdcc_ent_t *tmp_head; /* Head of temporary doubly linked list.  Chunks on this list are not in the hash table (slot).  The head entry is a sentinel (does not refer to an actual chunk). */
@@ -411,7 +465,7 @@ typedef struct H5D_rdcc_t {
     int           nused;        /* Number of chunk slots in use        */
     H5D_chunk_cached_t last;    /* Cached copy of last chunk information */
     struct H5D_rdcc_ent_t **slot; /* Chunk slots, each points to a chunk*/
-    H5SL_t        *sel_chunks;    /* Skip list containing information for each chunk selected */
+    H5D_chunk_sel_t sel_chunks;   /* Array of chunks selected, reused for each I/O operation */
     H5S_t         *single_space;  /* Dataspace for single element I/O on chunks */
     H5D_chunk_info_t    *single_chunk_info;  /* Pointer to single chunk's info */
 
@@ -645,6 +699,7 @@ H5_DLL herr_t H5D__chunk_allocated(const H5D_t *dset, hsize_t *nbytes);
 H5_DLL herr_t H5D__chunk_allocate(const H5D_io_info_t *io_info, hbool_t full_overwrite, hsize_t old_dim[]);
 H5_DLL herr_t H5D__chunk_file_alloc(const H5D_chk_idx_info_t *idx_info, const H5F_block_t *old_chunk,
     H5F_block_t *new_chunk, hbool_t *need_insert, const hsize_t *scaled);
+H5_DLL H5D_chunk_info_t *H5D__chunk_sel_find(const H5D_chunk_sel_t *sel, hsize_t index);
 H5_DLL herr_t H5D__chunk_update_old_edge_chunks(H5D_t *dset, hsize_t old_dim[]);
 H5_DLL herr_t H5D__chunk_prune_by_extent(H5D_t *dset, const hsize_t *old_dim);
 H5_DLL herr_t H5D__chunk_set_sizes(H5D_t *dset);
@@ -756,6 +811,9 @@ H5_DLL herr_t H5D__layout_compact_dirty_test(hid_t did, hbool_t *dirty);
 H5_DLL herr_t H5D__layout_idx_type_test(hid_t did, H5D_chunk_index_t *idx_type);
 H5_DLL herr_t H5D__layout_type_test(hid_t did, H5D_layout_t *layout_type);
 H5_DLL herr_t H5D__current_cache_size_test(hid_t did, size_t *nbytes_used, int *nused);
+H5_DLL herr_t H5D__chunk_cache_hits_test(hid_t did, unsigned *nhits, int *nhot);
+H5_DLL herr_t H5D__chunk_addr_table_test(hid_t did, hbool_t *loaded);
+H5_DLL herr_t H5D__chunk_pool_test(hid_t did, size_t *nbufs, size_t *nbytes);
 #endif /* H5D_TESTING */
 
 #endif /*_H5Dpkg_H*/
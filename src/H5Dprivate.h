@@ -46,6 +46,8 @@
 #define H5D_CRT_ALLOC_TIME_STATE_NAME "alloc_time_state" /* Space allocation time state */
 #define H5D_CRT_EXT_FILE_LIST_NAME "efl"                 /* External file list */
 #define H5D_CRT_MIN_DSET_HDR_SIZE_NAME "dset_oh_minimize"/* Minimize object header */
+#define H5D_CRT_CHUNK_FILTER_MODE_NAME "chunk_filter_mode" /* Chunk filter mode flags */
+#define H5D_CRT_CHUNK_FILTER_MIN_GAIN_NAME "chunk_filter_min_gain" /* Min. gain from filtering a chunk */
 
 /* ========  Dataset access property names ======== */
 #define H5D_ACS_DATA_CACHE_NUM_SLOTS_NAME   "rdcc_nslots"    /* Size of raw data chunk cache(slots) */
@@ -56,6 +58,11 @@
 #define H5D_ACS_VDS_PREFIX_NAME             "vds_prefix"     /* VDS file prefix */
 #define H5D_ACS_APPEND_FLUSH_NAME           "append_flush"   /* Append flush actions */
 #define H5D_ACS_EFILE_PREFIX_NAME           "external file prefix" /* External file prefix */
+#define H5D_ACS_CHUNK_ENCODE_NTHREADS_NAME  "chunk_encode_nthreads" /* Threads for filtering chunks when flushing them */
+#define H5D_ACS_CHUNK_READAHEAD_NAME        "chunk_readahead"       /* # of chunks to read ahead of sequential access */
+#define H5D_ACS_CHUNK_CACHE_POLICY_NAME     "chunk_cache_policy"    /* Chunk cache replacement policy */
+#define H5D_ACS_CHUNK_ADDR_TABLE_NAME       "chunk_addr_table"      /* Whether to look up chunks in an in-memory address table */
+#define H5D_ACS_CHUNK_READ_COALESCE_NAME    "chunk_read_coalesce"   /* Max. bytes to read at once for chunks next to each other in the file */
 
 /* ======== Data transfer properties ======== */
 #define H5D_XFER_MAX_TEMP_BUF_NAME      "max_temp_buf"  /* Maximum temp buffer size */
@@ -83,6 +90,8 @@
 #define H5D_XFER_FILTER_CB_NAME         "filter_cb"      /* Filter callback function */
 #define H5D_XFER_CONV_CB_NAME           "type_conv_cb"   /* Type conversion callback function */
 #define H5D_XFER_XFORM_NAME             "data_transform" /* Data transform */
+#define H5D_XFER_CHUNK_DECODE_NTHREADS_NAME "chunk_decode_nthreads" /* Threads for decoding filtered chunks */
+#define H5D_XFER_DEFLATE_NTHREADS_NAME  "deflate_nthreads" /* Threads for compressing a chunk with deflate */
 #ifdef H5_HAVE_INSTRUMENTED_LIBRARY
 /* Collective chunk instrumentation properties */
 #define H5D_XFER_COLL_CHUNK_LINK_HARD_NAME "coll_chunk_link_hard"
@@ -132,6 +141,8 @@ typedef struct H5D_dcpl_cache_t {
     H5O_fill_t fill;            /* Fill value info (H5D_CRT_FILL_VALUE_NAME) */
     H5O_pline_t pline;          /* I/O pipeline info (H5O_CRT_PIPELINE_NAME) */
     H5O_efl_t efl;              /* External file list info (H5D_CRT_EXT_FILE_LIST_NAME) */
+    unsigned chunk_filter_mode; /* Chunk filter mode flags (H5D_CRT_CHUNK_FILTER_MODE_NAME) */
+    double chunk_filter_min_gain; /* Min. gain from filtering a chunk (H5D_CRT_CHUNK_FILTER_MIN_GAIN_NAME) */
 } H5D_dcpl_cache_t;
 
 /* Callback information for copying datasets */
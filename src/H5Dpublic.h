@@ -35,6 +35,10 @@
 /* Bit flags for the H5Pset_chunk_opts() and H5Pget_chunk_opts() */
 #define H5D_CHUNK_DONT_FILTER_PARTIAL_CHUNKS      (0x0002u)
 
+/* Bit flags for the H5Pset_chunk_filter_mode() and H5Pget_chunk_filter_mode() */
+#define H5D_CHUNK_FILTER_ADAPTIVE       (0x0001u)   /* Store chunks that don't filter well unfiltered */
+#define H5D_CHUNK_SKIP_FILL_CHUNKS      (0x0002u)   /* Don't store new chunks holding only the fill value */
+
 /*******************/
 /* Public Typedefs */
 /*******************/
@@ -101,6 +105,26 @@ typedef enum H5D_vds_view_t {
     H5D_VDS_LAST_AVAILABLE      = 1
 } H5D_vds_view_t;
 
+/* Replacement policies for the raw data chunk cache */
+typedef enum H5D_chunk_cache_policy_t {
+    H5D_CHUNK_CACHE_POLICY_ERROR = -1,
+    H5D_CHUNK_CACHE_POLICY_LRU   = 0,   /* Approximate LRU, weighted by w0 (default) */
+    H5D_CHUNK_CACHE_POLICY_2Q    = 1    /* Scan-resistant 2Q */
+} H5D_chunk_cache_policy_t;
+
+/* Statistics of a dataset's raw data chunk cache, from H5Dget_chunk_cache_stats() */
+typedef struct H5D_chunk_cache_stats_t {
+    hsize_t     nhits;          /* # of chunk accesses found in the cache */
+    hsize_t     nmisses;        /* # of chunks read from the file into the cache */
+    hsize_t     nreads;         /* # of file reads made to bring chunks into the cache */
+    hsize_t     nevictions;     /* # of chunks removed from the cache */
+    hsize_t     npreemptions;   /* # of evictions made to free room for other chunks */
+    hsize_t     nflushes;       /* # of chunks written to the file */
+    hsize_t     nbytes_decoded; /* Bytes of chunk data produced by the filters when reading */
+    hsize_t     nbytes_encoded; /* Bytes of chunk data passed through the filters when writing */
+    double      filter_time;    /* Seconds spent running chunks through the filters */
+} H5D_chunk_cache_stats_t;
+
 /* Callback for H5Pset_append_flush() in a dataset access property list */
 typedef herr_t (*H5D_append_cb_t)(hid_t dataset_id, hsize_t *cur_dims, void *op_data);
 
@@ -146,6 +170,8 @@ H5_DLL herr_t H5Dget_num_chunks(hid_t dset_id, hid_t fspace_id, hsize_t *nchunks
 H5_DLL herr_t H5Dget_chunk_info_by_coord(hid_t dset_id, const hsize_t *coord, unsigned *filter_mask, haddr_t *addr, hsize_t *size);
 H5_DLL herr_t H5Dget_chunk_info(hid_t dset_id, hid_t fspace_id, hsize_t chk_idx, hsize_t *coord, unsigned *filter_mask, haddr_t *addr, hsize_t *size);
 H5_DLL haddr_t H5Dget_offset(hid_t dset_id);
+H5_DLL herr_t H5Dget_chunk_cache_stats(hid_t dset_id, H5D_chunk_cache_stats_t *stats);
+H5_DLL herr_t H5Dreset_chunk_cache_stats(hid_t dset_id);
 H5_DLL herr_t H5Dread(hid_t dset_id, hid_t mem_type_id, hid_t mem_space_id,
 			hid_t file_space_id, hid_t plist_id, void *buf/*out*/);
 H5_DLL herr_t H5Dwrite(hid_t dset_id, hid_t mem_type_id, hid_t mem_space_id,
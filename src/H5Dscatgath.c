@@ -746,6 +746,10 @@ done:
  *              The optimization is simply moving data to the appropriate
  *              places in the buffer.
  *
+ *              Also used when no conversion is needed but members are
+ *              left out or moved (H5T_SUBSET_PLAN): then each run of the
+ *              conversion's copy plan is moved instead.
+ *
  * Return:	Non-negative on success/Negative on failure
  *
  * Programmer:	Raymond Lu
@@ -774,7 +778,8 @@ H5D__compound_opt_read(size_t nelmts, H5S_sel_iter_t *iter,
     HDassert(type_info);
     HDassert(type_info->cmpd_subset);
     HDassert(H5T_SUBSET_SRC == type_info->cmpd_subset->subset ||
-        H5T_SUBSET_DST == type_info->cmpd_subset->subset);
+        H5T_SUBSET_DST == type_info->cmpd_subset->subset ||
+        H5T_SUBSET_PLAN == type_info->cmpd_subset->subset);
     HDassert(user_buf);
 
     /* Get info from API context */
@@ -827,13 +832,29 @@ H5D__compound_opt_read(size_t nelmts, H5S_sel_iter_t *iter,
             xubuf = ubuf + curr_off;
 
             /* Copy the data into the right place. */
-            for(i = 0; i < curr_nelmts; i++) {
-                HDmemmove(xubuf, xdbuf, copy_size);
-
-                /* Update pointers */
-                xdbuf += src_stride;
-                xubuf += dst_stride;
-            } /* end for */
+            if(H5T_SUBSET_PLAN == type_info->cmpd_subset->subset) {
+                const H5T_subset_copy_t *copies = type_info->cmpd_subset->copies;
+                size_t ncopies = type_info->cmpd_subset->ncopies;
+                size_t u;               /* Local index variable */
+
+                for(i = 0; i < curr_nelmts; i++) {
+                    for(u = 0; u < ncopies; u++)
+                        HDmemcpy(xubuf + copies[u].dst_offset, xdbuf + copies[u].src_offset, copies[u].size);
+
+                    /* Update pointers */
+                    xdbuf += src_stride;
+                    xubuf += dst_stride;
+                } /* end for */
+            } /* end if */
+            else {
+                for(i = 0; i < curr_nelmts; i++) {
+                    HDmemmove(xubuf, xdbuf, copy_size);
+
+                    /* Update pointers */
+                    xdbuf += src_stride;
+                    xubuf += dst_stride;
+                } /* end for */
+            } /* end else */
         } /* end for */
 
         /* Decrement number of elements left to process */
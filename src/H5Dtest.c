@@ -309,3 +309,142 @@ done:
     FUNC_LEAVE_NOAPI(ret_value)
 }   /* H5D__current_cache_size_test() */
 
+
+/*--------------------------------------------------------------------------
+ NAME
+    H5D__chunk_cache_hits_test
+ PURPOSE
+    Determine the number of hits in the dataset's chunk cache
+ USAGE
+    herr_t H5D__chunk_cache_hits_test(did, nhits, nhot)
+        hid_t did;              IN: Dataset to query
+        unsigned *nhits;        OUT: Pointer to location to place # of hits
+        int *nhot;              OUT: Pointer to location to place # of entries
+                                     in the 2Q hot queue
+ RETURNS
+    Non-negative on success, negative on failure
+ DESCRIPTION
+    Checks the number of chunk cache hits since the dataset was opened, and
+    the number of cached chunks in the hot queue of the 2Q policy.
+ GLOBAL VARIABLES
+ COMMENTS, BUGS, ASSUMPTIONS
+    DO NOT USE THIS FUNCTION FOR ANYTHING EXCEPT TESTING
+ EXAMPLES
+ REVISION LOG
+--------------------------------------------------------------------------*/
+herr_t
+H5D__chunk_cache_hits_test(hid_t did, unsigned *nhits, int *nhot)
+{
+    H5D_t	*dset;          /* Pointer to dataset to query */
+    herr_t ret_value = SUCCEED;   /* return value */
+
+    FUNC_ENTER_PACKAGE
+
+    /* Check args */
+    if(NULL == (dset = (H5D_t *)H5VL_object_verify(did, H5I_DATASET)))
+        HGOTO_ERROR(H5E_ARGS, H5E_BADTYPE, FAIL, "not a dataset")
+
+    if(nhits) {
+        HDassert(dset->shared->layout.type == H5D_CHUNKED);
+        *nhits = (unsigned)dset->shared->cache.chunk.stats.nhits;
+    } /* end if */
+
+    if(nhot) {
+        HDassert(dset->shared->layout.type == H5D_CHUNKED);
+        *nhot = dset->shared->cache.chunk.nhot;
+    } /* end if */
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+}   /* H5D__chunk_cache_hits_test() */
+
+
+/*--------------------------------------------------------------------------
+ NAME
+    H5D__chunk_addr_table_test
+ PURPOSE
+    Determine whether the dataset's chunk address table has been loaded
+ USAGE
+    herr_t H5D__chunk_addr_table_test(did, loaded)
+        hid_t did;              IN: Dataset to query
+        hbool_t *loaded;        OUT: Pointer to location to place whether
+                                     the table is loaded
+ RETURNS
+    Non-negative on success, negative on failure
+ DESCRIPTION
+    Checks whether chunk lookups for the dataset are served from the
+    chunk address table.
+ GLOBAL VARIABLES
+ COMMENTS, BUGS, ASSUMPTIONS
+    DO NOT USE THIS FUNCTION FOR ANYTHING EXCEPT TESTING
+ EXAMPLES
+ REVISION LOG
+--------------------------------------------------------------------------*/
+herr_t
+H5D__chunk_addr_table_test(hid_t did, hbool_t *loaded)
+{
+    H5D_t	*dset;          /* Pointer to dataset to query */
+    herr_t ret_value = SUCCEED;   /* return value */
+
+    FUNC_ENTER_PACKAGE
+
+    /* Check args */
+    if(NULL == (dset = (H5D_t *)H5VL_object_verify(did, H5I_DATASET)))
+        HGOTO_ERROR(H5E_ARGS, H5E_BADTYPE, FAIL, "not a dataset")
+
+    if(loaded) {
+        HDassert(dset->shared->layout.type == H5D_CHUNKED);
+        *loaded = (hbool_t)(dset->shared->cache.chunk.addr_table != NULL);
+    } /* end if */
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+}   /* H5D__chunk_addr_table_test() */
+
+
+
+/*--------------------------------------------------------------------------
+ NAME
+    H5D__chunk_pool_test
+ PURPOSE
+    Determine the number and size of free buffers in the dataset's chunk
+    buffer pool
+ USAGE
+    herr_t H5D__chunk_pool_test(did, nbufs, nbytes)
+        hid_t did;              IN: Dataset to query
+        size_t *nbufs;          OUT: Pointer to location to place the
+                                     number of free buffers in the pool
+        size_t *nbytes;         OUT: Pointer to location to place the
+                                     total size of the free buffers
+ RETURNS
+    Non-negative on success, negative on failure
+ DESCRIPTION
+    Checks how many filtered chunk buffers the dataset is keeping for
+    reuse, and how much memory they hold.
+ GLOBAL VARIABLES
+ COMMENTS, BUGS, ASSUMPTIONS
+    DO NOT USE THIS FUNCTION FOR ANYTHING EXCEPT TESTING
+ EXAMPLES
+ REVISION LOG
+--------------------------------------------------------------------------*/
+herr_t
+H5D__chunk_pool_test(hid_t did, size_t *nbufs, size_t *nbytes)
+{
+    H5D_t	*dset;          /* Pointer to dataset to query */
+    herr_t ret_value = SUCCEED;   /* return value */
+
+    FUNC_ENTER_PACKAGE
+
+    /* Check args */
+    if(NULL == (dset = (H5D_t *)H5VL_object_verify(did, H5I_DATASET)))
+        HGOTO_ERROR(H5E_ARGS, H5E_BADTYPE, FAIL, "not a dataset")
+
+    HDassert(dset->shared->layout.type == H5D_CHUNKED);
+    if(nbufs)
+        *nbufs = dset->shared->cache.chunk.pool.nbufs;
+    if(nbytes)
+        *nbytes = dset->shared->cache.chunk.pool.nbytes;
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+}   /* H5D__chunk_pool_test() */
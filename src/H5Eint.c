@@ -776,6 +776,7 @@ herr_t
 H5E__push_stack(H5E_t *estack, const char *file, const char *func, unsigned line,
     hid_t cls_id, hid_t maj_id, hid_t min_id, const char *desc)
 {
+    hbool_t     take_refs = TRUE;         /* Whether the stack holds references to the IDs */
     herr_t	ret_value = SUCCEED;      /* Return value */
 
     /*
@@ -792,6 +793,16 @@ H5E__push_stack(H5E_t *estack, const char *file, const char *func, unsigned line
     HDassert(maj_id > 0);
     HDassert(min_id > 0);
 
+#ifdef H5_HAVE_THREADSAFE
+    /* The helper threads of H5TS_parallel_for() don't hold the API lock
+     * that guards the IDs' reference counts, so their errors don't hold
+     * references until H5E_attach_helper_errors() moves them to the stack
+     * of the thread that holds it.  (Helper threads only push the
+     * library's own error classes and messages, which stay open.) */
+    if(H5TS_is_helper_thread())
+        take_refs = FALSE;
+#endif /* H5_HAVE_THREADSAFE */
+
     /* Check for 'default' error stack */
     if(estack == NULL)
     	if(NULL == (estack = H5E__get_my_stack())) /*lint !e506 !e774 Make lint 'constant value Boolean' in non-threaded case */
@@ -815,13 +826,13 @@ H5E__push_stack(H5E_t *estack, const char *file, const char *func, unsigned line
 
     if(estack->nused < H5E_NSLOTS) {
         /* Increment the IDs to indicate that they are used in this stack */
-        if(H5I_inc_ref(cls_id, FALSE) < 0)
+        if(take_refs && H5I_inc_ref(cls_id, FALSE) < 0)
             HGOTO_DONE(FAIL)
 	estack->slot[estack->nused].cls_id = cls_id;
-        if(H5I_inc_ref(maj_id, FALSE) < 0)
+        if(take_refs && H5I_inc_ref(maj_id, FALSE) < 0)
             HGOTO_DONE(FAIL)
 	estack->slot[estack->nused].maj_num = maj_id;
-        if(H5I_inc_ref(min_id, FALSE) < 0)
+        if(take_refs && H5I_inc_ref(min_id, FALSE) < 0)
             HGOTO_DONE(FAIL)
 	estack->slot[estack->nused].min_num = min_id;
 	if(NULL == (estack->slot[estack->nused].func_name = H5MM_xstrdup(func)))
@@ -856,6 +867,7 @@ static herr_t
 H5E__clear_entries(H5E_t *estack, size_t nentries)
 {
     H5E_error2_t *error;        /* Pointer to error stack entry to clear */
+    hbool_t held_refs = TRUE;   /* Whether the stack holds references to the IDs */
     unsigned u;                 /* Local index variable */
     herr_t ret_value = SUCCEED; /* Return value */
 
@@ -865,18 +877,26 @@ H5E__clear_entries(H5E_t *estack, size_t nentries)
     HDassert(estack);
     HDassert(estack->nused >= nentries);
 
+#ifdef H5_HAVE_THREADSAFE
+    /* (See H5E__push_stack()) */
+    if(H5TS_is_helper_thread())
+        held_refs = FALSE;
+#endif /* H5_HAVE_THREADSAFE */
+
     /* Empty the error stack from the top down */
     for(u = 0; nentries > 0; nentries--, u++) {
         error = &(estack->slot[estack->nused - (u + 1)]);
 
         /* Decrement the IDs to indicate that they are no longer used by this stack */
         /* (In reverse order that they were incremented, so that reference counts work well) */
-        if(H5I_dec_ref(error->min_num) < 0)
-            HGOTO_ERROR(H5E_ERROR, H5E_CANTDEC, FAIL, "unable to decrement ref count on error message")
-        if(H5I_dec_ref(error->maj_num) < 0)
-            HGOTO_ERROR(H5E_ERROR, H5E_CANTDEC, FAIL, "unable to decrement ref count on error message")
-        if(H5I_dec_ref(error->cls_id) < 0)
-            HGOTO_ERROR(H5E_ERROR, H5E_CANTDEC, FAIL, "unable to decrement ref count on error class")
+        if(held_refs) {
+            if(H5I_dec_ref(error->min_num) < 0)
+                HGOTO_ERROR(H5E_ERROR, H5E_CANTDEC, FAIL, "unable to decrement ref count on error message")
+            if(H5I_dec_ref(error->maj_num) < 0)
+                HGOTO_ERROR(H5E_ERROR, H5E_CANTDEC, FAIL, "unable to decrement ref count on error message")
+            if(H5I_dec_ref(error->cls_id) < 0)
+                HGOTO_ERROR(H5E_ERROR, H5E_CANTDEC, FAIL, "unable to decrement ref count on error class")
+        } /* end if */
 
         /* Release strings */
         if(error->func_name)
@@ -930,6 +950,83 @@ done:
     FUNC_LEAVE_NOAPI(ret_value)
 } /* end H5E_clear_stack() */
 
+#ifdef H5_HAVE_THREADSAFE
+
+/*-------------------------------------------------------------------------
+ * Function:    H5E_detach_helper_errors
+ *
+ * Purpose:     Take the errors pushed on a helper thread of
+ *              H5TS_parallel_for(), leaving the thread's error stack
+ *              empty, so that H5E_attach_helper_errors() can move them to
+ *              the stack of the thread that called H5TS_parallel_for().
+ *
+ * Return:      Success:        The errors, or NULL if there are none
+ *              Failure:        NULL (and the errors are dropped)
+ *
+ *-------------------------------------------------------------------------
+ */
+H5E_t *
+H5E_detach_helper_errors(void)
+{
+    H5E_t *estack;                      /* The thread's error stack */
+    H5E_t *ret_value = NULL;            /* Return value */
+
+    FUNC_ENTER_NOAPI(NULL)
+
+    HDassert(H5TS_is_helper_thread());
+
+    if(NULL != (estack = H5E__get_my_stack()) && estack->nused > 0) {
+        if(NULL != (ret_value = (H5E_t *)H5MM_malloc(sizeof(H5E_t))))
+            H5MM_memcpy(ret_value, estack, sizeof(H5E_t));
+        else
+            (void)H5E__clear_entries(estack, estack->nused);
+        estack->nused = 0;
+    } /* end if */
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5E_detach_helper_errors() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:    H5E_attach_helper_errors
+ *
+ * Purpose:     Push the errors taken from a helper thread with
+ *              H5E_detach_helper_errors() onto the current error stack,
+ *              taking references to their IDs, and release ERRORS.
+ *
+ * Return:      SUCCEED/FAIL
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5E_attach_helper_errors(H5E_t *errors)
+{
+    size_t u;                           /* Local index variable */
+    herr_t ret_value = SUCCEED;         /* Return value */
+
+    FUNC_ENTER_NOAPI(FAIL)
+
+    HDassert(errors);
+    HDassert(!H5TS_is_helper_thread());
+
+    for(u = 0; u < errors->nused; u++) {
+        H5E_error2_t *error = &(errors->slot[u]);
+
+        if(H5E__push_stack(NULL, error->file_name, error->func_name, error->line,
+                error->cls_id, error->maj_num, error->min_num, error->desc) < 0)
+            ret_value = FAIL;
+        H5MM_xfree_const(error->func_name);
+        H5MM_xfree_const(error->file_name);
+        H5MM_xfree_const(error->desc);
+    } /* end for */
+    H5MM_xfree(errors);
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5E_attach_helper_errors() */
+#endif /* H5_HAVE_THREADSAFE */
+
 
 /*-------------------------------------------------------------------------
  * Function:    H5E__pop
@@ -294,6 +294,7 @@ struct H5F_shared_t {
     size_t	rdcc_nslots;	/* Size of raw data chunk cache (slots)	*/
     size_t	rdcc_nbytes;	/* Size of raw data chunk cache	(bytes)	*/
     double	rdcc_w0;	/* Preempt read chunks first? [0.0..1.0]*/
+    H5F_rdcc_budget_t rdcc_budget; /* Raw data chunk cache memory shared by datasets */
     size_t      sieve_buf_size; /* Size of the data sieve buffer allocated (in bytes) */
     hsize_t	threshold;	/* Threshold for alignment		*/
     hsize_t	alignment;	/* Alignment				*/
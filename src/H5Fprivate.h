@@ -315,6 +315,7 @@ typedef struct H5F_t H5F_t;
 #define H5F_RDCC_NSLOTS(F)      ((F)->shared->rdcc_nslots)
 #define H5F_RDCC_NBYTES(F)      ((F)->shared->rdcc_nbytes)
 #define H5F_RDCC_W0(F)          ((F)->shared->rdcc_w0)
+#define H5F_RDCC_BUDGET(F)      (&(F)->shared->rdcc_budget)
 #define H5F_SIEVE_BUF_SIZE(F)   ((F)->shared->sieve_buf_size)
 #define H5F_GC_REF(F)           ((F)->shared->gc_ref)
 #define H5F_STORE_MSG_CRT_IDX(F)    ((F)->shared->store_msg_crt_idx)
@@ -377,6 +378,7 @@ typedef struct H5F_t H5F_t;
 #define H5F_RDCC_NSLOTS(F)      (H5F_rdcc_nslots(F))
 #define H5F_RDCC_NBYTES(F)      (H5F_rdcc_nbytes(F))
 #define H5F_RDCC_W0(F)          (H5F_rdcc_w0(F))
+#define H5F_RDCC_BUDGET(F)      (H5F_rdcc_budget(F))
 #define H5F_SIEVE_BUF_SIZE(F)   (H5F_sieve_buf_size(F))
 #define H5F_GC_REF(F)           (H5F_gc_ref(F))
 #define H5F_STORE_MSG_CRT_IDX(F) (H5F_store_msg_crt_idx(F))
@@ -484,6 +486,7 @@ typedef struct H5F_t H5F_t;
 #define H5F_ACS_DATA_CACHE_NUM_SLOTS_NAME       "rdcc_nslots"   /* Size of raw data chunk cache(slots) */
 #define H5F_ACS_DATA_CACHE_BYTE_SIZE_NAME       "rdcc_nbytes"   /* Size of raw data chunk cache(bytes) */
 #define H5F_ACS_PREEMPT_READ_CHUNKS_NAME        "rdcc_w0"       /* Preemption read chunks first */
+#define H5F_ACS_DATA_CACHE_BUDGET_NAME          "rdcc_budget"   /* File-wide raw data chunk cache budget (bytes) */
 #define H5F_ACS_ALIGN_THRHD_NAME                "threshold"     /* Threshold for alignment */
 #define H5F_ACS_ALIGN_NAME                      "align"         /* Alignment */
 #define H5F_ACS_META_BLOCK_SIZE_NAME            "meta_block_size" /* Minimum metadata allocation block size (when aggregating metadata allocations) */
@@ -676,6 +679,15 @@ typedef struct H5F_object_flush_t {
     void *udata;                /* User data */
 } H5F_object_flush_t;
 
+/* Raw data chunk cache memory shared by the datasets in a file */
+struct H5D_rdcc_ent_t;
+typedef struct H5F_rdcc_budget_t {
+    size_t      nbytes_max;     /* Max. bytes cached across datasets (0 for no limit) */
+    size_t      nbytes_used;    /* Bytes cached across datasets */
+    struct H5D_rdcc_ent_t *head; /* Least recently used chunk cache entry */
+    struct H5D_rdcc_ent_t *tail; /* Most recently used chunk cache entry */
+} H5F_rdcc_budget_t;
+
 /* Concise info about a block of bytes in a file */
 typedef struct H5F_block_t {
     haddr_t offset;             /* Offset of the block in the file */
@@ -783,6 +795,7 @@ H5_DLL hbool_t H5F_get_evict_on_close(const H5F_t *f);
 H5_DLL size_t H5F_rdcc_nbytes(const H5F_t *f);
 H5_DLL size_t H5F_rdcc_nslots(const H5F_t *f);
 H5_DLL double H5F_rdcc_w0(const H5F_t *f);
+H5_DLL H5F_rdcc_budget_t *H5F_rdcc_budget(const H5F_t *f);
 H5_DLL size_t H5F_sieve_buf_size(const H5F_t *f);
 H5_DLL unsigned H5F_gc_ref(const H5F_t *f);
 H5_DLL hbool_t H5F_store_msg_crt_idx(const H5F_t *f);
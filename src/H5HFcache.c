@@ -1680,7 +1680,7 @@ H5HF__cache_dblock_verify_chksum(const void *_image, size_t len, void *_udata)
         H5MM_memcpy(read_buf, image, len);
 
         /* Push direct block data through I/O filter pipeline */
-        if(H5Z_pipeline(&(hdr->pline), H5Z_FLAG_REVERSE, &filter_mask, H5Z_ENABLE_EDC, filter_cb, &nbytes, &len, &read_buf) < 0)
+        if(H5Z_pipeline(&(hdr->pline), H5Z_FLAG_REVERSE, &filter_mask, H5Z_ENABLE_EDC, filter_cb, udata->dblock_size, &nbytes, &len, &read_buf) < 0)
             HGOTO_ERROR(H5E_HEAP, H5E_CANTFILTER, FAIL, "output pipeline failed")
 
         /* Update info about direct block */
@@ -1834,7 +1834,7 @@ H5HF__cache_dblock_deserialize(const void *_image, size_t len, void *_udata,
             /* Push direct block data through I/O filter pipeline */
             nbytes = len;
             filter_mask = udata->filter_mask;
-            if (H5Z_pipeline(&(hdr->pline), H5Z_FLAG_REVERSE, &filter_mask, H5Z_ENABLE_EDC, filter_cb, &nbytes, &len, &read_buf) < 0)
+            if (H5Z_pipeline(&(hdr->pline), H5Z_FLAG_REVERSE, &filter_mask, H5Z_ENABLE_EDC, filter_cb, udata->dblock_size, &nbytes, &len, &read_buf) < 0)
                 HGOTO_ERROR(H5E_HEAP, H5E_CANTFILTER, NULL, "output pipeline failed")
 
             /* Sanity check */
@@ -2205,7 +2205,7 @@ H5HF__cache_dblock_pre_serialize(H5F_t *f, void *_thing,
 
         /* Push direct block data through I/O filter pipeline */
         nbytes = write_size;
-        if(H5Z_pipeline(&(hdr->pline), 0, &filter_mask, H5Z_ENABLE_EDC, filter_cb, &nbytes, &write_size, &write_buf) < 0)
+        if(H5Z_pipeline(&(hdr->pline), 0, &filter_mask, H5Z_ENABLE_EDC, filter_cb, (size_t)0, &nbytes, &write_size, &write_buf) < 0)
             HGOTO_ERROR(H5E_HEAP, H5E_WRITEERROR, FAIL, "output pipeline failed")
 
         /* Use the compressed number of bytes as the size to write */
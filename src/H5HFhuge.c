@@ -360,7 +360,7 @@ HDfprintf(stderr, "%s: obj_size = %Zu\n", FUNC, obj_size);
         /* Push direct block data through I/O filter pipeline */
         nbytes = write_size;
         if(H5Z_pipeline(&(hdr->pline), 0, &filter_mask, H5Z_NO_EDC,
-                 filter_cb, &nbytes, &write_size, &write_buf) < 0)
+                 filter_cb, (size_t)0, &nbytes, &write_size, &write_buf) < 0)
             HGOTO_ERROR(H5E_HEAP, H5E_CANTFILTER, FAIL, "output pipeline failed")
 #ifdef QAK
 HDfprintf(stderr, "%s: nbytes = %Zu, write_size = %Zu, write_buf = %p\n", FUNC, nbytes, write_size, write_buf);
@@ -690,6 +690,7 @@ H5HF__huge_op_real(H5HF_hdr_t *hdr, const uint8_t *id, hbool_t is_read,
     void *read_buf = NULL;              /* Pointer to buffer for reading */
     haddr_t obj_addr;                   /* Object's address in the file */
     size_t obj_size = 0;                /* Object's size in the file */
+    size_t defilt_size = 0;             /* Object's size once de-filtered (only used for filtered objects) */
     unsigned filter_mask = 0;           /* Filter mask for object (only used for filtered objects) */
     herr_t ret_value = SUCCEED;         /* Return value */
 
@@ -712,8 +713,10 @@ H5HF__huge_op_real(H5HF_hdr_t *hdr, const uint8_t *id, hbool_t is_read,
         H5F_DECODE_LENGTH(hdr->f, id, obj_size);
 
         /* Retrieve extra information needed for filtered objects */
-        if(hdr->filter_len > 0)
+        if(hdr->filter_len > 0) {
             UINT32DECODE(id, filter_mask);
+            H5F_DECODE_LENGTH(hdr->f, id, defilt_size);
+        } /* end if */
     } /* end if */
     else {
         /* Sanity check */
@@ -741,6 +744,7 @@ H5HF__huge_op_real(H5HF_hdr_t *hdr, const uint8_t *id, hbool_t is_read,
             obj_addr = found_rec.addr;
             H5_CHECKED_ASSIGN(obj_size, size_t, found_rec.len, hsize_t);
             filter_mask = found_rec.filter_mask;
+            H5_CHECKED_ASSIGN(defilt_size, size_t, found_rec.obj_size, hsize_t);
         } /* end if */
         else {
             H5HF_huge_bt2_indir_rec_t found_rec;  /* Record found from tracking object */
@@ -784,7 +788,7 @@ H5HF__huge_op_real(H5HF_hdr_t *hdr, const uint8_t *id, hbool_t is_read,
 
         /* De-filter the object */
         read_size = nbytes = obj_size;
-        if(H5Z_pipeline(&(hdr->pline), H5Z_FLAG_REVERSE, &filter_mask, H5Z_NO_EDC, filter_cb, &nbytes, &read_size, &read_buf) < 0)
+        if(H5Z_pipeline(&(hdr->pline), H5Z_FLAG_REVERSE, &filter_mask, H5Z_NO_EDC, filter_cb, defilt_size, &nbytes, &read_size, &read_buf) < 0)
             HGOTO_ERROR(H5E_HEAP, H5E_CANTFILTER, FAIL, "input filter failed")
         obj_size = nbytes;
     } /* end if */
@@ -96,6 +96,31 @@
 #define H5D_ACS_EFILE_PREFIX_COPY               H5P__dapl_efile_pref_copy
 #define H5D_ACS_EFILE_PREFIX_CMP                H5P__dapl_efile_pref_cmp
 #define H5D_ACS_EFILE_PREFIX_CLOSE              H5P__dapl_efile_pref_close
+/* Definitions for chunk encode threads */
+#define H5D_ACS_CHUNK_ENCODE_NTHREADS_SIZE      sizeof(unsigned)
+#define H5D_ACS_CHUNK_ENCODE_NTHREADS_DEF       1
+#define H5D_ACS_CHUNK_ENCODE_NTHREADS_ENC       H5P__encode_unsigned
+#define H5D_ACS_CHUNK_ENCODE_NTHREADS_DEC       H5P__decode_unsigned
+/* Definitions for chunk readahead */
+#define H5D_ACS_CHUNK_READAHEAD_SIZE            sizeof(unsigned)
+#define H5D_ACS_CHUNK_READAHEAD_DEF             0
+#define H5D_ACS_CHUNK_READAHEAD_ENC             H5P__encode_unsigned
+#define H5D_ACS_CHUNK_READAHEAD_DEC             H5P__decode_unsigned
+/* Definitions for chunk cache replacement policy */
+#define H5D_ACS_CHUNK_CACHE_POLICY_SIZE         sizeof(H5D_chunk_cache_policy_t)
+#define H5D_ACS_CHUNK_CACHE_POLICY_DEF          H5D_CHUNK_CACHE_POLICY_LRU
+#define H5D_ACS_CHUNK_CACHE_POLICY_ENC          H5P__dacc_chunk_cache_policy_enc
+#define H5D_ACS_CHUNK_CACHE_POLICY_DEC          H5P__dacc_chunk_cache_policy_dec
+/* Definitions for chunk address table */
+#define H5D_ACS_CHUNK_ADDR_TABLE_SIZE           sizeof(hbool_t)
+#define H5D_ACS_CHUNK_ADDR_TABLE_DEF            FALSE
+#define H5D_ACS_CHUNK_ADDR_TABLE_ENC            H5P__encode_hbool_t
+#define H5D_ACS_CHUNK_ADDR_TABLE_DEC            H5P__decode_hbool_t
+/* Definitions for coalescing chunk reads */
+#define H5D_ACS_CHUNK_READ_COALESCE_SIZE        sizeof(size_t)
+#define H5D_ACS_CHUNK_READ_COALESCE_DEF         0
+#define H5D_ACS_CHUNK_READ_COALESCE_ENC         H5P__encode_size_t
+#define H5D_ACS_CHUNK_READ_COALESCE_DEC         H5P__decode_size_t
 
 /******************/
 /* Local Typedefs */
@@ -123,6 +148,8 @@ static herr_t H5P__decode_chunk_cache_nbytes(const void **_pp, void *_value);
 /* Property list callbacks */
 static herr_t H5P__dacc_vds_view_enc(const void *value, void **pp, size_t *size);
 static herr_t H5P__dacc_vds_view_dec(const void **pp, void *value);
+static herr_t H5P__dacc_chunk_cache_policy_enc(const void *value, void **pp, size_t *size);
+static herr_t H5P__dacc_chunk_cache_policy_dec(const void **pp, void *value);
 static herr_t H5P__dapl_vds_file_pref_set(hid_t prop_id, const char* name, size_t size, void* value);
 static herr_t H5P__dapl_vds_file_pref_get(hid_t prop_id, const char* name, size_t size, void* value);
 static herr_t H5P__dapl_vds_file_pref_enc(const void *value, void **_pp, size_t *size);
@@ -180,6 +207,11 @@ const H5P_libclass_t H5P_CLS_DACC[1] = {{
 static const H5D_append_flush_t H5D_def_append_flush_g = H5D_ACS_APPEND_FLUSH_DEF;   /* Default setting for append flush */
 static const char *H5D_def_efile_prefix_g = H5D_ACS_EFILE_PREFIX_DEF;                /* Default external file prefix string */
 static const char *H5D_def_vds_prefix_g = H5D_ACS_VDS_PREFIX_DEF;                    /* Default vds prefix string */
+static const unsigned H5D_def_chunk_encode_nthreads_g = H5D_ACS_CHUNK_ENCODE_NTHREADS_DEF; /* Default number of chunk encode threads */
+static const unsigned H5D_def_chunk_readahead_g = H5D_ACS_CHUNK_READAHEAD_DEF;       /* Default number of chunks to read ahead */
+static const H5D_chunk_cache_policy_t H5D_def_chunk_cache_policy_g = H5D_ACS_CHUNK_CACHE_POLICY_DEF; /* Default chunk cache replacement policy */
+static const hbool_t H5D_def_chunk_addr_table_g = H5D_ACS_CHUNK_ADDR_TABLE_DEF;     /* Default setting for the chunk address table */
+static const size_t H5D_def_chunk_read_coalesce_g = H5D_ACS_CHUNK_READ_COALESCE_DEF; /* Default max. size of coalesced chunk reads */
 
 
 /*-------------------------------------------------------------------------
@@ -248,6 +280,36 @@ H5P__dacc_reg_prop(H5P_genclass_t *pclass)
             H5D_ACS_EFILE_PREFIX_DEL, H5D_ACS_EFILE_PREFIX_COPY, H5D_ACS_EFILE_PREFIX_CMP, H5D_ACS_EFILE_PREFIX_CLOSE) < 0)
          HGOTO_ERROR(H5E_PLIST, H5E_CANTINSERT, FAIL, "can't insert property into class")
 
+    /* Register property for the number of chunk encode threads */
+    if(H5P__register_real(pclass, H5D_ACS_CHUNK_ENCODE_NTHREADS_NAME, H5D_ACS_CHUNK_ENCODE_NTHREADS_SIZE, &H5D_def_chunk_encode_nthreads_g,
+            NULL, NULL, NULL, H5D_ACS_CHUNK_ENCODE_NTHREADS_ENC, H5D_ACS_CHUNK_ENCODE_NTHREADS_DEC,
+            NULL, NULL, NULL, NULL) < 0)
+         HGOTO_ERROR(H5E_PLIST, H5E_CANTINSERT, FAIL, "can't insert property into class")
+
+    /* Register property for the number of chunks to read ahead */
+    if(H5P__register_real(pclass, H5D_ACS_CHUNK_READAHEAD_NAME, H5D_ACS_CHUNK_READAHEAD_SIZE, &H5D_def_chunk_readahead_g,
+            NULL, NULL, NULL, H5D_ACS_CHUNK_READAHEAD_ENC, H5D_ACS_CHUNK_READAHEAD_DEC,
+            NULL, NULL, NULL, NULL) < 0)
+         HGOTO_ERROR(H5E_PLIST, H5E_CANTINSERT, FAIL, "can't insert property into class")
+
+    /* Register property for the chunk cache replacement policy */
+    if(H5P__register_real(pclass, H5D_ACS_CHUNK_CACHE_POLICY_NAME, H5D_ACS_CHUNK_CACHE_POLICY_SIZE, &H5D_def_chunk_cache_policy_g,
+            NULL, NULL, NULL, H5D_ACS_CHUNK_CACHE_POLICY_ENC, H5D_ACS_CHUNK_CACHE_POLICY_DEC,
+            NULL, NULL, NULL, NULL) < 0)
+         HGOTO_ERROR(H5E_PLIST, H5E_CANTINSERT, FAIL, "can't insert property into class")
+
+    /* Register property for the chunk address table */
+    if(H5P__register_real(pclass, H5D_ACS_CHUNK_ADDR_TABLE_NAME, H5D_ACS_CHUNK_ADDR_TABLE_SIZE, &H5D_def_chunk_addr_table_g,
+            NULL, NULL, NULL, H5D_ACS_CHUNK_ADDR_TABLE_ENC, H5D_ACS_CHUNK_ADDR_TABLE_DEC,
+            NULL, NULL, NULL, NULL) < 0)
+         HGOTO_ERROR(H5E_PLIST, H5E_CANTINSERT, FAIL, "can't insert property into class")
+
+    /* Register property for the max. size of coalesced chunk reads */
+    if(H5P__register_real(pclass, H5D_ACS_CHUNK_READ_COALESCE_NAME, H5D_ACS_CHUNK_READ_COALESCE_SIZE, &H5D_def_chunk_read_coalesce_g,
+            NULL, NULL, NULL, H5D_ACS_CHUNK_READ_COALESCE_ENC, H5D_ACS_CHUNK_READ_COALESCE_DEC,
+            NULL, NULL, NULL, NULL) < 0)
+         HGOTO_ERROR(H5E_PLIST, H5E_CANTINSERT, FAIL, "can't insert property into class")
+
 done:
     FUNC_LEAVE_NOAPI(ret_value)
 } /* end H5P__dacc_reg_prop() */
@@ -1586,3 +1648,473 @@ done:
     FUNC_LEAVE_API(ret_value)
 } /* end H5Pget_virtual_prefix() */
 
+
+
+/*-------------------------------------------------------------------------
+ * Function:    H5Pset_chunk_encode_nthreads
+ *
+ * Purpose:     Sets the number of threads used to run the filter pipeline
+ *              on dirty chunks when they are written out of the dataset's
+ *              raw data chunk cache.
+ *
+ *              When more than one thread is requested, the dirty filtered
+ *              chunks written together (when the cache is flushed, when
+ *              the dataset is closed, and when a dirty chunk is preempted
+ *              from the cache, along with the other dirty chunks nearest
+ *              preemption) are compressed concurrently, and then written
+ *              to the file in address order.  Multiple threads are only
+ *              used when the library is built thread-safe, and only when
+ *              all the dataset's filters are ones the library provides
+ *              and no filter callback is set (see H5Pset_filter_callback);
+ *              otherwise the chunks are filtered serially.  If filtering
+ *              any of the chunks fails, none of them are written and the
+ *              errors are reported on the calling thread's error stack.
+ *
+ *              The default is to use a single thread.
+ *
+ * Return:      Non-negative on success/Negative on failure
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5Pset_chunk_encode_nthreads(hid_t plist_id, unsigned nthreads)
+{
+    H5P_genplist_t *plist;      /* Property list pointer */
+    herr_t ret_value = SUCCEED; /* Return value */
+
+    FUNC_ENTER_API(FAIL)
+    H5TRACE2("e", "iIu", plist_id, nthreads);
+
+    /* Check argument */
+    if(nthreads < 1)
+        HGOTO_ERROR(H5E_ARGS, H5E_BADVALUE, FAIL, "number of threads must be at least 1")
+
+    /* Get the plist structure */
+    if(NULL == (plist = H5P_object_verify(plist_id, H5P_DATASET_ACCESS)))
+        HGOTO_ERROR(H5E_ATOM, H5E_BADATOM, FAIL, "can't find object for ID")
+
+    /* Update property list */
+    if(H5P_set(plist, H5D_ACS_CHUNK_ENCODE_NTHREADS_NAME, &nthreads) < 0)
+        HGOTO_ERROR(H5E_PLIST, H5E_CANTSET, FAIL, "unable to set value")
+
+done:
+    FUNC_LEAVE_API(ret_value)
+} /* end H5Pset_chunk_encode_nthreads() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:    H5Pget_chunk_encode_nthreads
+ *
+ * Purpose:     Gets the number of threads used to run the filter pipeline
+ *              on dirty chunks when they are written out of the dataset's
+ *              raw data chunk cache.
+ *
+ * Return:      Non-negative on success/Negative on failure
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5Pget_chunk_encode_nthreads(hid_t plist_id, unsigned *nthreads/*out*/)
+{
+    H5P_genplist_t *plist;      /* Property list pointer */
+    herr_t ret_value = SUCCEED; /* Return value */
+
+    FUNC_ENTER_API(FAIL)
+    H5TRACE2("e", "ix", plist_id, nthreads);
+
+    /* Get the plist structure */
+    if(NULL == (plist = H5P_object_verify(plist_id, H5P_DATASET_ACCESS)))
+        HGOTO_ERROR(H5E_ATOM, H5E_BADATOM, FAIL, "can't find object for ID")
+
+    /* Get value from property list */
+    if(nthreads)
+        if(H5P_get(plist, H5D_ACS_CHUNK_ENCODE_NTHREADS_NAME, nthreads) < 0)
+            HGOTO_ERROR(H5E_PLIST, H5E_CANTGET, FAIL, "unable to get value")
+
+done:
+    FUNC_LEAVE_API(ret_value)
+} /* end H5Pget_chunk_encode_nthreads() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:    H5Pset_chunk_readahead
+ *
+ * Purpose:     Sets the number of chunks to read ahead into the dataset's
+ *              raw data chunk cache when reads walk through the chunks
+ *              sequentially.
+ *
+ *              The chunk cache watches the chunks that miss the cache.
+ *              When two misses in a row step the same number of chunks
+ *              along the slowest or the fastest changing dimension of
+ *              the dataset, up to NCHUNKS of the following chunks along
+ *              that path are read (and decoded, for filtered chunks) in
+ *              one go, so that the next reads find them in the cache.
+ *              The number of chunks read ahead is also limited by the
+ *              size of the chunk cache.  Filtered chunks read ahead are
+ *              decoded with the number of threads set with
+ *              H5Pset_chunk_decode_nthreads for the read.
+ *
+ *              The default of 0 disables reading ahead.
+ *
+ * Return:      Non-negative on success/Negative on failure
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5Pset_chunk_readahead(hid_t plist_id, unsigned nchunks)
+{
+    H5P_genplist_t *plist;      /* Property list pointer */
+    herr_t ret_value = SUCCEED; /* Return value */
+
+    FUNC_ENTER_API(FAIL)
+    H5TRACE2("e", "iIu", plist_id, nchunks);
+
+    /* Get the plist structure */
+    if(NULL == (plist = H5P_object_verify(plist_id, H5P_DATASET_ACCESS)))
+        HGOTO_ERROR(H5E_ATOM, H5E_BADATOM, FAIL, "can't find object for ID")
+
+    /* Update property list */
+    if(H5P_set(plist, H5D_ACS_CHUNK_READAHEAD_NAME, &nchunks) < 0)
+        HGOTO_ERROR(H5E_PLIST, H5E_CANTSET, FAIL, "unable to set value")
+
+done:
+    FUNC_LEAVE_API(ret_value)
+} /* end H5Pset_chunk_readahead() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:    H5Pget_chunk_readahead
+ *
+ * Purpose:     Gets the number of chunks to read ahead into the dataset's
+ *              raw data chunk cache when reads walk through the chunks
+ *              sequentially.
+ *
+ * Return:      Non-negative on success/Negative on failure
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5Pget_chunk_readahead(hid_t plist_id, unsigned *nchunks/*out*/)
+{
+    H5P_genplist_t *plist;      /* Property list pointer */
+    herr_t ret_value = SUCCEED; /* Return value */
+
+    FUNC_ENTER_API(FAIL)
+    H5TRACE2("e", "ix", plist_id, nchunks);
+
+    /* Get the plist structure */
+    if(NULL == (plist = H5P_object_verify(plist_id, H5P_DATASET_ACCESS)))
+        HGOTO_ERROR(H5E_ATOM, H5E_BADATOM, FAIL, "can't find object for ID")
+
+    /* Get value from property list */
+    if(nchunks)
+        if(H5P_get(plist, H5D_ACS_CHUNK_READAHEAD_NAME, nchunks) < 0)
+            HGOTO_ERROR(H5E_PLIST, H5E_CANTGET, FAIL, "unable to get value")
+
+done:
+    FUNC_LEAVE_API(ret_value)
+} /* end H5Pget_chunk_readahead() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:    H5Pset_chunk_cache_policy
+ *
+ * Purpose:     Sets the replacement policy of the dataset's raw data
+ *              chunk cache.
+ *
+ *              H5D_CHUNK_CACHE_POLICY_LRU (the default) preempts chunks
+ *              in approximate least recently used order, weighted by the
+ *              w0 value set with H5Pset_chunk_cache.
+ *
+ *              H5D_CHUNK_CACHE_POLICY_2Q keeps chunks that are used
+ *              again after dropping out of the cache apart from the
+ *              chunks only used once, so that scans through a dataset
+ *              don't flush the chunks that are read over and over.
+ *              New chunks go into a probationary queue, which is
+ *              preempted first-in first-out once it holds more than a
+ *              quarter of the cache.  The cache remembers the chunks
+ *              recently preempted from the probationary queue, and one
+ *              that is used again while remembered goes into the hot queue,
+ *              which is preempted in least recently used order.  A new
+ *              chunk that would have to displace a hot chunk from its
+ *              hash slot is not cached.  The w0 value is not used.
+ *
+ * Return:      Non-negative on success/Negative on failure
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5Pset_chunk_cache_policy(hid_t plist_id, H5D_chunk_cache_policy_t policy)
+{
+    H5P_genplist_t *plist;      /* Property list pointer */
+    herr_t ret_value = SUCCEED; /* Return value */
+
+    FUNC_ENTER_API(FAIL)
+    H5TRACE2("e", "iDp", plist_id, policy);
+
+    /* Check argument */
+    if((policy != H5D_CHUNK_CACHE_POLICY_LRU) && (policy != H5D_CHUNK_CACHE_POLICY_2Q))
+        HGOTO_ERROR(H5E_ARGS, H5E_BADVALUE, FAIL, "not a valid chunk cache policy")
+
+    /* Get the plist structure */
+    if(NULL == (plist = H5P_object_verify(plist_id, H5P_DATASET_ACCESS)))
+        HGOTO_ERROR(H5E_ATOM, H5E_BADATOM, FAIL, "can't find object for ID")
+
+    /* Update property list */
+    if(H5P_set(plist, H5D_ACS_CHUNK_CACHE_POLICY_NAME, &policy) < 0)
+        HGOTO_ERROR(H5E_PLIST, H5E_CANTSET, FAIL, "unable to set value")
+
+done:
+    FUNC_LEAVE_API(ret_value)
+} /* end H5Pset_chunk_cache_policy() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:    H5Pget_chunk_cache_policy
+ *
+ * Purpose:     Gets the replacement policy of the dataset's raw data
+ *              chunk cache.
+ *
+ * Return:      Non-negative on success/Negative on failure
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5Pget_chunk_cache_policy(hid_t plist_id, H5D_chunk_cache_policy_t *policy/*out*/)
+{
+    H5P_genplist_t *plist;      /* Property list pointer */
+    herr_t ret_value = SUCCEED; /* Return value */
+
+    FUNC_ENTER_API(FAIL)
+    H5TRACE2("e", "ix", plist_id, policy);
+
+    /* Get the plist structure */
+    if(NULL == (plist = H5P_object_verify(plist_id, H5P_DATASET_ACCESS)))
+        HGOTO_ERROR(H5E_ATOM, H5E_BADATOM, FAIL, "can't find object for ID")
+
+    /* Get value from property list */
+    if(policy)
+        if(H5P_get(plist, H5D_ACS_CHUNK_CACHE_POLICY_NAME, policy) < 0)
+            HGOTO_ERROR(H5E_PLIST, H5E_CANTGET, FAIL, "unable to get value")
+
+done:
+    FUNC_LEAVE_API(ret_value)
+} /* end H5Pget_chunk_cache_policy() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:    H5Pset_chunk_addr_table
+ *
+ * Purpose:     Sets whether chunks of the dataset are looked up in an
+ *              in-memory table of chunk addresses instead of the
+ *              dataset's chunk index.
+ *
+ *              When USE_TABLE is TRUE, the whole chunk index is read once,
+ *              the first time a chunk that isn't in the chunk cache is
+ *              looked up, into a table with the address, size and filter
+ *              mask of every chunk in the dataset's current extent.
+ *              Later lookups are served from the table without going
+ *              through the index, which saves the metadata cache accesses
+ *              of B-tree and array index lookups for random reads.  The
+ *              table takes 16 bytes per chunk and is freed when the
+ *              dataset is closed.
+ *
+ *              The table is only used for datasets in files opened
+ *              read-only (and not for SWMR reading), where the chunk
+ *              index can't change while the dataset is open.
+ *
+ *              The default is FALSE.
+ *
+ * Return:      Non-negative on success/Negative on failure
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5Pset_chunk_addr_table(hid_t plist_id, hbool_t use_table)
+{
+    H5P_genplist_t *plist;      /* Property list pointer */
+    herr_t ret_value = SUCCEED; /* Return value */
+
+    FUNC_ENTER_API(FAIL)
+    H5TRACE2("e", "ib", plist_id, use_table);
+
+    /* Get the plist structure */
+    if(NULL == (plist = H5P_object_verify(plist_id, H5P_DATASET_ACCESS)))
+        HGOTO_ERROR(H5E_ATOM, H5E_BADATOM, FAIL, "can't find object for ID")
+
+    /* Update property list */
+    if(H5P_set(plist, H5D_ACS_CHUNK_ADDR_TABLE_NAME, &use_table) < 0)
+        HGOTO_ERROR(H5E_PLIST, H5E_CANTSET, FAIL, "unable to set value")
+
+done:
+    FUNC_LEAVE_API(ret_value)
+} /* end H5Pset_chunk_addr_table() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:    H5Pget_chunk_addr_table
+ *
+ * Purpose:     Gets whether chunks of the dataset are looked up in an
+ *              in-memory table of chunk addresses.
+ *
+ * Return:      Non-negative on success/Negative on failure
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5Pget_chunk_addr_table(hid_t plist_id, hbool_t *use_table/*out*/)
+{
+    H5P_genplist_t *plist;      /* Property list pointer */
+    herr_t ret_value = SUCCEED; /* Return value */
+
+    FUNC_ENTER_API(FAIL)
+    H5TRACE2("e", "ix", plist_id, use_table);
+
+    /* Get the plist structure */
+    if(NULL == (plist = H5P_object_verify(plist_id, H5P_DATASET_ACCESS)))
+        HGOTO_ERROR(H5E_ATOM, H5E_BADATOM, FAIL, "can't find object for ID")
+
+    /* Get value from property list */
+    if(use_table)
+        if(H5P_get(plist, H5D_ACS_CHUNK_ADDR_TABLE_NAME, use_table) < 0)
+            HGOTO_ERROR(H5E_PLIST, H5E_CANTGET, FAIL, "unable to get value")
+
+done:
+    FUNC_LEAVE_API(ret_value)
+} /* end H5Pget_chunk_addr_table() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:    H5Pset_chunk_read_coalesce
+ *
+ * Purpose:     Sets the largest read, in bytes, that the dataset's raw
+ *              data chunk cache may make to bring in several chunks that
+ *              lie next to each other in the file.
+ *
+ *              When MAX_NBYTES is non-zero, reads that select more than
+ *              one chunk load the chunks that aren't cached yet into the
+ *              chunk cache a group at a time.  The chunks in each group
+ *              are sorted by their address in the file, and runs of
+ *              chunks that are stored back to back are read with a
+ *              single I/O request of up to MAX_NBYTES bytes, instead of
+ *              one request per chunk.  Chunks read ahead with
+ *              H5Pset_chunk_readahead are read the same way.  The number
+ *              of chunks loaded at once is also limited by the size of
+ *              the chunk cache.
+ *
+ *              The default of 0 reads each chunk on its own.
+ *
+ * Return:      Non-negative on success/Negative on failure
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5Pset_chunk_read_coalesce(hid_t plist_id, size_t max_nbytes)
+{
+    H5P_genplist_t *plist;      /* Property list pointer */
+    herr_t ret_value = SUCCEED; /* Return value */
+
+    FUNC_ENTER_API(FAIL)
+    H5TRACE2("e", "iz", plist_id, max_nbytes);
+
+    /* Get the plist structure */
+    if(NULL == (plist = H5P_object_verify(plist_id, H5P_DATASET_ACCESS)))
+        HGOTO_ERROR(H5E_ATOM, H5E_BADATOM, FAIL, "can't find object for ID")
+
+    /* Update property list */
+    if(H5P_set(plist, H5D_ACS_CHUNK_READ_COALESCE_NAME, &max_nbytes) < 0)
+        HGOTO_ERROR(H5E_PLIST, H5E_CANTSET, FAIL, "unable to set value")
+
+done:
+    FUNC_LEAVE_API(ret_value)
+} /* end H5Pset_chunk_read_coalesce() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:    H5Pget_chunk_read_coalesce
+ *
+ * Purpose:     Gets the largest read, in bytes, that the dataset's raw
+ *              data chunk cache may make to bring in several chunks that
+ *              lie next to each other in the file.
+ *
+ * Return:      Non-negative on success/Negative on failure
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5Pget_chunk_read_coalesce(hid_t plist_id, size_t *max_nbytes/*out*/)
+{
+    H5P_genplist_t *plist;      /* Property list pointer */
+    herr_t ret_value = SUCCEED; /* Return value */
+
+    FUNC_ENTER_API(FAIL)
+    H5TRACE2("e", "ix", plist_id, max_nbytes);
+
+    /* Get the plist structure */
+    if(NULL == (plist = H5P_object_verify(plist_id, H5P_DATASET_ACCESS)))
+        HGOTO_ERROR(H5E_ATOM, H5E_BADATOM, FAIL, "can't find object for ID")
+
+    /* Get value from property list */
+    if(max_nbytes)
+        if(H5P_get(plist, H5D_ACS_CHUNK_READ_COALESCE_NAME, max_nbytes) < 0)
+            HGOTO_ERROR(H5E_PLIST, H5E_CANTGET, FAIL, "unable to get value")
+
+done:
+    FUNC_LEAVE_API(ret_value)
+} /* end H5Pget_chunk_read_coalesce() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:    H5P__dacc_chunk_cache_policy_enc
+ *
+ * Purpose:     Callback routine which is called whenever the chunk cache
+ *              policy property in the dataset access property list is
+ *              encoded.
+ *
+ * Return:      Success:        Non-negative
+ *              Failure:        Negative
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5P__dacc_chunk_cache_policy_enc(const void *value, void **_pp, size_t *size)
+{
+    const H5D_chunk_cache_policy_t *policy = (const H5D_chunk_cache_policy_t *)value; /* Create local alias for values */
+    uint8_t **pp = (uint8_t **)_pp;
+
+    FUNC_ENTER_STATIC_NOERR
+
+    /* Sanity check */
+    HDassert(policy);
+    HDassert(size);
+
+    if(NULL != *pp)
+        /* Encode chunk cache policy property */
+        *(*pp)++ = (uint8_t)*policy;
+
+    /* Size of chunk cache policy property */
+    (*size)++;
+
+    FUNC_LEAVE_NOAPI(SUCCEED)
+} /* end H5P__dacc_chunk_cache_policy_enc() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:    H5P__dacc_chunk_cache_policy_dec
+ *
+ * Purpose:     Callback routine which is called whenever the chunk cache
+ *              policy property in the dataset access property list is
+ *              decoded.
+ *
+ * Return:      Success:        Non-negative
+ *              Failure:        Negative
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5P__dacc_chunk_cache_policy_dec(const void **_pp, void *_value)
+{
+    H5D_chunk_cache_policy_t *policy = (H5D_chunk_cache_policy_t *)_value;
+    const uint8_t **pp = (const uint8_t **)_pp;
+
+    FUNC_ENTER_STATIC_NOERR
+
+    /* Sanity checks */
+    HDassert(pp);
+    HDassert(*pp);
+    HDassert(policy);
+
+    /* Decode chunk cache policy property */
+    *policy = (H5D_chunk_cache_policy_t)*(*pp)++;
+
+    FUNC_LEAVE_NOAPI(SUCCEED)
+} /* end H5P__dacc_chunk_cache_policy_dec() */
+
@@ -122,6 +122,16 @@
 #define H5D_CRT_MIN_DSET_HDR_SIZE_DEF  FALSE
 #define H5D_CRT_MIN_DSET_HDR_SIZE_ENC  H5P__encode_hbool_t
 #define H5D_CRT_MIN_DSET_HDR_SIZE_DEC  H5P__decode_hbool_t
+/* Definitions for chunk filter mode */
+#define H5D_CRT_CHUNK_FILTER_MODE_SIZE  sizeof(unsigned)
+#define H5D_CRT_CHUNK_FILTER_MODE_DEF   0
+#define H5D_CRT_CHUNK_FILTER_MODE_ENC   H5P__encode_unsigned
+#define H5D_CRT_CHUNK_FILTER_MODE_DEC   H5P__decode_unsigned
+/* Definitions for minimum gain from filtering a chunk */
+#define H5D_CRT_CHUNK_FILTER_MIN_GAIN_SIZE  sizeof(double)
+#define H5D_CRT_CHUNK_FILTER_MIN_GAIN_DEF   0.0
+#define H5D_CRT_CHUNK_FILTER_MIN_GAIN_ENC   H5P__encode_double
+#define H5D_CRT_CHUNK_FILTER_MIN_GAIN_DEC   H5P__decode_double
 
 
 /******************/
@@ -215,6 +225,8 @@ static const H5O_fill_t H5D_def_fill_g = H5D_CRT_FILL_VALUE_DEF;        /* Defau
 static const unsigned H5D_def_alloc_time_state_g = H5D_CRT_ALLOC_TIME_STATE_DEF;  /* Default allocation time state */
 static const H5O_efl_t H5D_def_efl_g = H5D_CRT_EXT_FILE_LIST_DEF;                 /* Default external file list */
 static const unsigned H5O_ohdr_min_g = H5D_CRT_MIN_DSET_HDR_SIZE_DEF; /* Default object header minimization */
+static const unsigned H5D_def_chunk_filter_mode_g = H5D_CRT_CHUNK_FILTER_MODE_DEF; /* Default chunk filter mode */
+static const double H5D_def_chunk_filter_min_gain_g = H5D_CRT_CHUNK_FILTER_MIN_GAIN_DEF; /* Default min. gain from filtering a chunk */
 
 /* Defaults for each type of layout */
 #ifdef H5_HAVE_C99_DESIGNATED_INITIALIZER
@@ -280,6 +292,18 @@ H5P__dcrt_reg_prop(H5P_genclass_t *pclass)
             NULL, NULL, NULL, NULL) < 0)
        HGOTO_ERROR(H5E_PLIST, H5E_CANTINSERT, FAIL, "can't insert property into class")
 
+    /* Register the chunk filter mode property */
+    if(H5P__register_real(pclass, H5D_CRT_CHUNK_FILTER_MODE_NAME, H5D_CRT_CHUNK_FILTER_MODE_SIZE, &H5D_def_chunk_filter_mode_g,
+            NULL, NULL, NULL, H5D_CRT_CHUNK_FILTER_MODE_ENC, H5D_CRT_CHUNK_FILTER_MODE_DEC,
+            NULL, NULL, NULL, NULL) < 0)
+       HGOTO_ERROR(H5E_PLIST, H5E_CANTINSERT, FAIL, "can't insert property into class")
+
+    /* Register the minimum gain from filtering a chunk property */
+    if(H5P__register_real(pclass, H5D_CRT_CHUNK_FILTER_MIN_GAIN_NAME, H5D_CRT_CHUNK_FILTER_MIN_GAIN_SIZE, &H5D_def_chunk_filter_min_gain_g,
+            NULL, NULL, NULL, H5D_CRT_CHUNK_FILTER_MIN_GAIN_ENC, H5D_CRT_CHUNK_FILTER_MIN_GAIN_DEC,
+            NULL, NULL, NULL, NULL) < 0)
+       HGOTO_ERROR(H5E_PLIST, H5E_CANTINSERT, FAIL, "can't insert property into class")
+
 done:
     FUNC_LEAVE_NOAPI(ret_value)
 } /* end H5P__dcrt_reg_prop() */
@@ -2732,6 +2756,115 @@ done:
     FUNC_LEAVE_API(ret_value)
 } /* end H5Pget_chunk_opts() */
 
+
+/*-------------------------------------------------------------------------
+ * Function:    H5Pset_chunk_filter_mode
+ *
+ * Purpose:     Sets how the filter pipeline is applied to the chunks of a
+ *              dataset.  The storage must already be set to chunked.
+ *
+ *              With H5D_CHUNK_FILTER_ADAPTIVE set in MODE, each chunk is
+ *              run through the pipeline as usual, but when the optional
+ *              filters shrink it by less than the fraction MIN_GAIN of
+ *              its size, the chunk is stored with the optional filters
+ *              skipped instead, which is recorded in the chunk's filter
+ *              mask.  Mandatory filters (like Fletcher32) are always
+ *              applied.
+ *
+ *              With H5D_CHUNK_SKIP_FILL_CHUNKS set in MODE, new chunks
+ *              that hold nothing but the fill value aren't written to the
+ *              file when they are flushed from the chunk cache, as long
+ *              as reading an unwritten chunk returns the fill value.
+ *
+ *              The mode isn't stored in the file; it applies to the
+ *              dataset opened by the H5Dcreate call using the property
+ *              list.
+ *
+ * Return:      Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5Pset_chunk_filter_mode(hid_t plist_id, unsigned mode, double min_gain)
+{
+    H5P_genplist_t      *plist;         /* Property list pointer */
+    H5O_layout_t        layout;         /* Layout information */
+    herr_t              ret_value = SUCCEED; /* Return value */
+
+    FUNC_ENTER_API(FAIL)
+    H5TRACE3("e", "iIud", plist_id, mode, min_gain);
+
+    /* Check arguments */
+    if(mode & ~(H5D_CHUNK_FILTER_ADAPTIVE | H5D_CHUNK_SKIP_FILL_CHUNKS))
+        HGOTO_ERROR(H5E_ARGS, H5E_BADRANGE, FAIL, "unknown chunk filter mode")
+    if(!(min_gain >= 0.0 && min_gain < 1.0))
+        HGOTO_ERROR(H5E_ARGS, H5E_BADRANGE, FAIL, "minimum gain must be in the range [0, 1)")
+
+#ifndef H5_HAVE_C99_DESIGNATED_INITIALIZER
+    /* If the compiler doesn't support C99 designated initializers, check if
+     *  the default layout structs have been initialized yet or not.  *ick* -QAK
+     */
+    if(!H5P_dcrt_def_layout_init_g)
+        if(H5P__init_def_layout() < 0)
+            HGOTO_ERROR(H5E_PLIST, H5E_CANTINIT, FAIL, "can't initialize default layout info")
+#endif /* H5_HAVE_C99_DESIGNATED_INITIALIZER */
+
+    /* Get the plist structure */
+    if(NULL == (plist = H5P_object_verify(plist_id, H5P_DATASET_CREATE)))
+        HGOTO_ERROR(H5E_ATOM, H5E_BADATOM, FAIL, "can't find object for ID")
+
+    /* Retrieve the layout property */
+    if(H5P_peek(plist, H5D_CRT_LAYOUT_NAME, &layout) < 0)
+        HGOTO_ERROR(H5E_PLIST, H5E_BADVALUE, FAIL, "can't get layout")
+    if(H5D_CHUNKED != layout.type)
+        HGOTO_ERROR(H5E_ARGS, H5E_BADVALUE, FAIL, "not a chunked storage layout")
+
+    /* Set the values */
+    if(H5P_set(plist, H5D_CRT_CHUNK_FILTER_MODE_NAME, &mode) < 0)
+        HGOTO_ERROR(H5E_PLIST, H5E_CANTSET, FAIL, "can't set chunk filter mode")
+    if(H5P_set(plist, H5D_CRT_CHUNK_FILTER_MIN_GAIN_NAME, &min_gain) < 0)
+        HGOTO_ERROR(H5E_PLIST, H5E_CANTSET, FAIL, "can't set minimum gain")
+
+done:
+    FUNC_LEAVE_API(ret_value)
+} /* end H5Pset_chunk_filter_mode() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:    H5Pget_chunk_filter_mode
+ *
+ * Purpose:     Gets how the filter pipeline is applied to the chunks of a
+ *              dataset, as set with H5Pset_chunk_filter_mode().
+ *
+ * Return:      Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5Pget_chunk_filter_mode(hid_t plist_id, unsigned *mode, double *min_gain)
+{
+    H5P_genplist_t      *plist;         /* Property list pointer */
+    herr_t              ret_value = SUCCEED; /* Return value */
+
+    FUNC_ENTER_API(FAIL)
+    H5TRACE3("e", "i*Iu*d", plist_id, mode, min_gain);
+
+    /* Get the plist structure */
+    if(NULL == (plist = H5P_object_verify(plist_id, H5P_DATASET_CREATE)))
+        HGOTO_ERROR(H5E_ATOM, H5E_BADATOM, FAIL, "can't find object for ID")
+
+    /* Get the values */
+    if(mode)
+        if(H5P_get(plist, H5D_CRT_CHUNK_FILTER_MODE_NAME, mode) < 0)
+            HGOTO_ERROR(H5E_PLIST, H5E_CANTGET, FAIL, "can't get chunk filter mode")
+    if(min_gain)
+        if(H5P_get(plist, H5D_CRT_CHUNK_FILTER_MIN_GAIN_NAME, min_gain) < 0)
+            HGOTO_ERROR(H5E_PLIST, H5E_CANTGET, FAIL, "can't get minimum gain")
+
+done:
+    FUNC_LEAVE_API(ret_value)
+} /* end H5Pget_chunk_filter_mode() */
+
 
 /*-------------------------------------------------------------------------
  * Function:	H5Pset_external
@@ -3047,6 +3180,106 @@ done:
     FUNC_LEAVE_API(ret_value)
 } /* end H5Pset_shuffle() */
 
+
+/*-------------------------------------------------------------------------
+ * Function:	H5Pset_bitshuffle
+ *
+ * Purpose:	Adds the bitshuffle filter, H5Z_FILTER_BITSHUFFLE, to the
+ *		pipeline.  The bits of the elements are transposed in
+ *		blocks of BLOCK_SIZE elements, which must be a multiple of
+ *		8, or zero to let the filter pick a block size from the
+ *		size of the datatype.
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5Pset_bitshuffle(hid_t plist_id, unsigned block_size)
+{
+    H5O_pline_t         pline;
+    H5P_genplist_t *plist;      /* Property list pointer */
+    unsigned cd_values[H5Z_BITSHUFFLE_USER_NPARMS] = {0, 0, 0, 0};  /* Filter parameters */
+    herr_t ret_value=SUCCEED;   /* return value */
+
+    FUNC_ENTER_API(FAIL)
+    H5TRACE2("e", "iIu", plist_id, block_size);
+
+    /* Check arguments */
+    if(TRUE != H5P_isa_class(plist_id, H5P_DATASET_CREATE))
+        HGOTO_ERROR(H5E_ARGS, H5E_BADTYPE, FAIL, "not a dataset creation property list")
+    if(block_size % 8)
+        HGOTO_ERROR(H5E_ARGS, H5E_BADVALUE, FAIL, "block size must be a multiple of 8")
+
+    /* Get the plist structure */
+    if(NULL == (plist = (H5P_genplist_t *)H5I_object(plist_id)))
+        HGOTO_ERROR(H5E_ATOM, H5E_BADATOM, FAIL, "can't find object for ID")
+
+    /* Only the block size is the user's; the rest are set for each dataset */
+    cd_values[H5Z_BITSHUFFLE_USER_NPARMS - 1] = block_size;
+
+    /* Add the filter */
+    if(H5P_peek(plist, H5O_CRT_PIPELINE_NAME, &pline) < 0)
+        HGOTO_ERROR(H5E_PLIST, H5E_CANTGET, FAIL, "can't get pipeline")
+    if(H5Z_append(&pline, H5Z_FILTER_BITSHUFFLE, H5Z_FLAG_OPTIONAL, (size_t)H5Z_BITSHUFFLE_USER_NPARMS, cd_values) < 0)
+        HGOTO_ERROR(H5E_PLINE, H5E_CANTINIT, FAIL, "unable to add bitshuffle filter to pipeline")
+    if(H5P_poke(plist, H5O_CRT_PIPELINE_NAME, &pline) < 0)
+        HGOTO_ERROR(H5E_PLINE, H5E_CANTINIT, FAIL, "unable to set pipeline")
+
+done:
+    FUNC_LEAVE_API(ret_value)
+} /* end H5Pset_bitshuffle() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5Pset_lz4
+ *
+ * Purpose:	Sets the compression method for a permanent filter to
+ *		H5Z_FILTER_LZ4.  ACCELERATION trades compression for speed:
+ *		1 (or 0) compresses the most, and each step up to
+ *		H5Z_LZ4_MAX_ACCELERATION gives up a little compression to
+ *		run faster.  Decompression speed doesn't depend on it.
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5Pset_lz4(hid_t plist_id, unsigned acceleration)
+{
+    H5O_pline_t         pline;
+    H5P_genplist_t *plist;      /* Property list pointer */
+    unsigned cd_values[H5Z_LZ4_USER_NPARMS] = {0, 0};   /* Filter parameters */
+    herr_t ret_value=SUCCEED;   /* return value */
+
+    FUNC_ENTER_API(FAIL)
+    H5TRACE2("e", "iIu", plist_id, acceleration);
+
+    /* Check arguments */
+    if(TRUE != H5P_isa_class(plist_id, H5P_DATASET_CREATE))
+        HGOTO_ERROR(H5E_ARGS, H5E_BADTYPE, FAIL, "not a dataset creation property list")
+    if(acceleration > H5Z_LZ4_MAX_ACCELERATION)
+        HGOTO_ERROR(H5E_ARGS, H5E_BADVALUE, FAIL, "invalid acceleration")
+
+    /* Get the plist structure */
+    if(NULL == (plist = (H5P_genplist_t *)H5I_object(plist_id)))
+        HGOTO_ERROR(H5E_ATOM, H5E_BADATOM, FAIL, "can't find object for ID")
+
+    /* The block size is left to the filter's default: the whole chunk */
+    cd_values[1] = acceleration;
+
+    /* Add the filter */
+    if(H5P_peek(plist, H5O_CRT_PIPELINE_NAME, &pline) < 0)
+        HGOTO_ERROR(H5E_PLIST, H5E_CANTGET, FAIL, "can't get pipeline")
+    if(H5Z_append(&pline, H5Z_FILTER_LZ4, H5Z_FLAG_OPTIONAL, (size_t)H5Z_LZ4_USER_NPARMS, cd_values) < 0)
+        HGOTO_ERROR(H5E_PLINE, H5E_CANTINIT, FAIL, "unable to add lz4 filter to pipeline")
+    if(H5P_poke(plist, H5O_CRT_PIPELINE_NAME, &pline) < 0)
+        HGOTO_ERROR(H5E_PLINE, H5E_CANTINIT, FAIL, "unable to set pipeline")
+
+done:
+    FUNC_LEAVE_API(ret_value)
+} /* end H5Pset_lz4() */
+
 
 /*-------------------------------------------------------------------------
  * Function:    H5Pset_nbit
@@ -152,6 +152,16 @@
 #define H5D_XFER_XFORM_COPY         H5P__dxfr_xform_copy
 #define H5D_XFER_XFORM_CMP          H5P__dxfr_xform_cmp
 #define H5D_XFER_XFORM_CLOSE        H5P__dxfr_xform_close
+/* Definitions for chunk decode threads property */
+#define H5D_XFER_CHUNK_DECODE_NTHREADS_SIZE sizeof(unsigned)
+#define H5D_XFER_CHUNK_DECODE_NTHREADS_DEF  1
+#define H5D_XFER_CHUNK_DECODE_NTHREADS_ENC  H5P__encode_unsigned
+#define H5D_XFER_CHUNK_DECODE_NTHREADS_DEC  H5P__decode_unsigned
+/* Definitions for deflate threads property */
+#define H5D_XFER_DEFLATE_NTHREADS_SIZE      sizeof(unsigned)
+#define H5D_XFER_DEFLATE_NTHREADS_DEF       1
+#define H5D_XFER_DEFLATE_NTHREADS_ENC       H5P__encode_unsigned
+#define H5D_XFER_DEFLATE_NTHREADS_DEC       H5P__decode_unsigned
 
 
 /******************/
@@ -250,6 +260,8 @@ static const H5Z_EDC_t H5D_def_enable_edc_g = H5D_XFER_EDC_DEF;            /* De
 static const H5Z_cb_t H5D_def_filter_cb_g = H5D_XFER_FILTER_CB_DEF;        /* Default value for filter callback */
 static const H5T_conv_cb_t H5D_def_conv_cb_g = H5D_XFER_CONV_CB_DEF;       /* Default value for datatype conversion callback */
 static const void *H5D_def_xfer_xform_g = H5D_XFER_XFORM_DEF;          /* Default value for data transform */
+static const unsigned H5D_def_chunk_decode_nthreads_g = H5D_XFER_CHUNK_DECODE_NTHREADS_DEF; /* Default value for chunk decode threads */
+static const unsigned H5D_def_deflate_nthreads_g = H5D_XFER_DEFLATE_NTHREADS_DEF; /* Default value for deflate threads */
 
 
 /*-------------------------------------------------------------------------
@@ -400,6 +412,18 @@ H5P__dxfr_reg_prop(H5P_genclass_t *pclass)
             H5D_XFER_XFORM_DEL, H5D_XFER_XFORM_COPY, H5D_XFER_XFORM_CMP, H5D_XFER_XFORM_CLOSE) < 0)
         HGOTO_ERROR(H5E_PLIST, H5E_CANTINSERT, FAIL, "can't insert property into class")
 
+    /* Register the chunk decode threads property */
+    if(H5P__register_real(pclass, H5D_XFER_CHUNK_DECODE_NTHREADS_NAME, H5D_XFER_CHUNK_DECODE_NTHREADS_SIZE, &H5D_def_chunk_decode_nthreads_g,
+            NULL, NULL, NULL, H5D_XFER_CHUNK_DECODE_NTHREADS_ENC, H5D_XFER_CHUNK_DECODE_NTHREADS_DEC,
+            NULL, NULL, NULL, NULL) < 0)
+        HGOTO_ERROR(H5E_PLIST, H5E_CANTINSERT, FAIL, "can't insert property into class")
+
+    /* Register the deflate threads property */
+    if(H5P__register_real(pclass, H5D_XFER_DEFLATE_NTHREADS_NAME, H5D_XFER_DEFLATE_NTHREADS_SIZE, &H5D_def_deflate_nthreads_g,
+            NULL, NULL, NULL, H5D_XFER_DEFLATE_NTHREADS_ENC, H5D_XFER_DEFLATE_NTHREADS_DEC,
+            NULL, NULL, NULL, NULL) < 0)
+        HGOTO_ERROR(H5E_PLIST, H5E_CANTINSERT, FAIL, "can't insert property into class")
+
 done:
     FUNC_LEAVE_NOAPI(ret_value)
 } /* end H5P__dxfr_reg_prop() */
@@ -1726,6 +1750,173 @@ done:
     FUNC_LEAVE_API(ret_value)
 } /* end H5Pget_hyper_vector_size() */
 
+
+/*-------------------------------------------------------------------------
+ * Function:	H5Pset_chunk_decode_nthreads
+ *
+ * Purpose:	Given a dataset transfer property list, set the number of
+ *              threads used to run the filter pipeline on the chunks read
+ *              by a single H5Dread call.  When more than one thread is
+ *              requested, the filtered chunks touched by the read that
+ *              are not already in the raw data chunk cache are read from
+ *              the file first and then decoded concurrently, before the
+ *              data is scattered into the application's buffer.
+ *
+ *              The decoded chunks are staged in the dataset's chunk cache,
+ *              so the number of chunks decoded together is limited by the
+ *              size of the cache (see H5Pset_chunk_cache).  The setting
+ *              only has an effect when the library is built thread-safe,
+ *              and only when all the dataset's filters are ones the
+ *              library provides and no filter callback is set (see
+ *              H5Pset_filter_callback); otherwise the chunks are decoded
+ *              serially.
+ *
+ *		The default is to use a single thread.
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5Pset_chunk_decode_nthreads(hid_t plist_id, unsigned nthreads)
+{
+    H5P_genplist_t *plist;      /* Property list pointer */
+    herr_t ret_value = SUCCEED; /* Return value */
+
+    FUNC_ENTER_API(FAIL)
+    H5TRACE2("e", "iIu", plist_id, nthreads);
+
+    /* Check arguments */
+    if(nthreads < 1)
+        HGOTO_ERROR(H5E_ARGS, H5E_BADVALUE, FAIL, "number of threads must be at least 1")
+
+    /* Get the plist structure */
+    if(NULL == (plist = H5P_object_verify(plist_id, H5P_DATASET_XFER)))
+        HGOTO_ERROR(H5E_ATOM, H5E_BADATOM, FAIL, "can't find object for ID")
+
+    /* Update property list */
+    if(H5P_set(plist, H5D_XFER_CHUNK_DECODE_NTHREADS_NAME, &nthreads) < 0)
+        HGOTO_ERROR(H5E_PLIST, H5E_CANTSET, FAIL, "unable to set value")
+
+done:
+    FUNC_LEAVE_API(ret_value)
+} /* end H5Pset_chunk_decode_nthreads() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5Pget_chunk_decode_nthreads
+ *
+ * Purpose:	Reads the value previously set with
+ *              H5Pset_chunk_decode_nthreads().
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5Pget_chunk_decode_nthreads(hid_t plist_id, unsigned *nthreads/*out*/)
+{
+    H5P_genplist_t *plist;      /* Property list pointer */
+    herr_t ret_value = SUCCEED; /* Return value */
+
+    FUNC_ENTER_API(FAIL)
+    H5TRACE2("e", "ix", plist_id, nthreads);
+
+    /* Get the plist structure */
+    if(NULL == (plist = H5P_object_verify(plist_id, H5P_DATASET_XFER)))
+        HGOTO_ERROR(H5E_ATOM, H5E_BADATOM, FAIL, "can't find object for ID")
+
+    /* Return values */
+    if(nthreads)
+        if(H5P_get(plist, H5D_XFER_CHUNK_DECODE_NTHREADS_NAME, nthreads) < 0)
+            HGOTO_ERROR(H5E_PLIST, H5E_CANTGET, FAIL, "unable to get value")
+
+done:
+    FUNC_LEAVE_API(ret_value)
+} /* end H5Pget_chunk_decode_nthreads() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5Pset_deflate_nthreads
+ *
+ * Purpose:	Given a dataset transfer property list, set the number of
+ *              threads the deflate filter uses to compress each chunk
+ *              written by calls that use the property list.  With more
+ *              than one thread, chunks larger than a block of 1 MB are
+ *              split into blocks that are compressed concurrently and
+ *              joined into a single zlib stream, which any zlib (and so
+ *              any version of the library) can decompress.
+ *
+ *              Chunks that are still in the chunk cache when the dataset
+ *              is flushed or closed are compressed with a single thread.
+ *              The setting only has an effect when the library is built
+ *              thread-safe, and it doesn't change how chunks are
+ *              decompressed.
+ *
+ *		The default is to use a single thread.
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5Pset_deflate_nthreads(hid_t plist_id, unsigned nthreads)
+{
+    H5P_genplist_t *plist;      /* Property list pointer */
+    herr_t ret_value = SUCCEED; /* Return value */
+
+    FUNC_ENTER_API(FAIL)
+    H5TRACE2("e", "iIu", plist_id, nthreads);
+
+    /* Check arguments */
+    if(nthreads < 1)
+        HGOTO_ERROR(H5E_ARGS, H5E_BADVALUE, FAIL, "number of threads must be at least 1")
+
+    /* Get the plist structure */
+    if(NULL == (plist = H5P_object_verify(plist_id, H5P_DATASET_XFER)))
+        HGOTO_ERROR(H5E_ATOM, H5E_BADATOM, FAIL, "can't find object for ID")
+
+    /* Update property list */
+    if(H5P_set(plist, H5D_XFER_DEFLATE_NTHREADS_NAME, &nthreads) < 0)
+        HGOTO_ERROR(H5E_PLIST, H5E_CANTSET, FAIL, "unable to set value")
+
+done:
+    FUNC_LEAVE_API(ret_value)
+} /* end H5Pset_deflate_nthreads() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5Pget_deflate_nthreads
+ *
+ * Purpose:	Reads the value previously set with
+ *              H5Pset_deflate_nthreads().
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5Pget_deflate_nthreads(hid_t plist_id, unsigned *nthreads/*out*/)
+{
+    H5P_genplist_t *plist;      /* Property list pointer */
+    herr_t ret_value = SUCCEED; /* Return value */
+
+    FUNC_ENTER_API(FAIL)
+    H5TRACE2("e", "ix", plist_id, nthreads);
+
+    /* Get the plist structure */
+    if(NULL == (plist = H5P_object_verify(plist_id, H5P_DATASET_XFER)))
+        HGOTO_ERROR(H5E_ATOM, H5E_BADATOM, FAIL, "can't find object for ID")
+
+    /* Return values */
+    if(nthreads)
+        if(H5P_get(plist, H5D_XFER_DEFLATE_NTHREADS_NAME, nthreads) < 0)
+            HGOTO_ERROR(H5E_PLIST, H5E_CANTGET, FAIL, "unable to get value")
+
+done:
+    FUNC_LEAVE_API(ret_value)
+} /* end H5Pget_deflate_nthreads() */
+
 
 /*-------------------------------------------------------------------------
  * Function:       H5P__dxfr_io_xfer_mode_enc
@@ -78,6 +78,11 @@
 #define H5F_ACS_PREEMPT_READ_CHUNKS_DEF         0.75f
 #define H5F_ACS_PREEMPT_READ_CHUNKS_ENC         H5P__encode_double
 #define H5F_ACS_PREEMPT_READ_CHUNKS_DEC         H5P__decode_double
+/* Definition for file-wide raw data chunk cache budget (bytes) */
+#define H5F_ACS_DATA_CACHE_BUDGET_SIZE          sizeof(size_t)
+#define H5F_ACS_DATA_CACHE_BUDGET_DEF           0
+#define H5F_ACS_DATA_CACHE_BUDGET_ENC           H5P__encode_size_t
+#define H5F_ACS_DATA_CACHE_BUDGET_DEC           H5P__decode_size_t
 /* Definition for threshold for alignment */
 #define H5F_ACS_ALIGN_THRHD_SIZE                sizeof(hsize_t)
 #define H5F_ACS_ALIGN_THRHD_DEF                 H5F_ALIGN_THRHD_DEF
@@ -409,6 +414,7 @@ static const H5AC_cache_config_t H5F_def_mdc_initCacheCfg_g = H5F_ACS_META_CACHE
 static const size_t H5F_def_rdcc_nslots_g = H5F_ACS_DATA_CACHE_NUM_SLOTS_DEF;      /* Default raw data chunk cache # of slots */
 static const size_t H5F_def_rdcc_nbytes_g = H5F_ACS_DATA_CACHE_BYTE_SIZE_DEF;      /* Default raw data chunk cache # of bytes */
 static const double H5F_def_rdcc_w0_g = H5F_ACS_PREEMPT_READ_CHUNKS_DEF;           /* Default raw data chunk cache dirty ratio */
+static const size_t H5F_def_rdcc_budget_g = H5F_ACS_DATA_CACHE_BUDGET_DEF;         /* Default file-wide raw data chunk cache budget */
 static const hsize_t H5F_def_threshold_g = H5F_ACS_ALIGN_THRHD_DEF;                /* Default allocation alignment threshold */
 static const hsize_t H5F_def_alignment_g = H5F_ACS_ALIGN_DEF;                      /* Default allocation alignment value */
 static const hsize_t H5F_def_meta_block_size_g = H5F_ACS_META_BLOCK_SIZE_DEF;      /* Default metadata allocation block size */
@@ -705,6 +711,12 @@ H5P__facc_reg_prop(H5P_genclass_t *pclass)
             H5F_ACS_VOL_CONN_DEL, H5F_ACS_VOL_CONN_COPY, H5F_ACS_VOL_CONN_CMP, H5F_ACS_VOL_CONN_CLOSE) < 0)
         HGOTO_ERROR(H5E_PLIST, H5E_CANTINSERT, FAIL, "can't insert property into class")
 
+    /* Register the file-wide raw data chunk cache budget */
+    if(H5P__register_real(pclass, H5F_ACS_DATA_CACHE_BUDGET_NAME, H5F_ACS_DATA_CACHE_BUDGET_SIZE, &H5F_def_rdcc_budget_g,
+            NULL, NULL, NULL, H5F_ACS_DATA_CACHE_BUDGET_ENC, H5F_ACS_DATA_CACHE_BUDGET_DEC,
+            NULL, NULL, NULL, NULL) < 0)
+        HGOTO_ERROR(H5E_PLIST, H5E_CANTINSERT, FAIL, "can't insert property into class")
+
 done:
     FUNC_LEAVE_NOAPI(ret_value)
 } /* end H5P__facc_reg_prop() */
@@ -1681,6 +1693,85 @@ done:
     FUNC_LEAVE_API(ret_value)
 } /* end H5Pget_cache() */
 
+
+/*-------------------------------------------------------------------------
+ * Function:    H5Pset_chunk_cache_budget
+ *
+ * Purpose:     Set the maximum number of bytes of raw data that the chunk
+ *              caches of all the datasets open in a file may hold together.
+ *
+ *              Each dataset's chunk cache is still limited by its own size
+ *              (set with H5Pset_cache or H5Pset_chunk_cache), but when the
+ *              caches together would go over the budget, the least
+ *              recently used chunks in the file are preempted first,
+ *              whichever dataset they belong to.  (Modified chunks of
+ *              other datasets are not preempted, but are left for their
+ *              own dataset to write out, so the budget may be exceeded
+ *              while they're held.)  To let the datasets in use take as
+ *              much of the budget as they need, set their own cache sizes
+ *              to the budget as well.
+ *
+ *              The default of 0 means no file-wide limit.
+ *
+ * Return:      Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5Pset_chunk_cache_budget(hid_t plist_id, size_t nbytes)
+{
+    H5P_genplist_t *plist;      /* Property list pointer */
+    herr_t ret_value = SUCCEED;   /* return value */
+
+    FUNC_ENTER_API(FAIL)
+    H5TRACE2("e", "iz", plist_id, nbytes);
+
+    /* Get the plist structure */
+    if(NULL == (plist = H5P_object_verify(plist_id,H5P_FILE_ACCESS)))
+        HGOTO_ERROR(H5E_ATOM, H5E_BADATOM, FAIL, "can't find object for ID")
+
+    /* Set size */
+    if(H5P_set(plist, H5F_ACS_DATA_CACHE_BUDGET_NAME, &nbytes) < 0)
+        HGOTO_ERROR(H5E_PLIST, H5E_CANTSET,FAIL, "can't set data cache budget")
+
+done:
+    FUNC_LEAVE_API(ret_value)
+} /* end H5Pset_chunk_cache_budget() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:    H5Pget_chunk_cache_budget
+ *
+ * Purpose:     Retrieves the maximum number of bytes of raw data that the
+ *              chunk caches of all the datasets open in a file may hold
+ *              together.
+ *
+ * Return:      Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5Pget_chunk_cache_budget(hid_t plist_id, size_t *nbytes/*out*/)
+{
+    H5P_genplist_t *plist;      /* Property list pointer */
+    herr_t ret_value = SUCCEED;   /* return value */
+
+    FUNC_ENTER_API(FAIL)
+    H5TRACE2("e", "ix", plist_id, nbytes);
+
+    /* Get the plist structure */
+    if(NULL == (plist = H5P_object_verify(plist_id,H5P_FILE_ACCESS)))
+        HGOTO_ERROR(H5E_ATOM, H5E_BADATOM, FAIL, "can't find object for ID")
+
+    /* Get size */
+    if(nbytes)
+        if(H5P_get(plist, H5F_ACS_DATA_CACHE_BUDGET_NAME, nbytes) < 0)
+            HGOTO_ERROR(H5E_PLIST, H5E_CANTGET,FAIL, "can't get data cache budget")
+
+done:
+    FUNC_LEAVE_API(ret_value)
+} /* end H5Pget_chunk_cache_budget() */
+
 
 /*-------------------------------------------------------------------------
  * Function:    H5Pset_mdc_image_config
@@ -344,6 +344,8 @@ H5_DLL herr_t H5Pget_cache(hid_t plist_id,
        int *mdc_nelmts, /* out */
        size_t *rdcc_nslots/*out*/,
        size_t *rdcc_nbytes/*out*/, double *rdcc_w0);
+H5_DLL herr_t H5Pset_chunk_cache_budget(hid_t plist_id, size_t nbytes);
+H5_DLL herr_t H5Pget_chunk_cache_budget(hid_t plist_id, size_t *nbytes/*out*/);
 H5_DLL herr_t H5Pset_mdc_config(hid_t    plist_id,
        H5AC_cache_config_t * config_ptr);
 H5_DLL herr_t H5Pget_mdc_config(hid_t     plist_id,
@@ -411,12 +413,16 @@ H5_DLL herr_t H5Pset_external(hid_t plist_id, const char *name, off_t offset,
           hsize_t size);
 H5_DLL herr_t H5Pset_chunk_opts(hid_t plist_id, unsigned opts);
 H5_DLL herr_t H5Pget_chunk_opts(hid_t plist_id, unsigned *opts);
+H5_DLL herr_t H5Pset_chunk_filter_mode(hid_t plist_id, unsigned mode, double min_gain);
+H5_DLL herr_t H5Pget_chunk_filter_mode(hid_t plist_id, unsigned *mode, double *min_gain);
 H5_DLL int H5Pget_external_count(hid_t plist_id);
 H5_DLL herr_t H5Pget_external(hid_t plist_id, unsigned idx, size_t name_size,
           char *name/*out*/, off_t *offset/*out*/,
           hsize_t *size/*out*/);
 H5_DLL herr_t H5Pset_szip(hid_t plist_id, unsigned options_mask, unsigned pixels_per_block);
 H5_DLL herr_t H5Pset_shuffle(hid_t plist_id);
+H5_DLL herr_t H5Pset_bitshuffle(hid_t plist_id, unsigned block_size);
+H5_DLL herr_t H5Pset_lz4(hid_t plist_id, unsigned acceleration);
 H5_DLL herr_t H5Pset_nbit(hid_t plist_id);
 H5_DLL herr_t H5Pset_scaleoffset(hid_t plist_id, H5Z_SO_scale_type_t scale_type, int scale_factor);
 H5_DLL herr_t H5Pset_fill_value(hid_t plist_id, hid_t type_id,
@@ -453,6 +459,16 @@ H5_DLL herr_t H5Pget_append_flush(hid_t plist_id, unsigned dims,
     hsize_t boundary[], H5D_append_cb_t *func, void **udata);
 H5_DLL herr_t H5Pset_efile_prefix(hid_t dapl_id, const char* prefix);
 H5_DLL ssize_t H5Pget_efile_prefix(hid_t dapl_id, char* prefix /*out*/, size_t size);
+H5_DLL herr_t H5Pset_chunk_encode_nthreads(hid_t plist_id, unsigned nthreads);
+H5_DLL herr_t H5Pget_chunk_encode_nthreads(hid_t plist_id, unsigned *nthreads/*out*/);
+H5_DLL herr_t H5Pset_chunk_readahead(hid_t plist_id, unsigned nchunks);
+H5_DLL herr_t H5Pget_chunk_readahead(hid_t plist_id, unsigned *nchunks/*out*/);
+H5_DLL herr_t H5Pset_chunk_cache_policy(hid_t plist_id, H5D_chunk_cache_policy_t policy);
+H5_DLL herr_t H5Pget_chunk_cache_policy(hid_t plist_id, H5D_chunk_cache_policy_t *policy/*out*/);
+H5_DLL herr_t H5Pset_chunk_addr_table(hid_t plist_id, hbool_t use_table);
+H5_DLL herr_t H5Pget_chunk_addr_table(hid_t plist_id, hbool_t *use_table/*out*/);
+H5_DLL herr_t H5Pset_chunk_read_coalesce(hid_t plist_id, size_t max_nbytes);
+H5_DLL herr_t H5Pget_chunk_read_coalesce(hid_t plist_id, size_t *max_nbytes/*out*/);
 
 /* Dataset xfer property list (DXPL) routines */
 H5_DLL herr_t H5Pset_data_transform(hid_t plist_id, const char* expression);
@@ -485,6 +501,10 @@ H5_DLL herr_t H5Pset_hyper_vector_size(hid_t fapl_id, size_t size);
 H5_DLL herr_t H5Pget_hyper_vector_size(hid_t fapl_id, size_t *size/*out*/);
 H5_DLL herr_t H5Pset_type_conv_cb(hid_t dxpl_id, H5T_conv_except_func_t op, void* operate_data);
 H5_DLL herr_t H5Pget_type_conv_cb(hid_t dxpl_id, H5T_conv_except_func_t *op, void** operate_data);
+H5_DLL herr_t H5Pset_chunk_decode_nthreads(hid_t plist_id, unsigned nthreads);
+H5_DLL herr_t H5Pget_chunk_decode_nthreads(hid_t plist_id, unsigned *nthreads/*out*/);
+H5_DLL herr_t H5Pset_deflate_nthreads(hid_t plist_id, unsigned nthreads);
+H5_DLL herr_t H5Pget_deflate_nthreads(hid_t plist_id, unsigned *nthreads/*out*/);
 #ifdef H5_HAVE_PARALLEL
 H5_DLL herr_t H5Pget_mpio_actual_chunk_opt_mode(hid_t plist_id, H5D_mpio_actual_chunk_opt_mode_t *actual_chunk_opt_mode);
 H5_DLL herr_t H5Pget_mpio_actual_io_mode(hid_t plist_id, H5D_mpio_actual_io_mode_t *actual_io_mode);
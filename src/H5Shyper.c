@@ -12213,6 +12213,68 @@ done:
 } /* end H5S_hyper_get_first_inc_block */
 
 
+/*--------------------------------------------------------------------------
+ NAME
+    H5S_hyper_get_regular
+ PURPOSE
+    Retrieve the parameters of a regular hyperslab selection, if it is one
+ USAGE
+    htri_t H5S_hyper_get_regular(space, start, stride, count, block)
+        const H5S_t *space;     IN: Dataspace to query
+        hsize_t start[];        OUT: Offset of start of hyperslab
+        hsize_t stride[];       OUT: Hyperslab stride
+        hsize_t count[];        OUT: Number of blocks included in hyperslab
+        hsize_t block[];        OUT: Size of block in hyperslab
+ RETURNS
+    TRUE if the selection is a regular hyperslab (and the parameters were
+    retrieved), FALSE if it isn't (can't fail)
+ DESCRIPTION
+    Retrieves the start/stride/count/block of the optimized form of a
+    regular hyperslab selection, with the selection offset applied to the
+    starts.  The stride of a dimension with a single block is set to the
+    block size, so that the blocks never overlap.
+ GLOBAL VARIABLES
+ COMMENTS, BUGS, ASSUMPTIONS
+    Unlimited selections aren't reported as regular.
+ EXAMPLES
+ REVISION LOG
+--------------------------------------------------------------------------*/
+htri_t
+H5S_hyper_get_regular(const H5S_t *space, hsize_t start[], hsize_t stride[],
+    hsize_t count[], hsize_t block[])
+{
+    const H5S_hyper_dim_t *diminfo;     /* Convenience pointer to diminfo.opt */
+    unsigned u;                 /* Local index variable */
+    htri_t ret_value = TRUE;    /* Return value */
+
+    FUNC_ENTER_NOAPI_NOINIT_NOERR
+
+    /* Check args */
+    HDassert(space);
+    HDassert(start);
+    HDassert(stride);
+    HDassert(count);
+    HDassert(block);
+
+    if(H5S_GET_SELECT_TYPE(space) != H5S_SEL_HYPERSLABS
+            || space->select.sel_info.hslab->unlim_dim >= 0
+            || TRUE != H5S__hyper_is_regular(space))
+        HGOTO_DONE(FALSE)
+
+    /* Retrieve the hyperslab parameters */
+    diminfo = space->select.sel_info.hslab->diminfo.opt;
+    for(u = 0; u < space->extent.rank; u++) {
+        start[u] = (hsize_t)((hssize_t)diminfo[u].start + space->select.offset[u]);
+        count[u] = diminfo[u].count;
+        block[u] = diminfo[u].block;
+        stride[u] = count[u] > 1 ? diminfo[u].stride : block[u];
+    } /* end for */
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5S_hyper_get_regular() */
+
+
 /*--------------------------------------------------------------------------
  NAME
     H5Sis_regular_hyperslab
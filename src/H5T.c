@@ -50,6 +50,13 @@
 
 #define H5T_ENCODE_VERSION      0
 
+/* Datatype fingerprints for the conversion path hash table (FNV-1a style
+ * mixing of whole property values) */
+#define H5T_FP_INIT             2166136261u
+#define H5T_FP_PRIME            16777619u
+#define H5T_FP_MIX(H, V)        (((H) ^ (unsigned)(V)) * H5T_FP_PRIME)
+#define H5T_PATH_BUCKET(S, D)   ((size_t)H5T_FP_MIX(H5T_FP_MIX(H5T_FP_INIT, S), D) & (H5T_g.nbuckets - 1))
+
 /*
  * Type initialization macros
  *
@@ -315,6 +322,12 @@ static htri_t H5T__compiler_conv(H5T_t *src, H5T_t *dst);
 static herr_t H5T__set_size(H5T_t *dt, size_t size);
 static herr_t H5T__close_cb(H5T_t *dt);
 static H5T_path_t *H5T__path_find_real(const H5T_t *src, const H5T_t *dst, const char *name, H5T_conv_func_t *conv);
+static unsigned H5T__fingerprint_bytes(const void *buf, size_t size);
+static unsigned H5T__fingerprint(const H5T_t *dt);
+static H5T_path_t *H5T__path_search(const H5T_t *src, const H5T_t *dst, int *md, int *cmp);
+static H5T_path_t *H5T__path_hash_find(const H5T_t *src, const H5T_t *dst);
+static void H5T__path_hash_insert(H5T_path_t *path);
+static void H5T__path_hash_remove(const H5T_path_t *path);
 static hbool_t H5T__detect_vlen_ref(const H5T_t *dt);
 static H5T_t *H5T__initiate_copy(const H5T_t *old_dt);
 static H5T_t *H5T__copy_transient(H5T_t *old_dt);
@@ -551,12 +564,17 @@ const unsigned H5O_dtype_ver_bounds[] = {
 
 /*
  * The path database. Each path has a source and destination data type pair
- * which is used as the key by which the `entries' array is sorted.
+ * which is used as the key by which the `entries' array is sorted.  Paths
+ * other than the no-op path are also indexed by a hash of the fingerprints
+ * of that pair, so that looking up an existing path doesn't have to compare
+ * datatypes all the way down a binary search.
  */
 static struct {
     int            npaths;        /*number of paths defined               */
     size_t         apaths;        /*number of paths allocated             */
     H5T_path_t   **path;          /*sorted array of path pointers         */
+    size_t         nbuckets;      /*number of path hash buckets (power of 2)*/
+    H5T_path_t   **bucket;        /*path hash table, chained by hash_next */
     int            nsoft;         /*number of soft conversions defined    */
     size_t         asoft;         /*number of soft conversions allocated  */
     H5T_soft_t    *soft;          /*unsorted array of soft conversions    */
@@ -755,6 +773,7 @@ H5T__init_package(void)
     H5T_t       *std_u32be=NULL;        /* Datatype structure for unsigned 32-bit big-endian integer */
     H5T_t       *std_u64le=NULL;        /* Datatype structure for unsigned 64-bit little-endian integer */
     H5T_t       *std_u64be=NULL;        /* Datatype structure for unsigned 64-bit big-endian integer */
+    H5T_t       *std_i16be=NULL;        /* Datatype structure for signed 16-bit big-endian integer */
     H5T_t       *dt = NULL;
     H5T_t       *fixedpt=NULL;          /* Datatype structure for native int */
     H5T_t       *floatpt=NULL;          /* Datatype structure for native float */
@@ -895,6 +914,7 @@ H5T__init_package(void)
 
     /* 2-byte big-endian signed integer */
     H5T_INIT_TYPE(SINTBE,H5T_STD_I16BE_g,COPY,native_int,SET,2)
+    std_i16be=dt;    /* Keep type for later */
 
     /* 4-byte little-endian signed integer */
     H5T_INIT_TYPE(SINTLE,H5T_STD_I32LE_g,COPY,native_int,SET,4)
@@ -1208,6 +1228,11 @@ H5T__init_package(void)
     status |= H5T__register_int(H5T_PERS_HARD, "short_dbl", native_short, native_double, H5T__conv_short_double);
     status |= H5T__register_int(H5T_PERS_HARD, "short_ldbl", native_short, native_ldouble, H5T__conv_short_ldouble);
 
+    /* From big-endian 16-bit integers to float, swapping and converting in
+     * one pass.  On big-endian machines this is just "short_flt". */
+    if(H5T_ORDER_LE == H5T_native_order_g)
+        status |= H5T__register_int(H5T_PERS_HARD, "i16be_flt", std_i16be, native_float, H5T__conv_i16be_float);
+
     /* From unsigned short to floats */
     status |= H5T__register_int(H5T_PERS_HARD, "ushort_flt", native_ushort, native_float, H5T__conv_ushort_float);
     status |= H5T__register_int(H5T_PERS_HARD, "ushort_dbl", native_ushort, native_double, H5T__conv_ushort_double);
@@ -1466,6 +1491,8 @@ H5T_top_term_package(void)
             H5T_g.path = (H5T_path_t **)H5MM_xfree(H5T_g.path);
             H5T_g.npaths = 0;
             H5T_g.apaths = 0;
+            H5T_g.bucket = (H5T_path_t **)H5MM_xfree(H5T_g.bucket);
+            H5T_g.nbuckets = 0;
             H5T_g.soft = (H5T_soft_t *)H5MM_xfree(H5T_g.soft);
             H5T_g.nsoft = 0;
             H5T_g.asoft = 0;
@@ -2520,7 +2547,9 @@ H5T__register(H5T_pers_t pers, const char *name, H5T_t *src, H5T_t *dst,
             new_path->cdata = cdata;
 
             /* Replace previous path */
+            H5T__path_hash_remove(old_path);
             H5T_g.path[i] = new_path;
+            H5T__path_hash_insert(new_path);
             new_path = NULL; /*so we don't free it on error*/
 
             /* Free old path */
@@ -2702,6 +2731,7 @@ H5T__unregister(H5T_pers_t pers, const char *name, H5T_t *src, H5T_t *dst,
         } /* end if */
         else {
             /* Remove from table */
+            H5T__path_hash_remove(path);
             HDmemmove(H5T_g.path + i, H5T_g.path + i + 1, (size_t)(H5T_g.npaths - (i + 1)) * sizeof(H5T_path_t*));
             --H5T_g.npaths;
 
@@ -4398,6 +4428,25 @@ H5T_cmp(const H5T_t *dt1, const H5T_t *dt2, hbool_t superset)
             if(dt1->shared->u.compnd.nmembs > dt2->shared->u.compnd.nmembs)
                 HGOTO_DONE(1);
 
+            /* Types describing the same struct usually list their members
+             * in the same order, so first try matching the members pairwise
+             * as they are.  If every pair matches, the sorted comparison
+             * below would pair up the same members, so the types are equal.
+             * Otherwise fall through, since the sort order decides which
+             * type is "less".
+             */
+            for(u = 0; u < dt1->shared->u.compnd.nmembs; u++) {
+                const H5T_cmemb_t *memb1 = &dt1->shared->u.compnd.memb[u];
+                const H5T_cmemb_t *memb2 = &dt2->shared->u.compnd.memb[u];
+
+                if(memb1->offset != memb2->offset || memb1->size != memb2->size ||
+                        HDstrcmp(memb1->name, memb2->name) ||
+                        H5T_cmp(memb1->type, memb2->type, superset))
+                    break;
+            } /* end for */
+            if(u == dt1->shared->u.compnd.nmembs)
+                HGOTO_DONE(0);
+
             /* Build an index for each type so the names are sorted */
             if(NULL == (idx1 = (unsigned *)H5MM_malloc(dt1->shared->u.compnd.nmembs * sizeof(unsigned))) ||
                     NULL == (idx2 = (unsigned *)H5MM_malloc(dt2->shared->u.compnd.nmembs * sizeof(unsigned))))
@@ -4850,8 +4899,7 @@ static H5T_path_t *
 H5T__path_find_real(const H5T_t *src, const H5T_t *dst, const char *name,
     H5T_conv_func_t *conv)
 {
-    int           lt, rt;                      /* left and right edges */
-    int           md;                          /* middle */
+    int           md;                          /* location in the path table */
     int           cmp;                         /* comparison result  */
     int           old_npaths;                  /* Previous number of paths in table */
     H5T_path_t    *table = NULL;               /* path existing in the table */
@@ -4894,8 +4942,10 @@ H5T__path_find_real(const H5T_t *src, const H5T_t *dst, const char *name,
     } /* end if */
 
     /* Find the conversion path.  If source and destination types are equal
-     * then use entry[0], otherwise do a binary search over the
-     * remaining entries.
+     * then use entry[0], otherwise look the pair up in the path hash table.
+     * The position of the path in the sorted table is only needed when a
+     * path is added or replaced below, so the binary search over the
+     * remaining entries is deferred until then.
      *
      * Quincey Koziol, 2 July, 1999
      * Only allow the no-op conversion to occur if no "force conversion" flags
@@ -4906,25 +4956,13 @@ H5T__path_find_real(const H5T_t *src, const H5T_t *dst, const char *name,
         cmp = 0;
         md = 0;
     } /* end if */
-    else {
-        lt = md = 1;
-        rt = H5T_g.npaths;
-        cmp = -1;
-
-        while(cmp && lt < rt) {
-            md = (lt + rt) / 2;
-            HDassert(H5T_g.path[md]);
-            cmp = H5T_cmp(src, H5T_g.path[md]->src, FALSE);
-            if(0 == cmp)
-                cmp = H5T_cmp(dst, H5T_g.path[md]->dst, FALSE);
-            if(cmp < 0)
-                rt = md;
-            else if(cmp > 0)
-                lt = md + 1;
-            else
-                table = H5T_g.path[md];
-        } /* end while */
-    } /* end else */
+    else if(H5T_g.nbuckets > 0) {
+        table = H5T__path_hash_find(src, dst);
+        cmp = table ? 0 : -1;
+        md = -1;
+    } /* end else-if */
+    else
+        table = H5T__path_search(src, dst, &md, &cmp);
 
     /* Keep a record of the number of paths in the table, in case one of the
      * initialization calls below (hard or soft) causes more entries to be
@@ -5030,25 +5068,14 @@ H5T__path_find_real(const H5T_t *src, const H5T_t *dst, const char *name,
 
     /* Check if paths were inserted into the table through a recursive call
      * and re-compute the correct location for this path if so. - QAK, 1/26/02
+     * The location is also computed here if the path was looked up through
+     * the hash table and is about to be added or replaced.
      */
-    if(old_npaths != H5T_g.npaths) {
-        lt = md = 1;
-        rt = H5T_g.npaths;
-        cmp = -1;
-
-        while(cmp && lt < rt) {
-            md = (lt + rt) / 2;
-            HDassert(H5T_g.path[md]);
-            cmp = H5T_cmp(src, H5T_g.path[md]->src, FALSE);
-            if(0 == cmp)
-                cmp = H5T_cmp(dst, H5T_g.path[md]->dst, FALSE);
-            if(cmp < 0)
-                rt = md;
-            else if(cmp > 0)
-                lt = md + 1;
-            else
-                table = H5T_g.path[md];
-        } /* end while */
+    if(old_npaths != H5T_g.npaths || (md < 0 && path != table)) {
+        H5T_path_t *found;              /* Path found in the sorted table */
+
+        if(NULL != (found = H5T__path_search(src, dst, &md, &cmp)))
+            table = found;
     } /* end if */
 
     /* Replace an existing table entry or add a new entry */
@@ -5079,9 +5106,13 @@ H5T__path_find_real(const H5T_t *src, const H5T_t *dst, const char *name,
             (void)H5T_close_real(table->src);
         if(table->dst)
             (void)H5T_close_real(table->dst);
+        if(md > 0)
+            H5T__path_hash_remove(table);
         table = H5FL_FREE(H5T_path_t, table);
         table = path;
         H5T_g.path[md] = path;
+        if(md > 0)
+            H5T__path_hash_insert(path);
     } /* end if */
     else if(path != table) {
         HDassert(cmp);
@@ -5099,6 +5130,7 @@ H5T__path_find_real(const H5T_t *src, const H5T_t *dst, const char *name,
         HDmemmove(H5T_g.path + md + 1, H5T_g.path + md, (size_t) (H5T_g.npaths - md) * sizeof(H5T_path_t*));
         H5T_g.npaths++;
         H5T_g.path[md] = path;
+        H5T__path_hash_insert(path);
         table = path;
     } /* end else-if */
 
@@ -5127,6 +5159,324 @@ done:
 } /* end H5T__path_find_real() */
 
 
+/*-------------------------------------------------------------------------
+ * Function:    H5T__fingerprint_bytes
+ *
+ * Purpose:     FNV-1a hash of SIZE bytes at BUF, used for member names
+ *              and enumeration values in datatype fingerprints.
+ *
+ * Return:      The hash (can't fail)
+ *
+ *-------------------------------------------------------------------------
+ */
+static unsigned
+H5T__fingerprint_bytes(const void *buf, size_t size)
+{
+    const uint8_t *p = (const uint8_t *)buf;
+    unsigned    ret_value = H5T_FP_INIT;        /* Return value */
+
+    FUNC_ENTER_STATIC_NOERR
+
+    while(size-- > 0)
+        ret_value = (ret_value ^ *p++) * H5T_FP_PRIME;
+
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5T__fingerprint_bytes() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:    H5T__fingerprint
+ *
+ * Purpose:     Computes a hash of the properties of DT which H5T_cmp
+ *              compares, so that datatypes which compare equal (without
+ *              the "superset" flag) always have the same fingerprint.
+ *              Properties which H5T_cmp doesn't always compare, like
+ *              opaque tags and the location of VL types, are left out.
+ *
+ * Return:      The fingerprint of DT (can't fail)
+ *
+ *-------------------------------------------------------------------------
+ */
+static unsigned
+H5T__fingerprint(const H5T_t *dt)
+{
+    const H5T_shared_t *shared;         /* Shared datatype info */
+    unsigned    fp;                     /* Fingerprint being built */
+    unsigned    u;                      /* Local index variable */
+    unsigned    ret_value = 0;          /* Return value */
+
+    FUNC_ENTER_STATIC_NOERR
+
+    HDassert(dt);
+    shared = dt->shared;
+
+    fp = H5T_FP_MIX(H5T_FP_INIT, shared->type);
+    fp = H5T_FP_MIX(fp, shared->size);
+    if(shared->parent)
+        fp = H5T_FP_MIX(fp, H5T__fingerprint(shared->parent));
+
+    switch(shared->type) {
+        case H5T_COMPOUND:
+            {
+                unsigned memb_fp = 0;   /* Sum of member fingerprints */
+
+                /* Members are combined independently of their order, as
+                 * H5T_cmp matches them up by name */
+                fp = H5T_FP_MIX(fp, shared->u.compnd.nmembs);
+                for(u = 0; u < shared->u.compnd.nmembs; u++) {
+                    const H5T_cmemb_t *memb = &shared->u.compnd.memb[u];
+                    unsigned h;
+
+                    h = H5T_FP_MIX(H5T__fingerprint_bytes(memb->name, HDstrlen(memb->name)), memb->offset);
+                    h = H5T_FP_MIX(h, memb->size);
+                    memb_fp += H5T_FP_MIX(h, H5T__fingerprint(memb->type));
+                } /* end for */
+                fp = H5T_FP_MIX(fp, memb_fp);
+            }
+            break;
+
+        case H5T_ENUM:
+            {
+                size_t base_size = shared->parent->shared->size;
+                unsigned memb_fp = 0;   /* Sum of member fingerprints */
+
+                fp = H5T_FP_MIX(fp, shared->u.enumer.nmembs);
+                for(u = 0; u < shared->u.enumer.nmembs; u++) {
+                    unsigned h;
+
+                    h = H5T__fingerprint_bytes(shared->u.enumer.name[u], HDstrlen(shared->u.enumer.name[u]));
+                    memb_fp += H5T_FP_MIX(h, H5T__fingerprint_bytes((const uint8_t *)shared->u.enumer.value + u * base_size, base_size));
+                } /* end for */
+                fp = H5T_FP_MIX(fp, memb_fp);
+            }
+            break;
+
+        case H5T_VLEN:
+            fp = H5T_FP_MIX(fp, shared->u.vlen.type);
+            fp = H5T_FP_MIX(fp, (uintptr_t)shared->u.vlen.file);
+            break;
+
+        case H5T_OPAQUE:
+            break;
+
+        case H5T_ARRAY:
+            fp = H5T_FP_MIX(fp, shared->u.array.ndims);
+            for(u = 0; u < shared->u.array.ndims; u++)
+                fp = H5T_FP_MIX(fp, shared->u.array.dim[u]);
+            break;
+
+        case H5T_NO_CLASS:
+        case H5T_INTEGER:
+        case H5T_FLOAT:
+        case H5T_TIME:
+        case H5T_STRING:
+        case H5T_BITFIELD:
+        case H5T_REFERENCE:
+        case H5T_NCLASSES:
+        default:
+            fp = H5T_FP_MIX(fp, shared->u.atomic.order);
+            fp = H5T_FP_MIX(fp, shared->u.atomic.prec);
+            fp = H5T_FP_MIX(fp, shared->u.atomic.offset);
+            fp = H5T_FP_MIX(fp, shared->u.atomic.lsb_pad);
+            fp = H5T_FP_MIX(fp, shared->u.atomic.msb_pad);
+            if(H5T_INTEGER == shared->type)
+                fp = H5T_FP_MIX(fp, shared->u.atomic.u.i.sign);
+            else if(H5T_FLOAT == shared->type) {
+                fp = H5T_FP_MIX(fp, shared->u.atomic.u.f.sign);
+                fp = H5T_FP_MIX(fp, shared->u.atomic.u.f.epos);
+                fp = H5T_FP_MIX(fp, shared->u.atomic.u.f.esize);
+                fp = H5T_FP_MIX(fp, shared->u.atomic.u.f.ebias);
+                fp = H5T_FP_MIX(fp, shared->u.atomic.u.f.mpos);
+                fp = H5T_FP_MIX(fp, shared->u.atomic.u.f.msize);
+                fp = H5T_FP_MIX(fp, shared->u.atomic.u.f.norm);
+                fp = H5T_FP_MIX(fp, shared->u.atomic.u.f.pad);
+            } /* end if */
+            else if(H5T_STRING == shared->type) {
+                fp = H5T_FP_MIX(fp, shared->u.atomic.u.s.cset);
+                fp = H5T_FP_MIX(fp, shared->u.atomic.u.s.pad);
+            } /* end if */
+            else if(H5T_REFERENCE == shared->type) {
+                fp = H5T_FP_MIX(fp, shared->u.atomic.u.r.rtype);
+                fp = H5T_FP_MIX(fp, shared->u.atomic.u.r.loc);
+            } /* end if */
+            break;
+    } /* end switch */
+
+    ret_value = fp;
+
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5T__fingerprint() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:    H5T__path_search
+ *
+ * Purpose:     Binary search of the sorted path table (excluding the no-op
+ *              path) for the path converting SRC to DST.  On return, *MD
+ *              is the location last compared and *CMP the result of that
+ *              comparison, which locate where a new path would go.
+ *
+ * Return:      Pointer to the path if found, NULL otherwise
+ *
+ *-------------------------------------------------------------------------
+ */
+static H5T_path_t *
+H5T__path_search(const H5T_t *src, const H5T_t *dst, int *md, int *cmp)
+{
+    int         lt, rt;                 /* left and right edges */
+    H5T_path_t *ret_value = NULL;       /* Return value */
+
+    FUNC_ENTER_STATIC_NOERR
+
+    lt = *md = 1;
+    rt = H5T_g.npaths;
+    *cmp = -1;
+
+    while(*cmp && lt < rt) {
+        *md = (lt + rt) / 2;
+        HDassert(H5T_g.path[*md]);
+        *cmp = H5T_cmp(src, H5T_g.path[*md]->src, FALSE);
+        if(0 == *cmp)
+            *cmp = H5T_cmp(dst, H5T_g.path[*md]->dst, FALSE);
+        if(*cmp < 0)
+            rt = *md;
+        else if(*cmp > 0)
+            lt = *md + 1;
+        else
+            ret_value = H5T_g.path[*md];
+    } /* end while */
+
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5T__path_search() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:    H5T__path_hash_find
+ *
+ * Purpose:     Looks up the path converting SRC to DST in the path hash
+ *              table.  Fingerprint matches are confirmed with H5T_cmp.
+ *
+ * Return:      Pointer to the path if found, NULL otherwise
+ *
+ *-------------------------------------------------------------------------
+ */
+static H5T_path_t *
+H5T__path_hash_find(const H5T_t *src, const H5T_t *dst)
+{
+    H5T_path_t *path;                   /* Path in the bucket's chain */
+    unsigned    src_fp, dst_fp;         /* Fingerprints of the datatypes */
+    H5T_path_t *ret_value = NULL;       /* Return value */
+
+    FUNC_ENTER_STATIC_NOERR
+
+    HDassert(H5T_g.nbuckets > 0);
+
+    src_fp = H5T__fingerprint(src);
+    dst_fp = H5T__fingerprint(dst);
+    for(path = H5T_g.bucket[H5T_PATH_BUCKET(src_fp, dst_fp)]; path; path = path->hash_next)
+        if(path->src_fp == src_fp && path->dst_fp == dst_fp &&
+                0 == H5T_cmp(src, path->src, FALSE) && 0 == H5T_cmp(dst, path->dst, FALSE))
+            HGOTO_DONE(path)
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5T__path_hash_find() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:    H5T__path_hash_insert
+ *
+ * Purpose:     Adds PATH, which must already be stored in the sorted path
+ *              table, to the path hash table.  The hash table is grown
+ *              (and rebuilt from the sorted table) when it gets more
+ *              paths than buckets.
+ *
+ *              If memory for the buckets can't be allocated the current
+ *              buckets are kept or, when there are none yet, paths are
+ *              looked up with a binary search until a later allocation
+ *              succeeds.
+ *
+ * Return:      void (can't fail)
+ *
+ *-------------------------------------------------------------------------
+ */
+static void
+H5T__path_hash_insert(H5T_path_t *path)
+{
+    size_t      idx;                    /* Bucket index */
+    hbool_t     rebuild = FALSE;        /* Whether the buckets were reallocated */
+
+    FUNC_ENTER_STATIC_NOERR
+
+    HDassert(path);
+    HDassert(path->src && path->dst);
+
+    path->src_fp = H5T__fingerprint(path->src);
+    path->dst_fp = H5T__fingerprint(path->dst);
+
+    if((size_t)H5T_g.npaths > H5T_g.nbuckets) {
+        size_t      nbuckets = MAX(128, 2 * H5T_g.nbuckets);
+        H5T_path_t **bucket;
+
+        if(NULL != (bucket = (H5T_path_t **)H5MM_calloc(nbuckets * sizeof(H5T_path_t *)))) {
+            H5MM_xfree(H5T_g.bucket);
+            H5T_g.bucket = bucket;
+            H5T_g.nbuckets = nbuckets;
+            rebuild = TRUE;
+        } /* end if */
+    } /* end if */
+
+    if(rebuild) {
+        int i;
+
+        /* Rebuild the chains, including PATH */
+        for(i = 1; i < H5T_g.npaths; i++) {
+            H5T_path_t *p = H5T_g.path[i];
+
+            idx = H5T_PATH_BUCKET(p->src_fp, p->dst_fp);
+            p->hash_next = H5T_g.bucket[idx];
+            H5T_g.bucket[idx] = p;
+        } /* end for */
+    } /* end if */
+    else if(H5T_g.nbuckets > 0) {
+        idx = H5T_PATH_BUCKET(path->src_fp, path->dst_fp);
+        path->hash_next = H5T_g.bucket[idx];
+        H5T_g.bucket[idx] = path;
+    } /* end if */
+
+    FUNC_LEAVE_NOAPI_VOID
+} /* end H5T__path_hash_insert() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:    H5T__path_hash_remove
+ *
+ * Purpose:     Removes PATH from the path hash table, if it's there.
+ *
+ * Return:      void (can't fail)
+ *
+ *-------------------------------------------------------------------------
+ */
+static void
+H5T__path_hash_remove(const H5T_path_t *path)
+{
+    H5T_path_t **pp;                    /* Link to the path in its chain */
+
+    FUNC_ENTER_STATIC_NOERR
+
+    HDassert(path);
+
+    if(H5T_g.nbuckets > 0)
+        for(pp = &H5T_g.bucket[H5T_PATH_BUCKET(path->src_fp, path->dst_fp)]; *pp; pp = &(*pp)->hash_next)
+            if(*pp == path) {
+                *pp = path->hash_next;
+                break;
+            } /* end if */
+
+    FUNC_LEAVE_NOAPI_VOID
+} /* end H5T__path_hash_remove() */
+
+
 /*-------------------------------------------------------------------------
  * Function:  H5T_path_noop
  *
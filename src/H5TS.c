@@ -37,6 +37,51 @@ H5TS_key_t H5TS_funcstk_key_g;
 H5TS_key_t H5TS_apictx_key_g;
 H5TS_key_t H5TS_cancel_key_g;
 
+/* Key for marking the helper threads of H5TS_parallel_for() */
+static H5TS_key_t H5TS_helper_key_g;
+
+#ifndef H5_MEMORY_ALLOC_SANITY_CHECK
+/* Condition variables for the pool of helper threads */
+#ifdef H5_HAVE_WIN_THREADS
+typedef CONDITION_VARIABLE H5TS_cond_t;
+#define H5TS_cond_init(cond)            InitializeConditionVariable(cond)
+#define H5TS_cond_wait(cond, mutex)     SleepConditionVariableCS(cond, mutex, INFINITE)
+#define H5TS_cond_broadcast(cond)       WakeAllConditionVariable(cond)
+#else /* H5_HAVE_WIN_THREADS */
+typedef pthread_cond_t H5TS_cond_t;
+#define H5TS_cond_init(cond)            pthread_cond_init(cond, NULL)
+#define H5TS_cond_wait(cond, mutex)     pthread_cond_wait(cond, mutex)
+#define H5TS_cond_broadcast(cond)       pthread_cond_broadcast(cond)
+#endif /* H5_HAVE_WIN_THREADS */
+
+/* Pool of helper threads for H5TS_parallel_for().  The threads are started
+ * as they are needed and kept until the library is shut down.  The pool
+ * runs one job (one H5TS_parallel_for() call) at a time. */
+typedef struct H5TS_pool_t {
+    H5TS_mutex_simple_t lock;           /* Lock for the fields below */
+    H5TS_cond_t work_cond;              /* Signaled when a job is posted, or on shutdown */
+    H5TS_cond_t done_cond;              /* Signaled when the last helper leaves a job */
+    H5TS_thread_t *threads;             /* Helper threads */
+    H5E_t **errors;                     /* Errors of each helper thread's failed tasks */
+    unsigned nthreads;                  /* Number of helper threads */
+    unsigned nalloc;                    /* Number of slots allocated for helper threads */
+    hbool_t shutdown;                   /* Whether the helper threads should exit */
+
+    /* Current job */
+    hbool_t busy;                       /* Whether there is a job */
+    uint64_t job;                       /* Number of the job */
+    H5TS_task_op_t op;                  /* Operation to perform on each task */
+    void *udata;                        /* User data for operation */
+    size_t ntasks;                      /* Number of tasks */
+    size_t next;                        /* Next task to run */
+    unsigned nwanted;                   /* Number of helpers the job can still take */
+    unsigned nactive;                   /* Number of helpers working on the job */
+    herr_t status;                      /* Whether any task of the job failed */
+} H5TS_pool_t;
+
+static H5TS_pool_t H5TS_pool_g;
+#endif /* H5_MEMORY_ALLOC_SANITY_CHECK */
+
 #ifndef H5_HAVE_WIN_THREADS
 
 /* An h5_tid_t is a record of a thread identifier that is
@@ -226,6 +271,16 @@ H5TS_pthread_first_thread_init(void)
 
     /* initialize key for thread cancellability mechanism */
     pthread_key_create(&H5TS_cancel_key_g, H5TS_key_destructor);
+
+    /* initialize key for marking helper threads (nothing to free) */
+    pthread_key_create(&H5TS_helper_key_g, NULL);
+
+#ifndef H5_MEMORY_ALLOC_SANITY_CHECK
+    /* initialize the pool of helper threads */
+    H5TS_mutex_init(&H5TS_pool_g.lock);
+    H5TS_cond_init(&H5TS_pool_g.work_cond);
+    H5TS_cond_init(&H5TS_pool_g.done_cond);
+#endif /* H5_MEMORY_ALLOC_SANITY_CHECK */
 }
 #endif /* H5_HAVE_WIN_THREADS */
 
@@ -473,6 +528,16 @@ H5TS_win32_process_enter(PINIT_ONCE InitOnce, PVOID Parameter, PVOID *lpContex)
     if(TLS_OUT_OF_INDEXES == (H5TS_apictx_key_g = TlsAlloc()))
         ret_value = FALSE;
 
+    if(TLS_OUT_OF_INDEXES == (H5TS_helper_key_g = TlsAlloc()))
+        ret_value = FALSE;
+
+#ifndef H5_MEMORY_ALLOC_SANITY_CHECK
+    /* Initialize the pool of helper threads (can't fail) */
+    InitializeCriticalSection(&H5TS_pool_g.lock);
+    InitializeConditionVariable(&H5TS_pool_g.work_cond);
+    InitializeConditionVariable(&H5TS_pool_g.done_cond);
+#endif /* H5_MEMORY_ALLOC_SANITY_CHECK */
+
     return ret_value;
 } /* H5TS_win32_process_enter() */
 #endif /* H5_HAVE_WIN_THREADS */
@@ -542,6 +607,11 @@ H5TS_win32_process_exit(void)
     TlsFree(H5TS_funcstk_key_g);
 #endif /* H5_HAVE_CODESTACK */
     TlsFree(H5TS_apictx_key_g);
+    TlsFree(H5TS_helper_key_g);
+
+#ifndef H5_MEMORY_ALLOC_SANITY_CHECK
+    DeleteCriticalSection(&H5TS_pool_g.lock);
+#endif /* H5_MEMORY_ALLOC_SANITY_CHECK */
 
     return;
 } /* H5TS_win32_process_exit() */
@@ -639,4 +709,319 @@ H5TS_create_thread(void *(*func)(void *), H5TS_attr_t *attr, void *udata)
 
 } /* H5TS_create_thread */
 
+
+#ifndef H5_MEMORY_ALLOC_SANITY_CHECK
+
+/*--------------------------------------------------------------------------
+ * NAME
+ *    H5TS__pool_run
+ *
+ * RETURNS
+ *    SUCCEED if every task this thread ran succeeded, FAIL otherwise.
+ *
+ * DESCRIPTION
+ *    Runs tasks of the pool's current job, one at a time, until none
+ *    are left.  The pool's lock must be held on entry and is held on
+ *    return, but not while a task runs.
+ *
+ *--------------------------------------------------------------------------
+ */
+static herr_t
+H5TS__pool_run(void)
+{
+    herr_t ret_value = SUCCEED;
+
+    while(H5TS_pool_g.next < H5TS_pool_g.ntasks) {
+        size_t idx = H5TS_pool_g.next++;
+
+        H5TS_mutex_unlock_simple(&H5TS_pool_g.lock);
+        if((H5TS_pool_g.op)(idx, H5TS_pool_g.udata) < 0)
+            ret_value = FAIL;
+        H5TS_mutex_lock_simple(&H5TS_pool_g.lock);
+    } /* end while */
+
+    return ret_value;
+} /* H5TS__pool_run */
+
+
+/*--------------------------------------------------------------------------
+ * NAME
+ *    H5TS__pool_helper
+ *
+ * RETURNS
+ *    NULL
+ *
+ * DESCRIPTION
+ *    Thread function for the helper threads of H5TS_parallel_for().
+ *    Marks the thread as a helper (see H5TS_is_helper_thread()), then
+ *    joins the jobs posted to the pool until it is shut down.  The
+ *    errors of the tasks the thread ran for a job are left in its slot
+ *    of the pool, for the thread that posted the job.
+ *
+ *--------------------------------------------------------------------------
+ */
+static void *
+H5TS__pool_helper(void *_slot)
+{
+    size_t slot = (size_t)((uintptr_t)_slot - 1);  /* Helper's slot in the pool */
+    uint64_t last_job = 0;              /* Last job this thread joined */
+
+    H5TS_set_thread_local_value(H5TS_helper_key_g, _slot);
+
+    H5TS_mutex_lock_simple(&H5TS_pool_g.lock);
+    for(;;) {
+        /* Wait for a new job that still wants helpers */
+        while(!H5TS_pool_g.shutdown && (!H5TS_pool_g.busy
+                || H5TS_pool_g.job == last_job || 0 == H5TS_pool_g.nwanted))
+            H5TS_cond_wait(&H5TS_pool_g.work_cond, &H5TS_pool_g.lock);
+        if(H5TS_pool_g.shutdown)
+            break;
+        last_job = H5TS_pool_g.job;
+        H5TS_pool_g.nwanted--;
+        H5TS_pool_g.nactive++;
+
+        if(H5TS__pool_run() < 0) {
+            H5TS_pool_g.status = FAIL;
+
+            /* (The errors are moved without the lock) */
+            H5TS_mutex_unlock_simple(&H5TS_pool_g.lock);
+            H5TS_pool_g.errors[slot] = H5E_detach_helper_errors();
+            H5TS_mutex_lock_simple(&H5TS_pool_g.lock);
+        } /* end if */
+        else {
+            /* Drop any errors that the successful tasks left behind */
+            H5TS_mutex_unlock_simple(&H5TS_pool_g.lock);
+            (void)H5E_clear_stack(NULL);
+            H5TS_mutex_lock_simple(&H5TS_pool_g.lock);
+        } /* end else */
+
+        if(0 == --H5TS_pool_g.nactive)
+            H5TS_cond_broadcast(&H5TS_pool_g.done_cond);
+    } /* end for */
+    H5TS_mutex_unlock_simple(&H5TS_pool_g.lock);
+
+    return NULL;
+} /* H5TS__pool_helper */
+
+
+/*--------------------------------------------------------------------------
+ * NAME
+ *    H5TS__pool_grow
+ *
+ * RETURNS
+ *    Number of helper threads in the pool.
+ *
+ * DESCRIPTION
+ *    Starts helper threads until the pool has 'nhelpers' of them, as
+ *    far as they can be created.  The pool's lock must be held.
+ *
+ *--------------------------------------------------------------------------
+ */
+static unsigned
+H5TS__pool_grow(unsigned nhelpers)
+{
+    if(nhelpers > H5TS_pool_g.nalloc) {
+        H5TS_thread_t *threads;
+        H5E_t **errors;
+
+        if(NULL == (threads = (H5TS_thread_t *)HDrealloc(H5TS_pool_g.threads, nhelpers * sizeof(H5TS_thread_t))))
+            return H5TS_pool_g.nthreads;
+        H5TS_pool_g.threads = threads;
+        if(NULL == (errors = (H5E_t **)HDrealloc(H5TS_pool_g.errors, nhelpers * sizeof(H5E_t *))))
+            return H5TS_pool_g.nthreads;
+        H5TS_pool_g.errors = errors;
+        H5TS_pool_g.nalloc = nhelpers;
+    } /* end if */
+
+    while(H5TS_pool_g.nthreads < nhelpers) {
+        void *slot = (void *)((uintptr_t)H5TS_pool_g.nthreads + 1);
+        H5TS_thread_t *thread = &H5TS_pool_g.threads[H5TS_pool_g.nthreads];
+
+        H5TS_pool_g.errors[H5TS_pool_g.nthreads] = NULL;
+#ifdef H5_HAVE_WIN_THREADS
+        if(NULL == (*thread = H5TS_create_thread(H5TS__pool_helper, NULL, slot)))
+            break;
+#else /* H5_HAVE_WIN_THREADS */
+        if(pthread_create(thread, NULL, H5TS__pool_helper, slot))
+            break;
+#endif /* H5_HAVE_WIN_THREADS */
+        H5TS_pool_g.nthreads++;
+    } /* end while */
+
+    return H5TS_pool_g.nthreads;
+} /* H5TS__pool_grow */
+#endif /* H5_MEMORY_ALLOC_SANITY_CHECK */
+
+
+/*--------------------------------------------------------------------------
+ * NAME
+ *    H5TS_is_helper_thread
+ *
+ * RETURNS
+ *    TRUE if the calling thread is a helper thread of H5TS_parallel_for(),
+ *    FALSE otherwise.
+ *
+ * DESCRIPTION
+ *    Helper threads run library code without holding the API lock, so
+ *    they must not touch the library's shared state.  The error stack
+ *    routines use this to avoid the ID reference counts.
+ *
+ *--------------------------------------------------------------------------
+ */
+hbool_t
+H5TS_is_helper_thread(void)
+{
+    return (hbool_t)(NULL != H5TS_get_thread_local_value(H5TS_helper_key_g));
+} /* H5TS_is_helper_thread */
+
+
+/*--------------------------------------------------------------------------
+ * NAME
+ *    H5TS_pool_term
+ *
+ * RETURNS
+ *    void
+ *
+ * DESCRIPTION
+ *    Stops the helper threads of H5TS_parallel_for(), when the library
+ *    is shut down.  They are started again if they are needed later.
+ *
+ *--------------------------------------------------------------------------
+ */
+void
+H5TS_pool_term(void)
+{
+#ifndef H5_MEMORY_ALLOC_SANITY_CHECK
+    unsigned u;
+
+    H5TS_mutex_lock_simple(&H5TS_pool_g.lock);
+    HDassert(!H5TS_pool_g.busy);
+    H5TS_pool_g.shutdown = TRUE;
+    H5TS_cond_broadcast(&H5TS_pool_g.work_cond);
+    H5TS_mutex_unlock_simple(&H5TS_pool_g.lock);
+
+    for(u = 0; u < H5TS_pool_g.nthreads; u++) {
+        H5TS_wait_for_thread(H5TS_pool_g.threads[u]);
+#ifdef H5_HAVE_WIN_THREADS
+        CloseHandle(H5TS_pool_g.threads[u]);
+#endif /* H5_HAVE_WIN_THREADS */
+    } /* end for */
+
+    if(H5TS_pool_g.threads)
+        HDfree(H5TS_pool_g.threads);
+    if(H5TS_pool_g.errors)
+        HDfree(H5TS_pool_g.errors);
+    H5TS_pool_g.threads = NULL;
+    H5TS_pool_g.errors = NULL;
+    H5TS_pool_g.nthreads = 0;
+    H5TS_pool_g.nalloc = 0;
+    H5TS_pool_g.shutdown = FALSE;
+#endif /* H5_MEMORY_ALLOC_SANITY_CHECK */
+} /* H5TS_pool_term */
+
 #endif  /* H5_HAVE_THREADSAFE */
+
+
+/*--------------------------------------------------------------------------
+ * NAME
+ *    H5TS_parallel_for
+ *
+ * USAGE
+ *    H5TS_parallel_for(nthreads, ntasks, op, udata)
+ *
+ * RETURNS
+ *    SUCCEED if every task succeeded, FAIL otherwise.
+ *
+ * DESCRIPTION
+ *    Calls 'op' once for each task index in [0, ntasks), spreading the
+ *    tasks over at most 'nthreads' threads (the calling thread is one of
+ *    them) and returning once all of them have finished.  The other
+ *    threads are taken from a pool of helper threads, which is grown as
+ *    needed and kept until the library is shut down.
+ *
+ *    The tasks run outside of the library's normal locking, so 'op' must
+ *    only touch memory that belongs to its task and must not call back
+ *    into the library, apart from self-contained routines like the I/O
+ *    filter pipeline with filters that H5Z_pipeline_thread_safe() allows
+ *    and without an application callback.  Library routines run on a
+ *    helper thread use that thread's own error stack, API context and
+ *    function stack.  The errors pushed by the failed tasks of a helper
+ *    thread are moved to the calling thread's error stack before this
+ *    returns, so they are reported like those of the tasks run by the
+ *    calling thread.
+ *
+ *    If the pool can't provide helper threads (because they can't be
+ *    created, or because the pool is already in use, for instance by a
+ *    task that calls this again), the tasks are run in the calling
+ *    thread.
+ *
+ *    When the library isn't built thread-safe (or the memory allocation
+ *    sanity checks, which aren't thread-safe, are enabled) the tasks are
+ *    run one after another in the calling thread.
+ *
+ *--------------------------------------------------------------------------
+ */
+herr_t
+H5TS_parallel_for(unsigned nthreads, size_t ntasks, H5TS_task_op_t op, void *udata)
+{
+    herr_t ret_value = SUCCEED;
+    size_t u;
+
+    HDassert(op);
+
+    if(nthreads > ntasks)
+        nthreads = (unsigned)ntasks;
+
+#if defined(H5_HAVE_THREADSAFE) && !defined(H5_MEMORY_ALLOC_SANITY_CHECK)
+    /* Don't let helper threads post jobs of their own */
+    if(nthreads > 1 && !H5TS_is_helper_thread()) {
+        H5TS_mutex_lock_simple(&H5TS_pool_g.lock);
+        if(!H5TS_pool_g.busy && !H5TS_pool_g.shutdown && H5TS__pool_grow(nthreads - 1) > 0) {
+            unsigned v;
+
+            /* Post the job */
+            H5TS_pool_g.busy = TRUE;
+            H5TS_pool_g.job++;
+            H5TS_pool_g.op = op;
+            H5TS_pool_g.udata = udata;
+            H5TS_pool_g.ntasks = ntasks;
+            H5TS_pool_g.next = 0;
+            H5TS_pool_g.nwanted = MIN(nthreads - 1, H5TS_pool_g.nthreads);
+            H5TS_pool_g.status = SUCCEED;
+            H5TS_cond_broadcast(&H5TS_pool_g.work_cond);
+
+            /* Run tasks alongside the helpers, then wait for them to finish */
+            if(H5TS__pool_run() < 0)
+                ret_value = FAIL;
+            H5TS_pool_g.nwanted = 0;
+            while(H5TS_pool_g.nactive > 0)
+                H5TS_cond_wait(&H5TS_pool_g.done_cond, &H5TS_pool_g.lock);
+            if(H5TS_pool_g.status < 0)
+                ret_value = FAIL;
+            H5TS_mutex_unlock_simple(&H5TS_pool_g.lock);
+
+            /* Take over the errors of the helpers' failed tasks (no other
+             * job can use their slots until the pool isn't busy) */
+            if(ret_value < 0)
+                for(v = 0; v < H5TS_pool_g.nthreads; v++)
+                    if(H5TS_pool_g.errors[v]) {
+                        (void)H5E_attach_helper_errors(H5TS_pool_g.errors[v]);
+                        H5TS_pool_g.errors[v] = NULL;
+                    } /* end if */
+
+            H5TS_mutex_lock_simple(&H5TS_pool_g.lock);
+            H5TS_pool_g.busy = FALSE;
+            H5TS_mutex_unlock_simple(&H5TS_pool_g.lock);
+
+            return ret_value;
+        } /* end if */
+        H5TS_mutex_unlock_simple(&H5TS_pool_g.lock);
+    } /* end if */
+#endif /* defined(H5_HAVE_THREADSAFE) && !defined(H5_MEMORY_ALLOC_SANITY_CHECK) */
+
+    for(u = 0; u < ntasks; u++)
+        if((op)(u, udata) < 0)
+            ret_value = FAIL;
+
+    return ret_value;
+} /* H5TS_parallel_for */
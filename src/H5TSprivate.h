@@ -124,6 +124,8 @@ H5_DLL herr_t H5TS_mutex_unlock(H5TS_mutex_t *mutex);
 H5_DLL herr_t H5TS_cancel_count_inc(void);
 H5_DLL herr_t H5TS_cancel_count_dec(void);
 H5_DLL H5TS_thread_t H5TS_create_thread(void *(*func)(void *), H5TS_attr_t * attr, void *udata);
+H5_DLL hbool_t H5TS_is_helper_thread(void);
+H5_DLL void H5TS_pool_term(void);
 
 #if defined c_plusplus || defined __cplusplus
 }
@@ -135,5 +137,11 @@ H5_DLL H5TS_thread_t H5TS_create_thread(void *(*func)(void *), H5TS_attr_t * att
 
 #endif /* H5_HAVE_THREADSAFE */
 
+/* Operation for H5TS_parallel_for(), called once for each task index */
+typedef herr_t (*H5TS_task_op_t)(size_t idx, void *udata);
+
+H5_DLL herr_t H5TS_parallel_for(unsigned nthreads, size_t ntasks,
+    H5TS_task_op_t op, void *udata);
+
 #endif	/* H5TSprivate_H_ */
 
@@ -35,11 +35,44 @@
 #include "H5Pprivate.h"		/* Property lists			*/
 #include "H5Tpkg.h"		/* Datatypes				*/
 
+/* Hard conversions between some common native types convert contiguous
+ * runs of elements with SSE2 vectors on x86-64, and AVX2 vectors when the
+ * CPU has them (checked at run time).  Define H5T_CONV_NO_SIMD to use only
+ * the scalar loops. */
+#if defined(__x86_64__) && defined(__GNUC__) && (__GNUC__ >= 5 || defined(__clang__)) \
+        && !defined(H5T_CONV_NO_SIMD) && H5_SIZEOF_SHORT == 2 && H5_SIZEOF_INT == 4 \
+        && H5_SIZEOF_LONG_LONG == 8
+#define H5T_CONV_SIMD
+#include <immintrin.h>
+#define H5T_CONV_AVX2           __attribute__((target("avx2")))
+#endif /* __x86_64__ */
+
 
 /****************/
 /* Local Macros */
 /****************/
 
+#ifdef H5T_CONV_SIMD
+/* Vector kernels for the hard conversions which have one (see
+ * H5T_CONV_LOOP_VEC_Y) */
+#define H5T_CONV_VEC_UCHAR_FLOAT        H5T__conv_vec_u8_f32
+#define H5T_CONV_VEC_SHORT_FLOAT        H5T__conv_vec_i16_f32
+#define H5T_CONV_VEC_USHORT_FLOAT       H5T__conv_vec_u16_f32
+#define H5T_CONV_VEC_INT_FLOAT          H5T__conv_vec_i32_f32
+#define H5T_CONV_VEC_INT_DOUBLE         H5T__conv_vec_i32_f64
+#define H5T_CONV_VEC_FLOAT_DOUBLE       H5T__conv_vec_f32_f64
+#define H5T_CONV_VEC_DOUBLE_FLOAT       H5T__conv_vec_f64_f32
+#define H5T_CONV_VEC_INT_LLONG          H5T__conv_vec_i32_i64
+#define H5T_CONV_VEC_LLONG_INT          H5T__conv_vec_i64_i32
+#if H5_SIZEOF_LONG == 8
+#define H5T_CONV_VEC_INT_LONG           H5T__conv_vec_i32_i64
+#define H5T_CONV_VEC_LONG_INT           H5T__conv_vec_i64_i32
+#else /* H5_SIZEOF_LONG == 8 */
+#define H5T_CONV_VEC_INT_LONG(S, D, N)  ((size_t)0)
+#define H5T_CONV_VEC_LONG_INT(S, D, N)  ((size_t)0)
+#endif /* H5_SIZEOF_LONG == 8 */
+#endif /* H5T_CONV_SIMD */
+
 /*
  * These macros are for the bodies of functions that convert buffers of one
  * atomic type to another using hardware.
@@ -234,9 +267,12 @@
         *(D) = (DT)(*(S));						      \
 }
 
-#define H5T_CONV_sS(STYPE,DTYPE,ST,DT,D_MIN,D_MAX) {			      \
+#define H5T_CONV_sS(STYPE,DTYPE,ST,DT,D_MIN,D_MAX)			      \
+    H5T_CONV_sS_V(STYPE,DTYPE,ST,DT,D_MIN,D_MAX,N)
+
+#define H5T_CONV_sS_V(STYPE,DTYPE,ST,DT,D_MIN,D_MAX,VEC) {		      \
     HDcompile_assert(sizeof(ST)<=sizeof(DT));				      \
-    H5T_CONV(H5T_CONV_xX, STYPE, DTYPE, ST, DT, D_MIN, D_MAX, N)              \
+    H5T_CONV_V(H5T_CONV_xX, STYPE, DTYPE, ST, DT, D_MIN, D_MAX, N, VEC)       \
 }
 
 #define H5T_CONV_sU_CORE(STYPE,DTYPE,S,D,ST,DT,D_MIN,D_MAX) {			      \
@@ -353,9 +389,12 @@
     H5T_CONV(H5T_CONV_xX, STYPE, DTYPE, ST, DT, D_MIN, D_MAX, N)              \
 }
 
-#define H5T_CONV_Ss(STYPE,DTYPE,ST,DT,D_MIN,D_MAX) {			      \
+#define H5T_CONV_Ss(STYPE,DTYPE,ST,DT,D_MIN,D_MAX)			      \
+    H5T_CONV_Ss_V(STYPE,DTYPE,ST,DT,D_MIN,D_MAX,N)
+
+#define H5T_CONV_Ss_V(STYPE,DTYPE,ST,DT,D_MIN,D_MAX,VEC) {		      \
     HDcompile_assert(sizeof(ST)>=sizeof(DT));				      \
-    H5T_CONV(H5T_CONV_Xx, STYPE, DTYPE, ST, DT, D_MIN, D_MAX, N)              \
+    H5T_CONV_V(H5T_CONV_Xx, STYPE, DTYPE, ST, DT, D_MIN, D_MAX, N, VEC)       \
 }
 
 #define H5T_CONV_Su_CORE(STYPE,DTYPE,S,D,ST,DT,D_MIN,D_MAX) {			      \
@@ -458,9 +497,12 @@
     H5T_CONV(H5T_CONV_us, STYPE, DTYPE, ST, DT, D_MIN, D_MAX, N)              \
 }
 
-#define H5T_CONV_fF(STYPE,DTYPE,ST,DT,D_MIN,D_MAX) {			      \
+#define H5T_CONV_fF(STYPE,DTYPE,ST,DT,D_MIN,D_MAX)			      \
+    H5T_CONV_fF_V(STYPE,DTYPE,ST,DT,D_MIN,D_MAX,N)
+
+#define H5T_CONV_fF_V(STYPE,DTYPE,ST,DT,D_MIN,D_MAX,VEC) {		      \
     HDcompile_assert(sizeof(ST)<=sizeof(DT));				      \
-    H5T_CONV(H5T_CONV_xX, STYPE, DTYPE, ST, DT, D_MIN, D_MAX, N)              \
+    H5T_CONV_V(H5T_CONV_xX, STYPE, DTYPE, ST, DT, D_MIN, D_MAX, N, VEC)       \
 }
 
 /* Same as H5T_CONV_Xx_CORE, except that instead of using D_MAX and D_MIN
@@ -497,9 +539,12 @@
         *(D) = (DT)(*(S));					              \
 }
 
-#define H5T_CONV_Ff(STYPE,DTYPE,ST,DT,D_MIN,D_MAX) {			      \
+#define H5T_CONV_Ff(STYPE,DTYPE,ST,DT,D_MIN,D_MAX)			      \
+    H5T_CONV_Ff_V(STYPE,DTYPE,ST,DT,D_MIN,D_MAX,N)
+
+#define H5T_CONV_Ff_V(STYPE,DTYPE,ST,DT,D_MIN,D_MAX,VEC) {		      \
     HDcompile_assert(sizeof(ST)>=sizeof(DT));				      \
-    H5T_CONV(H5T_CONV_Ff, STYPE, DTYPE, ST, DT, D_MIN, D_MAX, N)              \
+    H5T_CONV_V(H5T_CONV_Ff, STYPE, DTYPE, ST, DT, D_MIN, D_MAX, N, VEC)       \
 }
 
 #define H5T_HI_LO_BIT_SET(TYP, V, LO, HI) {                                   \
@@ -589,8 +634,11 @@
     *(D) = (DT)(*(S));							      \
 }
 
-#define H5T_CONV_xF(STYPE,DTYPE,ST,DT,D_MIN,D_MAX) {			      \
-    H5T_CONV(H5T_CONV_xF, STYPE, DTYPE, ST, DT, D_MIN, D_MAX, Y)                 \
+#define H5T_CONV_xF(STYPE,DTYPE,ST,DT,D_MIN,D_MAX)			      \
+    H5T_CONV_xF_V(STYPE,DTYPE,ST,DT,D_MIN,D_MAX,N)
+
+#define H5T_CONV_xF_V(STYPE,DTYPE,ST,DT,D_MIN,D_MAX,VEC) {		      \
+    H5T_CONV_V(H5T_CONV_xF, STYPE, DTYPE, ST, DT, D_MIN, D_MAX, Y, VEC)       \
 }
 
 /* Quincey added the condition branch (else if (*(S) != (ST)((DT)(*(S))))).
@@ -657,8 +705,10 @@
 #endif /* H5_WANT_DCONV_EXCEPTION */
 
 
-/* The main part of every integer hardware conversion macro */
-#define H5T_CONV(GUTS,STYPE,DTYPE,ST,DT,D_MIN,D_MAX,PREC)  		      \
+/* The main part of every integer hardware conversion macro.  VEC is Y when
+ * there's a vector kernel H5T_CONV_VEC_<STYPE>_<DTYPE> for contiguous runs
+ * of elements, N otherwise. */
+#define H5T_CONV_V(GUTS,STYPE,DTYPE,ST,DT,D_MIN,D_MAX,PREC,VEC)		      \
 {                                                                             \
     herr_t      ret_value=SUCCEED;      /* Return value         */            \
                                                                               \
@@ -777,6 +827,7 @@
                 H5T_CONV_LOOP_OUTER(PRE_SNOALIGN,PRE_DALIGN,POST_SNOALIGN,POST_DALIGN,GUTS,STYPE,DTYPE,src,d,ST,DT,D_MIN,D_MAX) \
             } else {							      \
                 /* Alignment is not required for both source and destination */ \
+                H5_GLUE(H5T_CONV_LOOP_VEC_, VEC)(STYPE,DTYPE,ST,DT)	      \
                 H5T_CONV_LOOP_OUTER(PRE_SNOALIGN,PRE_DNOALIGN,POST_SNOALIGN,POST_DNOALIGN,GUTS,STYPE,DTYPE,src,dst,ST,DT,D_MIN,D_MAX) \
             }	 	 	 	 	 	 	 	      \
 									      \
@@ -795,6 +846,32 @@ done:                                                                         \
     FUNC_LEAVE_NOAPI(ret_value)                                               \
 }
 
+/* Conversions without a vector kernel */
+#define H5T_CONV(GUTS,STYPE,DTYPE,ST,DT,D_MIN,D_MAX,PREC)		      \
+    H5T_CONV_V(GUTS,STYPE,DTYPE,ST,DT,D_MIN,D_MAX,PREC,N)
+
+/* Convert as many elements as the vector kernel handles at the start of a
+ * contiguous run, leaving the rest for the scalar loop.  The kernels give
+ * the same results as the scalar loop does without an exception callback
+ * (see H5T_CONV_LOOP_GUTS), so they are only used when none is set. */
+#ifdef H5T_CONV_SIMD
+#define H5T_CONV_LOOP_VEC_Y(STYPE,DTYPE,ST,DT) {			      \
+    if(!cb_struct.func && s_stride == (ssize_t)sizeof(ST) && d_stride == (ssize_t)sizeof(DT)) { \
+        size_t nvec = H5_GLUE4(H5T_CONV_VEC_,STYPE,_,DTYPE)(src, dst, safe); \
+                                                                              \
+        src += nvec;							      \
+        src_buf = (void *)src;						      \
+        dst += nvec;							      \
+        dst_buf = (void *)dst;						      \
+        safe -= nvec;							      \
+        nelmts -= nvec;							      \
+    }									      \
+}
+#else /* H5T_CONV_SIMD */
+#define H5T_CONV_LOOP_VEC_Y(STYPE,DTYPE,ST,DT) /*no vector kernels */
+#endif /* H5T_CONV_SIMD */
+#define H5T_CONV_LOOP_VEC_N(STYPE,DTYPE,ST,DT) /*no vector kernel */
+
 /* Declare the source & destination precision variables */
 #define H5T_CONV_DECL_PREC(PREC) H5_GLUE(H5T_CONV_DECL_PREC_, PREC)
 
@@ -992,6 +1069,42 @@ typedef struct H5T_conv_hw_t {
 
 static herr_t H5T_reverse_order(uint8_t *rev, uint8_t *s, size_t size, H5T_order_t order);
 
+#ifdef H5T_CONV_SIMD
+static size_t H5T__conv_vec_u8_f32(const void *src, void *dst, size_t nelmts);
+static size_t H5T__conv_vec_i16_f32(const void *src, void *dst, size_t nelmts);
+static size_t H5T__conv_vec_u16_f32(const void *src, void *dst, size_t nelmts);
+static size_t H5T__conv_vec_i32_f32(const void *src, void *dst, size_t nelmts);
+static size_t H5T__conv_vec_i32_f64(const void *src, void *dst, size_t nelmts);
+static size_t H5T__conv_vec_f32_f64(const void *src, void *dst, size_t nelmts);
+static size_t H5T__conv_vec_f64_f32(const void *src, void *dst, size_t nelmts);
+static size_t H5T__conv_vec_i32_i64(const void *src, void *dst, size_t nelmts);
+static size_t H5T__conv_vec_i64_i32(const void *src, void *dst, size_t nelmts);
+static size_t H5T__conv_vec_i16be_f32(const void *src, void *dst, size_t nelmts);
+static size_t H5T__conv_vec_bswap(uint8_t *buf, size_t size, size_t stride, size_t nelmts);
+static size_t H5T__conv_vec_u8_f32_sse2(const void *src, void *dst, size_t nelmts);
+static size_t H5T__conv_vec_i16_f32_sse2(const void *src, void *dst, size_t nelmts);
+static size_t H5T__conv_vec_u16_f32_sse2(const void *src, void *dst, size_t nelmts);
+static size_t H5T__conv_vec_i32_f32_sse2(const void *src, void *dst, size_t nelmts);
+static size_t H5T__conv_vec_i32_f64_sse2(const void *src, void *dst, size_t nelmts);
+static size_t H5T__conv_vec_f32_f64_sse2(const void *src, void *dst, size_t nelmts);
+static size_t H5T__conv_vec_f64_f32_sse2(const void *src, void *dst, size_t nelmts);
+static size_t H5T__conv_vec_i32_i64_sse2(const void *src, void *dst, size_t nelmts);
+static size_t H5T__conv_vec_i64_i32_sse2(const void *src, void *dst, size_t nelmts);
+static size_t H5T__conv_vec_i16be_f32_sse2(const void *src, void *dst, size_t nelmts);
+static size_t H5T__conv_vec_bswap_sse2(uint8_t *buf, size_t size, size_t nelmts);
+static size_t H5T__conv_vec_u8_f32_avx2(const void *src, void *dst, size_t nelmts) H5T_CONV_AVX2;
+static size_t H5T__conv_vec_i16_f32_avx2(const void *src, void *dst, size_t nelmts) H5T_CONV_AVX2;
+static size_t H5T__conv_vec_u16_f32_avx2(const void *src, void *dst, size_t nelmts) H5T_CONV_AVX2;
+static size_t H5T__conv_vec_i32_f32_avx2(const void *src, void *dst, size_t nelmts) H5T_CONV_AVX2;
+static size_t H5T__conv_vec_i32_f64_avx2(const void *src, void *dst, size_t nelmts) H5T_CONV_AVX2;
+static size_t H5T__conv_vec_f32_f64_avx2(const void *src, void *dst, size_t nelmts) H5T_CONV_AVX2;
+static size_t H5T__conv_vec_f64_f32_avx2(const void *src, void *dst, size_t nelmts) H5T_CONV_AVX2;
+static size_t H5T__conv_vec_i32_i64_avx2(const void *src, void *dst, size_t nelmts) H5T_CONV_AVX2;
+static size_t H5T__conv_vec_i64_i32_avx2(const void *src, void *dst, size_t nelmts) H5T_CONV_AVX2;
+static size_t H5T__conv_vec_i16be_f32_avx2(const void *src, void *dst, size_t nelmts) H5T_CONV_AVX2;
+static size_t H5T__conv_vec_bswap_avx2(uint8_t *buf, size_t size, size_t nelmts) H5T_CONV_AVX2;
+#endif /* H5T_CONV_SIMD */
+
 
 /*********************/
 /* Public Variables */
@@ -1021,6 +1134,941 @@ H5FL_BLK_DEFINE_STATIC(array_seq);
 /* Declare a free list to manage pieces of reference data */
 H5FL_BLK_DEFINE_STATIC(ref_seq);
 
+#ifdef H5T_CONV_SIMD
+
+/*-------------------------------------------------------------------------
+ * Vector kernels for hard conversions
+ *
+ * Each kernel converts as many whole blocks of NELMTS contiguous elements
+ * from SRC to DST as it can and returns how many elements it converted;
+ * the caller converts the rest.  The results are those of the scalar
+ * conversions when no exception callback is set: the "no exception" cores
+ * of the H5T_CONV_*_CORE macros when the library is configured with
+ * H5_WANT_DCONV_EXCEPTION and H5T_CONV_NO_EXCEPT_CORE's plain cast when it
+ * isn't.  Only H5T__conv_vec_i64_i32 has to tell the two apart.
+ *
+ * Conversions are done in place, so SRC and DST may be the same buffer:
+ * when the destination type is narrower, or as wide as the source type,
+ * each block is loaded completely before any of it is stored.  When it is
+ * wider, H5T_CONV only passes runs whose source and destination don't
+ * overlap.
+ *
+ * H5T__conv_vec_<kernel> uses the AVX2 version of the kernel when the CPU
+ * has AVX2 and the SSE2 version otherwise.
+ *-------------------------------------------------------------------------
+ */
+#define H5T_CONV_VEC_DISPATCH(K)                                              \
+static size_t                                                                 \
+H5_GLUE(H5T__conv_vec_, K)(const void *src, void *dst, size_t nelmts)         \
+{                                                                             \
+    size_t ret_value = 0;       /* Return value */                            \
+                                                                              \
+    FUNC_ENTER_STATIC_NOERR                                                   \
+                                                                              \
+    if(__builtin_cpu_supports("avx2"))                                        \
+        ret_value = H5_GLUE3(H5T__conv_vec_, K, _avx2)(src, dst, nelmts);     \
+    else                                                                      \
+        ret_value = H5_GLUE3(H5T__conv_vec_, K, _sse2)(src, dst, nelmts);     \
+                                                                              \
+    FUNC_LEAVE_NOAPI(ret_value)                                               \
+}
+
+H5T_CONV_VEC_DISPATCH(u8_f32)
+H5T_CONV_VEC_DISPATCH(i16_f32)
+H5T_CONV_VEC_DISPATCH(u16_f32)
+H5T_CONV_VEC_DISPATCH(i32_f32)
+H5T_CONV_VEC_DISPATCH(i32_f64)
+H5T_CONV_VEC_DISPATCH(f32_f64)
+H5T_CONV_VEC_DISPATCH(f64_f32)
+H5T_CONV_VEC_DISPATCH(i32_i64)
+H5T_CONV_VEC_DISPATCH(i64_i32)
+H5T_CONV_VEC_DISPATCH(i16be_f32)
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5T__conv_vec_bswap
+ *
+ * Purpose:	Reverse the byte order of NELMTS elements of SIZE bytes (2,
+ *              4, 8 or 16) which are STRIDE bytes apart in BUF.
+ *
+ *              Contiguous elements are swapped a vector at a time with the
+ *              AVX2 or SSE2 kernel, leaving the elements after the last
+ *              whole vector for the caller.  Strided elements are all
+ *              swapped, one at a time, with the byte swap instructions.
+ *
+ * Return:	Number of elements swapped
+ *
+ *-------------------------------------------------------------------------
+ */
+static size_t
+H5T__conv_vec_bswap(uint8_t *buf, size_t size, size_t stride, size_t nelmts)
+{
+    size_t      u;                      /* Local index variable */
+    size_t      ret_value = 0;          /* Return value */
+
+    FUNC_ENTER_STATIC_NOERR
+
+    if(stride == size) {
+        if(__builtin_cpu_supports("avx2"))
+            ret_value = H5T__conv_vec_bswap_avx2(buf, size, nelmts);
+        else
+            ret_value = H5T__conv_vec_bswap_sse2(buf, size, nelmts);
+    } /* end if */
+    else {
+        switch(size) {
+            case 2:
+                for(u = 0; u < nelmts; u++, buf += stride) {
+                    uint16_t x;
+
+                    HDmemcpy(&x, buf, sizeof(x));
+                    x = __builtin_bswap16(x);
+                    HDmemcpy(buf, &x, sizeof(x));
+                } /* end for */
+                break;
+
+            case 4:
+                for(u = 0; u < nelmts; u++, buf += stride) {
+                    uint32_t x;
+
+                    HDmemcpy(&x, buf, sizeof(x));
+                    x = __builtin_bswap32(x);
+                    HDmemcpy(buf, &x, sizeof(x));
+                } /* end for */
+                break;
+
+            case 8:
+                for(u = 0; u < nelmts; u++, buf += stride) {
+                    uint64_t x;
+
+                    HDmemcpy(&x, buf, sizeof(x));
+                    x = __builtin_bswap64(x);
+                    HDmemcpy(buf, &x, sizeof(x));
+                } /* end for */
+                break;
+
+            case 16:
+                for(u = 0; u < nelmts; u++, buf += stride) {
+                    uint64_t x[2];
+
+                    HDmemcpy(x, buf, sizeof(x));
+                    x[0] = __builtin_bswap64(x[0]);
+                    x[1] = __builtin_bswap64(x[1]);
+                    HDmemcpy(buf, &x[1], sizeof(x[1]));
+                    HDmemcpy(buf + 8, &x[0], sizeof(x[0]));
+                } /* end for */
+                break;
+
+            default:
+                HDassert(0 && "invalid element size");
+                nelmts = 0;
+                break;
+        } /* end switch */
+        ret_value = nelmts;
+    } /* end else */
+
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5T__conv_vec_bswap() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5T__conv_vec_u8_f32_sse2
+ *
+ * Purpose:	Convert blocks of 16 unsigned chars to floats with SSE2,
+ *              zero-extending the bytes to 32-bit integers first.
+ *
+ * Return:	Number of elements converted
+ *
+ *-------------------------------------------------------------------------
+ */
+static size_t
+H5T__conv_vec_u8_f32_sse2(const void *src, void *dst, size_t nelmts)
+{
+    const unsigned char *s = (const unsigned char *)src;
+    float       *d = (float *)dst;
+    const __m128i zero = _mm_setzero_si128();
+    size_t      nvec = nelmts & ~(size_t)15;    /* Number of elements to convert */
+    size_t      u;                              /* Local index variable */
+
+    FUNC_ENTER_STATIC_NOERR
+
+    for(u = 0; u < nvec; u += 16) {
+        __m128i v = _mm_loadu_si128((const __m128i *)(s + u));
+        __m128i lo = _mm_unpacklo_epi8(v, zero);
+        __m128i hi = _mm_unpackhi_epi8(v, zero);
+
+        _mm_storeu_ps(d + u, _mm_cvtepi32_ps(_mm_unpacklo_epi16(lo, zero)));
+        _mm_storeu_ps(d + u + 4, _mm_cvtepi32_ps(_mm_unpackhi_epi16(lo, zero)));
+        _mm_storeu_ps(d + u + 8, _mm_cvtepi32_ps(_mm_unpacklo_epi16(hi, zero)));
+        _mm_storeu_ps(d + u + 12, _mm_cvtepi32_ps(_mm_unpackhi_epi16(hi, zero)));
+    } /* end for */
+
+    FUNC_LEAVE_NOAPI(nvec)
+} /* end H5T__conv_vec_u8_f32_sse2() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5T__conv_vec_i16_f32_sse2
+ *
+ * Purpose:	Convert blocks of 8 shorts to floats with SSE2.  Each short
+ *              is sign-extended by duplicating it into both halves of a
+ *              32-bit lane and shifting it down arithmetically.
+ *
+ * Return:	Number of elements converted
+ *
+ *-------------------------------------------------------------------------
+ */
+static size_t
+H5T__conv_vec_i16_f32_sse2(const void *src, void *dst, size_t nelmts)
+{
+    const short *s = (const short *)src;
+    float       *d = (float *)dst;
+    size_t      nvec = nelmts & ~(size_t)7;     /* Number of elements to convert */
+    size_t      u;                              /* Local index variable */
+
+    FUNC_ENTER_STATIC_NOERR
+
+    for(u = 0; u < nvec; u += 8) {
+        __m128i v = _mm_loadu_si128((const __m128i *)(s + u));
+
+        _mm_storeu_ps(d + u, _mm_cvtepi32_ps(_mm_srai_epi32(_mm_unpacklo_epi16(v, v), 16)));
+        _mm_storeu_ps(d + u + 4, _mm_cvtepi32_ps(_mm_srai_epi32(_mm_unpackhi_epi16(v, v), 16)));
+    } /* end for */
+
+    FUNC_LEAVE_NOAPI(nvec)
+} /* end H5T__conv_vec_i16_f32_sse2() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5T__conv_vec_u16_f32_sse2
+ *
+ * Purpose:	Convert blocks of 8 unsigned shorts to floats with SSE2.
+ *
+ * Return:	Number of elements converted
+ *
+ *-------------------------------------------------------------------------
+ */
+static size_t
+H5T__conv_vec_u16_f32_sse2(const void *src, void *dst, size_t nelmts)
+{
+    const unsigned short *s = (const unsigned short *)src;
+    float       *d = (float *)dst;
+    const __m128i zero = _mm_setzero_si128();
+    size_t      nvec = nelmts & ~(size_t)7;     /* Number of elements to convert */
+    size_t      u;                              /* Local index variable */
+
+    FUNC_ENTER_STATIC_NOERR
+
+    for(u = 0; u < nvec; u += 8) {
+        __m128i v = _mm_loadu_si128((const __m128i *)(s + u));
+
+        _mm_storeu_ps(d + u, _mm_cvtepi32_ps(_mm_unpacklo_epi16(v, zero)));
+        _mm_storeu_ps(d + u + 4, _mm_cvtepi32_ps(_mm_unpackhi_epi16(v, zero)));
+    } /* end for */
+
+    FUNC_LEAVE_NOAPI(nvec)
+} /* end H5T__conv_vec_u16_f32_sse2() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5T__conv_vec_i32_f32_sse2
+ *
+ * Purpose:	Convert blocks of 8 ints to floats with SSE2.
+ *
+ * Return:	Number of elements converted
+ *
+ *-------------------------------------------------------------------------
+ */
+static size_t
+H5T__conv_vec_i32_f32_sse2(const void *src, void *dst, size_t nelmts)
+{
+    const int   *s = (const int *)src;
+    float       *d = (float *)dst;
+    size_t      nvec = nelmts & ~(size_t)7;     /* Number of elements to convert */
+    size_t      u;                              /* Local index variable */
+
+    FUNC_ENTER_STATIC_NOERR
+
+    for(u = 0; u < nvec; u += 8) {
+        __m128i a = _mm_loadu_si128((const __m128i *)(s + u));
+        __m128i b = _mm_loadu_si128((const __m128i *)(s + u + 4));
+
+        _mm_storeu_ps(d + u, _mm_cvtepi32_ps(a));
+        _mm_storeu_ps(d + u + 4, _mm_cvtepi32_ps(b));
+    } /* end for */
+
+    FUNC_LEAVE_NOAPI(nvec)
+} /* end H5T__conv_vec_i32_f32_sse2() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5T__conv_vec_i32_f64_sse2
+ *
+ * Purpose:	Convert blocks of 4 ints to doubles with SSE2.
+ *
+ * Return:	Number of elements converted
+ *
+ *-------------------------------------------------------------------------
+ */
+static size_t
+H5T__conv_vec_i32_f64_sse2(const void *src, void *dst, size_t nelmts)
+{
+    const int   *s = (const int *)src;
+    double      *d = (double *)dst;
+    size_t      nvec = nelmts & ~(size_t)3;     /* Number of elements to convert */
+    size_t      u;                              /* Local index variable */
+
+    FUNC_ENTER_STATIC_NOERR
+
+    for(u = 0; u < nvec; u += 4) {
+        __m128i v = _mm_loadu_si128((const __m128i *)(s + u));
+
+        _mm_storeu_pd(d + u, _mm_cvtepi32_pd(v));
+        _mm_storeu_pd(d + u + 2, _mm_cvtepi32_pd(_mm_srli_si128(v, 8)));
+    } /* end for */
+
+    FUNC_LEAVE_NOAPI(nvec)
+} /* end H5T__conv_vec_i32_f64_sse2() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5T__conv_vec_f32_f64_sse2
+ *
+ * Purpose:	Convert blocks of 4 floats to doubles with SSE2.
+ *
+ * Return:	Number of elements converted
+ *
+ *-------------------------------------------------------------------------
+ */
+static size_t
+H5T__conv_vec_f32_f64_sse2(const void *src, void *dst, size_t nelmts)
+{
+    const float *s = (const float *)src;
+    double      *d = (double *)dst;
+    size_t      nvec = nelmts & ~(size_t)3;     /* Number of elements to convert */
+    size_t      u;                              /* Local index variable */
+
+    FUNC_ENTER_STATIC_NOERR
+
+    for(u = 0; u < nvec; u += 4) {
+        __m128 v = _mm_loadu_ps(s + u);
+
+        _mm_storeu_pd(d + u, _mm_cvtps_pd(v));
+        _mm_storeu_pd(d + u + 2, _mm_cvtps_pd(_mm_movehl_ps(v, v)));
+    } /* end for */
+
+    FUNC_LEAVE_NOAPI(nvec)
+} /* end H5T__conv_vec_f32_f64_sse2() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5T__conv_vec_f64_f32_sse2
+ *
+ * Purpose:	Convert blocks of 4 doubles to floats with SSE2.  As in
+ *              H5T_CONV_Ff_NOEX_CORE, values beyond the range of float
+ *              become float infinities.
+ *
+ * Return:	Number of elements converted
+ *
+ *-------------------------------------------------------------------------
+ */
+static size_t
+H5T__conv_vec_f64_f32_sse2(const void *src, void *dst, size_t nelmts)
+{
+    const double *s = (const double *)src;
+    float       *d = (float *)dst;
+    const __m128d max = _mm_set1_pd((double)FLT_MAX);
+    const __m128d min = _mm_set1_pd(-(double)FLT_MAX);
+    const __m128d pos_inf = _mm_set1_pd((double)H5T_NATIVE_FLOAT_POS_INF_g);
+    const __m128d neg_inf = _mm_set1_pd((double)H5T_NATIVE_FLOAT_NEG_INF_g);
+    size_t      nvec = nelmts & ~(size_t)3;     /* Number of elements to convert */
+    size_t      u;                              /* Local index variable */
+
+    FUNC_ENTER_STATIC_NOERR
+
+    for(u = 0; u < nvec; u += 4) {
+        __m128d v[2];
+        __m128d hi, lo;
+        unsigned k;
+
+        v[0] = _mm_loadu_pd(s + u);
+        v[1] = _mm_loadu_pd(s + u + 2);
+        for(k = 0; k < 2; k++) {
+            hi = _mm_cmpgt_pd(v[k], max);
+            lo = _mm_cmplt_pd(v[k], min);
+            v[k] = _mm_or_pd(_mm_andnot_pd(hi, v[k]), _mm_and_pd(hi, pos_inf));
+            v[k] = _mm_or_pd(_mm_andnot_pd(lo, v[k]), _mm_and_pd(lo, neg_inf));
+        } /* end for */
+        _mm_storeu_ps(d + u, _mm_movelh_ps(_mm_cvtpd_ps(v[0]), _mm_cvtpd_ps(v[1])));
+    } /* end for */
+
+    FUNC_LEAVE_NOAPI(nvec)
+} /* end H5T__conv_vec_f64_f32_sse2() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5T__conv_vec_i32_i64_sse2
+ *
+ * Purpose:	Sign-extend blocks of 4 ints to 64-bit integers with SSE2.
+ *
+ * Return:	Number of elements converted
+ *
+ *-------------------------------------------------------------------------
+ */
+static size_t
+H5T__conv_vec_i32_i64_sse2(const void *src, void *dst, size_t nelmts)
+{
+    const int   *s = (const int *)src;
+    long long   *d = (long long *)dst;
+    size_t      nvec = nelmts & ~(size_t)3;     /* Number of elements to convert */
+    size_t      u;                              /* Local index variable */
+
+    FUNC_ENTER_STATIC_NOERR
+
+    for(u = 0; u < nvec; u += 4) {
+        __m128i v = _mm_loadu_si128((const __m128i *)(s + u));
+        __m128i sign = _mm_srai_epi32(v, 31);
+
+        _mm_storeu_si128((__m128i *)(d + u), _mm_unpacklo_epi32(v, sign));
+        _mm_storeu_si128((__m128i *)(d + u + 2), _mm_unpackhi_epi32(v, sign));
+    } /* end for */
+
+    FUNC_LEAVE_NOAPI(nvec)
+} /* end H5T__conv_vec_i32_i64_sse2() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5T__conv_vec_i64_i32_sse2
+ *
+ * Purpose:	Convert blocks of 4 64-bit integers to ints with SSE2.  A
+ *              value fits in an int when its high half is the sign
+ *              extension of its low half; blocks with a value which
+ *              doesn't fit are clamped one element at a time, as in
+ *              H5T_CONV_Xx_NOEX_CORE.  Without H5_WANT_DCONV_EXCEPTION
+ *              values are truncated to their low halves instead, as in
+ *              H5T_CONV_NO_EXCEPT_CORE.
+ *
+ * Return:	Number of elements converted
+ *
+ *-------------------------------------------------------------------------
+ */
+static size_t
+H5T__conv_vec_i64_i32_sse2(const void *src, void *dst, size_t nelmts)
+{
+    const long long *s = (const long long *)src;
+    int         *d = (int *)dst;
+#ifdef H5_WANT_DCONV_EXCEPTION
+    const __m128i lo_mask = _mm_set_epi32(0, -1, 0, -1);       /* Low halves of 64-bit lanes */
+#endif /* H5_WANT_DCONV_EXCEPTION */
+    size_t      nvec = nelmts & ~(size_t)3;     /* Number of elements to convert */
+    size_t      u;                              /* Local index variable */
+
+    FUNC_ENTER_STATIC_NOERR
+
+    for(u = 0; u < nvec; u += 4) {
+        __m128i v[2];
+#ifdef H5_WANT_DCONV_EXCEPTION
+        __m128i ext[2];
+        unsigned k;
+#endif /* H5_WANT_DCONV_EXCEPTION */
+
+        v[0] = _mm_loadu_si128((const __m128i *)(s + u));
+        v[1] = _mm_loadu_si128((const __m128i *)(s + u + 2));
+#ifdef H5_WANT_DCONV_EXCEPTION
+        for(k = 0; k < 2; k++) {
+            __m128i sign = _mm_srai_epi32(_mm_shuffle_epi32(v[k], _MM_SHUFFLE(2, 2, 0, 0)), 31);
+
+            ext[k] = _mm_or_si128(_mm_and_si128(v[k], lo_mask), _mm_andnot_si128(lo_mask, sign));
+        } /* end for */
+
+        if(0xFFFF == _mm_movemask_epi8(_mm_and_si128(_mm_cmpeq_epi32(ext[0], v[0]), _mm_cmpeq_epi32(ext[1], v[1]))))
+            _mm_storeu_si128((__m128i *)(d + u),
+                    _mm_unpacklo_epi64(_mm_shuffle_epi32(v[0], _MM_SHUFFLE(3, 3, 2, 0)),
+                        _mm_shuffle_epi32(v[1], _MM_SHUFFLE(3, 3, 2, 0))));
+        else {
+            long long t[4];
+
+            _mm_storeu_si128((__m128i *)t, v[0]);
+            _mm_storeu_si128((__m128i *)(t + 2), v[1]);
+            for(k = 0; k < 4; k++)
+                d[u + k] = t[k] > INT_MAX ? INT_MAX : (t[k] < INT_MIN ? INT_MIN : (int)t[k]);
+        } /* end else */
+#else /* H5_WANT_DCONV_EXCEPTION */
+        _mm_storeu_si128((__m128i *)(d + u),
+                _mm_unpacklo_epi64(_mm_shuffle_epi32(v[0], _MM_SHUFFLE(3, 3, 2, 0)),
+                    _mm_shuffle_epi32(v[1], _MM_SHUFFLE(3, 3, 2, 0))));
+#endif /* H5_WANT_DCONV_EXCEPTION */
+    } /* end for */
+
+    FUNC_LEAVE_NOAPI(nvec)
+} /* end H5T__conv_vec_i64_i32_sse2() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5T__conv_vec_u8_f32_avx2
+ *
+ * Purpose:	Convert blocks of 16 unsigned chars to floats with AVX2.
+ *
+ * Return:	Number of elements converted
+ *
+ *-------------------------------------------------------------------------
+ */
+static size_t
+H5T__conv_vec_u8_f32_avx2(const void *src, void *dst, size_t nelmts)
+{
+    const unsigned char *s = (const unsigned char *)src;
+    float       *d = (float *)dst;
+    size_t      nvec = nelmts & ~(size_t)15;    /* Number of elements to convert */
+    size_t      u;                              /* Local index variable */
+
+    FUNC_ENTER_STATIC_NOERR
+
+    for(u = 0; u < nvec; u += 16) {
+        __m128i v = _mm_loadu_si128((const __m128i *)(s + u));
+
+        _mm256_storeu_ps(d + u, _mm256_cvtepi32_ps(_mm256_cvtepu8_epi32(v)));
+        _mm256_storeu_ps(d + u + 8, _mm256_cvtepi32_ps(_mm256_cvtepu8_epi32(_mm_srli_si128(v, 8))));
+    } /* end for */
+
+    FUNC_LEAVE_NOAPI(nvec)
+} /* end H5T__conv_vec_u8_f32_avx2() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5T__conv_vec_i16_f32_avx2
+ *
+ * Purpose:	Convert blocks of 16 shorts to floats with AVX2.
+ *
+ * Return:	Number of elements converted
+ *
+ *-------------------------------------------------------------------------
+ */
+static size_t
+H5T__conv_vec_i16_f32_avx2(const void *src, void *dst, size_t nelmts)
+{
+    const short *s = (const short *)src;
+    float       *d = (float *)dst;
+    size_t      nvec = nelmts & ~(size_t)15;    /* Number of elements to convert */
+    size_t      u;                              /* Local index variable */
+
+    FUNC_ENTER_STATIC_NOERR
+
+    for(u = 0; u < nvec; u += 16) {
+        __m128i a = _mm_loadu_si128((const __m128i *)(s + u));
+        __m128i b = _mm_loadu_si128((const __m128i *)(s + u + 8));
+
+        _mm256_storeu_ps(d + u, _mm256_cvtepi32_ps(_mm256_cvtepi16_epi32(a)));
+        _mm256_storeu_ps(d + u + 8, _mm256_cvtepi32_ps(_mm256_cvtepi16_epi32(b)));
+    } /* end for */
+
+    FUNC_LEAVE_NOAPI(nvec)
+} /* end H5T__conv_vec_i16_f32_avx2() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5T__conv_vec_u16_f32_avx2
+ *
+ * Purpose:	Convert blocks of 16 unsigned shorts to floats with AVX2.
+ *
+ * Return:	Number of elements converted
+ *
+ *-------------------------------------------------------------------------
+ */
+static size_t
+H5T__conv_vec_u16_f32_avx2(const void *src, void *dst, size_t nelmts)
+{
+    const unsigned short *s = (const unsigned short *)src;
+    float       *d = (float *)dst;
+    size_t      nvec = nelmts & ~(size_t)15;    /* Number of elements to convert */
+    size_t      u;                              /* Local index variable */
+
+    FUNC_ENTER_STATIC_NOERR
+
+    for(u = 0; u < nvec; u += 16) {
+        __m128i a = _mm_loadu_si128((const __m128i *)(s + u));
+        __m128i b = _mm_loadu_si128((const __m128i *)(s + u + 8));
+
+        _mm256_storeu_ps(d + u, _mm256_cvtepi32_ps(_mm256_cvtepu16_epi32(a)));
+        _mm256_storeu_ps(d + u + 8, _mm256_cvtepi32_ps(_mm256_cvtepu16_epi32(b)));
+    } /* end for */
+
+    FUNC_LEAVE_NOAPI(nvec)
+} /* end H5T__conv_vec_u16_f32_avx2() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5T__conv_vec_i32_f32_avx2
+ *
+ * Purpose:	Convert blocks of 16 ints to floats with AVX2.
+ *
+ * Return:	Number of elements converted
+ *
+ *-------------------------------------------------------------------------
+ */
+static size_t
+H5T__conv_vec_i32_f32_avx2(const void *src, void *dst, size_t nelmts)
+{
+    const int   *s = (const int *)src;
+    float       *d = (float *)dst;
+    size_t      nvec = nelmts & ~(size_t)15;    /* Number of elements to convert */
+    size_t      u;                              /* Local index variable */
+
+    FUNC_ENTER_STATIC_NOERR
+
+    for(u = 0; u < nvec; u += 16) {
+        __m256i a = _mm256_loadu_si256((const __m256i *)(s + u));
+        __m256i b = _mm256_loadu_si256((const __m256i *)(s + u + 8));
+
+        _mm256_storeu_ps(d + u, _mm256_cvtepi32_ps(a));
+        _mm256_storeu_ps(d + u + 8, _mm256_cvtepi32_ps(b));
+    } /* end for */
+
+    FUNC_LEAVE_NOAPI(nvec)
+} /* end H5T__conv_vec_i32_f32_avx2() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5T__conv_vec_i32_f64_avx2
+ *
+ * Purpose:	Convert blocks of 8 ints to doubles with AVX2.
+ *
+ * Return:	Number of elements converted
+ *
+ *-------------------------------------------------------------------------
+ */
+static size_t
+H5T__conv_vec_i32_f64_avx2(const void *src, void *dst, size_t nelmts)
+{
+    const int   *s = (const int *)src;
+    double      *d = (double *)dst;
+    size_t      nvec = nelmts & ~(size_t)7;     /* Number of elements to convert */
+    size_t      u;                              /* Local index variable */
+
+    FUNC_ENTER_STATIC_NOERR
+
+    for(u = 0; u < nvec; u += 8) {
+        __m128i a = _mm_loadu_si128((const __m128i *)(s + u));
+        __m128i b = _mm_loadu_si128((const __m128i *)(s + u + 4));
+
+        _mm256_storeu_pd(d + u, _mm256_cvtepi32_pd(a));
+        _mm256_storeu_pd(d + u + 4, _mm256_cvtepi32_pd(b));
+    } /* end for */
+
+    FUNC_LEAVE_NOAPI(nvec)
+} /* end H5T__conv_vec_i32_f64_avx2() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5T__conv_vec_f32_f64_avx2
+ *
+ * Purpose:	Convert blocks of 8 floats to doubles with AVX2.
+ *
+ * Return:	Number of elements converted
+ *
+ *-------------------------------------------------------------------------
+ */
+static size_t
+H5T__conv_vec_f32_f64_avx2(const void *src, void *dst, size_t nelmts)
+{
+    const float *s = (const float *)src;
+    double      *d = (double *)dst;
+    size_t      nvec = nelmts & ~(size_t)7;     /* Number of elements to convert */
+    size_t      u;                              /* Local index variable */
+
+    FUNC_ENTER_STATIC_NOERR
+
+    for(u = 0; u < nvec; u += 8) {
+        __m128 a = _mm_loadu_ps(s + u);
+        __m128 b = _mm_loadu_ps(s + u + 4);
+
+        _mm256_storeu_pd(d + u, _mm256_cvtps_pd(a));
+        _mm256_storeu_pd(d + u + 4, _mm256_cvtps_pd(b));
+    } /* end for */
+
+    FUNC_LEAVE_NOAPI(nvec)
+} /* end H5T__conv_vec_f32_f64_avx2() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5T__conv_vec_f64_f32_avx2
+ *
+ * Purpose:	Convert blocks of 8 doubles to floats with AVX2, mapping
+ *              values beyond the range of float to infinities.
+ *
+ * Return:	Number of elements converted
+ *
+ *-------------------------------------------------------------------------
+ */
+static size_t
+H5T__conv_vec_f64_f32_avx2(const void *src, void *dst, size_t nelmts)
+{
+    const double *s = (const double *)src;
+    float       *d = (float *)dst;
+    const __m256d max = _mm256_set1_pd((double)FLT_MAX);
+    const __m256d min = _mm256_set1_pd(-(double)FLT_MAX);
+    const __m256d pos_inf = _mm256_set1_pd((double)H5T_NATIVE_FLOAT_POS_INF_g);
+    const __m256d neg_inf = _mm256_set1_pd((double)H5T_NATIVE_FLOAT_NEG_INF_g);
+    size_t      nvec = nelmts & ~(size_t)7;     /* Number of elements to convert */
+    size_t      u;                              /* Local index variable */
+
+    FUNC_ENTER_STATIC_NOERR
+
+    for(u = 0; u < nvec; u += 8) {
+        __m256d v[2];
+        unsigned k;
+
+        v[0] = _mm256_loadu_pd(s + u);
+        v[1] = _mm256_loadu_pd(s + u + 4);
+        for(k = 0; k < 2; k++) {
+            v[k] = _mm256_blendv_pd(v[k], pos_inf, _mm256_cmp_pd(v[k], max, _CMP_GT_OQ));
+            v[k] = _mm256_blendv_pd(v[k], neg_inf, _mm256_cmp_pd(v[k], min, _CMP_LT_OQ));
+        } /* end for */
+        _mm_storeu_ps(d + u, _mm256_cvtpd_ps(v[0]));
+        _mm_storeu_ps(d + u + 4, _mm256_cvtpd_ps(v[1]));
+    } /* end for */
+
+    FUNC_LEAVE_NOAPI(nvec)
+} /* end H5T__conv_vec_f64_f32_avx2() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5T__conv_vec_i32_i64_avx2
+ *
+ * Purpose:	Sign-extend blocks of 8 ints to 64-bit integers with AVX2.
+ *
+ * Return:	Number of elements converted
+ *
+ *-------------------------------------------------------------------------
+ */
+static size_t
+H5T__conv_vec_i32_i64_avx2(const void *src, void *dst, size_t nelmts)
+{
+    const int   *s = (const int *)src;
+    long long   *d = (long long *)dst;
+    size_t      nvec = nelmts & ~(size_t)7;     /* Number of elements to convert */
+    size_t      u;                              /* Local index variable */
+
+    FUNC_ENTER_STATIC_NOERR
+
+    for(u = 0; u < nvec; u += 8) {
+        __m128i a = _mm_loadu_si128((const __m128i *)(s + u));
+        __m128i b = _mm_loadu_si128((const __m128i *)(s + u + 4));
+
+        _mm256_storeu_si256((__m256i *)(d + u), _mm256_cvtepi32_epi64(a));
+        _mm256_storeu_si256((__m256i *)(d + u + 4), _mm256_cvtepi32_epi64(b));
+    } /* end for */
+
+    FUNC_LEAVE_NOAPI(nvec)
+} /* end H5T__conv_vec_i32_i64_avx2() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5T__conv_vec_i64_i32_avx2
+ *
+ * Purpose:	Convert blocks of 8 64-bit integers to ints with AVX2,
+ *              clamping them to the range of int first.  Without
+ *              H5_WANT_DCONV_EXCEPTION they're truncated to their low
+ *              halves instead, as in H5T_CONV_NO_EXCEPT_CORE.
+ *
+ * Return:	Number of elements converted
+ *
+ *-------------------------------------------------------------------------
+ */
+static size_t
+H5T__conv_vec_i64_i32_avx2(const void *src, void *dst, size_t nelmts)
+{
+    const long long *s = (const long long *)src;
+    int         *d = (int *)dst;
+#ifdef H5_WANT_DCONV_EXCEPTION
+    const __m256i max = _mm256_set1_epi64x((long long)INT_MAX);
+    const __m256i min = _mm256_set1_epi64x((long long)INT_MIN);
+#endif /* H5_WANT_DCONV_EXCEPTION */
+    const __m256i lo_idx = _mm256_setr_epi32(0, 2, 4, 6, 0, 2, 4, 6);  /* Low halves of 64-bit lanes */
+    size_t      nvec = nelmts & ~(size_t)7;     /* Number of elements to convert */
+    size_t      u;                              /* Local index variable */
+
+    FUNC_ENTER_STATIC_NOERR
+
+    for(u = 0; u < nvec; u += 8) {
+        __m256i v[2];
+        unsigned k;
+
+        v[0] = _mm256_loadu_si256((const __m256i *)(s + u));
+        v[1] = _mm256_loadu_si256((const __m256i *)(s + u + 4));
+        for(k = 0; k < 2; k++) {
+#ifdef H5_WANT_DCONV_EXCEPTION
+            v[k] = _mm256_blendv_epi8(v[k], max, _mm256_cmpgt_epi64(v[k], max));
+            v[k] = _mm256_blendv_epi8(v[k], min, _mm256_cmpgt_epi64(min, v[k]));
+#endif /* H5_WANT_DCONV_EXCEPTION */
+            v[k] = _mm256_permutevar8x32_epi32(v[k], lo_idx);
+        } /* end for */
+        _mm_storeu_si128((__m128i *)(d + u), _mm256_castsi256_si128(v[0]));
+        _mm_storeu_si128((__m128i *)(d + u + 4), _mm256_castsi256_si128(v[1]));
+    } /* end for */
+
+    FUNC_LEAVE_NOAPI(nvec)
+} /* end H5T__conv_vec_i64_i32_avx2() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5T__conv_vec_i16be_f32_sse2
+ *
+ * Purpose:	Convert blocks of 8 big-endian 16-bit integers to floats
+ *              with SSE2, swapping the bytes of each one and then
+ *              converting it like H5T__conv_vec_i16_f32_sse2.
+ *
+ *              The destination is twice as wide as the source, so the
+ *              blocks are converted from last to first: when SRC and DST
+ *              are the same buffer, the caller must convert the elements
+ *              after the last whole block before calling this.
+ *
+ * Return:	Number of elements converted
+ *
+ *-------------------------------------------------------------------------
+ */
+static size_t
+H5T__conv_vec_i16be_f32_sse2(const void *src, void *dst, size_t nelmts)
+{
+    const uint8_t *s = (const uint8_t *)src;
+    float       *d = (float *)dst;
+    size_t      nvec = nelmts & ~(size_t)7;     /* Number of elements to convert */
+    size_t      u;                              /* Local index variable */
+
+    FUNC_ENTER_STATIC_NOERR
+
+    for(u = nvec; u > 0; u -= 8) {
+        __m128i v = _mm_loadu_si128((const __m128i *)(s + 2 * (u - 8)));
+
+        v = _mm_or_si128(_mm_slli_epi16(v, 8), _mm_srli_epi16(v, 8));
+        _mm_storeu_ps(d + u - 8, _mm_cvtepi32_ps(_mm_srai_epi32(_mm_unpacklo_epi16(v, v), 16)));
+        _mm_storeu_ps(d + u - 4, _mm_cvtepi32_ps(_mm_srai_epi32(_mm_unpackhi_epi16(v, v), 16)));
+    } /* end for */
+
+    FUNC_LEAVE_NOAPI(nvec)
+} /* end H5T__conv_vec_i16be_f32_sse2() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5T__conv_vec_i16be_f32_avx2
+ *
+ * Purpose:	Convert blocks of 8 big-endian 16-bit integers to floats
+ *              with AVX2, from last to first (see
+ *              H5T__conv_vec_i16be_f32_sse2).
+ *
+ * Return:	Number of elements converted
+ *
+ *-------------------------------------------------------------------------
+ */
+static size_t
+H5T__conv_vec_i16be_f32_avx2(const void *src, void *dst, size_t nelmts)
+{
+    const uint8_t *s = (const uint8_t *)src;
+    float       *d = (float *)dst;
+    const __m128i swap = _mm_setr_epi8(1, 0, 3, 2, 5, 4, 7, 6, 9, 8, 11, 10, 13, 12, 15, 14);
+    size_t      nvec = nelmts & ~(size_t)7;     /* Number of elements to convert */
+    size_t      u;                              /* Local index variable */
+
+    FUNC_ENTER_STATIC_NOERR
+
+    for(u = nvec; u > 0; u -= 8) {
+        __m128i v = _mm_loadu_si128((const __m128i *)(s + 2 * (u - 8)));
+
+        v = _mm_shuffle_epi8(v, swap);
+        _mm256_storeu_ps(d + u - 8, _mm256_cvtepi32_ps(_mm256_cvtepi16_epi32(v)));
+    } /* end for */
+
+    FUNC_LEAVE_NOAPI(nvec)
+} /* end H5T__conv_vec_i16be_f32_avx2() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5T__conv_vec_bswap_sse2
+ *
+ * Purpose:	Reverse the byte order of contiguous elements of SIZE bytes
+ *              (2, 4, 8 or 16), 16 bytes at a time with SSE2.  The bytes of
+ *              each 16-bit word are swapped with shifts, then the words of
+ *              each element are reversed with word and doubleword
+ *              shuffles.
+ *
+ * Return:	Number of elements swapped
+ *
+ *-------------------------------------------------------------------------
+ */
+static size_t
+H5T__conv_vec_bswap_sse2(uint8_t *buf, size_t size, size_t nelmts)
+{
+    size_t      nbytes = (nelmts * size) & ~(size_t)15; /* Number of bytes to swap */
+    size_t      u;                              /* Local index variable */
+
+    FUNC_ENTER_STATIC_NOERR
+
+    for(u = 0; u < nbytes; u += 16) {
+        __m128i v = _mm_loadu_si128((const __m128i *)(buf + u));
+
+        v = _mm_or_si128(_mm_slli_epi16(v, 8), _mm_srli_epi16(v, 8));
+        switch(size) {
+            case 4:
+                v = _mm_shufflelo_epi16(v, _MM_SHUFFLE(2, 3, 0, 1));
+                v = _mm_shufflehi_epi16(v, _MM_SHUFFLE(2, 3, 0, 1));
+                break;
+
+            case 8:
+                v = _mm_shufflelo_epi16(v, _MM_SHUFFLE(0, 1, 2, 3));
+                v = _mm_shufflehi_epi16(v, _MM_SHUFFLE(0, 1, 2, 3));
+                break;
+
+            case 16:
+                v = _mm_shufflelo_epi16(v, _MM_SHUFFLE(0, 1, 2, 3));
+                v = _mm_shufflehi_epi16(v, _MM_SHUFFLE(0, 1, 2, 3));
+                v = _mm_shuffle_epi32(v, _MM_SHUFFLE(1, 0, 3, 2));
+                break;
+
+            default:
+                break;
+        } /* end switch */
+        _mm_storeu_si128((__m128i *)(buf + u), v);
+    } /* end for */
+
+    FUNC_LEAVE_NOAPI(nbytes / size)
+} /* end H5T__conv_vec_bswap_sse2() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5T__conv_vec_bswap_avx2
+ *
+ * Purpose:	Reverse the byte order of contiguous elements of SIZE bytes
+ *              (2, 4, 8 or 16), 32 bytes at a time with one AVX2 byte
+ *              shuffle.  No element crosses a 16-byte lane, so the same
+ *              in-lane shuffle works for every size.
+ *
+ * Return:	Number of elements swapped
+ *
+ *-------------------------------------------------------------------------
+ */
+static size_t
+H5T__conv_vec_bswap_avx2(uint8_t *buf, size_t size, size_t nelmts)
+{
+    uint8_t     idx[32];                        /* Shuffle control bytes */
+    __m256i     swap;                           /* Shuffle control vector */
+    size_t      nbytes = (nelmts * size) & ~(size_t)31; /* Number of bytes to swap */
+    size_t      u;                              /* Local index variable */
+
+    FUNC_ENTER_STATIC_NOERR
+
+    /* Each byte comes from the mirror position within its element */
+    for(u = 0; u < 32; u++)
+        idx[u] = (uint8_t)((u & 15 & ~(size - 1)) + (size - 1) - (u & (size - 1)));
+    swap = _mm256_loadu_si256((const __m256i *)idx);
+
+    for(u = 0; u < nbytes; u += 32) {
+        __m256i v = _mm256_loadu_si256((const __m256i *)(buf + u));
+
+        _mm256_storeu_si256((__m256i *)(buf + u), _mm256_shuffle_epi8(v, swap));
+    } /* end for */
+
+    FUNC_LEAVE_NOAPI(nbytes / size)
+} /* end H5T__conv_vec_bswap_avx2() */
+#endif /* H5T_CONV_SIMD */
+
 
 /*-------------------------------------------------------------------------
  * Function:	H5T__conv_noop
@@ -1174,6 +2222,16 @@ H5T__conv_order_opt(hid_t src_id, hid_t dst_id, H5T_cdata_t *cdata,
             } /* end if */
 
             buf_stride = buf_stride ? buf_stride : src->shared->size;
+#ifdef H5T_CONV_SIMD
+            /* Swap whole vectors of contiguous elements, or every strided
+             * element; the loops below swap whatever is left */
+            if(src->shared->size > 1) {
+                size_t nswap = H5T__conv_vec_bswap(buf, src->shared->size, buf_stride, nelmts);
+
+                buf += nswap * buf_stride;
+                nelmts -= nswap;
+            } /* end if */
+#endif /* H5T_CONV_SIMD */
             switch(src->shared->size) {
                 case 1:
                     /*no-op*/
@@ -1562,6 +2620,15 @@ H5T__conv_order(hid_t src_id, hid_t dst_id, H5T_cdata_t *cdata, size_t nelmts,
                 HGOTO_ERROR(H5E_ARGS, H5E_BADTYPE, FAIL, "not a datatype")
 
             buf_stride = buf_stride ? buf_stride : src->shared->size;
+#ifdef H5T_CONV_SIMD
+            if(src->shared->size == 2 || src->shared->size == 4 ||
+                    src->shared->size == 8 || src->shared->size == 16) {
+                size_t nswap = H5T__conv_vec_bswap(buf, src->shared->size, buf_stride, nelmts);
+
+                buf += nswap * buf_stride;
+                nelmts -= nswap;
+            } /* end if */
+#endif /* H5T_CONV_SIMD */
             md = src->shared->size / 2;
             for(i = 0; i < nelmts; i++, buf += buf_stride)
                 for(j = 0; j < md; j++)
@@ -1860,6 +2927,7 @@ H5T_conv_struct_free(H5T_conv_struct_t *priv)
     H5MM_xfree(src_memb_id);
     H5MM_xfree(dst_memb_id);
     H5MM_xfree(priv->memb_path);
+    H5MM_xfree(priv->subset_info.copies);
 
     FUNC_LEAVE_NOAPI((H5T_conv_struct_t *)H5MM_xfree(priv))
 } /* end H5T_conv_struct_free() */
@@ -1904,6 +2972,11 @@ H5T_conv_struct_free(H5T_conv_struct_t *priv)
  *              The optimization is simply moving data to the appropriate
  *              places in the buffer.
  *
+ *              More generally, when no member needs converting but members
+ *              are left out or moved, a copy plan is built: one run of
+ *              bytes to copy for each group of members which are adjacent,
+ *              in the same order, in both the source and the destination.
+ *
  * Return:	Non-negative on success/Negative on failure
  *
  * Programmer:	Robb Matzke
@@ -1937,11 +3010,6 @@ H5T_conv_struct_init(H5T_t *src, H5T_t *dst, H5T_cdata_t *cdata)
         src2dst = priv->src2dst;
         priv->src_nmembs = src_nmembs;
 
-        /* The flag of special optimization to indicate if source members and destination
-         * members are a subset of each other.  Initialize it to FALSE */
-        priv->subset_info.subset = H5T_SUBSET_FALSE;
-        priv->subset_info.copy_size = 0;
-
         /*
          * Insure that members are sorted.
          */
@@ -2009,6 +3077,13 @@ H5T_conv_struct_init(H5T_t *src, H5T_t *dst, H5T_cdata_t *cdata)
     /* The compound conversion functions need a background buffer */
     cdata->need_bkg = H5T_BKG_YES;
 
+    /* The flag of special optimization to indicate if source members and destination
+     * members are a subset of each other.  Initialize it to FALSE */
+    priv->subset_info.subset = H5T_SUBSET_FALSE;
+    priv->subset_info.copy_size = 0;
+    priv->subset_info.ncopies = 0;
+    priv->subset_info.copies = (H5T_subset_copy_t *)H5MM_xfree(priv->subset_info.copies);
+
     if(src_nmembs < dst_nmembs) {
         priv->subset_info.subset = H5T_SUBSET_SRC;
         for(i = 0; i < src_nmembs; i++) {
@@ -2049,6 +3124,50 @@ H5T_conv_struct_init(H5T_t *src, H5T_t *dst, H5T_cdata_t *cdata)
             * the case should have been handled as noop earlier in H5Dio.c. */
         {;}
 
+    /* Otherwise, if no member needs converting, build the copy plan */
+    if(priv->subset_info.subset == H5T_SUBSET_FALSE) {
+        H5T_subset_copy_t *copies;
+        size_t ncopies = 0;
+
+        for(i = 0; i < src_nmembs; i++)
+            if(src2dst[i] >= 0 && priv->memb_path[i]->is_noop == FALSE)
+                break;
+        if(i == src_nmembs && src_nmembs > 0) {
+            if(NULL == (copies = (H5T_subset_copy_t *)H5MM_malloc(src_nmembs * sizeof(H5T_subset_copy_t)))) {
+                cdata->priv = H5T_conv_struct_free(priv);
+                HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "memory allocation failed")
+            } /* end if */
+
+            /* The source members are sorted by offset, so members adjacent
+             * in both types follow each other here */
+            for(i = 0; i < src_nmembs; i++) {
+                const H5T_cmemb_t *src_memb = &src->shared->u.compnd.memb[i];
+                const H5T_cmemb_t *dst_memb;
+
+                if(src2dst[i] < 0)
+                    continue;
+                dst_memb = &dst->shared->u.compnd.memb[src2dst[i]];
+                if(ncopies > 0 && copies[ncopies - 1].src_offset + copies[ncopies - 1].size == src_memb->offset &&
+                        copies[ncopies - 1].dst_offset + copies[ncopies - 1].size == dst_memb->offset)
+                    copies[ncopies - 1].size += dst_memb->size;
+                else {
+                    copies[ncopies].src_offset = src_memb->offset;
+                    copies[ncopies].dst_offset = dst_memb->offset;
+                    copies[ncopies].size = dst_memb->size;
+                    ncopies++;
+                } /* end else */
+            } /* end for */
+
+            if(ncopies > 0) {
+                priv->subset_info.subset = H5T_SUBSET_PLAN;
+                priv->subset_info.ncopies = ncopies;
+                priv->subset_info.copies = copies;
+            } /* end if */
+            else
+                H5MM_xfree(copies);
+        } /* end if */
+    } /* end if */
+
     cdata->recalc = FALSE;
 
 done:
@@ -2190,6 +3309,30 @@ H5T__conv_struct(hid_t src_id, hid_t dst_id, H5T_cdata_t *cdata, size_t nelmts,
             H5T__sort_value(dst, NULL);
             src2dst = priv->src2dst;
 
+            /*
+             * If no member needs converting, copy the runs of the copy plan
+             * to the background buffer and the background buffer back.
+             */
+            if(priv->subset_info.subset == H5T_SUBSET_PLAN) {
+                size_t s_stride = buf_stride ? buf_stride : src->shared->size;
+                size_t b_stride = (buf_stride && bkg_stride) ? bkg_stride : dst->shared->size;
+
+                for(elmtno = 0; elmtno < nelmts; elmtno++) {
+                    for(u = 0; u < priv->subset_info.ncopies; u++)
+                        HDmemcpy(xbkg + priv->subset_info.copies[u].dst_offset,
+                                xbuf + priv->subset_info.copies[u].src_offset,
+                                priv->subset_info.copies[u].size);
+                    xbuf += s_stride;
+                    xbkg += b_stride;
+                } /* end for */
+                for(xbuf = buf, xbkg = bkg, elmtno = 0; elmtno < nelmts; elmtno++) {
+                    HDmemmove(xbuf, xbkg, dst->shared->size);
+                    xbuf += buf_stride ? buf_stride : dst->shared->size;
+                    xbkg += b_stride;
+                } /* end for */
+                break;
+            } /* end if */
+
             /*
              * Direction of conversion and striding through background.
              */
@@ -2340,7 +3483,9 @@ done:
  *                                                 TYPE5 E;
  *                                             };
  *              The optimization is simply moving data to the appropriate
- *              places in the buffer.
+ *              places in the buffer.  When no conversion is needed but
+ *              members are left out or moved, the runs of the copy plan
+ *              built by H5T_conv_struct_init() are copied instead.
  *
  * Return:	Non-negative on success/Negative on failure
  *
@@ -2491,6 +3636,21 @@ H5T__conv_struct_opt(hid_t src_id, hid_t dst_id, H5T_cdata_t *cdata,
                     xbkg += bkg_stride;
                 } /* end for */
             } /* end if */
+            else if(priv->subset_info.subset == H5T_SUBSET_PLAN) {
+                const H5T_subset_copy_t *copies = priv->subset_info.copies;
+                size_t ncopies = priv->subset_info.ncopies;
+
+                /* No member needs converting, so copy the runs of members
+                 * straight to their places in the background buffer */
+                for(xbuf = buf, xbkg = bkg, elmtno = 0; elmtno < nelmts; elmtno++) {
+                    for(u = 0; u < ncopies; u++)
+                        HDmemcpy(xbkg + copies[u].dst_offset, xbuf + copies[u].src_offset, copies[u].size);
+
+                    /* Update pointers */
+                    xbuf += buf_stride;
+                    xbkg += bkg_stride;
+                } /* end for */
+            } /* end else-if */
             else {
                 /*
                  * For each member where the destination is not larger than the
@@ -5968,7 +7128,7 @@ H5T__conv_int_long(hid_t src_id, hid_t dst_id, H5T_cdata_t *cdata,
     size_t nelmts, size_t buf_stride, size_t H5_ATTR_UNUSED bkg_stride,
     void *buf, void H5_ATTR_UNUSED *bkg)
 {
-    H5T_CONV_sS(INT, LONG, int, long, -, -);
+    H5T_CONV_sS_V(INT, LONG, int, long, -, -, Y);
 }
 
 
@@ -6060,7 +7220,7 @@ H5T__conv_int_llong(hid_t src_id, hid_t dst_id, H5T_cdata_t *cdata,
     size_t nelmts, size_t buf_stride, size_t H5_ATTR_UNUSED bkg_stride,
     void *buf, void H5_ATTR_UNUSED *bkg)
 {
-    H5T_CONV_sS(INT, LLONG, int, long long, -, -);
+    H5T_CONV_sS_V(INT, LLONG, int, long long, -, -, Y);
 }
 
 
@@ -6336,7 +7496,7 @@ H5T__conv_long_int(hid_t src_id, hid_t dst_id, H5T_cdata_t *cdata,
     size_t nelmts, size_t buf_stride, size_t H5_ATTR_UNUSED bkg_stride,
     void *buf, void H5_ATTR_UNUSED *bkg)
 {
-    H5T_CONV_Ss(LONG, INT, long, int, INT_MIN, INT_MAX);
+    H5T_CONV_Ss_V(LONG, INT, long, int, INT_MIN, INT_MAX, Y);
 }
 
 
@@ -6750,7 +7910,7 @@ H5T__conv_llong_int(hid_t src_id, hid_t dst_id, H5T_cdata_t *cdata,
     size_t nelmts, size_t buf_stride, size_t H5_ATTR_UNUSED bkg_stride,
     void *buf, void H5_ATTR_UNUSED *bkg)
 {
-    H5T_CONV_Ss(LLONG, INT, long long, int, INT_MIN, INT_MAX);
+    H5T_CONV_Ss_V(LLONG, INT, long long, int, INT_MIN, INT_MAX, Y);
 }
 
 
@@ -6979,7 +8139,7 @@ H5T__conv_float_double (hid_t src_id, hid_t dst_id, H5T_cdata_t *cdata,
     size_t nelmts, size_t buf_stride, size_t H5_ATTR_UNUSED bkg_stride,
     void *buf, void H5_ATTR_UNUSED *bkg)
 {
-    H5T_CONV_fF(FLOAT, DOUBLE, float, double, -, -);
+    H5T_CONV_fF_V(FLOAT, DOUBLE, float, double, -, -, Y);
 }
 
 
@@ -7025,7 +8185,7 @@ H5T__conv_double_float (hid_t src_id, hid_t dst_id, H5T_cdata_t *cdata,
     size_t nelmts, size_t buf_stride, size_t H5_ATTR_UNUSED bkg_stride,
     void *buf, void H5_ATTR_UNUSED *bkg)
 {
-    H5T_CONV_Ff(DOUBLE, FLOAT, double, float, -FLT_MAX, FLT_MAX);
+    H5T_CONV_Ff_V(DOUBLE, FLOAT, double, float, -FLT_MAX, FLT_MAX, Y);
 }
 
 
@@ -7185,7 +8345,7 @@ H5T__conv_uchar_float (hid_t src_id, hid_t dst_id, H5T_cdata_t *cdata,
     size_t nelmts, size_t buf_stride, size_t H5_ATTR_UNUSED bkg_stride,
     void *buf, void H5_ATTR_UNUSED *bkg)
 {
-    H5T_CONV_xF(UCHAR, FLOAT, unsigned char, float, -, -);
+    H5T_CONV_xF_V(UCHAR, FLOAT, unsigned char, float, -, -, Y);
 }
 
 
@@ -7251,9 +8411,88 @@ H5T__conv_short_float (hid_t src_id, hid_t dst_id, H5T_cdata_t *cdata,
     size_t nelmts, size_t buf_stride, size_t H5_ATTR_UNUSED bkg_stride,
     void *buf, void H5_ATTR_UNUSED *bkg)
 {
-    H5T_CONV_xF(SHORT, FLOAT, short, float, -, -);
+    H5T_CONV_xF_V(SHORT, FLOAT, short, float, -, -, Y);
 }
 
+
+/*-------------------------------------------------------------------------
+ * Function:	H5T__conv_i16be_float
+ *
+ * Purpose:	Convert big-endian 16-bit integers to native float on a
+ *		little-endian machine, swapping the bytes of each element as
+ *		it is converted instead of in a separate pass.  Every 16-bit
+ *		integer is exactly representable as a float, so there are
+ *		no conversion exceptions.
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5T__conv_i16be_float(hid_t src_id, hid_t dst_id, H5T_cdata_t *cdata,
+    size_t nelmts, size_t buf_stride, size_t H5_ATTR_UNUSED bkg_stride,
+    void *buf, void H5_ATTR_UNUSED *bkg)
+{
+    H5T_t	*st, *dt;		/*datatype descriptors		*/
+    uint8_t     *s;                     /*source element                */
+    float       d;                      /*converted element             */
+    size_t	elmtno;			/*element number		*/
+    herr_t      ret_value = SUCCEED;    /* Return value */
+
+    FUNC_ENTER_PACKAGE
+
+    switch(cdata->command) {
+        case H5T_CONV_INIT:
+            cdata->need_bkg = H5T_BKG_NO;
+            if(NULL == (st = (H5T_t *)H5I_object(src_id)) || NULL == (dt = (H5T_t *)H5I_object(dst_id)))
+                HGOTO_ERROR(H5E_DATATYPE, H5E_CANTINIT, FAIL, "unable to dereference datatype object ID")
+            if(st->shared->size != 2 || dt->shared->size != sizeof(float))
+                HGOTO_ERROR(H5E_DATATYPE, H5E_CANTINIT, FAIL, "disagreement about datatype size")
+            break;
+
+        case H5T_CONV_FREE:
+            break;
+
+        case H5T_CONV_CONV:
+            if(buf_stride) {
+                /* Each element is converted in its own slot */
+                HDassert(buf_stride >= sizeof(float));
+                for(elmtno = 0, s = (uint8_t *)buf; elmtno < nelmts; elmtno++, s += buf_stride) {
+                    d = (float)(int16_t)(((unsigned)s[0] << 8) | s[1]);
+                    HDmemcpy(s, &d, sizeof(float));
+                } /* end for */
+            } /* end if */
+            else {
+                /* The floats are wider than the integers they replace, so
+                 * walk backwards from the end of the buffer.  The vector
+                 * kernel converts whole blocks at the start of the buffer
+                 * after the elements past them have been converted. */
+                size_t nvec = nelmts & ~(size_t)7;
+
+                for(elmtno = nelmts; elmtno > nvec; elmtno--) {
+                    s = (uint8_t *)buf + 2 * (elmtno - 1);
+                    d = (float)(int16_t)(((unsigned)s[0] << 8) | s[1]);
+                    HDmemcpy((uint8_t *)buf + sizeof(float) * (elmtno - 1), &d, sizeof(float));
+                } /* end for */
+#ifdef H5T_CONV_SIMD
+                elmtno -= H5T__conv_vec_i16be_f32(buf, buf, nvec);
+#endif /* H5T_CONV_SIMD */
+                for(/*void*/; elmtno > 0; elmtno--) {
+                    s = (uint8_t *)buf + 2 * (elmtno - 1);
+                    d = (float)(int16_t)(((unsigned)s[0] << 8) | s[1]);
+                    HDmemcpy((uint8_t *)buf + sizeof(float) * (elmtno - 1), &d, sizeof(float));
+                } /* end for */
+            } /* end else */
+            break;
+
+        default:
+            HGOTO_ERROR(H5E_DATATYPE, H5E_UNSUPPORTED, FAIL, "unknown conversion command")
+    } /* end switch */
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5T__conv_i16be_float() */
+
 
 /*-------------------------------------------------------------------------
  * Function:	H5T__conv_short_double
@@ -7317,7 +8556,7 @@ H5T__conv_ushort_float (hid_t src_id, hid_t dst_id, H5T_cdata_t *cdata,
     size_t nelmts, size_t buf_stride, size_t H5_ATTR_UNUSED bkg_stride,
     void *buf, void H5_ATTR_UNUSED *bkg)
 {
-    H5T_CONV_xF(USHORT, FLOAT, unsigned short, float, -, -);
+    H5T_CONV_xF_V(USHORT, FLOAT, unsigned short, float, -, -, Y);
 }
 
 
@@ -7383,7 +8622,7 @@ H5T__conv_int_float (hid_t src_id, hid_t dst_id, H5T_cdata_t *cdata,
     size_t nelmts, size_t buf_stride, size_t H5_ATTR_UNUSED bkg_stride,
     void *buf, void H5_ATTR_UNUSED *bkg)
 {
-    H5T_CONV_xF(INT, FLOAT, int, float, -, -);
+    H5T_CONV_xF_V(INT, FLOAT, int, float, -, -, Y);
 }
 
 
@@ -7405,7 +8644,7 @@ H5T__conv_int_double (hid_t src_id, hid_t dst_id, H5T_cdata_t *cdata,
     size_t nelmts, size_t buf_stride, size_t H5_ATTR_UNUSED bkg_stride,
     void *buf, void H5_ATTR_UNUSED *bkg)
 {
-    H5T_CONV_xF(INT, DOUBLE, int, double, -, -);
+    H5T_CONV_xF_V(INT, DOUBLE, int, double, -, -, Y);
 }
 
 
@@ -179,6 +179,9 @@ struct H5T_path_t {
     hbool_t	are_compounds;		/*are source and dest both compounds?*/
     H5T_stats_t	stats;			/*statistics for the conversion	     */
     H5T_cdata_t	cdata;			/*data for this function	     */
+    unsigned	src_fp;			/*fingerprint of source datatype     */
+    unsigned	dst_fp;			/*fingerprint of destination datatype*/
+    struct H5T_path_t *hash_next;	/*next path in the same hash bucket  */
 };
 
 /* Reference function pointers */
@@ -949,6 +952,10 @@ H5_DLL herr_t H5T__conv_short_float(hid_t src_id, hid_t dst_id,
 				     H5T_cdata_t *cdata, size_t nelmts,
 				     size_t buf_stride, size_t bkg_stride,
                                      void *buf, void *bkg);
+H5_DLL herr_t H5T__conv_i16be_float(hid_t src_id, hid_t dst_id,
+				     H5T_cdata_t *cdata, size_t nelmts,
+				     size_t buf_stride, size_t bkg_stride,
+                                     void *buf, void *bkg);
 H5_DLL herr_t H5T__conv_short_double(hid_t src_id, hid_t dst_id,
 				     H5T_cdata_t *cdata, size_t nelmts,
 				     size_t buf_stride, size_t bkg_stride,
@@ -92,12 +92,23 @@ typedef enum {
     H5T_SUBSET_FALSE = 0,       /* Source and destination aren't subset of each other */
     H5T_SUBSET_SRC,             /* Source is the subset of dest and no conversion is needed */
     H5T_SUBSET_DST,             /* Dest is the subset of source and no conversion is needed */
+    H5T_SUBSET_PLAN,            /* No conversion is needed, but members are picked or moved: follow the copy plan */
     H5T_SUBSET_CAP              /* Must be the last value */
 } H5T_subset_t;
 
+/* One run of adjacent members, copied from each source element to each
+ * destination element (see H5T_SUBSET_PLAN) */
+typedef struct H5T_subset_copy_t {
+    size_t          src_offset; /* Offset of the run in a source element */
+    size_t          dst_offset; /* Offset of the run in a destination element */
+    size_t          size;       /* Size of the run in bytes */
+} H5T_subset_copy_t;
+
 typedef struct H5T_subset_info_t {
     H5T_subset_t    subset;     /* See above */
     size_t          copy_size;  /* Size in bytes, to copy for each element */
+    size_t          ncopies;    /* Number of runs in the copy plan */
+    H5T_subset_copy_t *copies;  /* The copy plan, for H5T_SUBSET_PLAN */
 } H5T_subset_info_t;
 
 /* Forward declarations for prototype arguments */
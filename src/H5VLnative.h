@@ -49,6 +49,8 @@
 #define H5VL_NATIVE_DATASET_CHUNK_WRITE             7   /* H5Dchunk_write               */
 #define H5VL_NATIVE_DATASET_GET_VLEN_BUF_SIZE       8   /* H5Dvlen_get_buf_size         */
 #define H5VL_NATIVE_DATASET_GET_OFFSET              9   /* H5Dget_offset                */
+#define H5VL_NATIVE_DATASET_GET_CHUNK_CACHE_STATS   10  /* H5Dget_chunk_cache_stats     */
+#define H5VL_NATIVE_DATASET_RESET_CHUNK_CACHE_STATS 11  /* H5Dreset_chunk_cache_stats   */
 
 /* Values for native VOL connector file optional VOL operations */
 #define H5VL_NATIVE_FILE_CLEAR_ELINK_CACHE             0   /* H5Fclear_elink_file_cache            */
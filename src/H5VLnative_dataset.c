@@ -604,6 +604,30 @@ H5VL__native_dataset_optional(void *obj, H5VL_dataset_optional_t optional_type,
                 break;
             }
 
+        /* H5Dget_chunk_cache_stats */
+        case H5VL_NATIVE_DATASET_GET_CHUNK_CACHE_STATS:
+            {
+                H5D_chunk_cache_stats_t *stats = HDva_arg(arguments, H5D_chunk_cache_stats_t *);
+
+                /* Make sure the dataset is chunked */
+                if(H5D_CHUNKED != dset->shared->layout.type)
+                    HGOTO_ERROR(H5E_ARGS, H5E_BADTYPE, FAIL, "not a chunked dataset")
+
+                *stats = dset->shared->cache.chunk.stats;
+                break;
+            }
+
+        /* H5Dreset_chunk_cache_stats */
+        case H5VL_NATIVE_DATASET_RESET_CHUNK_CACHE_STATS:
+            {
+                /* Make sure the dataset is chunked */
+                if(H5D_CHUNKED != dset->shared->layout.type)
+                    HGOTO_ERROR(H5E_ARGS, H5E_BADTYPE, FAIL, "not a chunked dataset")
+
+                HDmemset(&dset->shared->cache.chunk.stats, 0, sizeof(H5D_chunk_cache_stats_t));
+                break;
+            }
+
         default:
             HGOTO_ERROR(H5E_VOL, H5E_UNSUPPORTED, FAIL, "invalid optional operation")
     } /* end switch */
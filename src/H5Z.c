@@ -63,12 +63,14 @@ hbool_t H5_PKG_INIT_VAR = FALSE;
 static size_t                H5Z_table_alloc_g = 0;
 static size_t                H5Z_table_used_g = 0;
 static H5Z_class2_t         *H5Z_table_g = NULL;
+static H5Z_func_sized_t     *H5Z_sized_table_g = NULL;   /* Sized filter functions, by table index */
 #ifdef H5Z_DEBUG
 static H5Z_stats_t          *H5Z_stat_table_g = NULL;
 #endif /* H5Z_DEBUG */
 
 /* Local functions */
 static int H5Z_find_idx(H5Z_filter_t id);
+static H5Z_func_sized_t H5Z__find_sized(const H5Z_class2_t *cls);
 static int H5Z__check_unregister_dset_cb(void *obj_ptr, hid_t obj_id, void *key);
 static int H5Z__check_unregister_group_cb(void *obj_ptr, hid_t obj_id, void *key);
 static int H5Z__flush_file_cb(void *obj_ptr, hid_t obj_id, void *key);
@@ -92,6 +94,8 @@ H5Z__init_package(void)
     /* Internal filters */
     if (H5Z_register(H5Z_SHUFFLE) < 0)
         HGOTO_ERROR(H5E_PLINE, H5E_CANTINIT, FAIL, "unable to register shuffle filter")
+    if (H5Z_register(H5Z_BITSHUFFLE) < 0)
+        HGOTO_ERROR(H5E_PLINE, H5E_CANTINIT, FAIL, "unable to register bitshuffle filter")
     if (H5Z_register(H5Z_FLETCHER32) < 0)
         HGOTO_ERROR(H5E_PLINE, H5E_CANTINIT, FAIL, "unable to register fletcher32 filter")
     if (H5Z_register(H5Z_NBIT) < 0)
@@ -109,6 +113,10 @@ H5Z__init_package(void)
     if (H5Z_register(H5Z_SZIP) < 0)
         HGOTO_ERROR(H5E_PLINE, H5E_CANTINIT, FAIL, "unable to register szip filter")
 #endif /* H5_HAVE_FILTER_SZIP */
+#ifdef H5_HAVE_FILTER_LZ4
+    if (H5Z_register(H5Z_LZ4) < 0)
+        HGOTO_ERROR(H5E_PLINE, H5E_CANTINIT, FAIL, "unable to register lz4 filter")
+#endif /* H5_HAVE_FILTER_LZ4 */
 
 done:
     FUNC_LEAVE_NOAPI(ret_value)
@@ -186,6 +194,7 @@ H5Z_term_package(void)
         /* Free the table of filters */
         if (H5Z_table_g) {
             H5Z_table_g = (H5Z_class2_t *)H5MM_xfree(H5Z_table_g);
+            H5Z_sized_table_g = (H5Z_func_sized_t *)H5MM_xfree(H5Z_sized_table_g);
 #ifdef H5Z_DEBUG
             H5Z_stat_table_g = (H5Z_stats_t *)H5MM_xfree(H5Z_stat_table_g);
 #endif /* H5Z_DEBUG */
@@ -308,12 +317,16 @@ H5Z_register (const H5Z_class2_t *cls)
         if (H5Z_table_used_g >= H5Z_table_alloc_g) {
             size_t n = MAX(H5Z_MAX_NFILTERS, 2 * H5Z_table_alloc_g);
             H5Z_class2_t *table = (H5Z_class2_t *)H5MM_realloc(H5Z_table_g, n * sizeof(H5Z_class2_t));
+            H5Z_func_sized_t *sized_table;
 #ifdef H5Z_DEBUG
             H5Z_stats_t *stat_table = (H5Z_stats_t *)H5MM_realloc(H5Z_stat_table_g, n * sizeof(H5Z_stats_t));
 #endif /* H5Z_DEBUG */
             if (!table)
                 HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "unable to extend filter table")
             H5Z_table_g = table;
+            if (NULL == (sized_table = (H5Z_func_sized_t *)H5MM_realloc(H5Z_sized_table_g, n * sizeof(H5Z_func_sized_t))))
+                HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "unable to extend filter decoder table")
+            H5Z_sized_table_g = sized_table;
 #ifdef H5Z_DEBUG
             if (!stat_table)
                 HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "unable to extend filter statistics table")
@@ -325,6 +338,7 @@ H5Z_register (const H5Z_class2_t *cls)
         /* Initialize */
         i = H5Z_table_used_g++;
         H5MM_memcpy(H5Z_table_g+i, cls, sizeof(H5Z_class2_t));
+        H5Z_sized_table_g[i] = H5Z__find_sized(cls);
 #ifdef H5Z_DEBUG
         HDmemset(H5Z_stat_table_g+i, 0, sizeof(H5Z_stats_t));
 #endif /* H5Z_DEBUG */
@@ -333,6 +347,7 @@ H5Z_register (const H5Z_class2_t *cls)
     else {
         /* Replace old contents */
         H5MM_memcpy(H5Z_table_g+i, cls, sizeof(H5Z_class2_t));
+        H5Z_sized_table_g[i] = H5Z__find_sized(cls);
     } /* end else */
 
 done:
@@ -340,6 +355,37 @@ done:
 }
 
 
+/*-------------------------------------------------------------------------
+ * Function:    H5Z__find_sized
+ *
+ * Purpose:     Find the sized function that H5Z_pipeline_mem() calls
+ *              instead of the filter function of class CLS when it knows
+ *              the size of the decoded data or has an allocator for the
+ *              filter's buffers.  Only the library's deflate filter has
+ *              one; other filters, including all those registered by the
+ *              application or loaded from plugins, are always called
+ *              through the filter function of their class.
+ *
+ * Return:      The sized function, or NULL if there isn't one
+ *
+ *-------------------------------------------------------------------------
+ */
+static H5Z_func_sized_t
+H5Z__find_sized(const H5Z_class2_t H5_ATTR_UNUSED *cls)
+{
+    H5Z_func_sized_t ret_value = NULL;  /* Return value */
+
+    FUNC_ENTER_STATIC_NOERR
+
+#ifdef H5_HAVE_FILTER_DEFLATE
+    if (cls->filter == H5Z_DEFLATE->filter)
+        ret_value = H5Z__filter_deflate_sized;
+#endif /* H5_HAVE_FILTER_DEFLATE */
+
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5Z__find_sized() */
+
+
 /*-------------------------------------------------------------------------
  * Function:    H5Zunregister
  *
@@ -430,6 +476,7 @@ H5Z__unregister(H5Z_filter_t filter_id)
     /* Remove filter from table */
     /* Don't worry about shrinking table size (for now) */
     HDmemmove(&H5Z_table_g[filter_index], &H5Z_table_g[filter_index+1], sizeof(H5Z_class2_t)*((H5Z_table_used_g-1)-filter_index));
+    HDmemmove(&H5Z_sized_table_g[filter_index], &H5Z_sized_table_g[filter_index+1], sizeof(H5Z_func_sized_t)*((H5Z_table_used_g-1)-filter_index));
 #ifdef H5Z_DEBUG
     HDmemmove(&H5Z_stat_table_g[filter_index], &H5Z_stat_table_g[filter_index+1], sizeof(H5Z_stats_t)*((H5Z_table_used_g-1)-filter_index));
 #endif /* H5Z_DEBUG */
@@ -1242,6 +1289,15 @@ done:
  *           then the pipeline function should free the original buffer
  *           and return a fresh buffer, adjusting BUF_SIZE accordingly.
  *
+ *           When reading, DECODED_NBYTES is the size the data will have
+ *           once all the filters are undone (a whole chunk, for example,
+ *           or more if the caller needs the extra room in the buffer),
+ *           or 0 if it isn't known.  Filters with a sized function
+ *           (see H5Z__find_sized()) are passed it, so that they can
+ *           allocate their output buffer once instead of guessing its
+ *           size and growing it.  It isn't used when writing, and
+ *           callers pass 0.
+ *
  * Return:   Non-negative on success
  *           Negative on failure
  *-------------------------------------------------------------------------
@@ -1249,8 +1305,44 @@ done:
 herr_t
 H5Z_pipeline(const H5O_pline_t *pline, unsigned flags,
         unsigned *filter_mask/*in,out*/, H5Z_EDC_t edc_read,
-        H5Z_cb_t cb_struct, size_t *nbytes/*in,out*/,
+        H5Z_cb_t cb_struct, size_t decoded_nbytes, size_t *nbytes/*in,out*/,
         size_t *buf_size/*in,out*/, void **buf/*in,out*/)
+{
+    herr_t      ret_value = SUCCEED;       /* Return value */
+
+    FUNC_ENTER_NOAPI(FAIL)
+
+    if (H5Z_pipeline_mem(pline, flags, filter_mask, edc_read, cb_struct,
+            decoded_nbytes, NULL, nbytes, buf_size, buf) < 0)
+        HGOTO_ERROR(H5E_PLINE, H5E_CANTFILTER, FAIL, "filter pipeline failed")
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5Z_pipeline() */
+
+
+/*-------------------------------------------------------------------------
+ * Function: H5Z_pipeline_mem
+ *
+ * Purpose:  Process data through the filter pipeline, like H5Z_pipeline(),
+ *           with the buffers allocated and freed by MEM, if it isn't NULL.
+ *           Filters with a sized function (see H5Z__find_sized()) get
+ *           their output buffers from MEM and give their input buffers
+ *           back to it, so that a caller can recycle the buffers instead
+ *           of allocating them for every call.  Other filters allocate
+ *           and free their buffers with the H5MM routines as usual, so
+ *           the buffers that MEM hands out must be compatible with them.
+ *
+ * Return:   Non-negative on success
+ *           Negative on failure
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5Z_pipeline_mem(const H5O_pline_t *pline, unsigned flags,
+        unsigned *filter_mask/*in,out*/, H5Z_EDC_t edc_read,
+        H5Z_cb_t cb_struct, size_t decoded_nbytes, const H5Z_mem_t *mem,
+        size_t *nbytes/*in,out*/, size_t *buf_size/*in,out*/,
+        void **buf/*in,out*/)
 {
     size_t    i, idx, new_nbytes;
     int       fclass_idx;        /* Index of filter class in global table */
@@ -1322,7 +1414,11 @@ H5Z_pipeline(const H5O_pline_t *pline, unsigned flags,
 #endif
             tmp_flags = flags | (pline->filter[idx].flags);
             tmp_flags |= (edc_read== H5Z_DISABLE_EDC) ? H5Z_FLAG_SKIP_EDC : 0;
-            new_nbytes = (fclass->filter)(tmp_flags, pline->filter[idx].cd_nelmts,
+            if ((decoded_nbytes > 0 || mem) && H5Z_sized_table_g[fclass_idx])
+                new_nbytes = (H5Z_sized_table_g[fclass_idx])(tmp_flags, pline->filter[idx].cd_nelmts,
+                                        pline->filter[idx].cd_values, *nbytes, decoded_nbytes, mem, buf_size, buf);
+            else
+                new_nbytes = (fclass->filter)(tmp_flags, pline->filter[idx].cd_nelmts,
                                         pline->filter[idx].cd_values, *nbytes, buf_size, buf);
 
 #ifdef H5Z_DEBUG
@@ -1364,8 +1460,12 @@ H5Z_pipeline(const H5O_pline_t *pline, unsigned flags,
             fstats = &H5Z_stat_table_g[fclass_idx];
             H5_timer_begin (&timer);
 #endif
-            new_nbytes = (fclass->filter)(flags | (pline->filter[idx].flags), pline->filter[idx].cd_nelmts,
-                    pline->filter[idx].cd_values, *nbytes, buf_size, buf);
+            if (mem && H5Z_sized_table_g[fclass_idx])
+                new_nbytes = (H5Z_sized_table_g[fclass_idx])(flags | (pline->filter[idx].flags), pline->filter[idx].cd_nelmts,
+                        pline->filter[idx].cd_values, *nbytes, (size_t)0, mem, buf_size, buf);
+            else
+                new_nbytes = (fclass->filter)(flags | (pline->filter[idx].flags), pline->filter[idx].cd_nelmts,
+                        pline->filter[idx].cd_values, *nbytes, buf_size, buf);
 #ifdef H5Z_DEBUG
             H5_timer_end (&(fstats->stats[0].timer), &timer);
             fstats->stats[0].total += MAX(*nbytes, new_nbytes);
@@ -1392,7 +1492,61 @@ H5Z_pipeline(const H5O_pline_t *pline, unsigned flags,
 
 done:
     FUNC_LEAVE_NOAPI(ret_value)
-}
+} /* end H5Z_pipeline_mem() */
+
+
+/*-------------------------------------------------------------------------
+ * Function: H5Z__mem_alloc
+ *
+ * Purpose:  Allocate a buffer of at least SIZE bytes for a filter, from
+ *           MEM if it isn't NULL or with H5MM_malloc() otherwise.  The
+ *           size of the buffer is returned through ALLOC.
+ *
+ * Return:   Pointer to the buffer on success/NULL on failure
+ *-------------------------------------------------------------------------
+ */
+void *
+H5Z__mem_alloc(const H5Z_mem_t *mem, size_t size, size_t *alloc)
+{
+    void *ret_value = NULL;     /* Return value */
+
+    FUNC_ENTER_PACKAGE_NOERR
+
+    HDassert(alloc);
+
+    if (mem)
+        ret_value = (mem->alloc_func)(size, alloc, mem->info);
+    else if (NULL != (ret_value = H5MM_malloc(size)))
+        *alloc = size;
+
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5Z__mem_alloc() */
+
+
+/*-------------------------------------------------------------------------
+ * Function: H5Z__mem_free
+ *
+ * Purpose:  Free a filter's buffer of ALLOC bytes (or 0 if it isn't
+ *           known), back to MEM if it isn't NULL or with H5MM_xfree()
+ *           otherwise.
+ *
+ * Return:   NULL (never fails)
+ *-------------------------------------------------------------------------
+ */
+void *
+H5Z__mem_free(const H5Z_mem_t *mem, void *buf, size_t alloc)
+{
+    FUNC_ENTER_PACKAGE_NOERR
+
+    if (buf) {
+        if (mem)
+            (mem->free_func)(buf, alloc, mem->info);
+        else
+            H5MM_xfree(buf);
+    } /* end if */
+
+    FUNC_LEAVE_NOAPI(NULL)
+} /* end H5Z__mem_free() */
 
 
 /*-------------------------------------------------------------------------
@@ -1506,6 +1660,67 @@ done:
     FUNC_LEAVE_NOAPI(ret_value)
 } /* end H5Z_all_filters_avail() */
 
+
+/*-------------------------------------------------------------------------
+ * Function: H5Z_pipeline_thread_safe
+ *
+ * Purpose:  Check whether the filter pipeline PLINE can run on the helper
+ *           threads of H5TS_parallel_for(), which don't hold the API lock:
+ *           every filter in it must be registered and be one of the
+ *           library's own, which don't call back into the library.
+ *           Filters loaded from plugins (or registered by the
+ *           application, even over the library's IDs) may use the API,
+ *           so they are only run on the thread holding the lock.
+ *
+ * Return:   Non-negative (TRUE/FALSE) on success
+ *           Negative on failure
+ *-------------------------------------------------------------------------
+ */
+htri_t
+H5Z_pipeline_thread_safe(const H5O_pline_t *pline)
+{
+    static const H5Z_class2_t *const builtin[] = {
+        H5Z_SHUFFLE, H5Z_BITSHUFFLE, H5Z_FLETCHER32, H5Z_NBIT, H5Z_SCALEOFFSET
+#ifdef H5_HAVE_FILTER_DEFLATE
+        , H5Z_DEFLATE
+#endif /* H5_HAVE_FILTER_DEFLATE */
+#ifdef H5_HAVE_FILTER_SZIP
+        , H5Z_SZIP
+#endif /* H5_HAVE_FILTER_SZIP */
+#ifdef H5_HAVE_FILTER_LZ4
+        , H5Z_LZ4
+#endif /* H5_HAVE_FILTER_LZ4 */
+    };
+    size_t i, j;                  /* Local index variables */
+    htri_t ret_value = TRUE;      /* Return value */
+
+    FUNC_ENTER_NOAPI(FAIL)
+
+    /* Check args */
+    HDassert(pline);
+
+    for (i = 0; i < pline->nused; i++) {
+        const H5Z_filter_info_t *filter = &pline->filter[i];
+        int fclass_idx;
+
+        if ((fclass_idx = H5Z_find_idx(filter->id)) < 0)
+            HGOTO_DONE(FALSE)
+        for (j = 0; j < NELMTS(builtin); j++)
+            if (H5Z_table_g[fclass_idx].filter == builtin[j]->filter)
+                break;
+        if (j == NELMTS(builtin))
+            HGOTO_DONE(FALSE)
+
+        /* The bitshuffle filter hands some compression modes to its plugin */
+        if (H5Z_table_g[fclass_idx].filter == H5Z_BITSHUFFLE->filter
+                && !H5Z__bitshuffle_thread_safe(filter->cd_nelmts, filter->cd_values))
+            HGOTO_DONE(FALSE)
+    } /* end for */
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5Z_pipeline_thread_safe() */
+
 
 /*-------------------------------------------------------------------------
  * Function: H5Z_delete
@@ -1613,7 +1828,8 @@ done:
     FUNC_LEAVE_API(ret_value)
 } /* end H5Zget_filter_info() */
 
-
+
+
 /*-------------------------------------------------------------------------
  * Function: H5Z_get_filter_info
  *
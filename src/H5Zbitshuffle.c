@@ -0,0 +1,642 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * Copyright by The HDF Group.                                               *
+ * All rights reserved.                                                      *
+ *                                                                           *
+ * This file is part of HDF5.  The full HDF5 copyright notice, including     *
+ * terms governing use, modification, and redistribution, is contained in    *
+ * the COPYING file, which can be found at the root of the source code       *
+ * distribution tree, or in https://support.hdfgroup.org/ftp/HDF5/releases.  *
+ * If you do not have access to either file, you may request a copy from     *
+ * help@hdfgroup.org.                                                        *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+/*
+ * Purpose:	The bitshuffle filter.  Like the shuffle filter, but
+ *              transposes the bits of the elements instead of their bytes,
+ *              so each bit position of the elements is stored together.
+ *
+ *              The data is laid out the same way as by the bitshuffle
+ *              plugin filter, under the same filter id: the elements are
+ *              transposed in blocks, and the last block is cut down to a
+ *              multiple of 8 elements, with any elements after it stored
+ *              as they are.  Within a block of N elements, bit K of byte J
+ *              of element I is stored at bit (J * 8 + K) * N + I of the
+ *              block, counting from the least significant bit of each
+ *              byte.
+ *
+ *              The plugin's LZ4 mode, which compresses each block on its
+ *              own, is done with the library's lz4 codec.  Other modes
+ *              are handed to the plugin itself, when it can be loaded.
+ */
+
+#include "H5Zmodule.h"          /* This source code file is part of the H5Z module */
+
+
+#include "H5private.h"		/* Generic Functions			*/
+#include "H5Eprivate.h"		/* Error handling		  	*/
+#include "H5Iprivate.h"		/* IDs			  		*/
+#include "H5MMprivate.h"	/* Memory management			*/
+#include "H5PLprivate.h"        /* Plugins                              */
+#include "H5Pprivate.h"         /* Property lists                       */
+#include "H5Tprivate.h"		/* Datatypes         			*/
+#include "H5Zpkg.h"		/* Data filters				*/
+
+/* Local macros */
+#define H5Z_BITSHUFFLE_PARM_MAJOR       0   /* "Local" parameter for the format major version */
+#define H5Z_BITSHUFFLE_PARM_MINOR       1   /* "Local" parameter for the format minor version */
+#define H5Z_BITSHUFFLE_PARM_SIZE        2   /* "Local" parameter for the datatype size */
+#define H5Z_BITSHUFFLE_PARM_BLOCK       3   /* "User" parameter for the block size */
+#define H5Z_BITSHUFFLE_PARM_COMPRESS    4   /* "User" parameter for compression */
+
+#define H5Z_BITSHUFFLE_VERS_MAJOR       0   /* Format version written */
+#define H5Z_BITSHUFFLE_VERS_MINOR       3
+
+#define H5Z_BITSHUFFLE_BLOCK_MULT       8       /* Block sizes are multiples of this */
+#define H5Z_BITSHUFFLE_BLOCK_BYTES      8192    /* Target size of a block, in bytes */
+#define H5Z_BITSHUFFLE_BLOCK_MIN        128     /* Minimum default block size */
+#define H5Z_BITSHUFFLE_HEADER_SIZE      12      /* Size of the header of compressed data */
+
+/* Transpose the 8x8 bit matrix in the bytes of X, so bit K of byte J
+ * becomes bit J of byte K (bytes in little-endian order) */
+#define H5Z_BITSHUFFLE_TRANS_8X8(x, t) {                                    \
+    t = ((x) ^ ((x) >> 7)) & (uint64_t)0x00AA00AA00AA00AAULL;               \
+    x = (x) ^ t ^ (t << 7);                                                 \
+    t = ((x) ^ ((x) >> 14)) & (uint64_t)0x0000CCCC0000CCCCULL;              \
+    x = (x) ^ t ^ (t << 14);                                                \
+    t = ((x) ^ ((x) >> 28)) & (uint64_t)0x00000000F0F0F0F0ULL;              \
+    x = (x) ^ t ^ (t << 28);                                                \
+}
+
+/* Put the bytes of a 64-bit word loaded from memory in little-endian order */
+#ifdef WORDS_BIGENDIAN
+#define H5Z_BITSHUFFLE_LE64(x)                                              \
+    ((((x) & (uint64_t)0x00000000000000FFULL) << 56) |                      \
+     (((x) & (uint64_t)0x000000000000FF00ULL) << 40) |                      \
+     (((x) & (uint64_t)0x0000000000FF0000ULL) << 24) |                      \
+     (((x) & (uint64_t)0x00000000FF000000ULL) << 8) |                       \
+     (((x) & (uint64_t)0x000000FF00000000ULL) >> 8) |                       \
+     (((x) & (uint64_t)0x0000FF0000000000ULL) >> 24) |                      \
+     (((x) & (uint64_t)0x00FF000000000000ULL) >> 40) |                      \
+     (((x) & (uint64_t)0xFF00000000000000ULL) >> 56))
+#else /* WORDS_BIGENDIAN */
+#define H5Z_BITSHUFFLE_LE64(x)  (x)
+#endif /* WORDS_BIGENDIAN */
+
+/* Local function prototypes */
+static htri_t H5Z__can_apply_bitshuffle(hid_t dcpl_id, hid_t type_id, hid_t space_id);
+static herr_t H5Z__set_local_bitshuffle(hid_t dcpl_id, hid_t type_id, hid_t space_id);
+static size_t H5Z__filter_bitshuffle(unsigned flags, size_t cd_nelmts,
+    const unsigned cd_values[], size_t nbytes, size_t *buf_size, void **buf);
+static void H5Z__bitshuffle_trans_bits(unsigned char *buf, size_t nwords);
+static void H5Z__bitshuffle_block(unsigned char *dest, const unsigned char *src,
+    unsigned char *tmp, unsigned elem_size, size_t nelmts, hbool_t reverse);
+static hbool_t H5Z__bitshuffle_native(unsigned compress);
+static const H5Z_class2_t *H5Z__bitshuffle_plugin(void);
+#ifdef H5_HAVE_FILTER_LZ4
+static size_t H5Z__bitshuffle_lz4(hbool_t reverse, unsigned elem_size,
+    size_t block_size, size_t nbytes, size_t *buf_size, void **buf);
+#endif /* H5_HAVE_FILTER_LZ4 */
+
+/* This message derives from H5Z */
+const H5Z_class2_t H5Z_BITSHUFFLE[1] = {{
+    H5Z_CLASS_T_VERS,           /* H5Z_class_t version */
+    H5Z_FILTER_BITSHUFFLE,      /* Filter id number		*/
+    1,                          /* encoder_present flag (set to true) */
+    1,                          /* decoder_present flag (set to true) */
+    "bitshuffle",               /* Filter name for debugging	*/
+    H5Z__can_apply_bitshuffle,  /* The "can apply" callback     */
+    H5Z__set_local_bitshuffle,  /* The "set local" callback     */
+    H5Z__filter_bitshuffle,     /* The actual filter function	*/
+}};
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5Z__bitshuffle_thread_safe
+ *
+ * Purpose:	Check whether the bitshuffle filter can run with the
+ *              parameters CD_VALUES on the helper threads of
+ *              H5TS_parallel_for(), i.e. whether it doesn't hand the
+ *              data to the bitshuffle plugin.
+ *
+ * Return:	TRUE/FALSE
+ *
+ *-------------------------------------------------------------------------
+ */
+hbool_t
+H5Z__bitshuffle_thread_safe(size_t cd_nelmts, const unsigned cd_values[])
+{
+    unsigned compress;          /* Compression mode */
+
+    FUNC_ENTER_PACKAGE_NOERR
+
+    compress = cd_nelmts > H5Z_BITSHUFFLE_PARM_COMPRESS ? cd_values[H5Z_BITSHUFFLE_PARM_COMPRESS] : H5Z_BITSHUFFLE_COMPRESS_NONE;
+
+    FUNC_LEAVE_NOAPI(H5Z__bitshuffle_native(compress))
+} /* end H5Z__bitshuffle_thread_safe() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5Z__bitshuffle_native
+ *
+ * Purpose:	Check whether the library does the bitshuffle filter's
+ *              COMPRESS mode itself, rather than the bitshuffle plugin.
+ *
+ * Return:	TRUE/FALSE
+ *
+ *-------------------------------------------------------------------------
+ */
+static hbool_t
+H5Z__bitshuffle_native(unsigned compress)
+{
+    FUNC_ENTER_STATIC_NOERR
+
+#ifdef H5_HAVE_FILTER_LZ4
+    FUNC_LEAVE_NOAPI(compress == H5Z_BITSHUFFLE_COMPRESS_NONE || compress == H5Z_BITSHUFFLE_COMPRESS_LZ4)
+#else /* H5_HAVE_FILTER_LZ4 */
+    FUNC_LEAVE_NOAPI(compress == H5Z_BITSHUFFLE_COMPRESS_NONE)
+#endif /* H5_HAVE_FILTER_LZ4 */
+} /* end H5Z__bitshuffle_native() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5Z__bitshuffle_plugin
+ *
+ * Purpose:	Load the bitshuffle plugin filter, for the compression modes
+ *              the library doesn't do itself.  The plugin isn't
+ *              registered, since the library's filter has its id.
+ *
+ * Return:	Success: Pointer to the plugin's filter class
+ *		Failure: NULL
+ *
+ *-------------------------------------------------------------------------
+ */
+static const H5Z_class2_t *
+H5Z__bitshuffle_plugin(void)
+{
+    H5PL_key_t key;                     /* Key for finding the plugin */
+    const H5Z_class2_t *cls;            /* Plugin's filter class */
+    const H5Z_class2_t *ret_value = NULL;       /* Return value */
+
+    FUNC_ENTER_STATIC
+
+    key.id = H5Z_FILTER_BITSHUFFLE;
+    if(NULL == (cls = (const H5Z_class2_t *)H5PL_load(H5PL_TYPE_FILTER, &key)))
+	HGOTO_ERROR(H5E_PLINE, H5E_NOTFOUND, NULL, "bitshuffle compression mode needs the bitshuffle plugin, which can't be loaded")
+    if(cls->version != H5Z_CLASS_T_VERS || cls->id != H5Z_FILTER_BITSHUFFLE || NULL == cls->filter)
+	HGOTO_ERROR(H5E_PLINE, H5E_BADVALUE, NULL, "bitshuffle plugin has a bad filter class")
+
+    ret_value = cls;
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5Z__bitshuffle_plugin() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5Z__can_apply_bitshuffle
+ *
+ * Purpose:	Check whether the bitshuffle filter can be used with a
+ *              dataset's datatype.
+ *
+ * Return:	Success: TRUE
+ *		Failure: Negative
+ *
+ *-------------------------------------------------------------------------
+ */
+static htri_t
+H5Z__can_apply_bitshuffle(hid_t H5_ATTR_UNUSED dcpl_id, hid_t type_id, hid_t H5_ATTR_UNUSED space_id)
+{
+    const H5T_t	*type;                  /* Datatype */
+    size_t size;                        /* Datatype size */
+    htri_t ret_value = TRUE;            /* Return value */
+
+    FUNC_ENTER_STATIC
+
+    /* Get datatype */
+    if(NULL == (type = (const H5T_t *)H5I_object_verify(type_id, H5I_DATATYPE)))
+	HGOTO_ERROR(H5E_ARGS, H5E_BADTYPE, FAIL, "not a datatype")
+
+    /* Check the datatype's class */
+    if(H5T_get_class(type, TRUE) == H5T_NO_CLASS)
+	HGOTO_ERROR(H5E_PLINE, H5E_BADTYPE, FAIL, "bad datatype class")
+
+    /* The datatype's size has to fit in the filter's parameters */
+    size = H5T_get_size(type);
+    if(size == 0 || size > UINT_MAX)
+	HGOTO_ERROR(H5E_PLINE, H5E_BADTYPE, FAIL, "bad datatype size")
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5Z__can_apply_bitshuffle() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5Z__set_local_bitshuffle
+ *
+ * Purpose:	Set the "local" dataset parameters for bitshuffling: the
+ *              format version and the size of the datatype.  Checks the
+ *              block size set by the user, if any.  Compression modes the
+ *              library doesn't do itself are set up by the bitshuffle
+ *              plugin.
+ *
+ * Return:	Success: Non-negative
+ *		Failure: Negative
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5Z__set_local_bitshuffle(hid_t dcpl_id, hid_t type_id, hid_t space_id)
+{
+    H5P_genplist_t *dcpl_plist;         /* Property list pointer */
+    const H5T_t	*type;                  /* Datatype */
+    unsigned flags;                     /* Filter flags */
+    size_t cd_nelmts = H5Z_BITSHUFFLE_TOTAL_NPARMS;    /* Number of filter parameters */
+    unsigned cd_values[H5Z_BITSHUFFLE_TOTAL_NPARMS] = {0, 0, 0, 0, 0};  /* Filter parameters */
+    herr_t ret_value = SUCCEED;         /* Return value */
+
+    FUNC_ENTER_STATIC
+
+    /* Get the plist structure */
+    if(NULL == (dcpl_plist = H5P_object_verify(dcpl_id, H5P_DATASET_CREATE)))
+        HGOTO_ERROR(H5E_ATOM, H5E_BADATOM, FAIL, "can't find object for ID")
+
+    /* Get datatype */
+    if(NULL == (type = (const H5T_t *)H5I_object_verify(type_id, H5I_DATATYPE)))
+	HGOTO_ERROR(H5E_ARGS, H5E_BADTYPE, FAIL, "not a datatype")
+
+    /* Get the filter's current parameters */
+    if(H5P_get_filter_by_id(dcpl_plist, H5Z_FILTER_BITSHUFFLE, &flags, &cd_nelmts, cd_values, (size_t)0, NULL, NULL) < 0)
+	HGOTO_ERROR(H5E_PLINE, H5E_CANTGET, FAIL, "can't get bitshuffle parameters")
+
+    /* Check the user's parameters */
+    if(cd_values[H5Z_BITSHUFFLE_PARM_BLOCK] % H5Z_BITSHUFFLE_BLOCK_MULT)
+	HGOTO_ERROR(H5E_PLINE, H5E_BADVALUE, FAIL, "bitshuffle block size must be a multiple of 8")
+    if(!H5Z__bitshuffle_native(cd_values[H5Z_BITSHUFFLE_PARM_COMPRESS])) {
+        const H5Z_class2_t *plugin;     /* Plugin's filter class */
+
+        if(NULL == (plugin = H5Z__bitshuffle_plugin()))
+            HGOTO_ERROR(H5E_PLINE, H5E_UNSUPPORTED, FAIL, "bitshuffle compression mode is not supported")
+        if(plugin->set_local && (plugin->set_local)(dcpl_id, type_id, space_id) < 0)
+            HGOTO_ERROR(H5E_PLINE, H5E_SETLOCAL, FAIL, "bitshuffle plugin can't set local parameters")
+        HGOTO_DONE(SUCCEED)
+    } /* end if */
+
+    /* Set "local" parameters for this dataset */
+    cd_values[H5Z_BITSHUFFLE_PARM_MAJOR] = H5Z_BITSHUFFLE_VERS_MAJOR;
+    cd_values[H5Z_BITSHUFFLE_PARM_MINOR] = H5Z_BITSHUFFLE_VERS_MINOR;
+    if((cd_values[H5Z_BITSHUFFLE_PARM_SIZE] = (unsigned)H5T_get_size(type)) == 0)
+	HGOTO_ERROR(H5E_PLINE, H5E_BADTYPE, FAIL, "bad datatype size")
+
+    /* Modify the filter's parameters for this dataset */
+    if(H5P_modify_filter(dcpl_plist, H5Z_FILTER_BITSHUFFLE, flags, (size_t)H5Z_BITSHUFFLE_TOTAL_NPARMS, cd_values) < 0)
+	HGOTO_ERROR(H5E_PLINE, H5E_CANTSET, FAIL, "can't set local bitshuffle parameters")
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5Z__set_local_bitshuffle() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5Z__bitshuffle_trans_bits
+ *
+ * Purpose:	Transpose the bits of each group of 8 bytes in BUF, so bit
+ *              K of byte J of a group becomes bit J of byte K.  This is
+ *              its own inverse.
+ *
+ * Return:	void
+ *
+ *-------------------------------------------------------------------------
+ */
+static void
+H5Z__bitshuffle_trans_bits(unsigned char *buf, size_t nwords)
+{
+    uint64_t x, t;              /* Word being transposed, and scratch */
+    size_t u;                   /* Local index variable */
+
+    FUNC_ENTER_STATIC_NOERR
+
+    for(u = 0; u < nwords; u++, buf += 8) {
+        HDmemcpy(&x, buf, sizeof(x));
+        x = H5Z_BITSHUFFLE_LE64(x);
+        H5Z_BITSHUFFLE_TRANS_8X8(x, t)
+        x = H5Z_BITSHUFFLE_LE64(x);
+        HDmemcpy(buf, &x, sizeof(x));
+    } /* end for */
+
+    FUNC_LEAVE_NOAPI_VOID
+} /* end H5Z__bitshuffle_trans_bits() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5Z__bitshuffle_block
+ *
+ * Purpose:	Bitshuffle (or bitunshuffle, if REVERSE is set) one block
+ *              of NELMTS elements, a multiple of 8, from SRC into DEST.
+ *              TMP must have room for the block.
+ *
+ *              The transpose is done in three steps: the bytes of the
+ *              elements are shuffled, the bits of each group of 8 bytes
+ *              are transposed, then the bytes of the groups are shuffled
+ *              again, as 8-byte elements, within each byte position of
+ *              the elements.  Both byte shuffles use the shuffle filter's
+ *              vector code when it's available.
+ *
+ * Return:	void
+ *
+ *-------------------------------------------------------------------------
+ */
+static void
+H5Z__bitshuffle_block(unsigned char *dest, const unsigned char *src,
+    unsigned char *tmp, unsigned elem_size, size_t nelmts, hbool_t reverse)
+{
+    size_t u;                   /* Local index variable */
+
+    FUNC_ENTER_STATIC_NOERR
+
+    HDassert(nelmts % H5Z_BITSHUFFLE_BLOCK_MULT == 0);
+
+    if(reverse) {
+        for(u = 0; u < elem_size; u++)
+            H5Z__shuffle_bytes(tmp + (u * nelmts), src + (u * nelmts), 8, nelmts / 8, TRUE);
+        H5Z__bitshuffle_trans_bits(tmp, (nelmts * elem_size) / 8);
+        H5Z__shuffle_bytes(dest, tmp, elem_size, nelmts, TRUE);
+    } /* end if */
+    else {
+        H5Z__shuffle_bytes(tmp, src, elem_size, nelmts, FALSE);
+        H5Z__bitshuffle_trans_bits(tmp, (nelmts * elem_size) / 8);
+        for(u = 0; u < elem_size; u++)
+            H5Z__shuffle_bytes(dest + (u * nelmts), tmp + (u * nelmts), 8, nelmts / 8, FALSE);
+    } /* end else */
+
+    FUNC_LEAVE_NOAPI_VOID
+} /* end H5Z__bitshuffle_block() */
+
+
+#ifdef H5_HAVE_FILTER_LZ4
+
+/*-------------------------------------------------------------------------
+ * Function:	H5Z__bitshuffle_lz4
+ *
+ * Purpose:	Bitshuffle and compress (or decompress and bitunshuffle, if
+ *              REVERSE is set) a buffer the way the bitshuffle plugin does
+ *              in its LZ4 mode.
+ *
+ *              The compressed data starts with the big-endian sizes of the
+ *              unfiltered data, 8 bytes, and of a block in bytes, 4 bytes.
+ *              Each block is then bitshuffled and compressed on its own,
+ *              and stored after its big-endian compressed size.  The
+ *              elements after the last group of 8 are stored as they are,
+ *              after the blocks.
+ *
+ * Return:	Success: Size of buffer filtered
+ *		Failure: 0
+ *
+ *-------------------------------------------------------------------------
+ */
+static size_t
+H5Z__bitshuffle_lz4(hbool_t reverse, unsigned elem_size, size_t block_size,
+    size_t nbytes, size_t *buf_size, void **buf)
+{
+    uint8_t *outbuf = NULL;             /* Pointer to new buffer */
+    uint8_t *tmp = NULL;                /* Bitshuffled block */
+    uint8_t *scratch = NULL;            /* Scratch buffer for a block */
+    uint32_t *table = NULL;             /* Hash table for compression */
+    const uint8_t *ip = (const uint8_t *)(*buf);    /* Current input position */
+    const uint8_t *iend = ip + nbytes;  /* End of input */
+    uint8_t *op;                        /* Current output position */
+    uint64_t orig_size;                 /* Size of the unfiltered data */
+    size_t out_size;                    /* Size of the output buffer */
+    size_t nelmts;                      /* Number of elements */
+    size_t nblock;                      /* Number of elements in current block */
+    size_t offset;                      /* Offset of current block, in elements */
+    size_t size;                        /* Size of current block, in bytes */
+    size_t comp_size;                   /* Compressed size of current block */
+    size_t ret_value = 0;               /* Return value */
+
+    FUNC_ENTER_STATIC
+
+    if(reverse) {
+        /* Read the header; its block size overrides the filter's */
+        if(nbytes < H5Z_BITSHUFFLE_HEADER_SIZE)
+            HGOTO_ERROR(H5E_PLINE, H5E_CANTDECODE, 0, "bitshuffle data is too short")
+        orig_size = ((uint64_t)H5Z_LZ4_DECODE32(ip) << 32) | H5Z_LZ4_DECODE32(ip + 4);
+        block_size = H5Z_LZ4_DECODE32(ip + 8) / elem_size;
+        ip += H5Z_BITSHUFFLE_HEADER_SIZE;
+        if(orig_size > (uint64_t)((size_t)-1))
+            HGOTO_ERROR(H5E_PLINE, H5E_CANTDECODE, 0, "bitshuffle data is too large")
+        if(orig_size % elem_size)
+            HGOTO_ERROR(H5E_PLINE, H5E_CANTDECODE, 0, "bitshuffle data doesn't hold a whole number of elements")
+        nelmts = (size_t)orig_size / elem_size;
+        if(nelmts >= H5Z_BITSHUFFLE_BLOCK_MULT && (block_size == 0 || block_size % H5Z_BITSHUFFLE_BLOCK_MULT))
+            HGOTO_ERROR(H5E_PLINE, H5E_CANTDECODE, 0, "invalid bitshuffle block size")
+        out_size = MAX((size_t)orig_size, 1);
+    } /* end if */
+    else {
+        if(nbytes % elem_size)
+            HGOTO_ERROR(H5E_ARGS, H5E_BADVALUE, 0, "bitshuffle buffer doesn't hold a whole number of elements")
+        if(block_size > H5Z_LZ4_MAX_BLOCK / elem_size)
+            HGOTO_ERROR(H5E_PLINE, H5E_CANTENCODE, 0, "bitshuffle block is too large for lz4")
+        nelmts = nbytes / elem_size;
+        orig_size = nbytes;
+
+        /* Allocate the most the data can compress to, so it never has to
+         * be reallocated */
+        out_size = H5Z_BITSHUFFLE_HEADER_SIZE;
+        for(offset = 0; nelmts - offset >= H5Z_BITSHUFFLE_BLOCK_MULT; offset += nblock) {
+            nblock = MIN(block_size, nelmts - offset);
+            nblock -= nblock % H5Z_BITSHUFFLE_BLOCK_MULT;
+            out_size += 4 + H5Z_LZ4_COMPRESS_BOUND(nblock * elem_size);
+        } /* end for */
+        out_size += (nelmts - offset) * elem_size;
+        if(NULL == (table = (uint32_t *)H5MM_malloc(H5Z_LZ4_TABLE_SIZE)))
+            HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, 0, "memory allocation failed for lz4 compression")
+    } /* end else */
+
+    /* Allocate the output and block buffers */
+    if(NULL == (outbuf = (uint8_t *)H5MM_malloc(out_size)))
+        HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, 0, "memory allocation failed for bitshuffle buffer")
+    if(nelmts >= H5Z_BITSHUFFLE_BLOCK_MULT) {
+        if(NULL == (tmp = (uint8_t *)H5MM_malloc(MIN(block_size, nelmts) * elem_size)))
+            HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, 0, "memory allocation failed for bitshuffle buffer")
+        if(NULL == (scratch = (uint8_t *)H5MM_malloc(MIN(block_size, nelmts) * elem_size)))
+            HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, 0, "memory allocation failed for bitshuffle buffer")
+    } /* end if */
+
+    /* Write the header */
+    op = outbuf;
+    if(!reverse) {
+        H5Z_LZ4_ENCODE32(op, (uint32_t)(orig_size >> 32));
+        H5Z_LZ4_ENCODE32(op + 4, (uint32_t)orig_size);
+        H5Z_LZ4_ENCODE32(op + 8, (uint32_t)(block_size * elem_size));
+        op += H5Z_BITSHUFFLE_HEADER_SIZE;
+    } /* end if */
+
+    /* [De]compress each block; the last one is cut down to a multiple of 8
+     * elements */
+    for(offset = 0; nelmts - offset >= H5Z_BITSHUFFLE_BLOCK_MULT; offset += nblock) {
+        nblock = MIN(block_size, nelmts - offset);
+        nblock -= nblock % H5Z_BITSHUFFLE_BLOCK_MULT;
+        size = nblock * elem_size;
+
+        if(reverse) {
+            if(iend - ip < 4)
+                HGOTO_ERROR(H5E_PLINE, H5E_CANTDECODE, 0, "truncated bitshuffle data")
+            comp_size = H5Z_LZ4_DECODE32(ip);
+            ip += 4;
+            if(comp_size > (size_t)(iend - ip))
+                HGOTO_ERROR(H5E_PLINE, H5E_CANTDECODE, 0, "truncated bitshuffle data")
+            if(H5Z__lz4_decompress_block(ip, comp_size, tmp, size) < 0)
+                HGOTO_ERROR(H5E_PLINE, H5E_CANTDECODE, 0, "lz4 decompression failed")
+            ip += comp_size;
+            H5Z__bitshuffle_block(op, tmp, scratch, elem_size, nblock, TRUE);
+            op += size;
+        } /* end if */
+        else {
+            H5Z__bitshuffle_block(tmp, ip, scratch, elem_size, nblock, FALSE);
+            ip += size;
+            comp_size = H5Z__lz4_compress_block(tmp, size, op + 4, table, 1);
+            H5Z_LZ4_ENCODE32(op, (uint32_t)comp_size);
+            op += 4 + comp_size;
+        } /* end else */
+    } /* end for */
+
+    /* Copy the elements left over */
+    size = (nelmts - offset) * elem_size;
+    if(size > (size_t)(iend - ip))
+        HGOTO_ERROR(H5E_PLINE, H5E_CANTDECODE, 0, "truncated bitshuffle data")
+    H5MM_memcpy(op, ip, size);
+    op += size;
+
+    /* Free the input buffer and set the buffer information to return */
+    H5MM_xfree(*buf);
+    *buf = outbuf;
+    *buf_size = out_size;
+    ret_value = (size_t)(op - outbuf);
+    outbuf = NULL;
+
+done:
+    H5MM_xfree(outbuf);
+    H5MM_xfree(tmp);
+    H5MM_xfree(scratch);
+    H5MM_xfree(table);
+
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5Z__bitshuffle_lz4() */
+
+#endif /* H5_HAVE_FILTER_LZ4 */
+
+/*-------------------------------------------------------------------------
+ * Function:	H5Z__filter_bitshuffle
+ *
+ * Purpose:	Implement an I/O filter which transposes the bits of a
+ *              buffer of elements, putting the bits at each bit position
+ *              of the elements together.  For integer data whose values
+ *              don't use all of their bits, this leaves long runs of zero
+ *              bits for a compression filter after it to take out, or for
+ *              the filter's own LZ4 mode.
+ *
+ * Return:	Success: Size of buffer filtered
+ *		Failure: 0
+ *
+ *-------------------------------------------------------------------------
+ */
+static size_t
+H5Z__filter_bitshuffle(unsigned flags, size_t cd_nelmts, const unsigned cd_values[],
+    size_t nbytes, size_t *buf_size, void **buf)
+{
+    unsigned char *dest = NULL;         /* Buffer to deposit [un]shuffled bits into */
+    unsigned char *tmp = NULL;          /* Scratch buffer for a block */
+    const unsigned char *src = (const unsigned char *)(*buf);  /* Alias for source buffer */
+    unsigned elem_size;                 /* Number of bytes per element */
+    unsigned compress;                  /* Compression mode */
+    size_t block_size;                  /* Number of elements per block */
+    size_t nelmts;                      /* Number of elements in buffer */
+    size_t nblock;                      /* Number of elements in current block */
+    size_t offset;                      /* Offset of current block, in elements */
+    hbool_t reverse = (hbool_t)((flags & H5Z_FLAG_REVERSE) != 0);
+    size_t ret_value = 0;               /* Return value */
+
+    FUNC_ENTER_STATIC
+
+    /* Check arguments */
+    if(cd_nelmts <= H5Z_BITSHUFFLE_PARM_SIZE || cd_values[H5Z_BITSHUFFLE_PARM_SIZE] == 0)
+	HGOTO_ERROR(H5E_ARGS, H5E_BADVALUE, 0, "invalid bitshuffle parameters")
+    compress = cd_nelmts > H5Z_BITSHUFFLE_PARM_COMPRESS ? cd_values[H5Z_BITSHUFFLE_PARM_COMPRESS] : H5Z_BITSHUFFLE_COMPRESS_NONE;
+
+    /* Hand the modes the library doesn't do to the plugin */
+    if(!H5Z__bitshuffle_native(compress)) {
+        const H5Z_class2_t *plugin;     /* Plugin's filter class */
+
+        if(NULL == (plugin = H5Z__bitshuffle_plugin()))
+            HGOTO_ERROR(H5E_PLINE, H5E_UNSUPPORTED, 0, "bitshuffle compression mode is not supported")
+        if(0 == (ret_value = (plugin->filter)(flags, cd_nelmts, cd_values, nbytes, buf_size, buf)))
+            HGOTO_ERROR(H5E_PLINE, H5E_CANTFILTER, 0, "bitshuffle plugin filter failed")
+        HGOTO_DONE(ret_value)
+    } /* end if */
+
+    /* Get the number of bytes per element and the block size */
+    elem_size = cd_values[H5Z_BITSHUFFLE_PARM_SIZE];
+    if(cd_nelmts > H5Z_BITSHUFFLE_PARM_BLOCK && cd_values[H5Z_BITSHUFFLE_PARM_BLOCK] != 0)
+        block_size = cd_values[H5Z_BITSHUFFLE_PARM_BLOCK];
+    else {
+        block_size = H5Z_BITSHUFFLE_BLOCK_BYTES / elem_size;
+        block_size -= block_size % H5Z_BITSHUFFLE_BLOCK_MULT;
+        block_size = MAX(block_size, H5Z_BITSHUFFLE_BLOCK_MIN);
+    } /* end else */
+    if(block_size % H5Z_BITSHUFFLE_BLOCK_MULT)
+	HGOTO_ERROR(H5E_ARGS, H5E_BADVALUE, 0, "invalid bitshuffle block size")
+
+#ifdef H5_HAVE_FILTER_LZ4
+    /* Compress each block with lz4 */
+    if(compress == H5Z_BITSHUFFLE_COMPRESS_LZ4) {
+        if(0 == (ret_value = H5Z__bitshuffle_lz4(reverse, elem_size, block_size, nbytes, buf_size, buf)))
+            HGOTO_ERROR(H5E_PLINE, H5E_CANTFILTER, 0, "bitshuffle lz4 filter failed")
+        HGOTO_DONE(ret_value)
+    } /* end if */
+#endif /* H5_HAVE_FILTER_LZ4 */
+
+    /* The buffer has to hold whole elements */
+    if(nbytes % elem_size)
+	HGOTO_ERROR(H5E_ARGS, H5E_BADVALUE, 0, "bitshuffle buffer doesn't hold a whole number of elements")
+    nelmts = nbytes / elem_size;
+
+    /* Don't do anything if there isn't a whole group of elements */
+    if(nelmts >= H5Z_BITSHUFFLE_BLOCK_MULT) {
+        /* Allocate the destination and scratch buffers */
+        if(NULL == (dest = (unsigned char *)H5MM_malloc(nbytes)))
+            HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, 0, "memory allocation failed for bitshuffle buffer")
+        if(NULL == (tmp = (unsigned char *)H5MM_malloc(MIN(block_size, nelmts) * elem_size)))
+            HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, 0, "memory allocation failed for bitshuffle buffer")
+
+        /* Transpose each block; the last one is cut down to a multiple of 8
+         * elements */
+        for(offset = 0; nelmts - offset >= H5Z_BITSHUFFLE_BLOCK_MULT; offset += nblock) {
+            nblock = MIN(block_size, nelmts - offset);
+            nblock -= nblock % H5Z_BITSHUFFLE_BLOCK_MULT;
+            H5Z__bitshuffle_block(dest + (offset * elem_size), src + (offset * elem_size),
+                    tmp, elem_size, nblock, reverse);
+        } /* end for */
+
+        /* Copy the elements left over */
+        if(offset < nelmts)
+            H5MM_memcpy(dest + (offset * elem_size), src + (offset * elem_size),
+                    (nelmts - offset) * elem_size);
+
+        /* Free the input buffer */
+        H5MM_xfree(*buf);
+
+        /* Set the buffer information to return */
+        *buf = dest;
+        *buf_size = nbytes;
+        dest = NULL;
+    } /* end if */
+
+    /* Set the return value */
+    ret_value = nbytes;
+
+done:
+    H5MM_xfree(dest);
+    H5MM_xfree(tmp);
+
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5Z__filter_bitshuffle() */
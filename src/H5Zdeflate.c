@@ -20,6 +20,7 @@
 
 
 #include "H5private.h"		/* Generic Functions			*/
+#include "H5CXprivate.h"        /* API Contexts                         */
 #include "H5Eprivate.h"		/* Error handling		  	*/
 #include "H5MMprivate.h"	/* Memory management			*/
 #include "H5Zpkg.h"		/* Data filters				*/
@@ -33,9 +34,41 @@
 # include H5_ZLIB_HEADER /* "zlib.h" */
 #endif
 
+/* Size of the blocks of a chunk that are compressed separately when
+ * compressing with multiple threads */
+#define H5Z_DEFLATE_BLOCK_SIZE  ((size_t)1024 * 1024)
+
+/* Amount of the data before each block used as its dictionary (the
+ * largest distance deflate can refer back) */
+#define H5Z_DEFLATE_DICT_SIZE   ((size_t)32768)
+
+/* Room for the compressed data of each block, including the empty stored
+ * block that ends it on a byte boundary */
+#define H5Z_DEFLATE_BLOCK_BOUND ((size_t)compressBound((uLong)H5Z_DEFLATE_BLOCK_SIZE) + 16)
+
+/* Size of the zlib header and trailer */
+#define H5Z_DEFLATE_HEADER_SIZE         2
+#define H5Z_DEFLATE_TRAILER_SIZE        4
+
+/* Local typedefs */
+
+/* Information for compressing the blocks of a chunk */
+typedef struct H5Z_deflate_blocks_t {
+    Bytef *src;                 /* Data to compress */
+    size_t nbytes;              /* Size of data */
+    int level;                  /* Compression level */
+    Bytef *dst;                 /* Output; block N's compressed data goes at
+                                 * N * H5Z_DEFLATE_BLOCK_BOUND after the header */
+    size_t *dst_nbytes;         /* Size of each block's compressed data */
+    uLong *adler;               /* Adler-32 checksum of each block's data */
+} H5Z_deflate_blocks_t;
+
 /* Local function prototypes */
 static size_t H5Z_filter_deflate (unsigned flags, size_t cd_nelmts,
     const unsigned cd_values[], size_t nbytes, size_t *buf_size, void **buf);
+static herr_t H5Z__deflate_block_cb(size_t idx, void *_udata);
+static herr_t H5Z__deflate_blocks(Bytef *src, size_t nbytes, int level,
+    unsigned nthreads, void **dst, size_t *dst_alloc, size_t *dst_nbytes);
 
 /* This message derives from H5Z */
 const H5Z_class2_t H5Z_DEFLATE[1] = {{
@@ -51,6 +84,170 @@ const H5Z_class2_t H5Z_DEFLATE[1] = {{
 
 #define H5Z_DEFLATE_SIZE_ADJUST(s) (HDceil(((double)(s)) * (double)1.001f) + 12)
 
+
+/*-------------------------------------------------------------------------
+ * Function:	H5Z__deflate_block_cb
+ *
+ * Purpose:	Compress one block for H5Z__deflate_blocks(), as raw deflate
+ *              data primed with the data before the block.  Every block
+ *              but the last ends with a sync flush, so that it ends on a
+ *              byte boundary and the next block's data can follow it.
+ *              This may be called from a helper thread, so it only touches
+ *              the block's own part of the output.
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5Z__deflate_block_cb(size_t idx, void *_udata)
+{
+    H5Z_deflate_blocks_t *udata = (H5Z_deflate_blocks_t *)_udata;
+    size_t      offset = idx * H5Z_DEFLATE_BLOCK_SIZE;  /* Offset of block in data */
+    size_t      nbytes = MIN(H5Z_DEFLATE_BLOCK_SIZE, udata->nbytes - offset);   /* Size of block */
+    hbool_t     last = (offset + nbytes == udata->nbytes);  /* Whether this is the last block */
+    z_stream    z_strm;                 /* zlib parameters */
+    hbool_t     z_init = FALSE;         /* Whether the stream is initialized */
+    int         status;                 /* Status from zlib operation */
+    herr_t      ret_value = SUCCEED;    /* Return value */
+
+    FUNC_ENTER_STATIC_NOERR
+
+    /* Start a stream without the zlib header and trailer */
+    HDmemset(&z_strm, 0, sizeof(z_strm));
+    if(Z_OK != deflateInit2(&z_strm, udata->level, Z_DEFLATED, -MAX_WBITS, 8, Z_DEFAULT_STRATEGY))
+        HGOTO_DONE(FAIL)
+    z_init = TRUE;
+
+    /* Let the block refer back to the data before it, which will precede it
+     * when the whole stream is decompressed */
+    if(offset > 0)
+        if(Z_OK != deflateSetDictionary(&z_strm, udata->src + offset - H5Z_DEFLATE_DICT_SIZE, (uInt)H5Z_DEFLATE_DICT_SIZE))
+            HGOTO_DONE(FAIL)
+
+    /* Compress the block */
+    z_strm.next_in = udata->src + offset;
+    z_strm.avail_in = (uInt)nbytes;
+    z_strm.next_out = udata->dst + H5Z_DEFLATE_HEADER_SIZE + (idx * H5Z_DEFLATE_BLOCK_BOUND);
+    z_strm.avail_out = (uInt)H5Z_DEFLATE_BLOCK_BOUND;
+    status = deflate(&z_strm, last ? Z_FINISH : Z_SYNC_FLUSH);
+    if(status != (last ? Z_STREAM_END : Z_OK) || 0 != z_strm.avail_in || 0 == z_strm.avail_out)
+        HGOTO_DONE(FAIL)
+
+    udata->dst_nbytes[idx] = (size_t)z_strm.total_out;
+    udata->adler[idx] = adler32(adler32(0L, Z_NULL, 0), udata->src + offset, (uInt)nbytes);
+
+done:
+    if(z_init)
+        (void)deflateEnd(&z_strm);
+
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5Z__deflate_block_cb() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5Z__deflate_blocks
+ *
+ * Purpose:	Compress NBYTES of data at SRC into a zlib stream, by
+ *              compressing blocks of H5Z_DEFLATE_BLOCK_SIZE bytes with up
+ *              to NTHREADS threads and joining them, with a zlib header
+ *              and the Adler-32 checksum of all the data, into a single
+ *              stream.  As each block is primed with the data before it,
+ *              the stream is only slightly larger than compressing the
+ *              data in one piece.
+ *
+ *              The stream is returned in a new buffer through DST, the
+ *              buffer's size through DST_ALLOC and the stream's size
+ *              through DST_NBYTES.
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5Z__deflate_blocks(Bytef *src, size_t nbytes, int level, unsigned nthreads,
+    void **dst, size_t *dst_alloc, size_t *dst_nbytes)
+{
+    H5Z_deflate_blocks_t udata;         /* Information for compressing blocks */
+    size_t      nblocks;                /* Number of blocks */
+    size_t      alloc;                  /* Size of output buffer */
+    unsigned    level_flags;            /* Compression level flags for header */
+    unsigned    header;                 /* zlib header */
+    uLong       adler;                  /* Checksum of all the data */
+    Bytef      *p;                      /* Where the next block goes */
+    size_t      u;                      /* Local index variable */
+    herr_t      ret_value = SUCCEED;    /* Return value */
+
+    FUNC_ENTER_STATIC
+
+    HDmemset(&udata, 0, sizeof(udata));
+    udata.src = src;
+    udata.nbytes = nbytes;
+    udata.level = level;
+
+    /* Allocate the output, with room for the header and trailer */
+    nblocks = (nbytes + H5Z_DEFLATE_BLOCK_SIZE - 1) / H5Z_DEFLATE_BLOCK_SIZE;
+    alloc = H5Z_DEFLATE_HEADER_SIZE + (nblocks * H5Z_DEFLATE_BLOCK_BOUND) + H5Z_DEFLATE_TRAILER_SIZE;
+    if(NULL == (udata.dst = (Bytef *)H5MM_malloc(alloc)))
+        HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "unable to allocate deflate destination buffer")
+    if(NULL == (udata.dst_nbytes = (size_t *)H5MM_malloc(nblocks * sizeof(size_t))))
+        HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "unable to allocate deflate block sizes")
+    if(NULL == (udata.adler = (uLong *)H5MM_malloc(nblocks * sizeof(uLong))))
+        HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "unable to allocate deflate block checksums")
+
+    /* Compress the blocks, each in its own part of the output */
+    if(H5TS_parallel_for(nthreads, nblocks, H5Z__deflate_block_cb, &udata) < 0)
+        HGOTO_ERROR(H5E_PLINE, H5E_CANTINIT, FAIL, "deflate() failed")
+
+    /* Write the zlib header, with the compression level flags zlib would
+     * use */
+    if(level < 2)
+        level_flags = 0;
+    else if(level < 6)
+        level_flags = 1;
+    else if(level == 6)
+        level_flags = 2;
+    else
+        level_flags = 3;
+    header = ((Z_DEFLATED + ((MAX_WBITS - 8) << 4)) << 8) | (level_flags << 6);
+    header += 31 - (header % 31);
+    udata.dst[0] = (Bytef)(header >> 8);
+    udata.dst[1] = (Bytef)(header & 0xff);
+
+    /* Move the blocks together and combine their checksums */
+    p = udata.dst + H5Z_DEFLATE_HEADER_SIZE + udata.dst_nbytes[0];
+    adler = udata.adler[0];
+    for(u = 1; u < nblocks; u++) {
+        size_t block_nbytes = MIN(H5Z_DEFLATE_BLOCK_SIZE, nbytes - (u * H5Z_DEFLATE_BLOCK_SIZE));
+
+        HDmemmove(p, udata.dst + H5Z_DEFLATE_HEADER_SIZE + (u * H5Z_DEFLATE_BLOCK_BOUND), udata.dst_nbytes[u]);
+        p += udata.dst_nbytes[u];
+        adler = adler32_combine(adler, udata.adler[u], (z_off_t)block_nbytes);
+    } /* end for */
+
+    /* Write the trailer */
+    *p++ = (Bytef)((adler >> 24) & 0xff);
+    *p++ = (Bytef)((adler >> 16) & 0xff);
+    *p++ = (Bytef)((adler >> 8) & 0xff);
+    *p++ = (Bytef)(adler & 0xff);
+
+    /* Set return values */
+    *dst_nbytes = (size_t)(p - udata.dst);
+    *dst_alloc = alloc;
+    *dst = udata.dst;
+    udata.dst = NULL;
+
+done:
+    if(udata.dst)
+        H5MM_xfree(udata.dst);
+    if(udata.dst_nbytes)
+        H5MM_xfree(udata.dst_nbytes);
+    if(udata.adler)
+        H5MM_xfree(udata.adler);
+
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5Z__deflate_blocks() */
+
 
 /*-------------------------------------------------------------------------
  * Function:	H5Z_filter_deflate
@@ -72,12 +269,46 @@ static size_t
 H5Z_filter_deflate (unsigned flags, size_t cd_nelmts,
 		    const unsigned cd_values[], size_t nbytes,
 		    size_t *buf_size, void **buf)
+{
+    size_t	ret_value = 0;          /* Return value */
+
+    FUNC_ENTER_NOAPI_NOINIT_NOERR
+
+    ret_value = H5Z__filter_deflate_sized(flags, cd_nelmts, cd_values, nbytes,
+            (size_t)0, NULL, buf_size, buf);
+
+    FUNC_LEAVE_NOAPI(ret_value)
+}
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5Z__filter_deflate_sized
+ *
+ * Purpose:	The deflate filter, also passed the size of the fully
+ *              decoded data when it is known (DECODED_NBYTES, or 0).  The
+ *              uncompressed data usually needs no more room than that, so
+ *              decompression starts with an output buffer of that size,
+ *              rather than one the size of the input buffer that is then
+ *              doubled until the data fits.  The buffers are allocated
+ *              and freed with MEM, if it isn't NULL (see
+ *              H5Z_pipeline_mem()).
+ *
+ * Return:	Success: Size of buffer filtered
+ *		Failure: 0
+ *
+ *-------------------------------------------------------------------------
+ */
+size_t
+H5Z__filter_deflate_sized(unsigned flags, size_t cd_nelmts,
+    const unsigned cd_values[], size_t nbytes, size_t decoded_nbytes,
+    const H5Z_mem_t *mem, size_t *buf_size, void **buf)
 {
     void	*outbuf = NULL;         /* Pointer to new buffer */
+    size_t	out_alloc = 0;          /* Size of new buffer */
     int		status;                 /* Status from zlib operation */
     size_t	ret_value = 0;          /* Return value */
 
-    FUNC_ENTER_NOAPI(0)
+    FUNC_ENTER_PACKAGE
 
     /* Sanity check */
     HDassert(*buf_size > 0);
@@ -91,11 +322,12 @@ H5Z_filter_deflate (unsigned flags, size_t cd_nelmts,
     if (flags & H5Z_FLAG_REVERSE) {
 	/* Input; uncompress */
 	z_stream	z_strm;                 /* zlib parameters */
-	size_t		nalloc = *buf_size;     /* Number of bytes for output (compressed) buffer */
+	size_t		nalloc;                 /* Number of bytes for output (uncompressed) buffer */
 
         /* Allocate space for the compressed buffer */
-	if (NULL==(outbuf = H5MM_malloc(nalloc)))
+	if (NULL==(outbuf = H5Z__mem_alloc(mem, decoded_nbytes > 0 ? decoded_nbytes : *buf_size, &out_alloc)))
 	    HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, 0, "memory allocation failed for deflate uncompression")
+        nalloc = out_alloc;
 
         /* Set the uncompression parameters */
 	HDmemset(&z_strm, 0, sizeof(z_strm));
@@ -134,6 +366,7 @@ H5Z_filter_deflate (unsigned flags, size_t cd_nelmts,
                         HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, 0, "memory allocation failed for deflate uncompression")
                     } /* end if */
                     outbuf = new_outbuf;
+                    out_alloc = nalloc;
 
                     /* Update pointers to buffer for next set of uncompressed data */
                     z_strm.next_out = (unsigned char*)outbuf + z_strm.total_out;
@@ -143,7 +376,7 @@ H5Z_filter_deflate (unsigned flags, size_t cd_nelmts,
 	} while(status==Z_OK);
 
         /* Free the input buffer */
-	H5MM_xfree(*buf);
+	H5Z__mem_free(mem, *buf, *buf_size);
 
         /* Set return values */
 	*buf = outbuf;
@@ -165,12 +398,40 @@ H5Z_filter_deflate (unsigned flags, size_t cd_nelmts,
 	uLongf	     z_dst_nbytes = (uLongf)H5Z_DEFLATE_SIZE_ADJUST(nbytes);
 	uLong	     z_src_nbytes = (uLong)nbytes;
         int          aggression;     /* Compression aggression setting */
+        unsigned     nthreads = 1;   /* Threads for compressing the chunk */
 
         /* Set the compression aggression level */
         H5_CHECKED_ASSIGN(aggression, int, cd_values[0], unsigned);
 
+        /* Get the number of threads to compress with from the API context
+         * (helper threads of H5TS_parallel_for() have no API context, and
+         * can't start threads of their own anyway) */
+#ifdef H5_HAVE_THREADSAFE
+        if(nbytes > H5Z_DEFLATE_BLOCK_SIZE && !H5TS_is_helper_thread())
+            if(H5CX_get_deflate_nthreads(&nthreads) < 0)
+                HGOTO_ERROR(H5E_PLINE, H5E_CANTGET, 0, "can't get number of deflate threads")
+#endif /* H5_HAVE_THREADSAFE */
+
+        /* Compress large chunks a block at a time with multiple threads */
+        if(nthreads > 1 && nbytes > H5Z_DEFLATE_BLOCK_SIZE) {
+            size_t dst_alloc = 0;   /* Size of compressed buffer */
+            size_t dst_nbytes = 0;  /* Size of compressed data */
+
+            if(H5Z__deflate_blocks((Bytef *)*buf, nbytes, aggression, nthreads, &outbuf, &dst_alloc, &dst_nbytes) < 0)
+                HGOTO_ERROR(H5E_PLINE, H5E_CANTINIT, 0, "unable to compress blocks of data")
+
+            /* Free the input buffer */
+	    H5Z__mem_free(mem, *buf, *buf_size);
+
+            /* Set return values */
+	    *buf = outbuf;
+	    outbuf = NULL;
+	    *buf_size = dst_alloc;
+	    HGOTO_DONE(dst_nbytes)
+        } /* end if */
+
         /* Allocate output (compressed) buffer */
-	if(NULL == (outbuf = H5MM_malloc(z_dst_nbytes)))
+	if(NULL == (outbuf = H5Z__mem_alloc(mem, (size_t)z_dst_nbytes, &out_alloc)))
 	    HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, 0, "unable to allocate deflate destination buffer")
         z_dst = (Bytef *)outbuf;
 
@@ -187,19 +448,19 @@ H5Z_filter_deflate (unsigned flags, size_t cd_nelmts,
         /* Successfully uncompressed the buffer */
         else {
             /* Free the input buffer */
-	    H5MM_xfree(*buf);
+	    H5Z__mem_free(mem, *buf, *buf_size);
 
             /* Set return values */
 	    *buf = outbuf;
 	    outbuf = NULL;
-	    *buf_size = nbytes;
+	    *buf_size = out_alloc;
 	    ret_value = z_dst_nbytes;
 	} /* end else */
     } /* end else */
 
 done:
     if(outbuf)
-        H5MM_xfree(outbuf);
+        H5Z__mem_free(mem, outbuf, out_alloc);
     FUNC_LEAVE_NOAPI(ret_value)
 }
 #endif /* H5_HAVE_FILTER_DEFLATE */
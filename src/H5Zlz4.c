@@ -0,0 +1,483 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * Copyright by The HDF Group.                                               *
+ * All rights reserved.                                                      *
+ *                                                                           *
+ * This file is part of HDF5.  The full HDF5 copyright notice, including     *
+ * terms governing use, modification, and redistribution, is contained in    *
+ * the COPYING file, which can be found at the root of the source code       *
+ * distribution tree, or in https://support.hdfgroup.org/ftp/HDF5/releases.  *
+ * If you do not have access to either file, you may request a copy from     *
+ * help@hdfgroup.org.                                                        *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+/*
+ * Purpose:	The LZ4 filter, a fast compressor.  The codec is built in,
+ *              so the filter needs no external library.
+ *
+ *              The filtered data is laid out the same way as by the LZ4
+ *              plugin filter, under the same filter id:
+ *
+ *                  8 bytes   size of the unfiltered data (big-endian)
+ *                  4 bytes   block size (big-endian)
+ *                  for each block of the unfiltered data:
+ *                      4 bytes   size of the compressed block (big-endian)
+ *                      ...       the block, in the LZ4 block format, or
+ *                                as it is if it didn't get smaller
+ *
+ *              Blocks are compressed independently; the last one may be
+ *              short.
+ */
+
+#include "H5Zmodule.h"          /* This source code file is part of the H5Z module */
+
+
+#include "H5private.h"		/* Generic Functions			*/
+#include "H5Eprivate.h"		/* Error handling		  	*/
+#include "H5MMprivate.h"	/* Memory management			*/
+#include "H5Pprivate.h"         /* Property lists                       */
+#include "H5Zpkg.h"		/* Data filters				*/
+
+#ifdef H5_HAVE_FILTER_LZ4
+
+/* Local macros */
+#define H5Z_LZ4_PARM_BLOCK      0       /* "User" parameter for the block size */
+#define H5Z_LZ4_PARM_ACCEL      1       /* "User" parameter for the acceleration */
+
+#define H5Z_LZ4_DEFAULT_BLOCK   (1U << 30)      /* Default block size, in bytes */
+#define H5Z_LZ4_HEADER_SIZE     12      /* Size of the header of the filtered data */
+
+/* LZ4 block format */
+#define H5Z_LZ4_MINMATCH        4       /* Shortest match */
+#define H5Z_LZ4_LASTLITERALS    5       /* The last bytes of a block are literals */
+#define H5Z_LZ4_MFLIMIT         12      /* The last match starts this far before the end */
+#define H5Z_LZ4_MAX_DISTANCE    65535   /* Farthest match */
+#define H5Z_LZ4_RUN_MASK        15      /* Length field of a token */
+#define H5Z_LZ4_SKIP_TRIGGER    6       /* Log2 of the misses before the step grows */
+
+/* Hash of the 4 bytes at P */
+#define H5Z_LZ4_HASH(p)     ((H5Z__lz4_read32(p) * 2654435761U) >> (32 - H5Z_LZ4_HASH_LOG))
+
+/* Local function prototypes */
+static herr_t H5Z__set_local_lz4(hid_t dcpl_id, hid_t type_id, hid_t space_id);
+static size_t H5Z__filter_lz4(unsigned flags, size_t cd_nelmts,
+    const unsigned cd_values[], size_t nbytes, size_t *buf_size, void **buf);
+
+/* This message derives from H5Z */
+const H5Z_class2_t H5Z_LZ4[1] = {{
+    H5Z_CLASS_T_VERS,           /* H5Z_class_t version */
+    H5Z_FILTER_LZ4,             /* Filter id number		*/
+    1,                          /* encoder_present flag (set to true) */
+    1,                          /* decoder_present flag (set to true) */
+    "lz4",                      /* Filter name for debugging	*/
+    NULL,                       /* The "can apply" callback     */
+    H5Z__set_local_lz4,         /* The "set local" callback     */
+    H5Z__filter_lz4,            /* The actual filter function	*/
+}};
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5Z__lz4_read32
+ *
+ * Purpose:	Read 4 bytes from P, which may not be aligned.
+ *
+ * Return:	The bytes, as a native integer
+ *
+ *-------------------------------------------------------------------------
+ */
+static H5_INLINE uint32_t
+H5Z__lz4_read32(const uint8_t *p)
+{
+    uint32_t u;
+
+    HDmemcpy(&u, p, sizeof(u));
+
+    return u;
+} /* end H5Z__lz4_read32() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5Z__set_local_lz4
+ *
+ * Purpose:	Check the block size and acceleration set by the user.
+ *
+ * Return:	Success: Non-negative
+ *		Failure: Negative
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5Z__set_local_lz4(hid_t dcpl_id, hid_t H5_ATTR_UNUSED type_id, hid_t H5_ATTR_UNUSED space_id)
+{
+    H5P_genplist_t *dcpl_plist;         /* Property list pointer */
+    unsigned flags;                     /* Filter flags */
+    size_t cd_nelmts = H5Z_LZ4_TOTAL_NPARMS;    /* Number of filter parameters */
+    unsigned cd_values[H5Z_LZ4_TOTAL_NPARMS] = {0, 0};  /* Filter parameters */
+    herr_t ret_value = SUCCEED;         /* Return value */
+
+    FUNC_ENTER_STATIC
+
+    /* Get the plist structure */
+    if(NULL == (dcpl_plist = H5P_object_verify(dcpl_id, H5P_DATASET_CREATE)))
+        HGOTO_ERROR(H5E_ATOM, H5E_BADATOM, FAIL, "can't find object for ID")
+
+    /* Get the filter's current parameters */
+    if(H5P_get_filter_by_id(dcpl_plist, H5Z_FILTER_LZ4, &flags, &cd_nelmts, cd_values, (size_t)0, NULL, NULL) < 0)
+	HGOTO_ERROR(H5E_PLINE, H5E_CANTGET, FAIL, "can't get lz4 parameters")
+
+    if(cd_values[H5Z_LZ4_PARM_BLOCK] > H5Z_LZ4_MAX_BLOCK)
+	HGOTO_ERROR(H5E_PLINE, H5E_BADVALUE, FAIL, "lz4 block size is too large")
+    if(cd_values[H5Z_LZ4_PARM_ACCEL] > H5Z_LZ4_MAX_ACCELERATION)
+	HGOTO_ERROR(H5E_PLINE, H5E_BADVALUE, FAIL, "lz4 acceleration is too large")
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5Z__set_local_lz4() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5Z__lz4_compress_block
+ *
+ * Purpose:	Compress SRC_SIZE bytes from SRC into DST, in the LZ4 block
+ *              format.  DST must have room for
+ *              H5Z_LZ4_COMPRESS_BOUND(SRC_SIZE) bytes.  TABLE is scratch
+ *              space for the hash table, H5Z_LZ4_TABLE_SIZE bytes.
+ *
+ *              Matches are found through a table of the last position of
+ *              each hash of 4 bytes.  After a run of misses the search
+ *              steps ahead faster; ACCEL makes it step faster from the
+ *              start, trading compression for speed.
+ *
+ * Return:	Size of the compressed block
+ *
+ *-------------------------------------------------------------------------
+ */
+size_t
+H5Z__lz4_compress_block(const uint8_t *src, size_t src_size, uint8_t *dst,
+    uint32_t *table, unsigned accel)
+{
+    const uint8_t *ip = src;                /* Current input position */
+    const uint8_t *anchor = src;            /* Start of the pending literals */
+    const uint8_t *const iend = src + src_size;     /* End of input */
+    const uint8_t *mflimit;                 /* Last start of a match */
+    const uint8_t *matchlimit;              /* End of matches */
+    const uint8_t *ref;                     /* Start of the match */
+    uint8_t *op = dst;                      /* Current output position */
+    uint8_t *token;                         /* Token of the current sequence */
+    size_t lit_len, match_len, len;         /* Lengths */
+    size_t search;                          /* Misses, scaled for the step */
+    uint32_t h;                             /* Hash */
+
+    FUNC_ENTER_PACKAGE_NOERR
+
+    if(src_size > H5Z_LZ4_MFLIMIT) {
+        mflimit = iend - H5Z_LZ4_MFLIMIT;
+        matchlimit = iend - H5Z_LZ4_LASTLITERALS;
+        HDmemset(table, 0, H5Z_LZ4_TABLE_SIZE);
+
+        for(;;) {
+            /* Find a match */
+            search = (size_t)accel << H5Z_LZ4_SKIP_TRIGGER;
+            for(;;) {
+                if(ip > mflimit)
+                    goto last_literals;
+                h = H5Z_LZ4_HASH(ip);
+                ref = src + table[h];
+                table[h] = (uint32_t)(ip - src);
+                if(ref < ip && (size_t)(ip - ref) <= H5Z_LZ4_MAX_DISTANCE
+                        && H5Z__lz4_read32(ref) == H5Z__lz4_read32(ip))
+                    break;
+                ip += search++ >> H5Z_LZ4_SKIP_TRIGGER;
+            } /* end for */
+
+match_found:
+            /* Extend the match backwards */
+            while(ip > anchor && ref > src && ip[-1] == ref[-1]) {
+                ip--;
+                ref--;
+            } /* end while */
+
+            /* Write the token and literals */
+            lit_len = (size_t)(ip - anchor);
+            token = op++;
+            if(lit_len >= H5Z_LZ4_RUN_MASK) {
+                *token = H5Z_LZ4_RUN_MASK << 4;
+                for(len = lit_len - H5Z_LZ4_RUN_MASK; len >= 255; len -= 255)
+                    *op++ = 255;
+                *op++ = (uint8_t)len;
+            } /* end if */
+            else
+                *token = (uint8_t)(lit_len << 4);
+            H5MM_memcpy(op, anchor, lit_len);
+            op += lit_len;
+
+            /* Write the offset */
+            *op++ = (uint8_t)(ip - ref);
+            *op++ = (uint8_t)((size_t)(ip - ref) >> 8);
+
+            /* Extend the match forwards and write its length */
+            ip += H5Z_LZ4_MINMATCH;
+            ref += H5Z_LZ4_MINMATCH;
+            anchor = ip;
+            while(ip < matchlimit && *ip == *ref) {
+                ip++;
+                ref++;
+            } /* end while */
+            match_len = (size_t)(ip - anchor);
+            if(match_len >= H5Z_LZ4_RUN_MASK) {
+                *token |= H5Z_LZ4_RUN_MASK;
+                for(len = match_len - H5Z_LZ4_RUN_MASK; len >= 255; len -= 255)
+                    *op++ = 255;
+                *op++ = (uint8_t)len;
+            } /* end if */
+            else
+                *token |= (uint8_t)match_len;
+            anchor = ip;
+
+            /* Matches often follow each other, so look for one right
+             * after this one, and remember a position near its end */
+            if(ip > mflimit)
+                goto last_literals;
+            table[H5Z_LZ4_HASH(ip - 2)] = (uint32_t)(ip - 2 - src);
+            h = H5Z_LZ4_HASH(ip);
+            ref = src + table[h];
+            table[h] = (uint32_t)(ip - src);
+            if((size_t)(ip - ref) <= H5Z_LZ4_MAX_DISTANCE && H5Z__lz4_read32(ref) == H5Z__lz4_read32(ip))
+                goto match_found;
+            ip++;
+        } /* end for */
+    } /* end if */
+
+last_literals:
+    /* Write the rest of the input as literals */
+    lit_len = (size_t)(iend - anchor);
+    if(lit_len >= H5Z_LZ4_RUN_MASK) {
+        *op++ = H5Z_LZ4_RUN_MASK << 4;
+        for(len = lit_len - H5Z_LZ4_RUN_MASK; len >= 255; len -= 255)
+            *op++ = 255;
+        *op++ = (uint8_t)len;
+    } /* end if */
+    else
+        *op++ = (uint8_t)(lit_len << 4);
+    H5MM_memcpy(op, anchor, lit_len);
+    op += lit_len;
+
+    FUNC_LEAVE_NOAPI((size_t)(op - dst))
+} /* end H5Z__lz4_compress_block() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5Z__lz4_decompress_block
+ *
+ * Purpose:	Decompress the LZ4 block of SRC_SIZE bytes at SRC into
+ *              exactly DST_SIZE bytes at DST.  Every length and offset is
+ *              checked against the buffers, so corrupt data can't read or
+ *              write past them.
+ *
+ * Return:	Non-negative on success/Negative on failure
+ *
+ *-------------------------------------------------------------------------
+ */
+herr_t
+H5Z__lz4_decompress_block(const uint8_t *src, size_t src_size, uint8_t *dst,
+    size_t dst_size)
+{
+    const uint8_t *ip = src;                /* Current input position */
+    const uint8_t *const iend = src + src_size;     /* End of input */
+    uint8_t *op = dst;                      /* Current output position */
+    uint8_t *const oend = dst + dst_size;   /* End of output */
+    const uint8_t *ref;                     /* Start of the match */
+    size_t lit_len, match_len, offset;      /* Sequence fields */
+    unsigned token;                         /* Token of the current sequence */
+    uint8_t b;                              /* Length byte */
+    herr_t ret_value = SUCCEED;             /* Return value */
+
+    FUNC_ENTER_PACKAGE
+
+    for(;;) {
+        if(ip >= iend)
+            HGOTO_ERROR(H5E_PLINE, H5E_CANTDECODE, FAIL, "truncated lz4 block")
+        token = *ip++;
+
+        /* Copy the literals */
+        lit_len = token >> 4;
+        if(lit_len == H5Z_LZ4_RUN_MASK)
+            do {
+                if(ip >= iend)
+                    HGOTO_ERROR(H5E_PLINE, H5E_CANTDECODE, FAIL, "truncated lz4 block")
+                b = *ip++;
+                lit_len += b;
+            } while(b == 255);
+        if(lit_len > (size_t)(iend - ip) || lit_len > (size_t)(oend - op))
+            HGOTO_ERROR(H5E_PLINE, H5E_CANTDECODE, FAIL, "corrupt lz4 block")
+        H5MM_memcpy(op, ip, lit_len);
+        op += lit_len;
+        ip += lit_len;
+
+        /* The last sequence has only literals */
+        if(ip == iend)
+            break;
+
+        /* Copy the match */
+        if(iend - ip < 2)
+            HGOTO_ERROR(H5E_PLINE, H5E_CANTDECODE, FAIL, "truncated lz4 block")
+        offset = (size_t)ip[0] | ((size_t)ip[1] << 8);
+        ip += 2;
+        if(offset == 0 || offset > (size_t)(op - dst))
+            HGOTO_ERROR(H5E_PLINE, H5E_CANTDECODE, FAIL, "corrupt lz4 block")
+        match_len = token & H5Z_LZ4_RUN_MASK;
+        if(match_len == H5Z_LZ4_RUN_MASK)
+            do {
+                if(ip >= iend)
+                    HGOTO_ERROR(H5E_PLINE, H5E_CANTDECODE, FAIL, "truncated lz4 block")
+                b = *ip++;
+                match_len += b;
+            } while(b == 255);
+        match_len += H5Z_LZ4_MINMATCH;
+        if(match_len > (size_t)(oend - op))
+            HGOTO_ERROR(H5E_PLINE, H5E_CANTDECODE, FAIL, "corrupt lz4 block")
+        ref = op - offset;
+        if(offset >= match_len) {
+            H5MM_memcpy(op, ref, match_len);
+            op += match_len;
+        } /* end if */
+        else
+            /* The match overlaps the bytes it produces */
+            while(match_len-- > 0)
+                *op++ = *ref++;
+    } /* end for */
+
+    if(op != oend)
+        HGOTO_ERROR(H5E_PLINE, H5E_CANTDECODE, FAIL, "lz4 block decompressed to the wrong size")
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5Z__lz4_decompress_block() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5Z__filter_lz4
+ *
+ * Purpose:	Implement an I/O filter around the LZ4 codec.
+ *
+ *              The output buffer is sized once: for compression, from the
+ *              largest size the blocks can compress to; for decompression,
+ *              from the size in the header.
+ *
+ * Return:	Success: Size of buffer filtered
+ *		Failure: 0
+ *
+ *-------------------------------------------------------------------------
+ */
+static size_t
+H5Z__filter_lz4(unsigned flags, size_t cd_nelmts, const unsigned cd_values[],
+    size_t nbytes, size_t *buf_size, void **buf)
+{
+    uint8_t *outbuf = NULL;             /* Pointer to new buffer */
+    uint32_t *table = NULL;             /* Hash table for compression */
+    const uint8_t *ip = (const uint8_t *)(*buf);    /* Current input position */
+    uint8_t *op;                        /* Current output position */
+    size_t block_size;                  /* Size of a block */
+    size_t size;                        /* Size of the current block */
+    size_t comp_size;                   /* Compressed size of the current block */
+    size_t out_size;                    /* Size of the output */
+    size_t nblocks;                     /* Number of blocks */
+    size_t done_size;                   /* Number of bytes [de]compressed */
+    uint64_t orig_size;                 /* Size of the unfiltered data */
+    unsigned accel = 1;                 /* Acceleration */
+    size_t ret_value = 0;               /* Return value */
+
+    FUNC_ENTER_STATIC
+
+    if(flags & H5Z_FLAG_REVERSE) {
+        /** Input; decompress **/
+        if(nbytes < H5Z_LZ4_HEADER_SIZE)
+            HGOTO_ERROR(H5E_PLINE, H5E_CANTDECODE, 0, "lz4 data is too short")
+        orig_size = ((uint64_t)H5Z_LZ4_DECODE32(ip) << 32) | H5Z_LZ4_DECODE32(ip + 4);
+        block_size = H5Z_LZ4_DECODE32(ip + 8);
+        ip += H5Z_LZ4_HEADER_SIZE;
+        if(orig_size > (uint64_t)((size_t)-1))
+            HGOTO_ERROR(H5E_PLINE, H5E_CANTDECODE, 0, "lz4 data is too large")
+        if(orig_size > 0 && block_size == 0)
+            HGOTO_ERROR(H5E_PLINE, H5E_CANTDECODE, 0, "invalid lz4 block size")
+
+        if(NULL == (outbuf = (uint8_t *)H5MM_malloc(MAX(orig_size, 1))))
+            HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, 0, "memory allocation failed for lz4 decompression")
+
+        for(done_size = 0, op = outbuf; done_size < orig_size; done_size += size, op += size) {
+            size = (size_t)MIN(block_size, orig_size - done_size);
+            if((size_t)((const uint8_t *)(*buf) + nbytes - ip) < 4)
+                HGOTO_ERROR(H5E_PLINE, H5E_CANTDECODE, 0, "truncated lz4 data")
+            comp_size = H5Z_LZ4_DECODE32(ip);
+            ip += 4;
+            if(comp_size > (size_t)((const uint8_t *)(*buf) + nbytes - ip))
+                HGOTO_ERROR(H5E_PLINE, H5E_CANTDECODE, 0, "truncated lz4 data")
+
+            /* Blocks that didn't get smaller are stored as they are */
+            if(comp_size == size)
+                H5MM_memcpy(op, ip, size);
+            else if(H5Z__lz4_decompress_block(ip, comp_size, op, size) < 0)
+                HGOTO_ERROR(H5E_PLINE, H5E_CANTDECODE, 0, "lz4 decompression failed")
+            ip += comp_size;
+        } /* end for */
+
+        H5MM_xfree(*buf);
+        *buf = outbuf;
+        *buf_size = MAX(orig_size, 1);
+        outbuf = NULL;
+        ret_value = (size_t)orig_size;
+    } /* end if */
+    else {
+        /** Output; compress **/
+        if(nbytes > H5Z_LZ4_MAX_BLOCK)
+            HGOTO_ERROR(H5E_PLINE, H5E_CANTENCODE, 0, "buffer is too large for lz4")
+        block_size = H5Z_LZ4_DEFAULT_BLOCK;
+        if(cd_nelmts > H5Z_LZ4_PARM_BLOCK && cd_values[H5Z_LZ4_PARM_BLOCK] > 0)
+            block_size = cd_values[H5Z_LZ4_PARM_BLOCK];
+        if(cd_nelmts > H5Z_LZ4_PARM_ACCEL && cd_values[H5Z_LZ4_PARM_ACCEL] > 0)
+            accel = MIN(cd_values[H5Z_LZ4_PARM_ACCEL], H5Z_LZ4_MAX_ACCELERATION);
+        block_size = MAX(MIN(block_size, nbytes), 1);
+        nblocks = nbytes ? ((nbytes - 1) / block_size) + 1 : 0;
+
+        /* Allocate the most the data can compress to, so it never has to
+         * be reallocated */
+        out_size = H5Z_LZ4_HEADER_SIZE + (nblocks * (4 + H5Z_LZ4_COMPRESS_BOUND(block_size)));
+        if(NULL == (outbuf = (uint8_t *)H5MM_malloc(out_size)))
+            HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, 0, "memory allocation failed for lz4 compression")
+        if(NULL == (table = (uint32_t *)H5MM_malloc(H5Z_LZ4_TABLE_SIZE)))
+            HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, 0, "memory allocation failed for lz4 compression")
+
+        /* Write the header */
+        op = outbuf;
+        H5Z_LZ4_ENCODE32(op, (uint32_t)((uint64_t)nbytes >> 32));
+        H5Z_LZ4_ENCODE32(op + 4, (uint32_t)nbytes);
+        H5Z_LZ4_ENCODE32(op + 8, (uint32_t)block_size);
+        op += H5Z_LZ4_HEADER_SIZE;
+
+        for(done_size = 0; done_size < nbytes; done_size += size, ip += size) {
+            size = MIN(block_size, nbytes - done_size);
+            comp_size = H5Z__lz4_compress_block(ip, size, op + 4, table, accel);
+
+            /* Store blocks that didn't get smaller as they are */
+            if(comp_size >= size) {
+                H5MM_memcpy(op + 4, ip, size);
+                comp_size = size;
+            } /* end if */
+            H5Z_LZ4_ENCODE32(op, (uint32_t)comp_size);
+            op += 4 + comp_size;
+        } /* end for */
+
+        H5MM_xfree(*buf);
+        *buf = outbuf;
+        *buf_size = out_size;
+        outbuf = NULL;
+        ret_value = (size_t)(op - (uint8_t *)(*buf));
+    } /* end else */
+
+done:
+    H5MM_xfree(outbuf);
+    H5MM_xfree(table);
+
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5Z__filter_lz4() */
+
+#endif /* H5_HAVE_FILTER_LZ4 */
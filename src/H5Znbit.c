@@ -69,8 +69,15 @@ static herr_t H5Z__nbit_decompress_one_array(unsigned char *data, size_t data_of
 static herr_t H5Z__nbit_decompress_one_compound(unsigned char *data, size_t data_offset,
     unsigned char *buffer, size_t *j, size_t *buf_len, const unsigned parms[],
     unsigned *parms_index);
+static H5_INLINE uint64_t H5Z__nbit_load(const unsigned char *src, unsigned size, unsigned order);
+static H5_INLINE void H5Z__nbit_store(unsigned char *dst, unsigned size, unsigned order, uint64_t val);
+static H5_INLINE size_t H5Z__nbit_pack(const unsigned char *data, unsigned d_nelmts,
+    unsigned char *buffer, unsigned size, const parms_atomic *p);
+static H5_INLINE void H5Z__nbit_unpack(unsigned char *data, unsigned d_nelmts,
+    const unsigned char *buffer, unsigned size, const parms_atomic *p);
+static hbool_t H5Z__nbit_fast_ok(const parms_atomic *p);
 static herr_t H5Z__nbit_decompress(unsigned char *data, unsigned d_nelmts, unsigned char *buffer,
-    const unsigned parms[]);
+    size_t buffer_size, const unsigned parms[]);
 static void H5Z_nbit_compress_one_nooptype(unsigned char *data, size_t data_offset,
     unsigned char *buffer, size_t *j, size_t *buf_len, unsigned size);
 static void H5Z_nbit_compress_one_atomic(unsigned char *data, size_t data_offset,
@@ -104,6 +111,7 @@ H5Z_class2_t H5Z_NBIT[1] = {{
 #define H5Z_NBIT_MAX_NPARMS      4096  /* Max number of parameters for filter */
 #define H5Z_NBIT_ORDER_LE        0     /* Little endian for datatype byte order */
 #define H5Z_NBIT_ORDER_BE        1     /* Big endian for datatype byte order */
+#define H5Z_NBIT_FAST_MAX_PREC   32    /* Widest precision handled by the word-at-a-time kernels */
 
 /* Local variables */
 
@@ -1009,7 +1017,7 @@ H5Z_filter_nbit(unsigned flags, size_t cd_nelmts, const unsigned cd_values[],
             HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, 0, "memory allocation failed for nbit decompression")
 
         /* decompress the buffer */
-        if(H5Z__nbit_decompress(outbuf, d_nelmts, (unsigned char *)*buf, cd_values) < 0)
+        if(H5Z__nbit_decompress(outbuf, d_nelmts, (unsigned char *)*buf, nbytes, cd_values) < 0)
             HGOTO_ERROR(H5E_PLINE, H5E_CANTFILTER, 0, "can't decompress buffer")
     } /* end if */
     /* output; compress */
@@ -1301,9 +1309,126 @@ done:
     FUNC_LEAVE_NOAPI(ret_value)
 }
 
+/* ======== Word-at-a-time kernels ======================================
+ * For a top-level atomic datatype the packed stream is simply each
+ * element's significant bits, most significant first, laid end to end.
+ * The kernels below produce that same stream through a 64-bit bit
+ * accumulator flushed 32 bits at a time, instead of walking the
+ * significant bytes of every element one at a time.
+ */
+
+static H5_INLINE uint64_t
+H5Z__nbit_load(const unsigned char *src, unsigned size, unsigned order)
+{
+    uint64_t val = 0;
+    unsigned u;
+
+    if(order == H5Z_NBIT_ORDER_LE)
+        for(u = size; u > 0; u--)
+            val = (val << 8) | src[u - 1];
+    else
+        for(u = 0; u < size; u++)
+            val = (val << 8) | src[u];
+
+    return val;
+}
+
+static H5_INLINE void
+H5Z__nbit_store(unsigned char *dst, unsigned size, unsigned order, uint64_t val)
+{
+    unsigned u;
+
+    if(order == H5Z_NBIT_ORDER_LE)
+        for(u = 0; u < size; u++, val >>= 8)
+            dst[u] = (unsigned char)val;
+    else
+        for(u = size; u > 0; u--, val >>= 8)
+            dst[u - 1] = (unsigned char)val;
+}
+
+static hbool_t
+H5Z__nbit_fast_ok(const parms_atomic *p)
+{
+    return (hbool_t)((p->size == 1 || p->size == 2 || p->size == 4 || p->size == 8)
+            && p->precision > 0 && p->precision <= H5Z_NBIT_FAST_MAX_PREC
+            && (p->precision + p->offset) <= p->size * 8);
+}
+
+/* Pack D_NELMTS elements of SIZE bytes; returns the number of whole
+ * bytes written, matching the byte index left by the generic packer */
+static H5_INLINE size_t
+H5Z__nbit_pack(const unsigned char *data, unsigned d_nelmts, unsigned char *buffer,
+    unsigned size, const parms_atomic *p)
+{
+    uint64_t mask = ((uint64_t)1 << p->precision) - 1;
+    uint64_t acc = 0;           /* bit accumulator, pending bits are the low NACC */
+    unsigned nacc = 0;          /* number of pending bits, always < 32 between elements */
+    size_t j = 0;
+    unsigned i;
+
+    for(i = 0; i < d_nelmts; i++, data += size) {
+        acc = (acc << p->precision) | ((H5Z__nbit_load(data, size, p->order) >> p->offset) & mask);
+        nacc += p->precision;
+        if(nacc >= 32) {
+            uint32_t word;
+
+            nacc -= 32;
+            word = (uint32_t)(acc >> nacc);
+            buffer[j]     = (unsigned char)(word >> 24);
+            buffer[j + 1] = (unsigned char)(word >> 16);
+            buffer[j + 2] = (unsigned char)(word >> 8);
+            buffer[j + 3] = (unsigned char)word;
+            j += 4;
+        } /* end if */
+    } /* end for */
+
+    /* Flush whole bytes, then the left-justified partial byte */
+    while(nacc >= 8) {
+        nacc -= 8;
+        buffer[j++] = (unsigned char)(acc >> nacc);
+    } /* end while */
+    if(nacc > 0)
+        buffer[j] = (unsigned char)(acc << (8 - nacc));
+
+    return j;
+}
+
+/* Unpack D_NELMTS elements of SIZE bytes; the caller has checked that
+ * BUFFER holds all d_nelmts * precision bits */
+static H5_INLINE void
+H5Z__nbit_unpack(unsigned char *data, unsigned d_nelmts, const unsigned char *buffer,
+    unsigned size, const parms_atomic *p)
+{
+    size_t nbits = (size_t)d_nelmts * p->precision;
+    size_t nwords = nbits / 32;                 /* complete 32-bit words in the stream */
+    uint64_t mask = ((uint64_t)1 << p->precision) - 1;
+    uint64_t acc = 0;           /* bit accumulator, unread bits are the low NACC */
+    unsigned nacc = 0;          /* number of unread bits, always < 64 */
+    size_t j = 0;
+    unsigned i;
+
+    for(i = 0; i < d_nelmts; i++, data += size) {
+        if(nacc < p->precision) {
+            if(j / 4 < nwords) {
+                acc = (acc << 32) | ((uint64_t)buffer[j] << 24) | ((uint64_t)buffer[j + 1] << 16)
+                        | ((uint64_t)buffer[j + 2] << 8) | (uint64_t)buffer[j + 3];
+                j += 4;
+                nacc += 32;
+            } /* end if */
+            else
+                while(nacc < p->precision) {
+                    acc = (acc << 8) | buffer[j++];
+                    nacc += 8;
+                } /* end while */
+        } /* end if */
+        nacc -= p->precision;
+        H5Z__nbit_store(data, size, p->order, ((acc >> nacc) & mask) << p->offset);
+    } /* end for */
+}
+
 static herr_t
 H5Z__nbit_decompress(unsigned char *data, unsigned d_nelmts, unsigned char *buffer,
-    const unsigned parms[])
+    size_t buffer_size, const unsigned parms[])
 {
     /* i: index of data, j: index of buffer,
        buf_len: number of bits to be filled in current byte */
@@ -1334,8 +1459,29 @@ H5Z__nbit_decompress(unsigned char *data, unsigned d_nelmts, unsigned char *buff
             if(p.precision > p.size * 8 || (p.precision + p.offset) > p.size * 8)
                HGOTO_ERROR(H5E_PLINE, H5E_BADTYPE, FAIL, "invalid datatype precision/offset")
 
-            for(i = 0; i < d_nelmts; i++)
-               H5Z_nbit_decompress_one_atomic(data, i * p.size, buffer, &j, &buf_len, &p);
+            if(H5Z__nbit_fast_ok(&p)) {
+                if(buffer_size < ((size_t)d_nelmts * p.precision + 7) / 8)
+                    HGOTO_ERROR(H5E_PLINE, H5E_CANTFILTER, FAIL, "nbit buffer too small")
+
+                /* Instantiate the kernel for each element size */
+                switch(p.size) {
+                    case 1:
+                        H5Z__nbit_unpack(data, d_nelmts, buffer, 1, &p);
+                        break;
+                    case 2:
+                        H5Z__nbit_unpack(data, d_nelmts, buffer, 2, &p);
+                        break;
+                    case 4:
+                        H5Z__nbit_unpack(data, d_nelmts, buffer, 4, &p);
+                        break;
+                    default:
+                        H5Z__nbit_unpack(data, d_nelmts, buffer, 8, &p);
+                        break;
+                } /* end switch */
+            } /* end if */
+            else
+                for(i = 0; i < d_nelmts; i++)
+                   H5Z_nbit_decompress_one_atomic(data, i * p.size, buffer, &j, &buf_len, &p);
             break;
 
        case H5Z_NBIT_ARRAY:
@@ -1598,8 +1744,24 @@ H5Z_nbit_compress(unsigned char *data, unsigned d_nelmts, unsigned char *buffer,
             p.precision = parms[6];
             p.offset = parms[7];
 
-            for(i = 0; i < d_nelmts; i++)
-                H5Z_nbit_compress_one_atomic(data, i * p.size, buffer, &new_size, &buf_len, &p);
+            if(H5Z__nbit_fast_ok(&p))
+                switch(p.size) {
+                    case 1:
+                        new_size = H5Z__nbit_pack(data, d_nelmts, buffer, 1, &p);
+                        break;
+                    case 2:
+                        new_size = H5Z__nbit_pack(data, d_nelmts, buffer, 2, &p);
+                        break;
+                    case 4:
+                        new_size = H5Z__nbit_pack(data, d_nelmts, buffer, 4, &p);
+                        break;
+                    default:
+                        new_size = H5Z__nbit_pack(data, d_nelmts, buffer, 8, &p);
+                        break;
+                } /* end switch */
+            else
+                for(i = 0; i < d_nelmts; i++)
+                    H5Z_nbit_compress_one_atomic(data, i * p.size, buffer, &new_size, &buf_len, &p);
             break;
 
        case H5Z_NBIT_ARRAY:
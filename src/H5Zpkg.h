@@ -21,6 +21,13 @@
 /* Include private header file */
 #include "H5Zprivate.h"          /* Filter functions                */
 
+/* Filter function which is also passed the size of the fully decoded data
+ * when decoding, and the allocator for its buffers, if any (see
+ * H5Z_pipeline_mem()) */
+typedef size_t (*H5Z_func_sized_t)(unsigned flags, size_t cd_nelmts,
+    const unsigned cd_values[], size_t nbytes, size_t decoded_nbytes,
+    const H5Z_mem_t *mem, size_t *buf_size, void **buf);
+
 /********************/
 /* Internal filters */
 /********************/
@@ -28,6 +35,10 @@
 /* Shuffle filter */
 H5_DLLVAR const H5Z_class2_t H5Z_SHUFFLE[1];
 
+/* Bitshuffle filter */
+H5_DLLVAR const H5Z_class2_t H5Z_BITSHUFFLE[1];
+H5_DLL hbool_t H5Z__bitshuffle_thread_safe(size_t cd_nelmts, const unsigned cd_values[]);
+
 /* Fletcher32 filter */
 H5_DLLVAR const H5Z_class2_t H5Z_FLETCHER32[1];
 
@@ -44,6 +55,9 @@ H5_DLLVAR H5Z_class2_t H5Z_SCALEOFFSET[1];
 /* Deflate filter */
 #ifdef H5_HAVE_FILTER_DEFLATE
 H5_DLLVAR const H5Z_class2_t H5Z_DEFLATE[1];
+H5_DLL size_t H5Z__filter_deflate_sized(unsigned flags, size_t cd_nelmts,
+    const unsigned cd_values[], size_t nbytes, size_t decoded_nbytes,
+    const H5Z_mem_t *mem, size_t *buf_size, void **buf);
 #endif /* H5_HAVE_FILTER_DEFLATE */
 
 /* szip filter */
@@ -51,8 +65,40 @@ H5_DLLVAR const H5Z_class2_t H5Z_DEFLATE[1];
 H5_DLLVAR H5Z_class2_t H5Z_SZIP[1];
 #endif /* H5_HAVE_FILTER_SZIP */
 
+/* lz4 filter */
+#ifdef H5_HAVE_FILTER_LZ4
+H5_DLLVAR const H5Z_class2_t H5Z_LZ4[1];
+
+/* Log2 of the number of entries of the lz4 compressor's hash table, and the
+ * size of the table */
+#define H5Z_LZ4_HASH_LOG        12
+#define H5Z_LZ4_TABLE_SIZE      (sizeof(uint32_t) << H5Z_LZ4_HASH_LOG)
+
+/* Largest lz4 block, and the largest size it can compress to from N bytes */
+#define H5Z_LZ4_MAX_BLOCK       0x7E000000U
+#define H5Z_LZ4_COMPRESS_BOUND(n)   ((n) + ((n) / 255) + 16)
+
+/* Encode/decode the big-endian sizes that frame lz4 blocks */
+#define H5Z_LZ4_ENCODE32(p, n) {                                            \
+    (p)[0] = (uint8_t)((n) >> 24); (p)[1] = (uint8_t)((n) >> 16);           \
+    (p)[2] = (uint8_t)((n) >> 8); (p)[3] = (uint8_t)(n);                    \
+}
+#define H5Z_LZ4_DECODE32(p)                                                 \
+    (((uint32_t)(p)[0] << 24) | ((uint32_t)(p)[1] << 16) |                  \
+     ((uint32_t)(p)[2] << 8) | (uint32_t)(p)[3])
+
+H5_DLL size_t H5Z__lz4_compress_block(const uint8_t *src, size_t src_size,
+    uint8_t *dst, uint32_t *table, unsigned accel);
+H5_DLL herr_t H5Z__lz4_decompress_block(const uint8_t *src, size_t src_size,
+    uint8_t *dst, size_t dst_size);
+#endif /* H5_HAVE_FILTER_LZ4 */
+
 /* Package internal routines */
 H5_DLL herr_t H5Z__unregister(H5Z_filter_t filter_id);
+H5_DLL void H5Z__shuffle_bytes(void *dest, const void *src, unsigned bytesoftype,
+    size_t numofelements, hbool_t reverse);
+H5_DLL void *H5Z__mem_alloc(const H5Z_mem_t *mem, size_t size, size_t *alloc);
+H5_DLL void *H5Z__mem_free(const H5Z_mem_t *mem, void *buf, size_t alloc);
 
 #endif /* _H5Zpkg_H */
 
@@ -51,6 +51,17 @@ typedef struct H5Z_filter_info_t H5Z_filter_info_t;
 /* Library Private Typedefs */
 /****************************/
 
+/* Allocator for the buffers passed between filters (see H5Z_pipeline_mem()).
+ * ALLOC_FUNC returns a buffer of at least SIZE bytes and its actual size
+ * through ALLOC; FREE_FUNC takes back a buffer of ALLOC bytes (or 0 if it
+ * isn't known).  The buffers must be compatible with H5MM_realloc() and
+ * H5MM_xfree(), as filters without a sized function use those on them. */
+typedef struct H5Z_mem_t {
+    void *(*alloc_func)(size_t size, size_t *alloc, void *info);
+    void (*free_func)(void *buf, size_t alloc, void *info);
+    void *info;                 /* Information for the callbacks */
+} H5Z_mem_t;
+
 /* Structure to store information about each filter's parameters */
 struct H5Z_filter_info_t {
     H5Z_filter_t	id;		/*filter identification number	     */
@@ -82,7 +93,13 @@ H5_DLL herr_t H5Z_modify(const struct H5O_pline_t *pline, H5Z_filter_t filter,
 H5_DLL herr_t H5Z_pipeline(const struct H5O_pline_t *pline,
 			    unsigned flags, unsigned *filter_mask/*in,out*/,
  			    H5Z_EDC_t edc_read, H5Z_cb_t cb_struct,
-			    size_t *nbytes/*in,out*/, size_t *buf_size/*in,out*/,
+			    size_t decoded_nbytes, size_t *nbytes/*in,out*/,
+                            size_t *buf_size/*in,out*/, void **buf/*in,out*/);
+H5_DLL herr_t H5Z_pipeline_mem(const struct H5O_pline_t *pline,
+			    unsigned flags, unsigned *filter_mask/*in,out*/,
+ 			    H5Z_EDC_t edc_read, H5Z_cb_t cb_struct,
+			    size_t decoded_nbytes, const H5Z_mem_t *mem,
+                            size_t *nbytes/*in,out*/, size_t *buf_size/*in,out*/,
                             void **buf/*in,out*/);
 H5_DLL H5Z_class2_t *H5Z_find(H5Z_filter_t id);
 H5_DLL herr_t H5Z_can_apply(hid_t dcpl_id, hid_t type_id);
@@ -93,6 +110,7 @@ H5_DLL H5Z_filter_info_t *H5Z_filter_info(const struct H5O_pline_t *pline,
         H5Z_filter_t filter);
 H5_DLL htri_t H5Z_filter_in_pline(const struct H5O_pline_t *pline, H5Z_filter_t filter);
 H5_DLL htri_t H5Z_all_filters_avail(const struct H5O_pline_t *pline);
+H5_DLL htri_t H5Z_pipeline_thread_safe(const struct H5O_pline_t *pline);
 H5_DLL htri_t H5Z_filter_avail(H5Z_filter_t id);
 H5_DLL herr_t H5Z_delete(struct H5O_pline_t *pline, H5Z_filter_t filter);
 H5_DLL herr_t H5Z_get_filter_info(H5Z_filter_t filter, unsigned int *filter_config_flags);
@@ -40,6 +40,10 @@ typedef int H5Z_filter_t;
 #define H5Z_FILTER_NBIT         5       /*nbit compression              */
 #define H5Z_FILTER_SCALEOFFSET  6       /*scale+offset compression      */
 #define H5Z_FILTER_RESERVED     256	/*filter ids below this value are reserved for library use */
+#define H5Z_FILTER_LZ4          32004   /*lz4 compression (id registered
+                                         *  to the lz4 plugin)          */
+#define H5Z_FILTER_BITSHUFFLE   32008   /*bitshuffle the data (id registered
+                                         *  to the bitshuffle project)  */
 
 #define H5Z_FILTER_MAX		65535	/*maximum filter id		*/
 
@@ -77,6 +81,18 @@ typedef int H5Z_filter_t;
 #define H5Z_SHUFFLE_USER_NPARMS    0    /* Number of parameters that users can set */
 #define H5Z_SHUFFLE_TOTAL_NPARMS   1    /* Total number of parameters for filter */
 
+/* Macros for the bitshuffle filter */
+#define H5Z_BITSHUFFLE_USER_NPARMS  4   /* Number of parameters that users can set */
+#define H5Z_BITSHUFFLE_TOTAL_NPARMS 5   /* Total number of parameters for filter */
+#define H5Z_BITSHUFFLE_COMPRESS_NONE 0  /* Values of the compression parameter, */
+#define H5Z_BITSHUFFLE_COMPRESS_LZ4  2  /*  the filter's fifth one, as used by */
+#define H5Z_BITSHUFFLE_COMPRESS_ZSTD 3  /*  the bitshuffle plugin */
+
+/* Macros for the lz4 filter */
+#define H5Z_LZ4_USER_NPARMS         2   /* Number of parameters that users can set */
+#define H5Z_LZ4_TOTAL_NPARMS        2   /* Total number of parameters for filter */
+#define H5Z_LZ4_MAX_ACCELERATION    64  /* Largest acceleration */
+
 /* Macros for the szip filter */
 #define H5Z_SZIP_USER_NPARMS    2       /* Number of parameters that users can set */
 #define H5Z_SZIP_TOTAL_NPARMS   4       /* Total number of parameters for filter */
@@ -24,6 +24,14 @@
 #include "H5Tprivate.h"        /* Datatypes                     */
 #include "H5Zpkg.h"        /* Data filters                */
 
+/* Find the minimum and maximum of floating-point chunks with SSE2 vectors
+ * on x86-64.  Define H5Z_SCALEOFFSET_NO_SIMD to use only the portable
+ * loops. */
+#if defined(__x86_64__) && defined(__GNUC__) && !defined(H5Z_SCALEOFFSET_NO_SIMD)
+#define H5Z_SCALEOFFSET_SIMD
+#include <emmintrin.h>
+#endif /* __x86_64__ */
+
 /* Struct of parameters needed for compressing/decompressing one atomic datatype */
 typedef struct {
    unsigned size;      /* datatype size */
@@ -70,6 +78,14 @@ static void H5Z_scaleoffset_decompress_one_atomic(unsigned char *data, size_t da
     unsigned char *buffer, size_t *j, unsigned *buf_len, parms_atomic p);
 static void H5Z_scaleoffset_compress_one_atomic(unsigned char *data, size_t data_offset,
     unsigned char *buffer, size_t *j, unsigned *buf_len, parms_atomic p);
+static void H5Z__scaleoffset_max_min_float(const float *buf, unsigned d_nelmts,
+    float *max, float *min);
+static void H5Z__scaleoffset_max_min_double(const double *buf, unsigned d_nelmts,
+    double *max, double *min);
+static H5_INLINE void H5Z__scaleoffset_pack(const void *data, unsigned d_nelmts,
+    unsigned char *buffer, unsigned size, unsigned minbits);
+static H5_INLINE void H5Z__scaleoffset_unpack(void *data, unsigned d_nelmts,
+    const unsigned char *buffer, unsigned size, unsigned minbits);
 static void H5Z_scaleoffset_decompress(unsigned char *data, unsigned d_nelmts,
     unsigned char *buffer, parms_atomic p);
 static void H5Z_scaleoffset_compress(unsigned char *data, unsigned d_nelmts, unsigned char *buffer,
@@ -317,58 +333,161 @@ H5Z_class2_t H5Z_SCALEOFFSET[1] = {{
       HGOTO_ERROR(H5E_PLINE, H5E_BADTYPE, FAIL, "cannot find matched integer dataype") \
 }
 
+/* Number of independent accumulators kept by the min/max scans below.
+ * Each step over a block of lanes has no dependence between lanes, so
+ * for integer types the compiler turns it into vector compares and
+ * blends; the lanes are reduced once at the end.  Minimum and maximum
+ * are order-independent, so the results match a single sequential scan.
+ */
+#define H5Z_SCALEOFFSET_NLANES 8
+
 /* Find maximum and minimum values of a buffer with fill value defined for integer type */
-#define H5Z_scaleoffset_max_min_1(i, d_nelmts, buf, filval, max, min)\
-{                                                                  \
-   i = 0; while(i < d_nelmts && buf[i]== filval) i++;              \
-   if(i < d_nelmts) min = max = buf[i];                            \
-   for(; i < d_nelmts; i++) {                                      \
-      if(buf[i] == filval) continue; /* ignore fill value */       \
-      if(buf[i] > max) max = buf[i];                               \
-      if(buf[i] < min) min = buf[i];                               \
-   }                                                               \
+#define H5Z_scaleoffset_max_min_1(i, type, d_nelmts, buf, filval, max, min)        \
+{                                                                                  \
+   i = 0; while(i < d_nelmts && buf[i]== filval) i++;                              \
+   if(i < d_nelmts) min = max = buf[i];                                            \
+   if(i + H5Z_SCALEOFFSET_NLANES <= d_nelmts) {                                    \
+      type _mn[H5Z_SCALEOFFSET_NLANES], _mx[H5Z_SCALEOFFSET_NLANES];               \
+      unsigned _l;                                                                 \
+                                                                                   \
+      for(_l = 0; _l < H5Z_SCALEOFFSET_NLANES; _l++)                               \
+         _mn[_l] = _mx[_l] = min;                                                  \
+      for(; i + H5Z_SCALEOFFSET_NLANES <= d_nelmts; i += H5Z_SCALEOFFSET_NLANES)   \
+         for(_l = 0; _l < H5Z_SCALEOFFSET_NLANES; _l++) {                          \
+            type _v = buf[i + _l];                                                 \
+            _mx[_l] = (_v != filval && _v > _mx[_l]) ? _v : _mx[_l];               \
+            _mn[_l] = (_v != filval && _v < _mn[_l]) ? _v : _mn[_l];               \
+         }                                                                         \
+      for(_l = 0; _l < H5Z_SCALEOFFSET_NLANES; _l++) {                             \
+         if(_mx[_l] > max) max = _mx[_l];                                          \
+         if(_mn[_l] < min) min = _mn[_l];                                          \
+      }                                                                            \
+   }                                                                               \
+   for(; i < d_nelmts; i++) {                                                      \
+      if(buf[i] == filval) continue; /* ignore fill value */                       \
+      if(buf[i] > max) max = buf[i];                                               \
+      if(buf[i] < min) min = buf[i];                                               \
+   }                                                                               \
 }
 
 /* Find maximum and minimum values of a buffer with fill value undefined */
-#define H5Z_scaleoffset_max_min_2(i, d_nelmts, buf, max, min)\
-{                                                            \
-   min = max = buf[0];                                       \
-   for(i = 0; i < d_nelmts; i++) {                           \
-      if(buf[i] > max) max = buf[i];                         \
-      if(buf[i] < min) min = buf[i];                         \
-   }                                                         \
+#define H5Z_scaleoffset_max_min_2(i, type, d_nelmts, buf, max, min)                \
+{                                                                                  \
+   min = max = buf[0];                                                             \
+   i = 0;                                                                          \
+   if(d_nelmts >= H5Z_SCALEOFFSET_NLANES) {                                        \
+      type _mn[H5Z_SCALEOFFSET_NLANES], _mx[H5Z_SCALEOFFSET_NLANES];               \
+      unsigned _l;                                                                 \
+                                                                                   \
+      for(_l = 0; _l < H5Z_SCALEOFFSET_NLANES; _l++)                               \
+         _mn[_l] = _mx[_l] = min;                                                  \
+      for(; i + H5Z_SCALEOFFSET_NLANES <= d_nelmts; i += H5Z_SCALEOFFSET_NLANES)   \
+         for(_l = 0; _l < H5Z_SCALEOFFSET_NLANES; _l++) {                          \
+            type _v = buf[i + _l];                                                 \
+            _mx[_l] = _v > _mx[_l] ? _v : _mx[_l];                                 \
+            _mn[_l] = _v < _mn[_l] ? _v : _mn[_l];                                 \
+         }                                                                         \
+      for(_l = 0; _l < H5Z_SCALEOFFSET_NLANES; _l++) {                             \
+         if(_mx[_l] > max) max = _mx[_l];                                          \
+         if(_mn[_l] < min) min = _mn[_l];                                          \
+      }                                                                            \
+   }                                                                               \
+   for(; i < d_nelmts; i++) {                                                      \
+      if(buf[i] > max) max = buf[i];                                               \
+      if(buf[i] < min) min = buf[i];                                               \
+   }                                                                               \
 }
 
 /* Find maximum and minimum values of a buffer with fill value defined for floating-point type */
-#define H5Z_scaleoffset_max_min_3(i, d_nelmts, buf, filval, max, min, D_val)      \
-{                                                                                 \
-   i = 0; while(i < d_nelmts && HDfabs(buf[i] - filval) < HDpow(10.0f, -D_val)) i++; \
-   if(i < d_nelmts) min = max = buf[i];                                           \
-   for(; i < d_nelmts; i++) {                                                     \
-      if(HDfabs(buf[i] - filval) < HDpow(10.0f, -D_val))                          \
-         continue; /* ignore fill value */                                        \
-      if(buf[i] > max) max = buf[i];                                              \
-      if(buf[i] < min) min = buf[i];                                              \
-   }                                                                              \
+#define H5Z_scaleoffset_max_min_3(i, type, d_nelmts, buf, filval, max, min, D_val) \
+{                                                                                  \
+   double _eps = HDpow(10.0f, -D_val); /* values closer than this to the fill value are fill */\
+                                                                                   \
+   i = 0; while(i < d_nelmts && HDfabs(buf[i] - filval) < _eps) i++;               \
+   if(i < d_nelmts) min = max = buf[i];                                            \
+   if(i + H5Z_SCALEOFFSET_NLANES <= d_nelmts) {                                    \
+      type _mn[H5Z_SCALEOFFSET_NLANES], _mx[H5Z_SCALEOFFSET_NLANES];               \
+      unsigned _l;                                                                 \
+                                                                                   \
+      for(_l = 0; _l < H5Z_SCALEOFFSET_NLANES; _l++)                               \
+         _mn[_l] = _mx[_l] = min;                                                  \
+      for(; i + H5Z_SCALEOFFSET_NLANES <= d_nelmts; i += H5Z_SCALEOFFSET_NLANES)   \
+         for(_l = 0; _l < H5Z_SCALEOFFSET_NLANES; _l++) {                          \
+            type _v = buf[i + _l];                                                 \
+            int _keep = !(HDfabs(_v - filval) < _eps);                             \
+            _mx[_l] = (_keep && _v > _mx[_l]) ? _v : _mx[_l];                      \
+            _mn[_l] = (_keep && _v < _mn[_l]) ? _v : _mn[_l];                      \
+         }                                                                         \
+      for(_l = 0; _l < H5Z_SCALEOFFSET_NLANES; _l++) {                             \
+         if(_mx[_l] > max) max = _mx[_l];                                          \
+         if(_mn[_l] < min) min = _mn[_l];                                          \
+      }                                                                            \
+   }                                                                               \
+   for(; i < d_nelmts; i++) {                                                      \
+      if(HDfabs(buf[i] - filval) < _eps)                                           \
+         continue; /* ignore fill value */                                         \
+      if(buf[i] > max) max = buf[i];                                               \
+      if(buf[i] < min) min = buf[i];                                               \
+   }                                                                               \
 }
 
 /* Find minimum value of a buffer with fill value defined for integer type */
-#define H5Z_scaleoffset_min_1(i, d_nelmts, buf, filval, min) \
-{                                                            \
-   i = 0; while(i < d_nelmts && buf[i]== filval) i++;        \
-   if(i < d_nelmts) min = buf[i];                            \
-   for(; i < d_nelmts; i++) {                                \
-      if(buf[i] == filval) continue; /* ignore fill value */ \
-      if(buf[i] < min) min = buf[i];                         \
-   }                                                         \
+#define H5Z_scaleoffset_min_1(i, type, d_nelmts, buf, filval, min)                 \
+{                                                                                  \
+   i = 0; while(i < d_nelmts && buf[i]== filval) i++;                              \
+   if(i < d_nelmts) min = buf[i];                                                  \
+   if(i + H5Z_SCALEOFFSET_NLANES <= d_nelmts) {                                    \
+      type _mn[H5Z_SCALEOFFSET_NLANES];                                            \
+      unsigned _l;                                                                 \
+                                                                                   \
+      for(_l = 0; _l < H5Z_SCALEOFFSET_NLANES; _l++)                               \
+         _mn[_l] = min;                                                            \
+      for(; i + H5Z_SCALEOFFSET_NLANES <= d_nelmts; i += H5Z_SCALEOFFSET_NLANES)   \
+         for(_l = 0; _l < H5Z_SCALEOFFSET_NLANES; _l++) {                          \
+            type _v = buf[i + _l];                                                 \
+            _mn[_l] = (_v != filval && _v < _mn[_l]) ? _v : _mn[_l];               \
+         }                                                                         \
+      for(_l = 0; _l < H5Z_SCALEOFFSET_NLANES; _l++)                               \
+         if(_mn[_l] < min) min = _mn[_l];                                          \
+   }                                                                               \
+   for(; i < d_nelmts; i++) {                                                      \
+      if(buf[i] == filval) continue; /* ignore fill value */                       \
+      if(buf[i] < min) min = buf[i];                                               \
+   }                                                                               \
 }
 
 /* Find minimum value of a buffer with fill value undefined */
-#define H5Z_scaleoffset_min_2(i, d_nelmts, buf, min)\
-{                                                   \
-   min = buf[0];                                    \
-   for(i = 0; i < d_nelmts; i++)                    \
-      if(buf[i] < min) min = buf[i];                \
+#define H5Z_scaleoffset_min_2(i, type, d_nelmts, buf, min)                         \
+{                                                                                  \
+   min = buf[0];                                                                   \
+   i = 0;                                                                          \
+   if(d_nelmts >= H5Z_SCALEOFFSET_NLANES) {                                        \
+      type _mn[H5Z_SCALEOFFSET_NLANES];                                            \
+      unsigned _l;                                                                 \
+                                                                                   \
+      for(_l = 0; _l < H5Z_SCALEOFFSET_NLANES; _l++)                               \
+         _mn[_l] = min;                                                            \
+      for(; i + H5Z_SCALEOFFSET_NLANES <= d_nelmts; i += H5Z_SCALEOFFSET_NLANES)   \
+         for(_l = 0; _l < H5Z_SCALEOFFSET_NLANES; _l++)                            \
+            _mn[_l] = buf[i + _l] < _mn[_l] ? buf[i + _l] : _mn[_l];               \
+      for(_l = 0; _l < H5Z_SCALEOFFSET_NLANES; _l++)                               \
+         if(_mn[_l] < min) min = _mn[_l];                                          \
+   }                                                                               \
+   for(; i < d_nelmts; i++)                                                        \
+      if(buf[i] < min) min = buf[i];                                               \
+}
+
+/* A sequential scan keeps the first of several minimum values that
+ * compare equal, which for floating-point data can be -0.0 or 0.0; the
+ * minimum is stored in the output, so pick that same one */
+#define H5Z_scaleoffset_first_zero_min(i, d_nelmts, buf, min, is_fill)             \
+{                                                                                  \
+   if(min == 0)                                                                    \
+      for(i = 0; i < d_nelmts; i++)                                                \
+         if(buf[i] == 0 && !(is_fill)) {                                           \
+            min = buf[i];                                                          \
+            break;                                                                 \
+         }                                                                         \
 }
 
 /* Check and handle special situation for unsigned integer type */
@@ -419,23 +538,23 @@ H5Z_class2_t H5Z_SCALEOFFSET[1] = {{
     if(filavail == H5Z_SCALEOFFSET_FILL_DEFINED) { /* fill value defined */                \
         H5Z_scaleoffset_get_filval_1(type, cd_values, filval)                              \
         if(*minbits == H5Z_SO_INT_MINBITS_DEFAULT) { /* minbits not set yet, calculate max, min, and minbits */ \
-            H5Z_scaleoffset_max_min_1(i, d_nelmts, buf, filval, max, min)                  \
+            H5Z_scaleoffset_max_min_1(i, type, d_nelmts, buf, filval, max, min)            \
             H5Z_scaleoffset_check_1(type, max, min, minbits)                               \
             span = (type)(max - min + 1);                                                  \
             *minbits = H5Z_scaleoffset_log2((unsigned long long)(span+1));                 \
         } else /* minbits already set, only calculate min */                               \
-            H5Z_scaleoffset_min_1(i, d_nelmts, buf, filval, min)                           \
+            H5Z_scaleoffset_min_1(i, type, d_nelmts, buf, filval, min)                     \
         if(*minbits != sizeof(type)*8) /* change values if minbits != full precision */    \
             for(i = 0; i < d_nelmts; i++)                                                  \
                 buf[i] = (type)((buf[i] == filval) ? (((type)1 << *minbits) - 1) : (buf[i] - min)); \
     } else { /* fill value undefined */                                                    \
         if(*minbits == H5Z_SO_INT_MINBITS_DEFAULT ) { /* minbits not set yet, calculate max, min, and minbits */ \
-            H5Z_scaleoffset_max_min_2(i, d_nelmts, buf, max, min)                          \
+            H5Z_scaleoffset_max_min_2(i, type, d_nelmts, buf, max, min)                    \
             H5Z_scaleoffset_check_1(type, max, min, minbits)                               \
             span = (type)(max - min + 1);                                                  \
             *minbits = H5Z_scaleoffset_log2((unsigned long long)span);                     \
         } else /* minbits already set, only calculate min */                               \
-            H5Z_scaleoffset_min_2(i, d_nelmts, buf, min)                                   \
+            H5Z_scaleoffset_min_2(i, type, d_nelmts, buf, min)                             \
         if(*minbits != sizeof(type)*8) /* change values if minbits != full precision */    \
             for(i = 0; i < d_nelmts; i++)                                                  \
                 buf[i] = (type)(buf[i] - min);                                             \
@@ -452,23 +571,23 @@ H5Z_class2_t H5Z_SCALEOFFSET[1] = {{
    if(filavail == H5Z_SCALEOFFSET_FILL_DEFINED) { /* fill value defined */                   \
       H5Z_scaleoffset_get_filval_1(type, cd_values, filval)                                  \
       if(*minbits == H5Z_SO_INT_MINBITS_DEFAULT) { /* minbits not set yet, calculate max, min, and minbits */ \
-         H5Z_scaleoffset_max_min_1(i, d_nelmts, buf, filval, max, min)                       \
+         H5Z_scaleoffset_max_min_1(i, type, d_nelmts, buf, filval, max, min)                 \
          H5Z_scaleoffset_check_2(type, max, min, minbits)                                    \
          span = (unsigned type)(max - min + 1);                                              \
          *minbits = H5Z_scaleoffset_log2((unsigned long long)(span + 1));                    \
       } else /* minbits already set, only calculate min */                                   \
-         H5Z_scaleoffset_min_1(i, d_nelmts, buf, filval, min)                                \
+         H5Z_scaleoffset_min_1(i, type, d_nelmts, buf, filval, min)                          \
       if(*minbits != sizeof(type) * 8) /* change values if minbits != full precision */      \
          for(i = 0; i < d_nelmts; i++)                                                       \
             buf[i] = (type)((buf[i] == filval) ? (type)(((unsigned type)1 << *minbits) - 1) : (buf[i] - min)); \
    } else { /* fill value undefined */                                                       \
       if(*minbits == H5Z_SO_INT_MINBITS_DEFAULT ) { /* minbits not set yet, calculate max, min, and minbits */\
-         H5Z_scaleoffset_max_min_2(i, d_nelmts, buf, max, min)                               \
+         H5Z_scaleoffset_max_min_2(i, type, d_nelmts, buf, max, min)                         \
          H5Z_scaleoffset_check_2(type, max, min, minbits)                                    \
          span = (unsigned type)(max - min + 1);                                              \
          *minbits = H5Z_scaleoffset_log2((unsigned long long)span);                          \
       } else /* minbits already set, only calculate min */                                   \
-         H5Z_scaleoffset_min_2(i, d_nelmts, buf, min)                                        \
+         H5Z_scaleoffset_min_2(i, type, d_nelmts, buf, min)                                  \
       if(*minbits != sizeof(type) * 8) /* change values if minbits != full precision */      \
          for(i = 0; i < d_nelmts; i++)                                                       \
             buf[i] = (type)(buf[i] - min);                                                   \
@@ -477,47 +596,54 @@ H5Z_class2_t H5Z_SCALEOFFSET[1] = {{
 }
 
 /* Modify values of data in precompression if fill value defined for floating-point type */
-#define H5Z_scaleoffset_modify_1(i, type, pow_fun, abs_fun, lround_fun, llround_fun, buf, d_nelmts, filval, minbits, min, D_val) \
-{                                                                                     \
-   if(sizeof(type) == sizeof(int))                                                    \
-      for(i = 0; i < d_nelmts; i++) {                                                 \
-         if(abs_fun(buf[i] - filval) < pow_fun(10.0f, (type)-D_val))                  \
-            *(int *)((void *)&buf[i]) = (int)(((unsigned int)1 << *minbits) - 1);               \
-         else                                                                         \
-            *(int *)((void *)&buf[i]) = (int)lround_fun(buf[i] * pow_fun(10.0f, (type)D_val) - min * pow_fun(10.0f, (type)D_val));  \
-      }                                                                               \
-   else if(sizeof(type) == sizeof(long))                                              \
-      for(i = 0; i < d_nelmts; i++) {                                                 \
-         if(abs_fun(buf[i] - filval) < pow_fun(10.0f, (type)-D_val))                  \
-            *(long *)((void *)&buf[i]) = (long)(((unsigned long)1 << *minbits) - 1);            \
-         else                                                                         \
-            *(long *)((void *)&buf[i]) = lround_fun(buf[i] * pow_fun(10.0f, (type)D_val) - min * pow_fun(10.0f, (type)D_val)); \
-      }                                                                               \
-   else if(sizeof(type) == sizeof(long long))                                         \
-      for(i = 0; i < d_nelmts; i++) {                                                 \
-         if(abs_fun(buf[i] - filval) < pow_fun(10.0f, (type)-D_val))                  \
-            *(long long *)((void *)&buf[i]) = (long long)(((unsigned long long)1 << *minbits) - 1); \
-         else                                                                         \
-            *(long long *)((void *)&buf[i]) = llround_fun(buf[i] * pow_fun(10.0f, (type)D_val) - min * pow_fun(10.0f, (type)D_val)); \
-      }                                                                               \
-   else                                                                               \
-      HGOTO_ERROR(H5E_PLINE, H5E_BADTYPE, FAIL, "cannot find matched integer dataype") \
+#define H5Z_scaleoffset_modify_1(i, type, pow_fun, abs_fun, lround_fun, llround_fun, buf, d_nelmts, filval, minbits, min, D_val)\
+{                                                                                  \
+   type _scale = pow_fun(10.0f, (type)D_val);      /* decimal scale */             \
+   type _eps = pow_fun(10.0f, (type)-D_val);       /* values closer than this to the fill value are fill */\
+   type _min_scaled = min * _scale;                                                \
+                                                                                   \
+   if(sizeof(type) == sizeof(int))                                                 \
+      for(i = 0; i < d_nelmts; i++) {                                              \
+         if(abs_fun(buf[i] - filval) < _eps)                                       \
+            *(int *)((void *)&buf[i]) = (int)(((unsigned int)1 << *minbits) - 1);  \
+         else                                                                      \
+            *(int *)((void *)&buf[i]) = (int)lround_fun(buf[i] * _scale - _min_scaled);\
+      }                                                                            \
+   else if(sizeof(type) == sizeof(long))                                           \
+      for(i = 0; i < d_nelmts; i++) {                                              \
+         if(abs_fun(buf[i] - filval) < _eps)                                       \
+            *(long *)((void *)&buf[i]) = (long)(((unsigned long)1 << *minbits) - 1);\
+         else                                                                      \
+            *(long *)((void *)&buf[i]) = lround_fun(buf[i] * _scale - _min_scaled);\
+      }                                                                            \
+   else if(sizeof(type) == sizeof(long long))                                      \
+      for(i = 0; i < d_nelmts; i++) {                                              \
+         if(abs_fun(buf[i] - filval) < _eps)                                       \
+            *(long long *)((void *)&buf[i]) = (long long)(((unsigned long long)1 << *minbits) - 1);\
+         else                                                                      \
+            *(long long *)((void *)&buf[i]) = llround_fun(buf[i] * _scale - _min_scaled);\
+      }                                                                            \
+   else                                                                            \
+      HGOTO_ERROR(H5E_PLINE, H5E_BADTYPE, FAIL, "cannot find matched integer dataype")\
 }
 
 /* Modify values of data in precompression if fill value undefined for floating-point type */
-#define H5Z_scaleoffset_modify_2(i, type, pow_fun, lround_fun, llround_fun, buf, d_nelmts, min, D_val)         \
-{                                                                                     \
-   if(sizeof(type) == sizeof(int))                                                    \
-      for(i = 0; i < d_nelmts; i++)                                                   \
-         *(int *)((void *)&buf[i]) = (int)lround_fun(buf[i] * pow_fun(10.0f, (type)D_val) - min * pow_fun(10.0f, (type)D_val));     \
-   else if(sizeof(type) == sizeof(long))                                              \
-      for(i = 0; i < d_nelmts; i++)                                                   \
-         *(long *)((void *)&buf[i]) = lround_fun(buf[i] * pow_fun(10.0f, (type)D_val) - min * pow_fun(10.0f, (type)D_val));    \
-   else if(sizeof(type) == sizeof(long long))                                         \
-      for(i = 0; i < d_nelmts; i++)                                                   \
-         *(long long *)((void *)&buf[i]) = llround_fun(buf[i] * pow_fun(10.0f, (type)D_val) - min * pow_fun(10.0f, (type)D_val)); \
-   else                                                                               \
-      HGOTO_ERROR(H5E_PLINE, H5E_BADTYPE, FAIL, "cannot find matched integer dataype") \
+#define H5Z_scaleoffset_modify_2(i, type, pow_fun, lround_fun, llround_fun, buf, d_nelmts, min, D_val)\
+{                                                                                  \
+   type _scale = pow_fun(10.0f, (type)D_val);      /* decimal scale */             \
+   type _min_scaled = min * _scale;                                                \
+                                                                                   \
+   if(sizeof(type) == sizeof(int))                                                 \
+      for(i = 0; i < d_nelmts; i++)                                                \
+         *(int *)((void *)&buf[i]) = (int)lround_fun(buf[i] * _scale - _min_scaled);\
+   else if(sizeof(type) == sizeof(long))                                           \
+      for(i = 0; i < d_nelmts; i++)                                                \
+         *(long *)((void *)&buf[i]) = lround_fun(buf[i] * _scale - _min_scaled);   \
+   else if(sizeof(type) == sizeof(long long))                                      \
+      for(i = 0; i < d_nelmts; i++)                                                \
+         *(long long *)((void *)&buf[i]) = llround_fun(buf[i] * _scale - _min_scaled);\
+   else                                                                            \
+      HGOTO_ERROR(H5E_PLINE, H5E_BADTYPE, FAIL, "cannot find matched integer dataype")\
 }
 
 /* Save the minimum value for floating-point type */
@@ -540,7 +666,7 @@ H5Z_class2_t H5Z_SCALEOFFSET[1] = {{
 }
 
 /* Precompress for floating-point type using variable-minimum-bits method */
-#define H5Z_scaleoffset_precompress_3(type, pow_fun, abs_fun, round_fun, lround_fun, llround_fun, data, d_nelmts, filavail, cd_values,         \
+#define H5Z_scaleoffset_precompress_3(type, pow_fun, abs_fun, round_fun, lround_fun, llround_fun, max_min_fun, data, d_nelmts, filavail, cd_values, \
                                       minbits, minval, D_val)                            \
 {                                                                                        \
    type *buf = (type *)data, min = 0, max = 0, filval = 0;                               \
@@ -550,14 +676,17 @@ H5Z_class2_t H5Z_SCALEOFFSET[1] = {{
    *minval = 0;                                                                          \
    if(filavail == H5Z_SCALEOFFSET_FILL_DEFINED) { /* fill value defined */               \
       H5Z_scaleoffset_get_filval_2(type, cd_values, filval)                              \
-      H5Z_scaleoffset_max_min_3(i, d_nelmts, buf, filval, max, min, D_val)               \
+      H5Z_scaleoffset_max_min_3(i, type, d_nelmts, buf, filval, max, min, D_val)         \
+      H5Z_scaleoffset_first_zero_min(i, d_nelmts, buf, min,                              \
+                                     HDfabs(buf[i] - filval) < HDpow(10.0f, -D_val))     \
       H5Z_scaleoffset_check_3(i, type, pow_fun, round_fun, max, min, minbits, D_val)                \
       span = (unsigned long long)(llround_fun(max * pow_fun(10.0f, (type)D_val) - min * pow_fun(10.0f, (type)D_val)) + 1); \
       *minbits = H5Z_scaleoffset_log2(span + 1);                                         \
       if(*minbits != sizeof(type) * 8) /* change values if minbits != full precision */  \
          H5Z_scaleoffset_modify_1(i, type, pow_fun, abs_fun, lround_fun, llround_fun, buf, d_nelmts, filval, minbits, min, D_val)   \
    } else { /* fill value undefined */                                                   \
-      H5Z_scaleoffset_max_min_2(i, d_nelmts, buf, max, min)                              \
+      max_min_fun(buf, d_nelmts, &max, &min);                                            \
+      H5Z_scaleoffset_first_zero_min(i, d_nelmts, buf, min, 0)                           \
       H5Z_scaleoffset_check_3(i, type, pow_fun, round_fun, max, min, minbits, D_val)                \
       span = (unsigned long long)(llround_fun(max * pow_fun(10.0f, (type)D_val) - min * pow_fun(10.0f, (type)D_val)) + 1); \
       *minbits = H5Z_scaleoffset_log2(span);                                             \
@@ -615,38 +744,42 @@ H5Z_class2_t H5Z_SCALEOFFSET[1] = {{
 }
 
 /* Modify values of data in postdecompression if fill value defined for floating-point type */
-#define H5Z_scaleoffset_modify_3(i, type, pow_fun, buf, d_nelmts, filval, minbits, min, D_val)     \
-{                                                                                         \
-   if(sizeof(type) == sizeof(int))                                                          \
-      for(i = 0; i < d_nelmts; i++)                                                       \
-         buf[i] = (type)((*(int *)((void *)&buf[i]) == (int)(((unsigned int)1 << minbits) - 1)) ?   \
-                  filval : (type)(*(int *)((void *)&buf[i])) / pow_fun(10.0f, (type)D_val) + min);        \
-   else if(sizeof(type) == sizeof(long))                                                    \
-      for(i = 0; i < d_nelmts; i++)                                                       \
-         buf[i] = (type)((*(long *)((void *)&buf[i]) == (long)(((unsigned long)1 << minbits) - 1)) ? \
-                  filval : (type)(*(long *)((void *)&buf[i])) / pow_fun(10.0f, (type)D_val) + min);       \
-   else if(sizeof(type) == sizeof(long long))                                               \
-      for(i = 0; i < d_nelmts; i++)                                                       \
-         buf[i] = (type)((*(long long *)((void *)&buf[i]) == (long long)(((unsigned long long)1 << minbits) - 1)) ? \
-                  filval : (type)(*(long long *)((void *)&buf[i])) / pow_fun(10.0f, (type)D_val) + min);  \
-   else                                                                                   \
-      HGOTO_ERROR(H5E_PLINE, H5E_BADTYPE, FAIL, "cannot find matched integer dataype")    \
+#define H5Z_scaleoffset_modify_3(i, type, pow_fun, buf, d_nelmts, filval, minbits, min, D_val)\
+{                                                                                  \
+   type _scale = pow_fun(10.0f, (type)D_val);      /* decimal scale */             \
+                                                                                   \
+   if(sizeof(type) == sizeof(int))                                                 \
+      for(i = 0; i < d_nelmts; i++)                                                \
+         buf[i] = (type)((*(int *)((void *)&buf[i]) == (int)(((unsigned int)1 << minbits) - 1)) ?\
+                  filval : (type)(*(int *)((void *)&buf[i])) / _scale + min);      \
+   else if(sizeof(type) == sizeof(long))                                           \
+      for(i = 0; i < d_nelmts; i++)                                                \
+         buf[i] = (type)((*(long *)((void *)&buf[i]) == (long)(((unsigned long)1 << minbits) - 1)) ?\
+                  filval : (type)(*(long *)((void *)&buf[i])) / _scale + min);     \
+   else if(sizeof(type) == sizeof(long long))                                      \
+      for(i = 0; i < d_nelmts; i++)                                                \
+         buf[i] = (type)((*(long long *)((void *)&buf[i]) == (long long)(((unsigned long long)1 << minbits) - 1)) ?\
+                  filval : (type)(*(long long *)((void *)&buf[i])) / _scale + min);\
+   else                                                                            \
+      HGOTO_ERROR(H5E_PLINE, H5E_BADTYPE, FAIL, "cannot find matched integer dataype")\
 }
 
 /* Modify values of data in postdecompression if fill value undefined for floating-point type */
-#define H5Z_scaleoffset_modify_4(i, type, pow_fun, buf, d_nelmts, min, D_val)                   \
-{                                                                                      \
-   if(sizeof(type)==sizeof(int))                                                       \
-      for(i = 0; i < d_nelmts; i++)                                                    \
-         buf[i] = ((type)(*(int *)((void *)&buf[i])) / pow_fun(10.0f, (type)D_val) + min);       \
-   else if(sizeof(type)==sizeof(long))                                                 \
-      for(i = 0; i < d_nelmts; i++)                                                    \
-         buf[i] = ((type)(*(long *)((void *)&buf[i])) / pow_fun(10.0f, (type)D_val) + min);      \
-   else if(sizeof(type)==sizeof(long long))                                            \
-      for(i = 0; i < d_nelmts; i++)                                                    \
-         buf[i] = ((type)(*(long long *)((void *)&buf[i])) / pow_fun(10.0f, (type)D_val) + min); \
-   else                                                                                \
-      HGOTO_ERROR(H5E_PLINE, H5E_BADTYPE, FAIL, "cannot find matched integer dataype") \
+#define H5Z_scaleoffset_modify_4(i, type, pow_fun, buf, d_nelmts, min, D_val)      \
+{                                                                                  \
+   type _scale = pow_fun(10.0f, (type)D_val);      /* decimal scale */             \
+                                                                                   \
+   if(sizeof(type)==sizeof(int))                                                   \
+      for(i = 0; i < d_nelmts; i++)                                                \
+         buf[i] = ((type)(*(int *)((void *)&buf[i])) / _scale + min);              \
+   else if(sizeof(type)==sizeof(long))                                             \
+      for(i = 0; i < d_nelmts; i++)                                                \
+         buf[i] = ((type)(*(long *)((void *)&buf[i])) / _scale + min);             \
+   else if(sizeof(type)==sizeof(long long))                                        \
+      for(i = 0; i < d_nelmts; i++)                                                \
+         buf[i] = ((type)(*(long long *)((void *)&buf[i])) / _scale + min);        \
+   else                                                                            \
+      HGOTO_ERROR(H5E_PLINE, H5E_BADTYPE, FAIL, "cannot find matched integer dataype")\
 }
 
 /* Postdecompress for floating-point type using variable-minimum-bits method */
@@ -1386,7 +1519,7 @@ H5Z_scaleoffset_precompress_i(void *data, unsigned d_nelmts, enum H5Z_scaleoffse
         if(filavail == H5Z_SCALEOFFSET_FILL_DEFINED) { /* fill value defined */
             H5Z_scaleoffset_get_filval_1(signed char, cd_values, filval);
             if(*minbits == H5Z_SO_INT_MINBITS_DEFAULT) { /* minbits not set yet, calculate max, min, and minbits */
-                H5Z_scaleoffset_max_min_1(i, d_nelmts, buf, filval, max, min)
+                H5Z_scaleoffset_max_min_1(i, signed char, d_nelmts, buf, filval, max, min)
                 if((unsigned char)(max - min) > (unsigned char)(~(unsigned char)0 - 2)) {
                     *minbits = sizeof(signed char)*8;
                     return;
@@ -1394,13 +1527,13 @@ H5Z_scaleoffset_precompress_i(void *data, unsigned d_nelmts, enum H5Z_scaleoffse
                 span = (unsigned char)(max - min + 1);
                 *minbits = H5Z_scaleoffset_log2((unsigned long long)(span+1));
             } else /* minbits already set, only calculate min */
-                H5Z_scaleoffset_min_1(i, d_nelmts, buf, filval, min)
+                H5Z_scaleoffset_min_1(i, signed char, d_nelmts, buf, filval, min)
             if(*minbits != sizeof(signed char)*8) /* change values if minbits != full precision */
                 for(i = 0; i < d_nelmts; i++)
                     buf[i] = (signed char)((buf[i] == filval) ? (((unsigned char)1 << *minbits) - 1) : (buf[i] - min));
         } else { /* fill value undefined */
             if(*minbits == H5Z_SO_INT_MINBITS_DEFAULT) { /* minbits not set yet, calculate max, min, and minbits */
-                H5Z_scaleoffset_max_min_2(i, d_nelmts, buf, max, min)
+                H5Z_scaleoffset_max_min_2(i, signed char, d_nelmts, buf, max, min)
                 if((unsigned char)(max - min) > (unsigned char)(~(unsigned char)0 - 2)) {
                     *minbits = sizeof(signed char)*8;
                     *minval = (unsigned long long)min;
@@ -1409,7 +1542,7 @@ H5Z_scaleoffset_precompress_i(void *data, unsigned d_nelmts, enum H5Z_scaleoffse
                 span = (unsigned char)(max - min + 1);
                 *minbits = H5Z_scaleoffset_log2((unsigned long long)span);
             } else /* minbits already set, only calculate min */
-                H5Z_scaleoffset_min_2(i, d_nelmts, buf, min)
+                H5Z_scaleoffset_min_2(i, signed char, d_nelmts, buf, min)
             if(*minbits != sizeof(signed char) * 8) /* change values if minbits != full precision */
                 for(i = 0; i < d_nelmts; i++)
                     buf[i] = (signed char)(buf[i] - min);
@@ -1489,17 +1622,105 @@ H5Z_scaleoffset_precompress_fd(void *data, unsigned d_nelmts, enum H5Z_scaleoffs
 
     FUNC_ENTER_NOAPI_NOINIT
 
+H5_GCC_DIAG_OFF(float-equal)
     if(type == t_float)
-        H5Z_scaleoffset_precompress_3(float, HDpowf, HDfabsf, HDroundf, HDlroundf, HDllroundf, data, d_nelmts,
+        H5Z_scaleoffset_precompress_3(float, HDpowf, HDfabsf, HDroundf, HDlroundf, HDllroundf,
+                                      H5Z__scaleoffset_max_min_float, data, d_nelmts,
                                       filavail, cd_values, minbits, minval, D_val)
     else if(type == t_double)
-        H5Z_scaleoffset_precompress_3(double, HDpow, HDfabs, HDround, HDlround, HDllround, data, d_nelmts,
+        H5Z_scaleoffset_precompress_3(double, HDpow, HDfabs, HDround, HDlround, HDllround,
+                                      H5Z__scaleoffset_max_min_double, data, d_nelmts,
                                       filavail, cd_values, minbits, minval, D_val)
+H5_GCC_DIAG_ON(float-equal)
 
 done:
     FUNC_LEAVE_NOAPI(ret_value)
 }
 
+/* find maximum and minimum of a float buffer with fill value undefined;
+ * MINPS/MAXPS return their second operand unless the first compares
+ * less/greater, the same choice the scalar loop makes, NaNs included */
+static void
+H5Z__scaleoffset_max_min_float(const float *buf, unsigned d_nelmts, float *max, float *min)
+{
+    float mx = buf[0], mn = buf[0];
+    unsigned i = 0;
+
+#ifdef H5Z_SCALEOFFSET_SIMD
+    if(d_nelmts >= 8) {
+        __m128 vmx0 = _mm_set1_ps(mx), vmx1 = vmx0, vmn0 = vmx0, vmn1 = vmx0;
+        float lanes[8];
+        unsigned u;
+
+        for(; i + 8 <= d_nelmts; i += 8) {
+            __m128 v0 = _mm_loadu_ps(buf + i), v1 = _mm_loadu_ps(buf + i + 4);
+
+            vmx0 = _mm_max_ps(v0, vmx0);
+            vmx1 = _mm_max_ps(v1, vmx1);
+            vmn0 = _mm_min_ps(v0, vmn0);
+            vmn1 = _mm_min_ps(v1, vmn1);
+        } /* end for */
+        _mm_storeu_ps(lanes, vmx0);
+        _mm_storeu_ps(lanes + 4, vmx1);
+        for(u = 0; u < 8; u++)
+            if(lanes[u] > mx) mx = lanes[u];
+        _mm_storeu_ps(lanes, vmn0);
+        _mm_storeu_ps(lanes + 4, vmn1);
+        for(u = 0; u < 8; u++)
+            if(lanes[u] < mn) mn = lanes[u];
+    } /* end if */
+#endif /* H5Z_SCALEOFFSET_SIMD */
+
+    for(; i < d_nelmts; i++) {
+        if(buf[i] > mx) mx = buf[i];
+        if(buf[i] < mn) mn = buf[i];
+    } /* end for */
+
+    *max = mx;
+    *min = mn;
+}
+
+/* find maximum and minimum of a double buffer with fill value undefined */
+static void
+H5Z__scaleoffset_max_min_double(const double *buf, unsigned d_nelmts, double *max, double *min)
+{
+    double mx = buf[0], mn = buf[0];
+    unsigned i = 0;
+
+#ifdef H5Z_SCALEOFFSET_SIMD
+    if(d_nelmts >= 4) {
+        __m128d vmx0 = _mm_set1_pd(mx), vmx1 = vmx0, vmn0 = vmx0, vmn1 = vmx0;
+        double lanes[4];
+        unsigned u;
+
+        for(; i + 4 <= d_nelmts; i += 4) {
+            __m128d v0 = _mm_loadu_pd(buf + i), v1 = _mm_loadu_pd(buf + i + 2);
+
+            vmx0 = _mm_max_pd(v0, vmx0);
+            vmx1 = _mm_max_pd(v1, vmx1);
+            vmn0 = _mm_min_pd(v0, vmn0);
+            vmn1 = _mm_min_pd(v1, vmn1);
+        } /* end for */
+        _mm_storeu_pd(lanes, vmx0);
+        _mm_storeu_pd(lanes + 2, vmx1);
+        for(u = 0; u < 4; u++)
+            if(lanes[u] > mx) mx = lanes[u];
+        _mm_storeu_pd(lanes, vmn0);
+        _mm_storeu_pd(lanes + 2, vmn1);
+        for(u = 0; u < 4; u++)
+            if(lanes[u] < mn) mn = lanes[u];
+    } /* end if */
+#endif /* H5Z_SCALEOFFSET_SIMD */
+
+    for(; i < d_nelmts; i++) {
+        if(buf[i] > mx) mx = buf[i];
+        if(buf[i] < mn) mn = buf[i];
+    } /* end for */
+
+    *max = mx;
+    *min = mn;
+}
+
 /* postdecompress for floating-point type, variable-minimum-bits method
    success: non-negative, failure: negative 4/15/05 */
 static herr_t
@@ -1593,6 +1814,121 @@ H5Z_scaleoffset_decompress_one_atomic(unsigned char *data, size_t data_offset,
    }
 }
 
+/* ======== Word-at-a-time kernels =====================================
+ * The packed stream is the low MINBITS bits of each element, most
+ * significant first, laid end to end.  These kernels build it in a
+ * 64-bit bit accumulator flushed 32 bits at a time; elements wider than
+ * 32 bits go in as two pieces.  Elements are in memory byte order here,
+ * so they are read and written as native integers.
+ */
+
+/* Append the low NBITS (at most 32) bits of VAL to the stream */
+#define H5Z_SCALEOFFSET_PUT_BITS(val, nbits)                               \
+{                                                                          \
+    acc = (acc << (nbits)) | (val);                                        \
+    nacc += (nbits);                                                       \
+    if(nacc >= 32) {                                                       \
+        uint32_t _word;                                                    \
+                                                                           \
+        nacc -= 32;                                                        \
+        _word = (uint32_t)(acc >> nacc);                                   \
+        buffer[j]     = (unsigned char)(_word >> 24);                      \
+        buffer[j + 1] = (unsigned char)(_word >> 16);                      \
+        buffer[j + 2] = (unsigned char)(_word >> 8);                       \
+        buffer[j + 3] = (unsigned char)_word;                              \
+        j += 4;                                                            \
+    }                                                                      \
+}
+
+/* Take the next NBITS (at most 32) bits of the stream into VAL */
+#define H5Z_SCALEOFFSET_GET_BITS(val, nbits)                               \
+{                                                                          \
+    if(nacc < (nbits)) {                                                   \
+        if(j + 4 <= nbytes_in) {                                           \
+            acc = (acc << 32) | ((uint64_t)buffer[j] << 24) | ((uint64_t)buffer[j + 1] << 16) \
+                    | ((uint64_t)buffer[j + 2] << 8) | (uint64_t)buffer[j + 3]; \
+            j += 4;                                                        \
+            nacc += 32;                                                    \
+        }                                                                  \
+        else                                                               \
+            while(nacc < (nbits)) {                                        \
+                acc = (acc << 8) | buffer[j++];                            \
+                nacc += 8;                                                 \
+            }                                                              \
+    }                                                                      \
+    nacc -= (nbits);                                                       \
+    val = (acc >> nacc) & (((uint64_t)1 << (nbits)) - 1);                  \
+}
+
+static H5_INLINE void
+H5Z__scaleoffset_pack(const void *data, unsigned d_nelmts, unsigned char *buffer,
+    unsigned size, unsigned minbits)
+{
+    uint64_t mask = ((uint64_t)1 << minbits) - 1;       /* minbits < size * 8 <= 64 */
+    unsigned hi_bits = minbits > 32 ? minbits - 32 : 0; /* bits above the low word */
+    unsigned lo_bits = minbits - hi_bits;
+    uint64_t acc = 0;           /* bit accumulator, pending bits are the low NACC */
+    unsigned nacc = 0;          /* number of pending bits, always < 32 between pieces */
+    size_t j = 0;
+    unsigned i;
+
+    for(i = 0; i < d_nelmts; i++) {
+        uint64_t val;
+
+        if(size == 1)
+            val = ((const uint8_t *)data)[i];
+        else if(size == 2)
+            val = ((const uint16_t *)data)[i];
+        else if(size == 4)
+            val = ((const uint32_t *)data)[i];
+        else
+            val = ((const uint64_t *)data)[i];
+        val &= mask;
+
+        if(hi_bits > 0)
+            H5Z_SCALEOFFSET_PUT_BITS(val >> 32, hi_bits)
+        H5Z_SCALEOFFSET_PUT_BITS(val & 0xffffffff, lo_bits)
+    } /* end for */
+
+    /* Flush whole bytes, then the left-justified partial byte */
+    while(nacc >= 8) {
+        nacc -= 8;
+        buffer[j++] = (unsigned char)(acc >> nacc);
+    } /* end while */
+    if(nacc > 0)
+        buffer[j] = (unsigned char)(acc << (8 - nacc));
+}
+
+static H5_INLINE void
+H5Z__scaleoffset_unpack(void *data, unsigned d_nelmts, const unsigned char *buffer,
+    unsigned size, unsigned minbits)
+{
+    size_t nbytes_in = ((size_t)d_nelmts * minbits + 7) / 8;  /* bytes holding the stream */
+    unsigned hi_bits = minbits > 32 ? minbits - 32 : 0; /* bits above the low word */
+    unsigned lo_bits = minbits - hi_bits;
+    uint64_t acc = 0;           /* bit accumulator, unread bits are the low NACC */
+    unsigned nacc = 0;          /* number of unread bits, always < 64 */
+    size_t j = 0;
+    unsigned i;
+
+    for(i = 0; i < d_nelmts; i++) {
+        uint64_t hi = 0, lo;
+
+        if(hi_bits > 0)
+            H5Z_SCALEOFFSET_GET_BITS(hi, hi_bits)
+        H5Z_SCALEOFFSET_GET_BITS(lo, lo_bits)
+
+        if(size == 1)
+            ((uint8_t *)data)[i] = (uint8_t)lo;
+        else if(size == 2)
+            ((uint16_t *)data)[i] = (uint16_t)lo;
+        else if(size == 4)
+            ((uint32_t *)data)[i] = (uint32_t)lo;
+        else
+            ((uint64_t *)data)[i] = (hi << 32) | lo;
+    } /* end for */
+}
+
 static void
 H5Z_scaleoffset_decompress(unsigned char *data, unsigned d_nelmts,
     unsigned char *buffer, parms_atomic p)
@@ -1602,6 +1938,24 @@ H5Z_scaleoffset_decompress(unsigned char *data, unsigned d_nelmts,
     size_t i, j;
     unsigned buf_len;
 
+    /* Instantiate the word-at-a-time kernel for each element size */
+    switch(p.size) {
+        case 1:
+            H5Z__scaleoffset_unpack(data, d_nelmts, buffer, 1, p.minbits);
+            return;
+        case 2:
+            H5Z__scaleoffset_unpack(data, d_nelmts, buffer, 2, p.minbits);
+            return;
+        case 4:
+            H5Z__scaleoffset_unpack(data, d_nelmts, buffer, 4, p.minbits);
+            return;
+        case 8:
+            H5Z__scaleoffset_unpack(data, d_nelmts, buffer, 8, p.minbits);
+            return;
+        default:
+            break;
+    } /* end switch */
+
     /* must initialize to zeros */
     for(i = 0; i < d_nelmts * p.size; i++)
         data[i] = 0;
@@ -1688,6 +2042,24 @@ H5Z_scaleoffset_compress(unsigned char *data, unsigned d_nelmts,
    for(j = 0; j < buffer_size; j++)
       buffer[j] = 0;
 
+   /* Instantiate the word-at-a-time kernel for each element size */
+   switch(p.size) {
+      case 1:
+         H5Z__scaleoffset_pack(data, d_nelmts, buffer, 1, p.minbits);
+         return;
+      case 2:
+         H5Z__scaleoffset_pack(data, d_nelmts, buffer, 2, p.minbits);
+         return;
+      case 4:
+         H5Z__scaleoffset_pack(data, d_nelmts, buffer, 4, p.minbits);
+         return;
+      case 8:
+         H5Z__scaleoffset_pack(data, d_nelmts, buffer, 8, p.minbits);
+         return;
+      default:
+         break;
+   } /* end switch */
+
    /* initialization before the loop */
    j = 0;
    buf_len = sizeof(unsigned char) * 8;
@@ -22,10 +22,32 @@
 #include "H5Tprivate.h"		/* Datatypes         			*/
 #include "H5Zpkg.h"		/* Data filters				*/
 
+/* Byte transposes with SSE2 vectors on x86-64, and AVX2 vectors when the
+ * CPU has them (checked at run time).  Define H5Z_SHUFFLE_NO_SIMD to use
+ * only the portable loops. */
+#if defined(__x86_64__) && defined(__GNUC__) && (__GNUC__ >= 5 || defined(__clang__)) \
+        && !defined(H5Z_SHUFFLE_NO_SIMD)
+#define H5Z_SHUFFLE_SIMD
+#include <immintrin.h>
+#define H5Z_SHUFFLE_AVX2        __attribute__((target("avx2")))
+#endif /* __x86_64__ */
+
 /* Local function prototypes */
 static herr_t H5Z_set_local_shuffle(hid_t dcpl_id, hid_t type_id, hid_t space_id);
 static size_t H5Z_filter_shuffle(unsigned flags, size_t cd_nelmts,
     const unsigned cd_values[], size_t nbytes, size_t *buf_size, void **buf);
+#ifdef H5Z_SHUFFLE_SIMD
+static size_t H5Z__shuffle_sse2(unsigned char *dest, const unsigned char *src,
+    unsigned bytesoftype, size_t numofelements);
+static size_t H5Z__unshuffle_sse2(unsigned char *dest, const unsigned char *src,
+    unsigned bytesoftype, size_t numofelements);
+static size_t H5Z__shuffle_avx2(unsigned char *dest, const unsigned char *src,
+    unsigned bytesoftype, size_t numofelements) H5Z_SHUFFLE_AVX2;
+static size_t H5Z__unshuffle_avx2(unsigned char *dest, const unsigned char *src,
+    unsigned bytesoftype, size_t numofelements) H5Z_SHUFFLE_AVX2;
+static size_t H5Z__shuffle_simd(unsigned char *dest, const unsigned char *src,
+    unsigned bytesoftype, size_t numofelements, hbool_t reverse);
+#endif /* H5Z_SHUFFLE_SIMD */
 
 /* This message derives from H5Z */
 const H5Z_class2_t H5Z_SHUFFLE[1] = {{
@@ -127,6 +149,7 @@ H5Z_filter_shuffle(unsigned flags, size_t cd_nelmts, const unsigned cd_values[],
     unsigned char *_dest=NULL;  /* Alias for destination buffer */
     unsigned bytesoftype;       /* Number of bytes per element */
     size_t numofelements;       /* Number of elements in buffer */
+    size_t nvec = 0;            /* Number of elements transposed with vectors */
     size_t i;                   /* Local index variables */
 #ifdef NO_DUFFS_DEVICE
     size_t j;                   /* Local index variable */
@@ -155,18 +178,24 @@ H5Z_filter_shuffle(unsigned flags, size_t cd_nelmts, const unsigned cd_values[],
         if (NULL==(dest = H5MM_malloc(nbytes)))
             HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, 0, "memory allocation failed for shuffle buffer")
 
-        if(flags & H5Z_FLAG_REVERSE) {
-            /* Get the pointer to the source buffer */
-            _src =(unsigned char *)(*buf);
+#ifdef H5Z_SHUFFLE_SIMD
+        /* Transpose as many elements as possible with vectors */
+        nvec = H5Z__shuffle_simd((unsigned char *)dest, (const unsigned char *)(*buf),
+                bytesoftype, numofelements, (hbool_t)((flags & H5Z_FLAG_REVERSE) != 0));
+#endif /* H5Z_SHUFFLE_SIMD */
 
-            /* Input; unshuffle */
+        if(nvec == numofelements)
+            ;   /* All done */
+        else if(flags & H5Z_FLAG_REVERSE) {
+            /* Input; unshuffle the rest of the elements */
             for(i=0; i<bytesoftype; i++) {
-                _dest=((unsigned char *)dest)+i;
+                _src=((unsigned char *)(*buf))+(i*numofelements)+nvec;
+                _dest=((unsigned char *)dest)+(nvec*bytesoftype)+i;
 #define DUFF_GUTS							    \
     *_dest=*_src++;                             \
     _dest+=bytesoftype;
 #ifdef NO_DUFFS_DEVICE
-                j = numofelements;
+                j = numofelements - nvec;
                 while(j > 0) {
                     DUFF_GUTS;
 
@@ -176,8 +205,8 @@ H5Z_filter_shuffle(unsigned flags, size_t cd_nelmts, const unsigned cd_values[],
             {
                 size_t duffs_index; /* Counting index for Duff's device */
 
-                duffs_index = (numofelements + 7) / 8;
-                switch (numofelements % 8) {
+                duffs_index = ((numofelements - nvec) + 7) / 8;
+                switch ((numofelements - nvec) % 8) {
                     default:
                         HDassert(0 && "This Should never be executed!");
                         break;
@@ -212,26 +241,17 @@ H5Z_filter_shuffle(unsigned flags, size_t cd_nelmts, const unsigned cd_values[],
 #endif /* NO_DUFFS_DEVICE */
 #undef DUFF_GUTS
             } /* end for */
-
-            /* Add leftover to the end of data */
-            if(leftover>0) {
-                /* Adjust back to end of shuffled bytes */
-                _dest -= (bytesoftype - 1);     /*lint !e794 _dest is initialized */
-                H5MM_memcpy((void*)_dest, (void*)_src, leftover);
-            }
         } /* end if */
         else {
-            /* Get the pointer to the destination buffer */
-            _dest =(unsigned char *)dest;
-
-            /* Output; shuffle */
+            /* Output; shuffle the rest of the elements */
             for(i=0; i<bytesoftype; i++) {
-                _src=((unsigned char *)(*buf))+i;
+                _src=((unsigned char *)(*buf))+(nvec*bytesoftype)+i;
+                _dest=((unsigned char *)dest)+(i*numofelements)+nvec;
 #define DUFF_GUTS							    \
     *_dest++=*_src;                             \
     _src+=bytesoftype;
 #ifdef NO_DUFFS_DEVICE
-                j = numofelements;
+                j = numofelements - nvec;
                 while(j > 0) {
                     DUFF_GUTS;
 
@@ -241,8 +261,8 @@ H5Z_filter_shuffle(unsigned flags, size_t cd_nelmts, const unsigned cd_values[],
             {
                 size_t duffs_index; /* Counting index for Duff's device */
 
-                duffs_index = (numofelements + 7) / 8;
-                switch (numofelements % 8) {
+                duffs_index = ((numofelements - nvec) + 7) / 8;
+                switch ((numofelements - nvec) % 8) {
                     default:
                         HDassert(0 && "This Should never be executed!");
                         break;
@@ -277,15 +297,13 @@ H5Z_filter_shuffle(unsigned flags, size_t cd_nelmts, const unsigned cd_values[],
 #endif /* NO_DUFFS_DEVICE */
 #undef DUFF_GUTS
             } /* end for */
-
-            /* Add leftover to the end of data */
-            if(leftover>0) {
-                /* Adjust back to end of shuffled bytes */
-                _src -= (bytesoftype - 1);      /*lint !e794 _src is initialized */
-                H5MM_memcpy((void*)_dest, (void*)_src, leftover);
-            }
         } /* end else */
 
+        /* Copy the leftover bytes, which stay at the end of the data */
+        if(leftover>0)
+            H5MM_memcpy((unsigned char *)dest+(numofelements*bytesoftype),
+                    (unsigned char *)(*buf)+(numofelements*bytesoftype), leftover);
+
         /* Free the input buffer */
         H5MM_xfree(*buf);
 
@@ -301,3 +319,268 @@ done:
     FUNC_LEAVE_NOAPI(ret_value)
 }
 
+
+/*-------------------------------------------------------------------------
+ * Function:	H5Z__shuffle_bytes
+ *
+ * Purpose:	Shuffle (or unshuffle, if REVERSE is set) NUMOFELEMENTS
+ *              elements of BYTESOFTYPE bytes from SRC into DEST, which
+ *              must not overlap.  This is the transpose the shuffle
+ *              filter does, for other filters that build on it.
+ *
+ * Return:	void
+ *
+ *-------------------------------------------------------------------------
+ */
+void
+H5Z__shuffle_bytes(void *dest, const void *src, unsigned bytesoftype,
+    size_t numofelements, hbool_t reverse)
+{
+    const unsigned char *_src;  /* Alias for source buffer */
+    unsigned char *_dest;       /* Alias for destination buffer */
+    size_t nvec = 0;            /* Number of elements transposed with vectors */
+    size_t i, j;                /* Local index variables */
+
+    FUNC_ENTER_PACKAGE_NOERR
+
+    HDassert(dest);
+    HDassert(src);
+    HDassert(bytesoftype > 0);
+
+#ifdef H5Z_SHUFFLE_SIMD
+    nvec = H5Z__shuffle_simd((unsigned char *)dest, (const unsigned char *)src,
+            bytesoftype, numofelements, reverse);
+#endif /* H5Z_SHUFFLE_SIMD */
+
+    for(i = 0; i < bytesoftype; i++) {
+        if(reverse) {
+            _src = (const unsigned char *)src + (i * numofelements) + nvec;
+            _dest = (unsigned char *)dest + (nvec * bytesoftype) + i;
+            for(j = nvec; j < numofelements; j++, _dest += bytesoftype)
+                *_dest = *_src++;
+        } /* end if */
+        else {
+            _src = (const unsigned char *)src + (nvec * bytesoftype) + i;
+            _dest = (unsigned char *)dest + (i * numofelements) + nvec;
+            for(j = nvec; j < numofelements; j++, _src += bytesoftype)
+                *_dest++ = *_src;
+        } /* end else */
+    } /* end for */
+
+    FUNC_LEAVE_NOAPI_VOID
+} /* end H5Z__shuffle_bytes() */
+
+
+#ifdef H5Z_SHUFFLE_SIMD
+
+/*-------------------------------------------------------------------------
+ * Function:	H5Z__shuffle_simd
+ *
+ * Purpose:	Shuffle (or unshuffle, if REVERSE is set) as many whole
+ *              blocks of elements as possible from SRC into DEST with
+ *              vector instructions, for element sizes of 2, 4, 8 and 16
+ *              bytes.  The output is laid out exactly as the portable
+ *              loops lay it out.
+ *
+ * Return:	Number of elements [un]shuffled (0 for other element
+ *              sizes); the caller transposes the rest.
+ *
+ *-------------------------------------------------------------------------
+ */
+static size_t
+H5Z__shuffle_simd(unsigned char *dest, const unsigned char *src,
+    unsigned bytesoftype, size_t numofelements, hbool_t reverse)
+{
+    size_t ret_value = 0;       /* Return value */
+
+    FUNC_ENTER_STATIC_NOERR
+
+    if(bytesoftype == 2 || bytesoftype == 4 || bytesoftype == 8 || bytesoftype == 16) {
+        if(__builtin_cpu_supports("avx2"))
+            ret_value = reverse ? H5Z__unshuffle_avx2(dest, src, bytesoftype, numofelements)
+                    : H5Z__shuffle_avx2(dest, src, bytesoftype, numofelements);
+        else
+            ret_value = reverse ? H5Z__unshuffle_sse2(dest, src, bytesoftype, numofelements)
+                    : H5Z__shuffle_sse2(dest, src, bytesoftype, numofelements);
+    } /* end if */
+
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5Z__shuffle_simd() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5Z__shuffle_sse2
+ *
+ * Purpose:	Shuffle blocks of 16 elements of BYTESOFTYPE bytes (a power
+ *              of 2, up to 16) with SSE2 vectors.  Each block is loaded
+ *              into BYTESOFTYPE vectors, which are split into their even
+ *              and odd bytes log2(BYTESOFTYPE) times; that leaves one
+ *              vector for each byte position, holding that byte of the
+ *              16 elements in order.
+ *
+ * Return:	Number of elements shuffled
+ *
+ *-------------------------------------------------------------------------
+ */
+static size_t
+H5Z__shuffle_sse2(unsigned char *dest, const unsigned char *src,
+    unsigned bytesoftype, size_t numofelements)
+{
+    const __m128i lo_mask = _mm_set1_epi16(0x00FF);    /* Mask for even bytes */
+    unsigned half = bytesoftype / 2;    /* Half the number of vectors */
+    size_t nvec = numofelements & ~(size_t)15;  /* Number of elements to shuffle */
+    __m128i v[16], t[16];       /* Vectors of a block */
+    size_t j;                   /* Local index variable */
+    unsigned u, r;              /* Local index variables */
+
+    FUNC_ENTER_STATIC_NOERR
+
+    for(j = 0; j < nvec; j += 16) {
+        for(u = 0; u < bytesoftype; u++)
+            v[u] = _mm_loadu_si128((const __m128i *)(src + (j * bytesoftype) + (u * 16)));
+        for(r = half; r > 0; r >>= 1) {
+            for(u = 0; u < half; u++) {
+                t[u] = _mm_packus_epi16(_mm_and_si128(v[2 * u], lo_mask), _mm_and_si128(v[2 * u + 1], lo_mask));
+                t[u + half] = _mm_packus_epi16(_mm_srli_epi16(v[2 * u], 8), _mm_srli_epi16(v[2 * u + 1], 8));
+            } /* end for */
+            for(u = 0; u < bytesoftype; u++)
+                v[u] = t[u];
+        } /* end for */
+        for(u = 0; u < bytesoftype; u++)
+            _mm_storeu_si128((__m128i *)(dest + (u * numofelements) + j), v[u]);
+    } /* end for */
+
+    FUNC_LEAVE_NOAPI(nvec)
+} /* end H5Z__shuffle_sse2() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5Z__unshuffle_sse2
+ *
+ * Purpose:	Unshuffle blocks of 16 elements with SSE2 vectors, undoing
+ *              H5Z__shuffle_sse2() by interleaving the bytes of pairs of
+ *              vectors.
+ *
+ * Return:	Number of elements unshuffled
+ *
+ *-------------------------------------------------------------------------
+ */
+static size_t
+H5Z__unshuffle_sse2(unsigned char *dest, const unsigned char *src,
+    unsigned bytesoftype, size_t numofelements)
+{
+    unsigned half = bytesoftype / 2;    /* Half the number of vectors */
+    size_t nvec = numofelements & ~(size_t)15;  /* Number of elements to unshuffle */
+    __m128i v[16], t[16];       /* Vectors of a block */
+    size_t j;                   /* Local index variable */
+    unsigned u, r;              /* Local index variables */
+
+    FUNC_ENTER_STATIC_NOERR
+
+    for(j = 0; j < nvec; j += 16) {
+        for(u = 0; u < bytesoftype; u++)
+            v[u] = _mm_loadu_si128((const __m128i *)(src + (u * numofelements) + j));
+        for(r = half; r > 0; r >>= 1) {
+            for(u = 0; u < half; u++) {
+                t[2 * u] = _mm_unpacklo_epi8(v[u], v[u + half]);
+                t[2 * u + 1] = _mm_unpackhi_epi8(v[u], v[u + half]);
+            } /* end for */
+            for(u = 0; u < bytesoftype; u++)
+                v[u] = t[u];
+        } /* end for */
+        for(u = 0; u < bytesoftype; u++)
+            _mm_storeu_si128((__m128i *)(dest + (j * bytesoftype) + (u * 16)), v[u]);
+    } /* end for */
+
+    FUNC_LEAVE_NOAPI(nvec)
+} /* end H5Z__unshuffle_sse2() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5Z__shuffle_avx2
+ *
+ * Purpose:	Shuffle blocks of 32 elements with AVX2 vectors, the same
+ *              way as H5Z__shuffle_sse2().  The AVX2 pack instruction
+ *              works on each 128-bit half separately, so its results are
+ *              put back in order with a permute.
+ *
+ * Return:	Number of elements shuffled
+ *
+ *-------------------------------------------------------------------------
+ */
+static size_t
+H5Z__shuffle_avx2(unsigned char *dest, const unsigned char *src,
+    unsigned bytesoftype, size_t numofelements)
+{
+    const __m256i lo_mask = _mm256_set1_epi16(0x00FF);  /* Mask for even bytes */
+    unsigned half = bytesoftype / 2;    /* Half the number of vectors */
+    size_t nvec = numofelements & ~(size_t)31;  /* Number of elements to shuffle */
+    __m256i v[16], t[16];       /* Vectors of a block */
+    size_t j;                   /* Local index variable */
+    unsigned u, r;              /* Local index variables */
+
+    FUNC_ENTER_STATIC_NOERR
+
+    for(j = 0; j < nvec; j += 32) {
+        for(u = 0; u < bytesoftype; u++)
+            v[u] = _mm256_loadu_si256((const __m256i *)(src + (j * bytesoftype) + (u * 32)));
+        for(r = half; r > 0; r >>= 1) {
+            for(u = 0; u < half; u++) {
+                t[u] = _mm256_permute4x64_epi64(_mm256_packus_epi16(_mm256_and_si256(v[2 * u], lo_mask),
+                        _mm256_and_si256(v[2 * u + 1], lo_mask)), 0xD8);
+                t[u + half] = _mm256_permute4x64_epi64(_mm256_packus_epi16(_mm256_srli_epi16(v[2 * u], 8),
+                        _mm256_srli_epi16(v[2 * u + 1], 8)), 0xD8);
+            } /* end for */
+            for(u = 0; u < bytesoftype; u++)
+                v[u] = t[u];
+        } /* end for */
+        for(u = 0; u < bytesoftype; u++)
+            _mm256_storeu_si256((__m256i *)(dest + (u * numofelements) + j), v[u]);
+    } /* end for */
+
+    FUNC_LEAVE_NOAPI(nvec)
+} /* end H5Z__shuffle_avx2() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5Z__unshuffle_avx2
+ *
+ * Purpose:	Unshuffle blocks of 32 elements with AVX2 vectors, undoing
+ *              H5Z__shuffle_avx2().  The vectors are permuted before the
+ *              AVX2 unpack instructions, which work on each 128-bit half
+ *              separately.
+ *
+ * Return:	Number of elements unshuffled
+ *
+ *-------------------------------------------------------------------------
+ */
+static size_t
+H5Z__unshuffle_avx2(unsigned char *dest, const unsigned char *src,
+    unsigned bytesoftype, size_t numofelements)
+{
+    unsigned half = bytesoftype / 2;    /* Half the number of vectors */
+    size_t nvec = numofelements & ~(size_t)31;  /* Number of elements to unshuffle */
+    __m256i v[16], t[16];       /* Vectors of a block */
+    size_t j;                   /* Local index variable */
+    unsigned u, r;              /* Local index variables */
+
+    FUNC_ENTER_STATIC_NOERR
+
+    for(j = 0; j < nvec; j += 32) {
+        for(u = 0; u < bytesoftype; u++)
+            v[u] = _mm256_permute4x64_epi64(_mm256_loadu_si256((const __m256i *)(src + (u * numofelements) + j)), 0xD8);
+        for(r = half; r > 0; r >>= 1) {
+            for(u = 0; u < half; u++) {
+                t[2 * u] = _mm256_unpacklo_epi8(v[u], v[u + half]);
+                t[2 * u + 1] = _mm256_unpackhi_epi8(v[u], v[u + half]);
+            } /* end for */
+            for(u = 0; u < bytesoftype; u++)
+                v[u] = (r > 1) ? _mm256_permute4x64_epi64(t[u], 0xD8) : t[u];
+        } /* end for */
+        for(u = 0; u < bytesoftype; u++)
+            _mm256_storeu_si256((__m256i *)(dest + (j * bytesoftype) + (u * 32)), v[u]);
+    } /* end for */
+
+    FUNC_LEAVE_NOAPI(nvec)
+} /* end H5Z__unshuffle_avx2() */
+#endif /* H5Z_SHUFFLE_SIMD */
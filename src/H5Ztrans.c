@@ -58,10 +58,50 @@ typedef struct H5Z_node {
     H5Z_num_val         value;
 } H5Z_node;
 
+/* Maximum depth of the value stack for a compiled transform.  Deeper
+ * expressions are evaluated by walking the parse tree instead.
+ */
+#define H5Z_XFORM_MAX_DEPTH     8
+
+/* Number of elements a compiled transform evaluates at a time.  All of the
+ * intermediate values for one block stay in the L1 cache.
+ */
+#define H5Z_XFORM_BLOCK         128
+
+/* Instructions of a compiled transform */
+typedef enum {
+    H5Z_XFORM_OP_LOAD,          /* Push the data values                         */
+    H5Z_XFORM_OP_ADD_CONST,     /* top = top + val (also val + top)             */
+    H5Z_XFORM_OP_SUB_CONST,     /* top = top - val                              */
+    H5Z_XFORM_OP_MUL_CONST,     /* top = top * val (also val * top)             */
+    H5Z_XFORM_OP_DIV_CONST,     /* top = top / val                              */
+    H5Z_XFORM_OP_CONST_SUB,     /* top = val - top                              */
+    H5Z_XFORM_OP_CONST_DIV,     /* top = val / top                              */
+    H5Z_XFORM_OP_ADD,           /* Pop rhs, top = top + rhs                     */
+    H5Z_XFORM_OP_SUB,           /* Pop rhs, top = top - rhs                     */
+    H5Z_XFORM_OP_MUL,           /* Pop rhs, top = top * rhs                     */
+    H5Z_XFORM_OP_DIV            /* Pop rhs, top = top / rhs                     */
+} H5Z_xform_opcode;
+
+typedef struct {
+    H5Z_xform_opcode    code;       /* The operation                        */
+    double              val;        /* Constant operand, if there is one    */
+} H5Z_xform_inst;
+
+/* A transform compiled from its parse tree into postfix order, so that
+ * every element goes through the whole expression in one pass.
+ */
+typedef struct {
+    H5Z_xform_inst     *insts;      /* Instructions, NULL if not compiled   */
+    unsigned            ninsts;     /* Number of instructions               */
+    unsigned            nloads;     /* Number of references to the data     */
+} H5Z_xform_prog;
+
 struct H5Z_data_xform_t {
     char*       xform_exp;
     H5Z_node*       parse_root;
     H5Z_datval_ptrs*	dat_val_pointers;
+    H5Z_xform_prog      prog;       /* Compiled form of parse_root          */
 };
 
 typedef struct result {
@@ -100,6 +140,8 @@ static void H5Z_xform_destroy_parse_tree(H5Z_node *tree);
 static void* H5Z_xform_parse(const char *expression, H5Z_datval_ptrs* dat_val_pointers);
 static void* H5Z_xform_copy_tree(H5Z_node* tree, H5Z_datval_ptrs* dat_val_pointers, H5Z_datval_ptrs* new_dat_val_pointers);
 static void H5Z_xform_reduce_tree(H5Z_node* tree);
+static hbool_t H5Z_xform_compile_tree(const H5Z_node *tree, H5Z_xform_prog *prog, unsigned depth);
+static herr_t H5Z_xform_compile(H5Z_data_xform_t *data_xform_prop);
 #ifdef H5Z_XFORM_DEBUG
 static void H5Z_XFORM_DEBUG(H5Z_node *tree);
 static void H5Z_print(H5Z_node *tree, FILE *stream);
@@ -370,6 +412,120 @@ static void H5Z_print(H5Z_node *tree, FILE *stream);
         }																	\
 }
 
+/* Runs a compiled transform over SIZE elements of type TYPE, one block of
+ * H5Z_XFORM_BLOCK elements at a time, so each element passes through the whole
+ * expression while it is still in cache.  The arithmetic is the same as in
+ * H5Z_XFORM_DO_OP1: operations with a constant are done in double, operations
+ * between two data values in TYPE, and each intermediate result is stored as
+ * TYPE.  When the expression refers to the data only once (a linear transform)
+ * the block is updated in place, otherwise a copy of the data is pushed for
+ * each reference and the result is copied back at the end of the block.
+ * Whole blocks use a constant trip count so the compiler can vectorize the
+ * loops; H5Z_XFORM_DO_PROG_BLOCK handles one block of N elements.  Results
+ * computed in double are converted to TYPE through CTYPE, which is a wider
+ * signed type for unsigned int so that negative results wrap around the same
+ * way as they do with the scalar conversion in H5Z_XFORM_DO_OP1.
+ */
+#define H5Z_XFORM_DO_PROG_BLOCK(PROG, TYPE, CTYPE, N)                       \
+{                                                                           \
+    TYPE *_top = NULL;                                                      \
+    unsigned _depth = 0;                                                    \
+    unsigned _i;                                                            \
+    size_t _u;                                                              \
+                                                                            \
+    for(_i = 0; _i < (PROG)->ninsts; _i++) {                                \
+        const double _val = (PROG)->insts[_i].val;                          \
+                                                                            \
+        switch((PROG)->insts[_i].code) {                                    \
+            case H5Z_XFORM_OP_LOAD:                                         \
+                if((PROG)->nloads == 1)                                     \
+                    _top = _data;                                           \
+                else {                                                      \
+                    _top = _stack[_depth];                                  \
+                    HDmemcpy(_top, _data, (N) * sizeof(TYPE));              \
+                }                                                           \
+                _depth++;                                                   \
+                break;                                                      \
+                                                                            \
+            case H5Z_XFORM_OP_ADD_CONST:                                    \
+                for(_u = 0; _u < (N); _u++)                                 \
+                    _top[_u] = (TYPE)(CTYPE)((double)_top[_u] + _val);             \
+                break;                                                      \
+                                                                            \
+            case H5Z_XFORM_OP_SUB_CONST:                                    \
+                for(_u = 0; _u < (N); _u++)                                 \
+                    _top[_u] = (TYPE)(CTYPE)((double)_top[_u] - _val);             \
+                break;                                                      \
+                                                                            \
+            case H5Z_XFORM_OP_MUL_CONST:                                    \
+                for(_u = 0; _u < (N); _u++)                                 \
+                    _top[_u] = (TYPE)(CTYPE)((double)_top[_u] * _val);             \
+                break;                                                      \
+                                                                            \
+            case H5Z_XFORM_OP_DIV_CONST:                                    \
+                for(_u = 0; _u < (N); _u++)                                 \
+                    _top[_u] = (TYPE)(CTYPE)((double)_top[_u] / _val);             \
+                break;                                                      \
+                                                                            \
+            case H5Z_XFORM_OP_CONST_SUB:                                    \
+                for(_u = 0; _u < (N); _u++)                                 \
+                    _top[_u] = (TYPE)(CTYPE)(_val - (double)_top[_u]);             \
+                break;                                                      \
+                                                                            \
+            case H5Z_XFORM_OP_CONST_DIV:                                    \
+                for(_u = 0; _u < (N); _u++)                                 \
+                    _top[_u] = (TYPE)(CTYPE)(_val / (double)_top[_u]);             \
+                break;                                                      \
+                                                                            \
+            case H5Z_XFORM_OP_ADD:                                          \
+                _top = _stack[--_depth - 1];                                \
+                for(_u = 0; _u < (N); _u++)                                 \
+                    _stack[_depth - 1][_u] = (TYPE)(_stack[_depth - 1][_u] + _stack[_depth][_u]); \
+                break;                                                      \
+                                                                            \
+            case H5Z_XFORM_OP_SUB:                                          \
+                _top = _stack[--_depth - 1];                                \
+                for(_u = 0; _u < (N); _u++)                                 \
+                    _stack[_depth - 1][_u] = (TYPE)(_stack[_depth - 1][_u] - _stack[_depth][_u]); \
+                break;                                                      \
+                                                                            \
+            case H5Z_XFORM_OP_MUL:                                          \
+                _top = _stack[--_depth - 1];                                \
+                for(_u = 0; _u < (N); _u++)                                 \
+                    _stack[_depth - 1][_u] = (TYPE)(_stack[_depth - 1][_u] * _stack[_depth][_u]); \
+                break;                                                      \
+                                                                            \
+            case H5Z_XFORM_OP_DIV:                                          \
+                _top = _stack[--_depth - 1];                                \
+                for(_u = 0; _u < (N); _u++)                                 \
+                    _stack[_depth - 1][_u] = (TYPE)(_stack[_depth - 1][_u] / _stack[_depth][_u]); \
+                break;                                                      \
+                                                                            \
+            default:                                                        \
+                HGOTO_ERROR(H5E_ARGS, H5E_BADVALUE, FAIL, "Invalid instruction in compiled transform") \
+        }                                                                   \
+    }                                                                       \
+    HDassert(_depth == 1);                                                  \
+                                                                            \
+    if((PROG)->nloads > 1)                                                  \
+        HDmemcpy(_data, _stack[0], (N) * sizeof(TYPE));                     \
+}
+
+#define H5Z_XFORM_DO_PROG(PROG, TYPE, CTYPE, ARRAY, SIZE)                   \
+{                                                                           \
+    TYPE _stack[H5Z_XFORM_MAX_DEPTH][H5Z_XFORM_BLOCK];                      \
+    TYPE *_data = (TYPE *)(ARRAY);                                          \
+    size_t _nleft = (SIZE);                                                 \
+                                                                            \
+    while(_nleft >= H5Z_XFORM_BLOCK) {                                      \
+        H5Z_XFORM_DO_PROG_BLOCK(PROG, TYPE, CTYPE, H5Z_XFORM_BLOCK)         \
+        _data += H5Z_XFORM_BLOCK;                                           \
+        _nleft -= H5Z_XFORM_BLOCK;                                          \
+    }                                                                       \
+    if(_nleft > 0)                                                          \
+        H5Z_XFORM_DO_PROG_BLOCK(PROG, TYPE, CTYPE, _nleft)                  \
+}
+
 /*
  *  Programmer: Bill Wendling <wendling@ncsa.uiuc.edu>
  *              25. August 2003
@@ -1065,6 +1221,44 @@ H5Z_xform_eval(H5Z_data_xform_t *data_xform_prop, void* array, size_t array_size
             H5Z_XFORM_DO_OP5(long double, array_size)
 #endif
 
+    } /* end if */
+    /* Run the compiled form of the transform, if there is one */
+    else if(data_xform_prop->prog.insts) {
+        H5Z_xform_prog *prog = &data_xform_prop->prog;
+
+        if(array_type == H5T_NATIVE_CHAR)
+            H5Z_XFORM_DO_PROG(prog, char, char, array, array_size)
+#if CHAR_MIN >= 0
+        else if(array_type == H5T_NATIVE_SCHAR)
+            H5Z_XFORM_DO_PROG(prog, signed char, signed char, array, array_size)
+#else /* CHAR_MIN >= 0 */
+        else if(array_type == H5T_NATIVE_UCHAR)
+            H5Z_XFORM_DO_PROG(prog, unsigned char, unsigned char, array, array_size)
+#endif /* CHAR_MIN >= 0 */
+        else if(array_type == H5T_NATIVE_SHORT)
+            H5Z_XFORM_DO_PROG(prog, short, short, array, array_size)
+        else if(array_type == H5T_NATIVE_USHORT)
+            H5Z_XFORM_DO_PROG(prog, unsigned short, unsigned short, array, array_size)
+        else if(array_type == H5T_NATIVE_INT)
+            H5Z_XFORM_DO_PROG(prog, int, int, array, array_size)
+        else if(array_type == H5T_NATIVE_UINT)
+            H5Z_XFORM_DO_PROG(prog, unsigned int, long long, array, array_size)
+        else if(array_type == H5T_NATIVE_LONG)
+            H5Z_XFORM_DO_PROG(prog, long, long, array, array_size)
+        else if(array_type == H5T_NATIVE_ULONG)
+            H5Z_XFORM_DO_PROG(prog, unsigned long, unsigned long, array, array_size)
+        else if(array_type == H5T_NATIVE_LLONG)
+            H5Z_XFORM_DO_PROG(prog, long long, long long, array, array_size)
+        else if(array_type == H5T_NATIVE_ULLONG)
+            H5Z_XFORM_DO_PROG(prog, unsigned long long, unsigned long long, array, array_size)
+        else if(array_type == H5T_NATIVE_FLOAT)
+            H5Z_XFORM_DO_PROG(prog, float, float, array, array_size)
+        else if(array_type == H5T_NATIVE_DOUBLE)
+            H5Z_XFORM_DO_PROG(prog, double, double, array, array_size)
+#if H5_SIZEOF_LONG_DOUBLE !=0
+        else if(array_type == H5T_NATIVE_LDOUBLE)
+            H5Z_XFORM_DO_PROG(prog, long double, long double, array, array_size)
+#endif
     } /* end if */
     /* Otherwise, do the full data transform */
     else {
@@ -1516,6 +1710,159 @@ H5Z_do_op(H5Z_node* tree)
 }
 
 
+/*-------------------------------------------------------------------------
+ * Function:    H5Z_xform_compile_tree
+ * Purpose:     Appends the instructions for the subtree TREE to PROG in
+ *              postfix order.  DEPTH is the number of values already on
+ *              the stack when the subtree is evaluated.
+ * Return:      TRUE if the subtree could be compiled, FALSE if it has a
+ *              form the compiled evaluator doesn't handle (the parse
+ *              tree is then walked instead).
+ *-------------------------------------------------------------------------
+ */
+static hbool_t
+H5Z_xform_compile_tree(const H5Z_node *tree, H5Z_xform_prog *prog, unsigned depth)
+{
+    H5Z_xform_inst *inst;
+    hbool_t lsym, rsym;
+    hbool_t ret_value = FALSE;
+
+    FUNC_ENTER_NOAPI_NOINIT_NOERR
+
+    HDassert(tree);
+    HDassert(prog);
+
+    if(tree->type == H5Z_XFORM_SYMBOL) {
+        if(depth >= H5Z_XFORM_MAX_DEPTH)
+            HGOTO_DONE(FALSE)
+
+        inst = &prog->insts[prog->ninsts++];
+        inst->code = H5Z_XFORM_OP_LOAD;
+        inst->val = 0.0;
+        prog->nloads++;
+        HGOTO_DONE(TRUE)
+    } /* end if */
+
+    if(tree->type != H5Z_XFORM_PLUS && tree->type != H5Z_XFORM_MINUS &&
+            tree->type != H5Z_XFORM_MULT && tree->type != H5Z_XFORM_DIVIDE)
+        HGOTO_DONE(FALSE)
+    if(NULL == tree->rchild)
+        HGOTO_DONE(FALSE)
+
+    /* An operand that isn't a number depends on the data */
+    lsym = (hbool_t)(tree->lchild && tree->lchild->type != H5Z_XFORM_INTEGER && tree->lchild->type != H5Z_XFORM_FLOAT);
+    rsym = (hbool_t)(tree->rchild->type != H5Z_XFORM_INTEGER && tree->rchild->type != H5Z_XFORM_FLOAT);
+
+    if(lsym && rsym) {
+        if(!H5Z_xform_compile_tree(tree->lchild, prog, depth) || !H5Z_xform_compile_tree(tree->rchild, prog, depth + 1))
+            HGOTO_DONE(FALSE)
+
+        inst = &prog->insts[prog->ninsts++];
+        inst->val = 0.0;
+        if(tree->type == H5Z_XFORM_PLUS)
+            inst->code = H5Z_XFORM_OP_ADD;
+        else if(tree->type == H5Z_XFORM_MINUS)
+            inst->code = H5Z_XFORM_OP_SUB;
+        else if(tree->type == H5Z_XFORM_MULT)
+            inst->code = H5Z_XFORM_OP_MUL;
+        else
+            inst->code = H5Z_XFORM_OP_DIV;
+    } /* end if */
+    else if(lsym) {
+        if(!H5Z_xform_compile_tree(tree->lchild, prog, depth))
+            HGOTO_DONE(FALSE)
+
+        inst = &prog->insts[prog->ninsts++];
+        inst->val = (tree->rchild->type == H5Z_XFORM_INTEGER ? (double)tree->rchild->value.int_val : tree->rchild->value.float_val);
+        if(tree->type == H5Z_XFORM_PLUS)
+            inst->code = H5Z_XFORM_OP_ADD_CONST;
+        else if(tree->type == H5Z_XFORM_MINUS)
+            inst->code = H5Z_XFORM_OP_SUB_CONST;
+        else if(tree->type == H5Z_XFORM_MULT)
+            inst->code = H5Z_XFORM_OP_MUL_CONST;
+        else
+            inst->code = H5Z_XFORM_OP_DIV_CONST;
+    } /* end if */
+    else if(rsym) {
+        if(!H5Z_xform_compile_tree(tree->rchild, prog, depth))
+            HGOTO_DONE(FALSE)
+
+        /* A missing left operand (-x or +x) counts as zero, like in
+         * H5Z_XFORM_DO_OP1.  Addition and multiplication commute, so they
+         * share the instructions with the constant on the right.
+         */
+        inst = &prog->insts[prog->ninsts++];
+        if(NULL == tree->lchild)
+            inst->val = 0.0;
+        else
+            inst->val = (tree->lchild->type == H5Z_XFORM_INTEGER ? (double)tree->lchild->value.int_val : tree->lchild->value.float_val);
+        if(tree->type == H5Z_XFORM_PLUS)
+            inst->code = H5Z_XFORM_OP_ADD_CONST;
+        else if(tree->type == H5Z_XFORM_MINUS)
+            inst->code = H5Z_XFORM_OP_CONST_SUB;
+        else if(tree->type == H5Z_XFORM_MULT)
+            inst->code = H5Z_XFORM_OP_MUL_CONST;
+        else
+            inst->code = H5Z_XFORM_OP_CONST_DIV;
+    } /* end if */
+    else
+        HGOTO_DONE(FALSE)
+
+    ret_value = TRUE;
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5Z_xform_compile_tree() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:    H5Z_xform_compile
+ * Purpose:     Compiles the parse tree of a data transform into a flat list
+ *              of instructions that H5Z_xform_eval runs a block of elements
+ *              at a time.  Trivial transforms (no "x") and trees that can't
+ *              be compiled are left with no instructions.
+ * Return:      SUCCEED/FAIL
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+H5Z_xform_compile(H5Z_data_xform_t *data_xform_prop)
+{
+    H5Z_xform_prog *prog;
+    herr_t ret_value = SUCCEED;
+
+    FUNC_ENTER_NOAPI_NOINIT
+
+    HDassert(data_xform_prop);
+    HDassert(data_xform_prop->parse_root);
+    HDassert(data_xform_prop->xform_exp);
+
+    prog = &data_xform_prop->prog;
+    HDassert(NULL == prog->insts);
+
+    if(data_xform_prop->parse_root->type == H5Z_XFORM_INTEGER || data_xform_prop->parse_root->type == H5Z_XFORM_FLOAT)
+        HGOTO_DONE(SUCCEED)
+
+    /* Every instruction comes from an operator or a symbol in the
+     * expression, so its length bounds the number of instructions.
+     */
+    if(NULL == (prog->insts = (H5Z_xform_inst *)H5MM_malloc(HDstrlen(data_xform_prop->xform_exp) * sizeof(H5Z_xform_inst))))
+        HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "unable to allocate memory for compiled data transform")
+    prog->ninsts = 0;
+    prog->nloads = 0;
+
+    if(!H5Z_xform_compile_tree(data_xform_prop->parse_root, prog, 0)) {
+        prog->insts = (H5Z_xform_inst *)H5MM_xfree(prog->insts);
+        prog->ninsts = 0;
+        prog->nloads = 0;
+    } /* end if */
+    else
+        HDassert(prog->ninsts <= HDstrlen(data_xform_prop->xform_exp));
+
+done:
+    FUNC_LEAVE_NOAPI(ret_value)
+} /* end H5Z_xform_compile() */
+
+
 /*-------------------------------------------------------------------------
  * Function: H5D_xform_create
  *
@@ -1583,6 +1930,10 @@ H5Z_xform_create(const char *expr)
     if(count != data_xform_prop->dat_val_pointers->num_ptrs)
          HGOTO_ERROR(H5E_ARGS, H5E_BADTYPE, NULL, "error copying the parse tree, did not find correct number of \"variables\"")
 
+    /* Compile the parse tree for evaluation */
+    if(H5Z_xform_compile(data_xform_prop) < 0)
+        HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, NULL, "unable to compile data transform")
+
     /* Assign return value */
     ret_value=data_xform_prop;
 
@@ -1593,6 +1944,8 @@ done:
         if(data_xform_prop) {
             if(data_xform_prop->parse_root)
                 H5Z_xform_destroy_parse_tree(data_xform_prop->parse_root);
+            if(data_xform_prop->prog.insts)
+                H5MM_xfree(data_xform_prop->prog.insts);
             if(data_xform_prop->xform_exp)
                 H5MM_xfree(data_xform_prop->xform_exp);
 	    if(count > 0 && data_xform_prop->dat_val_pointers->ptr_dat_val)
@@ -1635,6 +1988,10 @@ H5Z_xform_destroy(H5Z_data_xform_t *data_xform_prop)
 	/* Destroy the parse tree */
         H5Z_xform_destroy_parse_tree(data_xform_prop->parse_root);
 
+        /* Free the compiled transform */
+        if(data_xform_prop->prog.insts)
+            H5MM_xfree(data_xform_prop->prog.insts);
+
         /* Free the expression */
         H5MM_xfree(data_xform_prop->xform_exp);
 
@@ -1715,6 +2072,10 @@ H5Z_xform_copy(H5Z_data_xform_t **data_xform_prop)
 	if(count != new_data_xform_prop->dat_val_pointers->num_ptrs)
             HGOTO_ERROR(H5E_ARGS, H5E_BADTYPE, FAIL, "error copying the parse tree, did not find correct number of \"variables\"")
 
+        /* Compile the copied parse tree */
+        if(H5Z_xform_compile(new_data_xform_prop) < 0)
+            HGOTO_ERROR(H5E_RESOURCE, H5E_NOSPACE, FAIL, "unable to compile data transform")
+
         /* Copy new information on top of old information */
         *data_xform_prop=new_data_xform_prop;
     } /* end if */
@@ -1725,6 +2086,8 @@ done:
         if(new_data_xform_prop) {
             if(new_data_xform_prop->parse_root)
                 H5Z_xform_destroy_parse_tree(new_data_xform_prop->parse_root);
+            if(new_data_xform_prop->prog.insts)
+                H5MM_xfree(new_data_xform_prop->prog.insts);
             if(new_data_xform_prop->xform_exp)
                 H5MM_xfree(new_data_xform_prop->xform_exp);
             H5MM_xfree(new_data_xform_prop);
@@ -32,6 +32,15 @@
 /***********/
 #include "H5private.h"		/* Generic Functions			*/
 
+/* Sum fletcher32 checksums with SSE2 vectors on x86-64, and AVX2 vectors
+ * when the CPU has them (checked at run time).  Define
+ * H5_CHECKSUM_NO_SIMD to use only the portable loop. */
+#if defined(__x86_64__) && defined(__GNUC__) && (__GNUC__ >= 5 || defined(__clang__)) \
+        && !defined(H5_CHECKSUM_NO_SIMD)
+#define H5_CHECKSUM_SIMD
+#include <immintrin.h>
+#endif /* __x86_64__ */
+
 
 /****************/
 /* Local Macros */
@@ -41,6 +50,16 @@
 /* (same as the IEEE 802.3 (Ethernet) quotient) */
 #define H5_CRC_QUOTIENT 0x04C11DB7
 
+/* Number of vectors of words summed for fletcher32 between reductions of
+ * the per-lane sums (small enough that they can't overflow 32 bits) */
+#define H5_FLETCHER32_NVEC      256
+
+/* Read 4 bytes as a little-endian integer (compilers turn this into a
+ * single load on little-endian machines) */
+#define H5_LOAD_LE32(p)                                                     \
+    ((uint32_t)(p)[0] | ((uint32_t)(p)[1] << 8) |                           \
+     ((uint32_t)(p)[2] << 16) | ((uint32_t)(p)[3] << 24))
+
 
 /******************/
 /* Local Typedefs */
@@ -56,6 +75,15 @@
 /* Local Prototypes */
 /********************/
 
+#ifdef H5_CHECKSUM_SIMD
+static size_t H5_checksum_fletcher32_sse2(const uint8_t *data, size_t nwords,
+    uint32_t *sum1, uint32_t *sum2);
+static size_t H5_checksum_fletcher32_avx2(const uint8_t *data, size_t nwords,
+    uint32_t *sum1, uint32_t *sum2) __attribute__((target("avx2")));
+static void H5_checksum_fletcher32_merge(uint32_t *sum1, uint32_t *sum2,
+    const uint32_t *s1v, const uint32_t *s2v, unsigned nlanes, size_t nwords);
+#endif /* H5_CHECKSUM_SIMD */
+
 
 /*********************/
 /* Package Variables */
@@ -71,8 +99,10 @@
 /* Local Variables */
 /*******************/
 
-/* Table of CRCs of all 8-bit messages. */
-static uint32_t H5_crc_table[256];
+/* Tables of CRCs for checksumming 8 bytes at a time: H5_crc_table[0] is the
+ * table of CRCs of all 8-bit messages, and H5_crc_table[k][n] is the CRC of
+ * byte n followed by k zero bytes. */
+static uint32_t H5_crc_table[8][256];
 
 /* Flag: has the table been computed? */
 static hbool_t H5_crc_table_computed = FALSE;
@@ -119,6 +149,20 @@ H5_checksum_fletcher32(const void *_data, size_t _len)
     HDassert(_data);
     HDassert(_len > 0);
 
+#ifdef H5_CHECKSUM_SIMD
+    /* Sum as many words as possible with vectors */
+    {
+        size_t nvec;            /* Number of words summed */
+
+        if(__builtin_cpu_supports("avx2"))
+            nvec = H5_checksum_fletcher32_avx2(data, len, &sum1, &sum2);
+        else
+            nvec = H5_checksum_fletcher32_sse2(data, len, &sum1, &sum2);
+        data += 2 * nvec;
+        len -= nvec;
+    }
+#endif /* H5_CHECKSUM_SIMD */
+
     /* Compute checksum for pairs of bytes */
     /* (the magic "360" value is is the largest number of sums that can be
      *  performed without numeric overflow)
@@ -150,6 +194,174 @@ H5_checksum_fletcher32(const void *_data, size_t _len)
     FUNC_LEAVE_NOAPI((sum2 << 16) | sum1)
 } /* end H5_checksum_fletcher32() */
 
+#ifdef H5_CHECKSUM_SIMD
+
+/*-------------------------------------------------------------------------
+ * Function:	H5_checksum_fletcher32_merge
+ *
+ * Purpose:	Add the sums of NWORDS words, kept in NLANES lanes, into the
+ *              running fletcher32 sums SUM1 and SUM2.
+ *
+ *              Lane J of S1V holds the sum of the words at positions J,
+ *              J + NLANES, J + 2 * NLANES, ..., and lane J of S2V the sum
+ *              of the partial sums of lane J before each word was added.
+ *              The first sum of the words is then the sum of S1V, and the
+ *              second sum, in which each word counts once for itself and
+ *              each word after it, is the sum of
+ *              NLANES * S2V[J] + (NLANES - J) * S1V[J].
+ *
+ *              The running sums are kept as the fletcher32 loop keeps them:
+ *              congruent to the exact sums modulo 65535, and zero only
+ *              when the exact sums are.  As the final value only depends
+ *              on that, this gives the same checksum as the loop.
+ *
+ * Return:	void
+ *
+ *-------------------------------------------------------------------------
+ */
+static void
+H5_checksum_fletcher32_merge(uint32_t *sum1, uint32_t *sum2,
+    const uint32_t *s1v, const uint32_t *s2v, unsigned nlanes, size_t nwords)
+{
+    uint64_t b1 = 0, b2 = 0;    /* Sums of these words */
+    uint64_t r1, r2;            /* Running sums */
+    unsigned u;                 /* Local index variable */
+
+    FUNC_ENTER_NOAPI_NOINIT_NOERR
+
+    for(u = 0; u < nlanes; u++) {
+        b1 += s1v[u];
+        b2 += ((uint64_t)nlanes * s2v[u]) + ((uint64_t)(nlanes - u) * s1v[u]);
+    } /* end for */
+
+    /* Each word so far counts once more in the second sum for each of
+     * these words */
+    r1 = *sum1;
+    r2 = ((*sum2 % 65535) + (((uint64_t)(nwords % 65535) * (r1 % 65535)) % 65535) + (b2 % 65535)) % 65535;
+    r1 = ((r1 % 65535) + (b1 % 65535)) % 65535;
+
+    /* Any non-zero word makes both sums non-zero */
+    if(*sum1 != 0 || b1 != 0) {
+        *sum1 = r1 ? (uint32_t)r1 : 65535;
+        *sum2 = r2 ? (uint32_t)r2 : 65535;
+    } /* end if */
+
+    FUNC_LEAVE_NOAPI_VOID
+} /* end H5_checksum_fletcher32_merge() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5_checksum_fletcher32_sse2
+ *
+ * Purpose:	Add as many words from DATA to the running fletcher32 sums
+ *              as fill vectors of 8 words, using SSE2.  Each vector of
+ *              big-endian words is byte-swapped and widened to two vectors
+ *              of 32-bit lanes, which accumulate the sums of
+ *              H5_checksum_fletcher32_merge().
+ *
+ * Return:	Number of words summed
+ *
+ *-------------------------------------------------------------------------
+ */
+static size_t
+H5_checksum_fletcher32_sse2(const uint8_t *data, size_t nwords, uint32_t *sum1,
+    uint32_t *sum2)
+{
+    const __m128i zero = _mm_setzero_si128();
+    size_t nvec = nwords / 8;   /* Number of vectors to sum */
+    size_t n;                   /* Number of vectors in this pass */
+    size_t u;                   /* Local index variable */
+    uint32_t s1v[8], s2v[8];    /* Lane sums */
+
+    FUNC_ENTER_NOAPI_NOINIT_NOERR
+
+    while(nvec > 0) {
+        __m128i s1lo = zero, s1hi = zero, s2lo = zero, s2hi = zero;
+
+        n = MIN(nvec, H5_FLETCHER32_NVEC);
+        for(u = 0; u < n; u++, data += 16) {
+            __m128i v = _mm_loadu_si128((const __m128i *)data);
+
+            v = _mm_or_si128(_mm_slli_epi16(v, 8), _mm_srli_epi16(v, 8));
+            s2lo = _mm_add_epi32(s2lo, s1lo);
+            s2hi = _mm_add_epi32(s2hi, s1hi);
+            s1lo = _mm_add_epi32(s1lo, _mm_unpacklo_epi16(v, zero));
+            s1hi = _mm_add_epi32(s1hi, _mm_unpackhi_epi16(v, zero));
+        } /* end for */
+
+        _mm_storeu_si128((__m128i *)&s1v[0], s1lo);
+        _mm_storeu_si128((__m128i *)&s1v[4], s1hi);
+        _mm_storeu_si128((__m128i *)&s2v[0], s2lo);
+        _mm_storeu_si128((__m128i *)&s2v[4], s2hi);
+        H5_checksum_fletcher32_merge(sum1, sum2, s1v, s2v, 8, n * 8);
+        nvec -= n;
+    } /* end while */
+
+    FUNC_LEAVE_NOAPI(nwords & ~(size_t)7)
+} /* end H5_checksum_fletcher32_sse2() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:	H5_checksum_fletcher32_avx2
+ *
+ * Purpose:	Like H5_checksum_fletcher32_sse2(), with vectors of 16 words
+ *              using AVX2.  The AVX2 unpack instructions work on each
+ *              128-bit half separately, so the lanes are put back in word
+ *              order before they are merged.
+ *
+ * Return:	Number of words summed
+ *
+ *-------------------------------------------------------------------------
+ */
+static size_t
+H5_checksum_fletcher32_avx2(const uint8_t *data, size_t nwords, uint32_t *sum1,
+    uint32_t *sum2)
+{
+    const __m256i zero = _mm256_setzero_si256();
+    size_t nvec = nwords / 16;  /* Number of vectors to sum */
+    size_t n;                   /* Number of vectors in this pass */
+    size_t u;                   /* Local index variable */
+    uint32_t lo[8], hi[8];      /* Lanes as stored */
+    uint32_t s1v[16], s2v[16];  /* Lane sums, in word order */
+
+    FUNC_ENTER_NOAPI_NOINIT_NOERR
+
+    while(nvec > 0) {
+        __m256i s1lo = zero, s1hi = zero, s2lo = zero, s2hi = zero;
+
+        n = MIN(nvec, H5_FLETCHER32_NVEC);
+        for(u = 0; u < n; u++, data += 32) {
+            __m256i v = _mm256_loadu_si256((const __m256i *)data);
+
+            v = _mm256_or_si256(_mm256_slli_epi16(v, 8), _mm256_srli_epi16(v, 8));
+            s2lo = _mm256_add_epi32(s2lo, s1lo);
+            s2hi = _mm256_add_epi32(s2hi, s1hi);
+            s1lo = _mm256_add_epi32(s1lo, _mm256_unpacklo_epi16(v, zero));
+            s1hi = _mm256_add_epi32(s1hi, _mm256_unpackhi_epi16(v, zero));
+        } /* end for */
+
+        /* The low vectors hold words 0-3 and 8-11, the high ones 4-7 and
+         * 12-15 */
+        _mm256_storeu_si256((__m256i *)lo, s1lo);
+        _mm256_storeu_si256((__m256i *)hi, s1hi);
+        HDmemcpy(&s1v[0], &lo[0], 4 * sizeof(uint32_t));
+        HDmemcpy(&s1v[4], &hi[0], 4 * sizeof(uint32_t));
+        HDmemcpy(&s1v[8], &lo[4], 4 * sizeof(uint32_t));
+        HDmemcpy(&s1v[12], &hi[4], 4 * sizeof(uint32_t));
+        _mm256_storeu_si256((__m256i *)lo, s2lo);
+        _mm256_storeu_si256((__m256i *)hi, s2hi);
+        HDmemcpy(&s2v[0], &lo[0], 4 * sizeof(uint32_t));
+        HDmemcpy(&s2v[4], &hi[0], 4 * sizeof(uint32_t));
+        HDmemcpy(&s2v[8], &lo[4], 4 * sizeof(uint32_t));
+        HDmemcpy(&s2v[12], &hi[4], 4 * sizeof(uint32_t));
+        H5_checksum_fletcher32_merge(sum1, sum2, s1v, s2v, 16, n * 16);
+        nvec -= n;
+    } /* end while */
+
+    FUNC_LEAVE_NOAPI(nwords & ~(size_t)15)
+} /* end H5_checksum_fletcher32_avx2() */
+#endif /* H5_CHECKSUM_SIMD */
+
 
 /*-------------------------------------------------------------------------
  * Function:	H5_checksum_crc_make_table
@@ -179,8 +391,13 @@ H5_checksum_crc_make_table(void)
                 c = H5_CRC_QUOTIENT ^ (c >> 1);
             else
                 c = c >> 1;
-        H5_crc_table[n] = c;
+        H5_crc_table[0][n] = c;
     }
+
+    /* Extend each of them with zero bytes */
+    for(n = 0; n < 256; n++)
+        for(k = 1; k < 8; k++)
+            H5_crc_table[k][n] = (H5_crc_table[k - 1][n] >> 8) ^ H5_crc_table[0][H5_crc_table[k - 1][n] & 0xff];
     H5_crc_table_computed = TRUE;
 
     FUNC_LEAVE_NOAPI_VOID
@@ -213,9 +430,17 @@ H5_checksum_crc_update(uint32_t crc, const uint8_t *buf, size_t len)
     if(!H5_crc_table_computed)
         H5_checksum_crc_make_table();
 
-    /* Update the CRC with the results from this buffer */
+    /* Update the CRC 8 bytes at a time ("slicing by 8"), then a byte at a
+     * time for the rest */
+    for(; len >= 8; len -= 8, buf += 8) {
+        crc ^= H5_LOAD_LE32(buf);
+        crc = H5_crc_table[7][crc & 0xff] ^ H5_crc_table[6][(crc >> 8) & 0xff] ^
+                H5_crc_table[5][(crc >> 16) & 0xff] ^ H5_crc_table[4][crc >> 24] ^
+                H5_crc_table[3][buf[4]] ^ H5_crc_table[2][buf[5]] ^
+                H5_crc_table[1][buf[6]] ^ H5_crc_table[0][buf[7]];
+    } /* end for */
     for(n = 0; n < len; n++)
-        crc = H5_crc_table[(crc ^ buf[n]) & 0xff] ^ (crc >> 8);
+        crc = H5_crc_table[0][(crc ^ buf[n]) & 0xff] ^ (crc >> 8);
 
     FUNC_LEAVE_NOAPI(crc)
 } /* end H5_checksum_crc_update() */
@@ -384,20 +609,13 @@ H5_checksum_lookup3(const void *key, size_t length, uint32_t initval)
     a = b = c = 0xdeadbeef + ((uint32_t)length) + initval;
 
     /*--------------- all but the last block: affect some 32 bits of (a,b,c) */
+    /* (the bytes of each word are read together, which adds the same value
+     *  as adding each byte shifted into place) */
     while (length > 12)
     {
-      a += k[0];
-      a += ((uint32_t)k[1])<<8;
-      a += ((uint32_t)k[2])<<16;
-      a += ((uint32_t)k[3])<<24;
-      b += k[4];
-      b += ((uint32_t)k[5])<<8;
-      b += ((uint32_t)k[6])<<16;
-      b += ((uint32_t)k[7])<<24;
-      c += k[8];
-      c += ((uint32_t)k[9])<<8;
-      c += ((uint32_t)k[10])<<16;
-      c += ((uint32_t)k[11])<<24;
+      a += H5_LOAD_LE32(k);
+      b += H5_LOAD_LE32(k + 4);
+      c += H5_LOAD_LE32(k + 8);
       H5_lookup3_mix(a, b, c);
       length -= 12;
       k += 12;
@@ -660,6 +660,36 @@ H5_trace(const double *returning, const char *func, const char *type, ...)
                         } /* end else */
                         break;
 
+                    case 'p':
+                        if(ptr) {
+                            if(vp)
+                               HDfprintf(out, "0x%lx", (unsigned long)vp);
+                            else
+                               HDfprintf(out, "NULL");
+                        } /* end if */
+                        else {
+                            H5D_chunk_cache_policy_t policy = (H5D_chunk_cache_policy_t)HDva_arg(ap, int);
+
+                            switch(policy) {
+                                case H5D_CHUNK_CACHE_POLICY_ERROR:
+                                   HDfprintf(out, "H5D_CHUNK_CACHE_POLICY_ERROR");
+                                    break;
+
+                                case H5D_CHUNK_CACHE_POLICY_LRU:
+                                   HDfprintf(out, "H5D_CHUNK_CACHE_POLICY_LRU");
+                                    break;
+
+                                case H5D_CHUNK_CACHE_POLICY_2Q:
+                                   HDfprintf(out, "H5D_CHUNK_CACHE_POLICY_2Q");
+                                    break;
+
+                                default:
+                                   HDfprintf(out, "%ld", (long)policy);
+                                    break;
+                            } /* end switch */
+                        } /* end else */
+                        break;
+
                     case 's':
                         if(ptr) {
                             if(vp)
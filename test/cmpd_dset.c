@@ -29,6 +29,7 @@ const char *FILENAME[] = {
     "cmpd_dset",
     "src_subset",
     "dst_subset",
+    "copy_plan",
     NULL
 };
 
@@ -120,9 +121,19 @@ typedef struct {
     long long r, s, t;
 } stype4;
 
+/* Some members of a large compound, for test_hdf5_copy_plan() */
+typedef struct plan_t {
+    int f30;
+    int f07;
+    int f08;
+    int extra;
+} plan_t;
+
 #define NX    100u
 #define NY    2000u
 #define PACK_NMEMBS     100
+#define PLAN_NMEMBS     40
+#define PLAN_NELMTS     1000
 
 
 /*-------------------------------------------------------------------------
@@ -1782,6 +1793,153 @@ error:
 }
 
 
+/*-------------------------------------------------------------------------
+ * Function:    test_hdf5_copy_plan
+ *
+ * Purpose:    Test reading and converting a few members of a large
+ *              compound type, in a different order and alongside a member
+ *              that isn't in the file, when no member needs converting.
+ *              The conversion copies runs of adjacent members instead of
+ *              converting each member (the "copy plan"), and must still
+ *              leave the extra member as it was.
+ *
+ * Return:    Success:    0
+ *
+ *        Failure:    1
+ *
+ *-------------------------------------------------------------------------
+ */
+static unsigned
+test_hdf5_copy_plan(char *filename, hid_t fapl)
+{
+    hid_t   file = -1;
+    hid_t   src_tid = -1, dst_tid = -1;
+    hid_t   dataset = -1;
+    hid_t   space = -1;
+    hsize_t dims[1] = {PLAN_NELMTS};
+    H5T_path_t *tpath;
+    H5T_subset_info_t *subset;
+    int     *orig = NULL;
+    plan_t  *rbuf = NULL;
+    void    *bkg = NULL;
+    char    name[8];
+    size_t  u;
+
+    TESTING("reading members picked out of a large compound");
+
+    /* Build the file type: PLAN_NMEMBS packed ints */
+    if((src_tid = H5Tcreate(H5T_COMPOUND, PLAN_NMEMBS * sizeof(int))) < 0)
+        TEST_ERROR
+    for(u = 0; u < PLAN_NMEMBS; u++) {
+        HDsnprintf(name, sizeof(name), "f%02u", (unsigned)u);
+        if(H5Tinsert(src_tid, name, u * sizeof(int), H5T_NATIVE_INT) < 0)
+            TEST_ERROR
+    } /* end for */
+
+    /* Build the memory type */
+    if((dst_tid = H5Tcreate(H5T_COMPOUND, sizeof(plan_t))) < 0)
+        TEST_ERROR
+    if(H5Tinsert(dst_tid, "f30", HOFFSET(plan_t, f30), H5T_NATIVE_INT) < 0)
+        TEST_ERROR
+    if(H5Tinsert(dst_tid, "f07", HOFFSET(plan_t, f07), H5T_NATIVE_INT) < 0)
+        TEST_ERROR
+    if(H5Tinsert(dst_tid, "f08", HOFFSET(plan_t, f08), H5T_NATIVE_INT) < 0)
+        TEST_ERROR
+    if(H5Tinsert(dst_tid, "extra", HOFFSET(plan_t, extra), H5T_NATIVE_INT) < 0)
+        TEST_ERROR
+
+    /* The conversion should copy two runs: f07 and f08 together, and f30 */
+    if(NULL == (tpath = H5T_path_find((H5T_t *)H5I_object(src_tid), (H5T_t *)H5I_object(dst_tid))))
+        TEST_ERROR
+    if(NULL == (subset = H5T_path_compound_subset(tpath)))
+        TEST_ERROR
+    if(subset->subset != H5T_SUBSET_PLAN || subset->ncopies != 2)
+        TEST_ERROR
+
+    if(NULL == (orig = (int *)HDmalloc(PLAN_NELMTS * PLAN_NMEMBS * sizeof(int))))
+        TEST_ERROR
+    if(NULL == (rbuf = (plan_t *)HDmalloc(PLAN_NELMTS * sizeof(plan_t))))
+        TEST_ERROR
+    if(NULL == (bkg = HDmalloc(PLAN_NELMTS * sizeof(plan_t))))
+        TEST_ERROR
+    for(u = 0; u < PLAN_NELMTS * PLAN_NMEMBS; u++)
+        orig[u] = (int)u;
+
+    /* Write the data and read it back into the memory type */
+    if((file = H5Fcreate(filename, H5F_ACC_TRUNC, H5P_DEFAULT, fapl)) < 0)
+        FAIL_STACK_ERROR
+    if((space = H5Screate_simple(1, dims, NULL)) < 0)
+        FAIL_STACK_ERROR
+    if((dataset = H5Dcreate2(file, "plan", src_tid, space, H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT)) < 0)
+        FAIL_STACK_ERROR
+    if(H5Dwrite(dataset, src_tid, H5S_ALL, H5S_ALL, H5P_DEFAULT, orig) < 0)
+        FAIL_STACK_ERROR
+
+    for(u = 0; u < PLAN_NELMTS; u++)
+        rbuf[u].extra = -(int)u;
+    if(H5Dread(dataset, dst_tid, H5S_ALL, H5S_ALL, H5P_DEFAULT, rbuf) < 0)
+        FAIL_STACK_ERROR
+    for(u = 0; u < PLAN_NELMTS; u++)
+        if(rbuf[u].f30 != orig[u * PLAN_NMEMBS + 30] || rbuf[u].f07 != orig[u * PLAN_NMEMBS + 7] ||
+                rbuf[u].f08 != orig[u * PLAN_NMEMBS + 8] || rbuf[u].extra != -(int)u) {
+            H5_FAILED();
+            HDprintf("    H5Dread element %u is wrong\n", (unsigned)u);
+            goto error;
+        } /* end if */
+
+    /* Convert in place with H5Tconvert, keeping "extra" from the background */
+    for(u = 0; u < PLAN_NELMTS; u++)
+        ((plan_t *)bkg)[u].extra = (int)u;
+    if(H5Tconvert(src_tid, dst_tid, (size_t)PLAN_NELMTS, orig, bkg, H5P_DEFAULT) < 0)
+        FAIL_STACK_ERROR
+    for(u = 0; u < PLAN_NELMTS; u++) {
+        const plan_t *p = (const plan_t *)orig + u;
+
+        if(p->f30 != (int)(u * PLAN_NMEMBS + 30) || p->f07 != (int)(u * PLAN_NMEMBS + 7) ||
+                p->f08 != (int)(u * PLAN_NMEMBS + 8) || p->extra != (int)u) {
+            H5_FAILED();
+            HDprintf("    H5Tconvert element %u is wrong\n", (unsigned)u);
+            goto error;
+        } /* end if */
+    } /* end for */
+
+    if(H5Dclose(dataset) < 0)
+        FAIL_STACK_ERROR
+    if(H5Sclose(space) < 0)
+        FAIL_STACK_ERROR
+    if(H5Tclose(src_tid) < 0)
+        FAIL_STACK_ERROR
+    if(H5Tclose(dst_tid) < 0)
+        FAIL_STACK_ERROR
+    if(H5Fclose(file) < 0)
+        FAIL_STACK_ERROR
+
+    HDfree(orig);
+    HDfree(rbuf);
+    HDfree(bkg);
+
+    PASSED();
+    return 0;
+
+error:
+    H5E_BEGIN_TRY {
+        H5Dclose(dataset);
+        H5Sclose(space);
+        H5Tclose(src_tid);
+        H5Tclose(dst_tid);
+        H5Fclose(file);
+    } H5E_END_TRY
+    if(orig)
+        HDfree(orig);
+    if(rbuf)
+        HDfree(rbuf);
+    if(bkg)
+        HDfree(bkg);
+    HDputs("*** DATASET TESTS FAILED ***");
+    return 1;
+} /* test_hdf5_copy_plan */
+
+
 /*-------------------------------------------------------------------------
  * Function:    test_pack_ooo
  *
@@ -2238,6 +2396,10 @@ main (int argc, char *argv[])
     h5_fixname(FILENAME[2], fapl_id, fname, sizeof(fname));
     nerrors += test_hdf5_dst_subset(fname, fapl_id);
 
+    HDputs("Testing the copy plan for members picked or moved without conversion:");
+    h5_fixname(FILENAME[3], fapl_id, fname, sizeof(fname));
+    nerrors += test_hdf5_copy_plan(fname, fapl_id);
+
     HDputs("Testing that compound types can be packed out of order:");
     nerrors += test_pack_ooo();
 
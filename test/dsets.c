@@ -83,6 +83,24 @@ const char *FILENAME[] = {
     "dls_01_strings",   /* 23 */
     "power2up",         /* 24 */
     "version_bounds",   /* 25 */
+    "chunk_decode",     /* 26 */
+    "chunk_encode",     /* 27 */
+    "chunk_readahead",  /* 28 */
+    "chunk_policy",     /* 29 */
+    "chunk_budget",     /* 30 */
+    "chunk_stats",      /* 31 */
+    "chunk_addr_table", /* 32 */
+    "chunk_coalesce",   /* 33 */
+    "chunk_buf_pool",   /* 34 */
+    "chunk_sel_points", /* 35 */
+    "shuffle_simd",     /* 36 */
+    "bitshuffle",       /* 37 */
+    "lz4",              /* 38 */
+    "deflate_nthreads", /* 39 */
+    "deflate_decode",   /* 40 */
+    "chunk_filter_mode", /* 41 */
+    "chunk_sel_hyper",  /* 42 */
+    "bitshuffle_lz4",   /* 43 */
     NULL
 };
 
@@ -136,12 +154,16 @@ const char *FILENAME[] = {
 #define DSET_NBIT_COMPOUND_NAME_3      "nbit_compound_3"
 #define DSET_NBIT_INT_SIZE_NAME        "nbit_int_size"
 #define DSET_NBIT_FLT_SIZE_NAME        "nbit_flt_size"
+#define DSET_NBIT_PACKED_NAME          "nbit_packed"
+#define NBIT_PACKED_NELMTS             1001
 #define DSET_SCALEOFFSET_INT_NAME      "scaleoffset_int"
 #define DSET_SCALEOFFSET_INT_NAME_2    "scaleoffset_int_2"
 #define DSET_SCALEOFFSET_FLOAT_NAME    "scaleoffset_float"
 #define DSET_SCALEOFFSET_FLOAT_NAME_2  "scaleoffset_float_2"
 #define DSET_SCALEOFFSET_DOUBLE_NAME   "scaleoffset_double"
 #define DSET_SCALEOFFSET_DOUBLE_NAME_2 "scaleoffset_double_2"
+#define DSET_SCALEOFFSET_PACKED_NAME   "scaleoffset_packed"
+#define SCALEOFFSET_PACKED_NELMTS      1003
 #define DSET_COMPARE_DCPL_NAME         "compare_dcpl"
 #define DSET_COMPARE_DCPL_NAME_2       "compare_dcpl_2"
 #define DSET_COPY_DCPL_NAME_1          "copy_dcpl_1"
@@ -4541,6 +4563,151 @@ error:
     return FAIL;
 } /* end test_nbit_flt_size() */
 
+/*-------------------------------------------------------------------------
+ * Function:    test_nbit_packed
+ *
+ * Purpose:     Tests that the packed bytes written by the nbit filter for
+ *              atomic integer types are the significant bits of each
+ *              element laid end to end, most significant bit first.  The
+ *              raw chunk is compared with a bit-by-bit reference packing
+ *              for several sizes, precisions, offsets and byte orders.
+ *
+ * Return:      Success:        0
+ *              Failure:        -1
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+test_nbit_packed(hid_t file)
+{
+    struct {
+        hid_t       base;           /* File datatype to derive from */
+        size_t      precision;      /* Significant bits */
+        size_t      offset;         /* Bit offset of the significant bits */
+        H5T_order_t order;          /* File byte order */
+    } cases[] = {
+        {H5T_NATIVE_UCHAR,  5,  1,  H5T_ORDER_LE},
+        {H5T_NATIVE_USHORT, 12, 2,  H5T_ORDER_LE},
+        {H5T_NATIVE_USHORT, 10, 6,  H5T_ORDER_BE},
+        {H5T_NATIVE_UINT,   24, 0,  H5T_ORDER_BE},
+        {H5T_NATIVE_UINT,   14, 11, H5T_ORDER_LE},
+        {H5T_NATIVE_ULLONG, 32, 17, H5T_ORDER_BE},
+        {H5T_NATIVE_ULLONG, 40, 3,  H5T_ORDER_LE}   /* Too wide for the fast path */
+    };
+    hid_t               dataset = -1, datatype = -1, space = -1, dc = -1;
+    hsize_t             size[1] = {NBIT_PACKED_NELMTS};
+    hsize_t             chunk_offset[1] = {0};
+    hsize_t             chunk_nbytes;
+    unsigned long long  *orig = NULL, *new_data = NULL;
+    unsigned char       *expect = NULL, *raw = NULL;
+    uint32_t            filter_mask;
+    char                name[32];
+    size_t              c, i, b, pos;
+
+    TESTING("    nbit packed layout");
+
+    if(NULL == (orig = (unsigned long long *)HDmalloc(NBIT_PACKED_NELMTS * sizeof(unsigned long long))))
+        TEST_ERROR
+    if(NULL == (new_data = (unsigned long long *)HDmalloc(NBIT_PACKED_NELMTS * sizeof(unsigned long long))))
+        TEST_ERROR
+    if(NULL == (expect = (unsigned char *)HDmalloc(NBIT_PACKED_NELMTS * sizeof(unsigned long long) + 1)))
+        TEST_ERROR
+    if(NULL == (raw = (unsigned char *)HDmalloc(NBIT_PACKED_NELMTS * sizeof(unsigned long long) + 1)))
+        TEST_ERROR
+
+    if((space = H5Screate_simple(1, size, NULL)) < 0) TEST_ERROR
+    if((dc = H5Pcreate(H5P_DATASET_CREATE)) < 0) TEST_ERROR
+    if(H5Pset_chunk(dc, 1, size) < 0) TEST_ERROR
+    if(H5Pset_nbit(dc) < 0) TEST_ERROR
+
+    for(c = 0; c < sizeof(cases) / sizeof(cases[0]); c++) {
+        /* Derive the file datatype */
+        if((datatype = H5Tcopy(cases[c].base)) < 0) TEST_ERROR
+        if(H5Tset_precision(datatype, cases[c].precision) < 0) TEST_ERROR
+        if(H5Tset_offset(datatype, cases[c].offset) < 0) TEST_ERROR
+        if(H5Tset_order(datatype, cases[c].order) < 0) TEST_ERROR
+
+        /* Values that fit the precision, with the top bit exercised */
+        for(i = 0; i < NBIT_PACKED_NELMTS; i++)
+            orig[i] = ((unsigned long long)HDrandom() * 2654435761ULL + i) &
+                    ((1ULL << cases[c].precision) - 1);
+        orig[0] = (1ULL << cases[c].precision) - 1;
+
+        /* Reference packing, one bit at a time */
+        HDmemset(expect, 0, NBIT_PACKED_NELMTS * sizeof(unsigned long long) + 1);
+        pos = 0;
+        for(i = 0; i < NBIT_PACKED_NELMTS; i++)
+            for(b = cases[c].precision; b > 0; b--, pos++)
+                if((orig[i] >> (b - 1)) & 1)
+                    expect[pos / 8] |= (unsigned char)(0x80 >> (pos % 8));
+
+        HDsnprintf(name, sizeof(name), "%s_%u", DSET_NBIT_PACKED_NAME, (unsigned)c);
+        if((dataset = H5Dcreate2(file, name, datatype, space, H5P_DEFAULT, dc, H5P_DEFAULT)) < 0)
+            TEST_ERROR
+        if(H5Dwrite(dataset, H5T_NATIVE_ULLONG, H5S_ALL, H5S_ALL, H5P_DEFAULT, orig) < 0)
+            TEST_ERROR
+
+        /* The filter always stores one byte past the last complete byte */
+        if(H5Dget_chunk_storage_size(dataset, chunk_offset, &chunk_nbytes) < 0)
+            TEST_ERROR
+        if(chunk_nbytes != pos / 8 + 1) {
+            H5_FAILED();
+            HDprintf("    Case %u: stored %llu bytes, expected %llu\n", (unsigned)c,
+                     (unsigned long long)chunk_nbytes, (unsigned long long)(pos / 8 + 1));
+            goto error;
+        } /* end if */
+        if(H5Dread_chunk(dataset, H5P_DEFAULT, chunk_offset, &filter_mask, raw) < 0)
+            TEST_ERROR
+        if(HDmemcmp(raw, expect, (size_t)chunk_nbytes) != 0) {
+            H5_FAILED();
+            HDprintf("    Case %u: packed bytes differ from the reference layout\n", (unsigned)c);
+            goto error;
+        } /* end if */
+
+        /* Read back through the filter */
+        HDmemset(new_data, 0, NBIT_PACKED_NELMTS * sizeof(unsigned long long));
+        if(H5Dread(dataset, H5T_NATIVE_ULLONG, H5S_ALL, H5S_ALL, H5P_DEFAULT, new_data) < 0)
+            TEST_ERROR
+        for(i = 0; i < NBIT_PACKED_NELMTS; i++)
+            if(new_data[i] != orig[i]) {
+                H5_FAILED();
+                HDprintf("    Case %u: read different values than written at index %lu\n",
+                         (unsigned)c, (unsigned long)i);
+                goto error;
+            } /* end if */
+
+        if(H5Dclose(dataset) < 0) TEST_ERROR
+        dataset = -1;
+        if(H5Tclose(datatype) < 0) TEST_ERROR
+        datatype = -1;
+    } /* end for */
+
+    if(H5Pclose(dc) < 0) TEST_ERROR
+    if(H5Sclose(space) < 0) TEST_ERROR
+
+    HDfree(orig);
+    HDfree(new_data);
+    HDfree(expect);
+    HDfree(raw);
+
+    PASSED();
+
+    return SUCCEED;
+
+error:
+    H5E_BEGIN_TRY {
+        H5Dclose(dataset);
+        H5Tclose(datatype);
+        H5Pclose(dc);
+        H5Sclose(space);
+    } H5E_END_TRY;
+    HDfree(orig);
+    HDfree(new_data);
+    HDfree(expect);
+    HDfree(raw);
+
+    return FAIL;
+} /* end test_nbit_packed() */
+
 /*-------------------------------------------------------------------------
  * Function:    test_scaleoffset_int
  *
@@ -5265,6 +5432,206 @@ error:
     return FAIL;
 } /* end test_scaleoffset_double_2() */
 
+/*-------------------------------------------------------------------------
+ * Function:    test_scaleoffset_packed
+ *
+ * Purpose:     Tests the exact bytes written by the scale-offset filter.
+ *              For unsigned integers without a fill value, the chunk is a
+ *              21-byte header holding minbits and the minimum, followed
+ *              by each value minus the minimum in minbits bits, most
+ *              significant bit first.  Also checks that when a float
+ *              chunk's minimum is zero, the header keeps the sign of the
+ *              first zero in the data.
+ *
+ * Return:      Success:        0
+ *              Failure:        -1
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+test_scaleoffset_packed(hid_t file)
+{
+    struct {
+        hid_t       type;           /* Dataset and memory datatype */
+        unsigned    range_bits;     /* Values span up to this many bits */
+    } cases[] = {
+        {H5T_NATIVE_UCHAR,  5},
+        {H5T_NATIVE_USHORT, 12},
+        {H5T_NATIVE_UINT,   17},
+        {H5T_NATIVE_UINT,   31},
+        {H5T_NATIVE_ULLONG, 40}
+    };
+    hid_t               dataset = -1, space = -1, dc = -1;
+    hsize_t             size[1] = {SCALEOFFSET_PACKED_NELMTS};
+    hsize_t             chunk_offset[1] = {0};
+    hsize_t             chunk_nbytes;
+    unsigned long long  *orig = NULL, *new_data = NULL;
+    unsigned char       *expect = NULL, *raw = NULL;
+    unsigned char       *mem = NULL;
+    float               fdata[16], fnew[16];
+    unsigned long long  min, max;
+    unsigned            minbits;
+    uint32_t            filter_mask;
+    char                name[32];
+    size_t              c, i, b, pos, type_size, nbytes;
+
+    TESTING("    scaleoffset packed layout");
+
+    nbytes = SCALEOFFSET_PACKED_NELMTS * sizeof(unsigned long long);
+    if(NULL == (orig = (unsigned long long *)HDmalloc(nbytes))) TEST_ERROR
+    if(NULL == (new_data = (unsigned long long *)HDmalloc(nbytes))) TEST_ERROR
+    if(NULL == (mem = (unsigned char *)HDmalloc(nbytes))) TEST_ERROR
+    if(NULL == (expect = (unsigned char *)HDmalloc(nbytes + 32))) TEST_ERROR
+    if(NULL == (raw = (unsigned char *)HDmalloc(nbytes + 32))) TEST_ERROR
+
+    if((space = H5Screate_simple(1, size, NULL)) < 0) TEST_ERROR
+    if((dc = H5Pcreate(H5P_DATASET_CREATE)) < 0) TEST_ERROR
+    if(H5Pset_fill_value(dc, H5T_NATIVE_INT, NULL) < 0) TEST_ERROR
+    if(H5Pset_chunk(dc, 1, size) < 0) TEST_ERROR
+    if(H5Pset_scaleoffset(dc, H5Z_SO_INT, H5Z_SO_INT_MINBITS_DEFAULT) < 0) TEST_ERROR
+
+    for(c = 0; c < sizeof(cases) / sizeof(cases[0]); c++) {
+        type_size = H5Tget_size(cases[c].type);
+
+        /* Values offset from a minimum of 100 */
+        min = max = 100;
+        for(i = 0; i < SCALEOFFSET_PACKED_NELMTS; i++) {
+            orig[i] = 100 + ((((unsigned long long)HDrandom() << 31) ^ (unsigned long long)HDrandom()) &
+                    ((1ULL << cases[c].range_bits) - 1) & ~1ULL);
+            if(orig[i] > max)
+                max = orig[i];
+        } /* end for */
+        orig[SCALEOFFSET_PACKED_NELMTS / 2] = min;
+        for(i = 0; i < SCALEOFFSET_PACKED_NELMTS; i++)
+            switch(type_size) {
+                case 1: ((unsigned char *)mem)[i] = (unsigned char)orig[i]; break;
+                case 2: ((unsigned short *)mem)[i] = (unsigned short)orig[i]; break;
+                case 4: ((unsigned int *)mem)[i] = (unsigned int)orig[i]; break;
+                default: ((unsigned long long *)mem)[i] = orig[i]; break;
+            } /* end switch */
+
+        /* Number of bits needed for the span max - min + 1 */
+        for(minbits = 0; (1ULL << minbits) < max - min + 1; minbits++)
+            ;
+
+        /* Expected header, then the values packed one bit at a time */
+        HDmemset(expect, 0, nbytes + 32);
+        for(b = 0; b < 4; b++)
+            expect[b] = (unsigned char)(minbits >> (8 * b));
+        expect[4] = (unsigned char)sizeof(unsigned long long);
+        for(b = 0; b < 8; b++)
+            expect[5 + b] = (unsigned char)(min >> (8 * b));
+        pos = 0;
+        for(i = 0; i < SCALEOFFSET_PACKED_NELMTS; i++)
+            for(b = minbits; b > 0; b--, pos++)
+                if(((orig[i] - min) >> (b - 1)) & 1)
+                    expect[21 + pos / 8] |= (unsigned char)(0x80 >> (pos % 8));
+
+        HDsnprintf(name, sizeof(name), "%s_%u", DSET_SCALEOFFSET_PACKED_NAME, (unsigned)c);
+        if((dataset = H5Dcreate2(file, name, cases[c].type, space, H5P_DEFAULT, dc, H5P_DEFAULT)) < 0)
+            TEST_ERROR
+        if(H5Dwrite(dataset, cases[c].type, H5S_ALL, H5S_ALL, H5P_DEFAULT, mem) < 0)
+            TEST_ERROR
+
+        if(H5Dget_chunk_storage_size(dataset, chunk_offset, &chunk_nbytes) < 0)
+            TEST_ERROR
+        if(chunk_nbytes != 21 + pos / 8 + 1) {
+            H5_FAILED();
+            HDprintf("    Case %u: stored %llu bytes, expected %llu\n", (unsigned)c,
+                     (unsigned long long)chunk_nbytes, (unsigned long long)(21 + pos / 8 + 1));
+            goto error;
+        } /* end if */
+        if(H5Dread_chunk(dataset, H5P_DEFAULT, chunk_offset, &filter_mask, raw) < 0)
+            TEST_ERROR
+        if(HDmemcmp(raw, expect, (size_t)chunk_nbytes) != 0) {
+            H5_FAILED();
+            HDprintf("    Case %u: packed bytes differ from the reference layout\n", (unsigned)c);
+            goto error;
+        } /* end if */
+
+        /* Read back through the filter */
+        HDmemset(new_data, 0, nbytes);
+        if(H5Dread(dataset, H5T_NATIVE_ULLONG, H5S_ALL, H5S_ALL, H5P_DEFAULT, new_data) < 0)
+            TEST_ERROR
+        for(i = 0; i < SCALEOFFSET_PACKED_NELMTS; i++)
+            if(new_data[i] != orig[i]) {
+                H5_FAILED();
+                HDprintf("    Case %u: read different values than written at index %lu\n",
+                         (unsigned)c, (unsigned long)i);
+                goto error;
+            } /* end if */
+
+        if(H5Dclose(dataset) < 0) TEST_ERROR
+        dataset = -1;
+    } /* end for */
+    if(H5Sclose(space) < 0) TEST_ERROR
+    space = -1;
+    if(H5Pclose(dc) < 0) TEST_ERROR
+    dc = -1;
+
+    /* Float chunk whose minimum is zero, with -0.0 before 0.0 */
+    for(i = 0; i < 16; i++)
+        fdata[i] = (float)(i + 1);
+    fdata[5] = -0.0f;
+    fdata[9] = 0.0f;
+    size[0] = 16;
+    if((space = H5Screate_simple(1, size, NULL)) < 0) TEST_ERROR
+    if((dc = H5Pcreate(H5P_DATASET_CREATE)) < 0) TEST_ERROR
+    if(H5Pset_fill_value(dc, H5T_NATIVE_FLOAT, NULL) < 0) TEST_ERROR
+    if(H5Pset_chunk(dc, 1, size) < 0) TEST_ERROR
+    if(H5Pset_scaleoffset(dc, H5Z_SO_FLOAT_DSCALE, 0) < 0) TEST_ERROR
+    if((dataset = H5Dcreate2(file, DSET_SCALEOFFSET_PACKED_NAME "_zero", H5T_NATIVE_FLOAT, space,
+                             H5P_DEFAULT, dc, H5P_DEFAULT)) < 0)
+        TEST_ERROR
+    if(H5Dwrite(dataset, H5T_NATIVE_FLOAT, H5S_ALL, H5S_ALL, H5P_DEFAULT, fdata) < 0)
+        TEST_ERROR
+    if(H5Dread_chunk(dataset, H5P_DEFAULT, chunk_offset, &filter_mask, raw) < 0)
+        TEST_ERROR
+
+    /* The stored minimum is the bits of -0.0f, little-endian */
+    if(raw[5] != 0 || raw[6] != 0 || raw[7] != 0 || raw[8] != 0x80) {
+        H5_FAILED();
+        HDprintf("    Float minimum stored as %02x %02x %02x %02x, expected -0.0\n",
+                 raw[5], raw[6], raw[7], raw[8]);
+        goto error;
+    } /* end if */
+    if(H5Dread(dataset, H5T_NATIVE_FLOAT, H5S_ALL, H5S_ALL, H5P_DEFAULT, fnew) < 0)
+        TEST_ERROR
+    for(i = 0; i < 16; i++)
+        if(!H5_FLT_ABS_EQUAL(fnew[i], fdata[i])) {
+            H5_FAILED();
+            HDprintf("    Read different float values than written at index %lu\n", (unsigned long)i);
+            goto error;
+        } /* end if */
+
+    if(H5Dclose(dataset) < 0) TEST_ERROR
+    if(H5Pclose(dc) < 0) TEST_ERROR
+    if(H5Sclose(space) < 0) TEST_ERROR
+
+    HDfree(orig);
+    HDfree(new_data);
+    HDfree(mem);
+    HDfree(expect);
+    HDfree(raw);
+
+    PASSED();
+
+    return SUCCEED;
+
+error:
+    H5E_BEGIN_TRY {
+        H5Dclose(dataset);
+        H5Pclose(dc);
+        H5Sclose(space);
+    } H5E_END_TRY;
+    HDfree(orig);
+    HDfree(new_data);
+    HDfree(mem);
+    HDfree(expect);
+    HDfree(raw);
+
+    return FAIL;
+} /* end test_scaleoffset_packed() */
+
 
 /*-------------------------------------------------------------------------
  * Function:    test_multiopen
@@ -8149,6 +8516,2681 @@ error:
 } /* end test_chunk_cache() */
 
 
+/*-------------------------------------------------------------------------
+ * Function:    decode_find_fletcher32
+ *
+ * Purpose:     H5Ewalk2() callback for test_chunk_decode_nthreads(), which
+ *              looks for the error pushed by the Fletcher32 filter when a
+ *              checksum doesn't match.
+ *
+ * Return:      0
+ *
+ *-------------------------------------------------------------------------
+ */
+static herr_t
+decode_find_fletcher32(unsigned H5_ATTR_UNUSED n, const H5E_error2_t *err_desc, void *client_data)
+{
+    if(err_desc->maj_num == H5E_STORAGE && err_desc->min_num == H5E_READERROR)
+        *(hbool_t *)client_data = TRUE;
+
+    return 0;
+} /* end decode_find_fletcher32() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:    test_chunk_decode_nthreads
+ *
+ * Purpose:     Tests reading filtered chunks with the chunk decode threads
+ *              DXPL property set, with chunk caches of different sizes and
+ *              with unfiltered partial edge chunks mixed in.  Also checks
+ *              that the errors of chunks that fail to decode are reported,
+ *              and that an application filter callback is still used.
+ *
+ * Return:      Success: 0
+ *              Failure: -1
+ *
+ *-------------------------------------------------------------------------
+ */
+#define DECODE_DIM0     105
+#define DECODE_DIM1     70
+#define DECODE_CHUNK0   10
+#define DECODE_CHUNK1   10
+static herr_t
+test_chunk_decode_nthreads(hid_t fapl)
+{
+    char        filename[FILENAME_BUF_SIZE];
+    hid_t       fid = -1;               /* File ID */
+    hid_t       dcpl = -1;              /* Dataset creation property list ID */
+    hid_t       dapl = -1;              /* Dataset access property list ID */
+    hid_t       dxpl = -1;              /* Dataset transfer property list ID */
+    hid_t       sid = -1;               /* Dataspace ID */
+    hid_t       mid = -1;               /* Memory space ID */
+    hid_t       dsid = -1;              /* Dataset ID */
+    hsize_t     dims[2] = {DECODE_DIM0, DECODE_DIM1};       /* Dataset dimensions */
+    hsize_t     chunk_dims[2] = {DECODE_CHUNK0, DECODE_CHUNK1}; /* Chunk dimensions */
+    hsize_t     start[2], count[2];     /* Hyperslab selection */
+    size_t      cache_nbytes[3] = {3 * DECODE_CHUNK0 * DECODE_CHUNK1 * sizeof(int),
+                                   1024 * 1024, 0};     /* Chunk cache sizes to try */
+    int         *wbuf = NULL;           /* Write buffer */
+    int         *rbuf = NULL;           /* Read buffer */
+    unsigned char bad_chunk[DECODE_CHUNK0 * DECODE_CHUNK1 * sizeof(int) + 4];   /* Chunk with a bad checksum */
+    hid_t       estack = -1;            /* Error stack ID */
+    hbool_t     found;                  /* Whether the checksum error was reported */
+    unsigned    nthreads;               /* Number of decode threads */
+    unsigned    opts;                   /* Chunk options */
+    herr_t      ret;                    /* Generic return value */
+    int         i, j;                   /* Local index variables */
+
+    TESTING("decoding chunks with multiple threads");
+
+    h5_fixname(FILENAME[26], fapl, filename, sizeof filename);
+
+    if(NULL == (wbuf = (int *)HDmalloc(DECODE_DIM0 * DECODE_DIM1 * sizeof(int))))
+        TEST_ERROR
+    if(NULL == (rbuf = (int *)HDmalloc(DECODE_DIM0 * DECODE_DIM1 * sizeof(int))))
+        TEST_ERROR
+    for(i = 0; i < DECODE_DIM0 * DECODE_DIM1; i++)
+        wbuf[i] = (i % 97) * (i / 31);
+
+    /* Check the property's default value and setting it */
+    if((dxpl = H5Pcreate(H5P_DATASET_XFER)) < 0) FAIL_STACK_ERROR
+    if(H5Pget_chunk_decode_nthreads(dxpl, &nthreads) < 0) FAIL_STACK_ERROR
+    if(nthreads != 1) FAIL_PUTS_ERROR("wrong default number of chunk decode threads")
+    H5E_BEGIN_TRY {
+        ret = H5Pset_chunk_decode_nthreads(dxpl, 0);
+    } H5E_END_TRY;
+    if(ret >= 0) FAIL_PUTS_ERROR("zero chunk decode threads accepted")
+    if(H5Pset_chunk_decode_nthreads(dxpl, 4) < 0) FAIL_STACK_ERROR
+    if(H5Pget_chunk_decode_nthreads(dxpl, &nthreads) < 0) FAIL_STACK_ERROR
+    if(nthreads != 4) FAIL_PUTS_ERROR("wrong number of chunk decode threads")
+
+    /* Create a filtered dataset, leaving partial edge chunks unfiltered */
+    if((fid = H5Fcreate(filename, H5F_ACC_TRUNC, H5P_DEFAULT, fapl)) < 0) FAIL_STACK_ERROR
+    if((sid = H5Screate_simple(2, dims, NULL)) < 0) FAIL_STACK_ERROR
+    if((dcpl = H5Pcreate(H5P_DATASET_CREATE)) < 0) FAIL_STACK_ERROR
+    if(H5Pset_chunk(dcpl, 2, chunk_dims) < 0) FAIL_STACK_ERROR
+    if(H5Pset_shuffle(dcpl) < 0) FAIL_STACK_ERROR
+#ifdef H5_HAVE_FILTER_DEFLATE
+    if(H5Pset_deflate(dcpl, 6) < 0) FAIL_STACK_ERROR
+#endif /* H5_HAVE_FILTER_DEFLATE */
+    if(H5Pset_fletcher32(dcpl) < 0) FAIL_STACK_ERROR
+    opts = H5D_CHUNK_DONT_FILTER_PARTIAL_CHUNKS;
+    if(H5Pset_chunk_opts(dcpl, opts) < 0) FAIL_STACK_ERROR
+    if((dsid = H5Dcreate2(fid, "dset", H5T_NATIVE_INT, sid, H5P_DEFAULT, dcpl, H5P_DEFAULT)) < 0)
+        FAIL_STACK_ERROR
+    if(H5Dwrite(dsid, H5T_NATIVE_INT, H5S_ALL, H5S_ALL, H5P_DEFAULT, wbuf) < 0) FAIL_STACK_ERROR
+    if(H5Dclose(dsid) < 0) FAIL_STACK_ERROR
+    dsid = -1;
+
+    /* Read the dataset back with different chunk cache sizes */
+    if((dapl = H5Pcreate(H5P_DATASET_ACCESS)) < 0) FAIL_STACK_ERROR
+    for(i = 0; i < 3; i++) {
+        if(H5Pset_chunk_cache(dapl, (size_t)101, cache_nbytes[i], H5D_CHUNK_CACHE_W0_DEFAULT) < 0)
+            FAIL_STACK_ERROR
+        if((dsid = H5Dopen2(fid, "dset", dapl)) < 0) FAIL_STACK_ERROR
+
+        /* Read the whole dataset */
+        HDmemset(rbuf, 0, DECODE_DIM0 * DECODE_DIM1 * sizeof(int));
+        if(H5Dread(dsid, H5T_NATIVE_INT, H5S_ALL, H5S_ALL, dxpl, rbuf) < 0) FAIL_STACK_ERROR
+        for(j = 0; j < DECODE_DIM0 * DECODE_DIM1; j++)
+            if(rbuf[j] != wbuf[j]) {
+                HDprintf("    cache size %lu: rbuf[%d] = %d, wbuf[%d] = %d\n",
+                        (unsigned long)cache_nbytes[i], j, rbuf[j], j, wbuf[j]);
+                TEST_ERROR
+            } /* end if */
+
+        /* Read a hyperslab that only partially covers some chunks, with
+         * some of the chunks already in the cache */
+        start[0] = 15; start[1] = 5;
+        count[0] = 80; count[1] = 60;
+        if(H5Sselect_hyperslab(sid, H5S_SELECT_SET, start, NULL, count, NULL) < 0) FAIL_STACK_ERROR
+        if((mid = H5Screate_simple(2, count, NULL)) < 0) FAIL_STACK_ERROR
+        HDmemset(rbuf, 0, DECODE_DIM0 * DECODE_DIM1 * sizeof(int));
+        if(H5Dread(dsid, H5T_NATIVE_INT, mid, sid, dxpl, rbuf) < 0) FAIL_STACK_ERROR
+        for(j = 0; j < (int)(count[0] * count[1]); j++) {
+            int row = (int)start[0] + j / (int)count[1];
+            int col = (int)start[1] + j % (int)count[1];
+
+            if(rbuf[j] != wbuf[row * DECODE_DIM1 + col]) {
+                HDprintf("    cache size %lu: hyperslab element (%d, %d) is wrong\n",
+                        (unsigned long)cache_nbytes[i], row, col);
+                TEST_ERROR
+            } /* end if */
+        } /* end for */
+        if(H5Sclose(mid) < 0) FAIL_STACK_ERROR
+        mid = -1;
+
+        if(H5Dclose(dsid) < 0) FAIL_STACK_ERROR
+        dsid = -1;
+    } /* end for */
+
+    /* Store chunks whose checksums don't match in a Fletcher32 dataset */
+    dims[1] = DECODE_CHUNK1;
+    if(H5Sset_extent_simple(sid, 2, dims, NULL) < 0) FAIL_STACK_ERROR
+    if(H5Premove_filter(dcpl, H5Z_FILTER_ALL) < 0) FAIL_STACK_ERROR
+    if(H5Pset_fletcher32(dcpl) < 0) FAIL_STACK_ERROR
+    if((dsid = H5Dcreate2(fid, "bad_checksums", H5T_NATIVE_INT, sid, H5P_DEFAULT, dcpl, H5P_DEFAULT)) < 0)
+        FAIL_STACK_ERROR
+    for(i = 0; i < (int)sizeof(bad_chunk); i++)
+        bad_chunk[i] = (unsigned char)(i * 7);
+    for(i = 0; i < DECODE_DIM0 / DECODE_CHUNK0; i++) {
+        hsize_t offset[2] = {(hsize_t)(i * DECODE_CHUNK0), 0};
+
+        if(H5Dwrite_chunk(dsid, H5P_DEFAULT, 0, offset, sizeof(bad_chunk), bad_chunk) < 0)
+            FAIL_STACK_ERROR
+    } /* end for */
+    if(H5Dclose(dsid) < 0) FAIL_STACK_ERROR
+    dsid = -1;
+
+    /* Reading them fails, with the filter's error on the error stack */
+    if((dsid = H5Dopen2(fid, "bad_checksums", H5P_DEFAULT)) < 0) FAIL_STACK_ERROR
+    H5E_BEGIN_TRY {
+        ret = H5Dread(dsid, H5T_NATIVE_INT, H5S_ALL, H5S_ALL, dxpl, rbuf);
+        estack = H5Eget_current_stack();
+    } H5E_END_TRY;
+    if(ret >= 0) FAIL_PUTS_ERROR("chunks with bad checksums read")
+    if(estack < 0) FAIL_STACK_ERROR
+    found = FALSE;
+    if(H5Ewalk2(estack, H5E_WALK_DOWNWARD, decode_find_fletcher32, &found) < 0) FAIL_STACK_ERROR
+    if(H5Eclose_stack(estack) < 0) FAIL_STACK_ERROR
+    estack = -1;
+    if(!found) FAIL_PUTS_ERROR("checksum error not reported")
+    if(H5Dclose(dsid) < 0) FAIL_STACK_ERROR
+    dsid = -1;
+
+    /* ...unless the application's filter callback lets them through */
+    if(H5Pset_filter_callback(dxpl, filter_cb_cont, NULL) < 0) FAIL_STACK_ERROR
+    if((dsid = H5Dopen2(fid, "bad_checksums", H5P_DEFAULT)) < 0) FAIL_STACK_ERROR
+    if(H5Dread(dsid, H5T_NATIVE_INT, H5S_ALL, H5S_ALL, dxpl, rbuf) < 0) FAIL_STACK_ERROR
+    if(H5Dclose(dsid) < 0) FAIL_STACK_ERROR
+    dsid = -1;
+
+    /* Release resources */
+    if(H5Pclose(dapl) < 0) FAIL_STACK_ERROR
+    if(H5Pclose(dxpl) < 0) FAIL_STACK_ERROR
+    if(H5Pclose(dcpl) < 0) FAIL_STACK_ERROR
+    if(H5Sclose(sid) < 0) FAIL_STACK_ERROR
+    if(H5Fclose(fid) < 0) FAIL_STACK_ERROR
+    HDfree(wbuf);
+    HDfree(rbuf);
+
+    PASSED();
+    return SUCCEED;
+
+error:
+    H5E_BEGIN_TRY {
+        H5Eclose_stack(estack);
+        H5Pclose(dapl);
+        H5Pclose(dxpl);
+        H5Pclose(dcpl);
+        H5Dclose(dsid);
+        H5Sclose(mid);
+        H5Sclose(sid);
+        H5Fclose(fid);
+    } H5E_END_TRY;
+    if(wbuf)
+        HDfree(wbuf);
+    if(rbuf)
+        HDfree(rbuf);
+    return FAIL;
+} /* end test_chunk_decode_nthreads() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:    test_chunk_encode_nthreads
+ *
+ * Purpose:     Tests writing filtered chunks with the chunk encode threads
+ *              DAPL property set, when chunks are preempted from a small
+ *              chunk cache, when the file is flushed and when the dataset
+ *              is closed, and with a filter registered by the application.
+ *
+ * Return:      Success: 0
+ *              Failure: -1
+ *
+ *-------------------------------------------------------------------------
+ */
+#define ENCODE_DIM0     60
+#define ENCODE_DIM1     55
+#define ENCODE_CHUNK0   10
+#define ENCODE_CHUNK1   10
+static herr_t
+test_chunk_encode_nthreads(hid_t fapl)
+{
+    char        filename[FILENAME_BUF_SIZE];
+    hid_t       fid = -1;               /* File ID */
+    hid_t       dcpl = -1;              /* Dataset creation property list ID */
+    hid_t       dapl = -1;              /* Dataset access property list ID */
+    hid_t       dapl2 = -1;             /* Dataset access property list ID from dataset */
+    hid_t       sid = -1;               /* Dataspace ID */
+    hid_t       mid = -1;               /* Memory space ID */
+    hid_t       dsid = -1;              /* Dataset ID */
+    hsize_t     dims[2] = {ENCODE_DIM0, ENCODE_DIM1};       /* Dataset dimensions */
+    hsize_t     chunk_dims[2] = {ENCODE_CHUNK0, ENCODE_CHUNK1}; /* Chunk dimensions */
+    hsize_t     start[2], count[2];     /* Hyperslab selection */
+    size_t      cache_nbytes[2] = {4 * ENCODE_CHUNK0 * ENCODE_CHUNK1 * sizeof(int),
+                                   1024 * 1024};    /* Chunk cache sizes to try */
+    int         *wbuf = NULL;           /* Write buffer */
+    int         *rbuf = NULL;           /* Read buffer */
+    unsigned    nthreads;               /* Number of encode threads */
+    unsigned    opts;                   /* Chunk options */
+    herr_t      ret;                    /* Generic return value */
+    char        dset_name[16];          /* Dataset name */
+    int         i, j, k;                /* Local index variables */
+
+    TESTING("encoding chunks with multiple threads");
+
+    h5_fixname(FILENAME[27], fapl, filename, sizeof filename);
+
+    if(NULL == (wbuf = (int *)HDmalloc(ENCODE_DIM0 * ENCODE_DIM1 * sizeof(int))))
+        TEST_ERROR
+    if(NULL == (rbuf = (int *)HDmalloc(ENCODE_DIM0 * ENCODE_DIM1 * sizeof(int))))
+        TEST_ERROR
+    for(i = 0; i < ENCODE_DIM0 * ENCODE_DIM1; i++)
+        wbuf[i] = (i % 89) * (i / 23);
+
+    /* Check the property's default value and setting it */
+    if((dapl = H5Pcreate(H5P_DATASET_ACCESS)) < 0) FAIL_STACK_ERROR
+    if(H5Pget_chunk_encode_nthreads(dapl, &nthreads) < 0) FAIL_STACK_ERROR
+    if(nthreads != 1) FAIL_PUTS_ERROR("wrong default number of chunk encode threads")
+    H5E_BEGIN_TRY {
+        ret = H5Pset_chunk_encode_nthreads(dapl, 0);
+    } H5E_END_TRY;
+    if(ret >= 0) FAIL_PUTS_ERROR("zero chunk encode threads accepted")
+    if(H5Pset_chunk_encode_nthreads(dapl, 4) < 0) FAIL_STACK_ERROR
+
+    /* Create a filtered dataset, leaving partial edge chunks unfiltered */
+    if((fid = H5Fcreate(filename, H5F_ACC_TRUNC, H5P_DEFAULT, fapl)) < 0) FAIL_STACK_ERROR
+    if((sid = H5Screate_simple(2, dims, NULL)) < 0) FAIL_STACK_ERROR
+    if((dcpl = H5Pcreate(H5P_DATASET_CREATE)) < 0) FAIL_STACK_ERROR
+    if(H5Pset_chunk(dcpl, 2, chunk_dims) < 0) FAIL_STACK_ERROR
+    if(H5Pset_shuffle(dcpl) < 0) FAIL_STACK_ERROR
+#ifdef H5_HAVE_FILTER_DEFLATE
+    if(H5Pset_deflate(dcpl, 6) < 0) FAIL_STACK_ERROR
+#endif /* H5_HAVE_FILTER_DEFLATE */
+    if(H5Pset_fletcher32(dcpl) < 0) FAIL_STACK_ERROR
+    opts = H5D_CHUNK_DONT_FILTER_PARTIAL_CHUNKS;
+    if(H5Pset_chunk_opts(dcpl, opts) < 0) FAIL_STACK_ERROR
+
+    /* Write datasets with different chunk cache sizes */
+    for(i = 0; i < 2; i++) {
+        if(H5Pset_chunk_cache(dapl, (size_t)101, cache_nbytes[i], H5D_CHUNK_CACHE_W0_DEFAULT) < 0)
+            FAIL_STACK_ERROR
+        HDsnprintf(dset_name, sizeof(dset_name), "dset%d", i);
+        if((dsid = H5Dcreate2(fid, dset_name, H5T_NATIVE_INT, sid, H5P_DEFAULT, dcpl, dapl)) < 0)
+            FAIL_STACK_ERROR
+
+        /* Check that the property is kept with the dataset */
+        if((dapl2 = H5Dget_access_plist(dsid)) < 0) FAIL_STACK_ERROR
+        if(H5Pget_chunk_encode_nthreads(dapl2, &nthreads) < 0) FAIL_STACK_ERROR
+        if(nthreads != 4) FAIL_PUTS_ERROR("wrong number of chunk encode threads")
+        if(H5Pclose(dapl2) < 0) FAIL_STACK_ERROR
+        dapl2 = -1;
+
+        /* Write the dataset a few columns at a time, so that partially
+         * written chunks are preempted from the cache */
+        count[0] = ENCODE_DIM0;
+        count[1] = 5;
+        if((mid = H5Screate_simple(2, count, NULL)) < 0) FAIL_STACK_ERROR
+        for(j = 0; j < ENCODE_DIM1; j += 5) {
+            start[0] = 0;
+            start[1] = (hsize_t)j;
+            for(k = 0; k < ENCODE_DIM0 * 5; k++)
+                rbuf[k] = wbuf[(k / 5) * ENCODE_DIM1 + j + (k % 5)];
+            if(H5Sselect_hyperslab(sid, H5S_SELECT_SET, start, NULL, count, NULL) < 0) FAIL_STACK_ERROR
+            if(H5Dwrite(dsid, H5T_NATIVE_INT, mid, sid, H5P_DEFAULT, rbuf) < 0) FAIL_STACK_ERROR
+
+            /* Flush the file halfway through */
+            if(j == 25 && H5Fflush(fid, H5F_SCOPE_LOCAL) < 0) FAIL_STACK_ERROR
+        } /* end for */
+        if(H5Sclose(mid) < 0) FAIL_STACK_ERROR
+        mid = -1;
+        if(H5Sselect_all(sid) < 0) FAIL_STACK_ERROR
+
+        if(H5Dclose(dsid) < 0) FAIL_STACK_ERROR
+        dsid = -1;
+    } /* end for */
+
+    /* Write a dataset with a filter registered by the application, which
+     * is only called from this thread */
+    if(H5Zregister(H5Z_COUNT) < 0) FAIL_STACK_ERROR
+    if(H5Pclose(dcpl) < 0) FAIL_STACK_ERROR
+    if((dcpl = H5Pcreate(H5P_DATASET_CREATE)) < 0) FAIL_STACK_ERROR
+    if(H5Pset_chunk(dcpl, 2, chunk_dims) < 0) FAIL_STACK_ERROR
+    if(H5Pset_shuffle(dcpl) < 0) FAIL_STACK_ERROR
+    if(H5Pset_filter(dcpl, H5Z_FILTER_COUNT, 0, (size_t)0, NULL) < 0) FAIL_STACK_ERROR
+    if((dsid = H5Dcreate2(fid, "dset2", H5T_NATIVE_INT, sid, H5P_DEFAULT, dcpl, dapl)) < 0)
+        FAIL_STACK_ERROR
+    count_nbytes_written = 0;
+    if(H5Dwrite(dsid, H5T_NATIVE_INT, H5S_ALL, H5S_ALL, H5P_DEFAULT, wbuf) < 0) FAIL_STACK_ERROR
+    if(H5Dclose(dsid) < 0) FAIL_STACK_ERROR
+    dsid = -1;
+    if(count_nbytes_written != (size_t)(((ENCODE_DIM0 + ENCODE_CHUNK0 - 1) / ENCODE_CHUNK0)
+            * ((ENCODE_DIM1 + ENCODE_CHUNK1 - 1) / ENCODE_CHUNK1) * ENCODE_CHUNK0 * ENCODE_CHUNK1 * sizeof(int)))
+        FAIL_PUTS_ERROR("wrong number of bytes filtered by application filter")
+    if(H5Fclose(fid) < 0) FAIL_STACK_ERROR
+    fid = -1;
+
+    /* Read the datasets back */
+    if((fid = H5Fopen(filename, H5F_ACC_RDONLY, fapl)) < 0) FAIL_STACK_ERROR
+    for(i = 0; i < 3; i++) {
+        HDsnprintf(dset_name, sizeof(dset_name), "dset%d", i);
+        if((dsid = H5Dopen2(fid, dset_name, H5P_DEFAULT)) < 0) FAIL_STACK_ERROR
+        HDmemset(rbuf, 0, ENCODE_DIM0 * ENCODE_DIM1 * sizeof(int));
+        if(H5Dread(dsid, H5T_NATIVE_INT, H5S_ALL, H5S_ALL, H5P_DEFAULT, rbuf) < 0) FAIL_STACK_ERROR
+        for(j = 0; j < ENCODE_DIM0 * ENCODE_DIM1; j++)
+            if(rbuf[j] != wbuf[j]) {
+                HDprintf("    %s: rbuf[%d] = %d, wbuf[%d] = %d\n", dset_name, j, rbuf[j], j, wbuf[j]);
+                TEST_ERROR
+            } /* end if */
+        if(H5Dclose(dsid) < 0) FAIL_STACK_ERROR
+        dsid = -1;
+    } /* end for */
+
+    /* Release resources */
+    if(H5Pclose(dapl) < 0) FAIL_STACK_ERROR
+    if(H5Pclose(dcpl) < 0) FAIL_STACK_ERROR
+    if(H5Sclose(sid) < 0) FAIL_STACK_ERROR
+    if(H5Fclose(fid) < 0) FAIL_STACK_ERROR
+    HDfree(wbuf);
+    HDfree(rbuf);
+
+    PASSED();
+    return SUCCEED;
+
+error:
+    H5E_BEGIN_TRY {
+        H5Pclose(dapl);
+        H5Pclose(dapl2);
+        H5Pclose(dcpl);
+        H5Dclose(dsid);
+        H5Sclose(mid);
+        H5Sclose(sid);
+        H5Fclose(fid);
+    } H5E_END_TRY;
+    if(wbuf)
+        HDfree(wbuf);
+    if(rbuf)
+        HDfree(rbuf);
+    return FAIL;
+} /* end test_chunk_encode_nthreads() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:    test_chunk_readahead
+ *
+ * Purpose:     Tests reading chunks with the chunk readahead DAPL property
+ *              set, walking through the chunks forward and backward along
+ *              the slowest changing dimension and with a stride along the
+ *              fastest changing dimension, with chunk caches of different
+ *              sizes and with unfiltered partial edge chunks mixed in.
+ *
+ * Return:      Success: 0
+ *              Failure: -1
+ *
+ *-------------------------------------------------------------------------
+ */
+#define READAHEAD_DIM0     100
+#define READAHEAD_DIM1     75
+#define READAHEAD_CHUNK0   10
+#define READAHEAD_CHUNK1   10
+static herr_t
+test_chunk_readahead(hid_t fapl)
+{
+    char        filename[FILENAME_BUF_SIZE];
+    hid_t       fid = -1;               /* File ID */
+    hid_t       dcpl = -1;              /* Dataset creation property list ID */
+    hid_t       dapl = -1;              /* Dataset access property list ID */
+    hid_t       dapl2 = -1;             /* Dataset access property list ID from dataset */
+    hid_t       sid = -1;               /* Dataspace ID */
+    hid_t       mid = -1;               /* Memory space ID */
+    hid_t       dsid = -1;              /* Dataset ID */
+    hsize_t     dims[2] = {READAHEAD_DIM0, READAHEAD_DIM1};         /* Dataset dimensions */
+    hsize_t     chunk_dims[2] = {READAHEAD_CHUNK0, READAHEAD_CHUNK1}; /* Chunk dimensions */
+    hsize_t     start[2], count[2];     /* Hyperslab selection */
+    hsize_t     mstart[2] = {0, 0};     /* Memory hyperslab start */
+    size_t      cache_nbytes[2] = {3 * READAHEAD_CHUNK0 * READAHEAD_CHUNK1 * sizeof(int),
+                                   1024 * 1024};    /* Chunk cache sizes to try */
+    int         *wbuf = NULL;           /* Write buffer */
+    int         rbuf[READAHEAD_CHUNK0 * READAHEAD_CHUNK1];  /* Read buffer */
+    unsigned    nchunks;                /* Number of chunks to read ahead */
+    unsigned    opts;                   /* Chunk options */
+    int         i, j, k;                /* Local index variables */
+
+    TESTING("reading chunks ahead of sequential access");
+
+    h5_fixname(FILENAME[28], fapl, filename, sizeof filename);
+
+    if(NULL == (wbuf = (int *)HDmalloc(READAHEAD_DIM0 * READAHEAD_DIM1 * sizeof(int))))
+        TEST_ERROR
+    for(i = 0; i < READAHEAD_DIM0 * READAHEAD_DIM1; i++)
+        wbuf[i] = (i % 83) * (i / 19);
+
+    /* Check the property's default value and setting it */
+    if((dapl = H5Pcreate(H5P_DATASET_ACCESS)) < 0) FAIL_STACK_ERROR
+    if(H5Pget_chunk_readahead(dapl, &nchunks) < 0) FAIL_STACK_ERROR
+    if(nchunks != 0) FAIL_PUTS_ERROR("wrong default number of chunks to read ahead")
+    if(H5Pset_chunk_readahead(dapl, 4) < 0) FAIL_STACK_ERROR
+
+    /* Create a filtered dataset, leaving partial edge chunks unfiltered */
+    if((fid = H5Fcreate(filename, H5F_ACC_TRUNC, H5P_DEFAULT, fapl)) < 0) FAIL_STACK_ERROR
+    if((sid = H5Screate_simple(2, dims, NULL)) < 0) FAIL_STACK_ERROR
+    if((dcpl = H5Pcreate(H5P_DATASET_CREATE)) < 0) FAIL_STACK_ERROR
+    if(H5Pset_chunk(dcpl, 2, chunk_dims) < 0) FAIL_STACK_ERROR
+    if(H5Pset_shuffle(dcpl) < 0) FAIL_STACK_ERROR
+#ifdef H5_HAVE_FILTER_DEFLATE
+    if(H5Pset_deflate(dcpl, 6) < 0) FAIL_STACK_ERROR
+#endif /* H5_HAVE_FILTER_DEFLATE */
+    if(H5Pset_fletcher32(dcpl) < 0) FAIL_STACK_ERROR
+    opts = H5D_CHUNK_DONT_FILTER_PARTIAL_CHUNKS;
+    if(H5Pset_chunk_opts(dcpl, opts) < 0) FAIL_STACK_ERROR
+    if((dsid = H5Dcreate2(fid, "dset", H5T_NATIVE_INT, sid, H5P_DEFAULT, dcpl, H5P_DEFAULT)) < 0)
+        FAIL_STACK_ERROR
+    if(H5Dwrite(dsid, H5T_NATIVE_INT, H5S_ALL, H5S_ALL, H5P_DEFAULT, wbuf) < 0) FAIL_STACK_ERROR
+    if(H5Dclose(dsid) < 0) FAIL_STACK_ERROR
+    dsid = -1;
+
+    /* Read the dataset back a chunk at a time, with different chunk cache sizes */
+    count[0] = READAHEAD_CHUNK0;
+    count[1] = READAHEAD_CHUNK1;
+    if((mid = H5Screate_simple(2, count, NULL)) < 0) FAIL_STACK_ERROR
+    for(i = 0; i < 2; i++) {
+        if(H5Pset_chunk_cache(dapl, (size_t)101, cache_nbytes[i], H5D_CHUNK_CACHE_W0_DEFAULT) < 0)
+            FAIL_STACK_ERROR
+        if((dsid = H5Dopen2(fid, "dset", dapl)) < 0) FAIL_STACK_ERROR
+
+        /* Check that the property is kept with the dataset */
+        if((dapl2 = H5Dget_access_plist(dsid)) < 0) FAIL_STACK_ERROR
+        if(H5Pget_chunk_readahead(dapl2, &nchunks) < 0) FAIL_STACK_ERROR
+        if(nchunks != 4) FAIL_PUTS_ERROR("wrong number of chunks to read ahead")
+        if(H5Pclose(dapl2) < 0) FAIL_STACK_ERROR
+        dapl2 = -1;
+
+        /* Walk down a column of whole chunks, then back up the column of
+         * partial edge chunks, then along every other chunk of a row */
+        for(j = 0; j < 24; j++) {
+            if(j < 10) {
+                start[0] = (hsize_t)(j * READAHEAD_CHUNK0);
+                start[1] = 20;
+            } /* end if */
+            else if(j < 20) {
+                start[0] = (hsize_t)((19 - j) * READAHEAD_CHUNK0);
+                start[1] = 70;
+            } /* end else if */
+            else {
+                start[0] = 50;
+                start[1] = (hsize_t)((j - 20) * 2 * READAHEAD_CHUNK1);
+            } /* end else */
+            count[0] = READAHEAD_CHUNK0;
+            count[1] = start[1] + READAHEAD_CHUNK1 > READAHEAD_DIM1 ? READAHEAD_DIM1 - start[1] : READAHEAD_CHUNK1;
+            if(H5Sselect_hyperslab(sid, H5S_SELECT_SET, start, NULL, count, NULL) < 0) FAIL_STACK_ERROR
+            if(H5Sselect_hyperslab(mid, H5S_SELECT_SET, mstart, NULL, count, NULL) < 0) FAIL_STACK_ERROR
+            HDmemset(rbuf, 0, sizeof(rbuf));
+            if(H5Dread(dsid, H5T_NATIVE_INT, mid, sid, H5P_DEFAULT, rbuf) < 0) FAIL_STACK_ERROR
+            for(k = 0; k < (int)(count[0] * count[1]); k++) {
+                int row = (int)start[0] + k / (int)count[1];
+                int col = (int)start[1] + k % (int)count[1];
+
+                if(rbuf[(k / (int)count[1]) * READAHEAD_CHUNK1 + k % (int)count[1]] != wbuf[row * READAHEAD_DIM1 + col]) {
+                    HDprintf("    cache size %lu: element (%d, %d) is wrong\n",
+                            (unsigned long)cache_nbytes[i], row, col);
+                    TEST_ERROR
+                } /* end if */
+            } /* end for */
+        } /* end for */
+
+        if(H5Dclose(dsid) < 0) FAIL_STACK_ERROR
+        dsid = -1;
+    } /* end for */
+    if(H5Sclose(mid) < 0) FAIL_STACK_ERROR
+    mid = -1;
+    if(H5Sselect_all(sid) < 0) FAIL_STACK_ERROR
+
+    /* Release resources */
+    if(H5Pclose(dapl) < 0) FAIL_STACK_ERROR
+    if(H5Pclose(dcpl) < 0) FAIL_STACK_ERROR
+    if(H5Sclose(sid) < 0) FAIL_STACK_ERROR
+    if(H5Fclose(fid) < 0) FAIL_STACK_ERROR
+    HDfree(wbuf);
+
+    PASSED();
+    return SUCCEED;
+
+error:
+    H5E_BEGIN_TRY {
+        H5Pclose(dapl);
+        H5Pclose(dapl2);
+        H5Pclose(dcpl);
+        H5Dclose(dsid);
+        H5Sclose(mid);
+        H5Sclose(sid);
+        H5Fclose(fid);
+    } H5E_END_TRY;
+    if(wbuf)
+        HDfree(wbuf);
+    return FAIL;
+} /* end test_chunk_readahead() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:    test_chunk_cache_policy
+ *
+ * Purpose:     Tests the chunk cache replacement policy DAPL property.
+ *              Reads a couple of chunks, reads enough other chunks to
+ *              push them out of the cache, reads them again and then
+ *              scans through the whole dataset, and checks whether the
+ *              chunks survived the scan.  They should with the 2Q policy
+ *              but not with the LRU policy.
+ *
+ * Return:      Success: 0
+ *              Failure: -1
+ *
+ *-------------------------------------------------------------------------
+ */
+#define POLICY_NCHUNKS     64
+#define POLICY_CHUNK       100
+static herr_t
+test_chunk_cache_policy(hid_t fapl)
+{
+    char        filename[FILENAME_BUF_SIZE];
+    hid_t       fid = -1;               /* File ID */
+    hid_t       dcpl = -1;              /* Dataset creation property list ID */
+    hid_t       dapl = -1;              /* Dataset access property list ID */
+    hid_t       dapl2 = -1;             /* Dataset access property list ID from dataset */
+    hid_t       sid = -1;               /* Dataspace ID */
+    hid_t       mid = -1;               /* Memory space ID */
+    hid_t       dsid = -1;              /* Dataset ID */
+    hsize_t     dim = POLICY_NCHUNKS * POLICY_CHUNK;    /* Dataset dimensions */
+    hsize_t     chunk_dim = POLICY_CHUNK;               /* Chunk dimensions */
+    hsize_t     start, count = POLICY_CHUNK;            /* Hyperslab selection */
+    hsize_t     roi[2] = {3, 5};        /* Chunks read over and over */
+    int         *wbuf = NULL;           /* Write buffer */
+    int         rbuf[POLICY_CHUNK];     /* Read buffer */
+    H5D_chunk_cache_policy_t policy;    /* Chunk cache policy */
+    unsigned    nhits, nhits2;          /* # of chunk cache hits */
+    int         nhot;                   /* # of chunks in the 2Q hot queue */
+    herr_t      ret;                    /* Generic return value */
+    int         i, j, k, pass;          /* Local index variables */
+
+    TESTING("chunk cache replacement policies");
+
+    h5_fixname(FILENAME[29], fapl, filename, sizeof filename);
+
+    if(NULL == (wbuf = (int *)HDmalloc(POLICY_NCHUNKS * POLICY_CHUNK * sizeof(int))))
+        TEST_ERROR
+    for(i = 0; i < POLICY_NCHUNKS * POLICY_CHUNK; i++)
+        wbuf[i] = i;
+
+    /* Check the property's default value and setting it */
+    if((dapl = H5Pcreate(H5P_DATASET_ACCESS)) < 0) FAIL_STACK_ERROR
+    if(H5Pget_chunk_cache_policy(dapl, &policy) < 0) FAIL_STACK_ERROR
+    if(policy != H5D_CHUNK_CACHE_POLICY_LRU) FAIL_PUTS_ERROR("wrong default chunk cache policy")
+    H5E_BEGIN_TRY {
+        ret = H5Pset_chunk_cache_policy(dapl, (H5D_chunk_cache_policy_t)7);
+    } H5E_END_TRY;
+    if(ret >= 0) FAIL_PUTS_ERROR("invalid chunk cache policy accepted")
+
+    /* Create a filtered dataset */
+    if((fid = H5Fcreate(filename, H5F_ACC_TRUNC, H5P_DEFAULT, fapl)) < 0) FAIL_STACK_ERROR
+    if((sid = H5Screate_simple(1, &dim, NULL)) < 0) FAIL_STACK_ERROR
+    if((mid = H5Screate_simple(1, &count, NULL)) < 0) FAIL_STACK_ERROR
+    if((dcpl = H5Pcreate(H5P_DATASET_CREATE)) < 0) FAIL_STACK_ERROR
+    if(H5Pset_chunk(dcpl, 1, &chunk_dim) < 0) FAIL_STACK_ERROR
+    /* (Filter the chunks so that reads go through the chunk cache) */
+    if(H5Pset_shuffle(dcpl) < 0) FAIL_STACK_ERROR
+    if((dsid = H5Dcreate2(fid, "dset", H5T_NATIVE_INT, sid, H5P_DEFAULT, dcpl, H5P_DEFAULT)) < 0)
+        FAIL_STACK_ERROR
+    if(H5Dwrite(dsid, H5T_NATIVE_INT, H5S_ALL, H5S_ALL, H5P_DEFAULT, wbuf) < 0) FAIL_STACK_ERROR
+    if(H5Dclose(dsid) < 0) FAIL_STACK_ERROR
+    dsid = -1;
+
+    /* Use a cache of 8 chunks, with enough slots to avoid collisions */
+    if(H5Pset_chunk_cache(dapl, (size_t)10007, 8 * POLICY_CHUNK * sizeof(int), H5D_CHUNK_CACHE_W0_DEFAULT) < 0)
+        FAIL_STACK_ERROR
+
+    for(pass = 0; pass < 2; pass++) {
+        policy = pass ? H5D_CHUNK_CACHE_POLICY_2Q : H5D_CHUNK_CACHE_POLICY_LRU;
+        if(H5Pset_chunk_cache_policy(dapl, policy) < 0) FAIL_STACK_ERROR
+        if((dsid = H5Dopen2(fid, "dset", dapl)) < 0) FAIL_STACK_ERROR
+
+        /* Check that the property is kept with the dataset */
+        if((dapl2 = H5Dget_access_plist(dsid)) < 0) FAIL_STACK_ERROR
+        if(H5Pget_chunk_cache_policy(dapl2, &policy) < 0) FAIL_STACK_ERROR
+        if(policy != (pass ? H5D_CHUNK_CACHE_POLICY_2Q : H5D_CHUNK_CACHE_POLICY_LRU))
+            FAIL_PUTS_ERROR("wrong chunk cache policy")
+        if(H5Pclose(dapl2) < 0) FAIL_STACK_ERROR
+        dapl2 = -1;
+
+        /* Read the chunks of interest, then 8 other chunks, then the chunks
+         * of interest again, then the whole dataset a chunk at a time */
+        for(i = 0; i < 2 + 8 + 2 + POLICY_NCHUNKS; i++) {
+            if(i < 2)
+                start = roi[i];
+            else if(i < 10)
+                start = (hsize_t)(i + 8);
+            else if(i < 12)
+                start = roi[i - 10];
+            else
+                start = (hsize_t)(i - 12);
+            start *= POLICY_CHUNK;
+            if(H5Sselect_hyperslab(sid, H5S_SELECT_SET, &start, NULL, &count, NULL) < 0) FAIL_STACK_ERROR
+            if(H5Dread(dsid, H5T_NATIVE_INT, mid, sid, H5P_DEFAULT, rbuf) < 0) FAIL_STACK_ERROR
+            for(k = 0; k < POLICY_CHUNK; k++)
+                if(rbuf[k] != wbuf[start + (hsize_t)k])
+                    TEST_ERROR
+        } /* end for */
+
+        /* Read the chunks of interest again, and check whether they're cached */
+        if(H5D__chunk_cache_hits_test(dsid, &nhits, &nhot) < 0) FAIL_STACK_ERROR
+        for(j = 0; j < 2; j++) {
+            start = roi[j] * POLICY_CHUNK;
+            if(H5Sselect_hyperslab(sid, H5S_SELECT_SET, &start, NULL, &count, NULL) < 0) FAIL_STACK_ERROR
+            if(H5Dread(dsid, H5T_NATIVE_INT, mid, sid, H5P_DEFAULT, rbuf) < 0) FAIL_STACK_ERROR
+        } /* end for */
+        if(H5D__chunk_cache_hits_test(dsid, &nhits2, NULL) < 0) FAIL_STACK_ERROR
+        if(pass) {
+            if(nhot != 2) FAIL_PUTS_ERROR("wrong number of hot chunks")
+            if(nhits2 - nhits != 2) FAIL_PUTS_ERROR("chunks of interest not kept through the scan")
+        } /* end if */
+        else {
+            if(nhot != 0) FAIL_PUTS_ERROR("hot chunks with the LRU policy")
+            if(nhits2 != nhits) FAIL_PUTS_ERROR("chunks of interest kept through the scan")
+        } /* end else */
+
+        if(H5Dclose(dsid) < 0) FAIL_STACK_ERROR
+        dsid = -1;
+    } /* end for */
+
+    /* Release resources */
+    if(H5Pclose(dapl) < 0) FAIL_STACK_ERROR
+    if(H5Pclose(dcpl) < 0) FAIL_STACK_ERROR
+    if(H5Sclose(mid) < 0) FAIL_STACK_ERROR
+    if(H5Sclose(sid) < 0) FAIL_STACK_ERROR
+    if(H5Fclose(fid) < 0) FAIL_STACK_ERROR
+    HDfree(wbuf);
+
+    PASSED();
+    return SUCCEED;
+
+error:
+    H5E_BEGIN_TRY {
+        H5Pclose(dapl);
+        H5Pclose(dapl2);
+        H5Pclose(dcpl);
+        H5Dclose(dsid);
+        H5Sclose(mid);
+        H5Sclose(sid);
+        H5Fclose(fid);
+    } H5E_END_TRY;
+    if(wbuf)
+        HDfree(wbuf);
+    return FAIL;
+} /* end test_chunk_cache_policy() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:    test_chunk_cache_budget
+ *
+ * Purpose:     Tests the file-wide chunk cache budget FAPL property.
+ *              Writes and reads several filtered datasets whose own chunk
+ *              caches could hold all their chunks, checks that the chunks
+ *              cached by all of them together stay within the budget and
+ *              that chunks are written out correctly when clean chunks of
+ *              the other datasets are preempted on their behalf.
+ *
+ * Return:      Success: 0
+ *              Failure: -1
+ *
+ *-------------------------------------------------------------------------
+ */
+#define BUDGET_NDSETS       3
+#define BUDGET_NCHUNKS      16
+#define BUDGET_CHUNK        100
+#define BUDGET_NBYTES       (5 * BUDGET_CHUNK * sizeof(int))
+static herr_t
+test_chunk_cache_budget(hid_t fapl)
+{
+    char        filename[FILENAME_BUF_SIZE];
+    char        dname[16];                  /* Dataset name */
+    hid_t       my_fapl = -1;               /* File access property list ID */
+    hid_t       fapl2 = -1;                 /* File access property list ID from file */
+    hid_t       fid = -1;                   /* File ID */
+    hid_t       dcpl = -1;                  /* Dataset creation property list ID */
+    hid_t       dapl = -1;                  /* Dataset access property list ID */
+    hid_t       sid = -1;                   /* Dataspace ID */
+    hid_t       mid = -1;                   /* Memory space ID */
+    hid_t       dsid[BUDGET_NDSETS] = {-1, -1, -1};  /* Dataset IDs */
+    hsize_t     dim = BUDGET_NCHUNKS * BUDGET_CHUNK;  /* Dataset dimensions */
+    hsize_t     chunk_dim = BUDGET_CHUNK;           /* Chunk dimensions */
+    hsize_t     start, count = BUDGET_CHUNK;        /* Hyperslab selection */
+    int         buf[BUDGET_CHUNK];          /* Data buffer */
+    size_t      nbytes;                     /* Budget / cached bytes */
+    size_t      total;                      /* Cached bytes of all datasets */
+    int         i, j, k;                    /* Local index variables */
+
+    TESTING("file-wide chunk cache budget");
+
+    h5_fixname(FILENAME[30], fapl, filename, sizeof filename);
+
+    /* Check the property's default value and setting it */
+    if((my_fapl = H5Pcopy(fapl)) < 0) FAIL_STACK_ERROR
+    if(H5Pget_chunk_cache_budget(my_fapl, &nbytes) < 0) FAIL_STACK_ERROR
+    if(nbytes != 0) FAIL_PUTS_ERROR("wrong default chunk cache budget")
+    if(H5Pset_chunk_cache_budget(my_fapl, BUDGET_NBYTES) < 0) FAIL_STACK_ERROR
+
+    if((fid = H5Fcreate(filename, H5F_ACC_TRUNC, H5P_DEFAULT, my_fapl)) < 0) FAIL_STACK_ERROR
+
+    /* Check that the property is kept with the file */
+    if((fapl2 = H5Fget_access_plist(fid)) < 0) FAIL_STACK_ERROR
+    if(H5Pget_chunk_cache_budget(fapl2, &nbytes) < 0) FAIL_STACK_ERROR
+    if(nbytes != BUDGET_NBYTES) FAIL_PUTS_ERROR("wrong chunk cache budget")
+    if(H5Pclose(fapl2) < 0) FAIL_STACK_ERROR
+    fapl2 = -1;
+
+    /* Create filtered datasets with caches big enough for all their chunks */
+    if((sid = H5Screate_simple(1, &dim, NULL)) < 0) FAIL_STACK_ERROR
+    if((mid = H5Screate_simple(1, &count, NULL)) < 0) FAIL_STACK_ERROR
+    if((dcpl = H5Pcreate(H5P_DATASET_CREATE)) < 0) FAIL_STACK_ERROR
+    if(H5Pset_chunk(dcpl, 1, &chunk_dim) < 0) FAIL_STACK_ERROR
+    if(H5Pset_shuffle(dcpl) < 0) FAIL_STACK_ERROR
+    if((dapl = H5Pcreate(H5P_DATASET_ACCESS)) < 0) FAIL_STACK_ERROR
+    if(H5Pset_chunk_cache(dapl, (size_t)10007, BUDGET_NCHUNKS * BUDGET_CHUNK * sizeof(int), H5D_CHUNK_CACHE_W0_DEFAULT) < 0)
+        FAIL_STACK_ERROR
+    for(j = 0; j < BUDGET_NDSETS; j++) {
+        HDsprintf(dname, "dset%d", j);
+        if((dsid[j] = H5Dcreate2(fid, dname, H5T_NATIVE_INT, sid, H5P_DEFAULT, dcpl, dapl)) < 0)
+            FAIL_STACK_ERROR
+    } /* end for */
+
+    /* Write the datasets a chunk at a time, round robin, so that each
+     * dataset has to preempt its own dirty chunks to stay within the
+     * budget */
+    for(i = 0; i < BUDGET_NCHUNKS; i++)
+        for(j = 0; j < BUDGET_NDSETS; j++) {
+            start = (hsize_t)i * BUDGET_CHUNK;
+            for(k = 0; k < BUDGET_CHUNK; k++)
+                buf[k] = (j * BUDGET_NCHUNKS * BUDGET_CHUNK) + (int)start + k;
+            if(H5Sselect_hyperslab(sid, H5S_SELECT_SET, &start, NULL, &count, NULL) < 0) FAIL_STACK_ERROR
+            if(H5Dwrite(dsid[j], H5T_NATIVE_INT, mid, sid, H5P_DEFAULT, buf) < 0) FAIL_STACK_ERROR
+
+            /* Check that the caches stay within the budget */
+            for(k = 0, total = 0; k < BUDGET_NDSETS; k++)
+                if(dsid[k] >= 0) {
+                    if(H5D__current_cache_size_test(dsid[k], &nbytes, NULL) < 0) FAIL_STACK_ERROR
+                    total += nbytes;
+                } /* end if */
+            if(total > BUDGET_NBYTES) FAIL_PUTS_ERROR("chunk caches exceed the budget")
+        } /* end for */
+
+    /* Read the datasets back in the same order while they are open, so
+     * that clean chunks are preempted on behalf of the other datasets */
+    for(i = 0; i < BUDGET_NCHUNKS; i++)
+        for(j = 0; j < BUDGET_NDSETS; j++) {
+            start = (hsize_t)i * BUDGET_CHUNK;
+            if(H5Sselect_hyperslab(sid, H5S_SELECT_SET, &start, NULL, &count, NULL) < 0) FAIL_STACK_ERROR
+            if(H5Dread(dsid[j], H5T_NATIVE_INT, mid, sid, H5P_DEFAULT, buf) < 0) FAIL_STACK_ERROR
+            for(k = 0; k < BUDGET_CHUNK; k++)
+                if(buf[k] != (j * BUDGET_NCHUNKS * BUDGET_CHUNK) + (int)start + k)
+                    TEST_ERROR
+        } /* end for */
+
+    /* Close one dataset; the others keep sharing the budget */
+    if(H5Dclose(dsid[0]) < 0) FAIL_STACK_ERROR
+    dsid[0] = -1;
+    start = 0;
+    if(H5Sselect_hyperslab(sid, H5S_SELECT_SET, &start, NULL, &count, NULL) < 0) FAIL_STACK_ERROR
+    for(j = 1; j < BUDGET_NDSETS; j++)
+        if(H5Dread(dsid[j], H5T_NATIVE_INT, mid, sid, H5P_DEFAULT, buf) < 0) FAIL_STACK_ERROR
+    for(j = 1; j < BUDGET_NDSETS; j++) {
+        if(H5Dclose(dsid[j]) < 0) FAIL_STACK_ERROR
+        dsid[j] = -1;
+    } /* end for */
+    if(H5Fclose(fid) < 0) FAIL_STACK_ERROR
+    fid = -1;
+
+    /* Verify the data after reopening the file without a budget */
+    if((fid = H5Fopen(filename, H5F_ACC_RDONLY, fapl)) < 0) FAIL_STACK_ERROR
+    for(j = 0; j < BUDGET_NDSETS; j++) {
+        HDsprintf(dname, "dset%d", j);
+        if((dsid[j] = H5Dopen2(fid, dname, H5P_DEFAULT)) < 0) FAIL_STACK_ERROR
+        for(i = 0; i < BUDGET_NCHUNKS; i++) {
+            start = (hsize_t)i * BUDGET_CHUNK;
+            if(H5Sselect_hyperslab(sid, H5S_SELECT_SET, &start, NULL, &count, NULL) < 0) FAIL_STACK_ERROR
+            if(H5Dread(dsid[j], H5T_NATIVE_INT, mid, sid, H5P_DEFAULT, buf) < 0) FAIL_STACK_ERROR
+            for(k = 0; k < BUDGET_CHUNK; k++)
+                if(buf[k] != (j * BUDGET_NCHUNKS * BUDGET_CHUNK) + (int)start + k)
+                    TEST_ERROR
+        } /* end for */
+        if(H5Dclose(dsid[j]) < 0) FAIL_STACK_ERROR
+        dsid[j] = -1;
+    } /* end for */
+
+    /* Release resources */
+    if(H5Pclose(dapl) < 0) FAIL_STACK_ERROR
+    if(H5Pclose(dcpl) < 0) FAIL_STACK_ERROR
+    if(H5Pclose(my_fapl) < 0) FAIL_STACK_ERROR
+    if(H5Sclose(mid) < 0) FAIL_STACK_ERROR
+    if(H5Sclose(sid) < 0) FAIL_STACK_ERROR
+    if(H5Fclose(fid) < 0) FAIL_STACK_ERROR
+
+    PASSED();
+    return SUCCEED;
+
+error:
+    H5E_BEGIN_TRY {
+        for(j = 0; j < BUDGET_NDSETS; j++)
+            H5Dclose(dsid[j]);
+        H5Pclose(dapl);
+        H5Pclose(dcpl);
+        H5Pclose(fapl2);
+        H5Pclose(my_fapl);
+        H5Sclose(mid);
+        H5Sclose(sid);
+        H5Fclose(fid);
+    } H5E_END_TRY;
+    return FAIL;
+} /* end test_chunk_cache_budget() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:    test_chunk_cache_stats
+ *
+ * Purpose:     Tests H5Dget_chunk_cache_stats and
+ *              H5Dreset_chunk_cache_stats.  Writes a filtered dataset
+ *              through a chunk cache that holds a few chunks, so most
+ *              chunks are preempted and flushed, then resets the
+ *              statistics and reads a chunk twice, for one miss and one
+ *              hit.
+ *
+ * Return:      Success: 0
+ *              Failure: -1
+ *
+ *-------------------------------------------------------------------------
+ */
+#define STATS_NCHUNKS       16
+#define STATS_CHUNK         100
+static herr_t
+test_chunk_cache_stats(hid_t fapl)
+{
+    char        filename[FILENAME_BUF_SIZE];
+    hid_t       fid = -1;                   /* File ID */
+    hid_t       dcpl = -1;                  /* Dataset creation property list ID */
+    hid_t       dapl = -1;                  /* Dataset access property list ID */
+    hid_t       sid = -1;                   /* Dataspace ID */
+    hid_t       mid = -1;                   /* Memory space ID */
+    hid_t       dsid = -1;                  /* Dataset ID */
+    hid_t       csid = -1;                  /* Contiguous dataset ID */
+    hsize_t     dim = STATS_NCHUNKS * STATS_CHUNK;  /* Dataset dimensions */
+    hsize_t     chunk_dim = STATS_CHUNK;            /* Chunk dimensions */
+    hsize_t     start, count = STATS_CHUNK;         /* Hyperslab selection */
+    int         buf[STATS_CHUNK];           /* Data buffer */
+    H5D_chunk_cache_stats_t stats;          /* Chunk cache statistics */
+    herr_t      ret;                        /* Generic return value */
+    int         i, k;                       /* Local index variables */
+
+    TESTING("chunk cache statistics");
+
+    h5_fixname(FILENAME[31], fapl, filename, sizeof filename);
+
+    if((fid = H5Fcreate(filename, H5F_ACC_TRUNC, H5P_DEFAULT, fapl)) < 0) FAIL_STACK_ERROR
+    if((sid = H5Screate_simple(1, &dim, NULL)) < 0) FAIL_STACK_ERROR
+    if((mid = H5Screate_simple(1, &count, NULL)) < 0) FAIL_STACK_ERROR
+
+    /* Datasets that aren't chunked have no chunk cache */
+    if((csid = H5Dcreate2(fid, "contig", H5T_NATIVE_INT, sid, H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT)) < 0)
+        FAIL_STACK_ERROR
+    H5E_BEGIN_TRY {
+        ret = H5Dget_chunk_cache_stats(csid, &stats);
+    } H5E_END_TRY;
+    if(ret >= 0) FAIL_PUTS_ERROR("statistics of a contiguous dataset")
+    if(H5Dclose(csid) < 0) FAIL_STACK_ERROR
+    csid = -1;
+
+    /* Create a filtered dataset with a cache of 4 chunks */
+    if((dcpl = H5Pcreate(H5P_DATASET_CREATE)) < 0) FAIL_STACK_ERROR
+    if(H5Pset_chunk(dcpl, 1, &chunk_dim) < 0) FAIL_STACK_ERROR
+    if(H5Pset_shuffle(dcpl) < 0) FAIL_STACK_ERROR
+    if((dapl = H5Pcreate(H5P_DATASET_ACCESS)) < 0) FAIL_STACK_ERROR
+    if(H5Pset_chunk_cache(dapl, (size_t)10007, 4 * STATS_CHUNK * sizeof(int), H5D_CHUNK_CACHE_W0_DEFAULT) < 0)
+        FAIL_STACK_ERROR
+    if((dsid = H5Dcreate2(fid, "dset", H5T_NATIVE_INT, sid, H5P_DEFAULT, dcpl, dapl)) < 0)
+        FAIL_STACK_ERROR
+    H5E_BEGIN_TRY {
+        ret = H5Dget_chunk_cache_stats(dsid, NULL);
+    } H5E_END_TRY;
+    if(ret >= 0) FAIL_PUTS_ERROR("NULL pointer accepted")
+
+    /* A new dataset starts with empty statistics */
+    if(H5Dget_chunk_cache_stats(dsid, &stats) < 0) FAIL_STACK_ERROR
+    if(stats.nhits || stats.nmisses || stats.nreads || stats.nevictions || stats.npreemptions
+            || stats.nflushes || stats.nbytes_decoded || stats.nbytes_encoded)
+        FAIL_PUTS_ERROR("statistics of a new dataset not empty")
+
+    /* Write the dataset a chunk at a time */
+    for(i = 0; i < STATS_NCHUNKS; i++) {
+        start = (hsize_t)i * STATS_CHUNK;
+        for(k = 0; k < STATS_CHUNK; k++)
+            buf[k] = (int)start + k;
+        if(H5Sselect_hyperslab(sid, H5S_SELECT_SET, &start, NULL, &count, NULL) < 0) FAIL_STACK_ERROR
+        if(H5Dwrite(dsid, H5T_NATIVE_INT, mid, sid, H5P_DEFAULT, buf) < 0) FAIL_STACK_ERROR
+    } /* end for */
+
+    /* All but the last 4 chunks have been preempted and written out */
+    if(H5Dget_chunk_cache_stats(dsid, &stats) < 0) FAIL_STACK_ERROR
+    if(stats.npreemptions != STATS_NCHUNKS - 4) FAIL_PUTS_ERROR("wrong # of preemptions")
+    if(stats.nevictions != STATS_NCHUNKS - 4) FAIL_PUTS_ERROR("wrong # of evictions")
+    if(stats.nflushes != STATS_NCHUNKS - 4) FAIL_PUTS_ERROR("wrong # of flushes")
+    if(stats.nbytes_encoded != (STATS_NCHUNKS - 4) * STATS_CHUNK * sizeof(int))
+        FAIL_PUTS_ERROR("wrong # of bytes encoded")
+    if(stats.nmisses != 0 || stats.nbytes_decoded != 0) FAIL_PUTS_ERROR("chunks read while writing")
+    if(stats.filter_time < 0.0) FAIL_PUTS_ERROR("negative filter time")
+
+    /* Reset the statistics */
+    if(H5Dreset_chunk_cache_stats(dsid) < 0) FAIL_STACK_ERROR
+    if(H5Dget_chunk_cache_stats(dsid, &stats) < 0) FAIL_STACK_ERROR
+    if(stats.npreemptions || stats.nevictions || stats.nflushes || stats.nbytes_encoded)
+        FAIL_PUTS_ERROR("statistics not reset")
+
+    /* Read the first chunk twice: one miss, then one hit */
+    start = 0;
+    if(H5Sselect_hyperslab(sid, H5S_SELECT_SET, &start, NULL, &count, NULL) < 0) FAIL_STACK_ERROR
+    for(i = 0; i < 2; i++) {
+        if(H5Dread(dsid, H5T_NATIVE_INT, mid, sid, H5P_DEFAULT, buf) < 0) FAIL_STACK_ERROR
+        for(k = 0; k < STATS_CHUNK; k++)
+            if(buf[k] != k)
+                TEST_ERROR
+    } /* end for */
+    if(H5Dget_chunk_cache_stats(dsid, &stats) < 0) FAIL_STACK_ERROR
+    if(stats.nmisses != 1) FAIL_PUTS_ERROR("wrong # of misses")
+    if(stats.nhits != 1) FAIL_PUTS_ERROR("wrong # of hits")
+    if(stats.nbytes_decoded != STATS_CHUNK * sizeof(int)) FAIL_PUTS_ERROR("wrong # of bytes decoded")
+    if(stats.npreemptions != 1) FAIL_PUTS_ERROR("wrong # of preemptions")
+
+    /* Release resources */
+    if(H5Dclose(dsid) < 0) FAIL_STACK_ERROR
+    if(H5Pclose(dapl) < 0) FAIL_STACK_ERROR
+    if(H5Pclose(dcpl) < 0) FAIL_STACK_ERROR
+    if(H5Sclose(mid) < 0) FAIL_STACK_ERROR
+    if(H5Sclose(sid) < 0) FAIL_STACK_ERROR
+    if(H5Fclose(fid) < 0) FAIL_STACK_ERROR
+
+    PASSED();
+    return SUCCEED;
+
+error:
+    H5E_BEGIN_TRY {
+        H5Dclose(csid);
+        H5Dclose(dsid);
+        H5Pclose(dapl);
+        H5Pclose(dcpl);
+        H5Sclose(mid);
+        H5Sclose(sid);
+        H5Fclose(fid);
+    } H5E_END_TRY;
+    return FAIL;
+} /* end test_chunk_cache_stats() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:    test_chunk_addr_table
+ *
+ * Purpose:     Tests the chunk address table DAPL property.  Writes some
+ *              of the chunks of a fixed size and of an extendible
+ *              dataset, then reads all the chunks in random order from
+ *              the file opened read-only with the table, and checks the
+ *              data and that the table was loaded.  Also checks that the
+ *              table isn't used when the file is opened read-write.
+ *
+ * Return:      Success: 0
+ *              Failure: -1
+ *
+ *-------------------------------------------------------------------------
+ */
+#define ADDR_TABLE_NCHUNKS  8
+#define ADDR_TABLE_CHUNK    10
+#define ADDR_TABLE_DIM      (ADDR_TABLE_NCHUNKS * ADDR_TABLE_CHUNK)
+static herr_t
+test_chunk_addr_table(hid_t fapl)
+{
+    char        filename[FILENAME_BUF_SIZE];
+    const char  *dnames[2] = {"fixed", "extendible"};  /* Dataset names */
+    hid_t       fid = -1;                   /* File ID */
+    hid_t       dcpl = -1;                  /* Dataset creation property list ID */
+    hid_t       dapl = -1;                  /* Dataset access property list ID */
+    hid_t       dapl2 = -1;                 /* Dataset access property list ID from dataset */
+    hid_t       sid = -1;                   /* Dataspace ID */
+    hid_t       mid = -1;                   /* Memory space ID */
+    hid_t       dsid = -1;                  /* Dataset ID */
+    hsize_t     dims[2] = {ADDR_TABLE_DIM, ADDR_TABLE_DIM};     /* Dataset dimensions */
+    hsize_t     max_dims[2] = {ADDR_TABLE_DIM, H5S_UNLIMITED};  /* Maximum dimensions of the extendible dataset */
+    hsize_t     chunk_dims[2] = {ADDR_TABLE_CHUNK, ADDR_TABLE_CHUNK};  /* Chunk dimensions */
+    hsize_t     start[2];                   /* Hyperslab selection */
+    int         fill = -1;                  /* Fill value */
+    int         buf[ADDR_TABLE_CHUNK][ADDR_TABLE_CHUNK];        /* Data buffer */
+    hbool_t     use_table;                  /* Chunk address table setting */
+    hbool_t     loaded;                     /* Whether the table is loaded */
+    int         d, n, i, k, l;              /* Local index variables */
+
+    TESTING("chunk address table");
+
+    h5_fixname(FILENAME[32], fapl, filename, sizeof filename);
+
+    /* Check the property's default value and setting it */
+    if((dapl = H5Pcreate(H5P_DATASET_ACCESS)) < 0) FAIL_STACK_ERROR
+    if(H5Pget_chunk_addr_table(dapl, &use_table) < 0) FAIL_STACK_ERROR
+    if(use_table) FAIL_PUTS_ERROR("wrong default chunk address table setting")
+    if(H5Pset_chunk_addr_table(dapl, TRUE) < 0) FAIL_STACK_ERROR
+
+    /* Create the datasets and write every chunk but every third one */
+    if((fid = H5Fcreate(filename, H5F_ACC_TRUNC, H5P_DEFAULT, fapl)) < 0) FAIL_STACK_ERROR
+    if((mid = H5Screate_simple(2, chunk_dims, NULL)) < 0) FAIL_STACK_ERROR
+    if((dcpl = H5Pcreate(H5P_DATASET_CREATE)) < 0) FAIL_STACK_ERROR
+    if(H5Pset_chunk(dcpl, 2, chunk_dims) < 0) FAIL_STACK_ERROR
+    if(H5Pset_fill_value(dcpl, H5T_NATIVE_INT, &fill) < 0) FAIL_STACK_ERROR
+    for(d = 0; d < 2; d++) {
+        if((sid = H5Screate_simple(2, dims, d ? max_dims : NULL)) < 0) FAIL_STACK_ERROR
+        if((dsid = H5Dcreate2(fid, dnames[d], H5T_NATIVE_INT, sid, H5P_DEFAULT, dcpl, dapl)) < 0)
+            FAIL_STACK_ERROR
+        for(n = 0; n < ADDR_TABLE_NCHUNKS * ADDR_TABLE_NCHUNKS; n++) {
+            if(n % 3 == 0)
+                continue;
+            start[0] = (hsize_t)(n / ADDR_TABLE_NCHUNKS) * ADDR_TABLE_CHUNK;
+            start[1] = (hsize_t)(n % ADDR_TABLE_NCHUNKS) * ADDR_TABLE_CHUNK;
+            for(k = 0; k < ADDR_TABLE_CHUNK; k++)
+                for(l = 0; l < ADDR_TABLE_CHUNK; l++)
+                    buf[k][l] = (d * 100000) + (int)((start[0] + (hsize_t)k) * ADDR_TABLE_DIM + start[1] + (hsize_t)l);
+            if(H5Sselect_hyperslab(sid, H5S_SELECT_SET, start, NULL, chunk_dims, NULL) < 0) FAIL_STACK_ERROR
+            if(H5Dwrite(dsid, H5T_NATIVE_INT, mid, sid, H5P_DEFAULT, buf) < 0) FAIL_STACK_ERROR
+        } /* end for */
+
+        /* The table isn't used while the file is writable */
+        if(H5D__chunk_addr_table_test(dsid, &loaded) < 0) FAIL_STACK_ERROR
+        if(loaded) FAIL_PUTS_ERROR("chunk address table used in a writable file")
+
+        if(H5Dclose(dsid) < 0) FAIL_STACK_ERROR
+        dsid = -1;
+        if(H5Sclose(sid) < 0) FAIL_STACK_ERROR
+        sid = -1;
+    } /* end for */
+    if(H5Fclose(fid) < 0) FAIL_STACK_ERROR
+    fid = -1;
+
+    /* Read all the chunks back in random order from the file opened read-only */
+    if((fid = H5Fopen(filename, H5F_ACC_RDONLY, fapl)) < 0) FAIL_STACK_ERROR
+    for(d = 0; d < 2; d++) {
+        if((dsid = H5Dopen2(fid, dnames[d], dapl)) < 0) FAIL_STACK_ERROR
+        if((sid = H5Dget_space(dsid)) < 0) FAIL_STACK_ERROR
+
+        /* Check that the property is kept with the dataset */
+        if((dapl2 = H5Dget_access_plist(dsid)) < 0) FAIL_STACK_ERROR
+        if(H5Pget_chunk_addr_table(dapl2, &use_table) < 0) FAIL_STACK_ERROR
+        if(!use_table) FAIL_PUTS_ERROR("wrong chunk address table setting")
+        if(H5Pclose(dapl2) < 0) FAIL_STACK_ERROR
+        dapl2 = -1;
+
+        /* The table is loaded on the first lookup */
+        if(H5D__chunk_addr_table_test(dsid, &loaded) < 0) FAIL_STACK_ERROR
+        if(loaded) FAIL_PUTS_ERROR("chunk address table loaded too early")
+
+        for(i = 0; i < ADDR_TABLE_NCHUNKS * ADDR_TABLE_NCHUNKS; i++) {
+            n = (i * 37) % (ADDR_TABLE_NCHUNKS * ADDR_TABLE_NCHUNKS);
+            start[0] = (hsize_t)(n / ADDR_TABLE_NCHUNKS) * ADDR_TABLE_CHUNK;
+            start[1] = (hsize_t)(n % ADDR_TABLE_NCHUNKS) * ADDR_TABLE_CHUNK;
+            if(H5Sselect_hyperslab(sid, H5S_SELECT_SET, start, NULL, chunk_dims, NULL) < 0) FAIL_STACK_ERROR
+            if(H5Dread(dsid, H5T_NATIVE_INT, mid, sid, H5P_DEFAULT, buf) < 0) FAIL_STACK_ERROR
+            for(k = 0; k < ADDR_TABLE_CHUNK; k++)
+                for(l = 0; l < ADDR_TABLE_CHUNK; l++)
+                    if(buf[k][l] != (n % 3 == 0 ? fill :
+                            (d * 100000) + (int)((start[0] + (hsize_t)k) * ADDR_TABLE_DIM + start[1] + (hsize_t)l)))
+                        TEST_ERROR
+        } /* end for */
+
+        if(H5D__chunk_addr_table_test(dsid, &loaded) < 0) FAIL_STACK_ERROR
+        if(!loaded) FAIL_PUTS_ERROR("chunk address table not loaded")
+
+        if(H5Dclose(dsid) < 0) FAIL_STACK_ERROR
+        dsid = -1;
+        if(H5Sclose(sid) < 0) FAIL_STACK_ERROR
+        sid = -1;
+    } /* end for */
+
+    /* Release resources */
+    if(H5Pclose(dapl) < 0) FAIL_STACK_ERROR
+    if(H5Pclose(dcpl) < 0) FAIL_STACK_ERROR
+    if(H5Sclose(mid) < 0) FAIL_STACK_ERROR
+    if(H5Fclose(fid) < 0) FAIL_STACK_ERROR
+
+    PASSED();
+    return SUCCEED;
+
+error:
+    H5E_BEGIN_TRY {
+        H5Dclose(dsid);
+        H5Pclose(dapl);
+        H5Pclose(dapl2);
+        H5Pclose(dcpl);
+        H5Sclose(mid);
+        H5Sclose(sid);
+        H5Fclose(fid);
+    } H5E_END_TRY;
+    return FAIL;
+} /* end test_chunk_addr_table() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:    test_chunk_read_coalesce
+ *
+ * Purpose:     Tests the DAPL property for coalescing the reads of chunks
+ *              stored next to each other in the file.  Writes an
+ *              unfiltered and a filtered dataset, reads each back whole
+ *              with and without coalescing, and checks the data and that
+ *              fewer reads were made with coalescing when the chunks are
+ *              stored back to back.
+ *
+ * Return:      Success: 0
+ *              Failure: -1
+ *
+ *-------------------------------------------------------------------------
+ */
+#define COALESCE_NCHUNKS    32
+#define COALESCE_CHUNK      256
+#define COALESCE_GROUP      8
+static herr_t
+test_chunk_read_coalesce(hid_t fapl)
+{
+    char        filename[FILENAME_BUF_SIZE];
+    const char  *dnames[2] = {"plain", "shuffled"}; /* Dataset names */
+    hid_t       fid = -1;                   /* File ID */
+    hid_t       dcpl = -1;                  /* Dataset creation property list ID */
+    hid_t       dapl = -1;                  /* Dataset access property list ID */
+    hid_t       sid = -1;                   /* Dataspace ID */
+    hid_t       dsid = -1;                  /* Dataset ID */
+    hsize_t     dim = COALESCE_NCHUNKS * COALESCE_CHUNK;    /* Dataset dimensions */
+    hsize_t     chunk_dim = COALESCE_CHUNK; /* Chunk dimensions */
+    hsize_t     offset;                     /* Chunk offset */
+    haddr_t     addr, next_addr = HADDR_UNDEF;  /* Chunk addresses */
+    hsize_t     size;                       /* Chunk size */
+    unsigned    filter_mask;                /* Chunk filter mask */
+    hbool_t     adjacent;                   /* Whether the chunks are back to back */
+    size_t      max_nbytes;                 /* Coalescing setting */
+    H5D_chunk_cache_stats_t stats;          /* Chunk cache statistics */
+    int         *wbuf = NULL;               /* Data written */
+    int         *rbuf = NULL;               /* Data read */
+    int         d, c, i;                    /* Local index variables */
+
+    TESTING("coalescing chunk reads");
+
+    h5_fixname(FILENAME[33], fapl, filename, sizeof filename);
+
+    if(NULL == (wbuf = (int *)HDmalloc(COALESCE_NCHUNKS * COALESCE_CHUNK * sizeof(int)))) TEST_ERROR
+    if(NULL == (rbuf = (int *)HDmalloc(COALESCE_NCHUNKS * COALESCE_CHUNK * sizeof(int)))) TEST_ERROR
+    for(i = 0; i < COALESCE_NCHUNKS * COALESCE_CHUNK; i++)
+        wbuf[i] = i;
+
+    /* Check the property's default value and setting it */
+    if((dapl = H5Pcreate(H5P_DATASET_ACCESS)) < 0) FAIL_STACK_ERROR
+    if(H5Pget_chunk_read_coalesce(dapl, &max_nbytes) < 0) FAIL_STACK_ERROR
+    if(max_nbytes != 0) FAIL_PUTS_ERROR("wrong default coalescing setting")
+    if(H5Pset_chunk_read_coalesce(dapl, (size_t)(COALESCE_GROUP * COALESCE_CHUNK * sizeof(int))) < 0)
+        FAIL_STACK_ERROR
+    if(H5Pget_chunk_read_coalesce(dapl, &max_nbytes) < 0) FAIL_STACK_ERROR
+    if(max_nbytes != COALESCE_GROUP * COALESCE_CHUNK * sizeof(int)) FAIL_PUTS_ERROR("wrong coalescing setting")
+
+    /* Use a cache big enough for two groups of chunks */
+    if(H5Pset_chunk_cache(dapl, (size_t)10007, 2 * COALESCE_GROUP * COALESCE_CHUNK * sizeof(int), H5D_CHUNK_CACHE_W0_DEFAULT) < 0)
+        FAIL_STACK_ERROR
+
+    /* Create the datasets, with the chunks allocated up front */
+    if((fid = H5Fcreate(filename, H5F_ACC_TRUNC, H5P_DEFAULT, fapl)) < 0) FAIL_STACK_ERROR
+    if((sid = H5Screate_simple(1, &dim, NULL)) < 0) FAIL_STACK_ERROR
+    for(d = 0; d < 2; d++) {
+        if((dcpl = H5Pcreate(H5P_DATASET_CREATE)) < 0) FAIL_STACK_ERROR
+        if(H5Pset_chunk(dcpl, 1, &chunk_dim) < 0) FAIL_STACK_ERROR
+        if(H5Pset_alloc_time(dcpl, H5D_ALLOC_TIME_EARLY) < 0) FAIL_STACK_ERROR
+        if(d && H5Pset_shuffle(dcpl) < 0) FAIL_STACK_ERROR
+        if((dsid = H5Dcreate2(fid, dnames[d], H5T_NATIVE_INT, sid, H5P_DEFAULT, dcpl, H5P_DEFAULT)) < 0)
+            FAIL_STACK_ERROR
+        if(H5Dwrite(dsid, H5T_NATIVE_INT, H5S_ALL, H5S_ALL, H5P_DEFAULT, wbuf) < 0) FAIL_STACK_ERROR
+        if(H5Dclose(dsid) < 0) FAIL_STACK_ERROR
+        dsid = -1;
+        if(H5Pclose(dcpl) < 0) FAIL_STACK_ERROR
+        dcpl = -1;
+    } /* end for */
+    if(H5Fclose(fid) < 0) FAIL_STACK_ERROR
+    fid = -1;
+
+    if((fid = H5Fopen(filename, H5F_ACC_RDONLY, fapl)) < 0) FAIL_STACK_ERROR
+    for(d = 0; d < 2; d++) {
+        /* Read the dataset with coalescing */
+        if((dsid = H5Dopen2(fid, dnames[d], dapl)) < 0) FAIL_STACK_ERROR
+        HDmemset(rbuf, 0, COALESCE_NCHUNKS * COALESCE_CHUNK * sizeof(int));
+        if(H5Dread(dsid, H5T_NATIVE_INT, H5S_ALL, H5S_ALL, H5P_DEFAULT, rbuf) < 0) FAIL_STACK_ERROR
+        for(i = 0; i < COALESCE_NCHUNKS * COALESCE_CHUNK; i++)
+            if(rbuf[i] != wbuf[i])
+                TEST_ERROR
+        if(H5Dget_chunk_cache_stats(dsid, &stats) < 0) FAIL_STACK_ERROR
+        if(stats.nmisses != COALESCE_NCHUNKS) FAIL_PUTS_ERROR("wrong # of misses")
+
+        /* Check whether the chunks are stored back to back, which depends
+         * on the file driver */
+        adjacent = TRUE;
+        for(c = 0; c < COALESCE_NCHUNKS; c++) {
+            offset = (hsize_t)c * COALESCE_CHUNK;
+            if(H5Dget_chunk_info_by_coord(dsid, &offset, &filter_mask, &addr, &size) < 0) FAIL_STACK_ERROR
+            if(c > 0 && addr != next_addr)
+                adjacent = FALSE;
+            next_addr = addr + size;
+        } /* end for */
+        if(adjacent && stats.nreads != COALESCE_NCHUNKS / COALESCE_GROUP)
+            FAIL_PUTS_ERROR("wrong # of coalesced reads")
+        if(stats.nreads > COALESCE_NCHUNKS) FAIL_PUTS_ERROR("too many reads")
+        if(H5Dclose(dsid) < 0) FAIL_STACK_ERROR
+        dsid = -1;
+
+        /* Read the dataset without coalescing */
+        if((dsid = H5Dopen2(fid, dnames[d], H5P_DEFAULT)) < 0) FAIL_STACK_ERROR
+        HDmemset(rbuf, 0, COALESCE_NCHUNKS * COALESCE_CHUNK * sizeof(int));
+        if(H5Dread(dsid, H5T_NATIVE_INT, H5S_ALL, H5S_ALL, H5P_DEFAULT, rbuf) < 0) FAIL_STACK_ERROR
+        for(i = 0; i < COALESCE_NCHUNKS * COALESCE_CHUNK; i++)
+            if(rbuf[i] != wbuf[i])
+                TEST_ERROR
+        if(H5Dget_chunk_cache_stats(dsid, &stats) < 0) FAIL_STACK_ERROR
+        if(stats.nreads != stats.nmisses) FAIL_PUTS_ERROR("reads coalesced when not asked to")
+        if(H5Dclose(dsid) < 0) FAIL_STACK_ERROR
+        dsid = -1;
+    } /* end for */
+
+    /* Release resources */
+    if(H5Pclose(dapl) < 0) FAIL_STACK_ERROR
+    if(H5Sclose(sid) < 0) FAIL_STACK_ERROR
+    if(H5Fclose(fid) < 0) FAIL_STACK_ERROR
+    HDfree(wbuf);
+    HDfree(rbuf);
+
+    PASSED();
+    return SUCCEED;
+
+error:
+    H5E_BEGIN_TRY {
+        H5Dclose(dsid);
+        H5Pclose(dapl);
+        H5Pclose(dcpl);
+        H5Sclose(sid);
+        H5Fclose(fid);
+    } H5E_END_TRY;
+    HDfree(wbuf);
+    HDfree(rbuf);
+    return FAIL;
+} /* end test_chunk_read_coalesce() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:    test_chunk_buf_pool
+ *
+ * Purpose:     Tests reusing the buffers of filtered chunks.  Writes and
+ *              reads a filtered and an unfiltered dataset a chunk at a
+ *              time through a cache that holds two chunks, checks the
+ *              data, and that only the filtered dataset keeps freed
+ *              buffers, no more than the cache can hold.
+ *
+ * Return:      Success: 0
+ *              Failure: -1
+ *
+ *-------------------------------------------------------------------------
+ */
+#define BUF_POOL_NCHUNKS    16
+#define BUF_POOL_CHUNK      100
+static herr_t
+test_chunk_buf_pool(hid_t fapl)
+{
+    char        filename[FILENAME_BUF_SIZE];
+    const char  *dnames[2] = {"plain", "filtered"}; /* Dataset names */
+    hid_t       fid = -1;                   /* File ID */
+    hid_t       dcpl = -1;                  /* Dataset creation property list ID */
+    hid_t       dapl = -1;                  /* Dataset access property list ID */
+    hid_t       sid = -1;                   /* Dataspace ID */
+    hid_t       mid = -1;                   /* Memory space ID */
+    hid_t       dsid = -1;                  /* Dataset ID */
+    hsize_t     dim = BUF_POOL_NCHUNKS * BUF_POOL_CHUNK;    /* Dataset dimensions */
+    hsize_t     chunk_dim = BUF_POOL_CHUNK; /* Chunk dimensions */
+    hsize_t     start;                      /* Hyperslab selection */
+    int         buf[BUF_POOL_CHUNK];        /* Data buffer */
+    size_t      nbufs;                      /* # of buffers in the pool */
+    size_t      nbytes;                     /* Size of the buffers in the pool */
+    int         d, pass, n, i;              /* Local index variables */
+
+    TESTING("reusing filtered chunk buffers");
+
+    h5_fixname(FILENAME[34], fapl, filename, sizeof filename);
+
+    /* Use a cache that holds two chunks */
+    if((dapl = H5Pcreate(H5P_DATASET_ACCESS)) < 0) FAIL_STACK_ERROR
+    if(H5Pset_chunk_cache(dapl, (size_t)101, 2 * BUF_POOL_CHUNK * sizeof(int), H5D_CHUNK_CACHE_W0_DEFAULT) < 0)
+        FAIL_STACK_ERROR
+
+    if((fid = H5Fcreate(filename, H5F_ACC_TRUNC, H5P_DEFAULT, fapl)) < 0) FAIL_STACK_ERROR
+    if((sid = H5Screate_simple(1, &dim, NULL)) < 0) FAIL_STACK_ERROR
+    if((mid = H5Screate_simple(1, &chunk_dim, NULL)) < 0) FAIL_STACK_ERROR
+    for(d = 0; d < 2; d++) {
+        if((dcpl = H5Pcreate(H5P_DATASET_CREATE)) < 0) FAIL_STACK_ERROR
+        if(H5Pset_chunk(dcpl, 1, &chunk_dim) < 0) FAIL_STACK_ERROR
+        if(d) {
+            if(H5Pset_shuffle(dcpl) < 0) FAIL_STACK_ERROR
+            if(H5Pset_fletcher32(dcpl) < 0) FAIL_STACK_ERROR
+        } /* end if */
+        if((dsid = H5Dcreate2(fid, dnames[d], H5T_NATIVE_INT, sid, H5P_DEFAULT, dcpl, dapl)) < 0)
+            FAIL_STACK_ERROR
+        if(H5Pclose(dcpl) < 0) FAIL_STACK_ERROR
+        dcpl = -1;
+
+        /* Write each chunk, then read and rewrite them a few times, in an
+         * order that makes the cache evict a chunk every time */
+        for(pass = 0; pass < 3; pass++)
+            for(n = 0; n < BUF_POOL_NCHUNKS; n++) {
+                start = (hsize_t)((n * 5) % BUF_POOL_NCHUNKS) * BUF_POOL_CHUNK;
+                if(H5Sselect_hyperslab(sid, H5S_SELECT_SET, &start, NULL, &chunk_dim, NULL) < 0)
+                    FAIL_STACK_ERROR
+                if(pass > 0) {
+                    if(H5Dread(dsid, H5T_NATIVE_INT, mid, sid, H5P_DEFAULT, buf) < 0) FAIL_STACK_ERROR
+                    for(i = 0; i < BUF_POOL_CHUNK; i++)
+                        if(buf[i] != (pass - 1) * 100000 + (int)start + i)
+                            TEST_ERROR
+                } /* end if */
+                for(i = 0; i < BUF_POOL_CHUNK; i++)
+                    buf[i] = pass * 100000 + (int)start + i;
+                if(H5Dwrite(dsid, H5T_NATIVE_INT, mid, sid, H5P_DEFAULT, buf) < 0) FAIL_STACK_ERROR
+            } /* end for */
+
+        /* Check the pool */
+        if(H5D__chunk_pool_test(dsid, &nbufs, &nbytes) < 0) FAIL_STACK_ERROR
+        if(d ? (nbufs == 0 || nbytes == 0 || nbytes > 2 * BUF_POOL_CHUNK * sizeof(int)) : (nbufs != 0 || nbytes != 0))
+            FAIL_PUTS_ERROR("wrong # of buffers in the pool")
+
+        if(H5Dclose(dsid) < 0) FAIL_STACK_ERROR
+        dsid = -1;
+    } /* end for */
+    if(H5Fclose(fid) < 0) FAIL_STACK_ERROR
+    fid = -1;
+
+    /* Read the data back from the file opened read-only */
+    if((fid = H5Fopen(filename, H5F_ACC_RDONLY, fapl)) < 0) FAIL_STACK_ERROR
+    for(d = 0; d < 2; d++) {
+        if((dsid = H5Dopen2(fid, dnames[d], dapl)) < 0) FAIL_STACK_ERROR
+        for(n = 0; n < BUF_POOL_NCHUNKS; n++) {
+            start = (hsize_t)((n * 7) % BUF_POOL_NCHUNKS) * BUF_POOL_CHUNK;
+            if(H5Sselect_hyperslab(sid, H5S_SELECT_SET, &start, NULL, &chunk_dim, NULL) < 0)
+                FAIL_STACK_ERROR
+            if(H5Dread(dsid, H5T_NATIVE_INT, mid, sid, H5P_DEFAULT, buf) < 0) FAIL_STACK_ERROR
+            for(i = 0; i < BUF_POOL_CHUNK; i++)
+                if(buf[i] != 2 * 100000 + (int)start + i)
+                    TEST_ERROR
+        } /* end for */
+        if(H5D__chunk_pool_test(dsid, &nbufs, &nbytes) < 0) FAIL_STACK_ERROR
+        if(d ? (nbufs == 0 || nbytes == 0 || nbytes > 2 * BUF_POOL_CHUNK * sizeof(int)) : (nbufs != 0 || nbytes != 0))
+            FAIL_PUTS_ERROR("wrong # of buffers in the pool")
+        if(H5Dclose(dsid) < 0) FAIL_STACK_ERROR
+        dsid = -1;
+    } /* end for */
+
+    /* Release resources */
+    if(H5Pclose(dapl) < 0) FAIL_STACK_ERROR
+    if(H5Sclose(mid) < 0) FAIL_STACK_ERROR
+    if(H5Sclose(sid) < 0) FAIL_STACK_ERROR
+    if(H5Fclose(fid) < 0) FAIL_STACK_ERROR
+
+    PASSED();
+    return SUCCEED;
+
+error:
+    H5E_BEGIN_TRY {
+        H5Dclose(dsid);
+        H5Pclose(dapl);
+        H5Pclose(dcpl);
+        H5Sclose(mid);
+        H5Sclose(sid);
+        H5Fclose(fid);
+    } H5E_END_TRY;
+    return FAIL;
+} /* end test_chunk_buf_pool() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:    test_chunk_sel_points
+ *
+ * Purpose:     Tests I/O on point selections that touch many chunks in no
+ *              particular order.  Writes one point in every chunk, in a
+ *              scrambled order, then reads the dataset back whole and
+ *              through the same point selection, and checks the data.
+ *
+ * Return:      Success: 0
+ *              Failure: -1
+ *
+ *-------------------------------------------------------------------------
+ */
+#define SEL_POINTS_DIM      64
+#define SEL_POINTS_CHUNK    2
+#define SEL_POINTS_NPOINTS  ((SEL_POINTS_DIM / SEL_POINTS_CHUNK) * (SEL_POINTS_DIM / SEL_POINTS_CHUNK))
+static herr_t
+test_chunk_sel_points(hid_t fapl)
+{
+    char        filename[FILENAME_BUF_SIZE];
+    hid_t       fid = -1;                   /* File ID */
+    hid_t       dcpl = -1;                  /* Dataset creation property list ID */
+    hid_t       sid = -1;                   /* Dataspace ID */
+    hid_t       mid = -1;                   /* Memory space ID */
+    hid_t       dsid = -1;                  /* Dataset ID */
+    hsize_t     dims[2] = {SEL_POINTS_DIM, SEL_POINTS_DIM};     /* Dataset dimensions */
+    hsize_t     chunk_dims[2] = {SEL_POINTS_CHUNK, SEL_POINTS_CHUNK};  /* Chunk dimensions */
+    hsize_t     npoints = SEL_POINTS_NPOINTS;   /* Number of points selected */
+    hsize_t     *coords = NULL;             /* Coordinates of the points selected */
+    int         *wbuf = NULL;               /* Data written */
+    int         *rbuf = NULL;               /* Data read */
+    int         fill = -1;                  /* Fill value */
+    int         i, n;                       /* Local index variables */
+
+    TESTING("point selections across many chunks");
+
+    h5_fixname(FILENAME[35], fapl, filename, sizeof filename);
+
+    if(NULL == (coords = (hsize_t *)HDmalloc(2 * SEL_POINTS_NPOINTS * sizeof(hsize_t)))) TEST_ERROR
+    if(NULL == (wbuf = (int *)HDmalloc(SEL_POINTS_NPOINTS * sizeof(int)))) TEST_ERROR
+    if(NULL == (rbuf = (int *)HDmalloc(SEL_POINTS_DIM * SEL_POINTS_DIM * sizeof(int)))) TEST_ERROR
+
+    /* Select one point in every chunk, in a scrambled order */
+    for(i = 0; i < SEL_POINTS_NPOINTS; i++) {
+        n = (i * 389) % SEL_POINTS_NPOINTS;
+        coords[2 * i] = (hsize_t)(n / (SEL_POINTS_DIM / SEL_POINTS_CHUNK)) * SEL_POINTS_CHUNK + (hsize_t)(i % SEL_POINTS_CHUNK);
+        coords[2 * i + 1] = (hsize_t)(n % (SEL_POINTS_DIM / SEL_POINTS_CHUNK)) * SEL_POINTS_CHUNK + 1;
+        wbuf[i] = i;
+    } /* end for */
+
+    if((fid = H5Fcreate(filename, H5F_ACC_TRUNC, H5P_DEFAULT, fapl)) < 0) FAIL_STACK_ERROR
+    if((sid = H5Screate_simple(2, dims, NULL)) < 0) FAIL_STACK_ERROR
+    if((mid = H5Screate_simple(1, &npoints, NULL)) < 0) FAIL_STACK_ERROR
+    if((dcpl = H5Pcreate(H5P_DATASET_CREATE)) < 0) FAIL_STACK_ERROR
+    if(H5Pset_chunk(dcpl, 2, chunk_dims) < 0) FAIL_STACK_ERROR
+    if(H5Pset_fill_value(dcpl, H5T_NATIVE_INT, &fill) < 0) FAIL_STACK_ERROR
+    if((dsid = H5Dcreate2(fid, "points", H5T_NATIVE_INT, sid, H5P_DEFAULT, dcpl, H5P_DEFAULT)) < 0)
+        FAIL_STACK_ERROR
+
+    /* Write the points */
+    if(H5Sselect_elements(sid, H5S_SELECT_SET, (size_t)SEL_POINTS_NPOINTS, coords) < 0) FAIL_STACK_ERROR
+    if(H5Dwrite(dsid, H5T_NATIVE_INT, mid, sid, H5P_DEFAULT, wbuf) < 0) FAIL_STACK_ERROR
+
+    /* Read the whole dataset back */
+    if(H5Dread(dsid, H5T_NATIVE_INT, H5S_ALL, H5S_ALL, H5P_DEFAULT, rbuf) < 0) FAIL_STACK_ERROR
+    for(i = 0; i < SEL_POINTS_NPOINTS; i++) {
+        if(rbuf[coords[2 * i] * SEL_POINTS_DIM + coords[2 * i + 1]] != i)
+            TEST_ERROR
+        rbuf[coords[2 * i] * SEL_POINTS_DIM + coords[2 * i + 1]] = fill;
+    } /* end for */
+    for(i = 0; i < SEL_POINTS_DIM * SEL_POINTS_DIM; i++)
+        if(rbuf[i] != fill)
+            TEST_ERROR
+
+    /* Read the points back through the point selection */
+    HDmemset(rbuf, 0, SEL_POINTS_NPOINTS * sizeof(int));
+    if(H5Dread(dsid, H5T_NATIVE_INT, mid, sid, H5P_DEFAULT, rbuf) < 0) FAIL_STACK_ERROR
+    for(i = 0; i < SEL_POINTS_NPOINTS; i++)
+        if(rbuf[i] != i)
+            TEST_ERROR
+
+    /* Release resources */
+    if(H5Dclose(dsid) < 0) FAIL_STACK_ERROR
+    if(H5Pclose(dcpl) < 0) FAIL_STACK_ERROR
+    if(H5Sclose(mid) < 0) FAIL_STACK_ERROR
+    if(H5Sclose(sid) < 0) FAIL_STACK_ERROR
+    if(H5Fclose(fid) < 0) FAIL_STACK_ERROR
+    HDfree(coords);
+    HDfree(wbuf);
+    HDfree(rbuf);
+
+    PASSED();
+    return SUCCEED;
+
+error:
+    H5E_BEGIN_TRY {
+        H5Dclose(dsid);
+        H5Pclose(dcpl);
+        H5Sclose(mid);
+        H5Sclose(sid);
+        H5Fclose(fid);
+    } H5E_END_TRY;
+    HDfree(coords);
+    HDfree(wbuf);
+    HDfree(rbuf);
+    return FAIL;
+} /* end test_chunk_sel_points() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:    test_chunk_sel_hyper
+ *
+ * Purpose:     Tests I/O on strided hyperslab selections whose blocks
+ *              cross chunk boundaries and whose gaps skip whole chunks:
+ *              a regular hyperslab, the same one moved by a selection
+ *              offset, and an irregular union of it with another block.
+ *              Writes each selection to a new dataset, then reads the
+ *              dataset back whole and through the selection, and checks
+ *              the data.
+ *
+ * Return:      Success: 0
+ *              Failure: -1
+ *
+ *-------------------------------------------------------------------------
+ */
+#define SEL_HYPER_DIM       60
+#define SEL_HYPER_CHUNK     4
+static herr_t
+test_chunk_sel_hyper(hid_t fapl)
+{
+    char        filename[FILENAME_BUF_SIZE];
+    char        dname[16];                  /* Dataset name */
+    hid_t       fid = -1;                   /* File ID */
+    hid_t       dcpl = -1;                  /* Dataset creation property list ID */
+    hid_t       sid = -1;                   /* Dataspace ID */
+    hid_t       mid = -1;                   /* Memory space ID */
+    hid_t       dsid = -1;                  /* Dataset ID */
+    hsize_t     dims[2] = {SEL_HYPER_DIM, SEL_HYPER_DIM};       /* Dataset dimensions */
+    hsize_t     chunk_dims[2] = {SEL_HYPER_CHUNK, SEL_HYPER_CHUNK};    /* Chunk dimensions */
+    hsize_t     start[2] = {1, 2};          /* Hyperslab start */
+    hsize_t     stride[2] = {9, 7};         /* Hyperslab stride */
+    hsize_t     count[2] = {6, 8};          /* Hyperslab count */
+    hsize_t     block[2] = {3, 2};          /* Hyperslab block */
+    hsize_t     box_start[2] = {40, 41};    /* Start of the extra block */
+    hsize_t     box_block[2] = {10, 6};     /* Size of the extra block */
+    hssize_t    offset[2] = {2, 3};         /* Selection offset */
+    hssize_t    no_offset[2] = {0, 0};      /* No selection offset */
+    hsize_t     npoints;                    /* Number of elements selected */
+    int         *wbuf = NULL;               /* Data written */
+    int         *rbuf = NULL;               /* Data read */
+    int         fill = -1;                  /* Fill value */
+    int         c, i, n, row, col;          /* Local index variables */
+
+    TESTING("strided hyperslab selections across chunks");
+
+    h5_fixname(FILENAME[42], fapl, filename, sizeof filename);
+
+    if(NULL == (wbuf = (int *)HDmalloc(SEL_HYPER_DIM * SEL_HYPER_DIM * sizeof(int)))) TEST_ERROR
+    if(NULL == (rbuf = (int *)HDmalloc(SEL_HYPER_DIM * SEL_HYPER_DIM * sizeof(int)))) TEST_ERROR
+
+    if((fid = H5Fcreate(filename, H5F_ACC_TRUNC, H5P_DEFAULT, fapl)) < 0) FAIL_STACK_ERROR
+    if((sid = H5Screate_simple(2, dims, NULL)) < 0) FAIL_STACK_ERROR
+    if((dcpl = H5Pcreate(H5P_DATASET_CREATE)) < 0) FAIL_STACK_ERROR
+    if(H5Pset_chunk(dcpl, 2, chunk_dims) < 0) FAIL_STACK_ERROR
+    if(H5Pset_fill_value(dcpl, H5T_NATIVE_INT, &fill) < 0) FAIL_STACK_ERROR
+
+    /* 0: regular, 1: regular with an offset, 2: irregular */
+    for(c = 0; c < 3; c++) {
+        HDsnprintf(dname, sizeof(dname), "hyper%d", c);
+        if((dsid = H5Dcreate2(fid, dname, H5T_NATIVE_INT, sid, H5P_DEFAULT, dcpl, H5P_DEFAULT)) < 0)
+            FAIL_STACK_ERROR
+
+        /* Select the elements */
+        if(H5Sselect_hyperslab(sid, H5S_SELECT_SET, start, stride, count, block) < 0) FAIL_STACK_ERROR
+        if(c == 2)
+            if(H5Sselect_hyperslab(sid, H5S_SELECT_OR, box_start, NULL, box_block, NULL) < 0) FAIL_STACK_ERROR
+        if(c == 1)
+            if(H5Soffset_simple(sid, offset) < 0) FAIL_STACK_ERROR
+        if(H5Sis_regular_hyperslab(sid) != (c == 2 ? FALSE : TRUE)) TEST_ERROR
+        if((n = (int)H5Sget_select_npoints(sid)) <= 0) FAIL_STACK_ERROR
+        npoints = (hsize_t)n;
+        if((mid = H5Screate_simple(1, &npoints, NULL)) < 0) FAIL_STACK_ERROR
+
+        /* Write the elements */
+        for(i = 0; i < n; i++)
+            wbuf[i] = i + 1;
+        if(H5Dwrite(dsid, H5T_NATIVE_INT, mid, sid, H5P_DEFAULT, wbuf) < 0) FAIL_STACK_ERROR
+
+        /* Work out the dataset's expected contents, numbering the
+         * selected elements in row-major order */
+        for(i = 0, row = 0; row < SEL_HYPER_DIM; row++)
+            for(col = 0; col < SEL_HYPER_DIM; col++) {
+                hsize_t r = (hsize_t)row - (c == 1 ? (hsize_t)offset[0] : 0);
+                hsize_t k = (hsize_t)col - (c == 1 ? (hsize_t)offset[1] : 0);
+                hbool_t selected;
+
+                selected = r >= start[0] && (r - start[0]) / stride[0] < count[0] && (r - start[0]) % stride[0] < block[0]
+                        && k >= start[1] && (k - start[1]) / stride[1] < count[1] && (k - start[1]) % stride[1] < block[1];
+                if(c == 2 && r >= box_start[0] && r < box_start[0] + box_block[0]
+                        && k >= box_start[1] && k < box_start[1] + box_block[1])
+                    selected = TRUE;
+                wbuf[row * SEL_HYPER_DIM + col] = selected ? ++i : fill;
+            } /* end for */
+        if(i != n)
+            TEST_ERROR
+
+        /* Read the whole dataset back */
+        if(H5Dread(dsid, H5T_NATIVE_INT, H5S_ALL, H5S_ALL, H5P_DEFAULT, rbuf) < 0) FAIL_STACK_ERROR
+        for(i = 0; i < SEL_HYPER_DIM * SEL_HYPER_DIM; i++)
+            if(rbuf[i] != wbuf[i])
+                TEST_ERROR
+
+        /* Read the elements back through the selection */
+        HDmemset(rbuf, 0, (size_t)n * sizeof(int));
+        if(H5Dread(dsid, H5T_NATIVE_INT, mid, sid, H5P_DEFAULT, rbuf) < 0) FAIL_STACK_ERROR
+        for(i = 0; i < n; i++)
+            if(rbuf[i] != i + 1)
+                TEST_ERROR
+
+        /* (Don't create the next dataset with the offset) */
+        if(H5Soffset_simple(sid, no_offset) < 0) FAIL_STACK_ERROR
+
+        if(H5Sclose(mid) < 0) FAIL_STACK_ERROR
+        mid = -1;
+        if(H5Dclose(dsid) < 0) FAIL_STACK_ERROR
+        dsid = -1;
+    } /* end for */
+
+    /* Release resources */
+    if(H5Pclose(dcpl) < 0) FAIL_STACK_ERROR
+    if(H5Sclose(sid) < 0) FAIL_STACK_ERROR
+    if(H5Fclose(fid) < 0) FAIL_STACK_ERROR
+    HDfree(wbuf);
+    HDfree(rbuf);
+
+    PASSED();
+    return SUCCEED;
+
+error:
+    H5E_BEGIN_TRY {
+        H5Dclose(dsid);
+        H5Pclose(dcpl);
+        H5Sclose(mid);
+        H5Sclose(sid);
+        H5Fclose(fid);
+    } H5E_END_TRY;
+    HDfree(wbuf);
+    HDfree(rbuf);
+    return FAIL;
+} /* end test_chunk_sel_hyper() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:    test_shuffle_sizes
+ *
+ * Purpose:     Tests the shuffle filter with several element sizes and
+ *              chunks whose number of elements is not a multiple of the
+ *              block sizes the vector code works on.  Checks the raw
+ *              chunks against a byte-by-byte shuffle of the data, so
+ *              the layout on disk is known not to depend on which code
+ *              did the shuffling, and checks that the data reads back.
+ *
+ * Return:      Success: 0
+ *              Failure: -1
+ *
+ *-------------------------------------------------------------------------
+ */
+#define SHUFFLE_SIZES_NELMTS    1013
+static herr_t
+test_shuffle_sizes(hid_t fapl)
+{
+    char        filename[FILENAME_BUF_SIZE];
+    char        dname[32];                  /* Dataset name */
+    hid_t       fid = -1;                   /* File ID */
+    hid_t       dcpl = -1;                  /* Dataset creation property list ID */
+    hid_t       sid = -1;                   /* Dataspace ID */
+    hid_t       tid = -1;                   /* Datatype ID */
+    hid_t       dsid = -1;                  /* Dataset ID */
+    hsize_t     dims = SHUFFLE_SIZES_NELMTS;    /* Dataset dimensions */
+    hsize_t     offset = 0;                 /* Chunk offset */
+    size_t      sizes[] = {2, 3, 4, 8, 16}; /* Element sizes */
+    unsigned char *wbuf = NULL;             /* Data written */
+    unsigned char *rbuf = NULL;             /* Data read */
+    unsigned char *sbuf = NULL;             /* Data shuffled */
+    uint32_t    filter_mask = 0;            /* Filter mask of the raw chunk */
+    size_t      s, i, u;                    /* Local index variables */
+
+    TESTING("shuffle filter with various element sizes");
+
+    h5_fixname(FILENAME[36], fapl, filename, sizeof filename);
+
+    if(NULL == (wbuf = (unsigned char *)HDmalloc(SHUFFLE_SIZES_NELMTS * 16))) TEST_ERROR
+    if(NULL == (rbuf = (unsigned char *)HDmalloc(SHUFFLE_SIZES_NELMTS * 16))) TEST_ERROR
+    if(NULL == (sbuf = (unsigned char *)HDmalloc(SHUFFLE_SIZES_NELMTS * 16))) TEST_ERROR
+
+    if((fid = H5Fcreate(filename, H5F_ACC_TRUNC, H5P_DEFAULT, fapl)) < 0) FAIL_STACK_ERROR
+    if((sid = H5Screate_simple(1, &dims, NULL)) < 0) FAIL_STACK_ERROR
+    if((dcpl = H5Pcreate(H5P_DATASET_CREATE)) < 0) FAIL_STACK_ERROR
+    if(H5Pset_chunk(dcpl, 1, &dims) < 0) FAIL_STACK_ERROR
+    if(H5Pset_shuffle(dcpl) < 0) FAIL_STACK_ERROR
+
+    for(s = 0; s < NELMTS(sizes); s++) {
+        /* Fill the buffer with data and shuffle it by hand */
+        for(i = 0; i < SHUFFLE_SIZES_NELMTS * sizes[s]; i++)
+            wbuf[i] = (unsigned char)((i * 7) + (i / 251));
+        for(i = 0; i < SHUFFLE_SIZES_NELMTS; i++)
+            for(u = 0; u < sizes[s]; u++)
+                sbuf[(u * SHUFFLE_SIZES_NELMTS) + i] = wbuf[(i * sizes[s]) + u];
+
+        /* Write the data through the filter */
+        HDsnprintf(dname, sizeof(dname), "shuffle_%u", (unsigned)sizes[s]);
+        if((tid = H5Tcreate(H5T_OPAQUE, sizes[s])) < 0) FAIL_STACK_ERROR
+        if((dsid = H5Dcreate2(fid, dname, tid, sid, H5P_DEFAULT, dcpl, H5P_DEFAULT)) < 0)
+            FAIL_STACK_ERROR
+        if(H5Dwrite(dsid, tid, H5S_ALL, H5S_ALL, H5P_DEFAULT, wbuf) < 0) FAIL_STACK_ERROR
+        if(H5Dclose(dsid) < 0) FAIL_STACK_ERROR
+        dsid = -1;
+
+        /* Check the raw chunk */
+        if((dsid = H5Dopen2(fid, dname, H5P_DEFAULT)) < 0) FAIL_STACK_ERROR
+        if(H5Dread_chunk(dsid, H5P_DEFAULT, &offset, &filter_mask, rbuf) < 0) FAIL_STACK_ERROR
+        if(filter_mask != 0) TEST_ERROR
+        if(HDmemcmp(rbuf, sbuf, SHUFFLE_SIZES_NELMTS * sizes[s]) != 0) TEST_ERROR
+
+        /* Check the data read back through the filter */
+        HDmemset(rbuf, 0, SHUFFLE_SIZES_NELMTS * sizes[s]);
+        if(H5Dread(dsid, tid, H5S_ALL, H5S_ALL, H5P_DEFAULT, rbuf) < 0) FAIL_STACK_ERROR
+        if(HDmemcmp(rbuf, wbuf, SHUFFLE_SIZES_NELMTS * sizes[s]) != 0) TEST_ERROR
+
+        if(H5Dclose(dsid) < 0) FAIL_STACK_ERROR
+        dsid = -1;
+        if(H5Tclose(tid) < 0) FAIL_STACK_ERROR
+        tid = -1;
+    } /* end for */
+
+    /* Release resources */
+    if(H5Pclose(dcpl) < 0) FAIL_STACK_ERROR
+    if(H5Sclose(sid) < 0) FAIL_STACK_ERROR
+    if(H5Fclose(fid) < 0) FAIL_STACK_ERROR
+    HDfree(wbuf);
+    HDfree(rbuf);
+    HDfree(sbuf);
+
+    PASSED();
+    return SUCCEED;
+
+error:
+    H5E_BEGIN_TRY {
+        H5Dclose(dsid);
+        H5Tclose(tid);
+        H5Pclose(dcpl);
+        H5Sclose(sid);
+        H5Fclose(fid);
+    } H5E_END_TRY;
+    HDfree(wbuf);
+    HDfree(rbuf);
+    HDfree(sbuf);
+    return FAIL;
+} /* end test_shuffle_sizes() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:    test_bitshuffle
+ *
+ * Purpose:     Tests the bitshuffle filter with several element sizes and
+ *              block sizes, on chunks that end with a partial block and a
+ *              few elements that aren't transposed.  Checks the raw
+ *              chunks against a bit-by-bit transpose of the data and
+ *              checks that the data reads back.
+ *
+ * Return:      Success: 0
+ *              Failure: -1
+ *
+ *-------------------------------------------------------------------------
+ */
+#define BITSHUFFLE_NELMTS   5005
+static herr_t
+test_bitshuffle(hid_t fapl)
+{
+    char        filename[FILENAME_BUF_SIZE];
+    char        dname[32];                  /* Dataset name */
+    hid_t       fid = -1;                   /* File ID */
+    hid_t       dcpl = -1;                  /* Dataset creation property list ID */
+    hid_t       sid = -1;                   /* Dataspace ID */
+    hid_t       tid = -1;                   /* Datatype ID */
+    hid_t       dsid = -1;                  /* Dataset ID */
+    hsize_t     dims = BITSHUFFLE_NELMTS;   /* Dataset dimensions */
+    hsize_t     offset = 0;                 /* Chunk offset */
+    size_t      sizes[] = {1, 2, 3, 4, 8};  /* Element sizes */
+    unsigned    blocks[] = {0, 64};         /* Block sizes */
+    unsigned char *wbuf = NULL;             /* Data written */
+    unsigned char *rbuf = NULL;             /* Data read */
+    unsigned char *sbuf = NULL;             /* Data bitshuffled */
+    uint32_t    filter_mask = 0;            /* Filter mask of the raw chunk */
+    size_t      block_size;                 /* Number of elements in a block */
+    size_t      start, nblock;              /* First element and number of elements of a block */
+    size_t      nbits;                      /* Number of bits of a block */
+    size_t      bit;                        /* Bit of the bitshuffled block */
+    size_t      s, b, i, u, k;              /* Local index variables */
+    herr_t      ret;                        /* Generic return value */
+
+    TESTING("bitshuffle filter");
+
+    h5_fixname(FILENAME[37], fapl, filename, sizeof filename);
+
+    if(NULL == (wbuf = (unsigned char *)HDmalloc(BITSHUFFLE_NELMTS * 8))) TEST_ERROR
+    if(NULL == (rbuf = (unsigned char *)HDmalloc(BITSHUFFLE_NELMTS * 8))) TEST_ERROR
+    if(NULL == (sbuf = (unsigned char *)HDmalloc(BITSHUFFLE_NELMTS * 8))) TEST_ERROR
+
+    if((fid = H5Fcreate(filename, H5F_ACC_TRUNC, H5P_DEFAULT, fapl)) < 0) FAIL_STACK_ERROR
+    if((sid = H5Screate_simple(1, &dims, NULL)) < 0) FAIL_STACK_ERROR
+
+    /* Block sizes have to be multiples of 8 */
+    if((dcpl = H5Pcreate(H5P_DATASET_CREATE)) < 0) FAIL_STACK_ERROR
+    H5E_BEGIN_TRY {
+        ret = H5Pset_bitshuffle(dcpl, 12);
+    } H5E_END_TRY;
+    if(ret >= 0) TEST_ERROR
+    if(H5Pclose(dcpl) < 0) FAIL_STACK_ERROR
+    dcpl = -1;
+
+    for(b = 0; b < NELMTS(blocks); b++) {
+        if((dcpl = H5Pcreate(H5P_DATASET_CREATE)) < 0) FAIL_STACK_ERROR
+        if(H5Pset_chunk(dcpl, 1, &dims) < 0) FAIL_STACK_ERROR
+        if(H5Pset_bitshuffle(dcpl, blocks[b]) < 0) FAIL_STACK_ERROR
+
+        for(s = 0; s < NELMTS(sizes); s++) {
+            /* Fill the buffer with small integers, mostly */
+            for(i = 0; i < BITSHUFFLE_NELMTS * sizes[s]; i++)
+                wbuf[i] = (unsigned char)((i % sizes[s]) == 0 ? (i * 13) + (i / 97) : (i / 1999));
+
+            /* Bitshuffle the data by hand: each block holds bit K of byte
+             * J of element I at bit (J * 8 + K) * N + I, and elements after
+             * the last whole group of 8 are stored as they are */
+            block_size = blocks[b] ? blocks[b] : MAX(((8192 / sizes[s]) / 8) * 8, 128);
+            HDmemcpy(sbuf, wbuf, BITSHUFFLE_NELMTS * sizes[s]);
+            for(start = 0; BITSHUFFLE_NELMTS - start >= 8; start += nblock) {
+                nblock = MIN(block_size, BITSHUFFLE_NELMTS - start);
+                nblock -= nblock % 8;
+                nbits = nblock * sizes[s] * 8;
+                HDmemset(sbuf + (start * sizes[s]), 0, nbits / 8);
+                for(i = 0; i < nblock; i++)
+                    for(u = 0; u < sizes[s]; u++)
+                        for(k = 0; k < 8; k++)
+                            if(wbuf[((start + i) * sizes[s]) + u] & (1 << k)) {
+                                bit = ((u * 8 + k) * nblock) + i;
+                                sbuf[(start * sizes[s]) + (bit / 8)] |= (unsigned char)(1 << (bit % 8));
+                            } /* end if */
+            } /* end for */
+
+            /* Write the data through the filter */
+            HDsnprintf(dname, sizeof(dname), "bitshuffle_%u_%u", blocks[b], (unsigned)sizes[s]);
+            if((tid = H5Tcreate(H5T_OPAQUE, sizes[s])) < 0) FAIL_STACK_ERROR
+            if((dsid = H5Dcreate2(fid, dname, tid, sid, H5P_DEFAULT, dcpl, H5P_DEFAULT)) < 0)
+                FAIL_STACK_ERROR
+            if(H5Dwrite(dsid, tid, H5S_ALL, H5S_ALL, H5P_DEFAULT, wbuf) < 0) FAIL_STACK_ERROR
+            if(H5Dclose(dsid) < 0) FAIL_STACK_ERROR
+            dsid = -1;
+
+            /* Check the raw chunk */
+            if((dsid = H5Dopen2(fid, dname, H5P_DEFAULT)) < 0) FAIL_STACK_ERROR
+            if(H5Dread_chunk(dsid, H5P_DEFAULT, &offset, &filter_mask, rbuf) < 0) FAIL_STACK_ERROR
+            if(filter_mask != 0) TEST_ERROR
+            if(HDmemcmp(rbuf, sbuf, BITSHUFFLE_NELMTS * sizes[s]) != 0) TEST_ERROR
+
+            /* Check the data read back through the filter */
+            HDmemset(rbuf, 0, BITSHUFFLE_NELMTS * sizes[s]);
+            if(H5Dread(dsid, tid, H5S_ALL, H5S_ALL, H5P_DEFAULT, rbuf) < 0) FAIL_STACK_ERROR
+            if(HDmemcmp(rbuf, wbuf, BITSHUFFLE_NELMTS * sizes[s]) != 0) TEST_ERROR
+
+            if(H5Dclose(dsid) < 0) FAIL_STACK_ERROR
+            dsid = -1;
+            if(H5Tclose(tid) < 0) FAIL_STACK_ERROR
+            tid = -1;
+        } /* end for */
+
+        if(H5Pclose(dcpl) < 0) FAIL_STACK_ERROR
+        dcpl = -1;
+    } /* end for */
+
+    /* Release resources */
+    if(H5Sclose(sid) < 0) FAIL_STACK_ERROR
+    if(H5Fclose(fid) < 0) FAIL_STACK_ERROR
+    HDfree(wbuf);
+    HDfree(rbuf);
+    HDfree(sbuf);
+
+    PASSED();
+    return SUCCEED;
+
+error:
+    H5E_BEGIN_TRY {
+        H5Dclose(dsid);
+        H5Tclose(tid);
+        H5Pclose(dcpl);
+        H5Sclose(sid);
+        H5Fclose(fid);
+    } H5E_END_TRY;
+    HDfree(wbuf);
+    HDfree(rbuf);
+    HDfree(sbuf);
+    return FAIL;
+} /* end test_bitshuffle() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:    test_bitshuffle_lz4
+ *
+ * Purpose:     Tests the bitshuffle filter's LZ4 mode against a chunk in
+ *              the bitshuffle plugin's format, compressed with liblz4
+ *              1.9.4: the chunk reads back through the library's filter,
+ *              and the filter writes the same bytes for the same data.
+ *              The data has several whole blocks, a cut-down last block
+ *              and a few elements after it.
+ *
+ * Return:      Success: 0
+ *              Failure: -1
+ *
+ *-------------------------------------------------------------------------
+ */
+#define BITSHUFFLE_LZ4_NELMTS   203
+static herr_t
+test_bitshuffle_lz4(hid_t fapl)
+{
+#ifdef H5_HAVE_FILTER_LZ4
+    /* 203 little-endian 32-bit integers, (i % 17) * 3 + i / 25, bitshuffled
+     * in blocks of 64 elements and compressed with liblz4 */
+    static const unsigned char ref_chunk[] = {
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x03, 0x2c, 0x00, 0x00, 0x01, 0x00,
+    0x00, 0x00, 0x00, 0x3c, 0xff, 0x22, 0xaa, 0xaa, 0x54, 0xab, 0x56, 0x55,
+    0x51, 0x55, 0x66, 0x66, 0xcc, 0x98, 0x31, 0x33, 0xcf, 0xcc, 0xb4, 0xb4,
+    0x68, 0x2d, 0x59, 0x5a, 0x92, 0x96, 0x38, 0xc7, 0x70, 0xce, 0x61, 0x9c,
+    0xe3, 0x18, 0xc0, 0x07, 0x81, 0x0f, 0x82, 0x1f, 0x04, 0x1f, 0x00, 0xf8,
+    0x01, 0xf0, 0x03, 0xe0, 0x07, 0xe0, 0x00, 0x01, 0x00, 0xb7, 0x50, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x3b, 0xff, 0x21, 0xa5, 0x52,
+    0xb5, 0xaa, 0x9a, 0xaa, 0x2a, 0xb5, 0x9c, 0x31, 0x73, 0x66, 0x86, 0x99,
+    0x19, 0x73, 0x26, 0xa5, 0x45, 0x4b, 0xeb, 0xd2, 0xd2, 0xa5, 0xc7, 0x39,
+    0x86, 0x73, 0x0c, 0xe3, 0x1c, 0xc6, 0x08, 0x3e, 0x18, 0x7c, 0x30, 0xfc,
+    0x60, 0xf8, 0x0f, 0xc0, 0x1f, 0x80, 0x3f, 0x00, 0x7f, 0x00, 0x01, 0x00,
+    0xb8, 0x50, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x3c, 0xff,
+    0x22, 0xaa, 0x55, 0x95, 0x54, 0x55, 0x29, 0x55, 0xad, 0x66, 0xcc, 0x8c,
+    0x33, 0x33, 0xe7, 0xcc, 0x9c, 0xb4, 0x69, 0x29, 0x5b, 0x5a, 0xb6, 0x96,
+    0x2e, 0x38, 0x8e, 0x31, 0x9c, 0x63, 0x38, 0xe7, 0x30, 0xc0, 0xf0, 0xc1,
+    0xe1, 0x83, 0xc3, 0x07, 0xc7, 0xff, 0x00, 0xfe, 0x01, 0xfc, 0x03, 0xf8,
+    0x07, 0x00, 0x01, 0x00, 0xb7, 0x50, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x11, 0x7f, 0xaa, 0x99, 0x2d, 0xce, 0x0f, 0xf0, 0x00, 0x01,
+    0x00, 0x01, 0x50, 0x00, 0x00, 0x00, 0x00, 0x00, 0x2f, 0x00, 0x00, 0x00,
+    0x32, 0x00, 0x00, 0x00, 0x35, 0x00, 0x00, 0x00
+    };
+    char        filename[FILENAME_BUF_SIZE];
+    hid_t       fid = -1;                   /* File ID */
+    hid_t       dcpl = -1;                  /* Dataset creation property list ID */
+    hid_t       sid = -1;                   /* Dataspace ID */
+    hid_t       dsid = -1;                  /* Dataset ID */
+    hsize_t     dims = BITSHUFFLE_LZ4_NELMTS;   /* Dataset dimensions */
+    hsize_t     offset = 0;                 /* Chunk offset */
+    hsize_t     chunk_nbytes;               /* Size of the stored chunk */
+    unsigned    cd_values[H5Z_BITSHUFFLE_TOTAL_NPARMS] = {0, 0, 0, 64, H5Z_BITSHUFFLE_COMPRESS_LZ4};
+    unsigned    wbuf[BITSHUFFLE_LZ4_NELMTS];    /* Data written */
+    unsigned    rbuf[BITSHUFFLE_LZ4_NELMTS];    /* Data read */
+    unsigned char cbuf[2 * sizeof(ref_chunk)];  /* Compressed chunk */
+    uint32_t    filter_mask = 0;            /* Filter mask of the raw chunk */
+    unsigned    i;                          /* Local index variable */
+
+    TESTING("bitshuffle filter with lz4");
+
+    h5_fixname(FILENAME[43], fapl, filename, sizeof filename);
+
+    for(i = 0; i < BITSHUFFLE_LZ4_NELMTS; i++)
+        wbuf[i] = (i % 17) * 3 + i / 25;
+
+    if((fid = H5Fcreate(filename, H5F_ACC_TRUNC, H5P_DEFAULT, fapl)) < 0) FAIL_STACK_ERROR
+    if((sid = H5Screate_simple(1, &dims, NULL)) < 0) FAIL_STACK_ERROR
+    if((dcpl = H5Pcreate(H5P_DATASET_CREATE)) < 0) FAIL_STACK_ERROR
+    if(H5Pset_chunk(dcpl, 1, &dims) < 0) FAIL_STACK_ERROR
+    if(H5Pset_filter(dcpl, H5Z_FILTER_BITSHUFFLE, H5Z_FLAG_OPTIONAL, (size_t)H5Z_BITSHUFFLE_TOTAL_NPARMS, cd_values) < 0)
+        FAIL_STACK_ERROR
+
+    /* Read the reference chunk */
+    if((dsid = H5Dcreate2(fid, "ref", H5T_STD_U32LE, sid, H5P_DEFAULT, dcpl, H5P_DEFAULT)) < 0)
+        FAIL_STACK_ERROR
+    if(H5Dwrite_chunk(dsid, H5P_DEFAULT, 0, &offset, sizeof(ref_chunk), ref_chunk) < 0) FAIL_STACK_ERROR
+    HDmemset(rbuf, 0, sizeof(rbuf));
+    if(H5Dread(dsid, H5T_NATIVE_UINT, H5S_ALL, H5S_ALL, H5P_DEFAULT, rbuf) < 0) FAIL_STACK_ERROR
+    if(HDmemcmp(rbuf, wbuf, sizeof(wbuf)) != 0) TEST_ERROR
+    if(H5Dclose(dsid) < 0) FAIL_STACK_ERROR
+    dsid = -1;
+
+    /* Write the data through the filter and check the raw chunk */
+    if((dsid = H5Dcreate2(fid, "data", H5T_STD_U32LE, sid, H5P_DEFAULT, dcpl, H5P_DEFAULT)) < 0)
+        FAIL_STACK_ERROR
+    if(H5Dwrite(dsid, H5T_NATIVE_UINT, H5S_ALL, H5S_ALL, H5P_DEFAULT, wbuf) < 0) FAIL_STACK_ERROR
+    if(H5Dclose(dsid) < 0) FAIL_STACK_ERROR
+    dsid = -1;
+    if((dsid = H5Dopen2(fid, "data", H5P_DEFAULT)) < 0) FAIL_STACK_ERROR
+    if(H5Dget_chunk_storage_size(dsid, &offset, &chunk_nbytes) < 0) FAIL_STACK_ERROR
+    if(chunk_nbytes != sizeof(ref_chunk)) TEST_ERROR
+    if(H5Dread_chunk(dsid, H5P_DEFAULT, &offset, &filter_mask, cbuf) < 0) FAIL_STACK_ERROR
+    if(filter_mask != 0) TEST_ERROR
+    if(HDmemcmp(cbuf, ref_chunk, sizeof(ref_chunk)) != 0) TEST_ERROR
+    HDmemset(rbuf, 0, sizeof(rbuf));
+    if(H5Dread(dsid, H5T_NATIVE_UINT, H5S_ALL, H5S_ALL, H5P_DEFAULT, rbuf) < 0) FAIL_STACK_ERROR
+    if(HDmemcmp(rbuf, wbuf, sizeof(wbuf)) != 0) TEST_ERROR
+    if(H5Dclose(dsid) < 0) FAIL_STACK_ERROR
+    dsid = -1;
+
+    /* Release resources */
+    if(H5Pclose(dcpl) < 0) FAIL_STACK_ERROR
+    if(H5Sclose(sid) < 0) FAIL_STACK_ERROR
+    if(H5Fclose(fid) < 0) FAIL_STACK_ERROR
+
+    PASSED();
+    return SUCCEED;
+
+error:
+    H5E_BEGIN_TRY {
+        H5Dclose(dsid);
+        H5Pclose(dcpl);
+        H5Sclose(sid);
+        H5Fclose(fid);
+    } H5E_END_TRY;
+    return FAIL;
+#else /* H5_HAVE_FILTER_LZ4 */
+    (void)fapl;
+
+    TESTING("bitshuffle filter with lz4");
+    SKIPPED();
+    HDputs("    lz4 filter not enabled");
+
+    return SUCCEED;
+#endif /* H5_HAVE_FILTER_LZ4 */
+} /* end test_bitshuffle_lz4() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:    test_lz4
+ *
+ * Purpose:     Tests the lz4 filter: compressible and random data, whole
+ *              chunk and smaller blocks, the layout of the compressed
+ *              chunk's header, and that a truncated chunk fails to read
+ *              instead of being decompressed past its end.
+ *
+ * Return:      Success: 0
+ *              Failure: -1
+ *
+ *-------------------------------------------------------------------------
+ */
+#define LZ4_NELMTS      20000
+static herr_t
+test_lz4(hid_t fapl)
+{
+#ifdef H5_HAVE_FILTER_LZ4
+    char        filename[FILENAME_BUF_SIZE];
+    char        dname[32];                  /* Dataset name */
+    hid_t       fid = -1;                   /* File ID */
+    hid_t       dcpl = -1;                  /* Dataset creation property list ID */
+    hid_t       sid = -1;                   /* Dataspace ID */
+    hid_t       dsid = -1;                  /* Dataset ID */
+    hsize_t     dims = LZ4_NELMTS;          /* Dataset dimensions */
+    hsize_t     offset = 0;                 /* Chunk offset */
+    hsize_t     chunk_nbytes;               /* Size of the stored chunk */
+    unsigned    cd_values[2];               /* Filter parameters */
+    int         *wbuf = NULL;               /* Data written */
+    int         *rbuf = NULL;               /* Data read */
+    unsigned char *cbuf = NULL;             /* Compressed chunk */
+    uint32_t    filter_mask = 0;            /* Filter mask of the raw chunk */
+    unsigned    block;                      /* Whether the blocks are smaller than the chunk */
+    unsigned    random;                     /* Whether the data is random */
+    herr_t      ret;                        /* Generic return value */
+    int         i;                          /* Local index variable */
+
+    TESTING("lz4 filter");
+
+    h5_fixname(FILENAME[38], fapl, filename, sizeof filename);
+
+    if(NULL == (wbuf = (int *)HDmalloc(LZ4_NELMTS * sizeof(int)))) TEST_ERROR
+    if(NULL == (rbuf = (int *)HDmalloc(LZ4_NELMTS * sizeof(int)))) TEST_ERROR
+    if(NULL == (cbuf = (unsigned char *)HDmalloc(2 * LZ4_NELMTS * sizeof(int)))) TEST_ERROR
+
+    if((fid = H5Fcreate(filename, H5F_ACC_TRUNC, H5P_DEFAULT, fapl)) < 0) FAIL_STACK_ERROR
+    if((sid = H5Screate_simple(1, &dims, NULL)) < 0) FAIL_STACK_ERROR
+
+    /* Accelerations are limited */
+    if((dcpl = H5Pcreate(H5P_DATASET_CREATE)) < 0) FAIL_STACK_ERROR
+    H5E_BEGIN_TRY {
+        ret = H5Pset_lz4(dcpl, H5Z_LZ4_MAX_ACCELERATION + 1);
+    } H5E_END_TRY;
+    if(ret >= 0) TEST_ERROR
+    if(H5Pclose(dcpl) < 0) FAIL_STACK_ERROR
+    dcpl = -1;
+
+    for(block = 0; block < 2; block++)
+        for(random = 0; random < 2; random++) {
+            /* Whole-chunk blocks through H5Pset_lz4(), or 1000-byte blocks
+             * (which don't divide the chunk) through H5Pset_filter() */
+            if((dcpl = H5Pcreate(H5P_DATASET_CREATE)) < 0) FAIL_STACK_ERROR
+            if(H5Pset_chunk(dcpl, 1, &dims) < 0) FAIL_STACK_ERROR
+            if(block) {
+                cd_values[0] = 1000;
+                cd_values[1] = 4;
+                if(H5Pset_filter(dcpl, H5Z_FILTER_LZ4, H5Z_FLAG_OPTIONAL, (size_t)2, cd_values) < 0)
+                    FAIL_STACK_ERROR
+            } /* end if */
+            else if(H5Pset_lz4(dcpl, 0) < 0)
+                FAIL_STACK_ERROR
+
+            for(i = 0; i < LZ4_NELMTS; i++)
+                wbuf[i] = random ? (int)HDrandom() : (i / 7) % 1000;
+
+            HDsnprintf(dname, sizeof(dname), "lz4_%u_%u", block, random);
+            if((dsid = H5Dcreate2(fid, dname, H5T_NATIVE_INT, sid, H5P_DEFAULT, dcpl, H5P_DEFAULT)) < 0)
+                FAIL_STACK_ERROR
+            if(H5Dwrite(dsid, H5T_NATIVE_INT, H5S_ALL, H5S_ALL, H5P_DEFAULT, wbuf) < 0) FAIL_STACK_ERROR
+            if(H5Dclose(dsid) < 0) FAIL_STACK_ERROR
+            dsid = -1;
+
+            if((dsid = H5Dopen2(fid, dname, H5P_DEFAULT)) < 0) FAIL_STACK_ERROR
+
+            /* Check the header of the compressed chunk, and that data that
+             * compresses got smaller */
+            if(H5Dget_chunk_storage_size(dsid, &offset, &chunk_nbytes) < 0) FAIL_STACK_ERROR
+            if(chunk_nbytes > 2 * LZ4_NELMTS * sizeof(int)) TEST_ERROR
+            if(!random && chunk_nbytes >= (LZ4_NELMTS * sizeof(int)) / 4) TEST_ERROR
+            if(H5Dread_chunk(dsid, H5P_DEFAULT, &offset, &filter_mask, cbuf) < 0) FAIL_STACK_ERROR
+            if(filter_mask != 0) TEST_ERROR
+            if(cbuf[0] != 0 || cbuf[1] != 0 || cbuf[2] != 0 || cbuf[3] != 0) TEST_ERROR
+            if(((unsigned)cbuf[4] << 24 | (unsigned)cbuf[5] << 16 | (unsigned)cbuf[6] << 8 | (unsigned)cbuf[7])
+                    != LZ4_NELMTS * sizeof(int))
+                TEST_ERROR
+            if(((unsigned)cbuf[8] << 24 | (unsigned)cbuf[9] << 16 | (unsigned)cbuf[10] << 8 | (unsigned)cbuf[11])
+                    != (block ? 1000 : LZ4_NELMTS * sizeof(int)))
+                TEST_ERROR
+
+            /* Check the data */
+            HDmemset(rbuf, 0, LZ4_NELMTS * sizeof(int));
+            if(H5Dread(dsid, H5T_NATIVE_INT, H5S_ALL, H5S_ALL, H5P_DEFAULT, rbuf) < 0) FAIL_STACK_ERROR
+            if(HDmemcmp(rbuf, wbuf, LZ4_NELMTS * sizeof(int)) != 0) TEST_ERROR
+
+            /* A truncated chunk must fail to read */
+            if(!random && !block) {
+                if(H5Dwrite_chunk(dsid, H5P_DEFAULT, 0, &offset, (size_t)chunk_nbytes / 2, cbuf) < 0)
+                    FAIL_STACK_ERROR
+                H5E_BEGIN_TRY {
+                    ret = H5Dread(dsid, H5T_NATIVE_INT, H5S_ALL, H5S_ALL, H5P_DEFAULT, rbuf);
+                } H5E_END_TRY;
+                if(ret >= 0) TEST_ERROR
+            } /* end if */
+
+            if(H5Dclose(dsid) < 0) FAIL_STACK_ERROR
+            dsid = -1;
+            if(H5Pclose(dcpl) < 0) FAIL_STACK_ERROR
+            dcpl = -1;
+        } /* end for */
+
+    /* Release resources */
+    if(H5Sclose(sid) < 0) FAIL_STACK_ERROR
+    if(H5Fclose(fid) < 0) FAIL_STACK_ERROR
+    HDfree(wbuf);
+    HDfree(rbuf);
+    HDfree(cbuf);
+
+    PASSED();
+    return SUCCEED;
+
+error:
+    H5E_BEGIN_TRY {
+        H5Dclose(dsid);
+        H5Pclose(dcpl);
+        H5Sclose(sid);
+        H5Fclose(fid);
+    } H5E_END_TRY;
+    HDfree(wbuf);
+    HDfree(rbuf);
+    HDfree(cbuf);
+    return FAIL;
+#else /* H5_HAVE_FILTER_LZ4 */
+    (void)fapl;
+
+    TESTING("lz4 filter");
+    SKIPPED();
+    HDputs("    lz4 filter not enabled");
+
+    return SUCCEED;
+#endif /* H5_HAVE_FILTER_LZ4 */
+} /* end test_lz4() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:    test_deflate_nthreads
+ *
+ * Purpose:     Tests compressing chunks with multiple threads in the
+ *              deflate filter: the stored chunk is a zlib stream that
+ *              reads back correctly and is about as small as one
+ *              compressed in one piece, and chunks of less than a block
+ *              are compressed as before.
+ *
+ * Return:      Success: 0
+ *              Failure: -1
+ *
+ *-------------------------------------------------------------------------
+ */
+#define DEFLATE_NTHREADS_NELMTS 1300000
+static herr_t
+test_deflate_nthreads(hid_t fapl)
+{
+#ifdef H5_HAVE_FILTER_DEFLATE
+    char        filename[FILENAME_BUF_SIZE];
+    char        dname[32];                  /* Dataset name */
+    hid_t       fid = -1;                   /* File ID */
+    hid_t       dcpl = -1;                  /* Dataset creation property list ID */
+    hid_t       dxpl = -1;                  /* Dataset transfer property list ID */
+    hid_t       sid = -1;                   /* Dataspace ID */
+    hid_t       dsid = -1;                  /* Dataset ID */
+    hsize_t     dims = DEFLATE_NTHREADS_NELMTS; /* Dataset dimensions */
+    hsize_t     chunk_dims;                 /* Chunk dimensions */
+    hsize_t     offset = 0;                 /* Chunk offset */
+    hsize_t     chunk_nbytes[2][2];         /* Size of the stored chunks, by chunk size and threads */
+    unsigned    nthreads;                   /* Number of threads */
+    int         *wbuf = NULL;               /* Data written */
+    int         *rbuf = NULL;               /* Data read */
+    unsigned char *cbuf = NULL;             /* Compressed chunk */
+    uint32_t    filter_mask = 0;            /* Filter mask of the raw chunk */
+    unsigned    small;                      /* Whether the chunks are smaller than a block */
+    unsigned    threaded;                   /* Whether multiple threads are used */
+    herr_t      ret;                        /* Generic return value */
+    int         i;                          /* Local index variable */
+
+    TESTING("deflate filter with multiple threads");
+
+    h5_fixname(FILENAME[39], fapl, filename, sizeof filename);
+
+    if(NULL == (wbuf = (int *)HDmalloc(DEFLATE_NTHREADS_NELMTS * sizeof(int)))) TEST_ERROR
+    if(NULL == (rbuf = (int *)HDmalloc(DEFLATE_NTHREADS_NELMTS * sizeof(int)))) TEST_ERROR
+    if(NULL == (cbuf = (unsigned char *)HDmalloc(2 * DEFLATE_NTHREADS_NELMTS * sizeof(int)))) TEST_ERROR
+
+    /* Check the property's default value and setting it */
+    if((dxpl = H5Pcreate(H5P_DATASET_XFER)) < 0) FAIL_STACK_ERROR
+    if(H5Pget_deflate_nthreads(dxpl, &nthreads) < 0) FAIL_STACK_ERROR
+    if(nthreads != 1) FAIL_PUTS_ERROR("wrong default number of deflate threads")
+    H5E_BEGIN_TRY {
+        ret = H5Pset_deflate_nthreads(dxpl, 0);
+    } H5E_END_TRY;
+    if(ret >= 0) FAIL_PUTS_ERROR("zero deflate threads accepted")
+
+    /* Data that compresses, but not trivially */
+    for(i = 0; i < DEFLATE_NTHREADS_NELMTS; i++)
+        wbuf[i] = ((i / 5) % 3000) + (int)(HDrandom() % 16);
+
+    if((fid = H5Fcreate(filename, H5F_ACC_TRUNC, H5P_DEFAULT, fapl)) < 0) FAIL_STACK_ERROR
+    if((sid = H5Screate_simple(1, &dims, NULL)) < 0) FAIL_STACK_ERROR
+
+    for(small = 0; small < 2; small++)
+        for(threaded = 0; threaded < 2; threaded++) {
+            /* One chunk of several blocks (and a partial one), or many
+             * chunks of less than a block */
+            chunk_dims = small ? DEFLATE_NTHREADS_NELMTS / 10 : DEFLATE_NTHREADS_NELMTS;
+            if((dcpl = H5Pcreate(H5P_DATASET_CREATE)) < 0) FAIL_STACK_ERROR
+            if(H5Pset_chunk(dcpl, 1, &chunk_dims) < 0) FAIL_STACK_ERROR
+            if(H5Pset_deflate(dcpl, 6) < 0) FAIL_STACK_ERROR
+
+            if(H5Pset_deflate_nthreads(dxpl, threaded ? 4 : 1) < 0) FAIL_STACK_ERROR
+            if(H5Pget_deflate_nthreads(dxpl, &nthreads) < 0) FAIL_STACK_ERROR
+            if(nthreads != (threaded ? 4 : 1)) FAIL_PUTS_ERROR("wrong number of deflate threads")
+
+            /* (The large chunk doesn't fit in the chunk cache, so it's
+             *  compressed by H5Dwrite) */
+            HDsnprintf(dname, sizeof(dname), "deflate_%u_%u", small, threaded);
+            if((dsid = H5Dcreate2(fid, dname, H5T_NATIVE_INT, sid, H5P_DEFAULT, dcpl, H5P_DEFAULT)) < 0)
+                FAIL_STACK_ERROR
+            if(H5Dwrite(dsid, H5T_NATIVE_INT, H5S_ALL, H5S_ALL, dxpl, wbuf) < 0) FAIL_STACK_ERROR
+            if(H5Dclose(dsid) < 0) FAIL_STACK_ERROR
+            dsid = -1;
+
+            if((dsid = H5Dopen2(fid, dname, H5P_DEFAULT)) < 0) FAIL_STACK_ERROR
+
+            /* The chunk is a zlib stream that compressed the data */
+            if(H5Dget_chunk_storage_size(dsid, &offset, &chunk_nbytes[small][threaded]) < 0) FAIL_STACK_ERROR
+            if(chunk_nbytes[small][threaded] >= (chunk_dims * sizeof(int)) / 2) TEST_ERROR
+            if(H5Dread_chunk(dsid, H5P_DEFAULT, &offset, &filter_mask, cbuf) < 0) FAIL_STACK_ERROR
+            if(filter_mask != 0) TEST_ERROR
+            if(cbuf[0] != 0x78 || (((unsigned)cbuf[0] << 8) | cbuf[1]) % 31 != 0) TEST_ERROR
+
+            /* Check the data (decompressing checks the stream's checksum) */
+            HDmemset(rbuf, 0, DEFLATE_NTHREADS_NELMTS * sizeof(int));
+            if(H5Dread(dsid, H5T_NATIVE_INT, H5S_ALL, H5S_ALL, H5P_DEFAULT, rbuf) < 0) FAIL_STACK_ERROR
+            if(HDmemcmp(rbuf, wbuf, DEFLATE_NTHREADS_NELMTS * sizeof(int)) != 0) TEST_ERROR
+
+            if(H5Dclose(dsid) < 0) FAIL_STACK_ERROR
+            dsid = -1;
+            if(H5Pclose(dcpl) < 0) FAIL_STACK_ERROR
+            dcpl = -1;
+        } /* end for */
+
+    /* Compressing in blocks costs little, and small chunks are compressed
+     * as before */
+    if(chunk_nbytes[0][1] > chunk_nbytes[0][0] + chunk_nbytes[0][0] / 100) TEST_ERROR
+    if(chunk_nbytes[1][1] != chunk_nbytes[1][0]) TEST_ERROR
+
+    /* Release resources */
+    if(H5Pclose(dxpl) < 0) FAIL_STACK_ERROR
+    if(H5Sclose(sid) < 0) FAIL_STACK_ERROR
+    if(H5Fclose(fid) < 0) FAIL_STACK_ERROR
+    HDfree(wbuf);
+    HDfree(rbuf);
+    HDfree(cbuf);
+
+    PASSED();
+    return SUCCEED;
+
+error:
+    H5E_BEGIN_TRY {
+        H5Pclose(dxpl);
+        H5Dclose(dsid);
+        H5Pclose(dcpl);
+        H5Sclose(sid);
+        H5Fclose(fid);
+    } H5E_END_TRY;
+    HDfree(wbuf);
+    HDfree(rbuf);
+    HDfree(cbuf);
+    return FAIL;
+#else /* H5_HAVE_FILTER_DEFLATE */
+    (void)fapl;
+
+    TESTING("deflate filter with multiple threads");
+    SKIPPED();
+    HDputs("    Deflate filter not enabled");
+
+    return SUCCEED;
+#endif /* H5_HAVE_FILTER_DEFLATE */
+} /* end test_deflate_nthreads() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:    test_deflate_decode
+ *
+ * Purpose:     Tests reading chunks that deflate compressed to a small
+ *              fraction of their size, which are decompressed into a
+ *              buffer of the chunk's size: through the chunk cache, with
+ *              the chunk cache disabled and with the chunks decoded by
+ *              several threads.  Shuffle is applied after deflate is
+ *              undone, so it sees the chunk-sized output.
+ *
+ * Return:      Success: 0
+ *              Failure: -1
+ *
+ *-------------------------------------------------------------------------
+ */
+#define DEFLATE_DECODE_NELMTS   200000
+#define DEFLATE_DECODE_CHUNK    50000
+static herr_t
+test_deflate_decode(hid_t fapl)
+{
+#ifdef H5_HAVE_FILTER_DEFLATE
+    char        filename[FILENAME_BUF_SIZE];
+    hid_t       fid = -1;                   /* File ID */
+    hid_t       dcpl = -1;                  /* Dataset creation property list ID */
+    hid_t       dapl = -1;                  /* Dataset access property list ID */
+    hid_t       dxpl = -1;                  /* Dataset transfer property list ID */
+    hid_t       sid = -1;                   /* Dataspace ID */
+    hid_t       dsid = -1;                  /* Dataset ID */
+    hsize_t     dims = DEFLATE_DECODE_NELMTS;   /* Dataset dimensions */
+    hsize_t     chunk_dims = DEFLATE_DECODE_CHUNK;  /* Chunk dimensions */
+    hsize_t     offset = 0;                 /* Chunk offset */
+    hsize_t     chunk_nbytes;               /* Size of the stored chunk */
+    int         *wbuf = NULL;               /* Data written */
+    int         *rbuf = NULL;               /* Data read */
+    unsigned    mode;                       /* How the chunks are read */
+    int         i;                          /* Local index variable */
+
+    TESTING("deflate filter decoding into chunk-sized buffers");
+
+    h5_fixname(FILENAME[40], fapl, filename, sizeof filename);
+
+    if(NULL == (wbuf = (int *)HDmalloc(DEFLATE_DECODE_NELMTS * sizeof(int)))) TEST_ERROR
+    if(NULL == (rbuf = (int *)HDmalloc(DEFLATE_DECODE_NELMTS * sizeof(int)))) TEST_ERROR
+
+    /* Long runs, so the chunks compress to well under 1% */
+    for(i = 0; i < DEFLATE_DECODE_NELMTS; i++)
+        wbuf[i] = i / 4096;
+
+    if((fid = H5Fcreate(filename, H5F_ACC_TRUNC, H5P_DEFAULT, fapl)) < 0) FAIL_STACK_ERROR
+    if((sid = H5Screate_simple(1, &dims, NULL)) < 0) FAIL_STACK_ERROR
+    if((dcpl = H5Pcreate(H5P_DATASET_CREATE)) < 0) FAIL_STACK_ERROR
+    if(H5Pset_chunk(dcpl, 1, &chunk_dims) < 0) FAIL_STACK_ERROR
+    if(H5Pset_shuffle(dcpl) < 0) FAIL_STACK_ERROR
+    if(H5Pset_deflate(dcpl, 9) < 0) FAIL_STACK_ERROR
+    if((dsid = H5Dcreate2(fid, "deflate_decode", H5T_NATIVE_INT, sid, H5P_DEFAULT, dcpl, H5P_DEFAULT)) < 0)
+        FAIL_STACK_ERROR
+    if(H5Dwrite(dsid, H5T_NATIVE_INT, H5S_ALL, H5S_ALL, H5P_DEFAULT, wbuf) < 0) FAIL_STACK_ERROR
+    if(H5Dclose(dsid) < 0) FAIL_STACK_ERROR
+    dsid = -1;
+
+    for(mode = 0; mode < 3; mode++) {
+        if((dapl = H5Pcreate(H5P_DATASET_ACCESS)) < 0) FAIL_STACK_ERROR
+        if((dxpl = H5Pcreate(H5P_DATASET_XFER)) < 0) FAIL_STACK_ERROR
+        if(mode == 1) {
+            if(H5Pset_chunk_cache(dapl, (size_t)0, (size_t)0, H5D_CHUNK_CACHE_W0_DEFAULT) < 0) FAIL_STACK_ERROR
+        } /* end if */
+        else if(mode == 2)
+            if(H5Pset_chunk_decode_nthreads(dxpl, 4) < 0) FAIL_STACK_ERROR
+
+        if((dsid = H5Dopen2(fid, "deflate_decode", dapl)) < 0) FAIL_STACK_ERROR
+
+        if(H5Dget_chunk_storage_size(dsid, &offset, &chunk_nbytes) < 0) FAIL_STACK_ERROR
+        if(chunk_nbytes * 100 > DEFLATE_DECODE_CHUNK * sizeof(int)) TEST_ERROR
+
+        HDmemset(rbuf, 0, DEFLATE_DECODE_NELMTS * sizeof(int));
+        if(H5Dread(dsid, H5T_NATIVE_INT, H5S_ALL, H5S_ALL, dxpl, rbuf) < 0) FAIL_STACK_ERROR
+        if(HDmemcmp(rbuf, wbuf, DEFLATE_DECODE_NELMTS * sizeof(int)) != 0) TEST_ERROR
+
+        if(H5Dclose(dsid) < 0) FAIL_STACK_ERROR
+        dsid = -1;
+        if(H5Pclose(dapl) < 0) FAIL_STACK_ERROR
+        dapl = -1;
+        if(H5Pclose(dxpl) < 0) FAIL_STACK_ERROR
+        dxpl = -1;
+    } /* end for */
+
+    /* Release resources */
+    if(H5Pclose(dcpl) < 0) FAIL_STACK_ERROR
+    if(H5Sclose(sid) < 0) FAIL_STACK_ERROR
+    if(H5Fclose(fid) < 0) FAIL_STACK_ERROR
+    HDfree(wbuf);
+    HDfree(rbuf);
+
+    PASSED();
+    return SUCCEED;
+
+error:
+    H5E_BEGIN_TRY {
+        H5Dclose(dsid);
+        H5Pclose(dcpl);
+        H5Pclose(dapl);
+        H5Pclose(dxpl);
+        H5Sclose(sid);
+        H5Fclose(fid);
+    } H5E_END_TRY;
+    HDfree(wbuf);
+    HDfree(rbuf);
+    return FAIL;
+#else /* H5_HAVE_FILTER_DEFLATE */
+    (void)fapl;
+
+    TESTING("deflate filter decoding into chunk-sized buffers");
+    SKIPPED();
+    HDputs("    Deflate filter not enabled");
+
+    return SUCCEED;
+#endif /* H5_HAVE_FILTER_DEFLATE */
+} /* end test_deflate_decode() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:    test_chunk_filter_mode
+ *
+ * Purpose:     Tests the adaptive chunk filter mode and skipping chunks
+ *              that hold only the fill value: chunks that don't compress
+ *              well are stored with the optional filters skipped (but
+ *              still checksummed), fill value chunks aren't stored
+ *              unless they couldn't be read back without being stored,
+ *              with the filters run in one thread or several, and all
+ *              the data reads back.
+ *
+ * Return:      Success: 0
+ *              Failure: -1
+ *
+ *-------------------------------------------------------------------------
+ */
+#define FILTER_MODE_CHUNK   4096
+#define FILTER_MODE_NCHUNKS 5
+static herr_t
+test_chunk_filter_mode(hid_t fapl)
+{
+#ifdef H5_HAVE_FILTER_LZ4
+    char        filename[FILENAME_BUF_SIZE];
+    char        dname[32];                  /* Dataset name */
+    hid_t       fid = -1;                   /* File ID */
+    hid_t       dcpl = -1;                  /* Dataset creation property list ID */
+    hid_t       dapl = -1;                  /* Dataset access property list ID */
+    hid_t       sid = -1;                   /* Dataspace ID */
+    hid_t       dsid = -1;                  /* Dataset ID */
+    hsize_t     dims = FILTER_MODE_CHUNK * FILTER_MODE_NCHUNKS; /* Dataset dimensions */
+    hsize_t     chunk_dims = FILTER_MODE_CHUNK; /* Chunk dimensions */
+    hsize_t     offset;                     /* Chunk offset */
+    hsize_t     nchunks;                    /* Number of stored chunks */
+    hsize_t     size;                       /* Size of a stored chunk */
+    haddr_t     addr;                       /* Address of a stored chunk */
+    unsigned    filter_mask;                /* Filter mask of a stored chunk */
+    unsigned    mode;                       /* Chunk filter mode */
+    double      min_gain;                   /* Min. gain from filtering a chunk */
+    int         fill = 7;                   /* User-defined fill value */
+    int         *wbuf = NULL;               /* Data written */
+    int         *rbuf = NULL;               /* Data read */
+    unsigned    seed = 1;                   /* Random number state */
+    unsigned    fill_case;                  /* Default, user-defined or no fill value */
+    unsigned    threaded;                   /* Whether multiple threads filter the chunks */
+    herr_t      ret;                        /* Generic return value */
+    int         i;                          /* Local index variable */
+
+    TESTING("adaptive chunk filter mode");
+
+    h5_fixname(FILENAME[41], fapl, filename, sizeof filename);
+
+    if(NULL == (wbuf = (int *)HDmalloc(FILTER_MODE_CHUNK * FILTER_MODE_NCHUNKS * sizeof(int)))) TEST_ERROR
+    if(NULL == (rbuf = (int *)HDmalloc(FILTER_MODE_CHUNK * FILTER_MODE_NCHUNKS * sizeof(int)))) TEST_ERROR
+
+    if((fid = H5Fcreate(filename, H5F_ACC_TRUNC, H5P_DEFAULT, fapl)) < 0) FAIL_STACK_ERROR
+    if((sid = H5Screate_simple(1, &dims, NULL)) < 0) FAIL_STACK_ERROR
+
+    /* The storage must be chunked and the arguments valid */
+    if((dcpl = H5Pcreate(H5P_DATASET_CREATE)) < 0) FAIL_STACK_ERROR
+    if(H5Pget_chunk_filter_mode(dcpl, &mode, &min_gain) < 0) FAIL_STACK_ERROR
+    if(mode != 0 || !H5_DBL_ABS_EQUAL(min_gain, 0.0)) TEST_ERROR
+    H5E_BEGIN_TRY {
+        ret = H5Pset_chunk_filter_mode(dcpl, H5D_CHUNK_FILTER_ADAPTIVE, 0.1);
+    } H5E_END_TRY;
+    if(ret >= 0) TEST_ERROR
+    if(H5Pset_chunk(dcpl, 1, &chunk_dims) < 0) FAIL_STACK_ERROR
+    H5E_BEGIN_TRY {
+        ret = H5Pset_chunk_filter_mode(dcpl, H5D_CHUNK_FILTER_ADAPTIVE, 1.0);
+    } H5E_END_TRY;
+    if(ret >= 0) TEST_ERROR
+    H5E_BEGIN_TRY {
+        ret = H5Pset_chunk_filter_mode(dcpl, 0x4u, 0.1);
+    } H5E_END_TRY;
+    if(ret >= 0) TEST_ERROR
+    if(H5Pset_chunk_filter_mode(dcpl, H5D_CHUNK_FILTER_ADAPTIVE | H5D_CHUNK_SKIP_FILL_CHUNKS, 0.1) < 0)
+        FAIL_STACK_ERROR
+    if(H5Pget_chunk_filter_mode(dcpl, &mode, &min_gain) < 0) FAIL_STACK_ERROR
+    if(mode != (H5D_CHUNK_FILTER_ADAPTIVE | H5D_CHUNK_SKIP_FILL_CHUNKS) || !H5_DBL_ABS_EQUAL(min_gain, 0.1))
+        TEST_ERROR
+    if(H5Pset_lz4(dcpl, 0) < 0) FAIL_STACK_ERROR
+    if(H5Pset_fletcher32(dcpl) < 0) FAIL_STACK_ERROR
+
+    /* Chunks of fill values, compressible data, random data, fill values
+     * and compressible data */
+    for(i = 0; i < FILTER_MODE_CHUNK * FILTER_MODE_NCHUNKS; i++) {
+        seed = seed * 1103515245 + 12345;
+        switch(i / FILTER_MODE_CHUNK) {
+            case 1:
+            case 4:
+                wbuf[i] = i / 5;
+                break;
+            case 2:
+                wbuf[i] = (int)seed;
+                break;
+            default:
+                wbuf[i] = 0;
+                break;
+        } /* end switch */
+    } /* end for */
+
+    for(fill_case = 0; fill_case < 3; fill_case++)
+        for(threaded = 0; threaded < 2; threaded++) {
+            /* Set the fill value, or have none written to new chunks */
+            if(fill_case == 1) {
+                if(H5Pset_fill_value(dcpl, H5T_NATIVE_INT, &fill) < 0) FAIL_STACK_ERROR
+                for(i = 0; i < FILTER_MODE_CHUNK; i++)
+                    wbuf[i] = wbuf[(3 * FILTER_MODE_CHUNK) + i] = fill;
+            } /* end if */
+            else if(fill_case == 2 && H5Pset_fill_time(dcpl, H5D_FILL_TIME_NEVER) < 0)
+                FAIL_STACK_ERROR
+
+            if((dapl = H5Pcreate(H5P_DATASET_ACCESS)) < 0) FAIL_STACK_ERROR
+            if(threaded && H5Pset_chunk_encode_nthreads(dapl, 4) < 0) FAIL_STACK_ERROR
+
+            HDsnprintf(dname, sizeof(dname), "filter_mode_%u_%u", fill_case, threaded);
+            if((dsid = H5Dcreate2(fid, dname, H5T_NATIVE_INT, sid, H5P_DEFAULT, dcpl, dapl)) < 0)
+                FAIL_STACK_ERROR
+            if(H5Dwrite(dsid, H5T_NATIVE_INT, H5S_ALL, H5S_ALL, H5P_DEFAULT, wbuf) < 0) FAIL_STACK_ERROR
+            if(H5Dclose(dsid) < 0) FAIL_STACK_ERROR
+            dsid = -1;
+            if(H5Pclose(dapl) < 0) FAIL_STACK_ERROR
+            dapl = -1;
+
+            if((dsid = H5Dopen2(fid, dname, H5P_DEFAULT)) < 0) FAIL_STACK_ERROR
+
+            /* The fill value chunks are stored only when they have to be */
+            if(H5Dget_num_chunks(dsid, H5S_ALL, &nchunks) < 0) FAIL_STACK_ERROR
+            if(nchunks != (fill_case == 2 ? 5 : 3)) TEST_ERROR
+            offset = 0;
+            if(H5Dget_chunk_info_by_coord(dsid, &offset, &filter_mask, &addr, &size) < 0) FAIL_STACK_ERROR
+            if(fill_case == 2 ? addr == HADDR_UNDEF : (addr != HADDR_UNDEF || size != 0))
+                TEST_ERROR
+
+            /* Compressible data is compressed */
+            offset = FILTER_MODE_CHUNK;
+            if(H5Dget_chunk_info_by_coord(dsid, &offset, &filter_mask, &addr, &size) < 0) FAIL_STACK_ERROR
+            if(filter_mask != 0 || size >= FILTER_MODE_CHUNK * sizeof(int) / 2) TEST_ERROR
+
+            /* Random data is stored with only its checksum */
+            offset = 2 * FILTER_MODE_CHUNK;
+            if(H5Dget_chunk_info_by_coord(dsid, &offset, &filter_mask, &addr, &size) < 0) FAIL_STACK_ERROR
+            if(filter_mask != 0x1 || size != FILTER_MODE_CHUNK * sizeof(int) + 4) TEST_ERROR
+
+            /* Check the data */
+            HDmemset(rbuf, 0, FILTER_MODE_CHUNK * FILTER_MODE_NCHUNKS * sizeof(int));
+            if(H5Dread(dsid, H5T_NATIVE_INT, H5S_ALL, H5S_ALL, H5P_DEFAULT, rbuf) < 0) FAIL_STACK_ERROR
+            if(HDmemcmp(rbuf, wbuf, FILTER_MODE_CHUNK * FILTER_MODE_NCHUNKS * sizeof(int)) != 0) TEST_ERROR
+
+            if(H5Dclose(dsid) < 0) FAIL_STACK_ERROR
+            dsid = -1;
+        } /* end for */
+
+    /* Release resources */
+    if(H5Pclose(dcpl) < 0) FAIL_STACK_ERROR
+    if(H5Sclose(sid) < 0) FAIL_STACK_ERROR
+    if(H5Fclose(fid) < 0) FAIL_STACK_ERROR
+    HDfree(wbuf);
+    HDfree(rbuf);
+
+    PASSED();
+    return SUCCEED;
+
+error:
+    H5E_BEGIN_TRY {
+        H5Dclose(dsid);
+        H5Pclose(dapl);
+        H5Pclose(dcpl);
+        H5Sclose(sid);
+        H5Fclose(fid);
+    } H5E_END_TRY;
+    HDfree(wbuf);
+    HDfree(rbuf);
+    return FAIL;
+#else /* H5_HAVE_FILTER_LZ4 */
+    (void)fapl;
+
+    TESTING("adaptive chunk filter mode");
+    SKIPPED();
+    HDputs("    lz4 filter not enabled");
+
+    return SUCCEED;
+#endif /* H5_HAVE_FILTER_LZ4 */
+} /* end test_chunk_filter_mode() */
+
+
 /*-------------------------------------------------------------------------
  * Function:    test_big_chunks_bypass_cache
  *
@@ -13658,12 +16700,14 @@ main(void)
                 nerrors += (test_nbit_compound_3(file) < 0         ? 1 : 0);
                 nerrors += (test_nbit_int_size(file) < 0         ? 1 : 0);
                 nerrors += (test_nbit_flt_size(file) < 0         ? 1 : 0);
+                nerrors += (test_nbit_packed(file) < 0         ? 1 : 0);
                 nerrors += (test_scaleoffset_int(file) < 0         ? 1 : 0);
                 nerrors += (test_scaleoffset_int_2(file) < 0             ? 1 : 0);
                 nerrors += (test_scaleoffset_float(file) < 0             ? 1 : 0);
                 nerrors += (test_scaleoffset_float_2(file) < 0             ? 1 : 0);
                 nerrors += (test_scaleoffset_double(file) < 0             ? 1 : 0);
                 nerrors += (test_scaleoffset_double_2(file) < 0     ? 1 : 0);
+                nerrors += (test_scaleoffset_packed(file) < 0       ? 1 : 0);
                 nerrors += (test_multiopen (file) < 0                ? 1 : 0);
                 nerrors += (test_types(file) < 0                       ? 1 : 0);
                 nerrors += (test_userblock_offset(envval, my_fapl, new_format) < 0  ? 1 : 0);
@@ -13686,6 +16730,24 @@ main(void)
 
                 nerrors += (test_huge_chunks(my_fapl) < 0        ? 1 : 0);
                 nerrors += (test_chunk_cache(my_fapl) < 0        ? 1 : 0);
+                nerrors += (test_chunk_decode_nthreads(my_fapl) < 0     ? 1 : 0);
+                nerrors += (test_chunk_encode_nthreads(my_fapl) < 0     ? 1 : 0);
+                nerrors += (test_chunk_readahead(my_fapl) < 0           ? 1 : 0);
+                nerrors += (test_chunk_cache_policy(my_fapl) < 0        ? 1 : 0);
+                nerrors += (test_chunk_cache_budget(my_fapl) < 0        ? 1 : 0);
+                nerrors += (test_chunk_cache_stats(my_fapl) < 0         ? 1 : 0);
+                nerrors += (test_chunk_addr_table(my_fapl) < 0          ? 1 : 0);
+                nerrors += (test_chunk_read_coalesce(my_fapl) < 0       ? 1 : 0);
+                nerrors += (test_chunk_buf_pool(my_fapl) < 0            ? 1 : 0);
+                nerrors += (test_chunk_sel_points(my_fapl) < 0          ? 1 : 0);
+                nerrors += (test_chunk_sel_hyper(my_fapl) < 0           ? 1 : 0);
+                nerrors += (test_shuffle_sizes(my_fapl) < 0             ? 1 : 0);
+                nerrors += (test_bitshuffle(my_fapl) < 0                ? 1 : 0);
+                nerrors += (test_bitshuffle_lz4(my_fapl) < 0            ? 1 : 0);
+                nerrors += (test_lz4(my_fapl) < 0                       ? 1 : 0);
+                nerrors += (test_deflate_nthreads(my_fapl) < 0          ? 1 : 0);
+                nerrors += (test_deflate_decode(my_fapl) < 0            ? 1 : 0);
+                nerrors += (test_chunk_filter_mode(my_fapl) < 0         ? 1 : 0);
                 nerrors += (test_big_chunks_bypass_cache(my_fapl) < 0   ? 1 : 0);
                 nerrors += (test_chunk_fast(envval, my_fapl) < 0    ? 1 : 0);
                 nerrors += (test_reopen_chunk_fast(my_fapl) < 0        ? 1 : 0);
@@ -661,6 +661,311 @@ error:
 }
 
 
+/*-------------------------------------------------------------------------
+ * Function:    conv_vec_except
+ *
+ * Purpose:     Counts the conversion exceptions raised in test_hard_vec()
+ *              and leaves them to the library.
+ *
+ * Return:      H5T_CONV_UNHANDLED
+ *
+ *-------------------------------------------------------------------------
+ */
+static H5T_conv_ret_t
+conv_vec_except(H5T_conv_except_t H5_ATTR_UNUSED except_type, hid_t H5_ATTR_UNUSED src_id,
+    hid_t H5_ATTR_UNUSED dst_id, void H5_ATTR_UNUSED *src_buf, void H5_ATTR_UNUSED *dst_buf,
+    void *user_data)
+{
+    (*(unsigned *)user_data)++;
+
+    return H5T_CONV_UNHANDLED;
+}
+
+
+/*-------------------------------------------------------------------------
+ * Function:    test_hard_vec
+ *
+ * Purpose:     Tests hard conversions of contiguous buffers long enough
+ *              for the vector kernels, with out-of-range and special
+ *              values scattered through them and in the elements left
+ *              over for the scalar loop, in place, and with and without
+ *              an exception callback.
+ *
+ * Return:      Success:        0
+ *
+ *              Failure:        number of errors
+ *
+ *-------------------------------------------------------------------------
+ */
+#define HARD_VEC_NELMTS 1003
+/* Source values for long long -> int: the last three elements are left
+ * over for the scalar loop by the vector kernels, so they're out of range
+ * too */
+#define HARD_VEC_LLONG(U) ((U) >= HARD_VEC_NELMTS - 3 ? lspecial[(U) - (HARD_VEC_NELMTS - 3)] : \
+        ((U) % 29 ? (long long)(U) * 1000 - 500000 : lspecial[((U) / 29) % 8]))
+/* Without exception handling, integer hard conversions are plain casts */
+#ifdef H5_WANT_DCONV_EXCEPTION
+#define HARD_VEC_LLONG_INT(L) ((L) > INT_MAX ? INT_MAX : ((L) < INT_MIN ? INT_MIN : (int)(L)))
+#else /* H5_WANT_DCONV_EXCEPTION */
+#define HARD_VEC_LLONG_INT(L) ((int)(L))
+#endif /* H5_WANT_DCONV_EXCEPTION */
+static int
+test_hard_vec(void)
+{
+    const double dspecial[] = {(double)FLT_MAX * 1.0000001, -(double)FLT_MAX * 1.0000001, 1e300, -1e300,
+            (double)FLT_MAX, -(double)FLT_MAX, 1e-320, -0.0};
+    const long long lspecial[] = {(long long)INT_MAX + 1, (long long)INT_MIN - 1, LLONG_MAX, LLONG_MIN,
+            INT_MAX, INT_MIN, -1, 0};
+    void        *buf = NULL;
+    double      *dbuf;
+    float       *fbuf;
+    long long   *lbuf;
+    int         *ibuf;
+    short       *sbuf;
+    hid_t       dxpl = -1;
+    unsigned    nexcept, nover;
+    size_t      u;
+
+    TESTING("hard conversions of contiguous buffers");
+
+    if(NULL == (buf = HDmalloc(HARD_VEC_NELMTS * sizeof(double)))) TEST_ERROR
+    dbuf = (double *)buf;
+    fbuf = (float *)buf;
+    lbuf = (long long *)buf;
+    ibuf = (int *)buf;
+    sbuf = (short *)buf;
+
+    /* double -> float, with and without an exception callback */
+    if((dxpl = H5Pcreate(H5P_DATASET_XFER)) < 0) TEST_ERROR
+    if(H5Pset_type_conv_cb(dxpl, conv_vec_except, &nexcept) < 0) TEST_ERROR
+    for(nover = 0; nover < 2; nover++) {
+        nexcept = 0;
+        for(u = 0; u < HARD_VEC_NELMTS; u++)
+            dbuf[u] = (u % 37) ? (double)u * 1.5 - 300.0 : dspecial[(u / 37) % 8];
+        if(H5Tconvert(H5T_NATIVE_DOUBLE, H5T_NATIVE_FLOAT, (size_t)HARD_VEC_NELMTS, buf, NULL, nover ? dxpl : H5P_DEFAULT) < 0) TEST_ERROR
+        for(u = 0; u < HARD_VEC_NELMTS; u++) {
+            double d = (u % 37) ? (double)u * 1.5 - 300.0 : dspecial[(u / 37) % 8];
+            float expect = d > (double)FLT_MAX ? H5T_NATIVE_FLOAT_POS_INF_g :
+                    (d < -(double)FLT_MAX ? H5T_NATIVE_FLOAT_NEG_INF_g : (float)d);
+
+            if(HDmemcmp(&fbuf[u], &expect, sizeof(float))) {
+                H5_FAILED();
+                HDprintf("    double -> float element %u: %g converted to %g\n", (unsigned)u, d, (double)fbuf[u]);
+                goto error;
+            } /* end if */
+        } /* end for */
+#ifdef H5_WANT_DCONV_EXCEPTION
+        /* (The hard conversions only call the exception callback when the
+         *  library is built with exception handling) */
+        if(nover && 0 == nexcept) TEST_ERROR
+#endif /* H5_WANT_DCONV_EXCEPTION */
+    } /* end for */
+
+    /* long long -> int */
+    for(u = 0; u < HARD_VEC_NELMTS; u++)
+        lbuf[u] = HARD_VEC_LLONG(u);
+    if(H5Tconvert(H5T_NATIVE_LLONG, H5T_NATIVE_INT, (size_t)HARD_VEC_NELMTS, buf, NULL, H5P_DEFAULT) < 0) TEST_ERROR
+    for(u = 0; u < HARD_VEC_NELMTS; u++) {
+        long long l = HARD_VEC_LLONG(u);
+        int expect = HARD_VEC_LLONG_INT(l);
+
+        if(ibuf[u] != expect) {
+            H5_FAILED();
+            HDprintf("    long long -> int element %u: %lld converted to %d\n", (unsigned)u, l, ibuf[u]);
+            goto error;
+        } /* end if */
+    } /* end for */
+
+    /* int -> long long, which widens the buffer */
+    if(H5Tconvert(H5T_NATIVE_INT, H5T_NATIVE_LLONG, (size_t)HARD_VEC_NELMTS, buf, NULL, H5P_DEFAULT) < 0) TEST_ERROR
+    for(u = 0; u < HARD_VEC_NELMTS; u++) {
+        long long expect = HARD_VEC_LLONG_INT(HARD_VEC_LLONG(u));
+
+        if(lbuf[u] != expect) {
+            H5_FAILED();
+            HDprintf("    int -> long long element %u: converted to %lld\n", (unsigned)u, lbuf[u]);
+            goto error;
+        } /* end if */
+    } /* end for */
+
+    /* short -> float */
+    for(u = 0; u < HARD_VEC_NELMTS; u++)
+        sbuf[u] = (short)((u * 65) - 32768);
+    if(H5Tconvert(H5T_NATIVE_SHORT, H5T_NATIVE_FLOAT, (size_t)HARD_VEC_NELMTS, buf, NULL, H5P_DEFAULT) < 0) TEST_ERROR
+    for(u = 0; u < HARD_VEC_NELMTS; u++) {
+        float expect = (float)(short)((u * 65) - 32768);
+
+        if(HDmemcmp(&fbuf[u], &expect, sizeof(float))) {
+            H5_FAILED();
+            HDprintf("    short -> float element %u: converted to %g\n", (unsigned)u, (double)fbuf[u]);
+            goto error;
+        } /* end if */
+    } /* end for */
+
+    if(H5Pclose(dxpl) < 0) TEST_ERROR
+    HDfree(buf);
+
+    PASSED();
+    return 0;
+
+error:
+    H5E_BEGIN_TRY {
+        H5Pclose(dxpl);
+    } H5E_END_TRY;
+    if(buf)
+        HDfree(buf);
+    return 1;
+} /* end test_hard_vec() */
+
+
+/*-------------------------------------------------------------------------
+ * Function:    test_order_vec
+ *
+ * Purpose:     Tests byte order conversions of 2, 4, 8 and 16-byte
+ *              integers in contiguous buffers long enough for the vector
+ *              kernels and in strided buffers (compound members), and the
+ *              conversion from big-endian 16-bit integers to native float
+ *              which swaps and converts in one pass.
+ *
+ * Return:      Success:        0
+ *
+ *              Failure:        number of errors
+ *
+ *-------------------------------------------------------------------------
+ */
+static int
+test_order_vec(void)
+{
+    const size_t sizes[] = {2, 4, 8, 16};
+    const size_t offs[] = {0, 2, 6};    /* Offsets of the compound members */
+    unsigned char *buf = NULL;
+    void        *bkg = NULL;
+    float       *fbuf;
+    hid_t       src = -1, dst = -1;
+    size_t      i, u, k;
+
+    TESTING("byte order conversions of contiguous and strided buffers");
+
+    if(NULL == (buf = (unsigned char *)HDmalloc(HARD_VEC_NELMTS * 16))) TEST_ERROR
+    if(NULL == (bkg = HDcalloc((size_t)HARD_VEC_NELMTS, (size_t)16))) TEST_ERROR
+    fbuf = (float *)buf;
+
+    /* Contiguous elements */
+    for(i = 0; i < NELMTS(sizes); i++) {
+        if((src = H5Tcopy(H5T_STD_U64BE)) < 0) TEST_ERROR
+        if(H5Tset_size(src, sizes[i]) < 0) TEST_ERROR
+        if(H5Tset_precision(src, 8 * sizes[i]) < 0) TEST_ERROR
+        if((dst = H5Tcopy(src)) < 0) TEST_ERROR
+        if(H5Tset_order(dst, H5T_ORDER_LE) < 0) TEST_ERROR
+
+        for(u = 0; u < HARD_VEC_NELMTS * sizes[i]; u++)
+            buf[u] = (unsigned char)(u * 7 + 3);
+        if(H5Tconvert(src, dst, (size_t)HARD_VEC_NELMTS, buf, NULL, H5P_DEFAULT) < 0) TEST_ERROR
+        for(u = 0; u < HARD_VEC_NELMTS; u++)
+            for(k = 0; k < sizes[i]; k++)
+                if(buf[u * sizes[i] + k] != (unsigned char)((u * sizes[i] + sizes[i] - 1 - k) * 7 + 3)) {
+                    H5_FAILED();
+                    HDprintf("    %u-byte element %u: byte %u is wrong\n", (unsigned)sizes[i], (unsigned)u, (unsigned)k);
+                    goto error;
+                } /* end if */
+
+        if(H5Tclose(src) < 0) TEST_ERROR
+        if(H5Tclose(dst) < 0) TEST_ERROR
+    } /* end for */
+
+    /* Strided elements: the members of a packed compound */
+    if((src = H5Tcreate(H5T_COMPOUND, (size_t)14)) < 0) TEST_ERROR
+    if(H5Tinsert(src, "s", offs[0], H5T_STD_U16BE) < 0) TEST_ERROR
+    if(H5Tinsert(src, "i", offs[1], H5T_STD_U32BE) < 0) TEST_ERROR
+    if(H5Tinsert(src, "l", offs[2], H5T_STD_U64BE) < 0) TEST_ERROR
+    if((dst = H5Tcreate(H5T_COMPOUND, (size_t)14)) < 0) TEST_ERROR
+    if(H5Tinsert(dst, "s", offs[0], H5T_STD_U16LE) < 0) TEST_ERROR
+    if(H5Tinsert(dst, "i", offs[1], H5T_STD_U32LE) < 0) TEST_ERROR
+    if(H5Tinsert(dst, "l", offs[2], H5T_STD_U64LE) < 0) TEST_ERROR
+
+    for(u = 0; u < HARD_VEC_NELMTS * 14; u++)
+        buf[u] = (unsigned char)(u * 7 + 3);
+    if(H5Tconvert(src, dst, (size_t)HARD_VEC_NELMTS, buf, bkg, H5P_DEFAULT) < 0) TEST_ERROR
+    for(u = 0; u < HARD_VEC_NELMTS; u++)
+        for(i = 0; i < NELMTS(offs); i++)
+            for(k = 0; k < sizes[i]; k++)
+                if(buf[u * 14 + offs[i] + k] != (unsigned char)((u * 14 + offs[i] + sizes[i] - 1 - k) * 7 + 3)) {
+                    H5_FAILED();
+                    HDprintf("    compound element %u: byte %u of member %u is wrong\n", (unsigned)u, (unsigned)k, (unsigned)i);
+                    goto error;
+                } /* end if */
+
+    if(H5Tclose(src) < 0) TEST_ERROR
+    if(H5Tclose(dst) < 0) TEST_ERROR
+
+    /* Big-endian 16-bit integers -> float, converted by the library itself
+     * on little-endian machines */
+    if(H5T_ORDER_LE == H5Tget_order(H5T_NATIVE_INT) &&
+            H5Tcompiler_conv(H5T_STD_I16BE, H5T_NATIVE_FLOAT) != TRUE) {
+        H5_FAILED();
+        HDputs("    no hard conversion from big-endian 16-bit integers to float");
+        goto error;
+    } /* end if */
+    for(u = 0; u < HARD_VEC_NELMTS; u++) {
+        unsigned short us = (unsigned short)((u * 65) - 32768);
+
+        buf[2 * u] = (unsigned char)(us >> 8);
+        buf[2 * u + 1] = (unsigned char)(us & 0xff);
+    } /* end for */
+    if(H5Tconvert(H5T_STD_I16BE, H5T_NATIVE_FLOAT, (size_t)HARD_VEC_NELMTS, buf, NULL, H5P_DEFAULT) < 0) TEST_ERROR
+    for(u = 0; u < HARD_VEC_NELMTS; u++) {
+        float expect = (float)(short)((u * 65) - 32768);
+
+        if(HDmemcmp(&fbuf[u], &expect, sizeof(float))) {
+            H5_FAILED();
+            HDprintf("    16-bit big-endian -> float element %u: converted to %g\n", (unsigned)u, (double)fbuf[u]);
+            goto error;
+        } /* end if */
+    } /* end for */
+
+    /* The same, strided */
+    if((src = H5Tcreate(H5T_COMPOUND, sizeof(float))) < 0) TEST_ERROR
+    if(H5Tinsert(src, "v", (size_t)0, H5T_STD_I16BE) < 0) TEST_ERROR
+    if((dst = H5Tcreate(H5T_COMPOUND, sizeof(float))) < 0) TEST_ERROR
+    if(H5Tinsert(dst, "v", (size_t)0, H5T_NATIVE_FLOAT) < 0) TEST_ERROR
+    for(u = 0; u < HARD_VEC_NELMTS; u++) {
+        unsigned short us = (unsigned short)((u * 65) - 32768);
+
+        buf[4 * u] = (unsigned char)(us >> 8);
+        buf[4 * u + 1] = (unsigned char)(us & 0xff);
+    } /* end for */
+    if(H5Tconvert(src, dst, (size_t)HARD_VEC_NELMTS, buf, bkg, H5P_DEFAULT) < 0) TEST_ERROR
+    for(u = 0; u < HARD_VEC_NELMTS; u++) {
+        float expect = (float)(short)((u * 65) - 32768);
+
+        if(HDmemcmp(&fbuf[u], &expect, sizeof(float))) {
+            H5_FAILED();
+            HDprintf("    strided 16-bit big-endian -> float element %u: converted to %g\n", (unsigned)u, (double)fbuf[u]);
+            goto error;
+        } /* end if */
+    } /* end for */
+
+    if(H5Tclose(src) < 0) TEST_ERROR
+    if(H5Tclose(dst) < 0) TEST_ERROR
+    HDfree(buf);
+    HDfree(bkg);
+
+    PASSED();
+    return 0;
+
+error:
+    H5E_BEGIN_TRY {
+        H5Tclose(src);
+        H5Tclose(dst);
+    } H5E_END_TRY;
+    if(buf)
+        HDfree(buf);
+    if(bkg)
+        HDfree(bkg);
+    return 1;
+} /* end test_order_vec() */
+
+
 /*-------------------------------------------------------------------------
  * Function:    expt_handle
  *
@@ -5241,6 +5546,8 @@ main(void)
 
     /* Test H5Tcompiler_conv() for querying hard conversion. */
     nerrors += (unsigned long)test_hard_query();
+    nerrors += (unsigned long)test_hard_vec();
+    nerrors += (unsigned long)test_order_vec();
 
     /* Test user-define, query functions and software conversion
      * for user-defined floating-point types */
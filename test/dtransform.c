@@ -16,12 +16,14 @@
 #define ROWS    12
 #define COLS    18
 #define FLOAT_TOL 0.0001F
+#define LARGE_NELMTS 1000    /* Not a multiple of the transform's block size */
 
 static int init_test(hid_t file_id);
 static int test_copy(const hid_t dxpl_id_c_to_f_copy, const hid_t dxpl_id_polynomial_copy);
 static int test_trivial(const hid_t dxpl_id_simple);
 static int test_poly(const hid_t dxpl_id_polynomial);
 static int test_specials(hid_t file);
+static int test_large(hid_t file);
 static int test_set(void);
 static int test_getset(const hid_t dxpl_id_simple);
 
@@ -325,6 +327,7 @@ int main(void)
     if(test_poly(dxpl_id_polynomial) < 0) TEST_ERROR;
     if(test_getset(dxpl_id_c_to_f) < 0) TEST_ERROR;
     if(test_specials(file_id) < 0) TEST_ERROR;
+    if(test_large(file_id) < 0) TEST_ERROR;
 
     /* Close the objects we opened/created */
     if(H5Dclose(dset_id_int) < 0) TEST_ERROR;
@@ -648,6 +651,126 @@ error:
      return -1;
 }
 
+/*-------------------------------------------------------------------------
+ * Function:    test_large
+ *
+ * Purpose:     Checks transforms over more elements than the library
+ *              evaluates at once, so that both whole blocks and a partial
+ *              block are used, for a linear transform, a transform that
+ *              uses the data several times and one that is nested too
+ *              deeply to be compiled.
+ *
+ * Return:      Success:        0
+ *              Failure:        -1
+ *-------------------------------------------------------------------------
+ */
+static int
+test_large(hid_t file)
+{
+    hid_t dxpl_id = -1, dset_id = -1, dataspace = -1;
+    hsize_t dim = LARGE_NELMTS;
+    int *orig = NULL, *int_buf = NULL;
+    double *dbl_buf = NULL;
+    const char* linear = "2.5*x+10";
+    const char* quadratic = "x*x - 3*x + 2";
+    const char* nested = "x*(x*(x*(x*(x*(x*(x*(x*(x+1))))))))";
+    size_t u;
+
+    TESTING("data transform over many elements")
+
+    if(NULL == (orig = (int *)HDmalloc(LARGE_NELMTS * sizeof(int))))
+        TEST_ERROR
+    if(NULL == (int_buf = (int *)HDmalloc(LARGE_NELMTS * sizeof(int))))
+        TEST_ERROR
+    if(NULL == (dbl_buf = (double *)HDmalloc(LARGE_NELMTS * sizeof(double))))
+        TEST_ERROR
+    for(u = 0; u < LARGE_NELMTS; u++)
+        orig[u] = (int)(u % 5);
+
+    if((dataspace = H5Screate_simple(1, &dim, NULL)) < 0)
+        TEST_ERROR
+    if((dset_id = H5Dcreate2(file, "/large", H5T_NATIVE_INT,
+            dataspace, H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT)) < 0)
+        TEST_ERROR
+    if((dxpl_id = H5Pcreate(H5P_DATASET_XFER)) < 0)
+        TEST_ERROR
+
+    /* Linear transform, on read with conversion to double */
+    if(H5Dwrite(dset_id, H5T_NATIVE_INT, H5S_ALL, H5S_ALL, H5P_DEFAULT, orig) < 0)
+        TEST_ERROR
+    if(H5Pset_data_transform(dxpl_id, linear) < 0)
+        TEST_ERROR
+    if(H5Dread(dset_id, H5T_NATIVE_DOUBLE, H5S_ALL, H5S_ALL, dxpl_id, dbl_buf) < 0)
+        TEST_ERROR
+    for(u = 0; u < LARGE_NELMTS; u++)
+        if(!H5_DBL_ABS_EQUAL(dbl_buf[u], 2.5 * (double)orig[u] + 10.0)) {
+            H5_FAILED();
+            HDfprintf(stderr, "    ERROR: element %zu is %f after transform \"%s\"\n", u, dbl_buf[u], linear);
+            goto error;
+        } /* end if */
+
+    /* Transform that uses the data three times, on write */
+    if(H5Pset_data_transform(dxpl_id, quadratic) < 0)
+        TEST_ERROR
+    if(H5Dwrite(dset_id, H5T_NATIVE_INT, H5S_ALL, H5S_ALL, dxpl_id, orig) < 0)
+        TEST_ERROR
+    if(H5Dread(dset_id, H5T_NATIVE_INT, H5S_ALL, H5S_ALL, H5P_DEFAULT, int_buf) < 0)
+        TEST_ERROR
+    for(u = 0; u < LARGE_NELMTS; u++)
+        if(int_buf[u] != orig[u] * orig[u] - 3 * orig[u] + 2) {
+            H5_FAILED();
+            HDfprintf(stderr, "    ERROR: element %zu is %d after transform \"%s\"\n", u, int_buf[u], quadratic);
+            goto error;
+        } /* end if */
+
+    /* Deeply nested transform, on read */
+    if(H5Dwrite(dset_id, H5T_NATIVE_INT, H5S_ALL, H5S_ALL, H5P_DEFAULT, orig) < 0)
+        TEST_ERROR
+    if(H5Pset_data_transform(dxpl_id, nested) < 0)
+        TEST_ERROR
+    if(H5Dread(dset_id, H5T_NATIVE_INT, H5S_ALL, H5S_ALL, dxpl_id, int_buf) < 0)
+        TEST_ERROR
+    for(u = 0; u < LARGE_NELMTS; u++) {
+        int expect = orig[u] + 1;
+        int i;
+
+        for(i = 0; i < 8; i++)
+            expect *= orig[u];
+        if(int_buf[u] != expect) {
+            H5_FAILED();
+            HDfprintf(stderr, "    ERROR: element %zu is %d after transform \"%s\"\n", u, int_buf[u], nested);
+            goto error;
+        } /* end if */
+    } /* end for */
+
+    if(H5Pclose(dxpl_id) < 0)
+        TEST_ERROR
+    if(H5Dclose(dset_id) < 0)
+        TEST_ERROR
+    if(H5Sclose(dataspace) < 0)
+        TEST_ERROR
+    HDfree(orig);
+    HDfree(int_buf);
+    HDfree(dbl_buf);
+
+    PASSED();
+    return 0;
+
+error:
+    H5E_BEGIN_TRY {
+        H5Pclose(dxpl_id);
+        H5Dclose(dset_id);
+        H5Sclose(dataspace);
+    } H5E_END_TRY
+    if(orig)
+        HDfree(orig);
+    if(int_buf)
+        HDfree(int_buf);
+    if(dbl_buf)
+        HDfree(dbl_buf);
+    return -1;
+}
+
 static int
 test_copy(const hid_t dxpl_id_c_to_f_copy, const hid_t dxpl_id_polynomial_copy)
 {
@@ -3432,6 +3432,115 @@ error:
 } /* end test_compound_18() */
 
 
+/*-------------------------------------------------------------------------
+ * Function:    test_compound_19
+ *
+ * Purpose:     Tests that the conversion path for a large compound type is
+ *              found again for equal types whose members were inserted in
+ *              a different order, and that registering and unregistering
+ *              a hard conversion function for that pair of types replaces
+ *              and removes the path.
+ *
+ * Return:      Success:        0
+ *              Failure:        number of errors
+ *
+ *-------------------------------------------------------------------------
+ */
+#define COMPOUND19_NMEMBS       200
+static int
+test_compound_19(void)
+{
+    hid_t       src = -1, src2 = -1, dst = -1;
+    H5T_conv_t  func, func2;
+    H5T_cdata_t *cdata = NULL, *cdata2 = NULL;
+    int         *buf = NULL;
+    long long   *lbuf, *bkg = NULL;
+    char        name[16];
+    unsigned    u;
+
+    TESTING("conversion path lookup for large compound types");
+
+    /* SRC and SRC2 are the same struct of ints, with the members inserted
+     * in opposite orders.  DST holds the members as long longs in reverse
+     * order. */
+    if((src = H5Tcreate(H5T_COMPOUND, COMPOUND19_NMEMBS * sizeof(int))) < 0) TEST_ERROR
+    if((src2 = H5Tcreate(H5T_COMPOUND, COMPOUND19_NMEMBS * sizeof(int))) < 0) TEST_ERROR
+    if((dst = H5Tcreate(H5T_COMPOUND, COMPOUND19_NMEMBS * sizeof(long long))) < 0) TEST_ERROR
+    for(u = 0; u < COMPOUND19_NMEMBS; u++) {
+        unsigned v = COMPOUND19_NMEMBS - 1 - u;
+
+        HDsnprintf(name, sizeof(name), "m%03u", u);
+        if(H5Tinsert(src, name, u * sizeof(int), H5T_NATIVE_INT) < 0) TEST_ERROR
+        if(H5Tinsert(dst, name, v * sizeof(long long), H5T_NATIVE_LLONG) < 0) TEST_ERROR
+        HDsnprintf(name, sizeof(name), "m%03u", v);
+        if(H5Tinsert(src2, name, v * sizeof(int), H5T_NATIVE_INT) < 0) TEST_ERROR
+    } /* end for */
+    if(H5Tequal(src, src2) <= 0) TEST_ERROR
+
+    /* Equal source types must find the same path */
+    if(NULL == (func = H5Tfind(src, dst, &cdata))) TEST_ERROR
+    if(NULL == (func2 = H5Tfind(src2, dst, &cdata2))) TEST_ERROR
+    if(func != func2 || cdata != cdata2) {
+        H5_FAILED(); AT();
+        HDprintf("    Equal compound types found different conversion paths\n");
+        goto error;
+    } /* end if */
+
+    /* Convert some data */
+    if(NULL == (buf = (int *)HDmalloc(COMPOUND19_NMEMBS * sizeof(long long)))) TEST_ERROR
+    if(NULL == (bkg = (long long *)HDcalloc(COMPOUND19_NMEMBS, sizeof(long long)))) TEST_ERROR
+    for(u = 0; u < COMPOUND19_NMEMBS; u++)
+        buf[u] = (int)u - 100;
+    if(H5Tconvert(src2, dst, (size_t)1, buf, bkg, H5P_DEFAULT) < 0) TEST_ERROR
+    lbuf = (long long *)buf;
+    for(u = 0; u < COMPOUND19_NMEMBS; u++)
+        if(lbuf[COMPOUND19_NMEMBS - 1 - u] != (long long)u - 100) {
+            H5_FAILED(); AT();
+            HDprintf("    Member %u converted to %lld\n", u, lbuf[COMPOUND19_NMEMBS - 1 - u]);
+            goto error;
+        } /* end if */
+
+    /* Replace the path with an application conversion which only counts
+     * its calls, then remove it again */
+    num_opaque_conversions_g = 0;
+    if(H5Tregister(H5T_PERS_HARD, "cmpd19", src, dst, convert_opaque) < 0) TEST_ERROR
+    if(convert_opaque != H5Tfind(src2, dst, &cdata2)) TEST_ERROR
+    if(H5Tconvert(src2, dst, (size_t)1, buf, bkg, H5P_DEFAULT) < 0) TEST_ERROR
+    if(1 != num_opaque_conversions_g) TEST_ERROR
+    if(H5Tunregister(H5T_PERS_HARD, "cmpd19", src, dst, convert_opaque) < 0) TEST_ERROR
+    if(NULL == (func2 = H5Tfind(src2, dst, &cdata2))) TEST_ERROR
+    if(func2 == convert_opaque) TEST_ERROR
+
+    for(u = 0; u < COMPOUND19_NMEMBS; u++)
+        buf[u] = (int)u;
+    if(H5Tconvert(src, dst, (size_t)1, buf, bkg, H5P_DEFAULT) < 0) TEST_ERROR
+    if(1 != num_opaque_conversions_g) TEST_ERROR
+    for(u = 0; u < COMPOUND19_NMEMBS; u++)
+        if(lbuf[COMPOUND19_NMEMBS - 1 - u] != (long long)u) TEST_ERROR
+
+    HDfree(buf);
+    HDfree(bkg);
+    if(H5Tclose(src) < 0) TEST_ERROR
+    if(H5Tclose(src2) < 0) TEST_ERROR
+    if(H5Tclose(dst) < 0) TEST_ERROR
+
+    PASSED();
+    return 0;
+
+error:
+    if(buf)
+        HDfree(buf);
+    if(bkg)
+        HDfree(bkg);
+    H5E_BEGIN_TRY {
+        H5Tclose(src);
+        H5Tclose(src2);
+        H5Tclose(dst);
+    } H5E_END_TRY;
+    return 1;
+} /* end test_compound_19() */
+
+
 /*-------------------------------------------------------------------------
  * Function:    test_query
  *
@@ -7890,6 +7999,7 @@ main(void)
     nerrors += test_compound_16();
     nerrors += test_compound_17();
     nerrors += test_compound_18();
+    nerrors += test_compound_19();
     nerrors += test_conv_enum_1();
     nerrors += test_conv_enum_2();
     nerrors += test_conv_bitfield();
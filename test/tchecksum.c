@@ -32,6 +32,15 @@
 /**********/
 #define BUF_LEN 3093    /* No particular value */
 
+/* Buffer sizes for comparing against the reference checksums */
+#define REF_MAX_LEN     1100    /* Longest short buffer */
+#define REF_MAX_OFFSET  32      /* Largest misalignment of short buffers */
+#define REF_HUGE_LEN    (2 * 1024 * 1024 + 37)  /* Buffer beyond any block limit */
+
+/* Buffer size and number of passes for timing the checksums */
+#define SPEED_BUF_LEN   (1024 * 1024)
+#define SPEED_NPASSES   64
+
 /*******************/
 /* Local variables */
 /*******************/
@@ -218,6 +227,149 @@ test_chksum_large(void)
     HDfree(large_buf);
 } /* test_chksum_large() */
 
+
+/****************************************************************
+**
+**  ref_fletcher32(): Fletcher32 checksum, summing one 16-bit word
+**      at a time with 64-bit sums
+**
+****************************************************************/
+static uint32_t
+ref_fletcher32(const uint8_t *data, size_t len)
+{
+    uint64_t sum1 = 0, sum2 = 0;        /* Exact sums */
+    size_t u;                           /* Local index variable */
+
+    for(u = 0; u + 1 < len; u += 2) {
+        sum1 += ((uint32_t)data[u] << 8) | data[u + 1];
+        sum2 += sum1;
+    } /* end for */
+    if(len % 2) {
+        sum1 += (uint32_t)data[len - 1] << 8;
+        sum2 += sum1;
+    } /* end if */
+
+    /* Non-zero sums end up in 1..65535 */
+    sum1 = sum1 ? ((sum1 - 1) % 65535) + 1 : 0;
+    sum2 = sum2 ? ((sum2 - 1) % 65535) + 1 : 0;
+
+    return (uint32_t)((sum2 << 16) | sum1);
+} /* ref_fletcher32() */
+
+
+/****************************************************************
+**
+**  ref_crc(): CRC checksum, computed a bit at a time
+**
+****************************************************************/
+static uint32_t
+ref_crc(const uint8_t *data, size_t len)
+{
+    uint32_t crc = 0xffffffff;          /* Running CRC */
+    size_t u;                           /* Local index variable */
+    unsigned v;                         /* Local index variable */
+
+    for(u = 0; u < len; u++) {
+        crc ^= data[u];
+        for(v = 0; v < 8; v++)
+            crc = (crc & 1) ? (0x04C11DB7 ^ (crc >> 1)) : (crc >> 1);
+    } /* end for */
+
+    return crc ^ 0xffffffff;
+} /* ref_crc() */
+
+
+/****************************************************************
+**
+**  test_chksum_reference(): Compare the checksums with simple
+**      reference versions, for many buffer sizes and alignments
+**
+****************************************************************/
+static void
+test_chksum_reference(void)
+{
+    uint8_t *buf;               /* Buffer for checksum calculations */
+    uint32_t chksum;            /* Checksum value */
+    size_t len, off;            /* Buffer length & offset */
+    size_t u;                   /* Local index variable */
+    unsigned pass;              /* Pass through the buffers */
+
+    /* Allocate the buffer */
+    buf = (uint8_t *)HDmalloc((size_t)REF_HUGE_LEN);
+    CHECK_PTR(buf, "HDmalloc");
+
+    /* Use varied data, then all bits set for the largest sums */
+    for(pass = 0; pass < 2; pass++) {
+        for(u = 0; u < REF_HUGE_LEN; u++)
+            buf[u] = pass ? 0xff : (uint8_t)((u * 7919) ^ (u >> 5));
+
+        for(off = 0; off < REF_MAX_OFFSET; off += 3)
+            for(len = 1; len < REF_MAX_LEN; len++) {
+                chksum = H5_checksum_fletcher32(buf + off, len);
+                VERIFY(chksum, ref_fletcher32(buf + off, len), "H5_checksum_fletcher32");
+
+                chksum = H5_checksum_crc(buf + off, len);
+                VERIFY(chksum, ref_crc(buf + off, len), "H5_checksum_crc");
+            } /* end for */
+
+        chksum = H5_checksum_fletcher32(buf, (size_t)REF_HUGE_LEN);
+        VERIFY(chksum, ref_fletcher32(buf, (size_t)REF_HUGE_LEN), "H5_checksum_fletcher32");
+
+        chksum = H5_checksum_crc(buf, (size_t)REF_HUGE_LEN);
+        VERIFY(chksum, ref_crc(buf, (size_t)REF_HUGE_LEN), "H5_checksum_crc");
+    } /* end for */
+
+    /* Release memory for buffer */
+    HDfree(buf);
+} /* test_chksum_reference() */
+
+
+/****************************************************************
+**
+**  test_chksum_speed(): Report the speed of each checksum
+**
+****************************************************************/
+static void
+test_chksum_speed(void)
+{
+    const char *names[3] = {"fletcher32", "crc", "lookup3"};
+    uint8_t *buf;               /* Buffer for checksum calculations */
+    uint32_t chksum = 0;        /* Checksum value */
+    double start, elapsed;      /* Timing */
+    size_t u;                   /* Local index variable */
+    unsigned v, w;              /* Local index variables */
+
+    /* Allocate the buffer */
+    buf = (uint8_t *)HDmalloc((size_t)SPEED_BUF_LEN);
+    CHECK_PTR(buf, "HDmalloc");
+    for(u = 0; u < SPEED_BUF_LEN; u++)
+        buf[u] = (uint8_t)(u * 3);
+
+    for(v = 0; v < 3; v++) {
+        start = H5_get_time();
+        for(w = 0; w < SPEED_NPASSES; w++) {
+            if(v == 0)
+                chksum ^= H5_checksum_fletcher32(buf, (size_t)SPEED_BUF_LEN);
+            else if(v == 1)
+                chksum ^= H5_checksum_crc(buf, (size_t)SPEED_BUF_LEN);
+            else
+                chksum ^= H5_checksum_lookup3(buf, (size_t)SPEED_BUF_LEN, w);
+        } /* end for */
+        elapsed = H5_get_time() - start;
+
+        if(elapsed > 0.0)
+            MESSAGE(5, ("    %-10s %8.2f GB/s\n", names[v],
+                    ((double)SPEED_BUF_LEN * SPEED_NPASSES) / (elapsed * 1.0e9)));
+    } /* end for */
+
+    /* Keep the checksums from being optimized away */
+    if(chksum == 0)
+        MESSAGE(7, ("    checksums folded to zero\n"));
+
+    /* Release memory for buffer */
+    HDfree(buf);
+} /* test_chksum_speed() */
+
 
 /****************************************************************
 **
@@ -236,6 +388,8 @@ test_checksum(void)
     test_chksum_size_three();		/* Test buffer w/only 3 bytes */
     test_chksum_size_four();		/* Test buffer w/only 4 bytes */
     test_chksum_large();		/* Test buffer w/larger # of bytes */
+    test_chksum_reference();		/* Test against reference checksums */
+    test_chksum_speed();		/* Report checksum speeds */
 
 } /* test_checksum() */
 
@@ -0,0 +1,700 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * Copyright by The HDF Group.                                               *
+ * All rights reserved.                                                      *
+ *                                                                           *
+ * This file is part of HDF5.  The full HDF5 copyright notice, including     *
+ * terms governing use, modification, and redistribution, is contained in    *
+ * the COPYING file, which can be found at the root of the source code       *
+ * distribution tree, or in https://support.hdfgroup.org/ftp/HDF5/releases.  *
+ * If you do not have access to either file, you may request a copy from     *
+ * help@hdfgroup.org.                                                        *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+/* ===========================================================================
+ * Usage:  filter_perf [-h] [-s S] [-c S] [-n N] [-o F] [-p P]...
+ *
+ * Measures the filter pipeline: each pipeline is run over a set of
+ * synthetic datasets (smooth floats, noisy ints, sparse ints and a
+ * constant), by writing and reading back a chunked dataset in a file kept
+ * in memory with the core driver.  The compression ratio and the encode
+ * and decode throughput (in MB of raw data per second) of each run are
+ * reported as JSON, so that the results can be compared between builds.
+ *
+ * A pipeline is a list of filters joined with '+', e.g. "shuffle+deflate".
+ * The known filters are shuffle, fletcher32, nbit, scaleoffset, deflate,
+ * szip, lz4 and bitshuffle; any other filter (e.g. one from a plugin) is
+ * given by its ID, optionally followed by its client data values, as in
+ * "32001:0,0,0,0,1".  Pipelines using filters that aren't available, or
+ * that can't be applied to a dataset, are listed as skipped.
+ */
+
+/* our header files */
+#include "h5test.h"
+#include "h5tools.h"
+#include "h5tools_utils.h"
+
+#define ONE_KB              1024
+#define ONE_MB              (ONE_KB * ONE_KB)
+#define ONE_GB              (ONE_MB * ONE_KB)
+
+/* report 0.0 in case t is zero too */
+#define MB_PER_SEC(bytes,t) (((t) < 0.0000000001) ? 0.0 : ((((double)(bytes)) / (double)ONE_MB) / (t)))
+
+#define FILTER_PERF_DSET    "dset"
+#define MAX_STEPS           8           /* Max. number of filters in a pipeline */
+#define MAX_CD_VALUES       16          /* Max. number of client data values for a filter */
+#define MAX_PIPELINES       64          /* Max. number of pipelines on the command line */
+
+/* Kinds of synthetic data */
+typedef enum data_kind_t {
+    DATA_SMOOTH_FLOAT,                  /* Slowly varying floats */
+    DATA_NOISY_INT,                     /* Ramp of ints with a few bits of noise */
+    DATA_SPARSE_INT,                    /* Ints that are mostly zero */
+    DATA_CONSTANT_INT,                  /* The same int everywhere */
+    DATA_NKINDS
+} data_kind_t;
+
+/* Description of a kind of synthetic data */
+typedef struct data_info_t {
+    const char  *name;                  /* Name of the data in the report */
+    hbool_t     is_float;               /* Whether the data are floats (else ints) */
+    size_t      precision;              /* Significant bits of the ints, for the nbit filter */
+} data_info_t;
+
+static const data_info_t data_info[DATA_NKINDS] = {
+    {"smooth_float", TRUE, 0},
+    {"noisy_int", FALSE, 22},
+    {"sparse_int", FALSE, 17},
+    {"constant_int", FALSE, 7}
+};
+
+/* One filter of a pipeline */
+typedef struct filter_step_t {
+    H5Z_filter_t id;                    /* Filter ID */
+    size_t      cd_nelmts;              /* Number of client data values */
+    unsigned    cd_values[MAX_CD_VALUES]; /* Client data values */
+} filter_step_t;
+
+/* A pipeline to measure */
+typedef struct pipeline_t {
+    const char  *name;                  /* Name of the pipeline in the report */
+    unsigned    nsteps;                 /* Number of filters */
+    filter_step_t steps[MAX_STEPS];     /* The filters, in order */
+} pipeline_t;
+
+/* Results of measuring a pipeline on one kind of data */
+typedef struct result_t {
+    hsize_t     stored_bytes;           /* Size of the stored dataset */
+    double      encode_time;            /* Best time to write the dataset */
+    double      decode_time;            /* Best time to read the dataset */
+    hbool_t     exact;                  /* Whether the data read back exactly */
+} result_t;
+
+/* Pipelines measured by default */
+static const char *default_pipelines[] = {
+    "none",
+    "shuffle",
+    "fletcher32",
+    "nbit",
+    "scaleoffset",
+    "deflate",
+    "shuffle+deflate",
+    "scaleoffset+deflate",
+    "shuffle+deflate+fletcher32",
+    "szip",
+    "lz4",
+    "shuffle+lz4",
+    "bitshuffle",
+    "bitshuffle+lz4",
+    "nbit+lz4",
+    NULL
+};
+
+/* internal variables */
+static const char *prog = NULL;
+
+/* commandline options : long and short form */
+static const char *s_opts = "hc:n:o:p:s:";
+static struct long_options l_opts[] = {
+    { "help", no_arg, 'h' },
+    { "chunk-size", require_arg, 'c' },
+    { "repeats", require_arg, 'n' },
+    { "output", require_arg, 'o' },
+    { "pipeline", require_arg, 'p' },
+    { "size", require_arg, 's' },
+    { NULL, 0, '\0' }
+};
+
+/*
+ * Function:    error
+ * Purpose:     Display error message and exit.
+ */
+static void
+error(const char *fmt, ...)
+{
+    va_list ap;
+
+    va_start(ap, fmt);
+    HDfprintf(stderr, "%s: error: ", prog);
+    HDvfprintf(stderr, fmt, ap);
+    HDfprintf(stderr, "\n");
+    va_end(ap);
+    HDexit(EXIT_FAILURE);
+}
+
+/*
+ * Function:    usage
+ * Purpose:     Print a usage message.
+ */
+static void
+usage(void)
+{
+    HDfprintf(stdout, "usage: %s [OPTIONS]\n", prog);
+    HDfprintf(stdout, "  OPTIONS\n");
+    HDfprintf(stdout, "     -h, --help                 Print this usage message and exit\n");
+    HDfprintf(stdout, "     -s S, --size=S             Size of each dataset [default: 16M]\n");
+    HDfprintf(stdout, "     -c S, --chunk-size=S       Size of the chunks [default: 1M]\n");
+    HDfprintf(stdout, "     -n N, --repeats=N          Number of times each pipeline is run, the\n");
+    HDfprintf(stdout, "                                best time being reported [default: 3]\n");
+    HDfprintf(stdout, "     -o F, --output=F           Write the report to file F [default: stdout]\n");
+    HDfprintf(stdout, "     -p P, --pipeline=P         Measure pipeline P (may be repeated)\n");
+    HDfprintf(stdout, "                                [default: a standard set of pipelines]\n");
+    HDfprintf(stdout, "\n");
+    HDfprintf(stdout, "  F  - a file name\n");
+    HDfprintf(stdout, "  N  - an integer > 0\n");
+    HDfprintf(stdout, "  P  - filters joined with '+', each one of none, shuffle, fletcher32,\n");
+    HDfprintf(stdout, "       nbit, scaleoffset, deflate, szip, lz4, bitshuffle, or a filter\n");
+    HDfprintf(stdout, "       ID with optional client data values, e.g. 32001:0,0,0,0,1\n");
+    HDfprintf(stdout, "  S  - is a size specifier, an integer >0 followed by a size indicator:\n");
+    HDfprintf(stdout, "\n");
+    HDfprintf(stdout, "          K - Kilobyte (%d)\n", ONE_KB);
+    HDfprintf(stdout, "          M - Megabyte (%d)\n", ONE_MB);
+    HDfprintf(stdout, "          G - Gigabyte (%d)\n", ONE_GB);
+    HDfprintf(stdout, "\n");
+    HDfprintf(stdout, "      Example: filter_perf -s 64M -p shuffle+deflate -p bitshuffle+lz4\n");
+    HDfprintf(stdout, "\n");
+    HDfflush(stdout);
+}
+
+/*
+ * Function:    parse_size_directive
+ * Purpose:     Parse the size directive passed on the commandline. The size
+ *              directive is an integer followed by a size indicator:
+ *
+ *                  K, k - Kilobyte
+ *                  M, m - Megabyte
+ *                  G, g - Gigabyte
+ *
+ * Return:      The size.  If an unknown size indicator is used, then the
+ *              program will exit with EXIT_FAILURE as the return value.
+ */
+static size_t
+parse_size_directive(const char *size)
+{
+    size_t s;
+    char *endptr;
+
+    s = (size_t)HDstrtoul(size, &endptr, 10);
+
+    if (endptr && *endptr) {
+        while (*endptr != '\0' && (*endptr == ' ' || *endptr == '\t'))
+            ++endptr;
+
+        switch (*endptr) {
+            case 'K':
+            case 'k':
+                s *= ONE_KB;
+                break;
+            case 'M':
+            case 'm':
+                s *= ONE_MB;
+                break;
+            case 'G':
+            case 'g':
+                s *= ONE_GB;
+                break;
+            default:
+                error("illegal size specifier '%c'", *endptr);
+                break;
+        }
+    }
+
+    return s;
+}
+
+/*
+ * Function:    parse_pipeline
+ * Purpose:     Parse the pipeline NAME into PIPELINE.  NAME is kept in
+ *              PIPELINE, so it must outlive it.
+ * Return:      Nothing.  The program exits if NAME is invalid.
+ */
+static void
+parse_pipeline(const char *name, pipeline_t *pipeline)
+{
+    const char *s = name;
+
+    HDmemset(pipeline, 0, sizeof(*pipeline));
+    pipeline->name = name;
+
+    while (*s) {
+        filter_step_t *step = &pipeline->steps[pipeline->nsteps];
+        size_t len = HDstrcspn(s, "+");
+
+        if (len == 4 && !HDstrncmp(s, "none", len))
+            ;   /* no filter */
+        else {
+            if (pipeline->nsteps == MAX_STEPS)
+                error("too many filters in pipeline \"%s\"", name);
+
+            if (len == 7 && !HDstrncmp(s, "shuffle", len))
+                step->id = H5Z_FILTER_SHUFFLE;
+            else if (len == 10 && !HDstrncmp(s, "fletcher32", len))
+                step->id = H5Z_FILTER_FLETCHER32;
+            else if (len == 4 && !HDstrncmp(s, "nbit", len))
+                step->id = H5Z_FILTER_NBIT;
+            else if (len == 11 && !HDstrncmp(s, "scaleoffset", len))
+                step->id = H5Z_FILTER_SCALEOFFSET;
+            else if (len == 7 && !HDstrncmp(s, "deflate", len))
+                step->id = H5Z_FILTER_DEFLATE;
+            else if (len == 4 && !HDstrncmp(s, "szip", len))
+                step->id = H5Z_FILTER_SZIP;
+            else if (len == 3 && !HDstrncmp(s, "lz4", len))
+                step->id = H5Z_FILTER_LZ4;
+            else if (len == 10 && !HDstrncmp(s, "bitshuffle", len))
+                step->id = H5Z_FILTER_BITSHUFFLE;
+            else {
+                /* A filter ID, with optional client data values */
+                const char *end = s + len;
+                char *endptr;
+
+                step->id = (H5Z_filter_t)HDstrtol(s, &endptr, 10);
+                if (endptr == s || step->id < 0 || step->id > H5Z_FILTER_MAX)
+                    error("unknown filter \"%.*s\" in pipeline \"%s\"", (int)len, s, name);
+                if (endptr < end && *endptr == ':') {
+                    do {
+                        const char *cd = endptr + 1;
+
+                        if (step->cd_nelmts == MAX_CD_VALUES)
+                            error("too many client data values in pipeline \"%s\"", name);
+                        step->cd_values[step->cd_nelmts++] = (unsigned)HDstrtoul(cd, &endptr, 10);
+                        if (endptr == cd)
+                            error("bad client data values in pipeline \"%s\"", name);
+                    } while (endptr < end && *endptr == ',');
+                }
+                if (endptr != end)
+                    error("unknown filter \"%.*s\" in pipeline \"%s\"", (int)len, s, name);
+            }
+            pipeline->nsteps++;
+        }
+
+        s += len;
+        if (*s == '+')
+            s++;
+    }
+}
+
+/*
+ * Function:    generate_data
+ * Purpose:     Fill BUF with NELMTS elements of synthetic data of kind
+ *              KIND.  The data are the same from run to run.
+ */
+static void
+generate_data(data_kind_t kind, void *buf, size_t nelmts)
+{
+    float *fbuf = (float *)buf;
+    int *ibuf = (int *)buf;
+    unsigned seed = 12345;
+    size_t u;
+
+    for (u = 0; u < nelmts; u++) {
+        seed = seed * 1103515245 + 12345;
+        switch (kind) {
+            case DATA_SMOOTH_FLOAT:
+                fbuf[u] = (float)(100.0 * HDsin((double)u / 1000.0) + 10.0 * HDcos((double)u / 37.0));
+                break;
+            case DATA_NOISY_INT:
+                /* Fits in the 22 bits given for the nbit filter */
+                ibuf[u] = (int)((u / 16) % (1 << 20)) + (int)((seed >> 16) & 0xff);
+                break;
+            case DATA_SPARSE_INT:
+                /* About 1% of the values are set, in 17 bits */
+                ibuf[u] = ((seed >> 16) % 100) ? 0 : (int)((seed >> 8) & 0xffff);
+                break;
+            case DATA_CONSTANT_INT:
+            case DATA_NKINDS:
+            default:
+                ibuf[u] = 42;
+                break;
+        }
+    }
+}
+
+/*
+ * Function:    filter_usable
+ * Purpose:     Check that a filter can be used to write and read data.
+ * Return:      TRUE/FALSE
+ */
+static hbool_t
+filter_usable(H5Z_filter_t id)
+{
+    unsigned config = 0;
+    htri_t avail;
+
+    H5E_BEGIN_TRY {
+        avail = H5Zfilter_avail(id);
+        if (avail > 0 && H5Zget_filter_info(id, &config) < 0)
+            avail = FALSE;
+    } H5E_END_TRY;
+
+    return (avail > 0 && (config & H5Z_FILTER_CONFIG_ENCODE_ENABLED)
+            && (config & H5Z_FILTER_CONFIG_DECODE_ENABLED));
+}
+
+/*
+ * Function:    set_pipeline
+ * Purpose:     Add the filters of PIPELINE to DCPL, for data of kind KIND.
+ * Return:      Non-negative on success/Negative on failure
+ */
+static herr_t
+set_pipeline(hid_t dcpl, const pipeline_t *pipeline, data_kind_t kind)
+{
+    unsigned u;
+
+    for (u = 0; u < pipeline->nsteps; u++) {
+        const filter_step_t *step = &pipeline->steps[u];
+        herr_t ret;
+
+        switch (step->id) {
+            case H5Z_FILTER_SHUFFLE:
+                ret = H5Pset_shuffle(dcpl);
+                break;
+            case H5Z_FILTER_FLETCHER32:
+                ret = H5Pset_fletcher32(dcpl);
+                break;
+            case H5Z_FILTER_NBIT:
+                ret = H5Pset_nbit(dcpl);
+                break;
+            case H5Z_FILTER_SCALEOFFSET:
+                if (data_info[kind].is_float)
+                    ret = H5Pset_scaleoffset(dcpl, H5Z_SO_FLOAT_DSCALE, 3);
+                else
+                    ret = H5Pset_scaleoffset(dcpl, H5Z_SO_INT, H5Z_SO_INT_MINBITS_DEFAULT);
+                break;
+            case H5Z_FILTER_DEFLATE:
+                ret = H5Pset_deflate(dcpl, 6);
+                break;
+            case H5Z_FILTER_SZIP:
+                ret = H5Pset_szip(dcpl, H5_SZIP_NN_OPTION_MASK, 32);
+                break;
+            case H5Z_FILTER_LZ4:
+                ret = H5Pset_lz4(dcpl, 0);
+                break;
+            case H5Z_FILTER_BITSHUFFLE:
+                ret = H5Pset_bitshuffle(dcpl, 0);
+                break;
+            default:
+                ret = H5Pset_filter(dcpl, step->id, H5Z_FLAG_MANDATORY, step->cd_nelmts,
+                        step->cd_values);
+                break;
+        }
+        if (ret < 0)
+            return FAIL;
+    }
+
+    return SUCCEED;
+}
+
+/*
+ * Function:    run_pipeline
+ * Purpose:     Measure PIPELINE on WBUF, NELMTS elements of data of kind
+ *              KIND, using RBUF to read the data back.
+ * Return:      Non-negative on success/Negative if the pipeline can't be
+ *              applied to the data, with a reason in *REASON
+ */
+static herr_t
+run_pipeline(const pipeline_t *pipeline, data_kind_t kind, const void *wbuf,
+    void *rbuf, size_t nelmts, size_t chunk_nelmts, unsigned repeats,
+    result_t *result, const char **reason)
+{
+    hid_t fapl = H5I_INVALID_HID, fid = H5I_INVALID_HID;
+    hid_t dcpl = H5I_INVALID_HID, sid = H5I_INVALID_HID;
+    hid_t dsid = H5I_INVALID_HID, mem_type, file_type = H5I_INVALID_HID;
+    hsize_t dims = nelmts, chunk_dims = chunk_nelmts;
+    size_t nbytes = nelmts * sizeof(int);
+    unsigned u;
+
+    HDcompile_assert(sizeof(int) == sizeof(float));
+
+    HDmemset(result, 0, sizeof(*result));
+    result->exact = TRUE;
+
+    for (u = 0; u < pipeline->nsteps; u++)
+        if (!filter_usable(pipeline->steps[u].id)) {
+            *reason = "filter not available";
+            return FAIL;
+        }
+
+    /* Keep the file in memory, so that only the library is measured */
+    if ((fapl = H5Pcreate(H5P_FILE_ACCESS)) < 0)
+        error("can't create file access property list");
+    if (H5Pset_fapl_core(fapl, 16 * (size_t)ONE_MB, FALSE) < 0)
+        error("can't set core driver");
+
+    /* The nbit filter only saves space when the type has fewer significant
+     * bits than its size */
+    mem_type = data_info[kind].is_float ? H5T_NATIVE_FLOAT : H5T_NATIVE_INT;
+    if ((file_type = H5Tcopy(mem_type)) < 0)
+        error("can't copy datatype");
+    for (u = 0; u < pipeline->nsteps; u++)
+        if (pipeline->steps[u].id == H5Z_FILTER_NBIT && data_info[kind].precision)
+            if (H5Tset_precision(file_type, data_info[kind].precision) < 0)
+                error("can't set precision");
+
+    if ((sid = H5Screate_simple(1, &dims, NULL)) < 0)
+        error("can't create dataspace");
+    if ((dcpl = H5Pcreate(H5P_DATASET_CREATE)) < 0)
+        error("can't create dataset creation property list");
+    if (H5Pset_chunk(dcpl, 1, &chunk_dims) < 0)
+        error("can't set chunk size");
+
+    *reason = NULL;
+    H5E_BEGIN_TRY {
+        if (set_pipeline(dcpl, pipeline, kind) < 0)
+            *reason = "can't set filters";
+    } H5E_END_TRY;
+
+    for (u = 0; u < repeats && !*reason; u++) {
+        hsize_t stored_bytes;
+        double start, t;
+
+        if ((fid = H5Fcreate("filter_perf.h5", H5F_ACC_TRUNC, H5P_DEFAULT, fapl)) < 0)
+            error("can't create file");
+
+        /* Encode: write the dataset and flush it from the chunk cache */
+        start = H5_get_time();
+        H5E_BEGIN_TRY {
+            dsid = H5Dcreate2(fid, FILTER_PERF_DSET, file_type, sid, H5P_DEFAULT, dcpl, H5P_DEFAULT);
+        } H5E_END_TRY;
+        if (dsid < 0) {
+            *reason = "filters can't be applied to the data";
+            if (H5Fclose(fid) < 0)
+                error("can't close file");
+            fid = H5I_INVALID_HID;
+            break;
+        }
+        if (H5Dwrite(dsid, mem_type, H5S_ALL, H5S_ALL, H5P_DEFAULT, wbuf) < 0)
+            error("can't write dataset for pipeline \"%s\"", pipeline->name);
+        if (H5Dclose(dsid) < 0)
+            error("can't close dataset");
+        t = H5_get_time() - start;
+        if (u == 0 || t < result->encode_time)
+            result->encode_time = t;
+
+        /* Decode: read the dataset back */
+        if ((dsid = H5Dopen2(fid, FILTER_PERF_DSET, H5P_DEFAULT)) < 0)
+            error("can't open dataset");
+        stored_bytes = H5Dget_storage_size(dsid);
+        HDmemset(rbuf, 0, nbytes);
+        start = H5_get_time();
+        if (H5Dread(dsid, mem_type, H5S_ALL, H5S_ALL, H5P_DEFAULT, rbuf) < 0)
+            error("can't read dataset for pipeline \"%s\"", pipeline->name);
+        t = H5_get_time() - start;
+        if (u == 0 || t < result->decode_time)
+            result->decode_time = t;
+        if (H5Dclose(dsid) < 0)
+            error("can't close dataset");
+        dsid = H5I_INVALID_HID;
+        if (H5Fclose(fid) < 0)
+            error("can't close file");
+        fid = H5I_INVALID_HID;
+
+        result->stored_bytes = stored_bytes;
+        if (HDmemcmp(wbuf, rbuf, nbytes))
+            result->exact = FALSE;
+    }
+
+    if (H5Pclose(dcpl) < 0 || H5Sclose(sid) < 0 || H5Tclose(file_type) < 0 || H5Pclose(fapl) < 0)
+        error("can't release resources");
+
+    return *reason ? FAIL : SUCCEED;
+}
+
+/*
+ * Function:    print_json_string
+ * Purpose:     Print S to OUT as a JSON string.
+ */
+static void
+print_json_string(FILE *out, const char *s)
+{
+    HDfputc('"', out);
+    for (; *s; s++) {
+        if (*s == '"' || *s == '\\')
+            HDfprintf(out, "\\%c", *s);
+        else if ((unsigned char)*s < 0x20)
+            HDfprintf(out, "\\u%04x", (unsigned)(unsigned char)*s);
+        else
+            HDfputc(*s, out);
+    }
+    HDfputc('"', out);
+}
+
+/*
+ * Function:    main
+ * Purpose:     Run the program
+ * Return:      EXIT_SUCCESS or EXIT_FAILURE
+ */
+int
+main(int argc, char **argv)
+{
+    pipeline_t *pipelines = NULL;
+    const char *pipeline_names[MAX_PIPELINES + 1];
+    const char **names = default_pipelines;
+    const char *output_name = NULL;
+    size_t npipeline_names = 0;
+    size_t size = 16 * (size_t)ONE_MB, chunk_size = ONE_MB;
+    size_t nelmts, chunk_nelmts, npipelines, p;
+    unsigned repeats = 3;
+    unsigned majnum, minnum, relnum;
+    void *wbuf = NULL, *rbuf = NULL;
+    FILE *out = stdout;
+    hbool_t first_result = TRUE, first_skipped = TRUE;
+    int kind;
+    int opt;
+
+    prog = argv[0];
+
+    /* Initialize h5tools lib */
+    h5tools_init();
+
+    while ((opt = get_option(argc, (const char **)argv, s_opts, l_opts)) > 0) {
+        switch ((char)opt) {
+        case 'c':
+            chunk_size = parse_size_directive(opt_arg);
+            break;
+        case 'n':
+            repeats = (unsigned)HDstrtoul(opt_arg, NULL, 10);
+            break;
+        case 'o':
+            output_name = opt_arg;
+            break;
+        case 'p':
+            if (npipeline_names == MAX_PIPELINES)
+                error("too many pipelines");
+            pipeline_names[npipeline_names++] = opt_arg;
+            break;
+        case 's':
+            size = parse_size_directive(opt_arg);
+            break;
+        case '?':
+            usage();
+            HDexit(EXIT_FAILURE);
+            break;
+        case 'h':
+        default:
+            usage();
+            HDexit(EXIT_SUCCESS);
+            break;
+        }
+    }
+
+    if (repeats == 0)
+        error("the number of repeats must be > 0");
+    nelmts = size / sizeof(int);
+    chunk_nelmts = chunk_size / sizeof(int);
+    if (nelmts == 0 || chunk_nelmts == 0)
+        error("the dataset and chunk sizes must be at least %d bytes", (int)sizeof(int));
+    chunk_nelmts = MIN(chunk_nelmts, nelmts);
+
+    if (npipeline_names) {
+        pipeline_names[npipeline_names] = NULL;
+        names = pipeline_names;
+    }
+    for (npipelines = 0; names[npipelines]; npipelines++)
+        ;
+    if (NULL == (pipelines = (pipeline_t *)HDcalloc(npipelines, sizeof(pipeline_t))))
+        error("out of memory");
+    for (p = 0; p < npipelines; p++)
+        parse_pipeline(names[p], &pipelines[p]);
+
+    if (NULL == (wbuf = HDmalloc(nelmts * sizeof(int))) || NULL == (rbuf = HDmalloc(nelmts * sizeof(int))))
+        error("out of memory");
+
+    if (output_name && NULL == (out = HDfopen(output_name, "w")))
+        error("can't open \"%s\": %s", output_name, HDstrerror(errno));
+
+    if (H5get_libversion(&majnum, &minnum, &relnum) < 0)
+        error("can't get library version");
+    HDfprintf(out, "{\n");
+    HDfprintf(out, "  \"library_version\": \"%u.%u.%u\",\n", majnum, minnum, relnum);
+    HDfprintf(out, "  \"dataset_bytes\": %lu,\n", (unsigned long)(nelmts * sizeof(int)));
+    HDfprintf(out, "  \"chunk_bytes\": %lu,\n", (unsigned long)(chunk_nelmts * sizeof(int)));
+    HDfprintf(out, "  \"repeats\": %u,\n", repeats);
+    HDfprintf(out, "  \"results\": [");
+
+    /* Measure each pipeline on each kind of data, keeping track of the
+     * runs that were skipped to report them at the end */
+    {
+        const char **skipped_reason = NULL;
+
+        if (NULL == (skipped_reason = (const char **)HDcalloc(npipelines * DATA_NKINDS, sizeof(const char *))))
+            error("out of memory");
+
+        for (kind = 0; kind < DATA_NKINDS; kind++) {
+            generate_data((data_kind_t)kind, wbuf, nelmts);
+
+            for (p = 0; p < npipelines; p++) {
+                size_t raw_bytes = nelmts * sizeof(int);
+                const char *reason = NULL;
+                result_t result;
+
+                if (run_pipeline(&pipelines[p], (data_kind_t)kind, wbuf, rbuf, nelmts, chunk_nelmts,
+                        repeats, &result, &reason) < 0) {
+                    skipped_reason[(size_t)kind * npipelines + p] = reason;
+                    continue;
+                }
+
+                HDfprintf(out, "%s\n    {\"data\": ", first_result ? "" : ",");
+                print_json_string(out, data_info[kind].name);
+                HDfprintf(out, ", \"pipeline\": ");
+                print_json_string(out, pipelines[p].name);
+                HDfprintf(out, ", \"raw_bytes\": %lu, \"stored_bytes\": %lu, \"ratio\": %.4f,",
+                        (unsigned long)raw_bytes, (unsigned long)result.stored_bytes,
+                        result.stored_bytes ? (double)raw_bytes / (double)result.stored_bytes : 0.0);
+                HDfprintf(out, " \"encode_mb_per_s\": %.2f, \"decode_mb_per_s\": %.2f, \"exact\": %s}",
+                        MB_PER_SEC(raw_bytes, result.encode_time),
+                        MB_PER_SEC(raw_bytes, result.decode_time),
+                        result.exact ? "true" : "false");
+                HDfflush(out);
+                first_result = FALSE;
+            }
+        }
+
+        HDfprintf(out, "\n  ],\n");
+        HDfprintf(out, "  \"skipped\": [");
+        for (kind = 0; kind < DATA_NKINDS; kind++)
+            for (p = 0; p < npipelines; p++) {
+                const char *reason = skipped_reason[(size_t)kind * npipelines + p];
+
+                if (reason) {
+                    HDfprintf(out, "%s\n    {\"data\": ", first_skipped ? "" : ",");
+                    print_json_string(out, data_info[kind].name);
+                    HDfprintf(out, ", \"pipeline\": ");
+                    print_json_string(out, pipelines[p].name);
+                    HDfprintf(out, ", \"reason\": ");
+                    print_json_string(out, reason);
+                    HDfprintf(out, "}");
+                    first_skipped = FALSE;
+                }
+            }
+        HDfprintf(out, "\n  ]\n");
+        HDfree(skipped_reason);
+    }
+    HDfprintf(out, "}\n");
+
+    if (out != stdout)
+        HDfclose(out);
+    HDfree(wbuf);
+    HDfree(rbuf);
+    HDfree(pipelines);
+    return EXIT_SUCCESS;
+}